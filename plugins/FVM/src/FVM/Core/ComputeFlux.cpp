@@ -6,7 +6,9 @@
 
 #include "Common/CBuilder.hpp"
 #include "Common/OptionURI.hpp"
+#include "Common/OptionComponent.hpp"
 #include "Common/Foreach.hpp"
+#include "Common/FindComponents.hpp"
 #include "Common/Log.hpp"
 
 #include "Mesh/CFieldView.hpp"
@@ -14,11 +16,13 @@
 #include "Mesh/CSpace.hpp"
 #include "Mesh/ElementType.hpp"
 #include "Mesh/ElementData.hpp"
+#include "Mesh/CFaceCellConnectivity.hpp"
 #include "Math/Checks.hpp"
 #include "Math/Consts.hpp"
 
 #include "FVM/Core/ComputeFlux.hpp"
 #include "FVM/Core/RiemannSolver.hpp"
+#include "FVM/Core/PolynomialReconstructor.hpp"
 
 /////////////////////////////////////////////////////////////////////////////////////
 
@@ -45,7 +49,8 @@ ComputeFlux::ComputeFlux ( const std::string& name ) :
   m_face_area("face_area_view"),
   m_face_normal("face_normal_view"),
   m_wave_speed_left(0),
-  m_wave_speed_right(0)
+  m_wave_speed_right(0),
+  m_current_face_cells(nullptr)
 {
   // options
   m_options.add_option(OptionURI::create("solution", URI("cpath:"), URI::Scheme::CPATH))
@@ -73,6 +78,11 @@ ComputeFlux::ComputeFlux ( const std::string& name ) :
       ->pretty_name("FaceNormal")
       ->attach_trigger ( boost::bind ( &ComputeFlux::config_normal,   this ) );
 
+  m_options.add_option(OptionComponent<PolynomialReconstructor>::create("reconstructor", &m_reconstructor))
+      ->description("Reconstruction of the solution in the faces. If not set, the solution is piecewise constant.")
+      ->pretty_name("Reconstructor")
+      ->attach_trigger ( boost::bind ( &ComputeFlux::config_reconstructor,   this ) );
+
   m_options["Elements"].attach_trigger ( boost::bind ( &ComputeFlux::trigger_elements,   this ) );
 
 }
@@ -133,6 +143,13 @@ void ComputeFlux::config_normal()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void ComputeFlux::config_reconstructor()
+{
+  m_face_cells.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void ComputeFlux::trigger_elements()
 {
     m_connected_solution.set_elements(elements());
@@ -141,6 +158,56 @@ void ComputeFlux::trigger_elements()
     m_face_normal.set_elements(elements());
     m_face_area.set_elements(elements());
     m_can_start_loop = true;
+
+    // the reconstruction is ready once it has been executed on the mesh
+    if (m_reconstructor.expired() || m_reconstructor.lock()->order() == 0 || m_reconstructor.lock()->dimension() == 0)
+      m_current_face_cells = nullptr;
+    else
+      m_current_face_cells = &face_cells();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ComputeFlux::FaceCells& ComputeFlux::face_cells()
+{
+  std::map<Component const*,FaceCells>::iterator it = m_face_cells.find(&elements());
+  if (it != m_face_cells.end())
+    return it->second;
+
+  // computed once per face component, as the mesh does not change
+
+  const PolynomialReconstructor& reconstructor = *m_reconstructor.lock();
+  const Uint dim = reconstructor.dimension();
+  const CFaceCellConnectivity& face2cells = *find_component_ptr<CFaceCellConnectivity>(elements());
+  const ElementType& face_type = elements().element_type();
+
+  FaceCells& face_cells = m_face_cells[&elements()];
+  face_cells.cells.resize(2*elements().size());
+  face_cells.dX.resize(2*dim*elements().size(),0.);
+
+  RealMatrix face_coordinates(face_type.nb_nodes(),dim);
+  RealVector face_centroid(dim);
+  Component::ConstPtr cells;
+  Uint cell_idx;
+  for (Uint face=0; face<elements().size(); ++face)
+  {
+    elements().put_coordinates(face_coordinates,face);
+    face_centroid = face_coordinates.colwise().mean().transpose();
+
+    for (Uint side=LEFT; side<=RIGHT; ++side)
+    {
+      boost::tie(cells,cell_idx) = face2cells.lookup().location(face2cells.connectivity()[face][side]);
+      const Uint cell = reconstructor.cell_idx(*cells,cell_idx);
+      face_cells.cells[2*face+side] = cell;
+      if (cell == uint_max())
+        continue;
+
+      const Real* centroid = reconstructor.centroid(cell);
+      for (Uint d=0; d<dim; ++d)
+        face_cells.dX[(2*face+side)*dim+d] = face_centroid[d] - centroid[d];
+    }
+  }
+  return face_cells;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////
@@ -158,7 +225,23 @@ void ComputeFlux::execute()
   {
     m_state_L[i]=solution[LEFT ][i];
     m_state_R[i]=solution[RIGHT][i];
+  }
 
+  // Reconstruct the states at the face
+  if (is_not_null(m_current_face_cells))
+  {
+    const PolynomialReconstructor& reconstructor = *m_reconstructor.lock();
+    const Uint dim = reconstructor.dimension();
+    const Uint cell_L = m_current_face_cells->cells[2*idx()+LEFT];
+    const Uint cell_R = m_current_face_cells->cells[2*idx()+RIGHT];
+    if (cell_L != uint_max())
+      reconstructor.reconstruct(cell_L, &m_current_face_cells->dX[(2*idx()+LEFT)*dim], m_state_L);
+    if (cell_R != uint_max())
+      reconstructor.reconstruct(cell_R, &m_current_face_cells->dX[(2*idx()+RIGHT)*dim], m_state_R);
+  }
+
+  for (Uint i=0; i<m_flux.size(); ++i)
+  {
     /// @todo investigate why Eigen chokes on values such as 1e-107 for a state
     /// Eigen then raises a SIGFPE signal.
     if (std::abs(m_state_L[i]) < eps() ) m_state_L[i] = 0.;
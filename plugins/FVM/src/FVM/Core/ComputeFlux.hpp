@@ -7,6 +7,8 @@
 #ifndef CF_FVM_Core_ComputeFlux_hpp
 #define CF_FVM_Core_ComputeFlux_hpp
 
+#include <map>
+
 #include "Solver/Actions/CLoopOperation.hpp"
 #include "FVM/Core/RiemannSolver.hpp"
 
@@ -20,8 +22,14 @@ namespace Mesh {
 namespace FVM {
 namespace Core {
 
+class PolynomialReconstructor;
+
 ///////////////////////////////////////////////////////////////////////////////////////
 
+/// Computes the flux through a face with a Riemann solver, and accumulates it
+/// in the residual of the left and right cells.
+/// If a PolynomialReconstructor of order higher than 0 is configured, the left
+/// and right states are its reconstructions at the centroid of the face.
 class FVM_Core_API ComputeFlux : public Solver::Actions::CLoopOperation
 {
 public: // typedefs
@@ -51,6 +59,7 @@ private: // helper functions
   void config_wave_speed();
   void config_area();
   void config_normal();
+  void config_reconstructor();
 
   void trigger_elements();
   
@@ -70,6 +79,24 @@ private: // data
   RealVector m_state_R;
   
   enum {LEFT=0,RIGHT=1};
+
+  /// cells of the faces in the reconstruction, and position of the centroid
+  /// of the faces relative to the centroid of the cells
+  struct FaceCells
+  {
+    std::vector<Uint> cells;  ///< 2 per face, Math::Consts::uint_max() if not reconstructed
+    std::vector<Real> dX;     ///< 2 x dimension per face
+  };
+
+  /// @return the face cells of the current faces, computed on first use
+  FaceCells& face_cells();
+
+  boost::weak_ptr<PolynomialReconstructor> m_reconstructor;
+
+  /// face cells per face component, valid for the mesh of the reconstruction
+  std::map<Common::Component const*, FaceCells> m_face_cells;
+  /// face cells of the current faces, null without reconstruction
+  FaceCells* m_current_face_cells;
   
   boost::shared_ptr<RiemannSolver> m_fluxsplitter;
 };
@@ -29,9 +29,46 @@ Common::ComponentBuilder < ComputeUpdateCoefficient, CAction, LibCore > ComputeU
 
 ///////////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+// The update coefficient may be stored in single precision (field option "Precision"):
+// it is computed in Real and only rounded when stored.
+
+/// update_coeff = 1 / ( V/dtau + V/dt ),  with  dtau = CFL*V/wave_speed
+template <typename CoeffT>
+void dual_time_step(CTable<CoeffT>& update_coeff, const CTable<Real>& wave_speed, const CTable<Real>& volume, const Real cfl, const Real dt)
+{
+  for (Uint i=0; i<update_coeff.size(); ++i)
+    update_coeff[i][0] = 1. / ( wave_speed[i][0]/cfl + volume[i][0]/dt );
+}
+
+/// update_coeff = dt/dx
+template <typename CoeffT>
+void global_time_step(CTable<CoeffT>& update_coeff, const CTable<Real>& volume, const Real dt)
+{
+  for (Uint i=0; i<update_coeff.size(); ++i)
+  {
+    if (volume[i][0] > 0)
+      update_coeff[i][0] = dt/volume[i][0];
+  }
+}
+
+/// update_coeff = CFL/wave_speed
+template <typename CoeffT>
+void local_time_step(CTable<CoeffT>& update_coeff, const CTable<Real>& wave_speed, const Real cfl)
+{
+  for (Uint i=0; i<update_coeff.size(); ++i)
+    update_coeff[i][0] = cfl/wave_speed[i][0];
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////////////
+
 ComputeUpdateCoefficient::ComputeUpdateCoefficient ( const std::string& name ) :
   CAction(name),
   m_time_accurate(false),
+  m_dual_time_stepping(false),
   m_CFL(1.)
 {
   mark_basic();
@@ -43,6 +80,12 @@ ComputeUpdateCoefficient::ComputeUpdateCoefficient ( const std::string& name ) :
       ->link_to(&m_time_accurate)
       ->add_tag("time_accurate");
 
+  m_options.add_option< OptionT<bool> > ("dual_time_stepping", m_dual_time_stepping)
+      ->description("Local pseudo time steps of dual time stepping, with the physical time step of the time component")
+      ->pretty_name("Dual Time Stepping")
+      ->link_to(&m_dual_time_stepping)
+      ->add_tag("dual_time_stepping");
+
   m_options.add_option< OptionT<Real> > ("cfl", m_CFL)
       ->description("Courant Number")
       ->pretty_name("CFL")
@@ -116,9 +159,24 @@ void ComputeUpdateCoefficient::execute()
   if (m_update_coeff.expired()) throw SetupError(FromHere(), "UpdateCoeff Field was not set");
 
   CTable<Real>& wave_speed = m_wave_speed.lock()->data();
-  CTable<Real>& update_coeff = m_update_coeff.lock()->data();
+  CField& update_coeff = *m_update_coeff.lock();
+  const bool single = update_coeff.precision() == CField::SINGLE;
+
+  if (m_dual_time_stepping) // local pseudo time stepping inside a physical time step
+  {
+    if (m_time.expired())   throw SetupError(FromHere(), "Time component was not set");
+    if (m_volume.expired()) throw SetupError(FromHere(), "Volume Field was not set");
 
-  if (m_time_accurate) // global time stepping
+    const Real dt = m_time.lock()->dt();
+    if (dt <= 0.) throw BadValue(FromHere(), "Dual time stepping requires a positive physical time step");
+
+    CTable<Real>& volume = m_volume.lock()->data();
+
+    // Calculate the update_coefficient, with the physical time derivative point-implicit
+    if (single) dual_time_step(update_coeff.data_single(), wave_speed, volume, m_CFL, dt);
+    else        dual_time_step(update_coeff.data(),        wave_speed, volume, m_CFL, dt);
+  }
+  else if (m_time_accurate) // global time stepping
   {
     if (m_time.expired())   throw SetupError(FromHere(), "Time component was not set");
     if (m_volume.expired()) throw SetupError(FromHere(), "Volume Field was not set");
@@ -143,11 +201,8 @@ void ComputeUpdateCoefficient::execute()
     }
 
     // Calculate the update_coefficient = dt/dx
-    for (Uint i=0; i<update_coeff.size(); ++i)
-    {
-      if (volume[i][0] > 0)
-        update_coeff[i][0] = dt/volume[i][0];
-    }
+    if (single) global_time_step(update_coeff.data_single(), volume, dt);
+    else        global_time_step(update_coeff.data(),        volume, dt);
 
     // Update the new time step
     time.dt() = dt;
@@ -158,8 +213,8 @@ void ComputeUpdateCoefficient::execute()
     if (!m_time.expired())  m_time.lock()->dt() = 0.;
 
     // Calculate the update_coefficient = CFL/wave_speed
-    for (Uint i=0; i<update_coeff.size(); ++i)
-      update_coeff[i][0] = m_CFL/wave_speed[i][0];
+    if (single) local_time_step(update_coeff.data_single(), wave_speed, m_CFL);
+    else        local_time_step(update_coeff.data(),        wave_speed, m_CFL);
   }
 }
 
@@ -18,6 +18,12 @@ namespace Solver { class CTime;   }
 namespace FVM {
 namespace Core {
 
+/// Computes the coefficient multiplying the residual, integrated over the cells,
+/// to update the solution.
+/// - time accurate: global time step, restricted by the CFL condition in all cells
+/// - steady: local time step @f$ \Delta \tau = CFL\ V / \lambda @f$ in every cell
+/// - dual time stepping: local pseudo time step inside the physical time step
+///   of the time component, with the physical time derivative treated point-implicitly
 class FVM_Core_API ComputeUpdateCoefficient : public Common::CAction
 {
 public: // typedefs
@@ -55,6 +61,7 @@ private: // data
   boost::weak_ptr<Solver::CTime> m_time;
 
   bool m_time_accurate;
+  bool m_dual_time_stepping;
   Real m_CFL;
 };
 
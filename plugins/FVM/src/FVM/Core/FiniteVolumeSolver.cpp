@@ -24,6 +24,7 @@
 #include "FVM/Core/ComputeUpdateCoefficient.hpp"
 #include "FVM/Core/UpdateSolution.hpp"
 #include "FVM/Core/OutputIterationInfo.hpp"
+#include "FVM/Core/PolynomialReconstructor.hpp"
 #include "FVM/Core/BC.hpp"
 
 #include "Mesh/CMesh.hpp"
@@ -80,6 +81,9 @@ FiniteVolumeSolver::FiniteVolumeSolver ( const std::string& name  ) : CSolver (
     " - The residual for cell[i] being F[i+1/2] - F[i-1/2],\n"
     "   F[i+1/2] is calculated using an approximate Riemann solver on the face\n"
     "   between cell[i] and cell[i+1]\n"
+    "   The states at the face are piecewise constant, or reconstructed from\n"
+    "   the cells with limited least-squares gradients when the option \"order\"\n"
+    "   of 2.3_reconstruct is set to 1\n"
     " - The wave_speed being the wave speed \"a\" in the Courant number defined as:\n"
     "        CFL = a * dt / V ,\n"
     "   with V the volume of a cell (notice not length) and dt the timestep to take.";
@@ -99,6 +103,12 @@ FiniteVolumeSolver::FiniteVolumeSolver ( const std::string& name  ) : CSolver (
       ->pretty_name("Time")
       ->attach_trigger( boost::bind ( &FiniteVolumeSolver::trigger_time, this ) );
 
+  m_options.add_option(OptionT<bool>::create("time_accurate", true))
+      ->description("Global time stepping if a time component is given.\n"
+                    "Otherwise the solution is marched to steady state with a local time step in every cell.")
+      ->pretty_name("Time Accurate")
+      ->attach_trigger( boost::bind ( &FiniteVolumeSolver::trigger_time_accurate, this ) );
+
   // Signals
   regist_signal( "create_bc" )
     ->connect( boost::bind( &FiniteVolumeSolver::signal_create_bc, this, _1 ) )
@@ -134,7 +144,10 @@ FiniteVolumeSolver::FiniteVolumeSolver ( const std::string& name  ) : CSolver (
     .mark_basic()
     .option("field").add_tag("wave_speed");
 
-  m_compute_rhs->create_static_component_ptr<CForAllFaces>("2.3_for_all_faces")
+  m_compute_rhs->create_static_component_ptr<PolynomialReconstructor>("2.3_reconstruct")
+    ->mark_basic();
+
+  m_compute_rhs->create_static_component_ptr<CForAllFaces>("2.4_for_all_faces")
     ->mark_basic();
 
   m_compute_update_coefficient = m_iterate->create_static_component_ptr<ComputeUpdateCoefficient>("3_compute_update_coeff");
@@ -163,11 +176,12 @@ void FiniteVolumeSolver::trigger_domain()
   if (is_null(mesh))
     throw SetupError(FromHere(),"Domain has no mesh");
 
-  m_compute_rhs->get_child_ptr("2.3_for_all_faces")
+  m_compute_rhs->get_child_ptr("2.4_for_all_faces")
     ->configure_option("regions",std::vector<URI>(1,mesh->topology().uri()));
   CLoopOperation::Ptr add_flux_to_rhs = build_component_abstract_type<CLoopOperation>("CF.FVM.Core.ComputeFlux","add_flux_to_rhs");
   add_flux_to_rhs->mark_basic();
-  m_compute_rhs->get_child("2.3_for_all_faces").add_component(add_flux_to_rhs);
+  m_compute_rhs->get_child("2.4_for_all_faces").add_component(add_flux_to_rhs);
+  add_flux_to_rhs->configure_option("reconstructor",m_compute_rhs->get_child("2.3_reconstruct").uri());
 
   if ( is_null(find_component_ptr_with_tag<CField>(*mesh,Mesh::Tags::normal()) ) )
   {
@@ -228,6 +242,8 @@ void FiniteVolumeSolver::trigger_domain()
     CFinfo << "  Creating field \"update_coeff\", cellbased" << CFendl;
     update_coeff_ptr = mesh->create_scalar_field("update_coeff",solution).self();
     update_coeff_ptr->add_tag("update_coeff");
+    // only used by the kernels updating the solution, which convert it when loading it
+    update_coeff_ptr->configure_option("Precision",std::string("Single"));
   }
   m_update_coeff->link_to(update_coeff_ptr);
 
@@ -253,13 +269,20 @@ void FiniteVolumeSolver::trigger_time()
   {
     m_time = time_ptr->as_ptr_checked<CTime>();
     m_iterate->configure_option_recursively("ctime",m_time.lock()->uri());
-    m_iterate->configure_option_recursively("time_accurate",true);
+    m_iterate->configure_option_recursively("time_accurate",option("time_accurate").value<bool>());
   }
   m_iterate->configure_option_recursively("ctime",m_time.lock()->uri());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void FiniteVolumeSolver::trigger_time_accurate()
+{
+  m_iterate->configure_option_recursively("time_accurate",option("time_accurate").value<bool>() && !m_time.expired());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void FiniteVolumeSolver::trigger_physical_model()
 {
 
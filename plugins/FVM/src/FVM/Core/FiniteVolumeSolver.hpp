@@ -90,6 +90,8 @@ private: // functions
 
   void trigger_time();
 
+  void trigger_time_accurate();
+
   void trigger_physical_model();
 
   void auto_config_fields(Component& parent);
@@ -4,6 +4,8 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include <boost/assign/std/vector.hpp>
+
 #include "Common/CBuilder.hpp"
 #include "Common/OptionURI.hpp"
 #include "Common/OptionT.hpp"
@@ -12,6 +14,7 @@
 
 #include "Mesh/CFieldView.hpp"
 #include "Mesh/CField.hpp"
+#include "Mesh/CMesh.hpp"
 #include "Mesh/CSpace.hpp"
 #include "Mesh/CElements.hpp"
 #include "Mesh/ElementType.hpp"
@@ -24,6 +27,7 @@
 
 /////////////////////////////////////////////////////////////////////////////////////
 
+using namespace boost::assign;
 using namespace CF::Common;
 using namespace CF::Mesh;
 using namespace CF::Math::Consts;
@@ -33,121 +37,289 @@ namespace Core {
 
 ///////////////////////////////////////////////////////////////////////////////////////
 
-Common::ComponentBuilder < PolynomialReconstructor, Component, LibCore > PolynomialReconstructor_Builder;
+Common::ComponentBuilder < PolynomialReconstructor, CAction, LibCore > PolynomialReconstructor_Builder;
 
 ///////////////////////////////////////////////////////////////////////////////////////
 
 PolynomialReconstructor::PolynomialReconstructor ( const std::string& name ) :
-  Component(name),
+  CAction(name),
   m_order(0),
-  m_dim(0)
+  m_dim(0),
+  m_nb_vars(0),
+  m_limiter("barth_jespersen"),
+  m_venkatakrishnan_k(5.)
 {
   // options
-  m_options.add_option(OptionT<Uint>::create("order", 1))
-      ->description("PolynomialReconstructor order")
-      ->pretty_name("Order");
+  m_options.add_option(OptionT<Uint>::create("order", m_order))
+      ->description("PolynomialReconstructor order (0 for a piecewise constant solution, the default, 1 for a linear reconstruction)")
+      ->pretty_name("Order")
+      ->link_to(&m_order);
+
+  m_options.add_option(OptionURI::create("solution", URI("cpath:"), URI::Scheme::CPATH))
+      ->description("Cell based solution")
+      ->pretty_name("Solution")
+      ->attach_trigger ( boost::bind ( &PolynomialReconstructor::config_solution,   this ) );
+
+  Option::Ptr limiter = m_options.add_option(OptionT<std::string>::create("limiter", m_limiter));
+  limiter->description("Limiter of the gradients")
+      ->pretty_name("Limiter")
+      ->link_to(&m_limiter);
+  limiter->restricted_list() += std::string("none"),
+                                std::string("venkatakrishnan");
 
-  m_options.add_option(OptionT<Uint>::create("dimension", 2))
-      ->description("Dimension of PolynomialReconstructor")
-      ->pretty_name("Dimension");
+  m_options.add_option(OptionT<Real>::create("venkatakrishnan_k", m_venkatakrishnan_k))
+      ->description("Constant K of the Venkatakrishnan limiter, larger values limiting less in smooth regions")
+      ->pretty_name("Venkatakrishnan K")
+      ->link_to(&m_venkatakrishnan_k)
+      ->attach_trigger ( boost::bind ( &PolynomialReconstructor::config_venkatakrishnan_k,   this ) );
 
   m_stencil_computer = create_static_component_ptr<CStencilComputerRings>("stencil_computer");
+  m_stencil_computer->configure_option("nb_rings",1u);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void PolynomialReconstructor::set_cell(const Uint unified_elem_idx)
+void PolynomialReconstructor::config_solution()
 {
-  m_idx = unified_elem_idx;
-  if (m_stencils.size() == 0) m_stencils.resize(m_stencil_computer->unified_elements().size());
-  std::vector<Uint>& stencil = m_stencils[m_idx];
-  if (stencil.size() == 0)    m_stencil_computer->compute_stencil(unified_elem_idx,stencil);
-
-   // DUDx_ave.Vacuum();
-   // DUDy_ave.Vacuum();
-   // DUDz_ave.Vacuum();
-   // D1.Vacuum();
-   // D2.Vacuum();
-   // D3.Vacuum();
-   // DxDx_ave = ZERO;
-   // DxDy_ave = ZERO;
-   // DxDz_ave = ZERO;
-   // DyDy_ave = ZERO;
-   // DyDz_ave = ZERO;
-   // DzDz_ave = ZERO;
-   // D = ZERO;
-
-   Component::Ptr elements;
-   Uint elem_idx;
-
-   boost::tie(elements,elem_idx) = m_stencil_computer->unified_elements().location(m_idx);
-   RealMatrix coordinates = elements->as_type<CElements>().get_coordinates(elem_idx);
-   RealVector X0(coordinates.cols());
-   elements->as_type<CElements>().element_type().compute_centroid(coordinates,X0);
-
-   RealVector X(X0.size());
-   RealVector dX(X0.size());
-   boost_foreach(const Uint neighbor_idx, stencil)
-   {
-     if (neighbor_idx != m_idx)
-     {
-       boost::tie(elements,elem_idx) = m_stencil_computer->unified_elements().location(neighbor_idx);
-       X = elements->as_type<CElements>().get_coordinates(elem_idx);
-       dX = X-X0;
-     }
-   }
-      //
-      // for ( n2 = 0 ; n2 <= n_pts-1 ; ++n2 ) {
-      //    dX =  Grid.Cell[ i_index[n2] ][ j_index[n2] ][ k_index[n2] ].Xc -
-      //       Grid.Cell[i][j][k].Xc;
-      //    DU =  W[ i_index[n2] ][ j_index[n2] ][ k_index[n2] ] -  W[i][j][k];
-      //
-      //    DUDx_ave += DU*dX.x;
-      //    DUDy_ave += DU*dX.y;
-      //    DUDz_ave += DU*dX.z;
-      //    DxDx_ave += dX.x*dX.x;
-      //    DxDy_ave += dX.x*dX.y;
-      //    DxDz_ave += dX.x*dX.z;
-      //    DyDy_ave += dX.y*dX.y;
-      //    DyDz_ave += dX.y*dX.z;
-      //    DzDz_ave += dX.z*dX.z;
-      //
-      // } /* endfor */
-      //
-      // DUDx_ave = DUDx_ave/double(n_pts);
-      // DUDy_ave = DUDy_ave/double(n_pts);
-      // DUDz_ave = DUDz_ave/double(n_pts);
-      // DxDx_ave = DxDx_ave/double(n_pts);
-      // DxDy_ave = DxDy_ave/double(n_pts);
-      // DxDz_ave = DxDz_ave/double(n_pts);
-      // DyDy_ave = DyDy_ave/double(n_pts);
-      // DyDz_ave = DyDz_ave/double(n_pts);
-      // DzDz_ave = DzDz_ave/double(n_pts);
-      //
-      // // (1) Either write a linear solver for 3x3 linear system
-      // // (2) Or simplely use cramer's rule for this simple system
-      //
-      // D = DxDx_ave*(DyDy_ave* DzDz_ave - DyDz_ave*DyDz_ave) +
-      //     DxDy_ave*(DxDz_ave*DyDz_ave - DxDy_ave*DzDz_ave)+
-      //     DxDz_ave*(DxDy_ave*DyDz_ave - DxDz_ave*DyDy_ave);
-      //
-      // D1 = DUDx_ave*(DyDy_ave* DzDz_ave - DyDz_ave*DyDz_ave) +
-      //      DUDy_ave*(DxDz_ave*DyDz_ave - DxDy_ave*DzDz_ave)+
-      //      DUDz_ave*(DxDy_ave*DyDz_ave - DxDz_ave*DyDy_ave);
-      //
-      // D2 =DxDx_ave*(DUDy_ave* DzDz_ave - DUDz_ave*DyDz_ave) +
-      //     DxDy_ave*(DxDz_ave*DUDz_ave - DUDx_ave*DzDz_ave)+
-      //     DxDz_ave*(DUDx_ave*DyDz_ave - DxDz_ave*DUDy_ave);
-      //
-      // D3 =DxDx_ave*(DyDy_ave* DUDz_ave - DyDz_ave*DUDy_ave) +
-      //     DxDy_ave*(DUDx_ave*DyDz_ave - DxDy_ave*DUDz_ave)+
-      //     DxDz_ave*(DxDy_ave*DUDy_ave - DUDx_ave*DyDy_ave);
-      //
-      // dWdx[i][j][k] = D1/D;
-      // dWdy[i][j][k] = D2/D;
-      // dWdz[i][j][k] = D3/D;
+  URI uri;  option("solution").put_value(uri);
+  m_solution = Common::Core::instance().root().access_component_ptr_checked(uri)->as_ptr_checked<CField>();
+
+  // the stencils belong to the mesh of the previous solution
+  m_stencil_start.clear();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+void PolynomialReconstructor::config_venkatakrishnan_k()
+{
+  // (K h)^3, with h the characteristic length of the cell
+  m_eps2.resize(m_cell_size.size());
+  for (Uint cell=0; cell<m_cell_size.size(); ++cell)
+    m_eps2[cell] = std::pow( m_venkatakrishnan_k * m_cell_size[cell], 3 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Uint PolynomialReconstructor::cell_idx(const Component& cells, const Uint idx) const
+{
+  if ( m_stencil_start.empty() || !m_stencil_computer->unified_elements().contains(cells) )
+    return uint_max();
+  return m_stencil_computer->unified_elements().unified_idx(cells,idx);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void PolynomialReconstructor::compute_least_squares()
+{
+  if (m_solution.expired())
+    throw SetupError(FromHere(), "Option \"solution\" of "+uri().string()+" has not been configured");
+
+  CField& solution = *m_solution.lock();
+
+  // (re)build the unified cells and node to cell connectivity of the stencil computer
+  CUnifiedData& cells = m_stencil_computer->unified_elements();
+  cells.reset();
+  m_stencil_computer->configure_option("mesh",solution.parent().as_type<CMesh>().uri());
+
+  const Uint nb_cells = cells.size();
+  m_nb_vars = solution.data().row_size();
+  m_dim = cells.components()[0]->as_type<CElements>().element_type().dimension();
+
+  // views of the solution
+
+  m_views.resize(cells.components().size());
+  for (Uint comp=0; comp<m_views.size(); ++comp)
+  {
+    m_views[comp] = allocate_component<CFieldView>("view");
+    m_views[comp]->initialize(solution, cells.components()[comp]->as_ptr<CEntities>());
+  }
+
+  m_cell_comp.resize(nb_cells);
+  m_cell_local.resize(nb_cells);
+  for (Uint cell=0; cell<nb_cells; ++cell)
+    boost::tie(m_cell_comp[cell],m_cell_local[cell]) = cells.location_idx(cell);
+
+  // centroids, nodes and size of the cells
+
+  m_centroids.resize(nb_cells*m_dim);
+  m_cell_size.resize(nb_cells);
+  m_nodes_start.resize(nb_cells+1);
+  m_nodes_start[0] = 0;
+  m_nodes_dX.clear();
+
+  RealMatrix coordinates;
+  RealVector centroid(m_dim);
+  for (Uint cell=0; cell<nb_cells; ++cell)
+  {
+    const CElements& elements = cells.components()[m_cell_comp[cell]]->as_type<CElements>();
+    const ElementType& etype = elements.element_type();
+    coordinates.resize(etype.nb_nodes(),m_dim);
+    elements.put_coordinates(coordinates,m_cell_local[cell]);
+    etype.compute_centroid(coordinates,centroid);
+
+    for (Uint d=0; d<m_dim; ++d)
+      m_centroids[cell*m_dim+d] = centroid[d];
+
+    for (Uint node=0; node<coordinates.rows(); ++node)
+      for (Uint d=0; d<m_dim; ++d)
+        m_nodes_dX.push_back(coordinates(node,d) - centroid[d]);
+    m_nodes_start[cell+1] = m_nodes_dX.size() / m_dim;
+
+    m_cell_size[cell] = std::pow( std::abs(etype.compute_volume(coordinates)), 1./m_dim );
+  }
+  config_venkatakrishnan_k();
+
+  // stencils and pseudo-inverses of the least-squares problems
+  //   grad(u)_i = ( sum_j dX_j dX_j^T )^-1  sum_j dX_j (u_j - u_i)
+
+  m_stencil_start.resize(nb_cells+1);
+  m_stencil_start[0] = 0;
+  m_stencils.clear();
+  m_weights.clear();
+
+  std::vector<Uint> stencil;
+  RealMatrix dX;
+  RealMatrix normal_matrix(m_dim,m_dim);
+  for (Uint cell=0; cell<nb_cells; ++cell)
+  {
+    m_stencil_computer->compute_stencil(cell,stencil);
+
+    dX.resize(m_dim,stencil.size());
+    Uint nb_neighbors = 0;
+    boost_foreach(const Uint neighbor, stencil)
+    {
+      if (neighbor == cell)
+        continue;
+      m_stencils.push_back(neighbor);
+      for (Uint d=0; d<m_dim; ++d)
+        dX(d,nb_neighbors) = m_centroids[neighbor*m_dim+d] - m_centroids[cell*m_dim+d];
+      ++nb_neighbors;
+    }
+    m_stencil_start[cell+1] = m_stencils.size();
+
+    normal_matrix.noalias() = dX.leftCols(nb_neighbors) * dX.leftCols(nb_neighbors).transpose();
+
+    // a stencil that does not span the space leaves the cell piecewise constant
+    const Real scale = normal_matrix.trace();
+    if (nb_neighbors < m_dim || std::abs(normal_matrix.determinant()) <= eps() * std::pow(scale,Real(m_dim)))
+    {
+      m_weights.resize(m_weights.size()+nb_neighbors*m_dim,0.);
+      continue;
+    }
+
+    const RealMatrix weights = normal_matrix.inverse() * dX.leftCols(nb_neighbors);
+    for (Uint n=0; n<nb_neighbors; ++n)
+      for (Uint d=0; d<m_dim; ++d)
+        m_weights.push_back(weights(d,n));
+  }
+
+  m_u.resize(nb_cells,m_nb_vars);
+  m_gradients.resize(nb_cells*m_nb_vars*m_dim);
+
+  CFinfo << "  Least-squares reconstruction: " << nb_cells << " cells, "
+         << m_stencils.size() << " neighbors" << CFendl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void PolynomialReconstructor::execute()
+{
+  if (m_order == 0)
+    return;
+
+  if (m_stencil_start.empty())
+    compute_least_squares();
+
+  const Uint nb_cells = m_cell_comp.size();
+
+  // gather the solution in contiguous storage
+
+  for (Uint cell=0; cell<nb_cells; ++cell)
+  {
+    CTable<Real>::ConstRow row = (*m_views[m_cell_comp[cell]])[m_cell_local[cell]];
+    for (Uint var=0; var<m_nb_vars; ++var)
+      m_u(cell,var) = row[var];
+  }
+
+  // gradients
+
+  for (Uint cell=0; cell<nb_cells; ++cell)
+  {
+    Real* grad = &m_gradients[cell*m_nb_vars*m_dim];
+    for (Uint i=0; i<m_nb_vars*m_dim; ++i)
+      grad[i] = 0.;
+
+    for (Uint n=m_stencil_start[cell]; n<m_stencil_start[cell+1]; ++n)
+    {
+      const Uint neighbor = m_stencils[n];
+      const Real* w = &m_weights[n*m_dim];
+      for (Uint var=0; var<m_nb_vars; ++var)
+      {
+        const Real du = m_u(neighbor,var) - m_u(cell,var);
+        for (Uint d=0; d<m_dim; ++d)
+          grad[var*m_dim+d] += w[d] * du;
+      }
+    }
+
+    if (m_limiter != "none")
+      limit(cell,m_u);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void PolynomialReconstructor::limit(const Uint cell, const RealMatrix& u)
+{
+  const bool venkatakrishnan = (m_limiter == "venkatakrishnan");
+  const Real eps2 = m_eps2[cell];
+
+  Real* grad = &m_gradients[cell*m_nb_vars*m_dim];
+  for (Uint var=0; var<m_nb_vars; ++var)
+  {
+    const Real u0 = u(cell,var);
+
+    // bounds of the solution in the stencil
+
+    Real u_max = u0;
+    Real u_min = u0;
+    for (Uint n=m_stencil_start[cell]; n<m_stencil_start[cell+1]; ++n)
+    {
+      u_max = std::max(u_max,u(m_stencils[n],var));
+      u_min = std::min(u_min,u(m_stencils[n],var));
+    }
+
+    // the most restrictive limiter over the nodes of the cell
+
+    Real phi = 1.;
+    for (Uint node=m_nodes_start[cell]; node<m_nodes_start[cell+1]; ++node)
+    {
+      const Real* dX = &m_nodes_dX[node*m_dim];
+      Real delta_minus = 0.;
+      for (Uint d=0; d<m_dim; ++d)
+        delta_minus += grad[var*m_dim+d] * dX[d];
+
+      if (delta_minus == 0.)
+        continue;
+
+      const Real delta_plus = (delta_minus > 0. ? u_max : u_min) - u0;
+
+      if (venkatakrishnan)
+      {
+        const Real dp2 = delta_plus*delta_plus;
+        const Real dm2 = delta_minus*delta_minus;
+        phi = std::min(phi, (dp2 + eps2 + 2.*delta_minus*delta_plus) /
+                            (dp2 + 2.*dm2 + delta_minus*delta_plus + eps2) );
+      }
+      else
+      {
+        phi = std::min(phi, delta_plus/delta_minus);
+      }
+    }
+
+    for (Uint d=0; d<m_dim; ++d)
+      grad[var*m_dim+d] *= phi;
+  }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -156,4 +328,3 @@ void PolynomialReconstructor::set_cell(const Uint unified_elem_idx)
 } // CF
 
 ////////////////////////////////////////////////////////////////////////////////////
-
@@ -7,19 +7,36 @@
 #ifndef CF_FVM_Core_PolynomialReconstructor_hpp
 #define CF_FVM_Core_PolynomialReconstructor_hpp
 
-#include "Common/Component.hpp"
+#include "Common/CAction.hpp"
+
+#include "Math/MatrixTypes.hpp"
+
+#include "Mesh/CTable.hpp"
+
 #include "FVM/Core/LibCore.hpp"
 
 /////////////////////////////////////////////////////////////////////////////////////
 
 namespace CF {
-  namespace Mesh { class CStencilComputerRings; }
+  namespace Mesh { class CStencilComputerRings; class CField; class CFieldView; }
 namespace FVM {
 namespace Core {
 
 ///////////////////////////////////////////////////////////////////////////////////////
 
-class FVM_Core_API PolynomialReconstructor : public Common::Component
+/// Linear reconstruction of a cell based solution, with least-squares gradients.
+///
+/// The stencil of a cell is the ring of cells sharing a node with it. The
+/// least-squares pseudo-inverse of every stencil is computed once per mesh and
+/// stored contiguously, so that executing this action, once per iteration, only
+/// has to accumulate the weighted differences of the solution to get the gradients.
+/// The gradients are then limited with the Barth-Jespersen or the Venkatakrishnan
+/// limiter, evaluated at the nodes of the cell.
+/// The faces read the reconstructed states through reconstruct().
+/// The option "order" is 0 by default, which keeps the solution piecewise
+/// constant as before; it must be set to 1 for the linear reconstruction.
+/// @author Willem Deconinck
+class FVM_Core_API PolynomialReconstructor : public Common::CAction
 {
 public: // typedefs
 
@@ -38,20 +55,95 @@ public: // functions
   /// Get the class name
   static std::string type_name () { return "PolynomialReconstructor"; }
 
-  void set_cell(const Uint unified_elem_idx);
+  /// computes the limited gradients of the solution in all the cells
+  virtual void execute();
+
+  /// @return the order of the reconstruction, 0 meaning piecewise constant
+  Uint order() const { return m_order; }
+
+  /// @return the index of a cell in the reconstruction, or Math::Consts::uint_max()
+  ///         if the cell is not reconstructed (e.g. a ghost cell)
+  Uint cell_idx(const Common::Component& cells, const Uint idx) const;
+
+  /// @return the centroid of a cell
+  const Real* centroid(const Uint cell) const { return &m_centroids[cell*m_dim]; }
+
+  /// @return the dimension of the reconstruction
+  Uint dimension() const { return m_dim; }
+
+  /// reconstructs the solution of a cell in a point
+  /// @param [in]  cell      index of the cell in the reconstruction
+  /// @param [in]  dX        position of the point relative to the centroid of the cell
+  /// @param [in,out] state  solution of the cell, replaced by the reconstructed solution
+  template < typename VectorT >
+  void reconstruct(const Uint cell, const Real* dX, VectorT& state) const
+  {
+    const Real* grad = &m_gradients[cell*m_nb_vars*m_dim];
+    for (Uint var=0; var<m_nb_vars; ++var)
+      for (Uint d=0; d<m_dim; ++d)
+        state[var] += grad[var*m_dim+d] * dX[d];
+  }
 
 private: // helper functions
+
+  /// invalidates the least-squares data when the solution is configured
+  void config_solution();
+
+  /// computes the smoothing parameter of the Venkatakrishnan limiter in every cell
+  void config_venkatakrishnan_k();
+
+  /// computes the stencils and their pseudo-inverses, once per mesh
+  void compute_least_squares();
+
+  /// limits the gradients of a cell
+  /// @param [in] cell  index of the cell in the reconstruction
+  /// @param [in] u     solution of all the cells
+  void limit(const Uint cell, const RealMatrix& u);
+
 private: // data
 
   boost::shared_ptr<Mesh::CStencilComputerRings> m_stencil_computer;
 
+  boost::weak_ptr<Mesh::CField> m_solution;
+
+  /// views of the solution, per component of cells
+  std::vector< boost::shared_ptr<Mesh::CFieldView> > m_views;
+
   Uint m_order;
   Uint m_dim;
-  
-  std::vector<std::vector<Uint> > m_stencils;
-  std::vector<std::vector<Real> > m_weights;
-  
-  Uint m_idx;
+  Uint m_nb_vars;
+
+  /// component and local index of every cell
+  std::vector<Uint> m_cell_comp;
+  std::vector<Uint> m_cell_local;
+
+  /// neighbors of the cells in CSR format: the neighbors of cell i
+  /// are m_stencils[ m_stencil_start[i] ... m_stencil_start[i+1] [
+  std::vector<Uint> m_stencil_start;
+  std::vector<Uint> m_stencils;
+  /// least-squares weights, m_dim per neighbor in the stencils
+  std::vector<Real> m_weights;
+
+  /// nodes of the cells relative to their centroids in CSR format, m_dim per node
+  std::vector<Uint> m_nodes_start;
+  std::vector<Real> m_nodes_dX;
+
+  /// centroids of the cells, m_dim per cell
+  std::vector<Real> m_centroids;
+  /// characteristic length of the cells
+  std::vector<Real> m_cell_size;
+  /// smoothing parameter of the Venkatakrishnan limiter per cell
+  std::vector<Real> m_eps2;
+
+  /// gathered solution, one row per cell
+  RealMatrix m_u;
+  /// limited gradients, m_nb_vars x m_dim per cell
+  std::vector<Real> m_gradients;
+
+  /// limiter, one of "none", "barth_jespersen" or "venkatakrishnan"
+  std::string m_limiter;
+  /// constant K of the Venkatakrishnan limiter
+  Real m_venkatakrishnan_k;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
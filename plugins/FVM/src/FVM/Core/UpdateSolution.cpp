@@ -25,6 +25,42 @@ Common::ComponentBuilder < UpdateSolution, CAction, LibCore > UpdateSolution_Bui
 
 ///////////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+/// solution += update_coeff * residual, with the update coefficient stored in
+/// Real or in single precision, and converted to Real when loaded
+template <typename CoeffT>
+void update(CTable<Real>& solution, const CTable<Real>& residual, const CTable<CoeffT>& update_coeff)
+{
+  // with the SoA layout, one contiguous loop per variable
+
+  if (solution.layout() == CTable<Real>::SOA && residual.layout() == CTable<Real>::SOA)
+  {
+    const typename CTable<CoeffT>::ConstColumn coeff = update_coeff.column(0);
+    for (Uint j=0; j<solution.row_size(); ++j)
+    {
+      Real* u = solution.column(j).values;
+      const Real* r = residual.column(j).values;
+      for (Uint i=0; i<solution.size(); ++i)
+        u[i] += static_cast<Real>(coeff[i]) * r[i];
+    }
+    return;
+  }
+
+  for (Uint i=0; i<solution.size(); ++i)
+  {
+    const Real coeff = update_coeff[i][0];
+    for (Uint j=0; j<solution.row_size(); ++j)
+    {
+      solution[i][j] += coeff * residual[i][j];
+    }
+  }
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////////////
+
 UpdateSolution::UpdateSolution ( const std::string& name ) :
   CAction(name)
 {
@@ -55,15 +91,12 @@ void UpdateSolution::execute()
 
   CTable<Real>& solution = m_solution.lock()->data();
   CTable<Real>& residual = m_residual.lock()->data();
-  CTable<Real>& update_coeff = m_update_coeff.lock()->data();
+  CField& update_coeff = *m_update_coeff.lock();
 
-  for (Uint i=0; i<solution.size(); ++i)
-  {
-    for (Uint j=0; j<solution.row_size(); ++j)
-    {
-      solution[i][j] += update_coeff[i][0] * residual[i][j];
-    }
-  }
+  if (update_coeff.precision() == CField::SINGLE)
+    update(solution, residual, update_coeff.data_single());
+  else
+    update(solution, residual, update_coeff.data());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
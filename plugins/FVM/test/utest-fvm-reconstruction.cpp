@@ -0,0 +1,196 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for CF::FVM::Core::PolynomialReconstructor"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/Core.hpp"
+#include "Common/CRoot.hpp"
+#include "Common/FindComponents.hpp"
+#include "Common/Foreach.hpp"
+
+#include "Math/Consts.hpp"
+
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/CElements.hpp"
+#include "Mesh/CField.hpp"
+#include "Mesh/CMeshTransformer.hpp"
+#include "Mesh/CSimpleMeshGenerator.hpp"
+#include "Mesh/Actions/CInitFieldFunction.hpp"
+
+#include "FVM/Core/PolynomialReconstructor.hpp"
+
+using namespace CF;
+using namespace CF::Common;
+using namespace CF::Mesh;
+using namespace CF::FVM::Core;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// linear field u = 3x - 2y + 1 on a square of 10x10 cells
+struct PolynomialReconstructor_Fixture
+{
+  PolynomialReconstructor_Fixture()
+  {
+    CRoot& root = Core::instance().root();
+    if ( is_not_null(root.get_child_ptr("mesh")) )
+    {
+      mesh = root.get_child("mesh").as_ptr<CMesh>();
+      return;
+    }
+
+    mesh = root.create_component_ptr<CMesh>("mesh");
+    CSimpleMeshGenerator::create_rectangle(*mesh, 1., 1., 10, 10);
+    build_component_abstract_type<CMeshTransformer>("CF.Mesh.Actions.CreateSpaceP0","create_spaceP0")->transform(mesh);
+
+    CField& solution = mesh->create_field("solution",CField::Basis::CELL_BASED,"P0","u[1]");
+
+    Actions::CInitFieldFunction::Ptr init_field = allocate_component<Actions::CInitFieldFunction>("init_field");
+    init_field->configure_option("functions",std::vector<std::string>(1,"3*x-2*y+1"));
+    init_field->configure_option("field",solution.uri());
+    init_field->transform(*mesh);
+  }
+
+  /// creates a linear reconstruction of the solution
+  PolynomialReconstructor& create_reconstructor(const std::string& name, const std::string& limiter)
+  {
+    PolynomialReconstructor& reconstructor = Core::instance().root().create_component<PolynomialReconstructor>(name);
+    reconstructor.configure_option("order",1u);
+    reconstructor.configure_option("limiter",limiter);
+    reconstructor.configure_option("solution",mesh->get_child("solution").uri());
+    return reconstructor;
+  }
+
+  /// @return the gradient of the reconstruction in a cell
+  RealVector gradient(const PolynomialReconstructor& reconstructor, const CElements& elements, const Uint e)
+  {
+    const Uint cell = reconstructor.cell_idx(elements,e);
+    BOOST_REQUIRE(cell != Math::Consts::uint_max());
+
+    RealVector grad(2);
+    for (Uint d=0; d<2; ++d)
+    {
+      Real dX[2] = {0.,0.};
+      dX[d] = 1.;
+      RealVector state = RealVector::Zero(1);
+      reconstructor.reconstruct(cell,dX,state);
+      grad[d] = state[0];
+    }
+    return grad;
+  }
+
+  /// @return true if the cell has no face on the boundary
+  static bool is_interior(const CElements& elements, const Uint e)
+  {
+    const RealVector centroid = elements.get_coordinates(e).colwise().mean();
+    return centroid.minCoeff() > 0.1 && centroid.maxCoeff() < 0.9;
+  }
+
+  CMesh::Ptr mesh;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( PolynomialReconstructor_TestSuite, PolynomialReconstructor_Fixture )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( piecewise_constant_by_default )
+{
+  PolynomialReconstructor& reconstructor = Core::instance().root().create_component<PolynomialReconstructor>("default");
+  BOOST_CHECK_EQUAL(reconstructor.order(), 0u);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( linear_field_unlimited )
+{
+  PolynomialReconstructor& reconstructor = create_reconstructor("unlimited","none");
+  reconstructor.execute();
+
+  // the least-squares gradient is exact in every cell, also on the boundary
+  Uint nb_cells = 0;
+  boost_foreach(const CElements& elements, find_components_recursively_with_filter<CElements>(mesh->topology(),IsElementsVolume()))
+  {
+    for (Uint e=0; e<elements.size(); ++e)
+    {
+      const RealVector grad = gradient(reconstructor,elements,e);
+      BOOST_CHECK_CLOSE(grad[XX],  3., 1e-10);
+      BOOST_CHECK_CLOSE(grad[YY], -2., 1e-10);
+      ++nb_cells;
+    }
+  }
+  BOOST_CHECK_EQUAL(nb_cells, 100u);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( linear_field_barth_jespersen )
+{
+  PolynomialReconstructor& reconstructor = create_reconstructor("barth_jespersen","barth_jespersen");
+  reconstructor.execute();
+
+  boost_foreach(const CElements& elements, find_components_recursively_with_filter<CElements>(mesh->topology(),IsElementsVolume()))
+  {
+    for (Uint e=0; e<elements.size(); ++e)
+    {
+      const RealVector grad = gradient(reconstructor,elements,e);
+
+      // the limiter only scales the gradient, and leaves it untouched in the interior
+      const Real phi = grad[XX] / 3.;
+      BOOST_CHECK_CLOSE(grad[YY], -2.*phi, 1e-10);
+      BOOST_CHECK_LE(phi, 1. + 1e-12);
+      BOOST_CHECK_GE(phi, 0.);
+      if (is_interior(elements,e))
+        BOOST_CHECK_CLOSE(phi, 1., 1e-10);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( venkatakrishnan_reconfigured )
+{
+  PolynomialReconstructor& reconstructor = create_reconstructor("venkatakrishnan","venkatakrishnan");
+
+  // a large K does not limit the smooth solution
+  reconstructor.configure_option("venkatakrishnan_k",1e6);
+  reconstructor.execute();
+
+  boost_foreach(const CElements& elements, find_components_recursively_with_filter<CElements>(mesh->topology(),IsElementsVolume()))
+  {
+    for (Uint e=0; e<elements.size(); ++e)
+    {
+      const RealVector grad = gradient(reconstructor,elements,e);
+      BOOST_CHECK_CLOSE(grad[XX],  3., 1e-8);
+      BOOST_CHECK_CLOSE(grad[YY], -2., 1e-8);
+    }
+  }
+
+  // a small K configured after the least-squares data is built limits the boundary cells
+  reconstructor.configure_option("venkatakrishnan_k",1e-6);
+  reconstructor.execute();
+
+  Uint nb_limited = 0;
+  boost_foreach(const CElements& elements, find_components_recursively_with_filter<CElements>(mesh->topology(),IsElementsVolume()))
+  {
+    for (Uint e=0; e<elements.size(); ++e)
+    {
+      if ( gradient(reconstructor,elements,e)[XX] < 0.99 * 3. )
+        ++nb_limited;
+    }
+  }
+  BOOST_CHECK_GT(nb_limited, 0u);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
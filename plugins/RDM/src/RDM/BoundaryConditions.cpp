@@ -9,10 +9,14 @@
 #include "Common/OptionT.hpp"
 #include "Common/OptionArray.hpp"
 #include "Common/Signal.hpp"
+#include "Common/Foreach.hpp"
+#include "Common/FindComponents.hpp"
 
 #include "Common/XML/SignalOptions.hpp"
 
 #include "Mesh/CMesh.hpp"
+#include "Mesh/CElements.hpp"
+#include "Mesh/CRegion.hpp"
 
 #include "Physics/PhysModel.hpp"
 
@@ -98,6 +102,21 @@ RDM::BoundaryTerm& BoundaryConditions::create_boundary_condition( const std::str
   return *bterm;
 }
 
+void BoundaryConditions::mark_strong_nodes( std::vector<bool>& fixed )
+{
+  boost_foreach( BoundaryTerm& bc, find_components<BoundaryTerm>( *this ) )
+  {
+    if( bc.is_weak() )
+      continue;
+
+    boost_foreach( CRegion& region, bc.regions() )
+    {
+      boost_foreach( const Uint node, CElements::used_nodes(region).array() )
+        fixed[node] = true;
+    }
+  }
+}
+
 void BoundaryConditions::signal_create_boundary_condition ( SignalArgs& node )
 {
   SignalOptions options( node );
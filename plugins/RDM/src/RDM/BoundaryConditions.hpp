@@ -43,6 +43,11 @@ public: // functions
   RDM::BoundaryTerm& create_boundary_condition( const std::string& type,
                                                 const std::string& name,
                                                 const std::vector<Common::URI>& regions );
+
+  /// marks the nodes on which a strong boundary condition imposes the solution
+  /// @param [out] fixed  flag per node, set to true for those nodes
+  void mark_strong_nodes( std::vector<bool>& fixed );
+
   /// @name SIGNALS
   //@{
 
@@ -0,0 +1,146 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "Common/Log.hpp"
+#include "Common/CBuilder.hpp"
+#include "Common/OptionComponent.hpp"
+#include "Common/OptionT.hpp"
+#include "Common/Foreach.hpp"
+#include "Common/FindComponents.hpp"
+
+#include "Math/Checks.hpp"
+
+#include "Mesh/CField.hpp"
+#include "Mesh/CMesh.hpp"
+
+#include "Solver/CEigenLSS.hpp"
+
+#include "RDM/RDSolver.hpp"
+#include "RDM/BoundaryConditions.hpp"
+#include "RDM/DomainDiscretization.hpp"
+#include "RDM/CellTerm.hpp"
+#include "RDM/BwdEuler.hpp"
+
+
+using namespace CF::Common;
+using namespace CF::Mesh;
+using namespace CF::Math::Checks;
+
+namespace CF {
+namespace RDM {
+
+
+Common::ComponentBuilder < BwdEuler, CAction, LibRDM > BwdEuler_Builder;
+
+
+BwdEuler::BwdEuler ( const std::string& name ) :
+  CF::Solver::Action(name),
+  m_initial_norm(0.)
+{
+  mark_basic();
+
+  m_options.add_option< OptionT<Real> >( "cfl", 1.0 )
+      ->pretty_name("CFL")
+      ->description("Courant-Fredrichs-Levy number of the first pseudo-time step");
+
+  m_options.add_option< OptionT<Real> >( "max_cfl", 1.0E6 )
+      ->pretty_name("Maximum CFL")
+      ->description("Upper bound of the CFL number when it is ramped with the convergence");
+
+  m_properties.add_property( "cfl", Real(0.) );
+
+  m_lss = create_static_component_ptr<Solver::CEigenLSS>("LSS");
+}
+
+
+void BwdEuler::execute()
+{
+  RDSolver& mysolver = solver().as_type< RDSolver >();
+
+  if (m_solution.expired())
+    m_solution = mysolver.fields().get_child( RDM::Tags::solution() ).follow()->as_ptr_checked<CField>();
+  if (m_wave_speed.expired())
+    m_wave_speed = mysolver.fields().get_child( RDM::Tags::wave_speed() ).follow()->as_ptr_checked<CField>();
+  if (m_residual.expired())
+    m_residual = mysolver.fields().get_child( RDM::Tags::residual() ).follow()->as_ptr_checked<CField>();
+
+  CTable<Real>& solution     = m_solution.lock()->data();
+  CTable<Real>& wave_speed   = m_wave_speed.lock()->data();
+  CTable<Real>& residual     = m_residual.lock()->data();
+
+  const Uint nbdofs = solution.size();
+  const Uint nbvars = solution.row_size();
+
+  std::vector<bool> fixed( nbdofs, false );
+  mysolver.boundary_conditions().mark_strong_nodes( fixed );
+
+  // ramp the CFL with the residual norm of the free nodes
+
+  Real norm = 0.;
+  for ( Uint i=0; i< nbdofs; ++i )
+  {
+    if ( fixed[i] )
+      continue;
+    for ( Uint j=0; j< nbvars; ++j )
+      norm += residual[i][j] * residual[i][j];
+  }
+  norm = std::sqrt(norm);
+
+  if ( is_zero(m_initial_norm) )
+    m_initial_norm = norm;
+
+  const Real max_cfl = options().option("max_cfl").value<Real>();
+  const Real CFL = is_zero(norm) ? max_cfl :
+                   std::min( max_cfl, options().option("cfl").value<Real>() * m_initial_norm / norm );
+
+  property("cfl") = CFL;
+
+  // jacobian of the residual, assembled by the cell terms
+
+  Solver::CEigenLSS& lss = *m_lss;
+  lss.resize( nbdofs * nbvars );
+  lss.set_zero();
+
+  boost_foreach( CellTerm& term, find_components_recursively<CellTerm>( mysolver.domain_discretization() ) )
+    term.assemble_jacobian( lss );
+
+  // pseudo-time term and right hand side
+
+  RealVector& rhs = lss.rhs();
+  for ( Uint i=0; i< nbdofs; ++i )
+  {
+    const bool frozen = fixed[i] || is_zero(wave_speed[i][0]);
+    const Real diagonal = wave_speed[i][0] / CFL;
+
+    for ( Uint j=0; j< nbvars; ++j )
+    {
+      const Uint row = i*nbvars + j;
+      if ( frozen )
+      {
+        lss.at(row,row) = 1.;
+        lss.set_dirichlet_bc(row, 0.);
+      }
+      else
+      {
+        lss.at(row,row) += diagonal;
+        rhs[row] = - residual[i][j];
+      }
+    }
+  }
+
+  lss.solve();
+
+  // update the solution
+
+  const RealVector& dU = lss.solution();
+  for ( Uint i=0; i< nbdofs; ++i )
+    for ( Uint j=0; j< nbvars; ++j )
+      solution[i][j] += dU[i*nbvars + j];
+}
+
+
+} // RDM
+} // CF
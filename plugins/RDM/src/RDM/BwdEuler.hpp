@@ -0,0 +1,76 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_RDM_BwdEuler_hpp
+#define CF_RDM_BwdEuler_hpp
+
+#include "Solver/Action.hpp"
+
+#include "RDM/LibRDM.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh { class CField; }
+namespace Solver { class CEigenLSS; }
+namespace RDM {
+
+/// Implicit pseudo-time step for steady problems, a Newton iteration
+/// regularized by pseudo-transient continuation:
+///   ( wave_speed / CFL + dR/dU ) dU = - R
+/// The jacobian dR/dU is assembled by the cell terms in a jacobian pass,
+/// which computes it element by element with finite differences of the
+/// element residual. The CFL is ramped by switched evolution relaxation,
+/// growing with the ratio of the initial to the current residual norm,
+/// so the iteration tends to a Newton method as the solution converges. @n
+/// The nodes with a strong boundary condition keep their value.
+/// In parallel each process solves for its own nodes, which amounts to
+/// a block Jacobi approximation of the jacobian.
+class RDM_API BwdEuler : public CF::Solver::Action {
+
+public: // typedefs
+
+  /// pointers
+  typedef boost::shared_ptr<BwdEuler> Ptr;
+  typedef boost::shared_ptr<BwdEuler const> ConstPtr;
+
+public: // functions
+  /// Contructor
+  /// @param name of the component
+  BwdEuler ( const std::string& name );
+
+  /// Virtual destructor
+  virtual ~BwdEuler() {}
+
+  /// Get the class name
+  static std::string type_name () { return "BwdEuler"; }
+
+  /// execute the action
+  virtual void execute ();
+
+private: // data
+
+  /// solution field pointer
+  boost::weak_ptr<Mesh::CField> m_solution;
+  /// residual field pointer
+  boost::weak_ptr<Mesh::CField> m_residual;
+  /// wave_speed field pointer
+  boost::weak_ptr<Mesh::CField> m_wave_speed;
+
+  /// linear system of the newton iteration
+  boost::shared_ptr<Solver::CEigenLSS> m_lss;
+
+  /// residual norm of the first step, reference for the CFL ramping
+  Real m_initial_norm;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // RDM
+} // CF
+
+#endif // CF_RDM_BwdEuler_hpp
@@ -9,6 +9,8 @@
 
 #include "Mesh/CField.hpp"
 
+#include "Solver/CEigenLSS.hpp"
+
 #include "RDM/ElementLoop.hpp"
 #include "RDM/SupportedCells.hpp"
 #include "RDM/CellTerm.hpp"
@@ -141,6 +143,10 @@ struct CellLoopT : public CellLoop
     // parametrization of the numerical term
     typedef typename ACTION::template Term< SF, QD, PHYS > TermT;
 
+    // in a jacobian pass the terms assemble the element jacobians instead of the residual
+
+    Solver::CEigenLSS::Ptr lss = parent().as_type<CellTerm>().jacobian_system();
+
     // loop on the (sub)regions that hold elements of this type
 
     boost_foreach(Mesh::CElements& elements,
@@ -153,10 +159,21 @@ struct CellLoopT : public CellLoop
       term.set_elements(elements);
 
       const Uint nb_elem = elements.size();
-      for ( Uint elem = 0; elem != nb_elem; ++elem )
+      if( is_null(lss) )
       {
-        term.select_loop_idx(elem);
-        term.execute();
+        for ( Uint elem = 0; elem != nb_elem; ++elem )
+        {
+          term.select_loop_idx(elem);
+          term.execute();
+        }
+      }
+      else
+      {
+        for ( Uint elem = 0; elem != nb_elem; ++elem )
+        {
+          term.select_loop_idx(elem);
+          term.assemble_jacobian(*lss);
+        }
       }
     }
   }
@@ -0,0 +1,88 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_RDM_CellLoopBatch_hpp
+#define CF_RDM_CellLoopBatch_hpp
+
+#include "RDM/CellLoop.hpp"
+
+namespace CF {
+namespace RDM {
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+/// CellLoopBatch defines a functor taking the type that boost::mpl::for_each passes.
+/// It is the host counterpart of CellLoopGPU: the elements are handed to the term
+/// in batches of TermT::batch_size consecutive elements, which the term gathers
+/// into fixed width arrays to compute them together with vector instructions.
+/// The term must provide execute_batch( first, count ).
+template < typename ACTION, typename PHYS>
+struct CellLoopBatch : public CellLoop
+{
+  /// Constructor
+  CellLoopBatch( const std::string& name ) : CellLoop(name) {  regist_typeinfo(this); }
+
+  /// Get the class name
+  static std::string type_name () { return "CellLoopBatch<" + ACTION::type_name() + "," + PHYS::type_name() + ">"; }
+
+  /// execute the action
+  virtual void execute ()
+  {
+    boost::mpl::for_each< typename RDM::CellTypes< PHYS::MODEL::_ndim >::Cells >( boost::ref(*this) );
+  }
+
+  /// operator needed for the loop over element types (SF)
+  template < typename SF >
+  void operator() ( SF& )
+  {
+    if( is_null(parent().as_ptr<ACTION>()) )
+      throw Common::SetupError(FromHere(), type_name() + " was intantiated with wrong action");
+
+    // definition of the quadrature type
+    typedef typename RDM::DefaultQuadrature<SF>::type QD;
+    // parametrization of the numerical term
+    typedef typename ACTION::template Term< SF, QD, PHYS > TermT;
+
+    // in a jacobian pass the terms assemble the element jacobians instead of the residual
+
+    Solver::CEigenLSS::Ptr lss = parent().as_type<CellTerm>().jacobian_system();
+
+    // loop on the (sub)regions that hold elements of this type
+
+    boost_foreach(Mesh::CElements& elements,
+                  Common::find_components_recursively_with_filter<Mesh::CElements>(*current_region,IsElementType<SF>()))
+    {
+
+      TermT& term = this->access_term<TermT>();
+
+      // point the term to the elements of the (sub)region
+      term.set_elements(elements);
+
+      const Uint nb_elem = elements.size();
+      if( is_null(lss) )
+      {
+        for ( Uint first = 0; first < nb_elem; first += TermT::batch_size )
+          term.execute_batch( first, std::min( Uint(TermT::batch_size), nb_elem - first ) );
+      }
+      else
+      {
+        for ( Uint elem = 0; elem != nb_elem; ++elem )
+        {
+          term.select_loop_idx(elem);
+          term.assemble_jacobian(*lss);
+        }
+      }
+    }
+  }
+
+}; // CellLoopBatch
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+} // RDM
+} // CF
+
+#endif // CF_RDM_CellLoopBatch_hpp
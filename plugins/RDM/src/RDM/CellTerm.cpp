@@ -9,6 +9,8 @@
 
 #include "Mesh/CField.hpp"
 
+#include "Solver/CEigenLSS.hpp"
+
 #include "Physics/PhysModel.hpp"
 #include "Physics/Variables.hpp"
 
@@ -66,7 +68,8 @@ void CellTerm::link_fields()
   }
 }
 
-ElementLoop& CellTerm::access_element_loop( const std::string& type_name )
+ElementLoop& CellTerm::access_element_loop( const std::string& type_name,
+                                            const std::string& loop_type )
 {
   // ensure that the fields are present
 
@@ -83,7 +86,7 @@ ElementLoop& CellTerm::access_element_loop( const std::string& type_name )
                         .as_type<Physics::Variables>()
                         .type();
 
-    loop = build_component_abstract_type_reduced< CellLoop >( "CellLoopT<" + type_name + "," + update_vars_type + ">" , "LOOP");
+    loop = build_component_abstract_type_reduced< CellLoop >( loop_type + "<" + type_name + "," + update_vars_type + ">" , "LOOP");
     add_component(loop);
   }
   else
@@ -92,6 +95,23 @@ ElementLoop& CellTerm::access_element_loop( const std::string& type_name )
   return *loop;
 }
 
+void CellTerm::assemble_jacobian( Solver::CEigenLSS& lss )
+{
+  m_jacobian_system = lss.as_ptr<Solver::CEigenLSS>();
+
+  try
+  {
+    execute();
+  }
+  catch(...)
+  {
+    m_jacobian_system.reset();
+    throw;
+  }
+
+  m_jacobian_system.reset();
+}
+
 
 /////////////////////////////////////////////////////////////////////////////////////
 
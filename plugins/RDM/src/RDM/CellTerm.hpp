@@ -14,6 +14,7 @@
 namespace CF {
 
 namespace Mesh { class CField; }
+namespace Solver { class CEigenLSS; }
 
 namespace RDM {
 
@@ -41,7 +42,19 @@ public: // functions
   /// Get the class name
   static std::string type_name () { return "CellTerm"; }
 
-  ElementLoop& access_element_loop( const std::string& type_name );
+  /// Access the element loop of this term, creating it if it does not exist
+  /// @param type_name  name of the term type, parametrizing the loop
+  /// @param loop_type  name of the loop template, CellLoopT or an alternative loop
+  ElementLoop& access_element_loop( const std::string& type_name,
+                                    const std::string& loop_type = "CellLoopT" );
+
+  /// Executes the term in a jacobian pass, where the residual and wave speed fields
+  /// are left untouched and the jacobian of the residual to the solution is
+  /// assembled into the system instead
+  void assemble_jacobian( Solver::CEigenLSS& lss );
+
+  /// @returns the system of the jacobian pass being executed, null outside of one
+  boost::shared_ptr<Solver::CEigenLSS> jacobian_system() const { return m_jacobian_system.lock(); }
 
   /// @name ACCESSORS
   //@{
@@ -66,6 +79,8 @@ protected: // data
 
   boost::weak_ptr<Mesh::CField> m_wave_speed;   ///< access to the wave_speed field
 
+  boost::weak_ptr<Solver::CEigenLSS> m_jacobian_system; ///< system of the current jacobian pass
+
 };
 
 /////////////////////////////////////////////////////////////////////////////////////
@@ -46,6 +46,20 @@ FwdEuler::FwdEuler ( const std::string& name ) :
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+/// Warns about the residuals of a node that is not updated, for lack of wave speed
+void warn_null_wave_speed(const CTable<Real>& residual, const Uint i)
+{
+  for ( Uint j=0; j< residual.row_size(); ++j )
+    if( is_not_zero(residual[i][j]) )
+      CFwarn << "residual not null but wave_speed null at node [" << i << "] variable [" << j << "]" << CFendl;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
 void FwdEuler::execute()
 {
   RDSolver& mysolver = solver().as_type< RDSolver >();
@@ -65,13 +79,32 @@ void FwdEuler::execute()
 
   const Uint nbdofs = solution.size();
   const Uint nbvars = solution.row_size();
+
+  // with the SoA layout, one contiguous loop per variable
+
+  if (solution.layout() == CTable<Real>::SOA && residual.layout() == CTable<Real>::SOA)
+  {
+    const CTable<Real>::ConstColumn ws = wave_speed.column(0);
+    for ( Uint i=0; i< nbdofs; ++i )
+      if ( is_zero(ws[i]) )
+        warn_null_wave_speed(residual,i);
+
+    for ( Uint j=0; j< nbvars; ++j )
+    {
+      Real* u = solution.column(j).values;
+      const Real* r = residual.column(j).values;
+      for ( Uint i=0; i< nbdofs; ++i )
+        if ( is_not_zero(ws[i]) )
+          u[i] += - ( CFL / ws[i] ) * r[i];
+    }
+    return;
+  }
+
   for ( Uint i=0; i< nbdofs; ++i )
   {
     if ( is_zero(wave_speed[i][0]) )
     {
-      for ( Uint j=0; j< nbvars; ++j )
-        if( is_not_zero(residual[i][j]) )
-          CFwarn << "residual not null but wave_speed null at node [" << i << "] variable [" << j << "]" << CFendl;
+      warn_null_wave_speed(residual,i);
       continue;
     }
 
@@ -0,0 +1,551 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <set>
+
+#include <Eigen/LU>
+
+#include "Common/Log.hpp"
+#include "Common/CBuilder.hpp"
+#include "Common/OptionT.hpp"
+#include "Common/Foreach.hpp"
+#include "Common/FindComponents.hpp"
+#include "Common/BasicExceptions.hpp"
+#include "Common/StringConversion.hpp"
+#include "Common/MPI/PE.hpp"
+
+#include "Math/Checks.hpp"
+#include "Math/Consts.hpp"
+
+#include "Mesh/CField.hpp"
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/CElements.hpp"
+#include "Mesh/CNodes.hpp"
+#include "Mesh/ElementType.hpp"
+
+#include "RDM/RDSolver.hpp"
+#include "RDM/BoundaryConditions.hpp"
+#include "RDM/DomainDiscretization.hpp"
+#include "RDM/Multigrid.hpp"
+
+
+using namespace CF::Common;
+using namespace CF::Mesh;
+using namespace CF::Math::Checks;
+
+namespace CF {
+namespace RDM {
+
+
+Common::ComponentBuilder < Multigrid, CAction, LibRDM > Multigrid_Builder;
+
+
+Multigrid::Multigrid ( const std::string& name ) :
+  CF::Solver::Action(name),
+  m_residual_current(false),
+  m_nb_cycles(0),
+  m_initial_norm(0.)
+{
+  mark_basic();
+
+  m_properties.add_property( "convergence_rate", Real(0.) );
+
+  m_options.add_option< OptionT<Real> >( "cfl", 1.0 )
+      ->pretty_name("CFL")
+      ->description("Courant-Fredrichs-Levy stability number of the smoothing steps on the finest level");
+
+  m_options.add_option< OptionT<Real> >( "relaxation", 0.7 )
+      ->pretty_name("Relaxation")
+      ->description("Damping of the block Jacobi smoothing steps on the coarse levels");
+
+  m_options.add_option< OptionT<Uint> >( "nb_levels", 4u )
+      ->pretty_name("Number of Levels")
+      ->description("Maximum number of levels, including the finest");
+
+  m_options.add_option< OptionT<Uint> >( "cycle_index", 1u )
+      ->pretty_name("Cycle Index")
+      ->description("Number of visits of each coarse level per cycle (1 for V cycles, 2 for W cycles)");
+
+  m_options.add_option< OptionT<Uint> >( "pre_smoothing", 1u )
+      ->pretty_name("Pre-Smoothing Steps")
+      ->description("Smoothing steps on each level before visiting the coarser level");
+
+  m_options.add_option< OptionT<Uint> >( "post_smoothing", 1u )
+      ->pretty_name("Post-Smoothing Steps")
+      ->description("Smoothing steps on each level after visiting the coarser level");
+
+  m_options.add_option< OptionT<Uint> >( "operator_period", 0u )
+      ->pretty_name("Operator Period")
+      ->description("Cycles between two updates of the coarse operators, "
+                    "0 to keep the ones of the first cycle (exact for linear problems)");
+
+  m_options.add_option< OptionT<Real> >( "max_convergence_rate", 0. )
+      ->pretty_name("Maximum Convergence Rate")
+      ->description("Fail when the mean reduction of the residual per cycle exceeds this value "
+                    "from the fifth cycle on, 0 to disable the check");
+}
+
+
+void Multigrid::build_levels()
+{
+  m_levels.clear();
+
+  const Uint nb_nodes = m_solution.lock()->data().size();
+
+  // graph of the nodes, connected through the cells
+
+  std::vector< std::set<Uint> > graph(nb_nodes);
+
+  boost_foreach( const CElements& elements, find_components_recursively<CElements>( mesh().topology() ) )
+  {
+    if( elements.element_type().dimensionality() != elements.element_type().dimension() )
+      continue;
+
+    boost_foreach( CTable<Uint>::ConstRow nodes, elements.node_connectivity().array() )
+    {
+      for(Uint a = 0; a < nodes.size(); ++a)
+        for(Uint b = 0; b < nodes.size(); ++b)
+          if( a != b )
+            graph[ nodes[a] ].insert( nodes[b] );
+    }
+  }
+
+  m_neighbours.resize(nb_nodes);
+  for(Uint i = 0; i < nb_nodes; ++i)
+    m_neighbours[i].assign( graph[i].begin(), graph[i].end() );
+
+  // distance-2 colouring of the free nodes: the residuals changed by
+  // perturbing the nodes of one colour do not overlap
+
+  std::vector<Uint> colour( nb_nodes, Math::Consts::uint_max() );
+  std::vector<Uint> stamp;
+  m_colours.clear();
+  for(Uint i = 0; i < nb_nodes; ++i)
+  {
+    if( m_fixed[i] )
+      continue;
+
+    stamp.assign( m_colours.size(), Math::Consts::uint_max() );
+    boost_foreach( const Uint j, m_neighbours[i] )
+    {
+      if( colour[j] != Math::Consts::uint_max() )
+        stamp[ colour[j] ] = i;
+      boost_foreach( const Uint k, m_neighbours[j] )
+        if( colour[k] != Math::Consts::uint_max() )
+          stamp[ colour[k] ] = i;
+    }
+
+    Uint c = 0;
+    while( c < m_colours.size() && stamp[c] == i )
+      ++c;
+    if( c == m_colours.size() )
+      m_colours.push_back( std::vector<Uint>() );
+
+    colour[i] = c;
+    m_colours[c].push_back(i);
+  }
+
+  // agglomerate of each node of the finest level, through all the levels
+
+  std::vector<Uint> node_agglomerate(nb_nodes);
+  for(Uint i = 0; i < nb_nodes; ++i)
+    node_agglomerate[i] = i;
+
+  const Uint max_levels = option("nb_levels").value<Uint>();
+
+  while( m_levels.size() + 1 < max_levels )
+  {
+    const Uint nb_vertices = graph.size();
+
+    // each vertex that is not agglomerated yet seeds an agglomerate
+    // with its neighbours that are not agglomerated yet
+
+    std::vector<Uint> agglomerate( nb_vertices, Math::Consts::uint_max() );
+    Uint nb_agglomerates = 0;
+    for(Uint v = 0; v < nb_vertices; ++v)
+    {
+      if( agglomerate[v] != Math::Consts::uint_max() )
+        continue;
+
+      agglomerate[v] = nb_agglomerates;
+      boost_foreach( const Uint w, graph[v] )
+        if( agglomerate[w] == Math::Consts::uint_max() )
+          agglomerate[w] = nb_agglomerates;
+
+      ++nb_agglomerates;
+    }
+
+    if( nb_agglomerates == nb_vertices || nb_agglomerates < 2 )
+      break; // the graph cannot be coarsened further
+
+    // graph of the agglomerates
+
+    std::vector< std::set<Uint> > coarse_graph(nb_agglomerates);
+    for(Uint v = 0; v < nb_vertices; ++v)
+      boost_foreach( const Uint w, graph[v] )
+        if( agglomerate[v] != agglomerate[w] )
+          coarse_graph[ agglomerate[v] ].insert( agglomerate[w] );
+
+    Level level;
+    level.coarsening = agglomerate;
+    level.agglomerate.resize(nb_nodes);
+    level.sizes.assign(nb_agglomerates, 0u);
+    for(Uint i = 0; i < nb_nodes; ++i)
+    {
+      node_agglomerate[i] = agglomerate[ node_agglomerate[i] ];
+      level.agglomerate[i] = node_agglomerate[i];
+      ++level.sizes[ node_agglomerate[i] ];
+    }
+
+    m_levels.push_back(level);
+    graph.swap(coarse_graph);
+
+    CFinfo << "multigrid level " << m_levels.size() << " has " << nb_agglomerates << " agglomerates" << CFendl;
+  }
+}
+
+
+void Multigrid::build_operators()
+{
+  if( m_levels.empty() )
+    return;
+
+  CTable<Real>& solution   = m_solution.lock()->data();
+  CTable<Real>& residual   = m_residual.lock()->data();
+  CTable<Real>& wave_speed = m_wave_speed.lock()->data();
+
+  const Uint nbdofs = solution.size();
+  const Uint nbvars = solution.row_size();
+
+  // keep the current state, which is restored at the end
+
+  if( !m_residual_current )
+    compute_residual();
+
+  const CTable<Real>::ArrayT solution_0   = solution.array();
+  const CTable<Real>::ArrayT residual_0   = residual.array();
+  const CTable<Real>::ArrayT wave_speed_0 = wave_speed.array();
+
+  Real scale = 1.;
+  for( Uint i = 0; i < nbdofs; ++i )
+    for( Uint j = 0; j < nbvars; ++j )
+      scale = std::max( scale, std::abs( solution_0[i][j] ) );
+  const Real eps = 1e-7 * scale;
+
+  boost_foreach( Level& lvl, m_levels )
+  {
+    lvl.operator_blocks.assign( lvl.sizes.size(), std::map<Uint,RealMatrix>() );
+    lvl.diagonal_inverse.assign( lvl.sizes.size(), RealMatrix() );
+  }
+
+  // each evaluation gives the column v of the jacobian blocks of all the nodes of one colour
+
+  RealVector column(nbvars);
+  for( Uint c = 0; c < m_colours.size(); ++c )
+  {
+    for( Uint v = 0; v < nbvars; ++v )
+    {
+      solution.array() = solution_0;
+      boost_foreach( const Uint j, m_colours[c] )
+        solution[j][v] += eps;
+
+      compute_residual();
+
+      boost_foreach( const Uint j, m_colours[c] )
+      {
+        for( Uint n = 0; n <= m_neighbours[j].size(); ++n )
+        {
+          const Uint k = n < m_neighbours[j].size() ? m_neighbours[j][n] : j;
+          if( m_fixed[k] )
+            continue;
+
+          for( Uint var = 0; var < nbvars; ++var )
+            column[var] = ( residual[k][var] - residual_0[k][var] ) / eps;
+
+          boost_foreach( Level& lvl, m_levels )
+          {
+            RealMatrix& block = lvl.operator_blocks[ lvl.agglomerate[k] ][ lvl.agglomerate[j] ];
+            if( block.size() == 0 )
+              block.setZero( nbvars, nbvars );
+            block.col(v) += column;
+          }
+        }
+      }
+    }
+  }
+
+  solution.array()   = solution_0;
+  residual.array()   = residual_0;
+  wave_speed.array() = wave_speed_0;
+  m_residual_current = true;
+
+  boost_foreach( Level& lvl, m_levels )
+  {
+    for( Uint a = 0; a < lvl.sizes.size(); ++a )
+    {
+      std::map<Uint,RealMatrix>::const_iterator diagonal = lvl.operator_blocks[a].find(a);
+      if( diagonal == lvl.operator_blocks[a].end() )
+        continue;
+
+      const Eigen::FullPivLU<RealMatrix> lu( diagonal->second );
+      if( lu.isInvertible() )
+        lvl.diagonal_inverse[a] = lu.inverse();
+    }
+  }
+}
+
+
+void Multigrid::restrict_sum( const Uint level, const CTable<Real>& fine, RealMatrix& coarse ) const
+{
+  cf_assert( level > 0 && level <= m_levels.size() );
+  const Level& lvl = m_levels[level-1];
+
+  coarse.resize( lvl.sizes.size(), fine.row_size() );
+  coarse.setZero();
+
+  const Uint nb_nodes = fine.size();
+  for(Uint i = 0; i < nb_nodes; ++i)
+  {
+    if( m_fixed[i] )
+      continue;
+
+    CTable<Real>::ConstRow row = fine[i];
+    for(Uint j = 0; j < row.size(); ++j)
+      coarse( lvl.agglomerate[i], j ) += row[j];
+  }
+}
+
+
+void Multigrid::prolongate_add( const Uint level, const RealMatrix& coarse, CTable<Real>& fine ) const
+{
+  cf_assert( level > 0 && level <= m_levels.size() );
+  const Level& lvl = m_levels[level-1];
+
+  const Uint nb_nodes = fine.size();
+  for(Uint i = 0; i < nb_nodes; ++i)
+  {
+    if( m_fixed[i] )
+      continue;
+
+    CTable<Real>::Row row = fine[i];
+    for(Uint j = 0; j < row.size(); ++j)
+      row[j] += coarse( lvl.agglomerate[i], j );
+  }
+}
+
+
+void Multigrid::compute_residual()
+{
+  RDSolver& mysolver = solver().as_type< RDSolver >();
+
+  m_residual.lock()->data()   = 0.;
+  m_wave_speed.lock()->data() = 0.;
+
+  mysolver.domain_discretization().execute();
+  mysolver.boundary_conditions().execute();
+
+  m_residual_current = true;
+}
+
+
+Real Multigrid::residual_norm() const
+{
+  const CTable<Real>& residual = m_residual.lock()->data();
+  const CNodes& nodes = mesh().nodes();
+
+  Real norm = 0.;
+  for ( Uint i=0; i < residual.size(); ++i )
+  {
+    if ( m_fixed[i] || nodes.is_ghost(i) )
+      continue;
+
+    for ( Uint j=0; j < residual.row_size(); ++j )
+      norm += residual[i][j] * residual[i][j];
+  }
+
+  if ( mpi::PE::instance().is_active() )
+  {
+    Real local = norm;
+    mpi::PE::instance().all_reduce( mpi::plus(), &local, 1, &norm );
+  }
+
+  return std::sqrt(norm);
+}
+
+
+void Multigrid::smooth_fine()
+{
+  if( !m_residual_current )
+    compute_residual();
+
+  CTable<Real>& solution     = m_solution.lock()->data();
+  CTable<Real>& wave_speed   = m_wave_speed.lock()->data();
+  CTable<Real>& residual     = m_residual.lock()->data();
+
+  const Real CFL = options().option("cfl").value<Real>();
+
+  const Uint nbdofs = solution.size();
+  const Uint nbvars = solution.row_size();
+  for ( Uint i=0; i< nbdofs; ++i )
+  {
+    // the strong boundary conditions set the solution of their nodes
+    if ( m_fixed[i] || is_zero(wave_speed[i][0]) )
+      continue;
+
+    const Real update = CFL / wave_speed[i][0];
+    for ( Uint j=0; j< nbvars; ++j )
+      solution[i][j] += - update * residual[i][j];
+  }
+
+  m_residual_current = false;
+
+  solver().as_type< RDSolver >().actions().get_child("Synchronize").as_type<CAction>().execute();
+}
+
+
+void Multigrid::coarse_residual( const Uint level, RealMatrix& residual ) const
+{
+  const Level& lvl = m_levels[level-1];
+
+  residual = lvl.forcing;
+  for ( Uint a=0; a < lvl.sizes.size(); ++a )
+  {
+    for ( std::map<Uint,RealMatrix>::const_iterator block = lvl.operator_blocks[a].begin(); block != lvl.operator_blocks[a].end(); ++block )
+      residual.row(a) += ( block->second * lvl.correction.row(block->first).transpose() ).transpose();
+  }
+}
+
+
+void Multigrid::smooth_coarse( const Uint level )
+{
+  Level& lvl = m_levels[level-1];
+
+  RealMatrix residual;
+  coarse_residual( level, residual );
+
+  const Real relaxation = options().option("relaxation").value<Real>();
+
+  for ( Uint a=0; a < lvl.sizes.size(); ++a )
+  {
+    if ( lvl.diagonal_inverse[a].size() == 0 )
+      continue;
+
+    lvl.correction.row(a) -= relaxation * ( lvl.diagonal_inverse[a] * residual.row(a).transpose() ).transpose();
+  }
+}
+
+
+void Multigrid::cycle( const Uint level )
+{
+  const Uint pre_smoothing  = option("pre_smoothing").value<Uint>();
+  const Uint post_smoothing = option("post_smoothing").value<Uint>();
+  const Uint cycle_index    = option("cycle_index").value<Uint>();
+
+  for ( Uint s=0; s < pre_smoothing; ++s )
+    level == 0 ? smooth_fine() : smooth_coarse(level);
+
+  if ( level + 1 < nb_levels() )
+  {
+    Level& coarse = m_levels[level];
+
+    // the coarse level is forced by the residual of this level
+
+    if ( level == 0 )
+    {
+      if( !m_residual_current )
+        compute_residual();
+      restrict_sum( 1, m_residual.lock()->data(), coarse.forcing );
+    }
+    else
+    {
+      RealMatrix residual;
+      coarse_residual( level, residual );
+
+      coarse.forcing.setZero( coarse.sizes.size(), residual.cols() );
+      for ( Uint v=0; v < coarse.coarsening.size(); ++v )
+        coarse.forcing.row( coarse.coarsening[v] ) += residual.row(v);
+    }
+
+    coarse.correction.setZero( coarse.forcing.rows(), coarse.forcing.cols() );
+
+    for ( Uint c=0; c < cycle_index; ++c )
+      cycle(level + 1);
+
+    // prolongation of the correction
+
+    if ( level == 0 )
+    {
+      prolongate_add( 1, coarse.correction, m_solution.lock()->data() );
+      m_residual_current = false;
+      solver().as_type< RDSolver >().actions().get_child("Synchronize").as_type<CAction>().execute();
+    }
+    else
+    {
+      RealMatrix& correction = m_levels[level-1].correction;
+      for ( Uint v=0; v < coarse.coarsening.size(); ++v )
+        correction.row(v) += coarse.correction.row( coarse.coarsening[v] );
+    }
+  }
+
+  for ( Uint s=0; s < post_smoothing; ++s )
+    level == 0 ? smooth_fine() : smooth_coarse(level);
+}
+
+
+void Multigrid::execute()
+{
+  RDSolver& mysolver = solver().as_type< RDSolver >();
+
+  if (m_solution.expired())
+    m_solution = mysolver.fields().get_child( RDM::Tags::solution() ).follow()->as_ptr_checked<CField>();
+  if (m_wave_speed.expired())
+    m_wave_speed = mysolver.fields().get_child( RDM::Tags::wave_speed() ).follow()->as_ptr_checked<CField>();
+  if (m_residual.expired())
+    m_residual = mysolver.fields().get_child( RDM::Tags::residual() ).follow()->as_ptr_checked<CField>();
+
+  // the iterative solver has just computed the residual of the current solution
+
+  m_residual_current = true;
+
+  const Uint nb_nodes = m_solution.lock()->data().size();
+  if ( m_fixed.size() != nb_nodes )
+  {
+    m_fixed.assign( nb_nodes, false );
+    mysolver.boundary_conditions().mark_strong_nodes( m_fixed );
+
+    build_levels();
+    m_nb_cycles = 0;
+  }
+
+  const Uint operator_period = option("operator_period").value<Uint>();
+  if ( m_nb_cycles == 0 || ( operator_period > 0 && m_nb_cycles % operator_period == 0 ) )
+    build_operators();
+
+  // convergence rate since the first cycle
+
+  const Real norm = residual_norm();
+  if ( m_nb_cycles == 0 )
+    m_initial_norm = norm;
+  else if ( m_initial_norm > 0. )
+  {
+    const Real rate = std::pow( norm / m_initial_norm, 1. / m_nb_cycles );
+    configure_property( "convergence_rate", rate );
+
+    const Real max_rate = option("max_convergence_rate").value<Real>();
+    if ( max_rate > 0. && m_nb_cycles >= 5 && rate > max_rate )
+      throw FailedToConverge( FromHere(), "Multigrid convergence rate " + to_str(rate)
+                              + " exceeds " + to_str(max_rate) + " after " + to_str(m_nb_cycles) + " cycles" );
+  }
+
+  cycle(0);
+
+  ++m_nb_cycles;
+}
+
+
+} // RDM
+} // CF
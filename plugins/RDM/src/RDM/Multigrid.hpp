@@ -0,0 +1,164 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_RDM_Multigrid_hpp
+#define CF_RDM_Multigrid_hpp
+
+#include <map>
+
+#include "Math/MatrixTypes.hpp"
+
+#include "Mesh/CTable.hpp"
+
+#include "Solver/Action.hpp"
+
+#include "RDM/LibRDM.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh { class CField; }
+namespace RDM {
+
+/// Agglomeration multigrid cycle, used as update step of the IterativeSolver
+/// in place of FwdEuler to accelerate the convergence to steady state. @n
+/// The coarse levels are built by agglomerating the nodes of the mesh, each
+/// node with its free neighbours in the graph of the cell connectivity, and
+/// recursively the agglomerates of each level. @n
+/// The smoother of the finest level is a forward Euler step of the domain
+/// discretization. The coarse levels solve for a piecewise constant correction
+/// with their own operator, the Galerkin projection R J P of the jacobian J of
+/// the fine residual, where the restriction R sums over the agglomerates and the
+/// prolongation P injects the correction of an agglomerate in all its nodes.
+/// The jacobian is measured by perturbing the solution of groups of nodes that
+/// share no cell neighbour, so one evaluation of the residual per group and
+/// variable gives all its columns. A coarse level only restricts the residual of
+/// the next finer level, which is its forcing, and smooths its correction with
+/// damped block Jacobi steps: the fine discretization is only evaluated on the
+/// finest level. @n
+/// The mean reduction of the residual per cycle is kept in the property
+/// "convergence_rate".
+class RDM_API Multigrid : public CF::Solver::Action {
+
+public: // typedefs
+
+  /// pointers
+  typedef boost::shared_ptr<Multigrid> Ptr;
+  typedef boost::shared_ptr<Multigrid const> ConstPtr;
+
+public: // functions
+  /// Contructor
+  /// @param name of the component
+  Multigrid ( const std::string& name );
+
+  /// Virtual destructor
+  virtual ~Multigrid() {}
+
+  /// Get the class name
+  static std::string type_name () { return "Multigrid"; }
+
+  /// execute the action
+  /// @throw Common::FailedToConverge if the convergence rate exceeds the option "max_convergence_rate"
+  virtual void execute ();
+
+  /// number of levels built, including the finest
+  Uint nb_levels() const { return m_levels.size() + 1; }
+
+  /// restricts the fine data to a coarse level, summing the rows over each agglomerate
+  /// @param [in] level  coarse level, starting from 1
+  /// @param [in] fine   data of the finest level, one row per node
+  /// @param [out] coarse data of the level, one row per agglomerate
+  void restrict_sum ( const Uint level, const Mesh::CTable<Real>& fine, RealMatrix& coarse ) const;
+
+  /// prolongates a correction of a coarse level, adding it to the nodes of each agglomerate
+  /// @param [in] level   coarse level, starting from 1
+  /// @param [in] coarse  correction of the level, one row per agglomerate
+  /// @param [in,out] fine data of the finest level, one row per node
+  void prolongate_add ( const Uint level, const RealMatrix& coarse, Mesh::CTable<Real>& fine ) const;
+
+private: // helper functions
+
+  /// builds the agglomerates of the coarse levels
+  void build_levels ();
+
+  /// builds the operators of the coarse levels from the jacobian of the fine residual
+  void build_operators ();
+
+  /// applies a multigrid cycle starting at the given level
+  void cycle ( const Uint level );
+
+  /// applies one forward Euler step on the finest level
+  void smooth_fine ();
+
+  /// applies one damped block Jacobi step to the correction of a coarse level
+  void smooth_coarse ( const Uint level );
+
+  /// residual of the correction of a coarse level, including its forcing
+  void coarse_residual ( const Uint level, RealMatrix& residual ) const;
+
+  /// evaluates the residual and wave speed of the current solution
+  void compute_residual ();
+
+  /// L2 norm of the residual of the free nodes over all processes
+  Real residual_norm () const;
+
+private: // types
+
+  /// sparse matrix with one block per pair of agglomerates
+  typedef std::vector< std::map<Uint,RealMatrix> > BlockMatrix;
+
+  /// agglomeration of the nodes into one coarse level
+  struct Level
+  {
+    std::vector<Uint> agglomerate;  ///< agglomerate of each node of the finest level
+    std::vector<Uint> coarsening;   ///< agglomerate of each vertex of the next finer level
+    std::vector<Uint> sizes;        ///< number of nodes of the finest level in each agglomerate
+
+    BlockMatrix operator_blocks;        ///< Galerkin projection of the fine jacobian
+    std::vector<RealMatrix> diagonal_inverse;  ///< inverse of the diagonal blocks, empty if singular
+
+    RealMatrix forcing;     ///< restricted residual of the next finer level
+    RealMatrix correction;  ///< piecewise constant correction
+  };
+
+private: // data
+
+  /// solution field pointer
+  boost::weak_ptr<Mesh::CField> m_solution;
+  /// residual field pointer
+  boost::weak_ptr<Mesh::CField> m_residual;
+  /// wave_speed field pointer
+  boost::weak_ptr<Mesh::CField> m_wave_speed;
+
+  /// coarse levels, the finest level being the mesh itself
+  std::vector<Level> m_levels;
+
+  /// neighbours of each node of the finest level through the cells
+  std::vector< std::vector<Uint> > m_neighbours;
+
+  /// groups of free nodes without common neighbour, perturbed together to measure the jacobian
+  std::vector< std::vector<Uint> > m_colours;
+
+  /// nodes with a strong boundary condition, left out of the coarse corrections
+  std::vector<bool> m_fixed;
+
+  /// true when the residual field corresponds to the current solution
+  bool m_residual_current;
+
+  /// cycles done since the levels were built
+  Uint m_nb_cycles;
+
+  /// residual norm before the first cycle
+  Real m_initial_norm;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // RDM
+} // CF
+
+#endif // CF_RDM_Multigrid_hpp
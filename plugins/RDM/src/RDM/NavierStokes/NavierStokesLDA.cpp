@@ -7,6 +7,7 @@
 #include "Common/CBuilder.hpp"
 
 #include "RDM/Schemes/LDA.hpp"
+#include "RDM/Schemes/LDABatch.hpp"
 
 #include "RDM/SupportedCells.hpp" // supported cells
 
@@ -32,6 +33,16 @@ Common::ComponentBuilder < CellLoopT<LDA,Physics::NavierStokes::Cons3D> ,
                            LibNavierStokes >
                            LDA_Euler3D_Builder;
 
+Common::ComponentBuilder < CellLoopBatch<LDABatch,Physics::NavierStokes::Cons2D> ,
+                           RDM::CellLoop,
+                           LibNavierStokes >
+                           LDABatch_Euler2D_Builder;
+
+Common::ComponentBuilder < CellLoopBatch<LDABatch,Physics::NavierStokes::Cons3D> ,
+                           RDM::CellLoop,
+                           LibNavierStokes >
+                           LDABatch_Euler3D_Builder;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 } // RDM
@@ -7,6 +7,7 @@
 #include "Common/CBuilder.hpp"
 
 #include "RDM/Schemes/LDA.hpp"
+#include "RDM/Schemes/LDABatch.hpp"
 
 #include "RDM/SupportedCells.hpp" // supported cells
 
@@ -40,6 +41,22 @@ Common::ComponentBuilder < CellLoopT<LDA, Physics::Scalar::RotationAdv2D>,
                            RDM::CellLoop,
                            LibScalar > LDA_RotationAdv2D_Builder;
 
+Common::ComponentBuilder < CellLoopBatch<LDABatch, Physics::Scalar::LinearAdv2D>,
+                           RDM::CellLoop,
+                           LibScalar > LDABatch_LinearAdv2D_Builder;
+
+Common::ComponentBuilder < CellLoopBatch<LDABatch, Physics::Scalar::LinearAdv3D>,
+                           RDM::CellLoop,
+                           LibScalar > LDABatch_LinearAdv3D_Builder;
+
+Common::ComponentBuilder < CellLoopBatch<LDABatch, Physics::Scalar::LinearAdvSys2D>,
+                           RDM::CellLoop,
+                           LibScalar > LDABatch_LinearAdvSys2D_Builder;
+
+Common::ComponentBuilder < CellLoopBatch<LDABatch, Physics::Scalar::RotationAdv2D>,
+                           RDM::CellLoop,
+                           LibScalar > LDABatch_RotationAdv2D_Builder;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 } // RDM
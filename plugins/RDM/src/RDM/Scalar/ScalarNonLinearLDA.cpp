@@ -7,6 +7,7 @@
 #include "Common/CBuilder.hpp"
 
 #include "RDM/Schemes/LDA.hpp"
+#include "RDM/Schemes/LDABatch.hpp"
 
 #include "RDM/SupportedCells.hpp" // supported cells
 
@@ -23,6 +24,8 @@ namespace RDM {
 
 Common::ComponentBuilder < CellLoopT<LDA, Physics::Scalar::Burgers2D> , RDM::CellLoop, LibScalar > LDA_Burgers2D_Builder;
 
+Common::ComponentBuilder < CellLoopBatch<LDABatch, Physics::Scalar::Burgers2D> , RDM::CellLoop, LibScalar > LDABatch_Burgers2D_Builder;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 } // RDM
@@ -18,6 +18,7 @@
 #include "Common/OptionComponent.hpp"
 #include "Common/BasicExceptions.hpp"
 
+#include "Math/Consts.hpp"
 #include "Math/MatrixTypes.hpp"
 
 #include "Mesh/ElementData.hpp"
@@ -28,6 +29,7 @@
 
 #include "Physics/PhysModel.hpp"
 
+#include "Solver/CEigenLSS.hpp"
 #include "Solver/Actions/CLoopOperation.hpp"
 
 #include "RDM/LibRDM.hpp"
@@ -70,10 +72,31 @@ public: // functions
   /// @post zeros the local residual matrix
   void interpolate ( const Mesh::CTable<Uint>::ConstRow& nodes_idx );
 
+  /// interpolates the solution values U_n to the quadrature points,
+  /// reusing the geometry computed by interpolate()
+  /// @post zeros the local residual matrix and the nodal wave speeds
+  void interpolate_solution ();
+
   void sol_gradients_at_qdpoint(const Uint q);
 
+  /// computes the element residuals Phi_n and the nodal wave speeds Ws_n
+  /// from the element solution U_n, without touching the fields
+  /// @pre interpolate() was called
+  virtual void compute_element_residual ()
+  {
+    throw Common::NotImplemented( FromHere(), type_name() + " does not provide the element residual jacobian" );
+  }
+
+  /// assembles into the system the jacobian of the residuals of the current element
+  /// to the solution, computed by finite differences of compute_element_residual()
+  /// on the element solution U_n
+  void assemble_jacobian ( Solver::CEigenLSS& lss );
+
 protected: // helper functions
 
+  /// adds the element residuals and the nodal wave speeds to the fields
+  void add_to_fields ( const Mesh::CTable<Uint>::ConstRow& nodes_idx );
+
   void change_elements()
   {
     connectivity_table =
@@ -103,6 +126,7 @@ protected: // typedefs
   typedef Eigen::Matrix<Real, PHYS::MODEL::_neqs, 1u>                            PhysicsVT;
 
   typedef Eigen::Matrix<Real, SF::nb_nodes,   PHYS::MODEL::_neqs>                SolutionMT;
+  typedef Eigen::Matrix<Real, SF::nb_nodes,   1u>                                WaveSpeedVT;
   typedef Eigen::Matrix<Real, 1u, PHYS::MODEL::_neqs >                           SolutionVT;
 
   typedef Eigen::Matrix<Real, SF::nb_nodes, SF::nb_nodes>                        MassMT;
@@ -154,6 +178,8 @@ protected: // data
 
   /// contribution to nodal residuals
   SolutionMT Phi_n;
+  /// contribution to nodal wave speeds
+  WaveSpeedVT Ws_n;
   /// node values
   NodeMT     X_n;
   /// Values of the solution located in the dof of the element
@@ -272,10 +298,6 @@ void SchemeBase<SF, QD,PHYS>::interpolate( const Mesh::CTable<Uint>::ConstRow& n
 
   X_q  = Ni * X_n;
 
-  // solution at all quadrature points in physical space
-
-  U_q = Ni * U_n;
-
   // Jacobian of transformation phys -> ref:
   //    |   dx/dksi    dx/deta    |
   //    |   dy/dksi    dy/deta    |
@@ -323,6 +345,17 @@ void SchemeBase<SF, QD,PHYS>::interpolate( const Mesh::CTable<Uint>::ConstRow& n
   for(Uint q = 0; q < QD::nb_points; ++q)
     wj[q] = jacob[q] * m_quadrature.weights[q];
 
+  interpolate_solution();
+}
+
+
+template<typename SF,typename QD, typename PHYS>
+void SchemeBase<SF, QD,PHYS>::interpolate_solution()
+{
+  // solution at all quadrature points in physical space
+
+  U_q = Ni * U_n;
+
   // solution derivatives in physical space at quadrature point
 
   for(Uint dim = 0; dim < PHYS::MODEL::_ndim; ++dim)
@@ -331,6 +364,57 @@ void SchemeBase<SF, QD,PHYS>::interpolate( const Mesh::CTable<Uint>::ConstRow& n
   // zero element residuals
 
   Phi_n.setZero();
+  Ws_n.setZero();
+}
+
+
+template<typename SF,typename QD, typename PHYS>
+void SchemeBase<SF, QD,PHYS>::add_to_fields( const Mesh::CTable<Uint>::ConstRow& nodes_idx )
+{
+  for (Uint n=0; n<SF::nb_nodes; ++n)
+  {
+    (*wave_speed)[nodes_idx[n]][0] += Ws_n[n];
+
+    for (Uint v=0; v < PHYS::MODEL::_neqs; ++v)
+      (*residual)[nodes_idx[n]][v] += Phi_n(n,v);
+  }
+}
+
+
+template<typename SF,typename QD, typename PHYS>
+void SchemeBase<SF, QD,PHYS>::assemble_jacobian( Solver::CEigenLSS& lss )
+{
+  const Uint neqs = PHYS::MODEL::_neqs;
+
+  const Mesh::CTable<Uint>::ConstRow nodes_idx = connectivity_table->array()[idx()];
+
+  interpolate( nodes_idx );
+
+  compute_element_residual();
+
+  const SolutionMT Phi_0 = Phi_n;
+
+  // perturb one variable of one node at a time, each perturbation
+  // gives one column of the element jacobian
+
+  for(Uint j = 0; j < SF::nb_nodes; ++j)
+    for(Uint w = 0; w < neqs; ++w)
+    {
+      const Real u = U_n(j,w);
+      const Real eps = std::sqrt( Math::Consts::eps() ) * std::max( std::abs(u), 1. );
+
+      U_n(j,w) = u + eps;
+
+      interpolate_solution();
+      compute_element_residual();
+
+      U_n(j,w) = u;
+
+      const Uint col = nodes_idx[j] * neqs + w;
+      for(Uint i = 0; i < SF::nb_nodes; ++i)
+        for(Uint v = 0; v < neqs; ++v)
+          lss.at( nodes_idx[i] * neqs + v, col ) += ( Phi_n(i,v) - Phi_0(i,v) ) / eps;
+    }
 }
 
 
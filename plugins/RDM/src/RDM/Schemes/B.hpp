@@ -81,6 +81,9 @@ public: // functions
   /// execute the action
   virtual void execute ();
 
+  /// computes the element residuals and the nodal wave speeds
+  virtual void compute_element_residual ();
+
 protected: // data
 
   /// The operator L in the advection equation Lu = f
@@ -120,6 +123,18 @@ void B::Term<SF,QD,PHYS>::execute()
 
   B::interpolate( nodes_idx );
 
+  compute_element_residual();
+
+  // update the residual and the wave speed
+
+  B::add_to_fields( nodes_idx );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+template<typename SF,typename QD, typename PHYS>
+void B::Term<SF,QD,PHYS>::compute_element_residual()
+{
   // L(N)+ @ each quadrature point
 
   for(Uint q=0; q < QD::nb_points; ++q)
@@ -192,12 +207,12 @@ void B::Term<SF,QD,PHYS>::execute()
     // compute the wave_speed for scaling the update
 
     for(Uint n = 0; n < SF::nb_nodes; ++n)
-      (*B::wave_speed)[nodes_idx[n]][0] += DvPlus[n].maxCoeff() * B::wj[q];
+      B::Ws_n[n] += DvPlus[n].maxCoeff() * B::wj[q];
 
 
   } // loop qd points
 
-  // update the residual
+  // blend the LDA residual with the N dissipation
 
   for (Uint v=0; v < PHYS::MODEL::_neqs; ++v)
   {
@@ -213,7 +228,7 @@ void B::Term<SF,QD,PHYS>::execute()
 
     for (Uint n=0; n<SF::nb_nodes; ++n)
     {
-      (*B::residual)[nodes_idx[n]][v] += B::Phi_n(n,v) + theta * Phi_n_diss(n,v);
+      B::Phi_n(n,v) += theta * Phi_n_diss(n,v);
     }
 
   } // loop over equations
@@ -84,6 +84,9 @@ public: // functions
   /// execute the action
   virtual void execute ();
 
+  /// computes the element residuals and the nodal wave speeds
+  virtual void compute_element_residual ();
+
 protected: // data
 
   /// The operator L in the advection equation Lu = f
@@ -129,14 +132,26 @@ inline Real myplus ( Real x )
 template<typename SF,typename QD, typename PHYS>
 void LDA::Term<SF,QD,PHYS>::execute()
 {
-  using namespace CF::Math;
-
   // get element connectivity
 
   const Mesh::CTable<Uint>::ConstRow nodes_idx = this->connectivity_table->array()[B::idx()];
 
   B::interpolate( nodes_idx );
 
+  compute_element_residual();
+
+  // update the residual and the wave speed
+
+  B::add_to_fields( nodes_idx );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+template<typename SF,typename QD, typename PHYS>
+void LDA::Term<SF,QD,PHYS>::compute_element_residual()
+{
+  using namespace CF::Math;
+
   // L(N)+ @ each quadrature point
 
   for(Uint q=0; q < QD::nb_points; ++q)
@@ -367,17 +382,10 @@ void LDA::Term<SF,QD,PHYS>::execute()
     // compute the wave_speed for scaling the update
 
     for(Uint n = 0; n < SF::nb_nodes; ++n)
-      (*B::wave_speed)[nodes_idx[n]][0] += DvPlus[n].maxCoeff() * B::wj[q];
+      B::Ws_n[n] += DvPlus[n].maxCoeff() * B::wj[q];
 
 
   } // loop qd points
-
-  // update the residual
-
-  for (Uint n=0; n<SF::nb_nodes; ++n)
-    for (Uint v=0; v < PHYS::MODEL::_neqs; ++v)
-      (*B::residual)[nodes_idx[n]][v] += B::Phi_n(n,v);
-
 }
 
 /////////////////////////////////////////////////////////////////////////////////////
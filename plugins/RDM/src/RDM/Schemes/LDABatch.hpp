@@ -0,0 +1,429 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_RDM_Schemes_LDABatch_hpp
+#define CF_RDM_Schemes_LDABatch_hpp
+
+#include "RDM/CellLoopBatch.hpp"
+
+#include "RDM/Schemes/LDA.hpp"
+
+namespace CF {
+namespace RDM {
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/// LDA scheme computed in batches of elements on the host, the CPU counterpart
+/// of the GPU LDA kernels. Gives the same residual as LDA, but is executed by
+/// a CellLoopBatch, which hands the elements to the term in batches.
+class RDM_SCHEMES_API LDABatch : public RDM::CellTerm {
+
+public: // typedefs
+
+  /// the actual scheme implementation is a nested class
+  /// varyng with shape function (SF), quadrature rule (QD) and Physics (PHYS)
+  template < typename SF, typename QD, typename PHYS > class Term;
+
+  typedef boost::shared_ptr< LDABatch > Ptr;
+  typedef boost::shared_ptr< LDABatch const > ConstPtr;
+
+public: // functions
+
+  /// Contructor
+  /// @param name of the component
+  LDABatch ( const std::string& name );
+
+  /// Virtual destructor
+  virtual ~LDABatch();
+
+  /// Get the class name
+  static std::string type_name () { return "LDABatch"; }
+
+  /// Execute the loop for all elements
+  virtual void execute();
+
+};
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/// Determinant and inverse of the jacobians of a batch of elements,
+/// with the closed form expressions so they vectorize over the batch
+template < Uint DIM > struct BatchInverse;
+
+template <> struct BatchInverse<2>
+{
+  template < typename BT >
+  static void compute ( const BT J[2][2], BT& det, BT Jinv[2][2] )
+  {
+    det = J[0][0] * J[1][1] - J[0][1] * J[1][0];
+
+    Jinv[0][0] =   J[1][1] / det;
+    Jinv[0][1] = - J[0][1] / det;
+    Jinv[1][0] = - J[1][0] / det;
+    Jinv[1][1] =   J[0][0] / det;
+  }
+};
+
+template <> struct BatchInverse<3>
+{
+  template < typename BT >
+  static void compute ( const BT J[3][3], BT& det, BT Jinv[3][3] )
+  {
+    Jinv[0][0] = J[1][1] * J[2][2] - J[1][2] * J[2][1];
+    Jinv[1][0] = J[1][2] * J[2][0] - J[1][0] * J[2][2];
+    Jinv[2][0] = J[1][0] * J[2][1] - J[1][1] * J[2][0];
+
+    det = J[0][0] * Jinv[0][0] + J[0][1] * Jinv[1][0] + J[0][2] * Jinv[2][0];
+
+    Jinv[0][1] = J[0][2] * J[2][1] - J[0][1] * J[2][2];
+    Jinv[1][1] = J[0][0] * J[2][2] - J[0][2] * J[2][0];
+    Jinv[2][1] = J[0][1] * J[2][0] - J[0][0] * J[2][1];
+
+    Jinv[0][2] = J[0][1] * J[1][2] - J[0][2] * J[1][1];
+    Jinv[1][2] = J[0][2] * J[1][0] - J[0][0] * J[1][2];
+    Jinv[2][2] = J[0][0] * J[1][1] - J[0][1] * J[1][0];
+
+    for(Uint i = 0; i < 3; ++i)
+      for(Uint j = 0; j < 3; ++j)
+        Jinv[i][j] /= det;
+  }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/// Batched LDA term. The data of batch_size elements is gathered into
+/// fixed width Eigen arrays, one lane per element, so the geometry, the
+/// interpolation and the distribution of the residual are computed for the
+/// whole batch with the SIMD packets of Eigen. The physics is evaluated lane
+/// by lane, through the same point-wise interface as the other schemes.
+/// The element by element execute() of LDA is kept for the jacobian pass.
+template < typename SF, typename QD, typename PHYS >
+class RDM_SCHEMES_API LDABatch::Term : public LDA::Term<SF,QD,PHYS> {
+
+public: // typedefs
+
+  /// scheme base class type
+  typedef SchemeBase<SF,QD,PHYS> B;
+
+  /// element by element scheme type
+  typedef LDA::Term<SF,QD,PHYS> LDAT;
+
+  /// pointers
+  typedef boost::shared_ptr< Term > Ptr;
+  typedef boost::shared_ptr< Term const> ConstPtr;
+
+  enum { batch_size = 8 };         ///< number of elements computed together
+
+  enum { nb_nodes = SF::nb_nodes,
+         nb_qd    = QD::nb_points,
+         ndim     = PHYS::MODEL::_ndim,
+         neqs     = PHYS::MODEL::_neqs };
+
+  /// one value for each element of the batch
+  typedef Eigen::Array<Real, batch_size, 1> BatchT;
+
+public: // functions
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW  ///< storing fixed-sized Eigen structures
+
+  /// Contructor
+  /// @param name of the component
+  Term ( const std::string& name ) : LDAT(name)
+  {
+    regist_typeinfo(this);
+  }
+
+  /// Get the class name
+  static std::string type_name () { return "LDABatch.Term<" + SF::type_name() + "," + PHYS::type_name() + ">"; }
+
+  /// computes the residual of a batch of consecutive elements
+  /// and adds it to the fields, together with the wave speeds
+  /// @param [in] first  index of the first element of the batch
+  /// @param [in] count  number of elements, at most batch_size
+  void execute_batch ( const Uint first, const Uint count );
+
+private: // helper functions
+
+  /// gathers the coordinates and solution of the batch, padding
+  /// the unused lanes with the last element
+  void gather ( const Uint first, const Uint count );
+
+  /// computes the geometry and the interpolated solution at quadrature point q
+  void interpolate_batch ( const Uint q );
+
+  /// evaluates the physics at quadrature point q, for each element of the batch
+  void compute_physics ( const Uint q, const Uint count );
+
+  /// adds the element residuals and wave speeds of the batch to the fields
+  void scatter ( const Uint count );
+
+private: // data
+
+  /// nodes of each element of the batch
+  Uint m_nodes_b [batch_size][nb_nodes];
+
+  /// node coordinates
+  BatchT X_b [nb_nodes][ndim];
+  /// node solution
+  BatchT U_b [nb_nodes][neqs];
+
+  /// jacobian of the transformation to the reference element, its inverse and determinant
+  BatchT J_b [ndim][ndim];
+  BatchT Jinv_b [ndim][ndim];
+  BatchT jacob_b;
+  /// integration factor at the current quadrature point
+  BatchT wj_b;
+
+  /// shape function gradients in physical space at the current quadrature point
+  BatchT dNdX_b [nb_nodes][ndim];
+  /// coordinates, solution and solution gradients at the current quadrature point
+  BatchT X_qb [ndim];
+  BatchT U_qb [neqs];
+  BatchT dUdX_b [neqs][ndim];
+
+  /// Ki+ of each node, their sum and its inverse
+  BatchT K_b [nb_nodes][neqs][neqs];
+  BatchT sumK_b [neqs][neqs];
+  BatchT invK_b [neqs][neqs];
+  /// largest positive eigen value of each node
+  BatchT Dmax_b [nb_nodes];
+  /// residual L(u) and its integral, premultiplied by the inverse of the sum of Ki+
+  BatchT LU_b [neqs];
+  BatchT LUw_b [neqs];
+
+  /// element residuals and wave speeds
+  BatchT Phi_b [nb_nodes][neqs];
+  BatchT Ws_b [nb_nodes];
+
+};
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+template<typename SF,typename QD, typename PHYS>
+void LDABatch::Term<SF,QD,PHYS>::execute_batch( const Uint first, const Uint count )
+{
+  cf_assert( count > 0 && count <= Uint(batch_size) );
+
+  gather( first, count );
+
+  for(Uint n = 0; n < nb_nodes; ++n)
+  {
+    Ws_b[n].setZero();
+    for(Uint v = 0; v < neqs; ++v)
+      Phi_b[n][v].setZero();
+  }
+
+  for(Uint q = 0; q < nb_qd; ++q)
+  {
+    interpolate_batch(q);
+
+    compute_physics(q, count);
+
+    // sum of Ki+, inverted lane by lane
+
+    for(Uint i = 0; i < neqs; ++i)
+      for(Uint j = 0; j < neqs; ++j)
+      {
+        sumK_b[i][j] = K_b[0][i][j];
+        for(Uint n = 1; n < nb_nodes; ++n)
+          sumK_b[i][j] += K_b[n][i][j];
+      }
+
+    for(Uint l = 0; l < count; ++l)
+    {
+      for(Uint i = 0; i < neqs; ++i)
+        for(Uint j = 0; j < neqs; ++j)
+          LDAT::sumLplus(i,j) = sumK_b[i][j][l];
+
+      LDAT::InvKi_n = LDAT::sumLplus.inverse();
+
+      for(Uint i = 0; i < neqs; ++i)
+        for(Uint j = 0; j < neqs; ++j)
+          invK_b[i][j][l] = LDAT::InvKi_n(i,j);
+    }
+
+    // phi_i of the LDA integral and the wave speeds
+
+    for(Uint i = 0; i < neqs; ++i)
+    {
+      LUw_b[i] = invK_b[i][0] * LU_b[0];
+      for(Uint j = 1; j < neqs; ++j)
+        LUw_b[i] += invK_b[i][j] * LU_b[j];
+      LUw_b[i] *= wj_b;
+    }
+
+    for(Uint n = 0; n < nb_nodes; ++n)
+    {
+      for(Uint i = 0; i < neqs; ++i)
+        for(Uint j = 0; j < neqs; ++j)
+          Phi_b[n][i] += K_b[n][i][j] * LUw_b[j];
+
+      Ws_b[n] += Dmax_b[n] * wj_b;
+    }
+
+  } // loop qd points
+
+  scatter( count );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+template<typename SF,typename QD, typename PHYS>
+void LDABatch::Term<SF,QD,PHYS>::gather( const Uint first, const Uint count )
+{
+  const Mesh::CTable<Uint>::ArrayT& connectivity = this->connectivity_table->array();
+  const Mesh::CTable<Real>& coordinates = *this->coordinates;
+  const Mesh::CTable<Real>& solution    = *this->solution;
+
+  for(Uint l = 0; l < Uint(batch_size); ++l)
+  {
+    const Mesh::CTable<Uint>::ConstRow nodes_idx = connectivity[ first + std::min(l, count-1) ];
+
+    for(Uint n = 0; n < nb_nodes; ++n)
+    {
+      const Uint node = nodes_idx[n];
+      m_nodes_b[l][n] = node;
+
+      for(Uint d = 0; d < ndim; ++d)
+        X_b[n][d][l] = coordinates[node][d];
+      for(Uint v = 0; v < neqs; ++v)
+        U_b[n][v][l] = solution[node][v];
+    }
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+template<typename SF,typename QD, typename PHYS>
+void LDABatch::Term<SF,QD,PHYS>::interpolate_batch( const Uint q )
+{
+  // Jacobian of transformation, J(ksi,x) = dx/dksi
+
+  for(Uint k = 0; k < ndim; ++k)
+    for(Uint x = 0; x < ndim; ++x)
+    {
+      J_b[k][x] = B::dNdKSI[k](q,0) * X_b[0][x];
+      for(Uint n = 1; n < nb_nodes; ++n)
+        J_b[k][x] += B::dNdKSI[k](q,n) * X_b[n][x];
+    }
+
+  BatchInverse<ndim>::compute( J_b, jacob_b, Jinv_b );
+
+  wj_b = jacob_b * B::m_quadrature.weights[q];
+
+  // gradients of the shape functions in physical space
+
+  for(Uint n = 0; n < nb_nodes; ++n)
+    for(Uint x = 0; x < ndim; ++x)
+    {
+      dNdX_b[n][x] = Jinv_b[x][0] * B::dNdKSI[0](q,n);
+      for(Uint k = 1; k < ndim; ++k)
+        dNdX_b[n][x] += Jinv_b[x][k] * B::dNdKSI[k](q,n);
+    }
+
+  // coordinates, solution and solution gradients
+
+  for(Uint x = 0; x < ndim; ++x)
+  {
+    X_qb[x] = B::Ni(q,0) * X_b[0][x];
+    for(Uint n = 1; n < nb_nodes; ++n)
+      X_qb[x] += B::Ni(q,n) * X_b[n][x];
+  }
+
+  for(Uint v = 0; v < neqs; ++v)
+  {
+    U_qb[v] = B::Ni(q,0) * U_b[0][v];
+    for(Uint n = 1; n < nb_nodes; ++n)
+      U_qb[v] += B::Ni(q,n) * U_b[n][v];
+
+    for(Uint x = 0; x < ndim; ++x)
+    {
+      dUdX_b[v][x] = dNdX_b[0][x] * U_b[0][v];
+      for(Uint n = 1; n < nb_nodes; ++n)
+        dUdX_b[v][x] += dNdX_b[n][x] * U_b[n][v];
+    }
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+template<typename SF,typename QD, typename PHYS>
+void LDABatch::Term<SF,QD,PHYS>::compute_physics( const Uint q, const Uint count )
+{
+  for(Uint l = 0; l < count; ++l)
+  {
+    // load this lane into the point-wise storage of the scheme
+
+    for(Uint x = 0; x < ndim; ++x)
+      B::X_q(q,x) = X_qb[x][l];
+
+    for(Uint v = 0; v < neqs; ++v)
+    {
+      B::U_q(q,v) = U_qb[v][l];
+      for(Uint x = 0; x < ndim; ++x)
+        B::dUdXq(v,x) = dUdX_b[v][x][l];
+    }
+
+    PHYS::compute_properties(B::X_q.row(q),
+                             B::U_q.row(q),
+                             B::dUdXq,
+                             B::phys_props);
+
+    // Ki+ of each node, projecting the eigen structure onto the shape function gradient
+
+    for(Uint n = 0; n < nb_nodes; ++n)
+    {
+      for(Uint x = 0; x < ndim; ++x)
+        B::dN[x] = dNdX_b[n][x][l];
+
+      PHYS::flux_jacobian_eigen_structure(B::phys_props, B::dN, LDAT::Rv, LDAT::Lv, LDAT::Dv);
+
+      LDAT::DvPlus[n] = LDAT::Dv.unaryExpr(std::ptr_fun(plus));
+
+      LDAT::Ki_n[n] = LDAT::Rv * LDAT::DvPlus[n].asDiagonal() * LDAT::Lv;
+
+      for(Uint i = 0; i < neqs; ++i)
+        for(Uint j = 0; j < neqs; ++j)
+          K_b[n][i][j][l] = LDAT::Ki_n[n](i,j);
+
+      Dmax_b[n][l] = LDAT::DvPlus[n].maxCoeff();
+    }
+
+    // PDE residual L(u)
+
+    PHYS::residual( B::phys_props, B::dFdU, B::LU );
+
+    for(Uint v = 0; v < neqs; ++v)
+      LU_b[v][l] = B::LU[v];
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+template<typename SF,typename QD, typename PHYS>
+void LDABatch::Term<SF,QD,PHYS>::scatter( const Uint count )
+{
+  Mesh::CTable<Real>& residual   = *this->residual;
+  Mesh::CTable<Real>& wave_speed = *this->wave_speed;
+
+  for(Uint l = 0; l < count; ++l)
+    for(Uint n = 0; n < nb_nodes; ++n)
+    {
+      const Uint node = m_nodes_b[l][n];
+
+      wave_speed[node][0] += Ws_b[n][l];
+
+      for(Uint v = 0; v < neqs; ++v)
+        residual[node][v] += Phi_b[n][v][l];
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+} // RDM
+} // CF
+
+#endif // CF_RDM_Schemes_LDABatch_hpp
@@ -73,6 +73,9 @@ public: // functions
   /// execute the action
   virtual void execute ();
 
+  /// computes the element residuals and the nodal wave speeds
+  virtual void compute_element_residual ();
+
 private: // data
 
   /// diagonal matrix with positive eigen values
@@ -91,6 +94,18 @@ void LF::Term<SF,QD,PHYS>::execute()
 
   B::interpolate( nodes_idx );
 
+  compute_element_residual();
+
+  // update the residual and the wave speed
+
+  B::add_to_fields( nodes_idx );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+template<typename SF,typename QD, typename PHYS>
+void LF::Term<SF,QD,PHYS>::compute_element_residual()
+{
   // L(N)+ @ each quadrature point
 
   for(Uint q=0; q < QD::nb_points; ++q)
@@ -137,17 +152,10 @@ void LF::Term<SF,QD,PHYS>::execute()
 
       // compute the wave_speed for scaling the update
 
-      (*B::wave_speed)[nodes_idx[i]][0] += alpha * B::wj[q];
+      B::Ws_n[i] += alpha * B::wj[q];
     }
 
   } // loop qd points
-
-  // update the residual
-
-  for (Uint n=0; n<SF::nb_nodes; ++n)
-    for (Uint v=0; v < PHYS::MODEL::_neqs; ++v)
-      (*B::residual)[nodes_idx[n]][v] += B::Phi_n(n,v);
-
 }
 
 ////////////////////////////////////////////////////////////////////////////////////
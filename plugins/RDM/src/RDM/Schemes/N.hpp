@@ -79,6 +79,9 @@ public: // functions
   /// execute the action
   virtual void execute ();
 
+  /// computes the element residuals and the nodal wave speeds
+  virtual void compute_element_residual ();
+
 protected: // data
 
   /// Matrix KiP_n stores the value L(N_i)+ at each quadrature point for each shape function N_i
@@ -115,6 +118,18 @@ void N::Term<SF,QD,PHYS>::execute()
 
   B::interpolate( nodes_idx );
 
+  compute_element_residual();
+
+  // update the residual and the wave speed
+
+  B::add_to_fields( nodes_idx );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+template<typename SF,typename QD, typename PHYS>
+void N::Term<SF,QD,PHYS>::compute_element_residual()
+{
   // L(N)+ @ each quadrature point
 
   for(Uint q=0; q < QD::nb_points; ++q)
@@ -194,16 +209,10 @@ void N::Term<SF,QD,PHYS>::execute()
     // compute the wave_speed for scaling the update
 
     for(Uint n = 0; n < SF::nb_nodes; ++n)
-      (*B::wave_speed)[nodes_idx[n]][0] += DvP[n].maxCoeff() * B::wj[q];
+      B::Ws_n[n] += DvP[n].maxCoeff() * B::wj[q];
 
   } // loop qd points
 
-  // update the residual
-
-  for (Uint n=0; n<SF::nb_nodes; ++n)
-    for (Uint v=0; v < PHYS::MODEL::_neqs; ++v)
-      (*B::residual)[nodes_idx[n]][v] += B::Phi_n(n,v);
-
 
   // debug
 
@@ -28,6 +28,8 @@
 
 #include "Mesh/SF/Tetra3DLagrangeP1.hpp"
 #include "Mesh/SF/Hexa3DLagrangeP1.hpp"
+#include "Mesh/SF/Prism3DLagrangeP1.hpp"
+#include "Mesh/SF/Pyramid3DLagrangeP1.hpp"
 
 
 #include "Mesh/Integrators/GaussImplementation.hpp"
@@ -56,13 +58,20 @@ typedef boost::mpl::vector<
 /// List of supported 3d cell shapefunctions
 typedef boost::mpl::vector<
   Mesh::SF::Tetra3DLagrangeP1,
-  Mesh::SF::Hexa3DLagrangeP1
+  Mesh::SF::Hexa3DLagrangeP1,
+  Mesh::SF::Prism3DLagrangeP1,
+  Mesh::SF::Pyramid3DLagrangeP1
 > CellTypes3D;
 
 #else
 
 typedef boost::mpl::vector<Mesh::SF::Triag2DLagrangeP1> CellTypes2D;
-typedef boost::mpl::vector<Mesh::SF::Tetra3DLagrangeP1> CellTypes3D;
+/// tetrahedra, with the prisms and pyramids of hybrid boundary layer meshes
+typedef boost::mpl::vector<
+  Mesh::SF::Tetra3DLagrangeP1,
+  Mesh::SF::Prism3DLagrangeP1,
+  Mesh::SF::Pyramid3DLagrangeP1
+> CellTypes3D;
 
 #endif
 
@@ -126,6 +135,20 @@ struct DefaultQuadrature< Mesh::SF::Quad2DLagrangeP3, 3 >
   typedef Mesh::Integrators::GaussMappedCoords< 8, Mesh::SF::Quad2DLagrangeP3::shape> type;
 };
 
+/// Partial specialization for P1 prisms
+template <>
+struct DefaultQuadrature< Mesh::SF::Prism3DLagrangeP1, 1 >
+{
+  typedef Mesh::Integrators::GaussMappedCoords< 2, Mesh::SF::Prism3DLagrangeP1::shape> type;
+};
+
+/// Partial specialization for P1 pyramids
+template <>
+struct DefaultQuadrature< Mesh::SF::Pyramid3DLagrangeP1, 1 >
+{
+  typedef Mesh::Integrators::GaussMappedCoords< 2, Mesh::SF::Pyramid3DLagrangeP1::shape> type;
+};
+
 //------------------------------------------------------------------------------------------
 
 /// Partial specialization for P2 with bubble.
@@ -0,0 +1,160 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Benchmark of the batched LDA loop against the element by element one"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/Core.hpp"
+#include "Common/CRoot.hpp"
+
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CField.hpp"
+#include "Mesh/CRegion.hpp"
+
+#include "Physics/Scalar/LinearAdv2D.hpp"
+
+#include "Tools/MeshGeneration/MeshGeneration.hpp"
+#include "Tools/Testing/TimedTestFixture.hpp"
+
+#include "RDM/Schemes/LDA.hpp"
+#include "RDM/Schemes/LDABatch.hpp"
+
+using namespace CF;
+using namespace CF::Common;
+using namespace CF::Mesh;
+using namespace CF::RDM;
+
+/// @todo create a library for support of the utests
+/// @todo move this to a class that all utests global fixtures must inherit from
+struct CoreInit {
+
+  /// global initiate
+  CoreInit()
+  {
+    using namespace boost::unit_test::framework;
+    Core::instance().initiate( master_test_suite().argc, master_test_suite().argv);
+  }
+
+  /// global tear-down
+  ~CoreInit()
+  {
+    Core::instance().terminate();
+  }
+
+};
+
+struct LDABatchFixture : Tools::Testing::TimedTestFixture
+{
+  /// number of residual evaluations timed for each loop
+  static const Uint nb_iterations = 10;
+
+  /// configures the fields of a cell term and computes its residual with the given loop
+  template < typename LoopT >
+  void compute_residual( CellTerm& term )
+  {
+    term.configure_option( RDM::Tags::solution(),   solution->uri() );
+    term.configure_option( RDM::Tags::residual(),   residual->uri() );
+    term.configure_option( RDM::Tags::wave_speed(), wave_speed->uri() );
+
+    // the term has no physical model to build its loop from, so it is created here
+
+    boost::shared_ptr<LoopT> loop = allocate_component<LoopT>("LOOP");
+    term.add_component( loop );
+    loop->select_region( mesh->topology().as_ptr<CRegion>() );
+
+    restart_timer();
+
+    for(Uint i = 0; i < nb_iterations; ++i)
+    {
+      residual->data()   = 0.;
+      wave_speed->data() = 0.;
+
+      loop->execute();
+    }
+  }
+
+  static CMesh::Ptr mesh;
+  static CField::Ptr solution;
+  static CField::Ptr residual;
+  static CField::Ptr wave_speed;
+
+  /// residual and wave speed of the element by element loop
+  static std::vector<Real> ref_residual;
+  static std::vector<Real> ref_wave_speed;
+};
+
+CMesh::Ptr  LDABatchFixture::mesh;
+CField::Ptr LDABatchFixture::solution;
+CField::Ptr LDABatchFixture::residual;
+CField::Ptr LDABatchFixture::wave_speed;
+
+std::vector<Real> LDABatchFixture::ref_residual;
+std::vector<Real> LDABatchFixture::ref_wave_speed;
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_GLOBAL_FIXTURE( CoreInit )
+
+BOOST_AUTO_TEST_SUITE( lda_batch_suite )
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Must be run before the next tests
+BOOST_FIXTURE_TEST_CASE( CreateMesh, LDABatchFixture )
+{
+  mesh = Core::instance().root().create_component_ptr<CMesh>("mesh");
+  Tools::MeshGeneration::create_rectangle_tris(*mesh, 1., 1., 500, 500);
+
+  solution   = mesh->create_field( RDM::Tags::solution(), CField::Basis::POINT_BASED, "space[0]", "u[1]" ).as_ptr<CField>();
+  residual   = mesh->create_field( RDM::Tags::residual(), *solution ).as_ptr<CField>();
+  wave_speed = mesh->create_scalar_field( RDM::Tags::wave_speed(), *solution ).as_ptr<CField>();
+
+  // smooth solution, so all the elements have a non zero residual
+
+  const CTable<Real>& coords = mesh->nodes().coordinates();
+  CTable<Real>& u = solution->data();
+  for(Uint i = 0; i < u.size(); ++i)
+    u[i][0] = std::sin( 3. * coords[i][XX] ) * std::cos( 2. * coords[i][YY] );
+}
+
+BOOST_FIXTURE_TEST_CASE( CellLoopT_LDA, LDABatchFixture )
+{
+  LDA& term = Core::instance().root().create_component<LDA>("LDA");
+
+  compute_residual< CellLoopT<LDA, Physics::Scalar::LinearAdv2D> >( term );
+
+  const CTable<Real>& R  = residual->data();
+  const CTable<Real>& ws = wave_speed->data();
+  for(Uint i = 0; i < R.size(); ++i)
+  {
+    ref_residual.push_back( R[i][0] );
+    ref_wave_speed.push_back( ws[i][0] );
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( CellLoopBatch_LDABatch, LDABatchFixture )
+{
+  LDABatch& term = Core::instance().root().create_component<LDABatch>("LDABatch");
+
+  compute_residual< CellLoopBatch<LDABatch, Physics::Scalar::LinearAdv2D> >( term );
+
+  const CTable<Real>& R  = residual->data();
+  const CTable<Real>& ws = wave_speed->data();
+
+  BOOST_REQUIRE_EQUAL( R.size(), ref_residual.size() );
+
+  for(Uint i = 0; i < R.size(); ++i)
+  {
+    BOOST_CHECK_SMALL( R[i][0] - ref_residual[i], 1e-12 );
+    BOOST_CHECK_CLOSE( ws[i][0], ref_wave_speed[i], 1e-8 );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
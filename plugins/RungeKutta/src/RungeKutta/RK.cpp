@@ -4,11 +4,18 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include <boost/assign/std/vector.hpp>
+
 #include "Common/OptionT.hpp"
+#include "Common/OptionArray.hpp"
 #include "Common/OptionComponent.hpp"
 #include "Common/CBuilder.hpp"
 #include "Common/CGroupActions.hpp"
 #include "Common/CGroup.hpp"
+#include "Common/Log.hpp"
+#include "Common/MPI/PE.hpp"
+
+#include "Math/Consts.hpp"
 
 #include "Mesh/CMesh.hpp"
 #include "Mesh/CField.hpp"
@@ -23,6 +30,7 @@
 namespace CF {
 namespace RungeKutta {
 
+using namespace boost::assign;
 using namespace Common;
 using namespace Mesh;
 using namespace Solver;
@@ -34,19 +42,130 @@ ComponentBuilder<RK, CAction, LibRungeKutta> RK_builder;
 
 RK::RK ( const std::string& name  )
   : Solver::Action(name),
-    m_stages(4u)
+    m_stages(4u),
+    m_scheme("classic"),
+    m_low_storage(false),
+    m_dual_time_stepping(false),
+    m_inner_iterations(20u),
+    m_inner_tolerance(0.),
+    m_adaptive_time_step(false),
+    m_absolute_tolerance(1e-6),
+    m_relative_tolerance(1e-4),
+    m_safety_factor(0.9),
+    m_embedded_order(0u),
+    m_dt_control(Math::Consts::real_max()),
+    m_previous_error(1.)
 {
   properties()["brief"] = std::string("Runge Kutta differential equation solver");
   properties()["description"] = std::string("Solves the differential equation using Runge Kutta method");
 
+  Option::Ptr scheme = options().add_option(OptionT<std::string>::create("scheme", m_scheme));
+  scheme->description("Runge Kutta scheme:\n"
+                      " - classic: scheme with the number of \"stages\" (1: forward Euler, 2: midpoint,\n"
+                      "   3: 3rd order TVD, 4: Jameson's 4 stage scheme)\n"
+                      " - ssp_rk33: 3rd order strong stability preserving scheme with 3 stages\n"
+                      " - ssp_rk43: 3rd order strong stability preserving scheme with 4 stages, twice the CFL of ssp_rk33\n"
+                      " - ls_rk45: 4th order low-storage scheme with 5 stages of Carpenter and Kennedy\n"
+                      " - custom: Shu-Osher form with the arrays \"alpha\", \"beta\" and \"gamma\"\n"
+                      " - custom_2N: Williamson 2N-storage form with the arrays \"A\", \"B\" and \"gamma\"")
+        ->pretty_name("Scheme")
+        ->link_to(&m_scheme)
+        ->attach_trigger( boost::bind( &RK::config_scheme, this) )
+        ->mark_basic();
+  scheme->restricted_list() += std::string("ssp_rk33"),
+                               std::string("ssp_rk43"),
+                               std::string("ls_rk45"),
+                               std::string("custom"),
+                               std::string("custom_2N");
+
   options().add_option(OptionT<Uint>::create("stages", m_stages))
-      ->description("Number of stages used in the multistage method")
+      ->description("Number of stages used in the classic multistage method")
       ->pretty_name("Stages")
       ->link_to(&m_stages)
-      ->attach_trigger( boost::bind( &RK::config_stages, this) )
+      ->attach_trigger( boost::bind( &RK::config_scheme, this) )
       ->mark_basic();
 
-  config_stages();
+  options().add_option< OptionArrayT<Real> >("alpha", std::vector<Real>())
+      ->description("Coefficients alpha of the custom scheme in Shu-Osher form, one per stage\n"
+                    "  U[k+1] = (1-alpha[k]) U[0] + alpha[k] U[k] + beta[k] H R(U[k])")
+      ->pretty_name("Alpha")
+      ->attach_trigger( boost::bind( &RK::config_scheme, this) );
+
+  options().add_option< OptionArrayT<Real> >("beta", std::vector<Real>())
+      ->description("Coefficients beta of the custom scheme in Shu-Osher form, one per stage")
+      ->pretty_name("Beta")
+      ->attach_trigger( boost::bind( &RK::config_scheme, this) );
+
+  options().add_option< OptionArrayT<Real> >("A", std::vector<Real>())
+      ->description("Coefficients A of the custom scheme in Williamson 2N-storage form, one per stage\n"
+                    "  dU = A[k] dU + H R(U[k]) ,  U[k+1] = U[k] + B[k] dU")
+      ->pretty_name("A")
+      ->attach_trigger( boost::bind( &RK::config_scheme, this) );
+
+  options().add_option< OptionArrayT<Real> >("B", std::vector<Real>())
+      ->description("Coefficients B of the custom scheme in Williamson 2N-storage form, one per stage")
+      ->pretty_name("B")
+      ->attach_trigger( boost::bind( &RK::config_scheme, this) );
+
+  options().add_option< OptionArrayT<Real> >("gamma", std::vector<Real>())
+      ->description("Times of the stages of a custom scheme, as a fraction of the time step")
+      ->pretty_name("Gamma")
+      ->attach_trigger( boost::bind( &RK::config_scheme, this) );
+
+  options().add_option< OptionArrayT<Real> >("error_weights", std::vector<Real>())
+      ->description("Differences of the weights of the stages between the solution of a custom scheme\n"
+                    "and the solution of lower order embedded in it, to estimate the error")
+      ->pretty_name("Error Weights")
+      ->attach_trigger( boost::bind( &RK::config_scheme, this) );
+
+  options().add_option(OptionT<Uint>::create("embedded_order", 0u))
+      ->description("Order of the solution embedded in a custom scheme")
+      ->pretty_name("Embedded Order")
+      ->attach_trigger( boost::bind( &RK::config_scheme, this) );
+
+  config_scheme();
+
+  options().add_option(OptionT<bool>::create("adaptive_time_step", m_adaptive_time_step))
+      ->description("Control the time step with the error estimate of the embedded pair of the scheme.\n"
+                    "Steps with a too large error are retried with a smaller time step.\n"
+                    "The time step remains limited by the update coefficient computation (CFL, end time),\n"
+                    "which must then compute update coefficients proportional to the time step.")
+      ->pretty_name("Adaptive Time Step")
+      ->link_to(&m_adaptive_time_step)
+      ->mark_basic();
+
+  options().add_option(OptionT<Real>::create("absolute_tolerance", m_absolute_tolerance))
+      ->description("Absolute tolerance on the local error of an adaptive time step")
+      ->pretty_name("Absolute Tolerance")
+      ->link_to(&m_absolute_tolerance);
+
+  options().add_option(OptionT<Real>::create("relative_tolerance", m_relative_tolerance))
+      ->description("Relative tolerance on the local error of an adaptive time step")
+      ->pretty_name("Relative Tolerance")
+      ->link_to(&m_relative_tolerance);
+
+  options().add_option(OptionT<Real>::create("safety_factor", m_safety_factor))
+      ->description("Safety factor of the time step controller")
+      ->pretty_name("Safety Factor")
+      ->link_to(&m_safety_factor);
+
+  options().add_option(OptionT<bool>::create(FlowSolver::Tags::dual_time_stepping(), m_dual_time_stepping))
+      ->description("Solve every physical time step implicitly, with pseudo time iterations of the stages")
+      ->pretty_name("Dual Time Stepping")
+      ->link_to(&m_dual_time_stepping)
+      ->mark_basic()
+      ->add_tag(FlowSolver::Tags::dual_time_stepping());
+
+  options().add_option(OptionT<Uint>::create("inner_iterations", m_inner_iterations))
+      ->description("Maximum number of pseudo time iterations per physical time step in dual time stepping")
+      ->pretty_name("Inner Iterations")
+      ->link_to(&m_inner_iterations);
+
+  options().add_option(OptionT<Real>::create("inner_tolerance", m_inner_tolerance))
+      ->description("Maximum change of the solution in a forward Euler pseudo time step, at which dual time\n"
+                    "stepping proceeds to the next physical time step (0 runs all inner iterations)")
+      ->pretty_name("Inner Tolerance")
+      ->link_to(&m_inner_tolerance);
 
   options().add_option(OptionComponent<CTime>::create( Solver::Tags::time(), &m_time))
       ->description("Time component")
@@ -64,6 +183,11 @@ RK::RK ( const std::string& name  )
       ->description("Update Coefficient")
       ->pretty_name("Update Coefficient");
 
+  options().add_option(OptionComponent<CField>::create("cell_volume", &m_cell_volume))
+      ->description("Volume of the cells, for dual time stepping with residuals integrated over the cells"
+                    " (finite volumes). Leave empty for point-wise residuals.")
+      ->pretty_name("Cell Volume");
+
   m_for_each_stage = create_static_component_ptr<CGroup>("1_for_each_stage");
   m_for_each_stage->mark_basic();
   m_pre_update  = m_for_each_stage->create_static_component_ptr<CGroupActions>("1_pre_update_actions");
@@ -83,67 +207,118 @@ RK::~RK()
 {
 }
 
-void RK::config_stages()
+void RK::config_scheme()
 {
-  m_alpha.resize(m_stages);
-  m_beta .resize(m_stages);
-  m_gamma.resize(m_stages);
-
-  // Set defaults Values
-  switch (m_stages)
-  {
-    case 1: // Simple Forward Euler
-      m_alpha[0] = 0.0;
-      m_beta[0] = 1.0;
-      m_gamma[0] = 0.0;
-      break;
+  m_alpha.clear();
+  m_beta .clear();
+  m_gamma.clear();
+  m_A.clear();
+  m_B.clear();
+  m_error_weights.clear();
 
-    case 2: // R-K 2
-      m_alpha[0] = 0.0;
-      m_alpha[1] = 0.0;
+  m_low_storage = false;
+  m_embedded_order = 0;
 
-      m_beta[0] = 0.5;
-      m_beta[1] = 1.0;
-
-      m_gamma[0] = 0.0;
-      m_gamma[1] = 0.5;
-      break;
-
-    case 3:  // 3rd order TVD R-K scheme
-      m_alpha[0] = 0.0;
-      m_alpha[1] = 1.0/4.0;
-      m_alpha[2] = 2.0/3.0;
-
-      m_beta[0] = 1.0;
-      m_beta[1] = 1.0/4.0;
-      m_beta[2] = 2.0/3.0;
+  if (m_scheme == "classic")
+  {
+    // Set defaults Values
+    switch (m_stages)
+    {
+      case 1: // Simple Forward Euler
+        m_alpha += 0.0;
+        m_beta  += 1.0;
+        m_gamma += 0.0;
+        break;
+
+      case 2: // R-K 2
+        m_alpha += 0.0, 0.0;
+        m_beta  += 0.5, 1.0;
+        m_gamma += 0.0, 0.5;
+        break;
+
+      case 3:  // 3rd order TVD R-K scheme
+        m_alpha += 0.0, 1.0/4.0, 2.0/3.0;
+        m_beta  += 1.0, 1.0/4.0, 2.0/3.0;
+        m_gamma += 0.0, 1.0,     0.5;
+        break;
+
+      case 4:    // R-K 4
+      default:
+        m_alpha += 0.0,     0.0,     0.0,     0.0;
+        m_beta  += 1.0/4.0, 1.0/3.0, 1.0/2.0, 1.0;
+        m_gamma += 0.0,     1.0/4.0, 1.0/3.0, 1.0/2.0;
+        break;
+    }
+  }
+  else if (m_scheme == "ssp_rk33") // Shu and Osher
+  {
+    m_alpha += 0.0, 1.0/4.0, 2.0/3.0;
+    m_beta  += 1.0, 1.0/4.0, 2.0/3.0;
+    m_gamma += 0.0, 1.0,     0.5;
 
-      m_gamma[0] = 0.0;
-      m_gamma[1] = 0.5;
-      m_gamma[2] = 1.0;
-      break;
+    // embedded 2nd order: the first 2 stages (Heun)
+    m_embedded_order = 2;
+    m_error_weights += -1.0/3.0, -1.0/3.0, 2.0/3.0;
+  }
+  else if (m_scheme == "ssp_rk43") // Spiteri and Ruuth, SSP coefficient 2
+  {
+    m_alpha += 0.0, 1.0, 1.0/3.0, 1.0;
+    m_beta  += 0.5, 0.5, 1.0/6.0, 0.5;
+    m_gamma += 0.0, 0.5, 1.0,     0.5;
 
-    case 4:    // R-K 4
-    default:
-      m_alpha.resize(m_stages);
-      m_beta .resize(m_stages);
-      m_gamma.resize(m_stages);
-
-      m_alpha[0] = 0.0;
-      m_alpha[1] = 0.0;
-      m_alpha[2] = 0.0;
-      m_alpha[3] = 0.0;
-
-      m_beta [0] = 1.0/4.0;
-      m_beta [1] = 1.0/3.0;
-      m_beta [2] = 1.0/2.0;
-      m_beta [3] = 1.0;
-
-      m_gamma[0] = 0.0;
-      m_gamma[1] = 0.5;
-      m_gamma[2] = 0.5;
-      m_gamma[3] = 1.0;
-      break;
+    // embedded 2nd order: equal weights 1/4
+    m_embedded_order = 2;
+    m_error_weights += -1.0/12.0, -1.0/12.0, -1.0/12.0, 1.0/4.0;
+  }
+  else if (m_scheme == "ls_rk45") // Carpenter and Kennedy, 2N-storage
+  {
+    m_low_storage = true;
+    m_A     += 0.0,
+               -567301805773.0/1357537059087.0,
+               -2404267990393.0/2016746695238.0,
+               -3550918686646.0/2091501179385.0,
+               -1275806237668.0/842570457699.0;
+    m_B     += 1432997174477.0/9575080441755.0,
+               5161836677717.0/13612068292357.0,
+               1720146321549.0/2090206949498.0,
+               3134564353537.0/4481467310338.0,
+               2277821191437.0/14882151754819.0;
+    m_gamma += 0.0,
+               1432997174477.0/9575080441755.0,
+               2526269341429.0/6820363962896.0,
+               2006345519317.0/3224310063776.0,
+               2802321613138.0/2924317926251.0;
+
+    // embedded 3rd order, from the first 4 stages
+    m_embedded_order = 3;
+    m_error_weights += -4.89542357656109,
+                       10.525898847361978,
+                       -7.452185327504098,
+                       1.6686528087350587,
+                       0.15305724796815198;
+  }
+  else if (m_scheme == "custom")
+  {
+    m_alpha = option("alpha").value< std::vector<Real> >();
+    m_beta  = option("beta" ).value< std::vector<Real> >();
+    m_gamma = option("gamma").value< std::vector<Real> >();
+    if (m_gamma.empty()) // not yet configured
+      return;
+    if (m_alpha.size() != m_gamma.size() || m_beta.size() != m_gamma.size())
+      throw BadValue(FromHere(),"alpha, beta and gamma must have one coefficient per stage");
+    config_custom_error_weights();
+  }
+  else if (m_scheme == "custom_2N")
+  {
+    m_low_storage = true;
+    m_A     = option("A"    ).value< std::vector<Real> >();
+    m_B     = option("B"    ).value< std::vector<Real> >();
+    m_gamma = option("gamma").value< std::vector<Real> >();
+    if (m_gamma.empty()) // not yet configured
+      return;
+    if (m_A.size() != m_gamma.size() || m_B.size() != m_gamma.size())
+      throw BadValue(FromHere(),"A, B and gamma must have one coefficient per stage");
+    config_custom_error_weights();
   }
 
   if (m_gamma[0] != 0) throw BadValue(FromHere(),"gamma[0] must be zero for consistent time marching");
@@ -153,33 +328,83 @@ void RK::config_stages()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void RK::config_custom_error_weights()
+{
+  m_error_weights = option("error_weights").value< std::vector<Real> >();
+  m_embedded_order = option("embedded_order").value<Uint>();
+  if (!m_error_weights.empty() && m_error_weights.size() != m_gamma.size())
+    throw BadValue(FromHere(),"error_weights must have one coefficient per stage");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void RK::execute()
 {
   if (m_solution.expired()) throw SetupError (FromHere(), "solution was not set");
+  if (m_gamma.empty()) throw SetupError (FromHere(), "the coefficients of the \""+m_scheme+"\" scheme were not set");
 
-  if ( m_solution_backup.expired() )  // backup not created --> create field
-    m_solution_backup = mesh().create_field("solution_backup",*m_solution.lock()).as_ptr<CField>();
+  // a single register: the solution at the start of the stages for the Shu-Osher form,
+  // or the solution increment for the 2N-storage form
 
-  const CTable<Real>& U  = m_solution.lock()->data();
-  CTable<Real>&       U0 = m_solution_backup.lock()->data();
+  if (m_low_storage)
+  {
+    if ( m_solution_increment.expired() )  // increment not created --> create field
+      m_solution_increment = mesh().create_field("solution_increment",*m_solution.lock()).as_ptr<CField>();
+    m_update->configure_option("solution_increment",m_solution_increment.lock()->uri());
+  }
+  else
+  {
+    if ( m_solution_backup.expired() )  // backup not created --> create field
+      m_solution_backup = mesh().create_field("solution_backup",*m_solution.lock()).as_ptr<CField>();
+    m_update->configure_option("solution_backup",m_solution_backup.lock()->uri());
+  }
 
   /// @todo put this in triggers of own config options
   m_update->configure_option("solution",m_solution.lock()->uri());
-  m_update->configure_option("solution_backup",m_solution_backup.lock()->uri());
   m_update->configure_option("residual",m_residual.lock()->uri());
   m_update->configure_option("update_coeff",m_update_coeff.lock()->uri());
 
-  /// 1) backup solution and time
-  U0 = U;
+  if (m_dual_time_stepping)
+  {
+    if (m_adaptive_time_step)
+      throw SetupError (FromHere(), "adaptive time steps are not supported with dual time stepping");
+    execute_dual_time_step();
+    return;
+  }
+
+  m_update->set_physical_time_step(0.);
 
+  if (m_adaptive_time_step)
+  {
+    execute_adaptive_time_step();
+    return;
+  }
+
+  /// 1) backup time, the solution is backed up by the first stage
   const Real T0 = m_time.lock()->current_time();
 
+  execute_stages(T0,false);
+
+  /// Set time back to pre-stages time, so that the action Solver::CAdvanceTime will update the time
+  /// @note that time().dt() has been modified
+  m_time.lock()->current_time() = T0;
+  m_advance_time->execute();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Real RK::execute_stages(const Real T0, const bool dual)
+{
+  CTime& time = *m_time.lock();
+  Real max_increment = 0.;
+
   /// For every stage of the Runge Kutta scheme
   m_pre_update->configure_option_recursively("freeze_update_coeff",false);
-  for (Uint k=0; k<m_stages; ++k)
+  for (Uint k=0; k<m_gamma.size(); ++k)
   {
-    /// - Set the time for this stage (notice that at first stage time is not modified since m_gamma[0] = 0)
-    m_time.lock()->current_time() = T0 + m_gamma[k] * m_time.lock()->dt();
+    /// - Set the time for this stage (notice that at first stage time is not modified since m_gamma[0] = 0).
+    ///   Pseudo time iterations all converge to the end of the physical time step.
+    time.current_time() = dual ? T0 + time.dt() : T0 + m_gamma[k] * time.dt();
 
     /// - Pre update actions, must compute residual, update_coefficient (and thus time().dt())
     m_pre_update->execute();
@@ -187,18 +412,170 @@ void RK::execute()
     /// - Freeze update_coeff for following stages
     if (k==0) m_pre_update->configure_option_recursively("freeze_update_coeff",true);
 
-    /// - Update solution
+    /// - Restrict the time step to the one of the controller
+    if (k==0 && m_adaptive_time_step && !dual) control_time_step();
+
+    /// - Update solution, in Shu-Osher form
     ///   @f[ U^{k+1} = (1-\alpha_k)\ U^0 + \alpha_k \ U^k + \beta_k H \ R(U^k) @f]
+    ///   or in 2N-storage form
+    ///   @f[ \Delta U = A_k\ \Delta U + H\ R(U^k) , \qquad U^{k+1} = U^k + B_k\ \Delta U @f]
     ///   with @f$ H @f$ the delta of the ODE
-    m_update->set_coefficients(m_alpha[k],m_beta[k]);
+    if (m_low_storage)
+      m_update->set_low_storage_coefficients(m_A[k],m_B[k]);
+    else
+      m_update->set_coefficients(m_alpha[k],m_beta[k]);
+    m_update->set_first_stage(k==0);
+    m_update->estimate_error(m_adaptive_time_step && !dual, m_adaptive_time_step && !dual ? m_error_weights[k] : 0.);
     m_update->execute();
 
+    if (k==0) max_increment = m_update->max_increment();
+
     /// - Post update actions, filters, checks, ...
     m_post_update->execute();
   }
+  return max_increment;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RK::control_time_step()
+{
+  CTime& time = *m_time.lock();
+  if (m_dt_control >= time.dt())
+    return;
+
+  // the update coefficient is proportional to the time step
+  const Real factor = m_dt_control / time.dt();
+  CTable<Real>& update_coeff = m_update_coeff.lock()->data();
+  for (Uint i=0; i<update_coeff.size(); ++i)
+    update_coeff[i][0] *= factor;
+  time.dt() = m_dt_control;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Real RK::error_norm() const
+{
+  const CTable<Real>& U  = m_solution.lock()->data();
+  const CTable<Real>& U0 = m_solution_backup.lock()->data();
+  const CTable<Real>& E  = m_solution_error.lock()->data();
+
+  Real error = 0.;
+  for (Uint i=0; i<U.size(); ++i)
+    for (Uint j=0; j<U.row_size(); ++j)
+    {
+      const Real scale = m_absolute_tolerance + m_relative_tolerance * std::max(std::abs(U[i][j]),std::abs(U0[i][j]));
+      error = std::max(error, std::abs(E[i][j]) / scale);
+    }
+
+  // all processes accept or reject the step, and control the time step, alike
+  if ( mpi::PE::instance().is_active() )
+  {
+    Real local = error;
+    mpi::PE::instance().all_reduce( mpi::max(), &local, 1, &error );
+  }
+  return error;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RK::execute_adaptive_time_step()
+{
+  if (m_error_weights.empty())
+    throw SetupError (FromHere(), "the \""+m_scheme+"\" scheme has no embedded pair for an adaptive time step");
+
+  // the solution at the start of the step, to retry it, and the error estimate
+
+  if ( m_solution_backup.expired() )
+    m_solution_backup = mesh().create_field("solution_backup",*m_solution.lock()).as_ptr<CField>();
+  if ( m_solution_error.expired() )
+    m_solution_error = mesh().create_field("solution_error",*m_solution.lock()).as_ptr<CField>();
+  m_update->configure_option("solution_backup",m_solution_backup.lock()->uri());
+  m_update->configure_option("solution_error",m_solution_error.lock()->uri());
+
+  CTime& time = *m_time.lock();
+  const Real T0 = time.current_time();
+
+  // PI controller of Gustafsson, the exponents scaled with the order of the error estimate
+  const Real q = m_embedded_order + 1.;
+  const Real min_factor = 0.2;
+  const Real max_factor = 5.;
+
+  for(;;)
+  {
+    execute_stages(T0,false);
+    const Real dt = time.dt();
+    const Real error = error_norm();
+
+    if (error <= 1.)  // accept the step
+    {
+      Real factor = max_factor;
+      if (error > 0.)
+        factor = m_safety_factor * std::pow(error,-0.7/q) * std::pow(m_previous_error,0.4/q);
+      m_dt_control = dt * std::min(max_factor, std::max(min_factor, factor));
+      m_previous_error = std::max(error,1e-4);
+      break;
+    }
+
+    // reject the step and retry it with a smaller time step
+    const Real factor = std::max(min_factor, m_safety_factor * std::pow(error,-1./q));
+    m_dt_control = dt * std::min(1., factor);
+    if (m_dt_control <= Math::Consts::eps() * std::max(1.,std::abs(T0)))
+      throw FailedToConverge (FromHere(), "adaptive time step vanishes at time "+to_str(T0));
+
+    CFdebug << "  time step " << dt << " rejected with error " << error << ", retrying with " << m_dt_control << CFendl;
+
+    m_solution.lock()->data() = m_solution_backup.lock()->data();
+    time.current_time() = T0;
+  }
+
   /// Set time back to pre-stages time, so that the action Solver::CAdvanceTime will update the time
-  /// @note that time().dt() has been modified
-  m_time.lock()->current_time() = T0;
+  time.current_time() = T0;
+  m_advance_time->execute();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RK::execute_dual_time_step()
+{
+  if (m_time.expired()) throw SetupError (FromHere(), "time was not set, but is required for dual time stepping");
+
+  if ( m_solution_time_level.expired() )
+    m_solution_time_level = mesh().create_field("solution_time_level",*m_solution.lock()).as_ptr<CField>();
+
+  m_update->configure_option("solution_time_level",m_solution_time_level.lock()->uri());
+  if ( !m_cell_volume.expired() )
+    m_update->configure_option("cell_volume",m_cell_volume.lock()->uri());
+
+  CTime& time = *m_time.lock();
+
+  /// 1) backup solution and time at the start of the physical time step
+  m_solution_time_level.lock()->data() = m_solution.lock()->data();
+  const Real T0 = time.current_time();
+
+  /// 2) physical time step, not restricted by any CFL condition
+  Real dt = time.option("time_step").value<Real>();
+  if ( T0 + dt > time.end_time() )
+    dt = time.end_time() - T0;
+  if ( dt <= 0. )
+    throw BadValue (FromHere(), "dual time stepping requires a positive time step in "+time.uri().string());
+  time.dt() = dt;
+  m_update->set_physical_time_step(dt);
+
+  /// 3) pseudo time iterations, with local pseudo time steps, until the
+  ///    forward Euler increment of the first stage is small enough
+  for (time.inner_iter()=0; time.inner_iter()<m_inner_iterations; ++time.inner_iter())
+  {
+    const Real max_increment = execute_stages(T0,true);
+    if (max_increment < m_inner_tolerance)
+    {
+      ++time.inner_iter();
+      break;
+    }
+  }
+
+  /// 4) advance the physical time
+  time.current_time() = T0;
   m_advance_time->execute();
 }
 
@@ -28,11 +28,22 @@ namespace RungeKutta {
 /// This method is based on the RKLS (Runge Kutta Low Storage) plugin found in
 /// COOLFluiD version 2.
 /// This action provides looping over runge kutta stages. @n
+/// The schemes are given in Shu-Osher form or in Williamson 2N-storage form,
+/// so that only one field is needed besides the solution and the residual. @n
+/// With the option "adaptive_time_step", the error estimate of the embedded pair
+/// of the scheme drives a PI controller of the time step. A step with a too large
+/// error is retried from the solution backup with a smaller time step. @n
 /// There are 2 slots to put custom actions inside:
 /// - pre_update_actions
 /// - post_update_actions
 /// The update itself is delegated to the UpdateSolution component
 /// time and dt are updated as well. (time update could be separate)
+///
+/// With the option "dual_time_stepping", every physical time step of size
+/// CTime "time_step" is solved implicitly (backward Euler) by iterating the
+/// stages in pseudo time, with the local pseudo time steps computed by the
+/// pre_update_actions. The pseudo time iterations stop after "inner_iterations"
+/// or when the maximum change of the solution drops below "inner_tolerance".
 /// @author Willem Deconinck
 class RungeKutta_API RK : public Solver::Action {
 
@@ -57,11 +68,50 @@ public: // functions
 
 private:
 
-  void config_stages();
+  void config_scheme();
+
+  /// executes all the stages once
+  /// @param T0    time at the start of the stages
+  /// @param dual  if true, the stages are pseudo time iterations at time T0 + dt
+  /// @return the largest change of the solution in a forward Euler step from the first stage
+  Real execute_stages(const Real T0, const bool dual);
+
+  /// one physical time step of dual time stepping
+  void execute_dual_time_step();
+
+  /// one time step with error control, retried until its error is small enough
+  void execute_adaptive_time_step();
+
+  /// restricts the time step and the update coefficient to the time step of the controller
+  void control_time_step();
+
+  /// @return the maximum of the error estimate scaled by the tolerances, over all processes
+  Real error_norm() const;
+
+  void config_custom_error_weights();
 
 private:
 
   Uint m_stages;
+  std::string m_scheme;
+
+  /// Williamson 2N-storage form if true, Shu-Osher form otherwise
+  bool m_low_storage;
+
+  bool m_dual_time_stepping;
+  Uint m_inner_iterations;
+  Real m_inner_tolerance;
+
+  bool m_adaptive_time_step;
+  Real m_absolute_tolerance;
+  Real m_relative_tolerance;
+  Real m_safety_factor;
+  /// order of the solution embedded in the scheme
+  Uint m_embedded_order;
+  /// time step proposed by the controller
+  Real m_dt_control;
+  /// error of the previous accepted step
+  Real m_previous_error;
 
   boost::shared_ptr<Common::CGroup> m_for_each_stage;
   boost::shared_ptr<Common::CGroupActions> m_pre_update;
@@ -75,10 +125,18 @@ private:
   boost::weak_ptr<Mesh::CField> m_residual;
   boost::weak_ptr<Mesh::CField> m_update_coeff;
   boost::weak_ptr<Mesh::CField> m_solution_backup;
+  boost::weak_ptr<Mesh::CField> m_solution_increment;
+  boost::weak_ptr<Mesh::CField> m_solution_error;
+  boost::weak_ptr<Mesh::CField> m_solution_time_level;
+  boost::weak_ptr<Mesh::CField> m_cell_volume;
 
   std::vector<Real> m_alpha;
   std::vector<Real> m_beta;
   std::vector<Real> m_gamma;
+  std::vector<Real> m_A;
+  std::vector<Real> m_B;
+  /// differences of the stage weights of the embedded pair
+  std::vector<Real> m_error_weights;
 
 };
 
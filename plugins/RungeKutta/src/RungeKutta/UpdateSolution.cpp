@@ -8,6 +8,7 @@
 #include "Common/CBuilder.hpp"
 #include "Common/OptionComponent.hpp"
 #include "Common/OptionT.hpp"
+#include "Common/MPI/PE.hpp"
 #include "Mesh/CField.hpp"
 #include "Mesh/CMesh.hpp"
 #include "RungeKutta/UpdateSolution.hpp"
@@ -28,8 +29,16 @@ Common::ComponentBuilder < UpdateSolution, CAction, LibRungeKutta > UpdateSoluti
 
 UpdateSolution::UpdateSolution ( const std::string& name ) :
   CAction(name),
+  m_low_storage(false),
+  m_first_stage(true),
   m_alpha(1.),  // forward euler step with these coefficients for alpha and beta
-  m_beta(1.)
+  m_beta(1.),
+  m_A(0.),
+  m_B(1.),
+  m_estimate_error(false),
+  m_error_weight(0.),
+  m_invdt(0.),
+  m_max_increment(0.)
 {
   mark_basic();
 
@@ -40,9 +49,17 @@ UpdateSolution::UpdateSolution ( const std::string& name ) :
       ->pretty_name("Solution");
 
   m_options.add_option(OptionComponent<CField>::create("solution_backup", &m_solution_backup))
-      ->description("Solution Backup")
+      ->description("Solution at the start of the stages, register of the Shu-Osher form")
       ->pretty_name("Solution Backup");
 
+  m_options.add_option(OptionComponent<CField>::create("solution_increment", &m_solution_increment))
+      ->description("Solution increment, register of the Williamson 2N-storage form")
+      ->pretty_name("Solution Increment");
+
+  m_options.add_option(OptionComponent<CField>::create("solution_error", &m_solution_error))
+      ->description("Error estimate of an embedded Runge Kutta pair, accumulated over the stages")
+      ->pretty_name("Solution Error");
+
   m_options.add_option(OptionComponent<CField>::create("update_coeff", &m_update_coeff))
       ->description("Update coefficient")
       ->pretty_name("Update Coefficient");
@@ -51,10 +68,14 @@ UpdateSolution::UpdateSolution ( const std::string& name ) :
       ->description("Residual")
       ->pretty_name("Residual");
 
-  m_solution_view = create_static_component_ptr<CMultiStateFieldView>("solution_view");
-  m_solution_backup_view = create_static_component_ptr<CMultiStateFieldView>("solution_backup_view");
-  m_residual_view = create_static_component_ptr<CMultiStateFieldView>("residual_view");
-  m_update_coeff_view = create_static_component_ptr<CScalarFieldView>("update_coeff_view");
+  m_options.add_option(OptionComponent<CField>::create("solution_time_level", &m_solution_time_level))
+      ->description("Solution at the previous physical time level, for dual time stepping")
+      ->pretty_name("Solution Time Level");
+
+  m_options.add_option(OptionComponent<CField>::create("cell_volume", &m_cell_volume))
+      ->description("Volume of the cells, for dual time stepping with residuals integrated over the cells"
+                    " (finite volumes). Leave empty for point-wise residuals.")
+      ->pretty_name("Cell Volume");
 
   m_options.add_option(OptionT<Real>::create("alpha", m_alpha))
       ->description("RK coefficient alpha")
@@ -72,49 +93,116 @@ UpdateSolution::UpdateSolution ( const std::string& name ) :
 void UpdateSolution::execute()
 {
   if (m_solution.expired())     throw SetupError(FromHere(), "Solution field was not set");
-  if (m_solution_backup.expired())     throw SetupError(FromHere(), "Solution backup field was not set");
   if (m_residual.expired())     throw SetupError(FromHere(), "Residual field was not set");
   if (m_update_coeff.expired()) throw SetupError(FromHere(), "UpdateCoeff Field was not set");
 
-  CScalarFieldView& update_coeff = *m_update_coeff_view;
-  CMultiStateFieldView& residual = *m_residual_view;
-  CMultiStateFieldView& solution = *m_solution_view;
-  CMultiStateFieldView& solution_backup = *m_solution_backup_view;
+  // the residual, update coefficient and registers are created from the solution,
+  // and share its rows, so the update is a single pass over contiguous tables
+
+  CTable<Real>& U = m_solution.lock()->data();
+  const CTable<Real>& R = m_residual.lock()->data();
+  const CTable<Real>& H = m_update_coeff.lock()->data();
 
-  /// @todo put this in attached triggers of the field configuration
-  residual.set_field(m_residual.lock());
-  solution.set_field(m_solution.lock());
-  solution_backup.set_field(m_solution_backup.lock());
-  update_coeff.set_field(m_update_coeff.lock());
+  cf_assert(R.size() == U.size());
+  cf_assert(H.size() == U.size());
 
-  const Real one_minus_alpha = 1.-m_alpha;
-  boost_foreach(const CEntities& elements, m_solution.lock()->field_elements())
+  // registers: the increment of the 2N-storage form, the solution at the start
+  // of the stages (also kept by the 2N-storage form if it is given, to retry a step),
+  // and the embedded error estimate
+
+  CTable<Real>* dU = nullptr;
+  CTable<Real>* U0 = nullptr;
+  CTable<Real>* E  = nullptr;
+  if (m_low_storage)
+  {
+    if (m_solution_increment.expired()) throw SetupError(FromHere(), "Solution increment field was not set");
+    dU = &m_solution_increment.lock()->data();
+    cf_assert(dU->size() == U.size());
+  }
+  else
   {
-    residual.set_elements(elements);
-    solution.set_elements(elements);
-    solution_backup.set_elements(elements);
-    update_coeff.set_elements(elements);
+    if (m_solution_backup.expired())  throw SetupError(FromHere(), "Solution backup field was not set");
+  }
+  if (!m_solution_backup.expired())
+  {
+    U0 = &m_solution_backup.lock()->data();
+    cf_assert(U0->size() == U.size());
+  }
+  if (m_estimate_error)
+  {
+    if (m_solution_error.expired())  throw SetupError(FromHere(), "Solution error field was not set");
+    E = &m_solution_error.lock()->data();
+    cf_assert(E->size() == U.size());
+  }
 
-    for (Uint e=0; e<elements.size(); ++e)
+  // dual time stepping adds the physical time derivative to the residual
+  const bool dual_time = (m_invdt != 0.);
+  const CTable<Real>* Un = nullptr;
+  const CTable<Real>* V  = nullptr;
+  if (dual_time)
+  {
+    if (m_solution_time_level.expired()) throw SetupError(FromHere(), "Solution time level field was not set");
+    Un = &m_solution_time_level.lock()->data();
+    cf_assert(Un->size() == U.size());
+    if (!m_cell_volume.expired())
     {
-      CMultiStateFieldView::View U  = solution[e];
-      CMultiStateFieldView::View U0 = solution_backup[e];
-      CMultiStateFieldView::View R  = residual[e];
-      const Real H                  = update_coeff[e];
-      for (Uint i=0; i<U.shape()[0]; ++i)
+      V = &m_cell_volume.lock()->data();
+      if (V->size() != U.size())
+        throw SetupError(FromHere(), "Cell volume field "+m_cell_volume.lock()->uri().string()+" does not match the solution");
+    }
+  }
+
+  // coefficients of the stage, the first one initializing the register
+  const Real A      = m_first_stage ? 0. : m_A;
+  const Real alpha  = m_first_stage ? 1. : m_alpha;
+  const Real one_minus_alpha = 1.-alpha;
+
+  const bool backup = m_first_stage && U0;
+
+  const Uint nb_vars = U.row_size();
+  Real max_increment = 0.;
+  for (Uint i=0; i<U.size(); ++i)
+  {
+    CTable<Real>::Row Ui = U[i];
+    const Real Hi = H[i][0];
+    const Real V_dt = dual_time ? (V ? (*V)[i][0] : 1.) * m_invdt : 0.;
+
+    for (Uint j=0; j<nb_vars; ++j)
+    {
+      Real increment = Hi*R[i][j];
+      if (dual_time)
+        increment -= Hi*V_dt*(Ui[j]-(*Un)[i][j]);
+      max_increment = std::max(max_increment, std::abs(increment));
+
+      if (backup)
+        (*U0)[i][j] = Ui[j];
+
+      if (E)
+        (*E)[i][j] = m_first_stage ? m_error_weight*increment : (*E)[i][j] + m_error_weight*increment;
+
+      if (m_low_storage)
       {
-        for (Uint j=0; j<U.shape()[1]; ++j)
-        {
-          U[i][j] = one_minus_alpha*U0[i][j] + m_alpha*U[i][j] + m_beta*H*R[i][j];
-        }
+        Real& dUij = (*dU)[i][j];
+        dUij = A*dUij + increment;
+        Ui[j] += m_B*dUij;
+      }
+      else
+      {
+        Ui[j] = one_minus_alpha*(*U0)[i][j] + alpha*Ui[j] + m_beta*increment;
       }
     }
   }
+
+  // the increment is the same on all processes, to take the same decisions
+  if ( mpi::PE::instance().is_active() )
+    mpi::PE::instance().all_reduce( mpi::max(), &max_increment, 1, &m_max_increment );
+  else
+    m_max_increment = max_increment;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-} // SFDM
+} // RungeKutta
 } // CF
 
 ////////////////////////////////////////////////////////////////////////////////////
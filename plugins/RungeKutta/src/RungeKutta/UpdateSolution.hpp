@@ -8,7 +8,6 @@
 #define CF_RungeKutta_UpdateSolution_hpp
 
 #include "Common/CAction.hpp"
-#include "Mesh/CFieldView.hpp"
 #include "RungeKutta/LibRungeKutta.hpp"
 
 /////////////////////////////////////////////////////////////////////////////////////
@@ -17,6 +16,23 @@ namespace CF {
 namespace Mesh   { class CField; }
 namespace RungeKutta {
 
+/// Update of the solution in one stage of a Runge Kutta method, in a single
+/// pass over the fields. Two low-storage forms are supported, each needing one
+/// register besides the solution and the residual:
+/// - Shu-Osher form, with the register @f$ U^0 @f$ holding the solution at the
+///   start of the stages, copied during the first stage
+///   @f[ U^{k+1} = (1-\alpha_k)\ U^0 + \alpha_k\ U^k + \beta_k\ H\ R^*(U^k) @f]
+/// - Williamson 2N-storage form, with the register @f$ \Delta U @f$
+///   @f[ \Delta U = A_k\ \Delta U + H\ R^*(U^k) , \qquad U^{k+1} = U^k + B_k\ \Delta U @f]
+///
+/// The error estimate of an embedded pair, @f$ E = \sum_k e_k\ H\ R^*(U^k) @f$,
+/// is accumulated in the same pass if requested.
+///
+/// In dual time stepping, @f$ H @f$ is a local pseudo time step, and the
+/// residual is augmented with the implicit (backward Euler) physical time derivative
+/// @f[ R^*(U) = R(U) - V \frac{U - U^n}{\Delta t} @f]
+/// with @f$ V @f$ the volume of the cell for residuals integrated over the cells,
+/// or 1 for point-wise residuals.
 class RungeKutta_API UpdateSolution : public Common::CAction
 {
 public: // typedefs
@@ -39,26 +55,72 @@ public: // functions
   /// execute the action
   virtual void execute ();
 
+  /// sets the coefficients of a stage in Shu-Osher form
   void set_coefficients(const Real& alpha, const Real& beta)
   {
+    m_low_storage = false;
     m_alpha = alpha;
     m_beta = beta;
   }
 
-private: // data
+  /// sets the coefficients of a stage in Williamson 2N-storage form
+  void set_low_storage_coefficients(const Real& A, const Real& B)
+  {
+    m_low_storage = true;
+    m_A = A;
+    m_B = B;
+  }
+
+  /// marks the next stage as the first one, which initializes the registers
+  void set_first_stage(const bool first_stage) { m_first_stage = first_stage; }
+
+  /// accumulates the error estimate of an embedded pair in the "solution_error" field
+  /// @param estimate  if false, no error is estimated
+  /// @param weight    difference of the weights of the stage in the two solutions of the pair
+  void estimate_error(const bool estimate, const Real& weight = 0.)
+  {
+    m_estimate_error = estimate;
+    m_error_weight = weight;
+  }
+
+  /// sets the physical time step of dual time stepping
+  /// @param dt  physical time step, or 0 to solve the ODE without physical time derivative
+  void set_physical_time_step(const Real& dt)
+  {
+    m_invdt = dt > 0. ? 1./dt : 0.;
+  }
 
-  Mesh::CScalarFieldView::Ptr m_update_coeff_view;
-  Mesh::CMultiStateFieldView::Ptr m_residual_view;
-  Mesh::CMultiStateFieldView::Ptr m_solution_view;
-  Mesh::CMultiStateFieldView::Ptr m_solution_backup_view;
+  /// @return the maximum absolute value of @f$ H\ R^* @f$ in the last stage,
+  ///         i.e. the largest change of a forward Euler step, over all processes
+  Real max_increment() const { return m_max_increment; }
+
+private: // data
 
   boost::weak_ptr<Mesh::CField> m_solution;
   boost::weak_ptr<Mesh::CField> m_solution_backup;
+  boost::weak_ptr<Mesh::CField> m_solution_increment;
+  boost::weak_ptr<Mesh::CField> m_solution_error;
   boost::weak_ptr<Mesh::CField> m_residual;
   boost::weak_ptr<Mesh::CField> m_update_coeff;
+  boost::weak_ptr<Mesh::CField> m_solution_time_level;
+  boost::weak_ptr<Mesh::CField> m_cell_volume;
+
+  /// Williamson 2N-storage form if true, Shu-Osher form otherwise
+  bool m_low_storage;
+  bool m_first_stage;
 
   Real m_alpha;
   Real m_beta;
+  Real m_A;
+  Real m_B;
+
+  bool m_estimate_error;
+  Real m_error_weight;
+
+  /// inverse of the physical time step, 0 if not in dual time stepping
+  Real m_invdt;
+
+  Real m_max_increment;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
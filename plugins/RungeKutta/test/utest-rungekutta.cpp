@@ -14,6 +14,7 @@
 #include "Common/Core.hpp"
 #include "Common/CRoot.hpp"
 #include "Common/CEnv.hpp"
+#include "Common/OptionT.hpp"
 
 #include "Math/Defs.hpp"
 #include "Mesh/CSimpleMeshGenerator.hpp"
@@ -31,6 +32,54 @@ using namespace CF::Mesh;
 
 //////////////////////////////////////////////////////////////////////////////
 
+/// Residual of the ODE dU/dt = -lambda U, with the update coefficient of
+/// dual time stepping for a constant pseudo time step, or the time step
+/// of the time component, limited by the end time, if dtau is zero
+class Decay : public CAction
+{
+public:
+
+  typedef boost::shared_ptr<Decay> Ptr;
+
+  Decay ( const std::string& name ) : CAction(name), lambda(1.), dtau(0.), freeze(false)
+  {
+    m_options.add_option(OptionT<bool>::create("freeze_update_coeff", freeze))
+      ->link_to(&freeze);
+  }
+
+  static std::string type_name () { return "Decay"; }
+
+  virtual void execute()
+  {
+    CTable<Real>& U = solution->data();
+    CTable<Real>& R = residual->data();
+    CTable<Real>& H = update_coeff->data();
+    for (Uint i=0; i<U.size(); ++i)
+      R[i][0] = -lambda*U[i][0];
+
+    if (freeze)
+      return;
+
+    if (dtau == 0.)
+      time->dt() = std::min( time->option("time_step").value<Real>(), time->end_time() - time->current_time() );
+
+    const Real dt = time->dt();
+    for (Uint i=0; i<U.size(); ++i)
+      H[i][0] = dtau > 0. ? dtau*dt/(dtau+dt) : dt;
+  }
+
+  CField::Ptr solution;
+  CField::Ptr residual;
+  CField::Ptr update_coeff;
+  CTime::Ptr time;
+
+  Real lambda;
+  Real dtau;
+  bool freeze;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_SUITE( RiemannSolvers_Suite )
 
 //////////////////////////////////////////////////////////////////////////////
@@ -61,6 +110,147 @@ BOOST_AUTO_TEST_CASE( test_RK )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_CASE( test_RK_dual_time_stepping )
+{
+  CMesh& mesh = Core::instance().root().create_component<CMesh>("mesh_dual");
+  CSimpleMeshGenerator::create_line(mesh,1.,10);
+  allocate_component<Mesh::Actions::CreateSpaceP0>("create_space[0]")->transform(mesh);
+  CField& solution = mesh.create_field("solution",CField::Basis::CELL_BASED);
+  CField& residual = mesh.create_field("residual",solution);
+  CField& update_coeff = mesh.create_scalar_field("update_coeff",solution);
+  solution.data() = 1.;
+
+  CTime& time = Core::instance().root().create_component<CTime>("time_dual");
+  time.configure_option("time_step",0.5);
+  time.configure_option("end_time",10.);
+
+  RK& rk = Core::instance().root().create_component<RK>("RK_dual");
+  rk.configure_option("stages",2u);
+  rk.configure_option("dual_time_stepping",true);
+  rk.configure_option("inner_iterations",100u);
+  rk.configure_option("inner_tolerance",1e-14);
+  rk.configure_option_recursively("mesh",mesh.uri());
+  rk.configure_option_recursively("ctime",time.uri());
+  rk.configure_option("solution",solution.uri());
+  rk.configure_option("residual",residual.uri());
+  rk.configure_option("update_coeff",update_coeff.uri());
+
+  Decay::Ptr decay = allocate_component<Decay>("decay");
+  decay->dtau = 0.5;
+  decay->solution = solution.as_ptr<CField>();
+  decay->residual = residual.as_ptr<CField>();
+  decay->update_coeff = update_coeff.as_ptr<CField>();
+  decay->time = time.as_ptr<CTime>();
+  rk.access_component("1_for_each_stage/1_pre_update_actions").add_component(decay);
+
+  // two backward Euler steps:  U^{n+1} = U^n / (1 + lambda dt)
+  rk.execute();
+  rk.execute();
+
+  BOOST_CHECK_CLOSE(time.current_time(), 1., 1e-10);
+  BOOST_CHECK_EQUAL(time.iter(), 2u);
+  BOOST_CHECK_LT(time.inner_iter(), 100u);
+  for (Uint i=0; i<solution.data().size(); ++i)
+    BOOST_CHECK_CLOSE(solution.data()[i][0], 1./(1.5*1.5), 1e-10);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// integrates dU/dt = -U until t = 1 with a given scheme
+/// @return the solution in the first cell
+Real integrate_decay(const std::string& scheme)
+{
+  CMesh& mesh = Core::instance().root().create_component<CMesh>("mesh_"+scheme);
+  CSimpleMeshGenerator::create_line(mesh,1.,10);
+  allocate_component<Mesh::Actions::CreateSpaceP0>("create_space[0]")->transform(mesh);
+  CField& solution = mesh.create_field("solution",CField::Basis::CELL_BASED);
+  CField& residual = mesh.create_field("residual",solution);
+  CField& update_coeff = mesh.create_scalar_field("update_coeff",solution);
+  solution.data() = 1.;
+
+  CTime& time = Core::instance().root().create_component<CTime>("time_"+scheme);
+  time.configure_option("time_step",0.1);
+  time.configure_option("end_time",1.);
+
+  RK& rk = Core::instance().root().create_component<RK>("RK_"+scheme);
+  rk.configure_option("scheme",scheme);
+  rk.configure_option_recursively("mesh",mesh.uri());
+  rk.configure_option_recursively("ctime",time.uri());
+  rk.configure_option("solution",solution.uri());
+  rk.configure_option("residual",residual.uri());
+  rk.configure_option("update_coeff",update_coeff.uri());
+
+  Decay::Ptr decay = allocate_component<Decay>("decay");
+  decay->solution = solution.as_ptr<CField>();
+  decay->residual = residual.as_ptr<CField>();
+  decay->update_coeff = update_coeff.as_ptr<CField>();
+  decay->time = time.as_ptr<CTime>();
+  rk.access_component("1_for_each_stage/1_pre_update_actions").add_component(decay);
+
+  for (Uint i=0; i<10; ++i)
+    rk.execute();
+
+  BOOST_CHECK_CLOSE(time.current_time(), 1., 1e-10);
+
+  // only one register besides the solution and the residual
+  BOOST_CHECK( is_null(mesh.get_child_ptr("solution_backup")) || is_null(mesh.get_child_ptr("solution_increment")) );
+
+  return solution.data()[0][0];
+}
+
+BOOST_AUTO_TEST_CASE( test_RK_schemes )
+{
+  const Real exact = std::exp(-1.);
+
+  // errors of order dt^3 and dt^4
+  BOOST_CHECK_CLOSE( integrate_decay("ssp_rk33"), exact, 1e-2 );
+  BOOST_CHECK_CLOSE( integrate_decay("ssp_rk43"), exact, 1e-2 );
+  BOOST_CHECK_CLOSE( integrate_decay("ls_rk45"),  exact, 1e-3 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_RK_adaptive_time_step )
+{
+  CMesh& mesh = Core::instance().root().create_component<CMesh>("mesh_adaptive");
+  CSimpleMeshGenerator::create_line(mesh,1.,10);
+  allocate_component<Mesh::Actions::CreateSpaceP0>("create_space[0]")->transform(mesh);
+  CField& solution = mesh.create_field("solution",CField::Basis::CELL_BASED);
+  CField& residual = mesh.create_field("residual",solution);
+  CField& update_coeff = mesh.create_scalar_field("update_coeff",solution);
+  solution.data() = 1.;
+
+  // a maximum time step far too large for the tolerances
+  CTime& time = Core::instance().root().create_component<CTime>("time_adaptive");
+  time.configure_option("time_step",0.5);
+  time.configure_option("end_time",2.);
+
+  RK& rk = Core::instance().root().create_component<RK>("RK_adaptive");
+  rk.configure_option("scheme",std::string("ssp_rk43"));
+  rk.configure_option("adaptive_time_step",true);
+  rk.configure_option("absolute_tolerance",1e-6);
+  rk.configure_option("relative_tolerance",1e-4);
+  rk.configure_option_recursively("mesh",mesh.uri());
+  rk.configure_option_recursively("ctime",time.uri());
+  rk.configure_option("solution",solution.uri());
+  rk.configure_option("residual",residual.uri());
+  rk.configure_option("update_coeff",update_coeff.uri());
+
+  Decay::Ptr decay = allocate_component<Decay>("decay");
+  decay->solution = solution.as_ptr<CField>();
+  decay->residual = residual.as_ptr<CField>();
+  decay->update_coeff = update_coeff.as_ptr<CField>();
+  decay->time = time.as_ptr<CTime>();
+  rk.access_component("1_for_each_stage/1_pre_update_actions").add_component(decay);
+
+  while (time.current_time() + 1e-12 < time.end_time())
+    rk.execute();
+
+  BOOST_CHECK_CLOSE(time.current_time(), 2., 1e-10);
+  BOOST_CHECK_GT(time.iter(), 4u);
+  BOOST_CHECK_CLOSE(solution.data()[0][0], std::exp(-2.), 1e-2);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -7,11 +7,12 @@
 #include "Common/Log.hpp"
 
 #include "Common/CBuilder.hpp"
+#include "Common/BasicExceptions.hpp"
+#include "Common/StringConversion.hpp"
 #include "Common/OptionURI.hpp"
 #include "Common/OptionT.hpp"
-#include "Common/OptionComponent.hpp"
 
-#include "Math/MathConsts.hpp"
+#include "Math/Consts.hpp"
 
 #include "Mesh/CField.hpp"
 #include "Mesh/CMesh.hpp"
@@ -21,11 +22,12 @@
 #include "Mesh/CConnectivity.hpp"
 #include "Mesh/CFaceCellConnectivity.hpp"
 
-#include "Solver/State.hpp"
-
-#include "RiemannSolvers/src/RiemannSolvers/RiemannSolver.hpp"
+#include "Physics/Scalar/LinearAdv2D.hpp"
+#include "Physics/Scalar/Burgers2D.hpp"
+#include "Physics/NavierStokes/Cons2D.hpp"
 
 #include "SFDM/ComputeRhsInCell.hpp"
+#include "SFDM/PhysicsT.hpp"
 #include "SFDM/Reconstruct.hpp"
 #include "SFDM/ShapeFunction.hpp"
 
@@ -33,8 +35,6 @@
 
 using namespace CF::Common;
 using namespace CF::Mesh;
-using namespace CF::RiemannSolvers;
-using namespace CF::Math::MathConsts;
 
 namespace CF {
 namespace SFDM {
@@ -46,7 +46,11 @@ Common::ComponentBuilder < ComputeRhsInCell, Solver::Actions::CLoopOperation, Li
 ///////////////////////////////////////////////////////////////////////////////////////
 
 ComputeRhsInCell::ComputeRhsInCell ( const std::string& name ) :
-  Solver::Actions::CLoopOperation(name)
+  Solver::Actions::CLoopOperation(name),
+  m_compute_rhs(0),
+  m_batch_begin(0),
+  m_batch_end(0),
+  m_neighbor_idx(Math::Consts::uint_max())
 {
   // options
   m_options.add_option(OptionURI::create("solution", URI("cpath:"), URI::Scheme::CPATH))
@@ -73,17 +77,10 @@ ComputeRhsInCell::ComputeRhsInCell ( const std::string& name ) :
     ->mark_basic()
     ->attach_trigger ( boost::bind ( &ComputeRhsInCell::config_jacobian_determinant,   this ) );
 
-  m_options.add_option( OptionT<std::string>::create("riemann_solver", "CF.RiemannSolvers.Roe") )
-    ->description("The component to solve the Rieman Problem on cell-faces")
-    ->pretty_name("Riemann Solver")
-    ->mark_basic()
-    ->attach_trigger ( boost::bind ( &ComputeRhsInCell::build_riemann_solver, this) );
-
-  m_options.add_option( OptionComponent<Solver::State>::create("solution_state", &m_sol_state) )
-    ->description("The component describing the solution state")
-    ->pretty_name("Solution State")
-    ->attach_trigger (boost::bind ( &ComputeRhsInCell::config_solution_physics, this) );
-
+  m_options.add_option( OptionT<std::string>::create("physics", Physics::Scalar::LinearAdv2D::type_name()) )
+    ->description("Physics of the new Physics API evaluated with a static binding (LinearAdv2D, Burgers2D or Cons2D)")
+    ->pretty_name("Physics")
+    ->mark_basic();
 
   m_options["Elements"].attach_trigger ( boost::bind ( &ComputeRhsInCell::trigger_elements,   this ) );
 
@@ -115,13 +112,6 @@ void ComputeRhsInCell::config_solution()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void ComputeRhsInCell::config_solution_physics()
-{
-  m_sol_vars = m_sol_state.lock()->create_physics();
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
 void ComputeRhsInCell::config_residual()
 {
   URI uri;
@@ -166,6 +156,14 @@ void ComputeRhsInCell::trigger_elements()
   m_can_start_loop = m_jacobian_determinant->set_elements(elements());
   m_can_start_loop = m_wave_speed->set_elements(elements());
 
+  // the solution may have changed since the last sweep
+
+  m_batch_begin = m_batch_end = 0;
+  m_neighbor_idx = Math::Consts::uint_max();
+
+  m_face_connectivity.reset();
+  m_cell_connectivity.clear();
+
   if (m_can_start_loop)
   {
     m_solution_sf =  elements().space("solution").shape_function().as_ptr_checked<SFDM::ShapeFunction>();
@@ -188,26 +186,155 @@ void ComputeRhsInCell::trigger_elements()
       m_normal[orientation][orientation] = 1.;
 
     flux.resize(m_nb_vars);
+    left_flux.resize(m_nb_vars);
     flux_in_line.resize(m_flux_sf->nb_nodes_per_line() , m_nb_vars);
     flux_grad_in_line.resize(m_solution_sf->nb_nodes_per_line() , m_nb_vars);
 
-    solution.resize(m_solution_sf->nb_nodes(),m_nb_vars);
+    geometry_coords.resize(elements().element_type().nb_nodes(), elements().element_type().dimension());
+
+    m_batch_solution.resize(m_solution_sf->nb_nodes(), batch_size*m_nb_vars);
+    m_batch_solution_in_flx_pts.resize(m_flux_sf->nb_nodes(), batch_size*m_nb_vars);
+
     neighbor_solution.resize(m_solution_sf->nb_nodes(),m_nb_vars);
+    neighbor_solution_in_flx_pts.resize(m_flux_sf->nb_nodes(),m_nb_vars);
+
+    state.resize(m_nb_vars);
+    left.resize(m_nb_vars);
+    right.resize(m_nb_vars);
+    plane_normal.resize(m_dimensionality);
+
+    m_sol_mapped_coords.resize(m_solution_sf->nb_nodes());
+    for (Uint pt=0; pt<m_solution_sf->nb_nodes(); ++pt)
+      m_sol_mapped_coords[pt] = m_solution_sf->local_coordinates().row(pt).transpose();
+    m_flx_mapped_coords.resize(m_flux_sf->nb_nodes());
+    for (Uint pt=0; pt<m_flux_sf->nb_nodes(); ++pt)
+      m_flx_mapped_coords[pt] = m_flux_sf->local_coordinates().row(pt).transpose();
+
+    // the only dynamic dispatch, once per element type
+    select_compute_rhs();
   }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////
 
-void ComputeRhsInCell::build_riemann_solver()
+void ComputeRhsInCell::execute()
 {
-  if (is_not_null(m_riemann_solver))
-    remove_component(*m_riemann_solver);
-  m_riemann_solver = create_component("riemann_solver",option("riemann_solver").value<std::string>()).as_ptr<RiemannSolver>();
+  // bound to the solution order and physics when the elements were set
+  cf_assert(m_compute_rhs != 0);
+  (this->*m_compute_rhs)();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////
 
-void ComputeRhsInCell::execute()
+template < Uint P, typename PHYS >
+void ComputeRhsInCell::compute_rhs_static()
+{
+  PhysicsT<PHYS> physics;
+  compute_rhs<P>( physics );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+template < typename PHYS >
+ComputeRhsInCell::ComputeRhsFn ComputeRhsInCell::static_compute_rhs() const
+{
+  if ( (Uint) PHYS::MODEL::_ndim != elements().element_type().dimension() )
+    throw SetupError(FromHere(), "Physics " + PHYS::type_name() + " does not match the dimension of " + elements().uri().string());
+
+  // the flux order is always one higher than the solution order
+  switch (m_solution_sf->order())
+  {
+    case 0: return &ComputeRhsInCell::compute_rhs_static<0,PHYS>;
+    case 1: return &ComputeRhsInCell::compute_rhs_static<1,PHYS>;
+    case 2: return &ComputeRhsInCell::compute_rhs_static<2,PHYS>;
+  }
+  throw NotImplemented(FromHere(), "SFDM solution of order " + to_str(m_solution_sf->order()) + " is not supported");
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+void ComputeRhsInCell::select_compute_rhs()
+{
+  const std::string physics = option("physics").value<std::string>();
+
+  if ( physics == Physics::Scalar::LinearAdv2D::type_name() )
+    m_compute_rhs = static_compute_rhs<Physics::Scalar::LinearAdv2D>();
+  else if ( physics == Physics::Scalar::Burgers2D::type_name() )
+    m_compute_rhs = static_compute_rhs<Physics::Scalar::Burgers2D>();
+  else if ( physics == Physics::NavierStokes::Cons2D::type_name() )
+    m_compute_rhs = static_compute_rhs<Physics::NavierStokes::Cons2D>();
+  else
+    throw ValueNotFound(FromHere(), "Physics " + physics + " is not supported by " + type_name());
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+void ComputeRhsInCell::reconstruct_batch( const Uint first_cell )
+{
+  const Uint nb_cells = std::min( Uint(batch_size), elements().size() - first_cell );
+
+  // gather the solution of the cells side by side
+
+  for (Uint cell=0; cell<nb_cells; ++cell)
+  {
+    CMultiStateFieldView::View solution_data = (*m_solution)[first_cell+cell];
+    for (Uint pt=0; pt<m_batch_solution.rows(); ++pt)
+      for (Uint var=0; var<m_nb_vars; ++var)
+        m_batch_solution(pt,cell*m_nb_vars+var) = solution_data[pt][var];
+  }
+
+  // one product for the whole batch, the columns of the last partial batch being unused
+
+  m_batch_solution_in_flx_pts.noalias() = m_reconstruct_solution->value_reconstruction_matrix() * m_batch_solution;
+
+  m_batch_begin = first_cell;
+  m_batch_end   = first_cell + nb_cells;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+const RealMatrix& ComputeRhsInCell::solution_in_flux_points( const Uint cell, Uint& first_col )
+{
+  if (cell >= m_batch_begin && cell < m_batch_end)
+  {
+    first_col = (cell-m_batch_begin)*m_nb_vars;
+    return m_batch_solution_in_flx_pts;
+  }
+
+  // a neighbor outside of the batch is reconstructed alone, once for all its faces
+
+  if (cell != m_neighbor_idx)
+  {
+    CMultiStateFieldView::View solution_data = (*m_solution)[cell];
+    for (Uint pt=0; pt<neighbor_solution.rows(); ++pt)
+      for (Uint var=0; var<m_nb_vars; ++var)
+        neighbor_solution(pt,var) = solution_data[pt][var];
+
+    neighbor_solution_in_flx_pts.noalias() = m_reconstruct_solution->value_reconstruction_matrix() * neighbor_solution;
+    m_neighbor_idx = cell;
+  }
+
+  first_col = 0;
+  return neighbor_solution_in_flx_pts;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+CFaceCellConnectivity& ComputeRhsInCell::cell_connectivity( Component& faces )
+{
+  std::map<Component const*, CFaceCellConnectivity::Ptr>::iterator it = m_cell_connectivity.find(&faces);
+  if (it == m_cell_connectivity.end())
+  {
+    CFaceCellConnectivity::Ptr f2c = faces.get_child("cell_connectivity").as_ptr_checked<CFaceCellConnectivity>();
+    it = m_cell_connectivity.insert( std::make_pair(&faces,f2c) ).first;
+  }
+  return *it->second;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+template < Uint P, typename PHYSICS >
+void ComputeRhsInCell::compute_rhs( PHYSICS& physics )
 {
   /// @section _theory Theory
   /// A general 2D non-linear system of hyperbolic equations is given:
@@ -257,28 +384,35 @@ void ComputeRhsInCell::execute()
   /// <ul>
   // idx() is the index that is set using the function set_loop_idx() or configuration LoopIndex
 
-  Reconstruct& reconstruct_solution_in_all_flux_points = *m_reconstruct_solution;
-  Reconstruct& reconstruct_flux_in_solution_points_in_line = *m_reconstruct_flux;
+  // number of solution and flux points in a line
+  enum { NS = P+1, NF = P+2 };
+
+  typedef Eigen::Matrix<Real, NS, NF>              LineGradientT;
+  typedef Eigen::Matrix<Real, NF, Eigen::Dynamic>  FluxLineT;
+  typedef Eigen::Matrix<Real, NS, Eigen::Dynamic>  FluxGradLineT;
+
+  cf_assert(flux_in_line.rows() == NF);
+  cf_assert(flux_grad_in_line.rows() == NS);
+
+  const Eigen::Map<const LineGradientT> flux_gradient_in_line ( m_reconstruct_flux->gradient_reconstruction_matrix(KSI).data() ); // KSI because line has only 1 orientation
+  Eigen::Map<FluxLineT>     flux_in_line_ ( flux_in_line.data(), NF, m_nb_vars );
+  Eigen::Map<FluxGradLineT> flux_grad_in_line_ ( flux_grad_in_line.data(), NS, m_nb_vars );
 
-  Solver::State& sol_state = *m_sol_state.lock();
-  Solver::Physics& sol_vars = *m_sol_vars;
 
   const SFDM::ShapeFunction& solution_sf = *m_solution_sf;
   const SFDM::ShapeFunction& flux_sf     = *m_flux_sf;
 
   const ElementType&   geometry   = elements().element_type();
-  RealMatrix geometry_coords  = elements().get_coordinates( idx() );
+  elements().put_coordinates( geometry_coords, idx() );
 
-  CMultiStateFieldView::View solution_data = (*m_solution)[idx()];
   CMultiStateFieldView::View residual_data = (*m_residual)[idx()];
   CMultiStateFieldView::View jacobian_determinant_data = (*m_jacobian_determinant)[idx()];
 
-  RealMatrix solution_in_sol_pts = to_matrix(solution_data);
-  RealVector jacobian_determinant = to_matrix(jacobian_determinant_data);  // RealVector is column shaped RealMatrix
-
   Real& wave_speed = (*m_wave_speed)[idx()];
 
-  CConnectivity& c2f = elements().get_child("face_connectivity").as_type<CConnectivity>();
+  if (is_null(m_face_connectivity))
+    m_face_connectivity = elements().get_child("face_connectivity").as_ptr_checked<CConnectivity>();
+  CConnectivity& c2f = *m_face_connectivity;
   Component::Ptr faces;
   Uint face_idx;
   Component::Ptr neighbor_cells;
@@ -290,13 +424,16 @@ void ComputeRhsInCell::execute()
   /// <li> Set all cell solution states in a matrix @f$ \mathbf{Q_s} @f$ (rows are states, columns are variables)@n
   /// <li> Reconstruct the solution in the flux points.
   ///      @f[ \tilde{Q}(\xi,\eta) = \sum_{s=1}^{N} |J_s| {Q}_{s}\  L_{s}(\xi,\eta)@f]
-  ///      SFDM::Reconstruct::value() provides a precalculated matrix @f$R@f$ with element (f,s) corresponding to @f$L_{s}(\xi_f,\eta_f)@f$.
+  ///      SFDM::Reconstruct::value_reconstruction_matrix() provides a precalculated matrix @f$R@f$ with element (f,s) corresponding to @f$L_{s}(\xi_f,\eta_f)@f$.
   ///      @f[ \mathbf{\tilde{Q}_f} = R \ \mathbf{\tilde{Q}_s} @f]
   ///      where subscript @f$ _f @f$ denotes the values in the flux points.
-  solution = reconstruct_solution_in_all_flux_points.value( to_matrix(solution_data) ) ;
-  //CFdebug << "rhs = \n" << to_matrix(residual_data) << CFendl;
-  //CFdebug << "solution = \n" << to_matrix(solution_data) << CFendl;
-  //CFdebug << "mapped solution in flux points = \n" << solution << CFendl;
+  ///      This is done for a batch of cells at once, placing their matrices @f$ \mathbf{\tilde{Q}_s} @f$ side by side.
+  if (idx() < m_batch_begin || idx() >= m_batch_end)
+    reconstruct_batch( idx() );
+
+  const Uint cols = (idx()-m_batch_begin)*m_nb_vars;
+  const RealMatrix& solution_in_sol_pts = m_batch_solution;
+  const RealMatrix& solution = m_batch_solution_in_flx_pts;
 
   max_wave_speed = 0.;
 
@@ -311,51 +448,54 @@ void ComputeRhsInCell::execute()
     { /// <ul>
       //CFdebug << "  line = " << line << CFendl;
       /// <li> Compute analytical flux in the flux points of the line, excluding begin and end point
-      ///      @f[ \mathbf{\tilde{F}}_{f,line} = \mathrm{flux}(\mathbf{\tilde{Q}}_{f, line}) @f] (see Solver::State::compute_flux())
+      ///      @f[ \mathbf{\tilde{F}}_{f,line} = \mathrm{flux}(\mathbf{\tilde{Q}}_{f, line}) @f] (see SFDM::PhysicsT::compute_flux())
 
-      for (Uint sol_pt=0; sol_pt<solution_sf.nb_nodes_per_line(); ++sol_pt)
+      for (Uint sol_pt=0; sol_pt<NS; ++sol_pt)
       {
-        sol_state.set_state(solution_in_sol_pts.row(solution_sf.points()[orientation][line][sol_pt]),sol_vars);
-        RealVector plane_area_normal = geometry.plane_jacobian_normal(solution_sf.local_coordinates().row(solution_sf.points()[orientation][line][sol_pt]), geometry_coords , (CF::CoordRef) orientation);
+        state = solution_in_sol_pts.row(solution_sf.points()[orientation][line][sol_pt]).segment(cols,m_nb_vars).transpose();
+        geometry.compute_plane_jacobian_normal(m_sol_mapped_coords[solution_sf.points()[orientation][line][sol_pt]], geometry_coords , (CF::CoordRef) orientation, plane_normal);
         for (Uint i=0; i<m_dimensionality-1; ++i)
-          plane_area_normal = plane_area_normal * 2.;
-        max_wave_speed = std::max(max_wave_speed, sol_state.max_abs_eigen_value(sol_vars, plane_area_normal ) );// / jacobian_determinant[ solution_sf.points()[orientation][line][sol_pt] ] );
+          plane_normal *= 2.;
+        max_wave_speed = std::max(max_wave_speed, physics.max_abs_eigen_value(state, plane_normal ) );// / jacobian_determinant[ solution_sf.points()[orientation][line][sol_pt] ] );
       }
 
-      for (Uint flux_pt=1; flux_pt<flux_in_line.rows()-1; ++flux_pt)
+      for (Uint flux_pt=1; flux_pt<NF-1; ++flux_pt)
       {
         //RealMatrix jacobian = geometry.jacobian(flux_sf.local_coordinates().row(flux_sf.points()[orientation][line][flux_pt]),geometry_coords);
-        sol_state.set_state(solution.row(flux_sf.points()[orientation][line][flux_pt]),sol_vars);
-        //sol_state.compute_flux(sol_vars,m_normal[orientation],flux);
-        sol_state.compute_flux(sol_vars, geometry.plane_jacobian_normal(flux_sf.local_coordinates().row(flux_sf.points()[orientation][line][flux_pt]), geometry_coords , (CF::CoordRef) orientation) ,flux);
-        flux_in_line.row(flux_pt) = flux;
+        state = solution.row(flux_sf.points()[orientation][line][flux_pt]).segment(cols,m_nb_vars).transpose();
+        //physics.compute_flux(state,m_normal[orientation],flux);
+        geometry.compute_plane_jacobian_normal(m_flx_mapped_coords[flux_sf.points()[orientation][line][flux_pt]], geometry_coords , (CF::CoordRef) orientation, plane_normal);
+        physics.compute_flux(state, plane_normal, flux);
+        flux_in_line_.row(flux_pt) = flux;
       }
 
       /// <li> Update face flux points with Riemann problem with neighbor
       ///      At the flux point location of the face:
-      ///      @f[ \tilde{F}_{\mathrm{facepoint}} = \mathrm{Riemann}(\tilde{Q}_{\mathrm{facepoint},\mathrm{left}},\tilde{Q}_{\mathrm{facepoint},\mathrm{right}}) @f]
+      ///      @f[ \tilde{F}_{\mathrm{facepoint}} = \mathrm{Rusanov}(\tilde{Q}_{\mathrm{facepoint},\mathrm{left}},\tilde{Q}_{\mathrm{facepoint},\mathrm{right}}) @f]
       for (Uint side=0; side<2; ++side) // a line connects 2 faces
       {
         // Find face
         boost::tie(faces,face_idx) = c2f.lookup().location( c2f[idx()][flux_sf.face_number()[orientation][side]] );
 
         // Find neighbor cell
-        CFaceCellConnectivity& f2c = faces->get_child("cell_connectivity").as_type<CFaceCellConnectivity>();
+        CFaceCellConnectivity& f2c = cell_connectivity(*faces);
         if (f2c.is_bdry_face()[face_idx])
         {
           //CFdebug << "    must implement a boundary condition on face " << faces->parent().name() << "["<<face_idx<<"]" << CFendl;
           /// @todo implement real boundary condition.
           if (side == 0)
           {
-            sol_state.set_state(solution.row(flux_sf.points()[orientation][line][0]),sol_vars);
-            sol_state.compute_flux(sol_vars, geometry.plane_jacobian_normal(flux_sf.local_coordinates().row(flux_sf.face_points()[orientation][line][0]), geometry_coords , (CF::CoordRef) orientation) ,flux);
-            flux_in_line.topRows<1>() = flux;
+            state = solution.row(flux_sf.points()[orientation][line][0]).segment(cols,m_nb_vars).transpose();
+            geometry.compute_plane_jacobian_normal(m_flx_mapped_coords[flux_sf.face_points()[orientation][line][0]], geometry_coords , (CF::CoordRef) orientation, plane_normal);
+            physics.compute_flux(state, plane_normal, flux);
+            flux_in_line_.template topRows<1>() = flux;
           }
           else
           {
-            sol_state.set_state(solution.row(flux_sf.face_points()[orientation][line][1]),sol_vars);
-            sol_state.compute_flux(sol_vars, geometry.plane_jacobian_normal(flux_sf.local_coordinates().row(flux_sf.face_points()[orientation][line][1]), geometry_coords , (CF::CoordRef) orientation) ,flux);
-            flux_in_line.bottomRows<1>() = flux;
+            state = solution.row(flux_sf.face_points()[orientation][line][1]).segment(cols,m_nb_vars).transpose();
+            geometry.compute_plane_jacobian_normal(m_flx_mapped_coords[flux_sf.face_points()[orientation][line][1]], geometry_coords , (CF::CoordRef) orientation, plane_normal);
+            physics.compute_flux(state, plane_normal, flux);
+            flux_in_line_.template bottomRows<1>() = flux;
           }
         }
         else
@@ -369,27 +509,31 @@ void ComputeRhsInCell::execute()
           /// @todo Multi-region support.
           /// It is now assumed for reconstruction that neighbor_cells == elements(), so that the same field_view "m_solution" can be used.
           cf_assert_desc("does not support multi_region yet",neighbor_cells == elements().self());
-          neighbor_solution = reconstruct_solution_in_all_flux_points.value( to_matrix( (*m_solution)[neighbor_cell_idx] ) );
+          Uint neighbor_cols;
+          const RealMatrix& neighbor_solution = solution_in_flux_points( neighbor_cell_idx, neighbor_cols );
 
-          const RealRowVector& left  = solution         .row ( flux_sf.face_points()[orientation][line][side] );
-          const RealRowVector& right = neighbor_solution.row ( flux_sf.face_points()[orientation][line][!side] ); // the other side
+          left  = solution         .row ( flux_sf.face_points()[orientation][line][side]  ).segment(cols,m_nb_vars).transpose();
+          right = neighbor_solution.row ( flux_sf.face_points()[orientation][line][!side] ).segment(neighbor_cols,m_nb_vars).transpose(); // the other side
 
 
           if (side == 0)
           {
-            riemann_solver().solve(left,right, -geometry.plane_jacobian_normal(flux_sf.local_coordinates().row(flux_sf.face_points()[orientation][line][0]), geometry_coords, (CF::CoordRef) orientation),   flux,left_wave_speed,right_wave_speed);
-            flux_in_line.topRows<1>() = -flux;
+            geometry.compute_plane_jacobian_normal(m_flx_mapped_coords[flux_sf.face_points()[orientation][line][0]], geometry_coords, (CF::CoordRef) orientation, plane_normal);
+            plane_normal *= -1.;
+            face_wave_speed = rusanov_flux(physics, left, right, plane_normal, flux);
+            flux_in_line_.template topRows<1>() = -flux;
           }
           else
           {
-            riemann_solver().solve(left,right,  geometry.plane_jacobian_normal(flux_sf.local_coordinates().row(flux_sf.points()[orientation][line][1]), geometry_coords, (CF::CoordRef) orientation),   flux,left_wave_speed,right_wave_speed);
-            flux_in_line.bottomRows<1>() = flux;
+            geometry.compute_plane_jacobian_normal(m_flx_mapped_coords[flux_sf.points()[orientation][line][1]], geometry_coords, (CF::CoordRef) orientation, plane_normal);
+            face_wave_speed = rusanov_flux(physics, left, right, plane_normal, flux);
+            flux_in_line_.template bottomRows<1>() = flux;
           }
           //CFdebug << "      solve Riemann("<<left<<","<<right<<") with normal ["<< (side==0?-1.:1.)*geometry.plane_jacobian_vector(flux_sf.local_coordinates().row(flux_sf.face_points()[orientation][line][side]), geometry_coords, (CF::CoordRef) orientation).transpose()<<"] = \n" << flux << CFendl;
 
           for (Uint i=0; i<m_dimensionality-1; ++i)
-            left_wave_speed = std::abs(left_wave_speed) * 2.;
-          max_wave_speed = std::max(max_wave_speed, std::abs(left_wave_speed) );
+            face_wave_speed *= 2.;
+          max_wave_speed = std::max(max_wave_speed, face_wave_speed );
 
         }
       }
@@ -401,18 +545,18 @@ void ComputeRhsInCell::execute()
       /// @f[\left.\frac{\partial \tilde{F}}{\partial \xi}\right|_{line,s}  = \sum_{f=1}^{N_f} \tilde{F}_{line,f} \ l'_{f}(\xi_{s}) @f]
       /// with @f$ N_f @f$ the number of flux points in the flux 1D shape function.
       ///
-      /// This is implemented using SFDM::Reconstruct::gradient()
-      flux_grad_in_line = reconstruct_flux_in_solution_points_in_line.gradient( flux_in_line , KSI ); // KSI because line has only 1 orientation
+      /// This is implemented with the fixed size matrix of SFDM::Reconstruct::gradient_reconstruction_matrix()
+      flux_grad_in_line_.noalias() = flux_gradient_in_line * flux_in_line_;
       //CFdebug << "    flux_grad_in_line = \n" << flux_grad_in_line << CFendl;
 
       /// <li> Add the flux gradient to the RHS
       ///      @f[ \frac{\partial Q_s}{\partial t} = - \frac{1}{|J_s|} \ \nabla_{\mathbf{\xi}} \cdot {\tilde{F}_s} @f]
-      for (Uint point=0; point<solution_sf.nb_nodes_per_line(); ++point)
+      for (Uint point=0; point<NS; ++point)
       {
         const Uint solution_idx = solution_sf.points()[orientation][line][point];
-        //CFdebug << "    jacobian_determinant["<<point<<"] = " << jacobian_determinant[solution_idx] << CFendl;
+        //CFdebug << "    jacobian_determinant["<<point<<"] = " << jacobian_determinant_data[solution_idx][0] << CFendl;
         for (Uint var=0; var<m_nb_vars; ++var)
-          residual_data[solution_idx][var] -= flux_grad_in_line(point,var) / jacobian_determinant[solution_idx];
+          residual_data[solution_idx][var] -= flux_grad_in_line_(point,var) / jacobian_determinant_data[solution_idx][0];
       }
     } /// </ul>
   } /// </ul>
@@ -425,6 +569,24 @@ void ComputeRhsInCell::execute()
   /// - work only in mapped space, and do transformations only after
 }
 
+/////////////////////////////////////////////////////////////////////////////////////
+
+template < typename PHYSICS >
+Real ComputeRhsInCell::rusanov_flux( PHYSICS& physics, const RealVector& left, const RealVector& right,
+                                     const RealVector& normal, RealVector& flux )
+{
+  /// @f[ F = \frac{1}{2} \left( F(Q_L) + F(Q_R) \right) - \frac{1}{2} \ a \ (Q_R - Q_L) @f]
+  /// with @f$ a @f$ the maximum absolute eigen value of both states
+  physics.compute_flux(left, normal, left_flux);
+  physics.compute_flux(right, normal, flux);
+
+  const Real a = std::max( physics.max_abs_eigen_value(left, normal),
+                           physics.max_abs_eigen_value(right, normal) );
+
+  flux = 0.5 * ( left_flux + flux ) - 0.5 * a * ( right - left );
+  return a;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 RealRowVector ComputeRhsInCell::to_row_vector(Mesh::CTable<Real>::ConstRow row) const
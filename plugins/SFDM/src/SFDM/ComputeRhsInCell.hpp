@@ -7,6 +7,8 @@
 #ifndef CF_Solver_Actions_ComputeRhsInCell_hpp
 #define CF_Solver_Actions_ComputeRhsInCell_hpp
 
+#include <map>
+
 #include "Solver/Actions/CLoopOperation.hpp"
 #include "SFDM/LibSFDM.hpp"
 #include "Mesh/CTable.hpp"
@@ -17,8 +19,7 @@
 /////////////////////////////////////////////////////////////////////////////////////
 
 namespace CF {
-namespace Solver { class State; class Physics; }
-namespace RiemannSolvers { class RiemannSolver; }
+namespace Mesh { class CConnectivity; class CFaceCellConnectivity; }
 namespace SFDM {
 
   class Reconstruct;
@@ -31,6 +32,16 @@ namespace SFDM {
 /// @brief Computes the RHS in one cell.
 ///
 /// It is the workhorse of SFD Solver.
+///
+/// The solution is reconstructed in the flux points for batches of consecutive
+/// cells at once, as a single matrix product. A batch stays valid until the
+/// elements are set again, which the loop does at the start of every sweep.
+///
+/// The option "physics" names a model of the new Physics API. The flux and
+/// the eigen values are evaluated through its static interface (see
+/// SFDM::PhysicsT), and the solution order and physics are bound once per
+/// element type instead of being dispatched in every point.
+/// The flux in the face points between two cells is the Rusanov flux.
 
 class SFDM_API ComputeRhsInCell : public Solver::Actions::CLoopOperation {
 
@@ -54,7 +65,10 @@ public: // functions
   /// execute the action
   virtual void execute ();
 
-  RiemannSolvers::RiemannSolver& riemann_solver() { return *m_riemann_solver; }
+private: // typedefs
+
+  /// computation of the RHS of a cell, bound to the solution order and the physics
+  typedef void (ComputeRhsInCell::*ComputeRhsFn)();
 
 private: // helper functions
 
@@ -62,10 +76,39 @@ private: // helper functions
   void config_residual();
   void config_jacobian_determinant();
   void config_wavespeed();
-  void config_solution_physics();
   void trigger_elements();
 
-  void build_riemann_solver();
+  /// binds the computation of the RHS to the solution order and the physics
+  void select_compute_rhs();
+
+  /// @return the computation of the RHS with the static physics PHYS
+  template < typename PHYS > ComputeRhsFn static_compute_rhs() const;
+
+  /// computes the RHS of the current cell with the static physics PHYS
+  template < Uint P, typename PHYS > void compute_rhs_static();
+
+  /// computes the RHS of the current cell, with the sizes of the lines fixed
+  /// at compile time from the solution order P
+  /// @param physics  provides the flux and the eigen values in a point
+  template < Uint P, typename PHYSICS > void compute_rhs( PHYSICS& physics );
+
+  /// computes the Rusanov flux between two states, projected on a (non unit) normal
+  /// @return the maximum absolute eigen value of both states
+  template < typename PHYSICS >
+  Real rusanov_flux( PHYSICS& physics, const RealVector& left, const RealVector& right,
+                     const RealVector& normal, RealVector& flux );
+
+  /// reconstructs the solution in the flux points for the batch of cells
+  /// starting at the given cell, with one matrix product for the whole batch
+  void reconstruct_batch( const Uint first_cell );
+
+  /// @return the solution in the flux points of a cell, reconstructing it if needed
+  /// @post the matrix rows are the flux points, and the columns of the cell
+  ///       start at the returned column index
+  const RealMatrix& solution_in_flux_points( const Uint cell, Uint& first_col );
+
+  /// @return the face to cell connectivity of a face component, cached by component
+  Mesh::CFaceCellConnectivity& cell_connectivity( Common::Component& faces );
 
   RealRowVector    to_row_vector(Mesh::CTable<Real>::ConstRow row) const ;
   RealMatrix       to_matrix(Mesh::CMultiStateFieldView::View data) const ;
@@ -83,24 +126,50 @@ private: // data
 
   boost::weak_ptr<Mesh::CMeshElements> m_mesh_elements;
 
-  boost::shared_ptr<RiemannSolvers::RiemannSolver> m_riemann_solver;
-  boost::weak_ptr<Solver::State> m_sol_state;
-  boost::shared_ptr<Solver::Physics> m_sol_vars;
-
   boost::shared_ptr<SFDM::ShapeFunction const> m_solution_sf;
   boost::shared_ptr<SFDM::ShapeFunction const> m_flux_sf;
 
+  /// computation of the RHS, bound when the elements are set
+  ComputeRhsFn m_compute_rhs;
+
+  /// face connectivity of the elements, looked up at the first cell
+  boost::shared_ptr<Mesh::CConnectivity> m_face_connectivity;
+  /// face to cell connectivities, per face component
+  std::map<Common::Component const*, boost::shared_ptr<Mesh::CFaceCellConnectivity> > m_cell_connectivity;
+
+  /// number of cells reconstructed together
+  static const Uint batch_size = 64;
+
+  /// first and past the last cell of the reconstructed batch
+  Uint m_batch_begin;
+  Uint m_batch_end;
+  /// solution in the solution points of the batch, the columns of a cell are contiguous
+  RealMatrix m_batch_solution;
+  /// solution in the flux points of the batch, the columns of a cell are contiguous
+  RealMatrix m_batch_solution_in_flx_pts;
+
+  /// neighbor cell reconstructed outside of the batch
+  Uint m_neighbor_idx;
+
   std::vector<RealVector> m_normal;
   Uint m_dimensionality;
   Uint m_nb_vars;
-  Real left_wave_speed;
-  Real right_wave_speed;
+  Real face_wave_speed;
   RealVector flux;
+  RealVector left_flux;
   Real max_wave_speed;
   RealMatrix flux_in_line;
   RealMatrix flux_grad_in_line;
-  RealMatrix solution;
+  RealMatrix geometry_coords;
   RealMatrix neighbor_solution;
+  RealMatrix neighbor_solution_in_flx_pts;
+  RealVector state;
+  RealVector left;
+  RealVector right;
+  RealVector plane_normal;
+  /// mapped coordinates of the solution and flux points
+  std::vector<RealVector> m_sol_mapped_coords;
+  std::vector<RealVector> m_flx_mapped_coords;
 };
 
 /////////////////////////////////////////////////////////////////////////////////////
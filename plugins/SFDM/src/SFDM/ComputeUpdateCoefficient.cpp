@@ -37,6 +37,7 @@ Common::ComponentBuilder < ComputeUpdateCoefficient, CAction, LibSFDM > ComputeU
 ComputeUpdateCoefficient::ComputeUpdateCoefficient ( const std::string& name ) :
   CAction(name),
   m_time_accurate(false),
+  m_dual_time_stepping(false),
   m_CFL(1.),
   m_freeze(false),
   m_tolerance(1e-12)
@@ -50,6 +51,12 @@ ComputeUpdateCoefficient::ComputeUpdateCoefficient ( const std::string& name ) :
     ->link_to(&m_time_accurate)
     ->add_tag("time_accurate");
 
+  m_options.add_option< OptionT<bool> > (FlowSolver::Tags::dual_time_stepping(), m_dual_time_stepping)
+    ->description("Local pseudo time steps of dual time stepping, with the physical time step of the time component")
+    ->pretty_name("Dual Time Stepping")
+    ->link_to(&m_dual_time_stepping)
+    ->add_tag(FlowSolver::Tags::dual_time_stepping());
+
   m_options.add_option< OptionT<Real> > ("cfl", m_CFL)
     ->description("Courant Number")
     ->pretty_name("CFL")
@@ -135,7 +142,24 @@ void ComputeUpdateCoefficient::execute()
 
     CTable<Real>& jacob_det = m_volume.lock()->parent().get_child("jacobian_determinant").as_type<CField>().data();
 
-    if (m_time_accurate) // global time stepping
+    if (m_dual_time_stepping) // local pseudo time stepping inside a physical time step
+    {
+      if (m_time.expired())   throw SetupError(FromHere(), "Time component was not set");
+
+      const Real dt = m_time.lock()->dt();
+      if (dt <= 0.) throw BadValue(FromHere(), "Dual time stepping requires a positive physical time step");
+
+      /// Calculate the update_coefficient
+      //  --------------------------------
+      /// The physical time derivative is treated point-implicitly:
+      /// @f[ \Delta U = \left( \frac{1}{\Delta \tau} + \frac{1}{\Delta t} \right)^{-1} \left( R - \frac{U-U^n}{\Delta t} \right) @f]
+      for (Uint i=0; i<update_coeff.size(); ++i)
+      {
+        const Real dtau = m_CFL*volume[i][0]/wave_speed[i][0];
+        update_coeff[i][0] = dtau*dt/(dtau+dt);
+      }
+    }
+    else if (m_time_accurate) // global time stepping
     {
       if (m_time.expired())   throw SetupError(FromHere(), "Time component was not set");
 
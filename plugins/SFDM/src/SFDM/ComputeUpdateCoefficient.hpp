@@ -56,6 +56,7 @@ private: // data
   boost::weak_ptr<Solver::CTime> m_time;
 
   bool m_time_accurate;
+  bool m_dual_time_stepping;
   Real m_CFL;
 
   bool m_freeze;
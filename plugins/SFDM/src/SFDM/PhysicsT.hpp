@@ -0,0 +1,101 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_SFDM_PhysicsT_hpp
+#define CF_SFDM_PhysicsT_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Math/MatrixTypes.hpp"
+
+#include "SFDM/LibSFDM.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace SFDM {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Physics used by ComputeRhsInCell through the static interface of a
+/// Physics::Variables type, as RDM::CellLoopT does. The flux and eigen values
+/// are inlined and evaluated on vectors of fixed size.
+/// @note the properties are computed without coordinates nor gradients,
+///       so the physics may only depend on the solution
+template < typename PHYS >
+class PhysicsT
+{
+public: // typedefs
+
+  typedef typename PHYS::MODEL MODEL;
+
+  typedef typename MODEL::GeoV GeoV;
+  typedef typename MODEL::SolV SolV;
+  typedef typename MODEL::SolM SolM;
+
+public: // functions
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW  ///< storing fixed-sized Eigen structures
+
+  PhysicsT()
+  {
+    m_coords.setZero();
+    m_grad_vars.setZero();
+  }
+
+  /// Get the class name
+  static std::string type_name() { return "PhysicsT<" + PHYS::type_name() + ">"; }
+
+  /// computes the flux of a state projected on a (non unit) normal
+  void compute_flux( const RealVector& state, const RealVector& normal, RealVector& flux )
+  {
+    m_vars = state;
+    m_normal = normal;
+
+    PHYS::compute_properties(m_coords, m_vars, m_grad_vars, m_props);
+    PHYS::flux(m_props, m_flux);
+
+    flux.noalias() = m_flux * m_normal;
+  }
+
+  /// @return the maximum absolute eigen value of the flux jacobian
+  /// projected on a (non unit) normal
+  Real max_abs_eigen_value( const RealVector& state, const RealVector& normal )
+  {
+    m_vars = state;
+
+    // the eigen values are computed in the unit direction and scaled afterwards,
+    // as the acoustic ones do not scale with the direction
+
+    const Real area = normal.norm();
+    m_normal = normal / area;
+
+    PHYS::compute_properties(m_coords, m_vars, m_grad_vars, m_props);
+    PHYS::flux_jacobian_eigen_values(m_props, m_normal, m_eigen_values);
+
+    return area * m_eigen_values.cwiseAbs().maxCoeff();
+  }
+
+private: // data
+
+  typename MODEL::Properties m_props;
+
+  GeoV m_coords;
+  GeoV m_normal;
+  SolV m_vars;
+  SolM m_grad_vars;
+  SolM m_flux;
+  SolV m_eigen_values;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+} // SFDM
+} // CF
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_SFDM_PhysicsT_hpp
@@ -52,6 +52,13 @@ public: // functions
   /// @param orientation  Direction to which the derivative is taken (KSI / ETA / ZTA)
   RealMatrix gradient(const RealMatrix& from_states, const CoordRef orientation) const;
 
+  /// Matrix used by value(), with element (t,f) the value in point t of shapefunction "to"
+  /// of the basis function of point f of shapefunction "from"
+  const RealMatrix& value_reconstruction_matrix() const { return m_value_reconstruction_matrix; }
+
+  /// Matrix used by gradient() in the given orientation
+  const RealMatrix& gradient_reconstruction_matrix(const CoordRef orientation) const { return m_gradient_reconstruction_matrix[orientation]; }
+
 private:
 
   void configure_from_to();
@@ -118,6 +118,11 @@ SFDWizard::SFDWizard( const std::string& name )
     ->pretty_name("Time Accurate")
     ->mark_basic();
 
+  m_options.add_option( OptionT<bool>::create(FlowSolver::Tags::dual_time_stepping(), false) )
+    ->description("Solve every time step implicitly with local pseudo time steps")
+    ->pretty_name("Dual Time Stepping")
+    ->mark_basic();
+
   m_options.add_option( OptionT<bool>::create("output_file", "mesh_t${time}.msh") )
     ->description("File to write")
     ->pretty_name("Output File")
@@ -241,6 +246,7 @@ void SFDWizard::start_simulation(const Real& end_time, const Real& time_step)
 
   model.solver().configure_option_recursively(FlowSolver::Tags::cfl(),option(FlowSolver::Tags::cfl()).value<Real>());
   model.solver().configure_option_recursively(FlowSolver::Tags::time_accurate(),option(FlowSolver::Tags::time_accurate()).value<bool>());
+  model.solver().configure_option_recursively(FlowSolver::Tags::dual_time_stepping(),option(FlowSolver::Tags::dual_time_stepping()).value<bool>());
 
   model.simulate();
 }
@@ -0,0 +1,179 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for CF::SFDM::ComputeRhsInCell"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/Core.hpp"
+#include "Common/CRoot.hpp"
+#include "Common/FindComponents.hpp"
+#include "Common/Foreach.hpp"
+
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/CElements.hpp"
+#include "Mesh/CField.hpp"
+#include "Mesh/CFieldView.hpp"
+#include "Mesh/CSimpleMeshGenerator.hpp"
+#include "Mesh/Actions/CBuildFaces.hpp"
+#include "Mesh/Actions/CInitFieldFunction.hpp"
+#include "Mesh/Actions/CreateSpaceP0.hpp"
+
+#include "Solver/Actions/CForAllCells.hpp"
+
+#include "Physics/Scalar/LinearAdv2D.hpp"
+
+#include "SFDM/CreateSpace.hpp"
+#include "SFDM/PhysicsT.hpp"
+
+using namespace CF;
+using namespace CF::Common;
+using namespace CF::Mesh;
+using namespace CF::Solver::Actions;
+using namespace CF::SFDM;
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct SFDMRhs_Fixture
+{
+  /// residual of the linear field u = x + 2y advected with the velocity (1,1)
+  /// on a square of 10x10 cells, more cells than reconstructed in one batch
+  /// @param P order of the solution
+  CMesh& compute_residual(const Uint P)
+  {
+    CRoot& root = Core::instance().root();
+
+    CMesh& mesh = root.create_component<CMesh>("mesh_P"+to_str(P));
+    CSimpleMeshGenerator::create_rectangle(mesh, 1., 1., 10, 10);
+
+    Mesh::Actions::CreateSpaceP0::Ptr create_space_P0 = allocate_component<Mesh::Actions::CreateSpaceP0>("create_space_P0");
+    create_space_P0->transform(mesh);
+
+    CreateSpace::Ptr create_space = allocate_component<CreateSpace>("create_space");
+    create_space->configure_option("P",P);
+    create_space->transform(mesh);
+
+    Mesh::Actions::CBuildFaces::Ptr build_faces = allocate_component<Mesh::Actions::CBuildFaces>("build_faces");
+    build_faces->configure_option("store_cell2face",true);
+    build_faces->transform(mesh);
+
+    CField& solution = mesh.create_field("solution",CField::Basis::CELL_BASED,"solution","u[1]");
+    CField& residual = mesh.create_field("residual",solution);
+    CField& jacobian_determinant = mesh.create_scalar_field("jacobian_determinant",solution);
+    CField& wave_speed = mesh.create_field("wave_speed",CField::Basis::CELL_BASED,"P0","wave_speed[1]");
+
+    Mesh::Actions::CInitFieldFunction::Ptr init_field = allocate_component<Mesh::Actions::CInitFieldFunction>("init_field");
+    init_field->configure_option("functions",std::vector<std::string>(1,"x+2*y"));
+    init_field->configure_option("field",solution.uri());
+    init_field->transform(mesh);
+
+    residual.data() = 0.;
+    wave_speed.data() = 0.;
+
+    CForAllCells& loop = root.create_component<CForAllCells>("loop_P"+to_str(P));
+    loop.configure_option("regions",std::vector<URI>(1,mesh.topology().uri()));
+
+    loop.create_loop_operation("CF.SFDM.ComputeJacobianDeterminant")
+        .configure_option("jacobian_determinant",jacobian_determinant.uri());
+    loop.execute();
+    root.remove_component(loop.name());
+
+    CForAllCells& rhs_loop = root.create_component<CForAllCells>("rhs_loop_P"+to_str(P));
+    rhs_loop.configure_option("regions",std::vector<URI>(1,mesh.topology().uri()));
+
+    CLoopOperation& compute_rhs = rhs_loop.create_loop_operation("CF.SFDM.ComputeRhsInCell");
+    compute_rhs.configure_option("physics",Physics::Scalar::LinearAdv2D::type_name());
+    compute_rhs.configure_option("solution",solution.uri());
+    compute_rhs.configure_option("residual",residual.uri());
+    compute_rhs.configure_option("jacobian_determinant",jacobian_determinant.uri());
+    compute_rhs.configure_option("wave_speed",wave_speed.uri());
+    rhs_loop.execute();
+
+    return mesh;
+  }
+
+  /// checks that the residual is -v.grad(u) = -3 in every solution point
+  /// @param interior_only leaves out the cells on the boundary
+  void check_residual(CMesh& mesh, const bool interior_only)
+  {
+    CField& residual = mesh.get_child("residual").as_type<CField>();
+    CMultiStateFieldView residual_view("residual_view");
+    residual_view.set_field(residual);
+
+    Uint nb_checked = 0;
+    boost_foreach(CElements& elements, find_components_recursively_with_filter<CElements>(mesh.topology(),IsElementsVolume()))
+    {
+      BOOST_REQUIRE(residual_view.set_elements(elements));
+      for (Uint e=0; e<elements.size(); ++e)
+      {
+        const RealVector centroid = elements.get_coordinates(e).colwise().mean();
+        if (interior_only && (centroid.minCoeff() < 0.1 || centroid.maxCoeff() > 0.9))
+          continue;
+
+        CMultiStateFieldView::View residual_data = residual_view[e];
+        for (Uint pt=0; pt<residual_data.size(); ++pt)
+          BOOST_CHECK_CLOSE(residual_data[pt][0], -3., 1e-8);
+        ++nb_checked;
+      }
+    }
+    BOOST_CHECK_EQUAL(nb_checked, interior_only ? 64u : 100u);
+  }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( SFDMRhs_TestSuite, SFDMRhs_Fixture )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( physics_static_flux )
+{
+  PhysicsT<Physics::Scalar::LinearAdv2D> physics;
+
+  RealVector state(1); state << 2.;
+  RealVector normal(2); normal << 1., 3.;
+  RealVector flux(1);
+
+  // the velocity is (1,1)
+  physics.compute_flux(state,normal,flux);
+  BOOST_CHECK_EQUAL(flux[0], 8.);
+
+  normal << 3., 4.;
+  BOOST_CHECK_CLOSE(physics.max_abs_eigen_value(state,normal), 7., 1e-12);
+
+  normal << -3., -4.;
+  BOOST_CHECK_CLOSE(physics.max_abs_eigen_value(state,normal), 7., 1e-12);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( linear_field_P0 )
+{
+  // the cell average can not represent the linear field on the boundary faces
+  check_residual(compute_residual(0u), true);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( linear_field_P1 )
+{
+  check_residual(compute_residual(1u), false);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( linear_field_P2 )
+{
+  check_residual(compute_residual(2u), false);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
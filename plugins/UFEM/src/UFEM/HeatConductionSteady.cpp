@@ -33,7 +33,7 @@ HeatConductionSteady::HeatConductionSteady(const std::string& name) : LinearSolv
       group <<
       (
         _A = _0, _T = _0,
-        element_quadrature <<
+        cached_element_quadrature(element_matrix_cache()) <<                                        // The matrices only depend on the mesh and on k
         (
           _A(temperature) += k * transpose(nabla(temperature)) * nabla(temperature),
           _T(temperature) += transpose(N(temperature))*N(temperature)
@@ -45,6 +45,8 @@ HeatConductionSteady::HeatConductionSteady(const std::string& name) : LinearSolv
     << boundary_conditions()                                                                        // boundary conditions
     << solve_action()                                                                               // Solve the LSS
     << create_proto_action("Increment", nodes_expression(temperature = solution(temperature)));     // Set the solution
+  
+  get_child("Assembly").option("k").attach_trigger(boost::bind(&ElementMatrixCache::invalidate, &element_matrix_cache()));
 }
 
 
@@ -92,6 +92,8 @@ struct LinearSolver::Implementation
   SolutionVector solution;
   
   boost::weak_ptr<CEigenLSS> m_lss;
+  
+  ElementMatrixCache m_element_matrix_cache;
 };
 
 LinearSolver::LinearSolver(const std::string& name) :
@@ -121,6 +123,8 @@ void LinearSolver::mesh_loaded(CMesh& mesh)
 {
   CSimpleSolver::mesh_loaded(mesh);
   
+  m_implementation->m_element_matrix_cache.invalidate();
+  
   // Set the region of all children to the root region of the mesh
   std::vector<URI> root_regions;
   root_regions.push_back(mesh.topology().uri());
@@ -142,6 +146,11 @@ BoundaryConditions& LinearSolver::boundary_conditions()
   return m_implementation->m_bc;
 }
 
+ElementMatrixCache& LinearSolver::element_matrix_cache()
+{
+  return m_implementation->m_element_matrix_cache;
+}
+
 
 } // UFEM
 } // CF
@@ -15,6 +15,7 @@
 
 #include "Solver/Actions/Proto/BlockAccumulator.hpp"
 #include "Solver/Actions/Proto/DirichletBC.hpp"
+#include "Solver/Actions/Proto/ElementMatrixCache.hpp"
 #include "Solver/Actions/Proto/SolutionVector.hpp"
 
 #include "BoundaryConditions.hpp"
@@ -60,6 +61,10 @@ public: // functions
   /// Get the component that manages boundary conditions
   BoundaryConditions& boundary_conditions();
   
+  /// Storage for element matrices that don't change between executions, for use with cached_element_quadrature.
+  /// It is invalidated when a mesh is loaded
+  Solver::Actions::Proto::ElementMatrixCache& element_matrix_cache();
+  
   
 private:
   class Implementation;
@@ -27,6 +27,11 @@ using namespace Solver::Actions::Proto;
 
 struct LinearSolverUnsteady::Implementation
 {
+  Implementation(ElementMatrixCache& element_matrix_cache) :
+    m_element_matrix_cache(element_matrix_cache)
+  {
+  }
+  
   void trigger_time()
   {
     if(m_time.expired())
@@ -38,15 +43,18 @@ struct LinearSolverUnsteady::Implementation
   void trigger_timestep()
   {
     m_invdt = m_time.lock()->invdt();
+    // Element matrices scaled with the time step must be computed again
+    m_element_matrix_cache.invalidate();
   }
   
+  ElementMatrixCache& m_element_matrix_cache;
   boost::weak_ptr<CTime> m_time;
   Real m_invdt;
 };
 
 LinearSolverUnsteady::LinearSolverUnsteady(const std::string& name) :
   LinearSolver(name),
-  m_implementation( new Implementation() )
+  m_implementation( new Implementation(element_matrix_cache()) )
 {
   m_options.add_option( OptionComponent<CTime>::create(Solver::Tags::time(), &m_implementation->m_time))
     ->pretty_name("Time")
@@ -37,7 +37,8 @@ public: // functions
   /// Get the class name
   static std::string type_name () { return "LinearSolverUnsteady"; }
   
-  /// Reference to the inverse timestep, linked to the model time step
+  /// Reference to the inverse timestep, linked to the model time step.
+  /// Changing the time step invalidates the element_matrix_cache()
   Real& invdt();
   
 private:
@@ -11,6 +11,7 @@
 
 #include "Solver/Actions/Proto/ElementOperations.hpp"
 #include "Solver/Actions/Proto/Terminals.hpp"
+#include "Solver/Actions/Proto/ThreadedLoop.hpp"
 
 namespace CF {
 namespace UFEM {
@@ -63,6 +64,20 @@ struct ComputeTau
 static Solver::Actions::Proto::MakeSFOp<ComputeTau>::type const compute_tau = {};
 
 } // UFEM
+
+namespace Solver {
+namespace Actions {
+namespace Proto {
+
+/// The coefficients are computed for each element, so every thread of an element loop uses its own copy
+template<>
+struct IsThreadPrivate<UFEM::SUPGCoeffs> : boost::mpl::true_
+{
+};
+
+} // Proto
+} // Actions
+} // Solver
 } // CF
 
 
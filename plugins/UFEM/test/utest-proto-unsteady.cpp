@@ -166,7 +166,7 @@ BOOST_AUTO_TEST_CASE( Heat1DUnsteady )
           group <<
           (
             _A = _0, _T = _0,
-            element_quadrature <<
+            cached_element_quadrature(solver.element_matrix_cache()) <<
             (
               _A(temperature) += alpha * transpose(nabla(temperature))*nabla(temperature),
               _T(temperature) += solver.invdt() * transpose(N(temperature))*N(temperature)
@@ -195,6 +195,9 @@ BOOST_AUTO_TEST_CASE( Heat1DUnsteady )
 
   // Run the solver
   model.simulate();
+  
+  // The element matrices were computed in the first time step only
+  BOOST_CHECK_EQUAL(solver.element_matrix_cache().nb_stored(), nb_segments);
 
   // Check result
   t = model.time().current_time();
@@ -0,0 +1,125 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <cstdlib>
+#include <cstring>
+
+#include <boost/bind.hpp>
+
+#include "Common/Allocator.hpp"
+#include "Common/ThreadPool.hpp"
+
+#ifdef CF_OS_WINDOWS
+  #include <malloc.h>
+#else
+  extern "C"
+  {
+    #include <unistd.h>
+    #include <sys/mman.h>
+  }
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Common {
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Size of a transparent huge page, and alignment of the blocks backed by them
+const std::size_t huge_page_size = 2*1024*1024;
+
+std::size_t page_size()
+{
+#ifdef CF_OS_WINDOWS
+  return 4096;
+#else
+  static const std::size_t size = sysconf(_SC_PAGESIZE);
+  return size;
+#endif
+}
+
+/// Zeroes a range of pages, which places them on the NUMA node of the thread
+void touch_pages(char* block, const std::size_t bytes, const Uint begin, const Uint end, const Uint)
+{
+  const std::size_t first = begin*page_size();
+  const std::size_t last = std::min(bytes, end*page_size());
+  std::memset(block+first, 0, last-first);
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+MemoryManager::MemoryManager() :
+  HugePages(false),
+  ParallelFirstTouch(false)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+MemoryManager& MemoryManager::instance()
+{
+  static MemoryManager memory_manager;
+  return memory_manager;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void* MemoryManager::allocate(const std::size_t bytes)
+{
+  const std::size_t size = std::max(bytes, std::size_t(1));
+  const bool huge = HugePages && size >= huge_page_size;
+
+  void* block = 0;
+#ifdef CF_OS_WINDOWS
+  block = _aligned_malloc(size, alignment);
+#else
+  if (posix_memalign(&block, huge ? huge_page_size : alignment, size) != 0)
+    block = 0;
+#endif
+  if (!block)
+    throw std::bad_alloc();
+
+#ifdef MADV_HUGEPAGE
+  if (huge)
+    madvise(block, size, MADV_HUGEPAGE); // only advice, failure leaves normal pages
+#endif
+
+  // the pages are split among the threads the same way as the indices of a loop,
+  // but which thread takes a chunk is only known at run time: placement is best effort.
+  // Within a task, the pages are left to the first write of the thread.
+
+  ThreadPool& pool = ThreadPool::instance();
+  if (ParallelFirstTouch && pool.nb_threads() > 1 && size >= pool.nb_threads()*page_size() && !pool.in_task())
+  {
+    const Uint nb_pages = (size + page_size() - 1) / page_size();
+    pool.parallel_for(0, nb_pages, boost::bind(&touch_pages, static_cast<char*>(block), size, _1, _2, _3));
+  }
+
+  return block;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MemoryManager::deallocate(void* block)
+{
+#ifdef CF_OS_WINDOWS
+  _aligned_free(block);
+#else
+  std::free(block);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Common
+} // CF
+
+////////////////////////////////////////////////////////////////////////////////
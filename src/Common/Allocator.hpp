@@ -0,0 +1,125 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Common_Allocator_hpp
+#define CF_Common_Allocator_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+#include "Common/CommonAPI.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Common {
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Manager of the memory of the mesh and field tables, allocated through Allocator.
+///
+/// Blocks are aligned to cache lines, so that vectorized loops over a table start
+/// aligned. Large blocks can be backed by transparent huge pages, and can be first
+/// touched by the threads of the ThreadPool, split in chunks the same way as the
+/// loops over the table, so that on NUMA nodes the pages are placed close to the
+/// threads using them. Both are controlled by the options "huge_pages" and
+/// "parallel_first_touch" of the environment (CEnv).
+class Common_API MemoryManager : public boost::noncopyable {
+
+public:
+
+  /// Alignment of every block, in bytes
+  static const std::size_t alignment = 64;
+
+  /// Constructor
+  MemoryManager();
+
+  /// Gets the instance of the manager
+  static MemoryManager& instance ();
+
+  /// Allocates an aligned block
+  /// @throw std::bad_alloc if the block cannot be allocated
+  void* allocate(const std::size_t bytes);
+
+  /// Frees a block returned by allocate()
+  void deallocate(void* block);
+
+  /// advise the kernel to back large blocks with transparent huge pages
+  bool HugePages;
+
+  /// large blocks are first touched by the threads of the pool, unless allocated within a task
+  bool ParallelFirstTouch;
+
+}; // class MemoryManager
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Standard allocator of the mesh and field tables, getting its memory from the MemoryManager
+template <typename T>
+class Allocator
+{
+public: // typedefs
+
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  template <typename U>
+  struct rebind { typedef Allocator<U> other; };
+
+public: // functions
+
+  Allocator() {}
+
+  template <typename U>
+  Allocator(const Allocator<U>&) {}
+
+  pointer address(reference value) const { return &value; }
+
+  const_pointer address(const_reference value) const { return &value; }
+
+  pointer allocate(const size_type n, const void* = 0)
+  {
+    if (n > max_size())
+      throw std::bad_alloc();
+    return static_cast<pointer>(MemoryManager::instance().allocate(n*sizeof(T)));
+  }
+
+  void deallocate(pointer p, const size_type)
+  {
+    MemoryManager::instance().deallocate(p);
+  }
+
+  size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(T); }
+
+  void construct(pointer p, const T& value) { new (static_cast<void*>(p)) T(value); }
+
+  void destroy(pointer p) { p->~T(); }
+
+}; // class Allocator
+
+/// All the allocators share the same memory
+template <typename T, typename U>
+bool operator==(const Allocator<T>&, const Allocator<U>&) { return true; }
+
+template <typename T, typename U>
+bool operator!=(const Allocator<T>&, const Allocator<U>&) { return false; }
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Common
+} // CF
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_Common_Allocator_hpp
@@ -10,6 +10,8 @@
 #include "Common/LibCommon.hpp"
 #include "Common/LogLevel.hpp"
 #include "Common/Log.hpp"
+#include "Common/ThreadPool.hpp"
+#include "Common/Allocator.hpp"
 #include "Common/CEnv.hpp"
 
 namespace CF {
@@ -101,6 +103,22 @@ CEnv::CEnv ( const std::string& name) : Component ( name )
       ->mark_basic()
       ->attach_trigger(boost::bind(&CEnv::trigger_log_level,this));
 
+  m_options.add_option< OptionT<Uint> >("nb_threads", ThreadPool::instance().nb_threads())
+      ->pretty_name("Number of Threads")
+      ->description("The number of threads sharing the loops over the mesh in every process, 0 for the number of cores")
+      ->mark_basic()
+      ->attach_trigger(boost::bind(&CEnv::trigger_nb_threads,this));
+
+  m_options.add_option< OptionT<bool> >("huge_pages", MemoryManager::instance().HugePages)
+      ->pretty_name("Huge Pages")
+      ->description("Back the large mesh and field tables with transparent huge pages")
+      ->attach_trigger(boost::bind(&CEnv::trigger_huge_pages,this));
+
+  m_options.add_option< OptionT<bool> >("parallel_first_touch", MemoryManager::instance().ParallelFirstTouch)
+      ->pretty_name("Parallel First Touch")
+      ->description("Let the threads first touch the large mesh and field tables, placing their pages near the threads looping over them")
+      ->attach_trigger(boost::bind(&CEnv::trigger_parallel_first_touch,this));
+
   trigger_log_level();
 
   // signals
@@ -118,6 +136,27 @@ CEnv::~CEnv()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void CEnv::trigger_nb_threads()
+{
+  ThreadPool::instance().set_nb_threads(option("nb_threads").value<Uint>());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CEnv::trigger_huge_pages()
+{
+  MemoryManager::instance().HugePages = option("huge_pages").value<bool>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CEnv::trigger_parallel_first_touch()
+{
+  MemoryManager::instance().ParallelFirstTouch = option("parallel_first_touch").value<bool>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void CEnv::trigger_only_cpu0_writes()
 {
   CFerror.setFilterRankZero(option("only_cpu0_writes").value<bool>());
@@ -55,6 +55,12 @@ private: // functions
 
   void trigger_log_level();
 
+  void trigger_nb_threads();
+
+  void trigger_huge_pages();
+
+  void trigger_parallel_first_touch();
+
 }; // CEnv
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -11,6 +11,7 @@
 #include <vector>
 #include <map>
 
+#include <boost/cstdint.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/checked_delete.hpp>
 
@@ -83,6 +84,10 @@ namespace CF {
 /// typedef for unsigned int
 typedef unsigned int Uint;
 
+/// typedef for global indices, 64 bit so that a mesh can have more than 2^32 entities,
+/// while the local indices and connectivity tables stay Uint
+typedef boost::uint64_t Gid;
+
 /// Definition of the default precision
 #ifdef CF_REAL_IS_FLOAT
 typedef float Real;
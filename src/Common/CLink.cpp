@@ -6,6 +6,7 @@
 
 #include "Common/BasicExceptions.hpp"
 #include "Common/CBuilder.hpp"
+#include "Common/CRoot.hpp"
 #include "Common/Signal.hpp"
 #include "Common/LibCommon.hpp"
 
@@ -68,6 +69,7 @@ CLink& CLink::link_to ( Component::Ptr lnkto )
     throw SetupError(FromHere(), "Cannot link a CLink to another CLink");
 
   m_link_component = lnkto;
+  notify_link_changed();
   return *this;
 }
 
@@ -78,6 +80,7 @@ CLink& CLink::link_to ( Component& lnkto )
     throw SetupError(FromHere(), "Cannot link a CLink to another CLink");
 
   m_link_component = lnkto.self();
+  notify_link_changed();
   return *this;
 }
 
@@ -88,10 +91,18 @@ CLink& CLink::link_to ( Component const& lnkto )
     throw SetupError(FromHere(), "Cannot link a CLink to another CLink");
 
   m_link_component = boost::const_pointer_cast<Component>(lnkto.self());
+  notify_link_changed();
   return *this;
 }
 
 
+void CLink::notify_link_changed()
+{
+  if( !m_root.expired() )
+    m_root.lock()->notify_tree_change( CRoot::TreeChange::CHANGED, uri() );
+}
+
+
 void CLink::change_link( SignalArgs & args )
 {
   SignalOptions options( args );
@@ -52,6 +52,11 @@ public: // functions
 
   void change_link( SignalArgs & args );
 
+private: // helper functions
+
+  /// records the new target in the tree change log of the root
+  void notify_link_changed();
+
 private: // data
 
   /// this is a link to the component
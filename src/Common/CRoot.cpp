@@ -5,7 +5,11 @@
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
 #include <sstream>
+#include <set>
 
+#include <boost/algorithm/string/predicate.hpp>
+
+#include "Common/Foreach.hpp"
 #include "Common/Log.hpp"
 #include "Common/Signal.hpp"
 
@@ -37,7 +41,10 @@ namespace Common {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-  CRoot::CRoot ( const std::string& name ) : Component ( name )
+  CRoot::CRoot ( const std::string& name ) :
+    Component ( name ),
+    m_tree_version(0),
+    m_tree_log_size(4096)
   {
     // we need to manually register the type name since CRoot cannot be
     // put into ComponentBuilder because the constructor is private
@@ -161,6 +168,117 @@ namespace Common {
     m_notif_queues.push_back(queue);
   }
 
+////////////////////////////////////////////////////////////////////////////////
+
+  void CRoot::notify_tree_change ( TreeChange::Type type, const URI& path )
+  {
+    TreeChange change;
+    change.version = ++m_tree_version;
+    change.type = type;
+    change.path = path.path();
+
+    m_tree_log.push_back(change);
+
+    while( m_tree_log.size() > m_tree_log_size )
+      m_tree_log.pop_front();
+  }
+
+////////////////////////////////////////////////////////////////////////////////
+
+  void CRoot::set_tree_log_size ( const Uint size )
+  {
+    m_tree_log_size = size;
+
+    while( m_tree_log.size() > m_tree_log_size )
+      m_tree_log.pop_front();
+  }
+
+////////////////////////////////////////////////////////////////////////////////
+
+  namespace {
+
+    /// true if path is strictly below one of the paths in the set
+    bool is_below_any ( const std::string& path, const std::set<std::string>& parents )
+    {
+      boost_foreach( const std::string& parent, parents )
+      {
+        if( path.size() > parent.size() && path[parent.size()] == '/'
+            && boost::starts_with(path, parent) )
+          return true;
+      }
+      return false;
+    }
+
+  }
+
+  bool CRoot::tree_changes_since ( const Uint version,
+                                   std::vector<std::string>& removed,
+                                   std::vector<std::string>& added ) const
+  {
+    removed.clear();
+    added.clear();
+
+    if( version > m_tree_version )
+      return false; // client comes from another tree
+
+    if( version == m_tree_version )
+      return true;  // nothing happened
+
+    if( m_tree_log.empty() || m_tree_log.front().version > version + 1 )
+      return false; // log was truncated
+
+    // first and last change recorded per path, in order of first appearance
+    std::vector<std::string> order;
+    std::map<std::string, std::pair<TreeChange::Type,bool> > first_seen; // (first type, replaced)
+
+    boost_foreach( const TreeChange& change, m_tree_log )
+    {
+      if( change.version <= version )
+        continue;
+
+      std::map<std::string, std::pair<TreeChange::Type,bool> >::iterator it = first_seen.find(change.path);
+      if( it == first_seen.end() )
+      {
+        first_seen[change.path] = std::make_pair(change.type, false);
+        order.push_back(change.path);
+      }
+      else if( change.type != TreeChange::REMOVED )
+      {
+        it->second.second = true;
+      }
+    }
+
+    std::vector<std::string> raw_removed, raw_added;
+
+    boost_foreach( const std::string& path, order )
+    {
+      const std::pair<TreeChange::Type,bool>& info = first_seen[path];
+
+      const bool existed_before = ( info.first != TreeChange::ADDED );
+      const bool exists_now = exists_component_path( URI(path, URI::Scheme::CPATH) );
+
+      if( existed_before && ( !exists_now || info.second || info.first == TreeChange::CHANGED ) )
+        raw_removed.push_back(path);
+
+      if( exists_now && ( !existed_before || info.second || info.first == TreeChange::CHANGED ) )
+        raw_added.push_back(path);
+    }
+
+    // drop the nodes whose ancestor is already listed
+    std::set<std::string> removed_set(raw_removed.begin(), raw_removed.end());
+    std::set<std::string> added_set(raw_added.begin(), raw_added.end());
+
+    boost_foreach( const std::string& path, raw_removed )
+      if( !is_below_any(path, removed_set) && !is_below_any(path, added_set) )
+        removed.push_back(path);
+
+    boost_foreach( const std::string& path, raw_added )
+      if( !is_below_any(path, added_set) )
+        added.push_back(path);
+
+    return true;
+  }
+
 ////////////////////////////////////////////////////////////////////////////////
 
 } // Common
@@ -9,6 +9,8 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <deque>
+
 #include "Common/Component.hpp"
 
 namespace CF {
@@ -27,6 +29,20 @@ namespace Common {
     typedef boost::shared_ptr<CRoot> Ptr;
     typedef boost::shared_ptr<CRoot const> ConstPtr;
 
+    /// One entry of the structural change log of the tree
+    struct TreeChange
+    {
+      /// Kind of change applied to a node
+      enum Type { ADDED, REMOVED, CHANGED };
+
+      /// tree version right after this change was applied
+      Uint version;
+      /// kind of change
+      Type type;
+      /// path of the node at the time of the change
+      std::string path;
+    };
+
   public: // functions
 
     /// Get the class name
@@ -100,6 +116,31 @@ namespace Common {
     /// @param queue The queue object. Cannot be null.
     void add_notification_queue ( NotificationQueue * queue );
 
+    /// @return the current version of the tree structure.
+    /// The version is incremented each time a node is added, removed or changed.
+    Uint tree_version () const { return m_tree_version; }
+
+    /// Records a structural change of the tree and increments its version
+    /// @param type kind of change
+    /// @param path path of the node that changed
+    void notify_tree_change ( TreeChange::Type type, const URI& path );
+
+    /// Computes the net set of changes applied to the tree after a given version.
+    /// Nodes that were added then removed within the window are dropped,
+    /// nodes that were replaced or changed appear in both lists, and nodes
+    /// lying under another listed node are omitted.
+    /// @param [in]  version  the version the caller is synchronized with
+    /// @param [out] removed  paths of the nodes to remove, in log order
+    /// @param [out] added    paths of the nodes to (re)send, in log order
+    /// @return false if the log does not reach back to @c version, in which
+    ///         case the caller needs the complete tree
+    bool tree_changes_since ( const Uint version,
+                              std::vector<std::string>& removed,
+                              std::vector<std::string>& added ) const;
+
+    /// Sets the maximum number of changes kept in the tree change log
+    void set_tree_log_size ( const Uint size );
+
   private: // helper functions
 
     typedef std::map< std::string , Component::Ptr > CompStorage_t;
@@ -115,6 +156,15 @@ namespace Common {
 
     std::vector<NotificationQueue*> m_notif_queues;
 
+    /// version of the tree structure
+    Uint m_tree_version;
+
+    /// bounded log of the latest structural changes
+    std::deque<TreeChange> m_tree_log;
+
+    /// maximum number of entries in the tree change log
+    Uint m_tree_log_size;
+
   }; // CRoot
 
 ////////////////////////////////////////////////////////////////////////////////
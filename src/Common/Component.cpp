@@ -67,6 +67,13 @@ Component::Component ( const std::string& name ) :
       ->description("lists the component tree inside this component")
       ->pretty_name("List tree");
 
+  regist_signal( "list_tree_delta" )
+      ->connect( boost::bind( &Component::signal_list_tree_delta, this, _1 ) )
+      ->hidden(true)
+      ->read_only(true)
+      ->description("lists the changes of the component tree inside this component since a given version")
+      ->pretty_name("List tree delta");
+
   regist_signal( "list_properties" )
       ->connect( boost::bind( &Component::signal_list_properties, this, _1 ) )
       ->hidden(true)
@@ -235,6 +242,9 @@ Component& Component::add_component ( Component::Ptr subcomp )
 
   subcomp->change_parent( this );
 
+  if( !m_root.expired() )
+    m_root.lock()->notify_tree_change( CRoot::TreeChange::ADDED, subcomp->uri() );
+
   raise_path_changed();
 
   return *subcomp;
@@ -258,6 +268,10 @@ Component& Component::add_static_component ( Component::Ptr subcomp )
   raise_path_changed();
 
   subcomp->change_parent( this );
+
+  if( !m_root.expired() )
+    m_root.lock()->notify_tree_change( CRoot::TreeChange::ADDED, subcomp->uri() );
+
   subcomp->signal("rename_component")->hidden(true);
   subcomp->signal("delete_component")->hidden(true);
   subcomp->signal("move_component")->hidden(true);
@@ -325,7 +339,10 @@ Component::Ptr Component::remove_component ( const std::string& name )
 
     // remove the component from the root
     if( !m_root.expired() )
+    {
+      m_root.lock()->notify_tree_change( CRoot::TreeChange::REMOVED, comp->uri() );
       m_root.lock()->remove_component_path(comp->uri());
+    }
 
     m_dynamic_components.erase(itr);               // remove it from the storage
 
@@ -791,6 +808,71 @@ void Component::signal_list_tree( SignalArgs& args )
   SignalFrame reply = args.create_reply( uri() );
 
   write_xml_tree(reply.main_map.content, false);
+
+  if( !m_root.expired() )
+    reply.main_map.set_value( "version", m_root.lock()->tree_version() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Component::signal_list_tree_delta( SignalArgs& args )
+{
+  SignalOptions options( args );
+  SignalFrame reply = args.create_reply( uri() );
+
+  cf_assert( !m_root.expired() );
+  CRoot::Ptr root = m_root.lock();
+
+  Uint version = 0;
+  if( options.check("version") )
+    version = options.value<Uint>("version");
+
+  std::vector<std::string> removed;
+  std::vector<std::string> added;
+
+  const bool is_delta = ( version != 0 ) && root->tree_changes_since( version, removed, added );
+
+  reply.main_map.set_value( "version", root->tree_version() );
+  reply.main_map.set_value( "full", !is_delta );
+
+  if( !is_delta )
+  {
+    // the client is too far behind, send the whole tree
+    write_xml_tree( reply.main_map.content, false );
+    return;
+  }
+
+  // only keep the changes inside this component
+  const std::string prefix = uri().path();
+  std::vector<std::string> removed_here;
+
+  boost_foreach( const std::string& path, removed )
+  {
+    if( boost::starts_with(path, prefix + "/") )
+      removed_here.push_back(path);
+  }
+
+  reply.main_map.set_array( "removed", removed_here, " ; " );
+
+  SignalFrame& added_frame = reply.map( "added" );
+
+  boost_foreach( const std::string& path, added )
+  {
+    if( !boost::starts_with(path, prefix + "/") )
+      continue;
+
+    Component::Ptr comp = root->retrieve_component( URI(path, URI::Scheme::CPATH) );
+    if( is_null(comp) )
+      continue;
+
+    comp->write_xml_tree( added_frame.main_map.content, false );
+
+    // remember where the node belongs
+    XmlNode written( added_frame.main_map.content.content->last_node("node") );
+
+    if( written.is_valid() )
+      written.set_attribute( "parent", comp->parent().uri().path() );
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -407,6 +407,11 @@ public: // functions
   /// lists the sub components and puts them on the xml_tree
   void signal_list_tree( SignalArgs& args );
 
+  /// lists the nodes added, removed or changed inside this component since
+  /// the tree version given in the "version" option
+  /// @note if the version is 0 or too old, the complete tree is put in the reply
+  void signal_list_tree_delta( SignalArgs& args );
+
   /// lists the properties of this component
   void signal_list_properties ( SignalArgs& args );
 
@@ -15,11 +15,13 @@
 #include "Common/OptionT.hpp"
 #include "Common/OptionURI.hpp"
 #include "Common/Signal.hpp"
+#include "Common/StringConversion.hpp"
 
 #include "Common/XML/FileOperations.hpp"
 #include "Common/XML/SignalOptions.hpp"
 
 #include "Common/MPI/PE.hpp"
+#include "Common/MPI/ListeningInfo.hpp"
 #include "Common/MPI/ListeningThread.hpp"
 
 #include "Common/MPI/CPEManager.hpp"
@@ -96,7 +98,10 @@ CPEManager::CPEManager( const std::string & name )
 
 CPEManager::~CPEManager()
 {
-
+  // the last frame posted to the parent must be delivered before its
+  // buffer is freed
+  if( !m_posted_requests.empty() && PE::instance().is_active() )
+    MPI_Waitall( m_posted_requests.size(), &m_posted_requests[0], MPI_STATUSES_IGNORE );
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -220,6 +225,53 @@ void CPEManager::send_to_parent( const SignalArgs & args )
 
 ////////////////////////////////////////////////////////////////////////////
 
+bool CPEManager::try_send_to_parent( const SignalArgs & args )
+{
+  std::map<std::string, Communicator>::iterator it = m_groups.find("MPI_Parent");
+
+  if( it == m_groups.end() )
+    return false;
+
+  if( !m_posted_requests.empty() )
+  {
+    int done = 0;
+
+    MPI_Testall( m_posted_requests.size(), &m_posted_requests[0], &done, MPI_STATUSES_IGNORE );
+
+    if( !done ) // the previous frame is still being sent
+      return false;
+  }
+
+  int remote_size;
+
+  to_string( *args.xml_doc, m_posted_frame );
+
+  // the listening thread of the parent would not be able to receive it
+  if( m_posted_frame.length() + 1 > ListeningInfo::buffer_size() )
+  {
+    const Uint length = m_posted_frame.length();
+    m_posted_frame.clear();
+    m_posted_requests.clear();
+    throw BadValue( FromHere(), "Frame of " + to_str(length) + " bytes is too big to be sent to the parent,"
+                    " which receives up to " + to_str(ListeningInfo::buffer_size()) + " bytes" );
+  }
+
+  MPI_Comm_remote_size( it->second, &remote_size );
+
+  m_posted_requests.resize( remote_size );
+
+  // the buffer must remain valid until the requests complete, it is only
+  // modified once they all did
+  char * buffer = const_cast<char *>( m_posted_frame.c_str() );
+
+  for(int i = 0 ; i < remote_size ; ++i)
+    MPI_Isend( buffer, m_posted_frame.length() + 1, MPI_CHAR, i, 0, it->second, &m_posted_requests[i] );
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////
+
 void CPEManager::send_to( const std::string & group, const SignalArgs & args )
 {
   std::map<std::string, Communicator>::iterator it = m_groups.find(group);
@@ -53,6 +53,16 @@ public: // functions
 
   void send_to_parent( const SignalArgs & args );
 
+  /// Sends a frame to the parent without blocking.
+  /// Only one frame can be in flight at a time: if the previous one has not
+  /// been delivered yet, the frame is dropped.
+  /// @param args The frame to send.
+  /// @return Returns @c true if the frame was posted, @c false if it was
+  /// dropped (or if there is no parent).
+  /// @throw BadValue if the frame is bigger than the parent can receive
+  /// (see @c ListeningInfo::buffer_size())
+  bool try_send_to_parent( const SignalArgs & args );
+
   void send_to( const std::string & group, const SignalArgs & args );
 
   void broadcast( const SignalArgs & args );
@@ -97,6 +107,11 @@ private:
 
   ListeningThread * m_listener;
 
+  /// Frame being sent by @c #try_send_to_parent()
+  std::string m_posted_frame;
+
+  /// Requests of the frame being sent by @c #try_send_to_parent()
+  std::vector<MPI_Request> m_posted_requests;
 
 
 }; // CPEManager
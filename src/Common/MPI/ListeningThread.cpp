@@ -4,9 +4,6 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
-#include <unistd.h>
-
-#include <boost/date_time.hpp>
 #include <boost/thread.hpp>
 
 #include "Common/Assertions.hpp"
@@ -16,6 +13,7 @@
 #include "Common/XML/FileOperations.hpp"
 
 #include "Common/MPI/ListeningInfo.hpp"
+#include "Common/MPI/PE.hpp"
 
 #include "Common/MPI/ListeningThread.hpp"
 
@@ -30,11 +28,32 @@ namespace mpi {
 
 ////////////////////////////////////////////////////////////////////////////
 
-ListeningThread::ListeningThread(unsigned int waitingTime)
-  : m_sleep_duration(waitingTime),
-    m_listening(false)
+ListeningThread::ListeningThread()
+  : m_listening(false),
+    m_running(false),
+    m_wakeup_comm(MPI_COMM_NULL),
+    m_wakeup_request(MPI_REQUEST_NULL),
+    m_wakeup_data(0)
+{
+
+}
+
+////////////////////////////////////////////////////////////////////////////
+
+ListeningThread::~ListeningThread()
 {
+  stop_listening();
 
+  std::map<Communicator, ListeningInfo*>::iterator it = m_comms.begin();
+
+  for( ; it != m_comms.end() ; ++it )
+    delete it->second;
+
+  int finalized = 0;
+  MPI_Finalized( &finalized );
+
+  if( m_wakeup_comm != MPI_COMM_NULL && !finalized )
+    MPI_Comm_free( &m_wakeup_comm );
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -46,9 +65,19 @@ void ListeningThread::add_communicator( Communicator comm )
   cf_assert( comm != MPI_COMM_NULL );
   cf_assert( m_comms.find(comm) == m_comms.end() );
 
-  m_comms[comm] = new ListeningInfo();
+  ListeningInfo * info = new ListeningInfo();
+
+  info->comm = comm;
+  m_comms[comm] = info;
+
+  bool running = m_running;
 
   m_mutex.unlock();
+
+  // the thread posts the receive on the new communicator as soon as it
+  // wakes up
+  if( running )
+    wake_up();
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -63,22 +92,43 @@ void ListeningThread::remove_comunicator( Communicator comm )
 
   cf_assert( it != m_comms.end() );
 
+  ListeningInfo * info = it->second;
+  bool running = m_running;
+
   m_comms.erase(it);
 
+  // if the thread is running, it may be waiting on the pending receive:
+  // only the thread can cancel it safely
+  if( running )
+    m_removed.push_back( info );
+  else
+    delete info;
+
   m_mutex.unlock();
+
+  if( running )
+    wake_up();
 }
 
 ////////////////////////////////////////////////////////////////////////////
 
 void ListeningThread::stop_listening()
 {
-//  m_mutex.lock();
+  m_mutex.lock();
+
+  bool running = m_running;
 
   m_listening = false;
 
-//  m_thread.join();
+  m_mutex.unlock();
+
+  if( running )
+    wake_up();
 
-//  m_mutex.unlock();
+  // a slot connected to new_signal may stop the thread: it cannot wait
+  // for itself to exit
+  if( m_thread.get_id() != boost::this_thread::get_id() && m_thread.joinable() )
+    m_thread.join();
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -87,24 +137,27 @@ void ListeningThread::start_listening()
 {
   if( !m_listening && !m_comms.empty() )
   {
-    m_listening = true;
+    // the thread waits on receives while the other threads send
+    if( !PE::instance().is_thread_multiple() )
+      throw SetupError( FromHere(), "The MPI library does not provide MPI_THREAD_MULTIPLE,"
+                                    " which the listening thread needs." );
 
-    m_thread = boost::thread(&ListeningThread::run, this);
-  }
-}
+    // the previous run may still be cancelling its receives
+    if( m_thread.get_id() != boost::this_thread::get_id() && m_thread.joinable() )
+      m_thread.join();
 
-////////////////////////////////////////////////////////////////////////////
+    if( m_wakeup_comm == MPI_COMM_NULL )
+      MPI_Comm_dup( MPI_COMM_SELF, &m_wakeup_comm );
 
-void ListeningThread::set_sleep_duration(Uint time)
-{
-  m_sleep_duration = time;
-}
+    m_mutex.lock();
 
-////////////////////////////////////////////////////////////////////////////
+    m_listening = true;
+    m_running = true;
 
-Uint ListeningThread::sleep_duration() const
-{
-  return m_sleep_duration;
+    m_mutex.unlock();
+
+    m_thread = boost::thread(&ListeningThread::run, this);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -118,9 +171,27 @@ boost::thread & ListeningThread::thread()
 
 void ListeningThread::init()
 {
-  static int count = 0;
   m_mutex.lock();
 
+  // cancel the receives of the removed communicators
+  std::vector<ListeningInfo*>::iterator it_rem = m_removed.begin();
+
+  for( ; it_rem != m_removed.end() ; ++it_rem )
+  {
+    cancel_receive( *it_rem );
+    delete *it_rem;
+  }
+
+  m_removed.clear();
+
+  if( m_wakeup_request == MPI_REQUEST_NULL )
+    MPI_Irecv( &m_wakeup_data, 1, MPI_CHAR, 0, 0, m_wakeup_comm, &m_wakeup_request );
+
+  m_requests.clear();
+  m_waiting.clear();
+
+  m_requests.push_back( m_wakeup_request );
+
   std::map<Communicator, ListeningInfo*>::iterator it = m_comms.begin();
 
   // non-blocking receive on all communicators
@@ -130,14 +201,14 @@ void ListeningThread::init()
 
     if( info->ready )
     {
-      MPI_Request request;
-      info->request = request;
-
       MPI_Irecv(info->data, ListeningInfo::buffer_size(), MPI_CHAR,
                     MPI_ANY_SOURCE, 0, it->first, &info->request);
 
       info->ready = false;
     }
+
+    m_requests.push_back( info->request );
+    m_waiting.push_back( info );
   }
 
   m_mutex.unlock();
@@ -147,52 +218,75 @@ void ListeningThread::init()
 
 void ListeningThread::run()
 {
+  std::vector< std::pair<Communicator, XmlDoc::Ptr> > frames;
+
+  ExceptionManager::instance().ExceptionDumps = false;
+
   while( m_listening )
   {
     this->init(); // initialize the listening process for comms that need it
-    this_thread::sleep( posix_time::milliseconds(m_sleep_duration) );
-    this->check_for_data(); // check if data arrived
+    this->check_for_data( frames ); // wait for data
+
+    // frames are dispatched without holding the mutex, so that slots can
+    // add or remove communicators, or stop the listening
+    std::vector< std::pair<Communicator, XmlDoc::Ptr> >::iterator it = frames.begin();
+
+    for( ; it != frames.end() && m_listening ; ++it )
+    {
+      try
+      {
+        new_signal( it->first, it->second );
+      }
+      catch( Exception & e )
+      {
+        CFerror << e.what() << CFendl;
+      }
+    }
+
+    frames.clear();
   }
+
+  this->cleanup();
 }
 
 ////////////////////////////////////////////////////////////////////////////
 
-void ListeningThread::check_for_data()
+void ListeningThread::check_for_data( std::vector< std::pair<Communicator, XmlDoc::Ptr> > & frames )
 {
-  m_mutex.lock();
+  std::vector<int> indices( m_requests.size() );
+  int count = 0;
 
-  ExceptionManager::instance().ExceptionDumps = false;
+  // blocks until at least one request completes
+  MPI_Waitsome( m_requests.size(), &m_requests[0], &count, &indices[0], MPI_STATUSES_IGNORE );
 
-  std::map<Communicator, ListeningInfo*>::iterator it = m_comms.begin();
+  m_mutex.lock();
 
-  for( ; it != m_comms.end() && m_listening ; ++it )
+  for( int i = 0 ; i < count ; ++i )
   {
-    ListeningInfo * info = it->second;
-
-    // if the communicator is waiting for data
-    if( !info->ready )
+    // the wake-up request: it is posted again on the next iteration
+    if( indices[i] == 0 )
     {
-      int flag;
+      m_wakeup_request = MPI_REQUEST_NULL;
+      continue;
+    }
 
-      MPI_Test(&info->request, &flag, MPI_STATUS_IGNORE);
+    ListeningInfo * info = m_waiting[ indices[i] - 1 ];
 
-      // if data arrived, flag is not zero
-      if( flag != 0 )
-      {
-        try
-        {
-          XmlDoc::Ptr doc = XML::parse_cstring( info->data );
-
-          new_signal( it->first, doc );
-
-          info->ready = true; // ready to do another non-blocking receive
-        }
-        catch(XmlError & e)
-        {
-          CFerror << e.what() << CFendl;
-          m_listening = false;
-        }
-      }
+    info->request = MPI_REQUEST_NULL;
+    info->ready = true; // ready to do another non-blocking receive
+
+    // the communicator was removed while the thread was waiting
+    if( m_comms.find(info->comm) == m_comms.end() )
+      continue;
+
+    try
+    {
+      frames.push_back( std::make_pair( info->comm, XML::parse_cstring( info->data ) ) );
+    }
+    catch(XmlError & e)
+    {
+      CFerror << e.what() << CFendl;
+      m_listening = false;
     }
   }
 
@@ -201,6 +295,68 @@ void ListeningThread::check_for_data()
 
 ////////////////////////////////////////////////////////////////////////////
 
+void ListeningThread::cleanup()
+{
+  m_mutex.lock();
+
+  std::vector<ListeningInfo*>::iterator it_rem = m_removed.begin();
+
+  for( ; it_rem != m_removed.end() ; ++it_rem )
+  {
+    cancel_receive( *it_rem );
+    delete *it_rem;
+  }
+
+  m_removed.clear();
+
+  std::map<Communicator, ListeningInfo*>::iterator it = m_comms.begin();
+
+  for( ; it != m_comms.end() ; ++it )
+    cancel_receive( it->second );
+
+  if( m_wakeup_request != MPI_REQUEST_NULL )
+  {
+    MPI_Cancel( &m_wakeup_request );
+    MPI_Wait( &m_wakeup_request, MPI_STATUS_IGNORE );
+  }
+
+  m_requests.clear();
+  m_waiting.clear();
+
+  m_running = false;
+
+  m_mutex.unlock();
+}
+
+////////////////////////////////////////////////////////////////////////////
+
+void ListeningThread::cancel_receive( ListeningInfo * info )
+{
+  cf_assert( is_not_null(info) );
+
+  if( !info->ready )
+  {
+    MPI_Cancel( &info->request );
+    MPI_Wait( &info->request, MPI_STATUS_IGNORE );
+
+    info->ready = true;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+
+void ListeningThread::wake_up()
+{
+  MPI_Request request;
+
+  // zero-length message to ourself; the request is freed right away since
+  // there is nothing to wait for
+  MPI_Isend( &m_wakeup_data, 0, MPI_CHAR, 0, 0, m_wakeup_comm, &request );
+  MPI_Request_free( &request );
+}
+
+////////////////////////////////////////////////////////////////////////////
+
 } // mpi
 } // Common
 } // CF
@@ -9,6 +9,9 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <map>
+#include <vector>
+
 // boost headers
 //#include <boost/asio/deadline_timer.hpp>
 #include <boost/signals2/signal.hpp>
@@ -17,6 +20,7 @@
 
 // CF headers
 #include "Common/XML/XmlDoc.hpp"
+#include "Common/MPI/types.hpp"
 
 ////////////////////////////////////////////////////////////////////////////
 
@@ -40,23 +44,22 @@ namespace mpi {
   /// be undefined. @n
 
   /// Internally, the thread makes a non-blocking MPI receive on all
-  /// communicators and then sleeps during some time (defined by the user).
-  /// When it wakes up, it checks all the communicators and, for each of them
-  /// that has new data, calls the @c new_signal signal; and then makes a new
-  /// non-blocking receive. @n
-
-  /// The fact that the thread sleeps is for performance reasons: it is to
-  /// avoid the code to run useless instruction and use not needed CPU time
-  /// while waiting. It is to the user to determine the best "sleeping time".
-  /// The default is 10 milliseconds. @n
-
-  /// However, be careful when defining this sleeping time. The biggest it is,
-  /// the longuest is the response time for requests. If the sleeping time is too
-  /// small, the CPU usage might be too high if no data arrives during a long time. @n
-
-  /// New intercommunicators can be added on the run as well as the sleeping
-  /// time can be modified. Thoes changes will be taken into account
-  /// at the next iteration (after the next check).
+  /// communicators and then blocks until at least one of them completes
+  /// (@c MPI_Waitsome). All frames that arrived are then handled as a batch:
+  /// for each of them, the @c new_signal signal is called; and then a new
+  /// non-blocking receive is made. The thread does not use any CPU time while
+  /// waiting and reacts as soon as data arrives. @n
+
+  /// To interrupt the wait, the thread also listens to a private
+  /// communicator on which it can send messages to itself (a "wake-up"
+  /// message). This is used to stop the thread immediately and to take
+  /// into account added or removed communicators without waiting for
+  /// data. @n
+
+  /// Since MPI is called from several threads at the same time, the MPI
+  /// environment has to be initialized with @c MPI_THREAD_MULTIPLE support
+  /// (see @c PE::init()). If the MPI library does not grant it,
+  /// @c start_listening() throws a @c SetupError.
 
   /// @author Quentin Gasper
 
@@ -69,7 +72,12 @@ namespace mpi {
   public: // functions
 
     /// @brief Constructor.
-    ListeningThread(Uint waitingTime = 10);
+    ListeningThread();
+
+    /// @brief Destructor.
+
+    /// Stops the listening and frees the wake-up communicator.
+    ~ListeningThread();
 
     /// @brief Adds a communicator to listen to.
 
@@ -77,11 +85,19 @@ namespace mpi {
     /// @param comm Communicator to add.
     void add_communicator(Communicator comm);
 
+    /// @brief Removes a communicator.
+
+    /// This method can be called during the listening. The pending receive
+    /// on the communicator is cancelled by the thread before it waits again.
+    /// @param comm Communicator to remove.
     void remove_comunicator(Communicator comm);
 
     /// @brief Stops the listening.
 
     /// Calling this method will exit the thread execution if it is running.
+    /// The thread is woken up, and if this method is not called from the
+    /// thread itself (i.e. from a slot connected to @c #new_signal), it
+    /// waits for the thread to exit.
     void stop_listening();
 
     /// @brief Starts the listening process
@@ -90,28 +106,38 @@ namespace mpi {
     /// main steps:
     /// @li call Irecv (non-blocking receive) on ready communicators (new ones
     /// and those that just received data)
-    /// @li wait @c #m_waitingTime ms
-    /// @li call check all communicators for new data
-    /// When new data arrived, @c #newFrame signal is emitted. @n
+    /// @li wait until data arrives on at least one communicator, or until the
+    /// thread is woken up
+    /// @li handle all frames that arrived
+    /// When new data arrived, @c #new_signal signal is emitted. @n
     /// This process is repeated as long as @c #stop_listening() is not called.
     /// If a new communicator is added, it will be taken in account on the next
     /// iteration.
     void start_listening();
 
-    void set_sleep_duration(Uint time);
-
-    Uint sleep_duration() const;
-
     boost::thread & thread();
 
   private: // function
 
     void run();
 
-    void check_for_data();
+    /// Waits until at least one frame arrived (or until the thread is woken
+    /// up) and parses all frames that arrived.
+    /// @param frames Vector where the parsed frames are appended.
+    void check_for_data( std::vector< std::pair<Communicator, XML::XmlDoc::Ptr> > & frames );
 
     void init();
 
+    /// Cancels the pending receives and deletes the removed communicators.
+    /// Called by the thread before it exits.
+    void cleanup();
+
+    /// Cancels the pending receive of a communicator, if any.
+    void cancel_receive( ListeningInfo * info );
+
+    /// Sends a message to the thread to interrupt the wait.
+    void wake_up();
+
   private: // data
 
     /// @brief Communicators
@@ -125,9 +151,34 @@ namespace mpi {
     /// If @c true, the thread is listening, otherwise it is not.
     bool m_listening;
 
-    Uint m_sleep_duration;
+    /// @brief Indicates whether the thread is running.
+
+    /// It can still be running for a short time after @c #m_listening was set
+    /// to @c false, while it cancels its pending receives.
+    bool m_running;
+
+    /// @brief Communicators removed during the listening.
+
+    /// Their pending receive has to be cancelled by the thread.
+    std::vector<ListeningInfo*> m_removed;
+
+    /// @brief Requests the thread waits on.
+
+    /// The first one is the wake-up request, the others are the
+    /// pending receives of @c #m_waiting, in the same order.
+    std::vector<MPI_Request> m_requests;
+
+    /// @brief Communicators the thread waits on.
+    std::vector<ListeningInfo*> m_waiting;
+
+    /// @brief Private communicator used to wake the thread up.
+    Communicator m_wakeup_comm;
+
+    /// @brief Request for the wake-up message.
+    MPI_Request m_wakeup_request;
 
-    Communicator m_receivingAcksComm;
+    /// @brief Buffer for the wake-up message.
+    char m_wakeup_data;
 
     boost::mutex m_mutex;
 
@@ -84,8 +84,18 @@ void PE::init(int argc, char** args)
 
   if( !is_initialized() && !is_finalized() ) // then initialize
   {
-    MPI_CHECK_RESULT(MPI_Init,(&argc,&args));
+    int provided = MPI_THREAD_SINGLE;
+
+    // the listening thread waits on receives while other threads send
+    MPI_CHECK_RESULT(MPI_Init_thread,(&argc,&args,MPI_THREAD_MULTIPLE,&provided));
     //  CFinfo << "MPI (version " <<  version() << ") -- initiated" << CFendl;
+
+    m_comm = MPI_COMM_WORLD;
+
+    // the communications stay on a single thread, see is_thread_multiple()
+    if( provided < MPI_THREAD_MULTIPLE )
+      CFwarn << "MPI (version " << version() << ") does not support calls from several threads"
+             << " at the same time: the MPI listening thread is disabled" << CFendl;
   }
 
   m_comm = MPI_COMM_WORLD;
@@ -93,6 +103,16 @@ void PE::init(int argc, char** args)
 
 ////////////////////////////////////////////////////////////////////////////////
 
+bool PE::is_thread_multiple() const
+{
+  if ( !is_initialized() || is_finalized() ) return false;
+  int provided = MPI_THREAD_SINGLE;
+  MPI_CHECK_RESULT(MPI_Query_thread,(&provided));
+  return provided == MPI_THREAD_MULTIPLE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void PE::finalize()
 {
   if( is_initialized() && !is_finalized() ) // then finalized
@@ -67,7 +67,7 @@ public:
   /// Returns the MPI version
   std::string version() const;
 
-  /// Initialise the PE
+  /// Initialise the PE, with support for MPI calls from several threads
   /// @post will have a valid state
   void init(int argc=0, char** args=0);
   /// Free the PE, careful because some mpi-s fail upon re-init after a proper finalize
@@ -78,6 +78,9 @@ public:
   bool is_initialized() const;
   /// Checks if the PE is finalized ( this is not the opposite of is_init )
   bool is_finalized() const;
+  /// Checks if MPI may be called from several threads at the same time,
+  /// which the MPI library may not grant even if init() requests it
+  bool is_thread_multiple() const;
   /// Checks if the PE is in valid state
   /// should be initialized and Communicator pointer is set
   bool is_active() const { return is_initialized() && !is_finalized() && is_not_null(m_comm); }
@@ -70,7 +70,7 @@ void PECommPattern::setup(PEObjectWrapper::Ptr gid, std::vector<Uint>& rank)
   // basic check
   BOOST_ASSERT( (Uint)gid->size() == rank.size() );
   if (gid->stride()!=1) throw CF::Common::BadValue(FromHere(),"Data to be registered as gid is not of stride=1.");
-  if (gid->is_data_type_Uint()!=true) throw CF::Common::CastingFailed(FromHere(),"Data to be registered as gid is not of type Uint.");
+  if (gid->is_data_type_Gid()!=true) throw CF::Common::CastingFailed(FromHere(),"Data to be registered as gid is not of type Gid.");
   m_gid=gid;
   m_gid->add_tag("gid_of_"+this->name());
   if (get_child_ptr(gid->name()).get() == nullptr) add_component(gid);
@@ -87,9 +87,9 @@ void PECommPattern::setup(PEObjectWrapper::Ptr gid, std::vector<Uint>& rank)
     m_isUpToDate=false;
     std::vector<int> map(gid->size());
     for(int i=0; i<(int)map.size(); i++) map[i]=i;
-    Uint *igid=(Uint*)gid->pack(map);
+    Gid *igid=(Gid*)gid->pack(map);
     std::vector<Uint>::iterator irank=rank.begin();
-    for (Uint* iigid=igid;irank!=rank.end();irank++,iigid++)
+    for (Gid* iigid=igid;irank!=rank.end();irank++,iigid++)
       add(*iigid,*irank);
     delete[] igid;
     /*
@@ -108,7 +108,7 @@ void PECommPattern::setup(PEObjectWrapper::Ptr gid, boost::multi_array<Uint,1>&
   // basic check
   BOOST_ASSERT( (Uint)gid->size() == rank.size() );
   if (gid->stride()!=1) throw CF::Common::BadValue(FromHere(),"Data to be registered as gid is not of stride=1.");
-  if (gid->is_data_type_Uint()!=true) throw CF::Common::CastingFailed(FromHere(),"Data to be registered as gid is not of type Uint.");
+  if (gid->is_data_type_Gid()!=true) throw CF::Common::CastingFailed(FromHere(),"Data to be registered as gid is not of type Gid.");
   m_gid=gid;
   m_gid->add_tag("gid_of_"+this->name());
   if (get_child_ptr(gid->name()).get() == nullptr) add_component(gid);
@@ -124,9 +124,9 @@ void PECommPattern::setup(PEObjectWrapper::Ptr gid, boost::multi_array<Uint,1>&
     m_isUpToDate=false;
     std::vector<int> map(gid->size());
     for(int i=0; i<(int)map.size(); i++) map[i]=i;
-    Uint *igid=(Uint*)gid->pack(map);
+    Gid *igid=(Gid*)gid->pack(map);
     boost::multi_array<Uint,1>::iterator irank=rank.begin();
-    for (Uint* iigid=igid;irank!=rank.end();irank++,iigid++)
+    for (Gid* iigid=igid;irank!=rank.end();irank++,iigid++)
       add(*iigid,*irank);
     delete[] igid;
 /*
@@ -155,8 +155,8 @@ void PECommPattern::setup()
   const CPint nproc=(CPint)mpi::PE::instance().size();
   if (m_gid.get()==nullptr) throw CF::Common::BadValue(FromHere(),"Gid is not registered for for commpattern: " + name());
   if (m_gid->stride()!=1) throw CF::Common::BadValue(FromHere(),"Gid is not of stride==1 for commpattern: " + name());
-  if (m_gid->is_data_type_Uint()!=true) throw CF::Common::CastingFailed(FromHere(),"Gid is not of type Uint for commpattern: " + name());
-  Uint* gid=(Uint*)m_gid->pack();
+  if (m_gid->is_data_type_Gid()!=true) throw CF::Common::CastingFailed(FromHere(),"Gid is not of type Gid for commpattern: " + name());
+  Gid* gid=(Gid*)m_gid->pack();
   m_isUpdatable.resize(m_gid->size(),true);
 
   // get counts on receive side
@@ -174,7 +174,7 @@ void PECommPattern::setup()
 //PEProcessSortedExecute(-1,PEDebugVector(recvcounter,recvcounter.size()));
 
   // fill receive data and inverse send
-  std::vector<CPint> receive_gids(recvSum);
+  std::vector<Gid> receive_gids(recvSum);
   int lid=0;
   BOOST_FOREACH(temp_buffer_item& i, m_add_buffer)
   {
@@ -193,30 +193,30 @@ void PECommPattern::setup()
 //PEProcessSortedExecute(-1,PEDebugVector(m_recvMap,m_recvMap.size()));
 
   // communicate gids per receive side
-  m_sendMap.resize(0);
-  m_sendMap.reserve(0);
+  std::vector<Gid> send_gids;
   m_sendCount.assign(nproc,-1);
-  mpi::PE::instance().all_to_all(receive_gids,m_recvCount,m_sendMap,m_sendCount);
+  mpi::PE::instance().all_to_all(receive_gids,m_recvCount,send_gids,m_sendCount);
+  m_sendMap.resize(send_gids.size());
 
 //PECheckPoint(100,"-- step 3 --:");
 //PEProcessSortedExecute(-1,PEDebugVector(m_sendCount,m_sendCount.size()));
 //PEProcessSortedExecute(-1,PEDebugVector(m_sendMap,m_sendMap.size()));
 
   // look up the nodes to on send side (brute force searching for now)
-  BOOST_FOREACH(int& si, m_sendMap)
+  for (int s=0; s<(int)send_gids.size(); s++)
   {
     bool found = false;
     for (int i=0; i<m_gid->size(); i++)
     {
-      if (gid[i]==si)
+      if (gid[i]==send_gids[s])
       {
-        si=i;
+        m_sendMap[s]=i;
         found = true;
         break;
       }
     }
     if (found == false)
-      throw ValueNotFound(FromHere(), "requested global id " + to_str(si) + " not found in gid list" );
+      throw ValueNotFound(FromHere(), "requested global id " + to_str(send_gids[s]) + " not found in gid list" );
   }
 
 //PECheckPoint(100,"-- step 4 --:");
@@ -240,8 +240,8 @@ void PECommPattern::setup()
   // get gid and some tests
   if (m_gid.get()==nullptr) throw CF::Common::BadValue(FromHere(),"Gid is not registered for for commpattern: " + name());
   if (m_gid->stride()!=1) throw CF::Common::BadValue(FromHere(),"Gid is not of stride==1 for commpattern: " + name());
-  if (m_gid->is_data_type_Uint()!=true) throw CF::Common::CastingFailed(FromHere(),"Gid is not of type Uint for commpattern: " + name());
-  Uint* gid=(Uint*)m_gid->pack();
+  if (m_gid->is_data_type_Gid()!=true) throw CF::Common::CastingFailed(FromHere(),"Gid is not of type Gid for commpattern: " + name());
+  Gid* gid=(Gid*)m_gid->pack();
 
 //PECheckPoint(100,"-- step 2 --:");
 
@@ -366,7 +366,7 @@ void PECommPattern::synchronize_this( const PEObjectWrapper& pobj )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void PECommPattern::add(Uint gid, Uint rank)
+void PECommPattern::add(Gid gid, Uint rank)
 {
   if (m_isFreeze) throw Common::ShouldNotBeHere(FromHere(),"Wanted to add nodes to commpattern '" + name() + "' which is freezed.");
   m_add_buffer.push_back(temp_buffer_item(gid,rank,false));
@@ -375,7 +375,7 @@ void PECommPattern::add(Uint gid, Uint rank)
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void PECommPattern::move(Uint gid, Uint rank, bool keep_as_ghost)
+void PECommPattern::move(Gid gid, Uint rank, bool keep_as_ghost)
 {
   if (m_isFreeze) throw Common::ShouldNotBeHere(FromHere(),"Wanted to moves nodes of commpattern '" + name() + "' which is freezed.");
   m_mov_buffer.push_back(temp_buffer_item(gid,rank,keep_as_ghost));
@@ -384,7 +384,7 @@ void PECommPattern::move(Uint gid, Uint rank, bool keep_as_ghost)
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void PECommPattern::remove(Uint gid, Uint rank, bool on_all_ranks)
+void PECommPattern::remove(Gid gid, Uint rank, bool on_all_ranks)
 {
   if (m_isFreeze) throw Common::ShouldNotBeHere(FromHere(),"Wanted to delete nodes from commpattern '" + name() + "' which is freezed.");
   m_rem_buffer.push_back(temp_buffer_item(gid,rank,on_all_ranks));
@@ -399,129 +399,3 @@ void PECommPattern::remove(Uint gid, Uint rank, bool on_all_ranks)
 
 } // Common
 } // CF
-
-
-
-
-
-
-
-
-
-
-
-/*
-#include <boost/lambda/lambda.hpp>
-
-#include "Common/MPI/PE.hpp"
-#include "Common/MPI/PECommPattern.hpp"
-#include "Common/MPI/all_to_all.hpp"
-
-////////////////////////////////////////////////////////////////////////////////
-
-using namespace boost::lambda;
-
-namespace CF {
-  namespace Common  {
-
-////////////////////////////////////////////////////////////////////////////////
-
-PECommPattern::PECommPattern()
-{
-  m_isCommPatternPrepared=false;
-  m_sendCount.resize(mpi::PE::instance().size(),0);
-  m_sendMap.resize(0);
-  m_receiveCount.resize(mpi::PE::instance().size(),0);
-  m_receiveMap.resize(0);
-  m_updatable.resize(0);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-PECommPattern::PECommPattern(std::vector<Uint> gid, std::vector<Uint> rank)
-{
-  m_isCommPatternPrepared=false;
-  m_sendCount.resize(mpi::PE::instance().size(),0);
-  m_sendMap.resize(0);
-  m_receiveCount.resize(mpi::PE::instance().size(),0);
-  m_receiveMap.resize(0);
-  m_updatable.resize(0);
-  setup(gid,rank);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-PECommPattern::~PECommPattern()
-{
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void PECommPattern::setup(std::vector<Uint> gid, std::vector<Uint> rank)
-{
-
-  const Uint irank=mpi::PE::instance().rank();
-  const Uint nproc=(Uint)mpi::PE::instance().size();
-
-  assert(gid.size()==rank.size());
-
-  // count how much to send to each process
-  // fill send map directly
-  // and also fill updatable
-  std::vector< std::vector<Uint> > sendmap;
-  m_updatable.resize(gid.size());
-  sendmap.resize(nproc);
-  for(std::vector<Uint>::iterator i=rank.begin(); i < rank.end(); i++){
-    if (*i!=irank){
-      m_sendCount[*i]++;
-      sendmap[*i].push_back(gid[i-rank.begin()]);
-    }
-    m_updatable[i-rank.begin()]=(*i==irank);
-  }
-  for(std::vector< std::vector<Uint> >::iterator i=sendmap.begin(); i < sendmap.end(); i++)
-    for(std::vector<Uint>::iterator j=i->begin(); j < i->end(); j++)
-      m_sendMap.push_back(*j);
-
-  // fill receive count
-  boost::mpi::all_to_all(mpi::PE::instance(),m_sendCount,m_receiveCount);
-
-  // fill receive map
-  Uint total_m_receiveCount=0;
-  for(Uint i=0; i<nproc; i++)
-    total_m_receiveCount+=m_receiveCount[i];
-
-  m_receiveMap.resize(total_m_receiveCount);
-  std::vector< int > rcvdisp(nproc,0);
-
-  for(Uint i=1; i<nproc; i++)
-    rcvdisp[i]=rcvdisp[i-1]+m_receiveCount[i-1];
-
-  for(Uint i=0; i<nproc; i++)
-    MPI_Gatherv(&(sendmap[i])[0], sendmap[i].size(), MPI_INT, &m_receiveMap[0], &m_receiveCount[0], &rcvdisp[0], MPI_INT, i, mpi::PE::instance());
-
-  std::cout << "m_updatable: ";
-  std::for_each(m_updatable.begin(), m_updatable.end(), std::cout << _1 << ' ');
-  std::cout << "\n" << std::flush;
-
-  std::cout << "m_sendCount: ";
-  std::for_each(m_sendCount.begin(), m_sendCount.end(), std::cout << _1 << ' ');
-  std::cout << "\n" << std::flush;
-
-  std::cout << "m_sendMap: ";
-  std::for_each(m_sendMap.begin(), m_sendMap.end(), std::cout << _1 << ' ');
-  std::cout << "\n" << std::flush;
-
-  std::cout << "m_receiveCount: ";
-  std::for_each(m_receiveCount.begin(), m_receiveCount.end(), std::cout << _1 << ' ');
-  std::cout << "\n" << std::flush;
-
-  std::cout << "m_receiveMap: ";
-  std::for_each(m_receiveMap.begin(), m_receiveMap.end(), std::cout << _1 << ' ');
-  std::cout << "\n" << std::flush;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-  }  // Common
-} // CF
-*/
@@ -39,7 +39,7 @@ namespace Common {
   @todo when adding, how to give values to the newly createable elements?
   @todo add readonly properties (for example for coordinates, you want to keep it synchronous with commpattern but don't actually want to update it every time)
   @todo propagate CPint through mpiwrapper
-  @todo gid registration: must be more straightforward to check if its really a CFuint single stride data
+  @todo gid registration: must be more straightforward to check if its really a Gid single stride data
   @todo introduce allocate_component
 **/
 
@@ -60,7 +60,7 @@ public:
   /// typedef for the temporary buffer
   class temp_buffer_item{
     public:
-      temp_buffer_item(Uint _gid, Uint _rank, bool _option)
+      temp_buffer_item(Gid _gid, Uint _rank, bool _option)
       {
         gid=_gid;
         rank=(CPint)_rank;
@@ -68,11 +68,11 @@ public:
       }
       temp_buffer_item()
       {
-        gid= std::numeric_limits<Uint>::max();
+        gid= std::numeric_limits<Gid>::max();
         rank=std::numeric_limits<CPint>::max();
         option=false;
       }
-      Uint gid;
+      Gid gid;
       CPint rank;
       bool option;
   };
@@ -80,7 +80,7 @@ public:
   typedef std::vector<temp_buffer_item> temp_buffer_array;
   /// helper struct for setup function
   struct dist_struct {
-    Uint  gid;    // global id of the item
+    Gid   gid;    // global id of the item
     CPint rank;   // rank where the item is
     CPint lid;    // local id on that rank
     void *data;   // packed data if it needs to be moved along procs, otherwise nullptr
@@ -165,9 +165,9 @@ public:
   /// @param name the component will appear under this name
   /// @param std::vector of data
   /// @param stride number of array element grouping
-  template<typename T> void insert(const std::string& name, boost::multi_array<T,2>& data, const bool needs_update=true)
+  template<typename T, typename AllocatorT> void insert(const std::string& name, boost::multi_array<T,2,AllocatorT>& data, const bool needs_update=true)
   {
-    PEObjectWrapperMultiArray<T,2>& ow = create_component< PEObjectWrapperMultiArray<T,2> >(name);
+    PEObjectWrapperMultiArray<T,2,AllocatorT>& ow = create_component< PEObjectWrapperMultiArray<T,2,AllocatorT> >(name);
     ow.setup(data,needs_update);
   }
 
@@ -175,9 +175,9 @@ public:
   /// @param name the component will appear under this name
   /// @param std::vector of data
   /// @param stride number of array element grouping
-  template<typename T> void insert(const std::string& name, boost::multi_array<T,1>& data, const bool needs_update=true)
+  template<typename T, typename AllocatorT> void insert(const std::string& name, boost::multi_array<T,1,AllocatorT>& data, const bool needs_update=true)
   {
-    PEObjectWrapperMultiArray<T,1>& ow = create_component< PEObjectWrapperMultiArray<T,1> >(name);
+    PEObjectWrapperMultiArray<T,1,AllocatorT>& ow = create_component< PEObjectWrapperMultiArray<T,1,AllocatorT> >(name);
     ow.setup(data,needs_update);
   }
 
@@ -198,7 +198,7 @@ public:
   /// this function sets actually up the communication pattern
   /// beware: interprocess communication heavy
   /// this overload of setup is designed for making no callback functions, so all the registered data should match the size of current size + number of additions
-  /// @param gid PEObjectWrapper to a Uint tpye of data array
+  /// @param gid PEObjectWrapper to a Gid tpye of data array
   /// @param rank vector of ranks where given global ids are updatable to add
   void setup(PEObjectWrapper::Ptr gid, std::vector<Uint>& rank);
 
@@ -206,7 +206,7 @@ public:
   /// this function sets actually up the communication pattern
   /// beware: interprocess communication heavy
   /// this overload of setup is designed for making no callback functions, so all the registered data should match the size of current size + number of additions
-  /// @param gid PEObjectWrapper to a Uint tpye of data array
+  /// @param gid PEObjectWrapper to a Gid tpye of data array
   /// @param rank vector of ranks where given global ids are updatable to add
   void setup(PEObjectWrapper::Ptr gid, boost::multi_array<Uint,1>& rank);
 
@@ -228,7 +228,7 @@ public:
   /// @param gid global id
   /// @param rank rank where given global node is to be updatable
   /// @see setup for committing changes
-  void add(Uint gid, Uint rank);
+  void add(Gid gid, Uint rank);
 
   /// move element along partitions
   /// when all changes done, all needs to be committed by calling setup
@@ -236,7 +236,7 @@ public:
   /// @param rank rank where the node is expected to be updatable
   /// @param keep_as_ghost decision if node to be kept on from_rank as ghost
   /// @see setup for committing changes
-  void move(Uint gid, Uint rank, bool keep_as_ghost=true);
+  void move(Gid gid, Uint rank, bool keep_as_ghost=true);
 
   /// delete element from the commpattern
   /// when all changes done, all needs to be committed by calling setup
@@ -244,7 +244,7 @@ public:
   /// @param rank if on_all_ranks is true, its a complete removal. If its false then depends if node is ghost or updatable on rank and deletes only on this rank or all ranks respectively
   /// @param on_all_ranks force delete on all processes if true
   /// @see setup for committing changes
-  void remove(Uint gid, Uint rank, bool on_all_ranks=false);
+  void remove(Gid gid, Uint rank, bool on_all_ranks=false);
 
   //@} END COMMPATTERN HANDLING
 
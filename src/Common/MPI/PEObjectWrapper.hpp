@@ -83,10 +83,14 @@ class Common_API PEObjectWrapper : public Component {
     /// @return number of items to be treated as one
     virtual int stride() const = 0;
 
-    /// Check for Uint, necessary for cheking type of gid in commpattern
+    /// Check for Uint
     /// @return true or false depending if registered data's type was Uint or not
     virtual bool is_data_type_Uint() const = 0;
 
+    /// Check for Gid, the type of the gid in commpattern
+    /// @return true or false depending if registered data's type was Gid or not
+    virtual bool is_data_type_Gid() const = 0;
+
     /// accessor to lag telling if wrapped data needs to be synchronized,
     /// if not then it will only be modified if commpattern changes (for example coordinates of a mesh)
     /// @return true or false depending if to be synchronized
@@ -226,10 +230,14 @@ template<typename T> class PEObjectWrapperPtr: public PEObjectWrapper{
     /// @return number of items to be treated as one
     int stride() const { return m_stride; };
 
-    /// Check for Uint, necessary for cheking type of gid in commpattern
+    /// Check for Uint
     /// @return true or false depending if registered data's type was Uint or not
     bool is_data_type_Uint() const { return boost::is_same<T,Uint>::value; };
 
+    /// Check for Gid, necessary for cheking type of gid in commpattern
+    /// @return true or false depending if registered data's type was Gid or not
+    bool is_data_type_Gid() const { return boost::is_same<T,Gid>::value; };
+
   private:
 
     /// holder of the pointer
@@ -357,10 +365,14 @@ template<typename T> class PEObjectWrapperVector: public PEObjectWrapper{
     /// @return number of items to be treated as one
     int stride() const { return m_stride; }
 
-    /// Check for Uint, necessary for cheking type of gid in commpattern
+    /// Check for Uint
     /// @return true or false depending if registered data's type was Uint or not
     bool is_data_type_Uint() const { return boost::is_same<T,Uint>::value; }
 
+    /// Check for Gid, necessary for cheking type of gid in commpattern
+    /// @return true or false depending if registered data's type was Gid or not
+    bool is_data_type_Gid() const { return boost::is_same<T,Gid>::value; }
+
   private:
 
     /// pointer to std::vector
@@ -479,10 +491,14 @@ template<typename T> class PEObjectWrapperVectorWeakPtr: public PEObjectWrapper{
     /// @return number of items to be treated as one
     int stride() const { return m_stride; };
 
-    /// Check for Uint, necessary for cheking type of gid in commpattern
+    /// Check for Uint
     /// @return true or false depending if registered data's type was Uint or not
     bool is_data_type_Uint() const { return boost::is_same<T,Uint>::value; }
 
+    /// Check for Gid, necessary for cheking type of gid in commpattern
+    /// @return true or false depending if registered data's type was Gid or not
+    bool is_data_type_Gid() const { return boost::is_same<T,Gid>::value; }
+
   private:
 
     /// pointer to std::vector
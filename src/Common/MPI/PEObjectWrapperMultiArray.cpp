@@ -17,13 +17,21 @@ namespace Common {
 //////////////////////////////////////////////////////////////////////////////
 
 ComponentBuilder < PEObjectWrapperMultiArray<Uint,1>, PEObjectWrapper, LibCommon > PEObjectWrapperMultiArray_Uint_1_builder;
+ComponentBuilder < PEObjectWrapperMultiArray<Gid,1>, PEObjectWrapper, LibCommon > PEObjectWrapperMultiArray_Gid_1_builder;
 ComponentBuilder < PEObjectWrapperMultiArray<int,1>,  PEObjectWrapper, LibCommon > PEObjectWrapperMultiArray_int_1_builder;
 ComponentBuilder < PEObjectWrapperMultiArray<Real,1>, PEObjectWrapper, LibCommon > PEObjectWrapperMultiArray_Real_1_builder;
+#ifndef CF_REAL_IS_FLOAT
+ComponentBuilder < PEObjectWrapperMultiArray<float,1>, PEObjectWrapper, LibCommon > PEObjectWrapperMultiArray_float_1_builder;
+#endif
 //ComponentBuilder < PEObjectWrapperMultiArray<bool,1>, PEObjectWrapper, LibCommon > PEObjectWrapperMultiArray_bool_1_builder;
 
 ComponentBuilder < PEObjectWrapperMultiArray<Uint,2>, PEObjectWrapper, LibCommon > PEObjectWrapperMultiArray_Uint_2_builder;
+ComponentBuilder < PEObjectWrapperMultiArray<Gid,2>, PEObjectWrapper, LibCommon > PEObjectWrapperMultiArray_Gid_2_builder;
 ComponentBuilder < PEObjectWrapperMultiArray<int,2>,  PEObjectWrapper, LibCommon > PEObjectWrapperMultiArray_int_2_builder;
 ComponentBuilder < PEObjectWrapperMultiArray<Real,2>, PEObjectWrapper, LibCommon > PEObjectWrapperMultiArray_Real_2_builder;
+#ifndef CF_REAL_IS_FLOAT
+ComponentBuilder < PEObjectWrapperMultiArray<float,2>, PEObjectWrapper, LibCommon > PEObjectWrapperMultiArray_float_2_builder;
+#endif
 //ComponentBuilder < PEObjectWrapperMultiArray<bool,2>, PEObjectWrapper, LibCommon > PEObjectWrapperMultiArray_bool_2_builder;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -9,6 +9,8 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <memory>
+
 #include <boost/type_traits/is_pod.hpp>
 #include <boost/type_traits/is_same.hpp>
 
@@ -24,8 +26,10 @@ namespace Common  {
 ////////////////////////////////////////////////////////////////////////////////
 
 /// Wrapper class for CTable components
+/// The allocator of the array is a template parameter, so that both the arrays
+/// with the standard allocator and the tables of the mesh can be wrapped.
 /// @author Willem Deconinck
-template <typename T, std::size_t NumDims>
+template <typename T, std::size_t NumDims, typename AllocatorT = std::allocator<T> >
 class PEObjectWrapperMultiArray: public PEObjectWrapper
 {
 
@@ -38,8 +42,8 @@ class PEObjectWrapperMultiArray: public PEObjectWrapper
 
 };
 
-template <typename T>
-class PEObjectWrapperMultiArray<T,1>: public PEObjectWrapper{
+template <typename T, typename AllocatorT>
+class PEObjectWrapperMultiArray<T,1,AllocatorT>: public PEObjectWrapper{
 
   public:
 
@@ -61,7 +65,7 @@ class PEObjectWrapperMultiArray<T,1>: public PEObjectWrapper{
     /// setup of passing by reference
     /// @param std::vector of data
     /// @param stride number of array element grouping
-    void setup(boost::multi_array<T,1>& data, const bool needs_update)
+    void setup(boost::multi_array<T,1,AllocatorT>& data, const bool needs_update)
     {
       if (boost::is_pod<T>::value==false) throw CF::Common::BadValue(FromHere(),name()+": Data is not POD (plain old datatype).");
       m_data=&data;
@@ -143,20 +147,24 @@ class PEObjectWrapperMultiArray<T,1>: public PEObjectWrapper{
     /// @return number of items to be treated as one
     int stride() const { return m_stride; }
 
-    /// Check for Uint, necessary for cheking type of gid in commpattern
+    /// Check for Uint
     /// @return true or false depending if registered data's type was Uint or not
     bool is_data_type_Uint() const { return boost::is_same<T,Uint>::value; }
 
+    /// Check for Gid, necessary for cheking type of gid in commpattern
+    /// @return true or false depending if registered data's type was Gid or not
+    bool is_data_type_Gid() const { return boost::is_same<T,Gid>::value; }
+
   private:
 
     /// pointer to std::vector
-    boost::multi_array<T,1>* m_data;
+    boost::multi_array<T,1,AllocatorT>* m_data;
 };
 
 //////////////////////////////////////////////////////////////////////////////
 
-template <typename T>
-class PEObjectWrapperMultiArray<T,2>: public PEObjectWrapper{
+template <typename T, typename AllocatorT>
+class PEObjectWrapperMultiArray<T,2,AllocatorT>: public PEObjectWrapper{
 
   public:
 
@@ -177,7 +185,7 @@ class PEObjectWrapperMultiArray<T,2>: public PEObjectWrapper{
     /// setup of passing by reference
     /// @param std::vector of data
     /// @param stride number of array element grouping
-    void setup(boost::multi_array<T,2>& data, const bool needs_update)
+    void setup(boost::multi_array<T,2,AllocatorT>& data, const bool needs_update)
     {
       if (boost::is_pod<T>::value==false) throw CF::Common::BadValue(FromHere(),name()+": Data is not POD (plain old datatype).");
       m_data=&data;
@@ -260,14 +268,18 @@ class PEObjectWrapperMultiArray<T,2>: public PEObjectWrapper{
     /// @return number of items to be treated as one
     int stride() const { return m_stride; }
 
-    /// Check for Uint, necessary for cheking type of gid in commpattern
+    /// Check for Uint
     /// @return true or false depending if registered data's type was Uint or not
     bool is_data_type_Uint() const { return boost::is_same<T,Uint>::value; }
 
+    /// Check for Gid, necessary for cheking type of gid in commpattern
+    /// @return true or false depending if registered data's type was Gid or not
+    bool is_data_type_Gid() const { return boost::is_same<T,Gid>::value; }
+
   private:
 
     /// pointer to std::vector
-    boost::multi_array<T,2>* m_data;
+    boost::multi_array<T,2,AllocatorT>* m_data;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
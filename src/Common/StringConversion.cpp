@@ -4,6 +4,8 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include <climits>
+
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/compare.hpp>
@@ -40,6 +42,15 @@ namespace Common {
     return boost::lexical_cast<std::string>(v);
   }
 
+#if ULONG_MAX == 0xffffffffUL
+  // Gid is not unsigned long where long is 32 bit
+  template <>
+  Common_API std::string to_str<Gid> (const Gid & v)
+  {
+    return boost::lexical_cast<std::string>(v);
+  }
+#endif
+
   template <>
   Common_API std::string to_str<Uint> (const Uint & v)
   {
@@ -219,6 +230,14 @@ namespace Common {
     return boost::lexical_cast<unsigned long> ( str );
   }
 
+#if ULONG_MAX == 0xffffffffUL
+  template <>
+  Common_API Gid from_str<Gid> (const std::string& str)
+  {
+    return boost::lexical_cast<Gid> ( str );
+  }
+#endif
+
   template <>
   Common_API Uint from_str<Uint> (const std::string& str)
   {
@@ -0,0 +1,204 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <boost/bind.hpp>
+
+#include "Common/BasicExceptions.hpp"
+#include "Common/ThreadPool.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Common {
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Executes a range task on a chunk, adapting it to a task
+void execute_chunk(const ThreadPool::RangeTask& task, const Uint begin, const Uint end, const Uint thread)
+{
+  task(begin,end,thread);
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+ThreadPool::ThreadPool() :
+  m_nb_threads(1),
+  m_nb_busy(0),
+  m_stop(false)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ThreadPool::~ThreadPool()
+{
+  join();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ThreadPool& ThreadPool::instance()
+{
+  static ThreadPool thread_pool;
+  return thread_pool;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::set_nb_threads(const Uint nb_threads)
+{
+  const Uint new_nb_threads = nb_threads ? nb_threads : std::max(1u, boost::thread::hardware_concurrency());
+  if (new_nb_threads == m_nb_threads)
+    return;
+
+  if (in_task())
+    throw SetupError(FromHere(), "The number of threads cannot be changed from within a task");
+
+  boost::lock_guard<boost::mutex> caller(m_caller_mutex);
+  join();
+
+  m_nb_threads = new_nb_threads;
+  m_stop = false;
+  if (m_nb_threads > 1)
+  {
+    m_threads.resize(m_nb_threads);
+    for (Uint thread=0; thread<m_nb_threads; ++thread)
+      m_threads[thread] = new boost::thread( boost::bind(&ThreadPool::work, this, thread) );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::join()
+{
+  {
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_task_queued.notify_all();
+
+  for (Uint thread=0; thread<m_threads.size(); ++thread)
+  {
+    m_threads[thread]->join();
+    delete m_threads[thread];
+  }
+  m_threads.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Uint ThreadPool::thread_idx() const
+{
+  const boost::thread::id id = boost::this_thread::get_id();
+  for (Uint thread=0; thread<m_threads.size(); ++thread)
+    if (m_threads[thread]->get_id() == id)
+      return thread;
+  return m_nb_threads;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::work(const Uint thread)
+{
+  for(;;)
+  {
+    Task task;
+    {
+      boost::unique_lock<boost::mutex> lock(m_mutex);
+      while (m_tasks.empty() && !m_stop)
+        m_task_queued.wait(lock);
+      if (m_tasks.empty())
+        return;
+
+      task = m_tasks.front();
+      m_tasks.pop_front();
+      ++m_nb_busy;
+    }
+
+    std::string error;
+    try
+    {
+      task(thread);
+    }
+    catch (std::exception& e)
+    {
+      error = e.what();
+    }
+    catch (...)
+    {
+      error = "unknown exception";
+    }
+
+    {
+      boost::lock_guard<boost::mutex> lock(m_mutex);
+      if (!error.empty() && m_error.empty())
+        m_error = error;
+      --m_nb_busy;
+      if (m_tasks.empty() && m_nb_busy == 0)
+        m_tasks_done.notify_all();
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::parallel_for(const Uint begin, const Uint end, const RangeTask& task, const Uint chunk_size)
+{
+  if (begin >= end)
+    return;
+
+  // serial execution, within a task, or by the calling thread if the pool
+  // has no threads or is busy with the parallel_for() of another thread
+
+  const Uint thread = thread_idx();
+  if (thread != m_nb_threads)
+  {
+    task(begin,end,thread);
+    return;
+  }
+
+  boost::unique_lock<boost::mutex> caller(m_caller_mutex, boost::try_to_lock);
+  if (m_threads.empty() || !caller.owns_lock())
+  {
+    task(begin,end,0u);
+    return;
+  }
+
+  // a few chunks per thread, so that threads finishing early can take over some work
+
+  const Uint nb_indices = end - begin;
+  const Uint chunk = chunk_size ? chunk_size : std::max(1u, nb_indices / (4*m_nb_threads));
+
+  {
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+    m_error.clear();
+    for (Uint b=begin; b<end; b+=chunk)
+      m_tasks.push_back( boost::bind(&execute_chunk, boost::cref(task), b, std::min(end,b+chunk), _1) );
+  }
+  m_task_queued.notify_all();
+
+  std::string error;
+  {
+    boost::unique_lock<boost::mutex> lock(m_mutex);
+    while (!m_tasks.empty() || m_nb_busy)
+      m_tasks_done.wait(lock);
+    error.swap(m_error);
+  }
+
+  if (!error.empty())
+    throw ParallelError(FromHere(), "A thread failed: " + error);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Common
+} // CF
+
+////////////////////////////////////////////////////////////////////////////////
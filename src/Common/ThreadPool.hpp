@@ -0,0 +1,136 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Common_ThreadPool_hpp
+#define CF_Common_ThreadPool_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <deque>
+#include <vector>
+
+#include <boost/function.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include "Common/CommonAPI.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Common {
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Pool of threads executing tasks within a process.
+///
+/// The loops over the mesh use it to share their iterations among the threads,
+/// so that a process can use all the cores it runs on, next to the distribution
+/// of the mesh over the processes with MPI. The number of threads is set with
+/// the option "nb_threads" of the environment (CEnv), and defaults to one, in
+/// which case the tasks are executed by the calling thread.
+///
+/// Every task receives the index of the thread executing it, in [0,nb_threads()[,
+/// to select data that is private to the thread.
+/// @note MPI may only be called by the main thread, not from within a task.
+class Common_API ThreadPool : public boost::noncopyable
+{
+public: // typedefs
+
+  /// Task, taking the index of the thread that executes it
+  typedef boost::function< void (Uint) > Task;
+
+  /// Task on a range [begin,end[, taking the index of the thread that executes it
+  typedef boost::function< void (Uint, Uint, Uint) > RangeTask;
+
+public: // functions
+
+  /// Constructor, without threads
+  ThreadPool();
+
+  /// Destructor, joins the threads
+  ~ThreadPool();
+
+  /// Gets the instance of the pool
+  static ThreadPool& instance();
+
+  /// @return the number of threads executing the tasks
+  Uint nb_threads() const { return m_nb_threads; }
+
+  /// Sets the number of threads executing the tasks
+  /// @param nb_threads the number of threads, 0 for the number of cores
+  void set_nb_threads(const Uint nb_threads);
+
+  /// @return true if the calling thread is one of the threads of the pool, executing a task
+  bool in_task() const { return thread_idx() != m_nb_threads; }
+
+  /// Executes a task on the range [begin,end[, split in chunks shared among the threads.
+  /// Returns when all the chunks are executed. The first exception raised by a
+  /// chunk is thrown again as a ParallelError.
+  /// A parallel_for() called from within a task executes serially, in that task.
+  /// The pool executes the chunks of one parallel_for() at a time: a call from another
+  /// thread while the pool is busy also executes serially, in the calling thread.
+  /// @param begin      first index of the range
+  /// @param end        one past the last index of the range
+  /// @param task       the task executed on every chunk [b,e[ as task(b,e,thread)
+  /// @param chunk_size number of indices in a chunk, 0 to let the pool choose
+  void parallel_for(const Uint begin, const Uint end, const RangeTask& task, const Uint chunk_size = 0);
+
+private: // functions
+
+  /// Loop of a thread, executing the queued tasks
+  void work(const Uint thread);
+
+  /// Stops and joins the threads
+  void join();
+
+  /// @return the index of the calling thread in the pool, or nb_threads() if it is not in the pool
+  Uint thread_idx() const;
+
+private: // data
+
+  /// number of threads executing the tasks
+  Uint m_nb_threads;
+
+  /// the threads of the pool, none if m_nb_threads is 1
+  std::vector< boost::thread* > m_threads;
+
+  /// queued tasks
+  std::deque< Task > m_tasks;
+
+  /// number of tasks being executed
+  Uint m_nb_busy;
+
+  /// set to stop the threads
+  bool m_stop;
+
+  /// message of the first exception raised by a task
+  std::string m_error;
+
+  /// protects the queue and the counters
+  boost::mutex m_mutex;
+
+  /// held by the thread that shares a parallel_for() among the threads,
+  /// or changes their number
+  boost::mutex m_caller_mutex;
+
+  /// signals queued tasks to the threads
+  boost::condition_variable m_task_queued;
+
+  /// signals the completion of all the tasks
+  boost::condition_variable m_tasks_done;
+
+}; // ThreadPool
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Common
+} // CF
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_Common_ThreadPool_hpp
@@ -49,9 +49,13 @@ TypeInfo::TypeInfo()
 {
   regist<int>("integer");
   regist<CF::Uint>("unsigned");
+  regist<CF::Gid>("gid");
   regist<std::string>("string");
   regist<bool>("bool");
   regist<CF::Real>("real");
+#ifndef CF_REAL_IS_FLOAT
+  regist<float>("single");
+#endif
   regist<Common::URI>("uri");
   regist<std::vector<int> >("array[integer]");
   regist<std::vector<Uint> >("array[unsigned]");
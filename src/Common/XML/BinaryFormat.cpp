@@ -0,0 +1,308 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <cstring>
+#include <map>
+#include <vector>
+
+#include "rapidxml/rapidxml.hpp"
+
+#include "Common/Assertions.hpp"
+#include "Common/BasicExceptions.hpp"
+
+#include "Common/XML/BinaryFormat.hpp"
+
+/////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Common {
+namespace XML {
+
+/////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// marker put at the beginning of each binary frame (format version 1)
+const char binary_marker[] = { 'C', 'F', 'B', 1 };
+
+/// number of bytes of the marker
+const std::size_t binary_marker_size = sizeof(binary_marker);
+
+/////////////////////////////////////////////////////////////////////////////
+
+/// Helper that builds the string table and the node stream
+class BinaryWriter
+{
+public:
+
+  BinaryWriter() { index(""); } // index 0 is the empty string
+
+  Uint index ( const char * str, std::size_t size )
+  {
+    const std::string key(str, size);
+    std::map<std::string, Uint>::iterator it = m_indexes.find(key);
+
+    if( it != m_indexes.end() )
+      return it->second;
+
+    const Uint idx = m_strings.size();
+    m_indexes[key] = idx;
+    m_strings.push_back(key);
+    return idx;
+  }
+
+  Uint index ( const std::string& str ) { return index(str.c_str(), str.size()); }
+
+  void write_node ( const rapidxml::xml_node<>& node )
+  {
+    write_uint( node.type() );
+    write_uint( index( node.name(), node.name_size() ) );
+    write_uint( index( node.value(), node.value_size() ) );
+
+    Uint nb_attrs = 0;
+    for( rapidxml::xml_attribute<>* attr = node.first_attribute() ; attr != nullptr ; attr = attr->next_attribute() )
+      ++nb_attrs;
+
+    write_uint( nb_attrs );
+
+    for( rapidxml::xml_attribute<>* attr = node.first_attribute() ; attr != nullptr ; attr = attr->next_attribute() )
+    {
+      write_uint( index( attr->name(), attr->name_size() ) );
+      write_uint( index( attr->value(), attr->value_size() ) );
+    }
+
+    Uint nb_children = 0;
+    for( rapidxml::xml_node<>* child = node.first_node() ; child != nullptr ; child = child->next_sibling() )
+      ++nb_children;
+
+    write_uint( nb_children );
+
+    for( rapidxml::xml_node<>* child = node.first_node() ; child != nullptr ; child = child->next_sibling() )
+      write_node( *child );
+  }
+
+  void finish ( std::string& buffer ) const
+  {
+    buffer.assign( binary_marker, binary_marker_size );
+
+    write_uint( m_strings.size(), buffer );
+
+    std::vector<std::string>::const_iterator it = m_strings.begin();
+    for( ; it != m_strings.end() ; ++it )
+    {
+      write_uint( it->size(), buffer );
+      buffer.append( *it );
+    }
+
+    buffer.append( m_stream );
+  }
+
+private:
+
+  /// writes an unsigned integer as a variable length quantity (7 bits per byte)
+  static void write_uint ( std::size_t value, std::string& out )
+  {
+    while( value >= 0x80 )
+    {
+      out.push_back( static_cast<char>( (value & 0x7F) | 0x80 ) );
+      value >>= 7;
+    }
+    out.push_back( static_cast<char>(value) );
+  }
+
+  void write_uint ( std::size_t value ) { write_uint( value, m_stream ); }
+
+  std::map<std::string, Uint> m_indexes;
+  std::vector<std::string> m_strings;
+  std::string m_stream;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/// Helper that rebuilds a rapidxml tree from a binary frame
+class BinaryReader
+{
+public:
+
+  BinaryReader ( const char * data, std::size_t length, rapidxml::xml_document<>& doc ) :
+    m_pos(data + binary_marker_size),
+    m_end(data + length),
+    m_doc(doc)
+  {
+    const Uint nb_strings = read_uint();
+
+    m_strings.reserve(nb_strings);
+
+    for( Uint i = 0 ; i < nb_strings ; ++i )
+    {
+      const Uint size = read_uint();
+
+      if( std::size_t(m_end - m_pos) < size )
+        throw XmlError(FromHere(), "Binary frame is truncated (string table).");
+
+      // strings are copied to the document memory pool and null-terminated
+      char * str = m_doc.allocate_string( nullptr, size + 1 );
+      std::memcpy( str, m_pos, size );
+      str[size] = '\0';
+
+      m_strings.push_back( std::make_pair(str, size) );
+      m_pos += size;
+    }
+  }
+
+  void read_children ( rapidxml::xml_node<>& parent )
+  {
+    const Uint type = read_uint();
+
+    if( type != rapidxml::node_document )
+    {
+      // a single node was written, it becomes the only child of the document
+      parent.append_node( read_node(type) );
+      return;
+    }
+
+    read_string(); // document name
+    read_string(); // document value
+
+    if( read_uint() != 0 )
+      throw XmlError(FromHere(), "Binary frame is corrupted (document attributes).");
+
+    const Uint nb_children = read_uint();
+
+    for( Uint i = 0 ; i < nb_children ; ++i )
+      parent.append_node( read_node( read_uint() ) );
+  }
+
+  bool at_end () const { return m_pos == m_end; }
+
+private:
+
+  rapidxml::xml_node<>* read_node ( const Uint type )
+  {
+    if( type > rapidxml::node_pi || type == rapidxml::node_document )
+      throw XmlError(FromHere(), "Binary frame is corrupted (invalid node type).");
+
+    const std::pair<char*, Uint>& name = read_string();
+    const std::pair<char*, Uint>& value = read_string();
+
+    rapidxml::xml_node<>* node = m_doc.allocate_node( static_cast<rapidxml::node_type>(type),
+                                                      name.first, value.first,
+                                                      name.second, value.second );
+
+    const Uint nb_attrs = read_uint();
+
+    for( Uint i = 0 ; i < nb_attrs ; ++i )
+    {
+      const std::pair<char*, Uint>& attr_name = read_string();
+      const std::pair<char*, Uint>& attr_value = read_string();
+
+      node->append_attribute( m_doc.allocate_attribute( attr_name.first, attr_value.first,
+                                                        attr_name.second, attr_value.second ) );
+    }
+
+    const Uint nb_children = read_uint();
+
+    for( Uint i = 0 ; i < nb_children ; ++i )
+      node->append_node( read_node( read_uint() ) );
+
+    return node;
+  }
+
+  const std::pair<char*, Uint>& read_string ()
+  {
+    const Uint idx = read_uint();
+
+    if( idx >= m_strings.size() )
+      throw XmlError(FromHere(), "Binary frame is corrupted (invalid string index).");
+
+    return m_strings[idx];
+  }
+
+  Uint read_uint ()
+  {
+    Uint value = 0;
+    Uint shift = 0;
+
+    while( true )
+    {
+      if( m_pos == m_end )
+        throw XmlError(FromHere(), "Binary frame is truncated.");
+
+      if( shift > 28 )
+        throw XmlError(FromHere(), "Binary frame is corrupted (integer overflow).");
+
+      const unsigned char byte = static_cast<unsigned char>(*m_pos++);
+      value |= Uint(byte & 0x7F) << shift;
+
+      if( (byte & 0x80) == 0 )
+        return value;
+
+      shift += 7;
+    }
+  }
+
+  const char * m_pos;
+  const char * m_end;
+  rapidxml::xml_document<>& m_doc;
+  std::vector< std::pair<char*, Uint> > m_strings;
+};
+
+} // anonymous namespace
+
+/////////////////////////////////////////////////////////////////////////////
+
+void to_binary ( const XmlNode& node, std::string& buffer )
+{
+  cf_assert( node.is_valid() );
+
+  BinaryWriter writer;
+
+  writer.write_node( *node.content );
+  writer.finish( buffer );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+bool is_binary_frame ( const char * data, std::size_t length )
+{
+  cf_assert( is_not_null(data) );
+
+  return length >= binary_marker_size &&
+      std::memcmp( data, binary_marker, binary_marker_size ) == 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+XmlDoc::Ptr parse_binary ( const char * data, std::size_t length )
+{
+  if( !is_binary_frame(data, length) )
+    throw XmlError(FromHere(), "The buffer is not a binary frame.");
+
+  rapidxml::xml_document<>* xmldoc = new rapidxml::xml_document<>();
+
+  try
+  {
+    BinaryReader reader( data, length, *xmldoc );
+
+    reader.read_children( *xmldoc );
+
+    if( !reader.at_end() )
+      throw XmlError(FromHere(), "Binary frame has trailing data.");
+  }
+  catch(...)
+  {
+    delete xmldoc;
+    throw;
+  }
+
+  return XmlDoc::Ptr( new XmlDoc(xmldoc) );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+} // XML
+} // Common
+} // CF
@@ -0,0 +1,53 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Common_XML_BinaryFormat_hpp
+#define CF_Common_XML_BinaryFormat_hpp
+
+////////////////////////////////////////////////////////////////////////////
+
+#include "Common/XML/XmlDoc.hpp"
+
+/////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Common {
+namespace XML {
+
+/// @file BinaryFormat.hpp
+/// Compact binary representation of XML trees, used as an alternative to the
+/// text format when sending frames over the network. @n
+/// All node names, attribute names and values are stored once in a string
+/// table and referred to by index, so that the repetitive content of
+/// component trees (type names, modes, option tags) costs only a few bytes
+/// per occurrence. Integers are stored as variable length quantities.
+
+/// Writes the provided XML node to a binary buffer.
+/// @param node The node to write. If it is a document, all its children are
+/// written.
+/// @param buffer The string to which the binary frame has to be written.
+void to_binary ( const XmlNode& node, std::string& buffer );
+
+/// Checks whether a buffer holds a binary frame
+/// @param data The buffer, cannot be null.
+/// @param length The length of the buffer
+/// @return Returns @c true if the buffer starts with the binary frame marker.
+bool is_binary_frame ( const char * data, std::size_t length );
+
+/// Parses a binary frame built with @c #to_binary()
+/// @param data The buffer, cannot be null.
+/// @param length The length of the buffer
+/// @return Returns a shared pointer with the built XML document.
+/// @throw XmlError If the buffer is not a valid binary frame.
+XmlDoc::Ptr parse_binary ( const char * data, std::size_t length );
+
+} // XML
+} // Common
+} // CF
+
+////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_Common_XML_BinaryFormat_hpp
@@ -30,7 +30,7 @@ namespace XML {
 ////////////////////////////////////////////////////////////////////////////
 
 XmlNode add_multi_array_in( Map & map, const std::string & name,
-                            const boost::multi_array<Real, 2> & array,
+                            const boost::const_multi_array_ref<Real, 2> & array,
                             const std::string & delimiter,
                             const std::vector<std::string> & labels )
 {
@@ -22,8 +22,9 @@ namespace XML {
 ////////////////////////////////////////////////////////////////////////////
 
 /// Adds a multi array in the provided @c Map
+/// Any multi array of reals can be given, whatever its allocator.
 XmlNode add_multi_array_in(Map & map, const std::string & name,
-                           const boost::multi_array<Real, 2> & array,
+                           const boost::const_multi_array_ref<Real, 2> & array,
                            const std::string & delimiter = ";",
                            const std::vector<std::string> & labels = std::vector<std::string>());
 
@@ -32,6 +32,8 @@ namespace Consts
   inline Uint uint_max() { return std::numeric_limits<Uint>::max(); }
   /// Definition of the minimum number representable with the chosen precision.
   inline Uint uint_min() { return std::numeric_limits<Uint>::min(); }
+  /// Returns the maximum global index
+  inline Gid gid_max() { return std::numeric_limits<Gid>::max(); }
   /// Returns the maximum number representable with the chosen precision
   inline Real real_max() { return std::numeric_limits<Real>::max(); }
   /// Definition of the minimum number representable with the chosen precision.
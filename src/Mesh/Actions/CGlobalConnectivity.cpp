@@ -93,7 +93,7 @@ void CGlobalConnectivity::execute()
   CMesh& mesh = *m_mesh.lock();
 
   CNodes& nodes = mesh.nodes();
-  CList<Uint>& nodes_glb_idx = nodes.glb_idx();
+  CList<Gid>& nodes_glb_idx = nodes.glb_idx();
   // Undefined behavior if sizeof(Uint) != sizeof(std::size_t)
   // Assert at compile time
   //BOOST_STATIC_ASSERT(sizeof(std::size_t) == sizeof(Uint));
@@ -106,9 +106,9 @@ void CGlobalConnectivity::execute()
 
 
   //1)
-  std::map<Uint,Uint> node_glb2loc;
+  std::map<Gid,Uint> node_glb2loc;
   Uint loc_node_idx(0);
-  boost_foreach(Uint glb_node_idx, nodes_glb_idx.array())
+  boost_foreach(const Gid glb_node_idx, nodes_glb_idx.array())
     node_glb2loc[glb_node_idx]=loc_node_idx++;
 
   //2)
@@ -121,8 +121,8 @@ void CGlobalConnectivity::execute()
     if (nodes.is_ghost(i))
       ++nb_ghost;
 
-  std::vector<Uint> ghostnode_glb_idx(nb_ghost);
-  std::vector<Uint> ghostnode_glb_elem_connectivity;
+  std::vector<Gid> ghostnode_glb_idx(nb_ghost);
+  std::vector<Gid> ghostnode_glb_elem_connectivity;
   std::vector<Uint> ghostnode_glb_elem_connectivity_start(nb_ghost+1);
   ghostnode_glb_elem_connectivity_start[0]=0;
   Component::Ptr elem_comp;
@@ -148,14 +148,14 @@ void CGlobalConnectivity::execute()
   }
 
   // 4)
-  std::vector<std::vector<Uint> > glb_elem_connectivity(nodes.size());
+  std::vector<std::vector<Gid> > glb_elem_connectivity(nodes.size());
   nodes_glb_idx.resize(mesh.nodes().size());
 
   for (Uint root=0; root<mpi::PE::instance().size(); ++root)
   {
-    std::vector<Uint> rcv_glb_node_idx(0);//ghostnode_glb_idx.size());
+    std::vector<Gid> rcv_glb_node_idx(0);//ghostnode_glb_idx.size());
     mpi::PE::instance().broadcast(ghostnode_glb_idx,rcv_glb_node_idx,root);
-    std::vector<Uint> rcv_glb_elem_connectivity(0);//ghostnode_glb_elem_connectivity.size());
+    std::vector<Gid> rcv_glb_elem_connectivity(0);//ghostnode_glb_elem_connectivity.size());
     mpi::PE::instance().broadcast(ghostnode_glb_elem_connectivity,rcv_glb_elem_connectivity,root);
     std::vector<Uint> rcv_glb_elem_connectivity_start(0);//ghostnode_glb_elem_connectivity_start.size());
     mpi::PE::instance().broadcast(ghostnode_glb_elem_connectivity_start,rcv_glb_elem_connectivity_start,root);
@@ -167,7 +167,7 @@ void CGlobalConnectivity::execute()
         if (p == mpi::PE::instance().rank())
         {
           Uint rcv_idx(0);
-          boost_foreach(const std::size_t glb_node, rcv_glb_node_idx)
+          boost_foreach(const Gid glb_node, rcv_glb_node_idx)
           {
             if (node_glb2loc.find(glb_node) != node_glb2loc.end())
             {
@@ -185,7 +185,7 @@ void CGlobalConnectivity::execute()
   }
 
 
-  CDynTable<Uint>& nodes_glb_elem_connectivity = mesh.nodes().glb_elem_connectivity();
+  CDynTable<Gid>& nodes_glb_elem_connectivity = mesh.nodes().glb_elem_connectivity();
   nodes_glb_elem_connectivity.resize(glb_elem_connectivity.size());
   for (Uint i=0; i<glb_elem_connectivity.size(); ++i)
   {
@@ -23,8 +23,11 @@ namespace Actions {
 
 /// @brief Create a global number for nodes and elements of the mesh
 ///
-/// Global numbers are created using a hash based on the coordinates
-/// of the nodes, and all vertex coordinates of the elements.
+/// Owned nodes and elements are numbered contiguously, starting at an offset
+/// given by an exclusive scan of the number of owned entities per process.
+/// Ghost nodes find their owner by their exact coordinates, and ghost elements
+/// by the sorted global indices of their nodes, through a GlobalNumberingDirectory.
+/// No process ever holds more than its share of the keys.
 /// After numbering the nodes and elements will share the global numbering
 /// table given an example with 30 nodes and 30 elements on 3 processes
 /// proc 1:   nodes [ 0 -> 10]   elems [11 -> 20]
@@ -58,10 +61,6 @@ public: // functions
   /// extended help that user can query
   virtual std::string help() const;
 
-public: // functions
-
-  static std::size_t hash_value(const RealMatrix& coords);
-
 private: // data
 
   bool m_debug;
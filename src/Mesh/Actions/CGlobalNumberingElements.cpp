@@ -10,7 +10,6 @@
 #include <boost/functional/hash.hpp>
 
 #include <boost/static_assert.hpp>
-#include <set>
 
 #include "Common/Log.hpp"
 #include "Common/CBuilder.hpp"
@@ -20,7 +19,6 @@
 #include "Common/StreamHelpers.hpp"
 #include "Common/StringConversion.hpp"
 #include "Common/OptionArray.hpp"
-#include "Common/CreateComponentDataType.hpp"
 #include "Common/OptionT.hpp"
 #include "Common/MPI/PE.hpp"
 #include "Common/MPI/debug.hpp"
@@ -50,8 +48,6 @@ namespace Actions {
   using namespace Math::Functions;
   using namespace Math::Consts;
 
-  create_component_data_type( std::vector<std::size_t> , Mesh_Actions_API , CVector_size_t , "CVector<size_t>" );
-
 ////////////////////////////////////////////////////////////////////////////////
 
 Common::ComponentBuilder < CGlobalNumberingElements, CMeshTransformer, LibActions> CGlobalNumberingElements_Builder;
@@ -63,7 +59,7 @@ CGlobalNumberingElements::CGlobalNumberingElements( const std::string& name )
   m_debug(false)
 {
 
-  m_properties["brief"] = std::string("Construct global node and element numbering based on coordinates hash values");
+  m_properties["brief"] = std::string("Construct global element numbering");
   std::string desc;
   desc =
     "  Usage: CGlobalNumberingElements Regions:array[uri]=region1,region2\n\n";
@@ -100,50 +96,6 @@ void CGlobalNumberingElements::execute()
 {
   CMesh& mesh = *m_mesh.lock();
 
-  CTable<Real>& coordinates = mesh.nodes().coordinates();
-
-
-  boost_foreach( CElements& elements, find_components_recursively<CElements>(mesh) )
-  {
-    RealMatrix element_coordinates(elements.element_type().nb_nodes(),coordinates.row_size());
-
-    if ( is_null( elements.get_child_ptr("glb_elem_hash") ) )
-      elements.create_component<CVector_size_t>("glb_elem_hash");
-    CVector_size_t& glb_elem_hash = elements.get_child("glb_elem_hash").as_type<CVector_size_t>();
-    glb_elem_hash.data().resize(elements.size());
-
-    for (Uint elem_idx=0; elem_idx<elements.size(); ++elem_idx)
-    {
-      elements.put_coordinates(element_coordinates,elem_idx);
-      glb_elem_hash.data()[elem_idx]=hash_value(element_coordinates);
-      if (m_debug)
-        std::cout << "["<<mpi::PE::instance().rank() << "]  hashing elem ("<< elements.uri().path() << "["<<elem_idx<<"]) to " << glb_elem_hash.data()[elem_idx] << std::endl;
-
-      //CFinfo << "glb_elem_hash["<<elem_idx<<"] = " <<  glb_elem_hash.data()[elem_idx] << CFendl;
-    }
-  }
-
-
-  // In debug mode, check if no hashes are duplicated
-  if (m_debug)
-  {
-    std::set<std::size_t> glb_set;
-
-    boost_foreach( CElements& elements, find_components_recursively<CElements>(mesh) )
-    {
-      CVector_size_t& glb_elem_hash = elements.get_child("glb_elem_hash").as_type<CVector_size_t>();
-      for (Uint i=0; i<glb_elem_hash.data().size(); ++i)
-      {
-        if (glb_set.insert(glb_elem_hash.data()[i]).second == false)  // it was already in the set
-          throw ValueExists(FromHere(), "elem "+elements.uri().path()+"["+to_str(i)+"] is duplicated");
-      }
-    }
-
-  }
-
-
-  // now renumber
-
   //------------------------------------------------------------------------------
   // get tot nb of owned indexes and communicate
 
@@ -152,54 +104,33 @@ void CGlobalNumberingElements::execute()
     tot_nb_owned_ids += elements.size();
 
   std::vector<Uint> nb_ids_per_proc(mpi::PE::instance().size());
-  //boost::mpi::communicator world;
-  //boost::mpi::all_gather(world, tot_nb_owned_ids, nb_ids_per_proc);
-  mpi::PE::instance().all_gather(tot_nb_owned_ids, nb_ids_per_proc);
-  std::vector<Uint> start_id_per_proc(mpi::PE::instance().size());
-  Uint start_id=0;
-  for (Uint p=0; p<nb_ids_per_proc.size(); ++p)
-  {
-    start_id_per_proc[p] = start_id;
-    start_id += nb_ids_per_proc[p];
-  }
 
+  // avoid mpi call if PE not active
+  if( mpi::PE::instance().is_active() )
+    mpi::PE::instance().all_gather(tot_nb_owned_ids, nb_ids_per_proc);
+  else
+    nb_ids_per_proc[0] = tot_nb_owned_ids;
 
+  // exclusive scan of the number of owned ids gives the first id of this process
+  const Uint my_rank = mpi::PE::instance().is_active() ? mpi::PE::instance().rank() : 0u;
+  Gid glb_id=0;
+  for (Uint p=0; p<my_rank; ++p)
+    glb_id += nb_ids_per_proc[p];
 
   //------------------------------------------------------------------------------
   // give glb idx to elements
-  Uint glb_id=start_id_per_proc[mpi::PE::instance().rank()];
   boost_foreach( CEntities& elements, find_components_recursively<CElements>(mesh) )
   {
-    CList<Uint>& elements_glb_idx = elements.glb_idx();
+    CList<Gid>& elements_glb_idx = elements.glb_idx();
     elements_glb_idx.resize(elements.size());
-    std::vector<std::size_t>& glb_elem_hash = elements.get_child("glb_elem_hash").as_type<CVector_size_t>().data();
-    cf_assert(glb_elem_hash.size() == elements.size());
     for (Uint e=0; e<elements.size(); ++e)
     {
       if (m_debug)
-        std::cout << "["<<mpi::PE::instance().rank() << "]  will change elem "<< glb_elem_hash[e] << " (" << elements.uri().path() << "["<<e<<"]) to " << glb_id << std::endl;
+        std::cout << "["<<my_rank << "]  will change elem " << elements.uri().path() << "["<<e<<"] to " << glb_id << std::endl;
       elements_glb_idx[e] = glb_id;
       ++glb_id;
     }
   }
-
-
-  // In debug mode, check if no hashes are duplicated
-  if (m_debug)
-  {
-    std::set<Uint> glb_set;
-
-    boost_foreach( CElements& elements, find_components_recursively<CElements>(mesh) )
-    {
-      CList<Uint>& elements_glb_idx = elements.glb_idx();
-      for (Uint i=0; i<elements.size(); ++i)
-      {
-        if (glb_set.insert(elements_glb_idx[i]).second == false)  // it was already in the set
-          throw ValueExists(FromHere(), "elem "+elements.uri().path()+"["+to_str(i)+"] is duplicated");
-      }
-    }
-
-  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -23,8 +23,8 @@ namespace Actions {
 
 /// @brief Create a global number for nodes and elements of the mesh
 ///
-/// Global numbers are created using a hash based on the coordinates
-/// of the nodes, and all vertex coordinates of the elements.
+/// All elements are owned. They are numbered contiguously, starting at an
+/// offset given by an exclusive scan of the number of elements per process.
 /// After numbering the nodes and elements will share the global numbering
 /// table given an example for 30 elements on 3 processes
 /// proc 1:   elems [ 0 -> 9]
@@ -10,7 +10,6 @@
 #include <boost/functional/hash.hpp>
 
 #include <boost/static_assert.hpp>
-#include <set>
 
 #include "Common/Log.hpp"
 #include "Common/CBuilder.hpp"
@@ -20,12 +19,12 @@
 #include "Common/StreamHelpers.hpp"
 #include "Common/StringConversion.hpp"
 #include "Common/OptionArray.hpp"
-#include "Common/CreateComponentDataType.hpp"
 #include "Common/OptionT.hpp"
 #include "Common/MPI/PE.hpp"
 #include "Common/MPI/debug.hpp"
 
 #include "Mesh/Actions/CGlobalNumberingNodes.hpp"
+#include "Mesh/Actions/GlobalNumberingDirectory.hpp"
 #include "Mesh/CCellFaces.hpp"
 #include "Mesh/CRegion.hpp"
 #include "Mesh/CNodes.hpp"
@@ -50,8 +49,6 @@ namespace Actions {
   using namespace Math::Functions;
   using namespace Math::Consts;
 
-  create_component_data_type( std::vector<std::size_t> , Mesh_Actions_API , CVector_size_t , "CVector<size_t>" );
-
 ////////////////////////////////////////////////////////////////////////////////
 
 Common::ComponentBuilder < CGlobalNumberingNodes, CMeshTransformer, LibActions> CGlobalNumberingNodes_Builder;
@@ -63,7 +60,7 @@ CGlobalNumberingNodes::CGlobalNumberingNodes( const std::string& name )
   m_debug(false)
 {
 
-  m_properties["brief"] = std::string("Construct global node and element numbering based on coordinates hash values");
+  m_properties["brief"] = std::string("Construct global node numbering, matching nodes by coordinates");
   std::string desc;
   desc =
     "  Usage: CGlobalNumberingNodes Regions:array[uri]=region1,region2\n\n";
@@ -100,67 +97,19 @@ void CGlobalNumberingNodes::execute()
 {
   CMesh& mesh = *m_mesh.lock();
 
-  CTable<Real>& coordinates = mesh.nodes().coordinates();
-
-  if ( is_null( mesh.nodes().get_child_ptr("glb_node_hash") ) )
-    mesh.nodes().create_component<CVector_size_t>("glb_node_hash");
-
-  CVector_size_t& glb_node_hash =
-      mesh.nodes().get_child("glb_node_hash").as_type<CVector_size_t>();
-
-  glb_node_hash.data().resize(coordinates.size());
-
-
-  Uint i(0);
-  boost_foreach(CTable<Real>::ConstRow coords, coordinates.array() )
-  {
-    glb_node_hash.data()[i]=hash_value(to_vector(coords));
-    if (m_debug)
-      std::cout << "["<<mpi::PE::instance().rank() << "]  hashing node ("<< to_vector(coords).transpose() << ") to " << glb_node_hash.data()[i] << std::endl;
-    ++i;
-  }
-
-
-  // In debug mode, check if no hashes are duplicated
-  if (m_debug)
-  {
-    std::set<std::size_t> glb_set;
-    for (Uint i=0; i<glb_node_hash.data().size(); ++i)
-    {
-      if (glb_set.insert(glb_node_hash.data()[i]).second == false)  // it was already in the set
-        throw ValueExists(FromHere(), "node "+to_str(i)+" is duplicated");
-    }
-  }
-
-
-  // now renumber
-
-  //------------------------------------------------------------------------------
-  // create node_glb2loc mapping
-  std::map<std::size_t,Uint> node_glb2loc;
-  Uint loc_node_idx(0);
-  boost_foreach(std::size_t hash, glb_node_hash.data())
-    node_glb2loc[hash]=loc_node_idx++;
-  std::map<std::size_t,Uint>::iterator node_glb2loc_it;
-  std::map<std::size_t,Uint>::iterator hash_not_found = node_glb2loc.end();
-
+  CNodes& nodes = mesh.nodes();
+  CTable<Real>& coordinates = nodes.coordinates();
 
   //------------------------------------------------------------------------------
   // get tot nb of owned indexes and communicate
 
   Uint nb_ghost(0);
-  CNodes& nodes = mesh.nodes();
-  CList<Uint>& nodes_rank = mesh.nodes().rank();
-  nodes_rank.resize(nodes.size());
   for (Uint i=0; i<nodes.size(); ++i)
   {
     if (nodes.is_ghost(i))
       ++nb_ghost;
-    else
-      nodes_rank[i] = mpi::PE::instance().rank();
   }
 
-
   Uint tot_nb_owned_ids=nodes.size()-nb_ghost;
   if (m_debug) std::cout << "["<<mpi::PE::instance().rank()<<"] nodes owned: " << tot_nb_owned_ids << std::endl;
   if (m_debug) std::cout << "["<<mpi::PE::instance().rank()<<"] nb ghost: " << nb_ghost << std::endl;
@@ -174,72 +123,38 @@ void CGlobalNumberingNodes::execute()
   else
     nb_ids_per_proc[0] = tot_nb_owned_ids;
 
-  std::vector<Uint> start_id_per_proc(mpi::PE::instance().size());
-
-  Uint start_id=0;
-  for (Uint p=0; p<nb_ids_per_proc.size(); ++p)
-  {
-    start_id_per_proc[p] = start_id;
-    start_id += nb_ids_per_proc[p];
-  }
+  // exclusive scan of the number of owned ids gives the first id of this process
+  const Uint my_rank = mpi::PE::instance().is_active() ? mpi::PE::instance().rank() : 0u;
+  Gid glb_id=0;
+  for (Uint p=0; p<my_rank; ++p)
+    glb_id += nb_ids_per_proc[p];
 
 
   //------------------------------------------------------------------------------
-  // add glb_idx to owned nodes, broadcast/receive glb_idx for ghost nodes
+  // add glb_idx to owned nodes, ask the owners for glb_idx of ghost nodes.
+  // Nodes are matched by their exact coordinates.
 
-  std::vector<size_t> node_from(nodes.size()-nb_ghost);
-  std::vector<Uint>   node_to(nodes.size()-nb_ghost);
-
-  CList<Uint>& nodes_glb_idx = mesh.nodes().glb_idx();
-  nodes_glb_idx.resize(nodes.size());
-
-  Uint cnt=0;
-  Uint glb_id = start_id_per_proc[mpi::PE::instance().rank()];
+  GlobalNumberingDirectory<Real> directory(coordinates.row_size());
+  directory.reserve(nodes.size());
   for (Uint i=0; i<nodes.size(); ++i)
   {
-    if ( ! nodes.is_ghost(i) )
-    {
-      nodes_glb_idx[i] = glb_id++;
-      node_from[cnt] = glb_node_hash.data()[i];
-      node_to[cnt]   = nodes_glb_idx[i];
-      ++cnt;
-    }
+    directory.add( &coordinates[i][0], nodes.is_ghost(i) ? gid_max() : glb_id++ );
   }
 
-  for (Uint root=0; root<mpi::PE::instance().size(); ++root)
+  std::vector<Gid> glb_idx;
+  std::vector<Uint> rank;
+  directory.resolve(glb_idx,rank,m_debug);
+
+  CList<Gid>& nodes_glb_idx = nodes.glb_idx();
+  CList<Uint>& nodes_rank = nodes.rank();
+  nodes_glb_idx.resize(nodes.size());
+  nodes_rank.resize(nodes.size());
+  for (Uint i=0; i<nodes.size(); ++i)
   {
-    //std::vector<std::size_t> rcv_node_from = mpi::broadcast(node_from, root);
-    //std::vector<Uint>        rcv_node_to   = mpi::broadcast(node_to, root);
-    // PECheckPoint(100,"001");
-    std::vector<std::size_t> rcv_node_from(0);//node_from.size());
-    mpi::PE::instance().broadcast(node_from,rcv_node_from,root);
-    //PECheckPoint(100,"002");
-    std::vector<Uint>        rcv_node_to(0);//node_to.size());
-    mpi::PE::instance().broadcast(node_to,rcv_node_to,root);
-    //PECheckPoint(100,"003");
-    if (mpi::PE::instance().rank() != root)
-    {
-      for (Uint p=0; p<mpi::PE::instance().size(); ++p)
-      {
-        if (p == mpi::PE::instance().rank())
-        {
-          Uint rcv_idx(0);
-          boost_foreach(const std::size_t node_hash, rcv_node_from)
-          {
-            node_glb2loc_it = node_glb2loc.find(node_hash);
-            if ( node_glb2loc_it != hash_not_found )
-            {
-              if (m_debug)
-                std::cout << "["<<mpi::PE::instance().rank() << "]  will change node "<< node_glb2loc_it->first << " (" << node_glb2loc_it->second << ") to " << rcv_node_to[rcv_idx] << std::endl;
-              nodes_glb_idx[node_glb2loc_it->second]=rcv_node_to[rcv_idx];
-              nodes_rank[node_glb2loc_it->second]=root;
-            }
-            ++rcv_idx;
-          }
-          break;
-        }
-      }
-    }
+    if (m_debug)
+      std::cout << "["<<my_rank << "]  will change node "<< i << " to " << glb_idx[i] << " owned by " << rank[i] << std::endl;
+    nodes_glb_idx[i] = glb_idx[i];
+    nodes_rank[i] = rank[i];
   }
 
 }
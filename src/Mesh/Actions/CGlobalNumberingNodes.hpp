@@ -23,8 +23,9 @@ namespace Actions {
 
 /// @brief Create a global number for nodes and elements of the mesh
 ///
-/// Global numbers are created using a hash based on the coordinates
-/// of the nodes, and all vertex coordinates of the elements.
+/// Owned nodes are numbered contiguously, starting at an offset given by an
+/// exclusive scan of the number of owned nodes per process. Ghost nodes find
+/// their owner by their exact coordinates, through a GlobalNumberingDirectory.
 /// After numbering the nodes and elements will share the global numbering
 /// table given an example with 30 nodes and 30 elements on 3 processes
 /// proc 1:   nodes [ 0 ->  9]
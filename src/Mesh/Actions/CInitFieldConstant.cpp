@@ -76,7 +76,11 @@ void CInitFieldConstant::execute()
 {
   if (m_field.expired())
     throw SetupError(FromHere(), "option [field] was not set in ["+uri().path()+"]");
-  m_field.lock()->data() = m_constant;
+  CField& field = *m_field.lock();
+  if (field.precision() == CField::SINGLE)
+    field.data_single() = m_constant;
+  else
+    field.data() = m_constant;
 }
 
 //////////////////////////////////////////////////////////////////////////////
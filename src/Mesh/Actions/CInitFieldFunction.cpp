@@ -81,9 +81,20 @@ void CInitFieldFunction::execute()
 
   CField& field = *m_field.lock();
 
+  if (field.precision() == CField::SINGLE)
+    initialize(field, field.data_single());
+  else
+    initialize(field, field.data());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+void CInitFieldFunction::initialize(CField& field, CTable<T>& data)
+{
   std::vector<Real> vars(3,0.);
 
-  RealVector return_val(field.data().row_size());
+  RealVector return_val(data.row_size());
 
   if (field.basis() == CField::Basis::POINT_BASED)
   {
@@ -96,20 +107,23 @@ void CInitFieldFunction::execute()
 
       m_function.evaluate(vars,return_val);
 
-      CTable<Real>::Row data_row = field[idx];
+      typename CTable<T>::Row data_row = data[idx];
       for (Uint i=0; i<data_row.size(); ++i)
         data_row[i] = return_val[i];
     }
   }
   else
   {
-    CMultiStateFieldView field_view("field_view");
-    field_view.set_field(field);
+    // the states of an element are consecutive rows, as in CMultiStateFieldView
     RealMatrix coordinates;
     boost_foreach( CElements& elements, find_components_recursively<CElements>(field.topology()) )
     {
-      if (field_view.set_elements(elements))
+      if (field.exists_for_entities(elements))
       {
+        const CSpace& space = elements.space(field.space_name());
+        const Uint nb_states = space.nb_states();
+        const Uint start_idx = field.elements_start_idx(elements);
+
         elements.allocate_coordinates(coordinates);
         RealVector centroid(coordinates.cols());
         cf_assert(centroid.size() < 4);
@@ -118,13 +132,11 @@ void CInitFieldFunction::execute()
         {
           elements.put_coordinates( coordinates, elem_idx );
 
-
-          CMultiStateFieldView::View data_rows = field_view[elem_idx];
           /// for each state of the field shape function
-          for (Uint iState=0; iState<field_view.space().nb_states(); ++iState)
+          for (Uint iState=0; iState<nb_states; ++iState)
           {
             /// get its local coordinates from the SPACE shape_function
-            RealVector local_coords = field_view.space().shape_function().local_coordinates().row(iState);
+            RealVector local_coords = space.shape_function().local_coordinates().row(iState);
             /// get the physical coordinates through the GEOMETRIC shape function (from element_type)
             RealVector physical_coords = elements.element_type().shape_function().value(local_coords)*coordinates;
             /// evaluate the function using the physical coordinates
@@ -132,9 +144,10 @@ void CInitFieldFunction::execute()
               vars[d] = physical_coords[d];
             m_function.evaluate(vars,return_val);
             /// put the return values in the field
-            for (Uint i=0; i<data_rows[iState].size(); ++i)
+            typename CTable<T>::Row data_row = data[start_idx + nb_states*elem_idx + iState];
+            for (Uint i=0; i<data_row.size(); ++i)
             {
-              data_rows[iState][i] = return_val[i];
+              data_row[i] = return_val[i];
             }
           }
         }
@@ -20,6 +20,7 @@
 namespace CF {
 namespace Mesh { 
   class CField;
+  template <typename T> class CTable;
 namespace Actions {
 
 //////////////////////////////////////////////////////////////////////////////
@@ -51,6 +52,11 @@ private: // functions
 
   void config_function();
 
+  /// evaluates the functions in the points of the field into its data table,
+  /// the table of Real or of float according to the precision of the field
+  template <typename T>
+  void initialize(CField& field, CTable<T>& data);
+
 private: // data
   
   Math::VectorialFunction  m_function;
@@ -0,0 +1,274 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+#include <string>
+
+#include <boost/functional/hash.hpp>
+
+#include "Common/BasicExceptions.hpp"
+#include "Common/StringConversion.hpp"
+#include "Common/MPI/PE.hpp"
+
+#include "Math/Consts.hpp"
+
+#include "Mesh/Actions/GlobalNumberingDirectory.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh {
+namespace Actions {
+
+  using namespace Common;
+  using namespace Math::Consts;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// orders entries of a flat table of keys lexicographically
+template <typename KeyT>
+struct KeyLess
+{
+  KeyLess( const std::vector<KeyT>& keys, const Uint key_size ) : keys(keys), key_size(key_size) {}
+
+  bool operator() ( const Uint a, const Uint b ) const
+  {
+    return std::lexicographical_compare( &keys[a*key_size], &keys[a*key_size] + key_size,
+                                         &keys[b*key_size], &keys[b*key_size] + key_size );
+  }
+
+  const std::vector<KeyT>& keys;
+  const Uint key_size;
+};
+
+/// value hashed for a key entry
+inline Real hashed( const Real value )
+{
+  // -0. and 0. compare equal, so they must hash equal
+  return value == 0. ? 0. : value;
+}
+
+inline Gid hashed( const Gid value )
+{
+  return value;
+}
+
+/// sends in_n[p] values to each process p, and receives out_n[p] values from it
+/// out_n must be filled with -1 if the receive counts are unknown
+template <typename T>
+void exchange( const std::vector<T>& in, const std::vector<int>& in_n, std::vector<T>& out, std::vector<int>& out_n )
+{
+  out.clear();
+
+  if ( mpi::PE::instance().is_active() )
+  {
+    mpi::PE::instance().all_to_all( in, in_n, out, out_n );
+  }
+  else
+  {
+    out = in;
+    out_n = in_n;
+  }
+}
+
+} // anonymous namespace
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename KeyT>
+GlobalNumberingDirectory<KeyT>::GlobalNumberingDirectory( const Uint key_size ) :
+  m_key_size(key_size)
+{
+  cf_assert( key_size != 0 );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename KeyT>
+void GlobalNumberingDirectory<KeyT>::reserve( const Uint nb_entities )
+{
+  m_keys.reserve( nb_entities * m_key_size );
+  m_glb_idx.reserve( nb_entities );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename KeyT>
+void GlobalNumberingDirectory<KeyT>::add( const KeyT* key, const Gid glb_idx )
+{
+  m_keys.insert( m_keys.end(), key, key + m_key_size );
+  m_glb_idx.push_back( glb_idx );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename KeyT>
+Uint GlobalNumberingDirectory<KeyT>::home( const KeyT* key, const Uint nb_procs ) const
+{
+  std::size_t seed=0;
+  for (Uint i=0; i<m_key_size; ++i)
+    boost::hash_combine(seed,hashed(key[i]));
+  return seed % nb_procs;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename KeyT>
+void GlobalNumberingDirectory<KeyT>::resolve( std::vector<Gid>& glb_idx, std::vector<Uint>& rank, const bool check ) const
+{
+  const bool parallel = mpi::PE::instance().is_active();
+  const Uint nb_procs = parallel ? mpi::PE::instance().size() : 1u;
+  const Uint my_rank  = parallel ? mpi::PE::instance().rank() : 0u;
+  const Uint nb_entities = size();
+
+  //------------------------------------------------------------------------------
+  // sort the entities by home process
+
+  std::vector<Uint> entity_home(nb_entities);
+  std::vector<int>  send_n(nb_procs,0);
+  for (Uint i=0; i<nb_entities; ++i)
+  {
+    entity_home[i] = home(&m_keys[i*m_key_size],nb_procs);
+    ++send_n[entity_home[i]];
+  }
+
+  std::vector<Uint> send_start(nb_procs,0);
+  for (Uint p=1; p<nb_procs; ++p)
+    send_start[p] = send_start[p-1] + send_n[p-1];
+
+  // send_order[s] is the entity at position s in the send buffers
+  std::vector<Uint> send_order(nb_entities);
+  std::vector<KeyT> send_keys(nb_entities*m_key_size);
+  std::vector<Gid>  send_idx(nb_entities);
+  for (Uint i=0; i<nb_entities; ++i)
+  {
+    const Uint s = send_start[entity_home[i]]++;
+    send_order[s] = i;
+    send_idx[s] = m_glb_idx[i];
+    std::copy(&m_keys[i*m_key_size], &m_keys[i*m_key_size] + m_key_size, &send_keys[s*m_key_size]);
+  }
+
+  std::vector<int> send_keys_n(nb_procs);
+  for (Uint p=0; p<nb_procs; ++p)
+    send_keys_n[p] = send_n[p]*m_key_size;
+
+  //------------------------------------------------------------------------------
+  // send the keys to their home process
+
+  std::vector<KeyT> recv_keys;
+  std::vector<int>  recv_keys_n(nb_procs,-1);
+  exchange(send_keys,send_keys_n,recv_keys,recv_keys_n);
+
+  std::vector<Gid>  recv_idx;
+  std::vector<int>  recv_n(nb_procs,-1);
+  exchange(send_idx,send_n,recv_idx,recv_n);
+
+  const Uint nb_recv = recv_idx.size();
+  cf_assert(recv_keys.size() == nb_recv*m_key_size);
+
+  std::vector<Uint> recv_rank(nb_recv);
+  Uint r=0;
+  for (Uint p=0; p<nb_procs; ++p)
+    for (int j=0; j<recv_n[p]; ++j)
+      recv_rank[r++] = p;
+
+  //------------------------------------------------------------------------------
+  // sort the owned keys, and answer the ghosts by binary search
+
+  KeyLess<KeyT> less(recv_keys,m_key_size);
+
+  std::vector<Uint> owned;
+  owned.reserve(nb_recv);
+  for (Uint j=0; j<nb_recv; ++j)
+  {
+    if (recv_idx[j] != gid_max())
+      owned.push_back(j);
+  }
+  std::sort(owned.begin(),owned.end(),less);
+
+  // errors are only raised after the last communication, to not leave other processes waiting
+  std::string duplicated;
+  if (check)
+  {
+    for (Uint k=1; k<owned.size() && duplicated.empty(); ++k)
+    {
+      if ( !less(owned[k-1],owned[k]) )
+        duplicated = "entity with global index "+to_str(recv_idx[owned[k]])+" from process "+to_str(recv_rank[owned[k]])
+                    +" has the same key as entity with global index "+to_str(recv_idx[owned[k-1]])+" from process "+to_str(recv_rank[owned[k-1]]);
+    }
+  }
+
+  std::vector<Gid>  answer_idx(nb_recv);
+  std::vector<Uint> answer_rank(nb_recv);
+  for (Uint j=0; j<nb_recv; ++j)
+  {
+    if (recv_idx[j] != gid_max())
+    {
+      answer_idx[j] = recv_idx[j];
+      answer_rank[j] = recv_rank[j];
+      continue;
+    }
+
+    std::vector<Uint>::const_iterator found = std::lower_bound(owned.begin(),owned.end(),j,less);
+    if ( found != owned.end() && !less(j,*found) )
+    {
+      answer_idx[j] = recv_idx[*found];
+      answer_rank[j] = recv_rank[*found];
+    }
+    else
+    {
+      answer_idx[j] = gid_max();
+      answer_rank[j] = uint_max();
+    }
+  }
+
+  //------------------------------------------------------------------------------
+  // send the answers back, in the order they were asked
+
+  std::vector<Gid>  reply_idx;
+  std::vector<int>  reply_n(send_n);
+  exchange(answer_idx,recv_n,reply_idx,reply_n);
+
+  std::vector<Uint> reply_rank;
+  exchange(answer_rank,recv_n,reply_rank,reply_n);
+
+  cf_assert(reply_idx.size() == nb_entities);
+
+  glb_idx.resize(nb_entities);
+  rank.resize(nb_entities);
+  for (Uint s=0; s<nb_entities; ++s)
+  {
+    const Uint i = send_order[s];
+    if (m_glb_idx[i] != gid_max())
+    {
+      glb_idx[i] = m_glb_idx[i];
+      rank[i] = my_rank;
+    }
+    else
+    {
+      glb_idx[i] = reply_idx[s];
+      rank[i] = reply_rank[s];
+      if (check && rank[i] == uint_max())
+        throw ValueNotFound(FromHere(), "ghost entity "+to_str(i)+" has no owner");
+    }
+  }
+
+  if (!duplicated.empty())
+    throw ValueExists(FromHere(), duplicated);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+Mesh_Actions_TEMPLATE template class GlobalNumberingDirectory<Real>;
+Mesh_Actions_TEMPLATE template class GlobalNumberingDirectory<Gid>;
+
+//////////////////////////////////////////////////////////////////////////////
+
+} // Actions
+} // Mesh
+} // CF
@@ -0,0 +1,91 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Mesh_Actions_GlobalNumberingDirectory_hpp
+#define CF_Mesh_Actions_GlobalNumberingDirectory_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "Mesh/Actions/LibActions.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh {
+namespace Actions {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// @brief Distributed directory matching copies of entities across processes
+///
+/// Every entity is identified by an exact key of a fixed number of values
+/// (e.g. the coordinates of a node as Real, or the sorted global indices of
+/// the nodes of an element as Gid). Owned entities come with their global
+/// index, ghost entities ask for the index and rank of their owner.
+///
+/// Each key is sent to a "home" process, chosen from a hash of the key.
+/// The home process sorts the keys of the owned entities it receives and
+/// answers the ghost entities by binary search. Keys are compared exactly,
+/// so hash collisions only affect the load balance of the directory, never
+/// the result. Memory and communication are proportional to the number of
+/// local entities instead of the total number of entities.
+///
+/// Instantiated for Real and Gid keys.
+/// @author Willem Deconinck
+template < typename KeyT >
+class Mesh_Actions_API GlobalNumberingDirectory
+{
+public:
+
+  /// constructor
+  /// @param key_size number of values in the key of each entity
+  GlobalNumberingDirectory( const Uint key_size );
+
+  /// reserve memory for a number of entities
+  void reserve( const Uint nb_entities );
+
+  /// adds an entity
+  /// @param key       pointer to the key_size values of the key
+  /// @param glb_idx   global index if the entity is owned, gid_max() if it is a ghost
+  void add( const KeyT* key, const Gid glb_idx );
+
+  /// number of entities added
+  Uint size() const { return m_glb_idx.size(); }
+
+  /// Collective: finds the global index and owner rank of all added entities.
+  /// Ghost entities for which no owner was found get gid_max() as index and uint_max() as rank.
+  /// @param [out] glb_idx   global index of each entity, in the order of addition
+  /// @param [out] rank      owner rank of each entity, in the order of addition
+  /// @param [in]  check     throw if an owned key is found twice, or a ghost has no owner
+  void resolve( std::vector<Gid>& glb_idx, std::vector<Uint>& rank, const bool check = false ) const;
+
+private:
+
+  /// home process of a key
+  Uint home( const KeyT* key, const Uint nb_procs ) const;
+
+  /// number of values per key
+  Uint m_key_size;
+
+  /// keys of all entities, key_size values per entity
+  std::vector<KeyT> m_keys;
+
+  /// global index of owned entities, gid_max() for ghosts
+  std::vector<Gid> m_glb_idx;
+
+}; // end GlobalNumberingDirectory
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Actions
+} // Mesh
+} // CF
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_Mesh_Actions_GlobalNumberingDirectory_hpp
@@ -15,7 +15,9 @@
 #include "Common/MPI/PE.hpp"
 #include "Common/MPI/Buffer.hpp"
 #include "Common/MPI/debug.hpp"
+#include "Common/StringConversion.hpp"
 
+#include "Math/Consts.hpp"
 
 #include "Mesh/CFaces.hpp"
 #include "Mesh/CRegion.hpp"
@@ -60,7 +62,7 @@ void my_all_gather(const std::vector<T>& send, std::vector<std::vector<T> >& rec
       displs[i] = displs[i-1] + strides[i-1];
       sum_strides += strides[i];
     }
-    std::vector<Uint> recv_linear(sum_strides);
+    std::vector<T> recv_linear(sum_strides);
     MPI_CHECK_RESULT(MPI_Allgatherv, ((void*)&send[0], (int)send.size(), get_mpi_datatype<T>(), &recv_linear[0], &strides[0], &displs[0], get_mpi_datatype<T>(), mpi::PE::instance().communicator()));
     recv.resize(strides.size());
     for (Uint i=0; i<strides.size(); ++i)
@@ -102,8 +104,8 @@ void my_all_to_all(const std::vector<std::vector<T> >& send, std::vector<std::ve
   for (Uint i=1; i<mpi::PE::instance().size(); ++i)
     recv_displs[i] = recv_displs[i-1] + recv_strides[i-1];
 
-  std::vector<Uint> recv_linear(recv_displs.back()+recv_strides.back());
-  MPI_CHECK_RESULT(MPI_Alltoallv, (&send_linear[0], &send_strides[0], &send_displs[0], mpi::get_mpi_datatype<Uint>(), &recv_linear[0], &recv_strides[0], &recv_displs[0], get_mpi_datatype<Uint>(), mpi::PE::instance().communicator()));
+  std::vector<T> recv_linear(recv_displs.back()+recv_strides.back());
+  MPI_CHECK_RESULT(MPI_Alltoallv, (&send_linear[0], &send_strides[0], &send_displs[0], mpi::get_mpi_datatype<T>(), &recv_linear[0], &recv_strides[0], &recv_displs[0], get_mpi_datatype<T>(), mpi::PE::instance().communicator()));
 
   recv.resize(recv_strides.size());
   for (Uint i=0; i<recv_strides.size(); ++i)
@@ -198,8 +200,8 @@ void GrowOverlap::execute()
   face2cell.setup(mesh.topology());
 
 
-  std::map<Uint,Uint> glb_node_2_loc_node;
-  std::map<Uint,Uint>::iterator glb_node_not_found = glb_node_2_loc_node.end();
+  std::map<Gid,Uint> glb_node_2_loc_node;
+  std::map<Gid,Uint>::iterator glb_node_not_found = glb_node_2_loc_node.end();
   for (Uint n=0; n<nodes.size(); ++n)
   {
     if ( glb_node_2_loc_node.find(nodes.glb_idx()[n]) == glb_node_not_found )
@@ -212,8 +214,8 @@ void GrowOverlap::execute()
     }
   }
 
-  std::map<Uint,Uint> glb_elem_2_loc_elem;
-  std::map<Uint,Uint>::iterator glb_elem_not_found = glb_elem_2_loc_elem.end();
+  std::map<Gid,Uint> glb_elem_2_loc_elem;
+  std::map<Gid,Uint>::iterator glb_elem_not_found = glb_elem_2_loc_elem.end();
   for (Uint e=0; e<mesh.elements().size(); ++e)
   {
     Component::Ptr comp;
@@ -233,7 +235,7 @@ void GrowOverlap::execute()
     }
   }
 
-  std::set<Uint> bdry_nodes;
+  std::set<Gid> bdry_nodes;
   for (Uint f=0; f<face2cell.size(); ++f)
   {
     cf_assert(f < face2cell.is_bdry_face().size());
@@ -257,15 +259,15 @@ void GrowOverlap::execute()
 
   // -----------------------------------------------------------------------------
   // SEARCH FOR CONNECTED ELEMENTS
-  // in  : nodes                            std::vector<Uint>
+  // in  : nodes                            std::vector<Gid>
   // out : buffer with packed elements      mpi::Buffer(nodes)
 
   // COMMUNICATE NODES TO LOOK FOR
 
-  std::vector<Uint> send_nodes; send_nodes.reserve(bdry_nodes.size());
-  boost_foreach(const Uint n, bdry_nodes)
+  std::vector<Gid> send_nodes; send_nodes.reserve(bdry_nodes.size());
+  boost_foreach(const Gid n, bdry_nodes)
     send_nodes.push_back(n);
-  std::vector<std::vector<Uint> > recv_nodes;
+  std::vector<std::vector<Gid> > recv_nodes;
   my_all_gather(send_nodes,recv_nodes);
 
 
@@ -277,7 +279,7 @@ void GrowOverlap::execute()
 
 
   // storage for nodes that will need to be fetched after elements have been received
-  std::set<Uint> new_ghost_nodes;
+  std::set<Gid> new_ghost_nodes;
 
   for (Uint proc=0; proc<PE::instance().size(); ++proc)
   {
@@ -285,14 +287,14 @@ void GrowOverlap::execute()
     {
       for (Uint n=0; n<recv_nodes[proc].size(); ++n)
       {
-        Uint find_glb_node_idx = recv_nodes[proc][n];
+        Gid find_glb_node_idx = recv_nodes[proc][n];
 
         // +--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+
         if ( glb_node_2_loc_node.find(find_glb_node_idx) != glb_node_not_found)
         {
           Uint loc_idx = glb_node_2_loc_node[find_glb_node_idx];
-          CDynTable<Uint>::ConstRow connected_elements = nodes.glb_elem_connectivity()[loc_idx];
-          boost_foreach ( const Uint glb_elem_idx, nodes.glb_elem_connectivity()[loc_idx] )
+          CDynTable<Gid>::ConstRow connected_elements = nodes.glb_elem_connectivity()[loc_idx];
+          boost_foreach ( const Gid glb_elem_idx, nodes.glb_elem_connectivity()[loc_idx] )
           {
 
             if ( glb_elem_2_loc_elem.find(glb_elem_idx) != glb_elem_not_found)
@@ -340,9 +342,17 @@ void GrowOverlap::execute()
           elements_to_send[to_proc] << elements.glb_idx()[elem_idx]
                                     << elements.rank()[elem_idx];
 
+          // the received connectivity holds the global node numbers until it is fixed below
+          /// @todo the connectivity table is 32 bit, send the global node numbers
+          ///       in a separate table to grow the overlap of meshes with more than 2^32 nodes
           boost_foreach(const Uint connected_node, elements.node_connectivity()[elem_idx])
-              elements_to_send[to_proc] << nodes.glb_idx()[connected_node];
+          {
+            if (nodes.glb_idx()[connected_node] > Gid(Math::Consts::uint_max()))
+              throw NotSupported(FromHere(), "Overlap with node with glb_idx "+to_str(nodes.glb_idx()[connected_node])+", which does not fit in the connectivity table");
+            elements_to_send[to_proc] << static_cast<Uint>(nodes.glb_idx()[connected_node]);
+          }
 
+          copy.entity_data.pack(elements_to_send[to_proc],elem_idx);
         }
       }
 
@@ -373,8 +383,8 @@ void GrowOverlap::execute()
       remove.flush();
       new_elem_size[comp_idx] = elements.size();
 
-      std::set<Uint>::iterator found_bdry_node;
-      std::set<Uint>::iterator not_found = bdry_nodes.end();
+      std::set<Gid>::iterator found_bdry_node;
+      std::set<Gid>::iterator not_found = bdry_nodes.end();
       for (Uint e=old_elem_size[comp_idx]; e<new_elem_size[comp_idx]; ++e)
       {
         boost_foreach(const Uint connected_glb_node, elements.node_connectivity()[e])
@@ -394,16 +404,16 @@ void GrowOverlap::execute()
 
   // -----------------------------------------------------------------------------
   // SEARCH FOR REQUESTED NODES
-  // in  : requested nodes                std::vector<Uint>
+  // in  : requested nodes                std::vector<Gid>
   // out : buffer with packed nodes       mpi::Buffer(nodes)
 
   // COMMUNICATE NODES TO LOOK FOR
 
-  std::vector<Uint> request_nodes; request_nodes.reserve(new_ghost_nodes.size());
-  boost_foreach(const Uint n, new_ghost_nodes)
+  std::vector<Gid> request_nodes; request_nodes.reserve(new_ghost_nodes.size());
+  boost_foreach(const Gid n, new_ghost_nodes)
       request_nodes.push_back(n);
 
-  std::vector<std::vector<Uint> > recv_request_nodes;
+  std::vector<std::vector<Gid> > recv_request_nodes;
   my_all_gather(request_nodes,recv_request_nodes);
 
 
@@ -416,7 +426,7 @@ void GrowOverlap::execute()
 
       for (Uint n=0; n<recv_request_nodes[proc].size(); ++n)
       {
-        Uint find_glb_idx = recv_request_nodes[proc][n];
+        Gid find_glb_idx = recv_request_nodes[proc][n];
 
         // +--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+
         if ( glb_node_2_loc_node.find(find_glb_idx) != glb_node_not_found)
@@ -454,8 +464,8 @@ void GrowOverlap::execute()
 
   // -----------------------------------------------------------------------------
   // FIX NODE CONNECTIVITY
-  std::map<Uint,Uint> glb_to_loc;
-  std::map<Uint,Uint>::iterator it;
+  std::map<Gid,Uint> glb_to_loc;
+  std::map<Gid,Uint>::iterator it;
   bool inserted;
   for (Uint n=0; n<nodes.size(); ++n)
   {
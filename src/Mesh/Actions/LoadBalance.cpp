@@ -4,16 +4,26 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include <map>
+#include <set>
 
 #include "Common/CBuilder.hpp"
+#include "Common/FindComponents.hpp"
+#include "Common/Foreach.hpp"
 #include "Common/Log.hpp"
+#include "Common/OptionT.hpp"
 
 #include "Common/MPI/PE.hpp"
+#include "Common/MPI/PECommPattern.hpp"
 
 #include "Mesh/Actions/LoadBalance.hpp"
+#include "Mesh/CField.hpp"
 #include "Mesh/CMesh.hpp"
+#include "Mesh/CNodes.hpp"
 #include "Mesh/CRegion.hpp"
+#include "Mesh/CSpace.hpp"
 #include "Mesh/CMeshPartitioner.hpp"
+#include "Mesh/Tags.hpp"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -30,6 +40,99 @@ Common::ComponentBuilder < LoadBalance, CMeshTransformer, LibActions> LoadBalanc
 
 //////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+// fields are stored in tables of Real whatever their precision, as entity data migrated with the mesh
+
+/// Copies the values of a field in tables of the nodes or of the elements
+template <typename ValueT>
+void store_field(CMesh& mesh, CField& field, const CTable<ValueT>& data)
+{
+  const std::string table_name = "load_balance_"+field.name();
+  const Uint row_size = data.row_size();
+
+  if (field.basis() == CField::Basis::POINT_BASED)
+  {
+    // nodes outside the topology of the field are stored as zeros
+    CNodes& nodes = mesh.nodes();
+    CTable<Real>& table = nodes.create_component<CTable<Real> >(table_name);
+    table.add_tag(Tags::entity_data());
+    table.set_row_size(row_size);
+    table.resize(nodes.size());
+
+    const CList<Uint>& used_nodes = field.used_nodes();
+    for (Uint i=0; i<used_nodes.size(); ++i)
+      for (Uint v=0; v<row_size; ++v)
+        table[used_nodes[i]][v] = data[i][v];
+  }
+  else
+  {
+    // all states of an element are stored in one row
+    boost_foreach(CElements& elements, find_components_recursively<CElements>(field.topology()))
+    {
+      if (field.exists_for_entities(elements) == false)
+        continue;
+
+      const Uint nb_states = elements.space(field.space_name()).nb_states();
+      const Uint start = field.elements_start_idx(elements);
+
+      CTable<Real>& table = elements.create_component<CTable<Real> >(table_name);
+      table.add_tag(Tags::entity_data());
+      table.set_row_size(nb_states*row_size);
+      table.resize(elements.size());
+
+      for (Uint e=0; e<elements.size(); ++e)
+        for (Uint s=0; s<nb_states; ++s)
+          for (Uint v=0; v<row_size; ++v)
+            table[e][s*row_size+v] = data[start+e*nb_states+s][v];
+    }
+  }
+}
+
+/// Copies back the values of a field, from the tables migrated with the nodes or the elements
+template <typename ValueT>
+void restore_field(CMesh& mesh, CField& field, CTable<ValueT>& data)
+{
+  const std::string table_name = "load_balance_"+field.name();
+  const Uint row_size = data.row_size();
+
+  if (field.basis() == CField::Basis::POINT_BASED)
+  {
+    CNodes& nodes = mesh.nodes();
+    const CTable<Real>& table = nodes.get_child(table_name).as_type<CTable<Real> >();
+
+    const CList<Uint>& used_nodes = field.used_nodes();
+    for (Uint i=0; i<used_nodes.size(); ++i)
+      for (Uint v=0; v<row_size; ++v)
+        data[i][v] = table[used_nodes[i]][v];
+
+    nodes.remove_component(table_name);
+  }
+  else
+  {
+    boost_foreach(CElements& elements, find_components_recursively<CElements>(field.topology()))
+    {
+      if (field.exists_for_entities(elements) == false)
+        continue;
+
+      const Uint nb_states = elements.space(field.space_name()).nb_states();
+      const Uint start = field.elements_start_idx(elements);
+      const CTable<Real>& table = elements.get_child(table_name).as_type<CTable<Real> >();
+
+      for (Uint e=0; e<elements.size(); ++e)
+        for (Uint s=0; s<nb_states; ++s)
+          for (Uint v=0; v<row_size; ++v)
+            data[start+e*nb_states+s][v] = table[e][s*row_size+v];
+
+      elements.remove_component(table_name);
+    }
+  }
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
 LoadBalance::LoadBalance( const std::string& name )
 : CMeshTransformer(name)
 {
@@ -44,6 +147,11 @@ LoadBalance::LoadBalance( const std::string& name )
   add_static_component(*m_partitioner);
 
   m_partitioner->configure_option("graph_package", std::string("PHG"));
+
+  m_options.add_option<OptionT<bool> >("repartition", false)
+      ->description("Take the current distribution into account to keep the migration low, "
+                    "for a mesh that is balanced again during a simulation")
+      ->pretty_name("Repartition");
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -69,12 +177,19 @@ void LoadBalance::execute()
     build_component_abstract_type<CMeshTransformer>("CF.Mesh.Actions.CGlobalConnectivity","glb_connectivity")->transform(mesh);
 
 
+    if ( m_partitioner->options().check("approach") )
+      m_partitioner->configure_option("approach", std::string(option("repartition").value<bool>() ? "REPARTITION" : "PARTITION"));
+
+    store_fields(mesh);
+
     CFinfo << "  + partitioning and migrating" << CFendl;
     m_partitioner->transform(mesh);
 
     CFinfo << "  + growing overlap layer" << CFendl;
     build_component_abstract_type<CMeshTransformer>("CF.Mesh.Actions.GrowOverlap","grow_overlap")->transform(mesh);
 
+    restore_fields(mesh);
+
 
     CFinfo << "  + deallocating unused connectivity" << CFendl;
 
@@ -107,6 +222,66 @@ void LoadBalance::execute()
 
 //////////////////////////////////////////////////////////////////////////////
 
+void LoadBalance::store_fields(CMesh& mesh)
+{
+  boost_foreach(CField& field, find_components<CField>(mesh))
+  {
+    if (field.precision() == CField::SINGLE)
+      store_field(mesh, field, field.data_single());
+    else
+      store_field(mesh, field, field.data());
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void LoadBalance::restore_fields(CMesh& mesh)
+{
+  // the nodes used by the topologies of point-based fields have changed
+  std::set<const CRegion*> topologies;
+  boost_foreach(CField& field, find_components<CField>(mesh))
+  {
+    if (field.basis() == CField::Basis::POINT_BASED && topologies.insert(&field.topology()).second)
+      CEntities::used_nodes(field.topology(),true);
+  }
+
+  // the communication patterns were built for the old distribution
+  std::set<PECommPattern::Ptr> old_comm_patterns;
+  boost_foreach(CField& field, find_components<CField>(mesh))
+  {
+    if (is_not_null(field.comm_pattern_ptr()))
+      old_comm_patterns.insert(field.comm_pattern_ptr());
+  }
+  boost_foreach(const PECommPattern::Ptr& comm_pattern, old_comm_patterns)
+  {
+    if (comm_pattern->has_parent())
+      comm_pattern->parent().remove_component(*comm_pattern);
+  }
+
+  std::map<PECommPattern::Ptr,PECommPattern*> new_comm_patterns;
+  boost_foreach(CField& field, find_components<CField>(mesh))
+  {
+    field.create_data_storage();
+    if (field.precision() == CField::SINGLE)
+      restore_field(mesh, field, field.data_single());
+    else
+      restore_field(mesh, field, field.data());
+
+    // fields sharing a communication pattern share the new one
+    const PECommPattern::Ptr old_comm_pattern = field.comm_pattern_ptr();
+    if (is_not_null(old_comm_pattern))
+    {
+      field.reset_comm_pattern();
+      std::map<PECommPattern::Ptr,PECommPattern*>::iterator it = new_comm_patterns.find(old_comm_pattern);
+      if (it == new_comm_patterns.end())
+        new_comm_patterns[old_comm_pattern] = &field.parallelize();
+      else
+        field.parallelize_with(*it->second);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
 
 } // Actions
 } // Mesh
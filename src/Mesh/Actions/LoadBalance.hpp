@@ -19,6 +19,7 @@ namespace CF {
 namespace Mesh {
 
   class CMeshPartitioner;
+  class CMesh;
 
 namespace Actions {
 
@@ -26,6 +27,12 @@ namespace Actions {
 
 /// @brief Load Balance the mesh
 ///
+/// The mesh can be load balanced again during a simulation: the fields of the
+/// mesh are migrated along with the nodes and elements, and the fields that
+/// were parallelized get a new communication pattern.
+/// The objects are weighted by the "partition_weight" property of the
+/// nodes and elements components (see CMeshPartitioner).
+///
 /// @post After this, the mesh is ready to be parallellized
 /// @author Willem Deconinck
 class Mesh_Actions_API LoadBalance : public CMeshTransformer
@@ -47,6 +54,12 @@ public: // functions
 
 private:
 
+  /// copies the fields into tables that are migrated with the nodes and elements
+  void store_fields(CMesh& mesh);
+
+  /// copies the migrated tables back into the fields, and parallelizes them again
+  void restore_fields(CMesh& mesh);
+
   boost::shared_ptr<CMeshPartitioner> m_partitioner;
 
 }; // end LoadBalance
@@ -0,0 +1,833 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+#include "Common/CBuilder.hpp"
+#include "Common/FindComponents.hpp"
+#include "Common/Foreach.hpp"
+#include "Common/Log.hpp"
+#include "Common/OptionComponent.hpp"
+#include "Common/OptionT.hpp"
+#include "Common/StringConversion.hpp"
+
+#include "Common/MPI/PE.hpp"
+#include "Common/MPI/PECommPattern.hpp"
+
+#include "Mesh/Actions/Refine.hpp"
+#include "Mesh/CElements.hpp"
+#include "Mesh/CFaceCellConnectivity.hpp"
+#include "Mesh/CField.hpp"
+#include "Mesh/CList.hpp"
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CMeshElements.hpp"
+#include "Mesh/CNodes.hpp"
+#include "Mesh/CDynTable.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/CSpace.hpp"
+#include "Mesh/CStructuredBlocks.hpp"
+#include "Mesh/ElementType.hpp"
+#include "Mesh/GeoShape.hpp"
+#include "Mesh/Tags.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh {
+namespace Actions {
+
+using namespace Common;
+using namespace Common::mpi;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Common::ComponentBuilder < Refine, CMeshTransformer, LibActions> Refine_Builder;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+typedef std::pair<Uint,Uint> Edge;
+
+Edge make_edge(const Uint a, const Uint b)
+{
+  return a < b ? Edge(a,b) : Edge(b,a);
+}
+
+/// local nodes of the edges of each supported shape
+const Uint line_edges[1][2]   = { {0,1} };
+const Uint triag_edges[3][2]  = { {0,1}, {1,2}, {2,0} };
+const Uint quad_edges[4][2]   = { {0,1}, {1,2}, {2,3}, {3,0} };
+const Uint tetra_edges[6][2]  = { {0,1}, {0,2}, {0,3}, {1,2}, {1,3}, {2,3} };
+const Uint hexa_edges[12][2]  = { {0,1}, {1,2}, {2,3}, {3,0}, {4,5}, {5,6}, {6,7}, {7,4}, {0,4}, {1,5}, {2,6}, {3,7} };
+
+/// position of the nodes of lines, quadrilaterals and hexahedra along their directions
+const Uint tensor_corners[8][3] = { {0,0,0}, {1,0,0}, {1,1,0}, {0,1,0}, {0,0,1}, {1,0,1}, {1,1,1}, {0,1,1} };
+
+/// children of a tetrahedron, each node being the middle of the edge between two
+/// nodes of the parent, or a node of the parent if both are the same.
+/// The inner octahedron is cut along its diagonal between the edges 02 and 13,
+/// and all children have the orientation of the parent.
+const Uint tetra_children[8][4][2] = {
+  { {0,0}, {0,1}, {0,2}, {0,3} },
+  { {0,1}, {1,1}, {1,2}, {1,3} },
+  { {0,2}, {1,2}, {2,2}, {2,3} },
+  { {0,3}, {1,3}, {2,3}, {3,3} },
+  { {0,1}, {0,2}, {0,3}, {1,3} },
+  { {0,1}, {1,2}, {0,2}, {1,3} },
+  { {0,2}, {0,3}, {1,3}, {2,3} },
+  { {0,2}, {1,3}, {1,2}, {2,3} }
+};
+
+/// @return the edges of a shape, as pairs of local nodes
+std::vector<Edge> shape_edges(const GeoShape::Type shape)
+{
+  const Uint (*edges)[2] = 0;
+  Uint nb_edges = 0;
+  switch (shape)
+  {
+    case GeoShape::LINE:  edges = line_edges;  nb_edges = 1;  break;
+    case GeoShape::TRIAG: edges = triag_edges; nb_edges = 3;  break;
+    case GeoShape::QUAD:  edges = quad_edges;  nb_edges = 4;  break;
+    case GeoShape::TETRA: edges = tetra_edges; nb_edges = 6;  break;
+    case GeoShape::HEXA:  edges = hexa_edges;  nb_edges = 12; break;
+    default: break;
+  }
+
+  std::vector<Edge> result(nb_edges);
+  for (Uint i=0; i<nb_edges; ++i)
+    result[i] = Edge(edges[i][0],edges[i][1]);
+  return result;
+}
+
+/// @return the node of a tetrahedron that is on none of the split edges, or 4 if there is none
+Uint free_tetra_node(const std::vector<Edge>& edges, const std::vector<bool>& split)
+{
+  for (Uint n=0; n<4; ++n)
+  {
+    bool is_free = true;
+    for (Uint i=0; i<edges.size(); ++i)
+      is_free = is_free && !(split[i] && (edges[i].first == n || edges[i].second == n));
+    if (is_free)
+      return n;
+  }
+  return 4;
+}
+
+/// @return true if an element with these split edges has no split that keeps the mesh
+///         conforming, and must be refined completely
+bool needs_full_refinement(const GeoShape::Type shape, const std::vector<Edge>& edges, const std::vector<bool>& split)
+{
+  const Uint nb_split = std::count(split.begin(), split.end(), true);
+  if (nb_split == 0 || nb_split == edges.size())
+    return false;
+
+  switch (shape)
+  {
+    case GeoShape::TRIAG:
+      return nb_split != 1;
+    case GeoShape::TETRA:
+      return nb_split != 1 && !(nb_split == 3 && free_tetra_node(edges,split) != 4);
+    default:
+      return true;
+  }
+}
+
+/// orders nodes by global index, so that all processes combine the parents of a new node in the same order
+struct GlobalIndexLess
+{
+  GlobalIndexLess(const CList<Gid>& glb_idx) : m_glb_idx(glb_idx) {}
+
+  bool operator()(const Uint a, const Uint b) const
+  {
+    return m_glb_idx[a] < m_glb_idx[b] || (m_glb_idx[a] == m_glb_idx[b] && a < b);
+  }
+
+  const CList<Gid>& m_glb_idx;
+};
+
+/// Refines the mesh once
+class Refinement
+{
+public:
+
+  Refinement(CMesh& mesh) :
+    m_mesh(mesh),
+    m_nb_old_nodes(mesh.nodes().size()),
+    m_parallel(PE::instance().is_active() && PE::instance().size() > 1)
+  {
+  }
+
+  /// marks all the edges of the mesh
+  void mark_all()
+  {
+    boost_foreach(const CElements& elements, find_components_recursively<CElements>(m_mesh.topology()))
+    {
+      const std::vector<Edge> edges = shape_edges(elements.element_type().shape());
+      for (Uint e=0; e<elements.size(); ++e)
+        mark_element(elements,e,edges);
+    }
+  }
+
+  /// marks the edges of the elements where the indicator is not zero, and
+  /// the edges that must be split as well to keep the mesh conforming
+  void mark(const CField& indicator)
+  {
+    boost_foreach(const CElements& elements, find_components_recursively<CElements>(m_mesh.topology()))
+    {
+      if (indicator.exists_for_entities(elements) == false)
+        continue;
+
+      const std::vector<Edge> edges = shape_edges(elements.element_type().shape());
+      const Uint nb_states = elements.space(indicator.space_name()).nb_states();
+      const Uint start = indicator.elements_start_idx(elements);
+      for (Uint e=0; e<elements.size(); ++e)
+      {
+        const Real value = indicator.precision() == CField::SINGLE ? indicator.data_single()[start+e*nb_states][0]
+                                                                   : indicator.data()[start+e*nb_states][0];
+        if (value != 0.)
+          mark_element(elements,e,edges);
+      }
+    }
+    close();
+  }
+
+  /// keeps the values of the fields, in the numbering of the nodes and the elements
+  void store_fields()
+  {
+    boost_foreach(CField& field, find_components<CField>(m_mesh))
+    {
+      if (field.precision() == CField::SINGLE)
+        store_field(field, field.data_single());
+      else
+        store_field(field, field.data());
+    }
+  }
+
+  /// replaces the elements by their children, and creates the new nodes they need
+  void split_elements()
+  {
+    boost_foreach(CElements& elements, find_components_recursively<CElements>(m_mesh.topology()))
+    {
+      const GeoShape::Type shape = elements.element_type().shape();
+      if (shape == GeoShape::POINT)
+        continue;
+
+      const std::vector<Edge> edges = shape_edges(shape);
+      const Uint nb_nodes = elements.element_type().nb_nodes();
+
+      std::vector<Uint> children;
+      std::vector<Uint>& parents = m_parent_elements[&elements];
+      std::vector<Uint> nodes(nb_nodes);
+      for (Uint e=0; e<elements.size(); ++e)
+      {
+        const CTable<Uint>::ConstRow row = elements.get_nodes(e);
+        std::copy(row.begin(), row.end(), nodes.begin());
+        split_element(shape, edges, nodes, children);
+        parents.resize(children.size()/nb_nodes, e);
+      }
+
+      // children replace their parent, and belong to the same process
+      const std::vector<Uint> old_rank(elements.rank().array().begin(), elements.rank().array().end());
+      const Uint nb_children = parents.size();
+
+      CTable<Uint>& connectivity = elements.node_connectivity();
+      connectivity.resize(nb_children);
+      elements.rank().resize(nb_children);
+      elements.glb_idx().resize(nb_children);
+      for (Uint c=0; c<nb_children; ++c)
+      {
+        for (Uint n=0; n<nb_nodes; ++n)
+          connectivity[c][n] = children[c*nb_nodes+n];
+        elements.rank()[c] = old_rank[parents[c]];
+      }
+
+      // the elements are renumbered, and lose their block structure
+      if (CStructuredBlocks::Ptr structured_blocks = find_component_ptr<CStructuredBlocks>(elements))
+        elements.remove_component(*structured_blocks);
+    }
+
+    // the lists of used nodes are built again when needed
+    std::vector<CList<Uint>::Ptr> used_nodes;
+    boost_foreach(CList<Uint>& list, find_components_recursively_with_tag<CList<Uint> >(m_mesh.topology(),Mesh::Tags::nodes_used()))
+      used_nodes.push_back(list.as_ptr<CList<Uint> >());
+    boost_foreach(const CList<Uint>::Ptr& list, used_nodes)
+      list->parent().remove_component(*list);
+  }
+
+  /// adds the new nodes, interpolating the fields of the nodes between their parents
+  void create_nodes()
+  {
+    CNodes& nodes = m_mesh.nodes();
+    const Uint nb_new_nodes = m_new_node_parents.size();
+    nodes.resize(m_nb_old_nodes+nb_new_nodes);
+
+    // a new node belongs to the process owning its parent of lowest global index
+    for (Uint i=0; i<nb_new_nodes; ++i)
+      nodes.rank()[m_nb_old_nodes+i] = nodes.rank()[m_new_node_parents[i][0]];
+
+    boost_foreach(Field& field, nodes.fields())
+    {
+      for (Uint i=0; i<nb_new_nodes; ++i)
+        interpolate(m_new_node_parents[i], field[m_nb_old_nodes+i], field);
+    }
+
+    // the global connectivity is built again when needed (see CGlobalConnectivity)
+    nodes.glb_elem_connectivity().resize(0);
+  }
+
+  /// sets the values of the fields after the refinement, and parallelizes them again
+  void restore_fields()
+  {
+    std::set<PECommPattern::Ptr> old_comm_patterns;
+    boost_foreach(CField& field, find_components<CField>(m_mesh))
+    {
+      if (is_not_null(field.comm_pattern_ptr()))
+        old_comm_patterns.insert(field.comm_pattern_ptr());
+    }
+    boost_foreach(const PECommPattern::Ptr& comm_pattern, old_comm_patterns)
+    {
+      if (comm_pattern->has_parent())
+        comm_pattern->parent().remove_component(*comm_pattern);
+    }
+
+    std::map<PECommPattern::Ptr,PECommPattern*> new_comm_patterns;
+    boost_foreach(CField& field, find_components<CField>(m_mesh))
+    {
+      field.create_data_storage();
+      if (field.precision() == CField::SINGLE)
+        restore_field(field, field.data_single());
+      else
+        restore_field(field, field.data());
+
+      // fields sharing a communication pattern share the new one
+      const PECommPattern::Ptr old_comm_pattern = field.comm_pattern_ptr();
+      if (is_not_null(old_comm_pattern))
+      {
+        field.reset_comm_pattern();
+        std::map<PECommPattern::Ptr,PECommPattern*>::iterator it = new_comm_patterns.find(old_comm_pattern);
+        if (it == new_comm_patterns.end())
+          new_comm_patterns[old_comm_pattern] = &field.parallelize();
+        else
+          field.parallelize_with(*it->second);
+      }
+    }
+  }
+
+private:
+
+  /// marks an edge to split
+  /// @param shared true if the edge may be on other processes, that must know it is split
+  /// @return true if the edge was not marked yet
+  bool mark_edge(const Uint a, const Uint b, const bool shared)
+  {
+    const Edge edge = make_edge(a,b);
+    const bool is_new = m_split_edges.insert(edge).second;
+    if (is_new && shared)
+      m_shared_new_edges.push_back(edge);
+    return is_new;
+  }
+
+  /// marks all edges of an element
+  void mark_element(const CElements& elements, const Uint e, const std::vector<Edge>& edges)
+  {
+    const CTable<Uint>::ConstRow nodes = elements.get_nodes(e);
+    const bool shared = m_parallel && is_shared(elements,e);
+    for (Uint i=0; i<edges.size(); ++i)
+      mark_edge(nodes[edges[i].first],nodes[edges[i].second],shared);
+  }
+
+  /// @return true if the element can be on other processes: it is a ghost, or one of its nodes is
+  bool is_shared(const CElements& elements, const Uint e) const
+  {
+    if (elements.is_ghost(e))
+      return true;
+    const CNodes& nodes = m_mesh.nodes();
+    boost_foreach(const Uint node, elements.get_nodes(e))
+    {
+      if (nodes.is_ghost(node))
+        return true;
+    }
+    return false;
+  }
+
+  /// @return which edges of an element are split
+  void split_edges(const std::vector<Edge>& edges, const std::vector<Uint>& nodes, std::vector<bool>& split) const
+  {
+    split.resize(edges.size());
+    for (Uint i=0; i<edges.size(); ++i)
+      split[i] = m_split_edges.count(make_edge(nodes[edges[i].first],nodes[edges[i].second])) != 0;
+  }
+
+  /// marks edges until all elements have a conforming split, on all processes
+  void close()
+  {
+    std::map<Gid,Uint> glb_to_loc;
+    std::vector<Uint> neighbors;
+    if (m_parallel)
+    {
+      const CList<Gid>& glb_idx = m_mesh.nodes().glb_idx();
+      for (Uint i=0; i<glb_idx.size(); ++i)
+        glb_to_loc[glb_idx[i]] = i;
+      neighbors = neighbor_ranks();
+    }
+
+    bool changed = true;
+    while (changed)
+    {
+      // refine completely the elements without conforming split, until there are none left
+      bool closed = false;
+      while (!closed)
+      {
+        closed = true;
+        boost_foreach(const CElements& elements, find_components_recursively<CElements>(m_mesh.topology()))
+        {
+          const GeoShape::Type shape = elements.element_type().shape();
+          const std::vector<Edge> edges = shape_edges(shape);
+          std::vector<Uint> nodes(elements.element_type().nb_nodes());
+          std::vector<bool> split;
+          for (Uint e=0; e<elements.size(); ++e)
+          {
+            const CTable<Uint>::ConstRow row = elements.get_nodes(e);
+            std::copy(row.begin(), row.end(), nodes.begin());
+            split_edges(edges,nodes,split);
+            if (needs_full_refinement(shape,edges,split))
+            {
+              mark_element(elements,e,edges);
+              closed = false;
+            }
+          }
+        }
+      }
+
+      changed = false;
+      if (m_parallel)
+      {
+        // the edges split here are sent to the neighbor processes, that may hold them too
+        const CList<Gid>& glb_idx = m_mesh.nodes().glb_idx();
+        std::vector<Gid> send;
+        std::vector<int> send_n(PE::instance().size(),0);
+        send.reserve(2*m_shared_new_edges.size()*neighbors.size());
+        boost_foreach(const Uint neighbor, neighbors)
+        {
+          boost_foreach(const Edge& edge, m_shared_new_edges)
+          {
+            send.push_back(glb_idx[edge.first]);
+            send.push_back(glb_idx[edge.second]);
+          }
+          send_n[neighbor] = 2*m_shared_new_edges.size();
+        }
+        m_shared_new_edges.clear();
+
+        std::vector<Gid> recv;
+        std::vector<int> recv_n(PE::instance().size(),-1);
+        PE::instance().all_to_all(send,send_n,recv,recv_n);
+
+        // the received edges are passed on, to reach the processes that hold them
+        // without being a neighbor of the process that split them
+        bool received_new = false;
+        for (Uint i=0; i+1<recv.size(); i+=2)
+        {
+          std::map<Gid,Uint>::const_iterator a = glb_to_loc.find(recv[i]);
+          std::map<Gid,Uint>::const_iterator b = glb_to_loc.find(recv[i+1]);
+          if (a != glb_to_loc.end() && b != glb_to_loc.end())
+            received_new = mark_edge(a->second,b->second,true) || received_new;
+        }
+
+        // continue while any process needs to close its elements again
+        PE::instance().all_reduce(logical_or(),&received_new,1,&changed);
+      }
+    }
+  }
+
+  /// @return the processes that share nodes or elements with this one
+  std::vector<Uint> neighbor_ranks() const
+  {
+    const Uint nb_procs = PE::instance().size();
+    const Uint rank = PE::instance().rank();
+
+    // the owners of the ghosts
+    std::vector<int> is_neighbor(nb_procs,0);
+    const CNodes& nodes = m_mesh.nodes();
+    for (Uint n=0; n<nodes.size(); ++n)
+    {
+      if (nodes.is_ghost(n))
+        is_neighbor[nodes.rank()[n]] = 1;
+    }
+    boost_foreach(const CElements& elements, find_components_recursively<CElements>(m_mesh.topology()))
+    {
+      for (Uint e=0; e<elements.size(); ++e)
+      {
+        if (elements.is_ghost(e))
+          is_neighbor[elements.rank()[e]] = 1;
+      }
+    }
+
+    // and the processes holding ghosts of this one
+    std::vector<int> is_neighbor_of;
+    PE::instance().all_to_all(is_neighbor,is_neighbor_of);
+
+    std::vector<Uint> neighbors;
+    for (Uint p=0; p<nb_procs; ++p)
+    {
+      if (p != rank && (is_neighbor[p] || is_neighbor_of[p]))
+        neighbors.push_back(p);
+    }
+    return neighbors;
+  }
+
+  /// appends the children of an element, or the element itself if it is not split
+  void split_element(const GeoShape::Type shape, const std::vector<Edge>& edges, const std::vector<Uint>& nodes, std::vector<Uint>& children)
+  {
+    std::vector<bool> split;
+    split_edges(edges,nodes,split);
+    cf_assert(needs_full_refinement(shape,edges,split) == false);
+
+    const Uint nb_split = std::count(split.begin(), split.end(), true);
+    if (nb_split == 0)
+    {
+      children.insert(children.end(), nodes.begin(), nodes.end());
+      return;
+    }
+
+    switch (shape)
+    {
+      case GeoShape::LINE:
+        split_tensor(1,nodes,children);
+        break;
+      case GeoShape::QUAD:
+        split_tensor(2,nodes,children);
+        break;
+      case GeoShape::HEXA:
+        split_tensor(3,nodes,children);
+        break;
+      case GeoShape::TRIAG:
+        if (nb_split == 1)
+          bisect(edges[std::find(split.begin(), split.end(), true) - split.begin()],nodes,children);
+        else
+          split_face(0,1,2,nodes,children);
+        break;
+      case GeoShape::TETRA:
+        if (nb_split == 1)
+          bisect(edges[std::find(split.begin(), split.end(), true) - split.begin()],nodes,children);
+        else if (nb_split == 3)
+        {
+          const Uint apex = free_tetra_node(edges,split);
+          split_face((apex+1)%4,(apex+2)%4,(apex+3)%4,nodes,children);
+        }
+        else
+          split_tetra(nodes,children);
+        break;
+      default:
+        cf_assert_desc("unsupported shape", false);
+    }
+  }
+
+  /// splits a line, quadrilateral or hexahedron in 2 along each direction
+  void split_tensor(const Uint dim, const std::vector<Uint>& nodes, std::vector<Uint>& children)
+  {
+    const Uint nb_corners = nodes.size();
+    std::vector<Uint> parents;
+    for (Uint c=0; c<nb_corners; ++c)
+    {
+      for (Uint n=0; n<nb_corners; ++n)
+      {
+        // the child node sits at position 0, 1 or 2 along each direction of the parent,
+        // and is the center of the parent nodes matching it in all directions where it is not 1
+        parents.clear();
+        for (Uint p=0; p<nb_corners; ++p)
+        {
+          bool is_parent = true;
+          for (Uint d=0; d<dim; ++d)
+          {
+            const Uint position = tensor_corners[c][d] + tensor_corners[n][d];
+            is_parent = is_parent && (position == 1 || position == 2*tensor_corners[p][d]);
+          }
+          if (is_parent)
+            parents.push_back(nodes[p]);
+        }
+        children.push_back(parents.size() == 1 ? parents[0] : new_node(parents));
+      }
+    }
+  }
+
+  /// splits a triangle or tetrahedron in 2 through the middle of one edge
+  void bisect(const Edge& edge, const std::vector<Uint>& nodes, std::vector<Uint>& children)
+  {
+    const Uint middle = midpoint(nodes[edge.first],nodes[edge.second]);
+    std::vector<Uint> child(nodes);
+    child[edge.second] = middle;
+    children.insert(children.end(), child.begin(), child.end());
+    child = nodes;
+    child[edge.first] = middle;
+    children.insert(children.end(), child.begin(), child.end());
+  }
+
+  /// splits the triangle a-b-c in 4, which is the element itself or the face of a tetrahedron
+  /// opposite to the node that is kept in all children
+  void split_face(const Uint a, const Uint b, const Uint c, const std::vector<Uint>& nodes, std::vector<Uint>& children)
+  {
+    const Uint ab = midpoint(nodes[a],nodes[b]);
+    const Uint bc = midpoint(nodes[b],nodes[c]);
+    const Uint ca = midpoint(nodes[c],nodes[a]);
+
+    // replacing nodes keeps the orientation of the parent
+    std::vector<Uint> child(nodes);
+    child[b] = ab; child[c] = ca;
+    children.insert(children.end(), child.begin(), child.end());
+    child = nodes;
+    child[a] = ab; child[c] = bc;
+    children.insert(children.end(), child.begin(), child.end());
+    child = nodes;
+    child[a] = ca; child[b] = bc;
+    children.insert(children.end(), child.begin(), child.end());
+    child = nodes;
+    child[a] = bc; child[b] = ca; child[c] = ab;
+    children.insert(children.end(), child.begin(), child.end());
+  }
+
+  /// splits a tetrahedron in 8
+  void split_tetra(const std::vector<Uint>& nodes, std::vector<Uint>& children)
+  {
+    for (Uint c=0; c<8; ++c)
+    {
+      for (Uint n=0; n<4; ++n)
+      {
+        const Uint a = nodes[tetra_children[c][n][0]];
+        const Uint b = nodes[tetra_children[c][n][1]];
+        children.push_back(a == b ? a : midpoint(a,b));
+      }
+    }
+  }
+
+  /// @return the new node in the middle of an edge
+  Uint midpoint(const Uint a, const Uint b)
+  {
+    std::vector<Uint> parents(2);
+    parents[0] = a;
+    parents[1] = b;
+    return new_node(parents);
+  }
+
+  /// @return the new node in the center of the given nodes, created on first use
+  Uint new_node(std::vector<Uint>& parents)
+  {
+    std::sort(parents.begin(), parents.end());
+    std::map<std::vector<Uint>,Uint>::const_iterator it = m_new_nodes.find(parents);
+    if (it != m_new_nodes.end())
+      return it->second;
+
+    const Uint node = m_nb_old_nodes + m_new_node_parents.size();
+    m_new_nodes[parents] = node;
+    m_new_node_parents.push_back(parents);
+    std::sort(m_new_node_parents.back().begin(), m_new_node_parents.back().end(), GlobalIndexLess(m_mesh.nodes().glb_idx()));
+    return node;
+  }
+
+  /// sets a row to the average of the rows of the parent nodes
+  template <typename RowT, typename TableT>
+  static void interpolate(const std::vector<Uint>& parents, RowT row, const TableT& table)
+  {
+    for (Uint v=0; v<row.size(); ++v)
+    {
+      Real value = 0.;
+      boost_foreach(const Uint parent, parents)
+        value += table[parent][v];
+      row[v] = value / parents.size();
+    }
+  }
+
+  template <typename ValueT>
+  void store_field(CField& field, const CTable<ValueT>& data)
+  {
+    const Uint row_size = data.row_size();
+
+    if (field.basis() == CField::Basis::POINT_BASED)
+    {
+      // nodes outside the topology of the field are stored as zeros
+      std::vector<Real>& values = m_node_values[&field];
+      values.assign(m_nb_old_nodes*row_size,0.);
+
+      const CList<Uint>& used_nodes = field.used_nodes();
+      for (Uint i=0; i<used_nodes.size(); ++i)
+        for (Uint v=0; v<row_size; ++v)
+          values[used_nodes[i]*row_size+v] = data[i][v];
+    }
+    else
+    {
+      boost_foreach(const CElements& elements, find_components_recursively<CElements>(field.topology()))
+      {
+        if (field.exists_for_entities(elements) == false)
+          continue;
+
+        if (elements.space(field.space_name()).nb_states() != 1)
+          throw NotSupported(FromHere(), "Field ["+field.uri().path()+"] has more than one state per element in ["+elements.uri().path()+"], and cannot be refined");
+
+        const Uint start = field.elements_start_idx(elements);
+        std::vector<Real>& values = m_element_values[std::make_pair(&field,&elements)];
+        values.resize(elements.size()*row_size);
+        for (Uint e=0; e<elements.size(); ++e)
+          for (Uint v=0; v<row_size; ++v)
+            values[e*row_size+v] = data[start+e][v];
+      }
+    }
+  }
+
+  template <typename ValueT>
+  void restore_field(CField& field, CTable<ValueT>& data)
+  {
+    const Uint row_size = data.row_size();
+
+    if (field.basis() == CField::Basis::POINT_BASED)
+    {
+      std::vector<Real>& values = m_node_values[&field];
+      values.resize((m_nb_old_nodes+m_new_node_parents.size())*row_size);
+      for (Uint i=0; i<m_new_node_parents.size(); ++i)
+      {
+        for (Uint v=0; v<row_size; ++v)
+        {
+          Real value = 0.;
+          boost_foreach(const Uint parent, m_new_node_parents[i])
+            value += values[parent*row_size+v];
+          values[(m_nb_old_nodes+i)*row_size+v] = value / m_new_node_parents[i].size();
+        }
+      }
+
+      const CList<Uint>& used_nodes = field.used_nodes();
+      for (Uint i=0; i<used_nodes.size(); ++i)
+        for (Uint v=0; v<row_size; ++v)
+          data[i][v] = values[used_nodes[i]*row_size+v];
+    }
+    else
+    {
+      // children take the value of their parent
+      boost_foreach(const CElements& elements, find_components_recursively<CElements>(field.topology()))
+      {
+        if (field.exists_for_entities(elements) == false)
+          continue;
+
+        const Uint start = field.elements_start_idx(elements);
+        const std::vector<Real>& values = m_element_values[std::make_pair(&field,&elements)];
+        const std::vector<Uint>& parents = m_parent_elements[&elements];
+        for (Uint c=0; c<elements.size(); ++c)
+        {
+          const Uint parent = parents.empty() ? c : parents[c];
+          for (Uint v=0; v<row_size; ++v)
+            data[start+c][v] = values[parent*row_size+v];
+        }
+      }
+    }
+  }
+
+  CMesh& m_mesh;
+
+  /// number of nodes before the refinement, the new nodes are numbered from there
+  const Uint m_nb_old_nodes;
+
+  const bool m_parallel;
+
+  /// edges to split, as pairs of local nodes
+  std::set<Edge> m_split_edges;
+
+  /// edges marked since the last exchange, that other processes may hold
+  std::vector<Edge> m_shared_new_edges;
+
+  /// new nodes, by their sorted parents
+  std::map<std::vector<Uint>,Uint> m_new_nodes;
+
+  /// parents of each new node, sorted by global index
+  std::vector<std::vector<Uint> > m_new_node_parents;
+
+  /// parent of each child element
+  std::map<const CEntities*,std::vector<Uint> > m_parent_elements;
+
+  /// values of the point-based fields, by node
+  std::map<const CField*,std::vector<Real> > m_node_values;
+
+  /// values of the element-based fields, by element
+  std::map<std::pair<const CField*,const CEntities*>,std::vector<Real> > m_element_values;
+};
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+Refine::Refine( const std::string& name )
+: CMeshTransformer(name)
+{
+  properties()["brief"] = std::string("Refine the mesh uniformly, or where an indicator field is not zero");
+  std::string desc;
+  desc =
+    "  Usage: Refine levels:unsigned=2\n"
+    "         Refine indicator:uri=cpath://Root/domain/mesh/refinement_indicator\n\n";
+  properties()["description"] = desc;
+
+  m_options.add_option<OptionT<Uint> >("levels", 1u)
+      ->description("Number of times the mesh is refined uniformly")
+      ->pretty_name("Levels");
+
+  m_options.add_option(OptionComponent<CField>::create("indicator", &m_indicator))
+      ->description("Element-based field, only the elements where it is not zero are refined")
+      ->pretty_name("Indicator");
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+void Refine::execute()
+{
+  CMesh& mesh = *m_mesh.lock();
+
+  if (is_not_null(find_component_ptr_recursively<CFaceCellConnectivity>(mesh.topology())))
+    throw NotSupported(FromHere(), "The faces of mesh ["+mesh.uri().path()+"] are built, refine the mesh before building them");
+
+  boost_foreach(const CElements& elements, find_components_recursively<CElements>(mesh.topology()))
+  {
+    const ElementType& etype = elements.element_type();
+    const std::vector<Edge> edges = shape_edges(etype.shape());
+    if (etype.shape() != GeoShape::POINT && (edges.empty() || etype.order() != 1))
+      throw NotSupported(FromHere(), "Elements ["+elements.uri().path()+"] of type ["+etype.derived_type_name()+"] cannot be refined");
+  }
+
+  const Uint levels = option("levels").value<Uint>();
+  if (!m_indicator.expired())
+  {
+    if (levels != 1)
+      throw BadValue(FromHere(), "Option [levels] of ["+uri().path()+"] must be 1 when refining with an indicator");
+    if (m_indicator.lock()->basis() == CField::Basis::POINT_BASED)
+      throw BadValue(FromHere(), "Indicator ["+m_indicator.lock()->uri().path()+"] must be an element-based field");
+  }
+
+  for (Uint level=0; level<levels; ++level)
+  {
+    CFinfo << "  + refining mesh [" << mesh.uri().path() << "]" << CFendl;
+
+    Refinement refinement(mesh);
+    if (m_indicator.expired())
+      refinement.mark_all();
+    else
+      refinement.mark(*m_indicator.lock());
+
+    refinement.store_fields();
+    refinement.split_elements();
+    refinement.create_nodes();
+
+    mesh.elements().reset();
+    mesh.elements().update();
+    mesh.update_statistics();
+
+    build_component_abstract_type<CMeshTransformer>("CF.Mesh.Actions.CGlobalNumbering","glb_numbering")->transform(mesh);
+
+    refinement.restore_fields();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+} // Actions
+} // Mesh
+} // CF
@@ -0,0 +1,90 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Mesh_Actions_Refine_hpp
+#define CF_Mesh_Actions_Refine_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Mesh/CMeshTransformer.hpp"
+#include "Mesh/Actions/LibActions.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh {
+
+  class CField;
+
+namespace Actions {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// @brief Refine the mesh in place
+///
+/// Every element is split in 2 along each of its directions: lines in 2,
+/// triangles and quadrilaterals in 4, tetrahedra and hexahedra in 8, and the
+/// boundary elements along with the cells. New nodes are placed in the middle
+/// of the edges, and in the center of the quadrilaterals and hexahedra.
+///
+/// With the "indicator" option, only the elements where the indicator field is
+/// not zero are refined. The mesh is kept conforming by a closure: a triangle
+/// or tetrahedron with one split edge is bisected, a tetrahedron with the three
+/// edges of one face split is divided in 4, and any other partially split
+/// element is refined completely, until no element changes anymore.
+/// Quadrilaterals and hexahedra have no such intermediate splits, and are
+/// refined completely as soon as one of their edges is split: the refinement of
+/// one of them spreads to all the quadrilaterals or hexahedra connected to it,
+/// and only stops at triangles, tetrahedra or the boundary. Meshes of quadrilaterals
+/// or hexahedra only are thus always refined uniformly.
+///
+/// Point-based fields are interpolated linearly in the new nodes, and fields
+/// with one state per element are copied from the parent element into its
+/// children. The global numbering is built again, and the fields that were
+/// parallelized get a new communication pattern.
+///
+/// In parallel, the edges split by the closure on the elements shared with other
+/// processes are exchanged with the neighbor processes only, the processes holding
+/// ghosts of this one or owning its ghosts, and passed on until no process splits
+/// a new edge.
+///
+/// @pre The elements are linear lines, triangles, quadrilaterals, tetrahedra or hexahedra
+/// @pre The faces are not built yet (see CBuildFaces)
+/// @pre In parallel, each process holds all the elements around the nodes it owns
+///      (see GrowOverlap), so that the new nodes are created by the owners of their parents
+class Mesh_Actions_API Refine : public CMeshTransformer
+{
+public: // typedefs
+
+    typedef boost::shared_ptr<Refine> Ptr;
+    typedef boost::shared_ptr<Refine const> ConstPtr;
+
+public: // functions
+
+  /// constructor
+  Refine( const std::string& name );
+
+  /// Gets the Class name
+  static std::string type_name() { return "Refine"; }
+
+  virtual void execute();
+
+private: // data
+
+  /// element-based field marking the elements to refine, the whole mesh is refined if not set
+  boost::weak_ptr<CField> m_indicator;
+
+}; // end Refine
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Actions
+} // Mesh
+} // CF
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_Mesh_Actions_Refine_hpp
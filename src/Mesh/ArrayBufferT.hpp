@@ -13,6 +13,7 @@
 
 #include <boost/foreach.hpp>
 
+#include "Common/Allocator.hpp"
 #include "Common/BoostArray.hpp"
 #include "Common/BasicExceptions.hpp"
 #include "Common/StringConversion.hpp"
@@ -50,7 +51,7 @@ public: // typedef
 
   typedef boost::shared_ptr<ArrayBufferT> Ptr;
 
-  typedef boost::multi_array<T,2> Array_t;
+  typedef boost::multi_array<T,2,Common::Allocator<T> > Array_t;
   typedef T value_type;
 
   typedef boost::detail::multi_array::sub_array<T,1> SubArray_t;
@@ -16,6 +16,7 @@
 #include "Mesh/CNodes.hpp"
 #include "Mesh/ConnectivityData.hpp"
 #include "Mesh/CRegion.hpp"
+#include "Mesh/CStructuredBlocks.hpp"
 #include "Mesh/ElementData.hpp"
 
 #include "Mesh/SF/Hexa3DLagrangeP1.hpp"
@@ -566,6 +567,7 @@ void build_mesh(const BlockData& block_data, CMesh& mesh)
   CElements& volume_elements = root_region.create_region("volume").create_elements("CF.Mesh.SF.Hexa3DLagrangeP1", mesh_nodes_comp);
   volume_elements.node_connectivity().resize(elements_dist[rank+1]-elements_dist[rank]);
   CTable<Uint>::ArrayT& volume_connectivity = volume_elements.node_connectivity().array();
+  CElements* structured_elements = &volume_elements;
 
   // Fill the volume arrays
   Uint element_idx = 0; // global element index
@@ -758,6 +760,7 @@ void build_mesh(const BlockData& block_data, CMesh& mesh)
     // Create the volume cells connectivity
     CElements& volume_elements_2d = root_region_2d.create_region("volume").create_elements("CF.Mesh.SF.Quad2DLagrangeP1", mesh_nodes_comp_2d);
     CTable<Uint>::ArrayT& volume_connectivity_2d = volume_elements_2d.node_connectivity().array();
+    structured_elements = &volume_elements_2d;
     volume_connectivity_2d.resize(boost::extents[elements_dist[rank+1]-elements_dist[rank]][4]);
 
     // Extract 2D data from the temporary 3D mesh
@@ -943,6 +946,23 @@ void build_mesh(const BlockData& block_data, CMesh& mesh)
     }
     mesh.remove_component(*tmp_mesh3d);
   }
+
+  // Keep the block structure of the volume elements. The elements of a 2D mesh
+  // follow the order of the patch they were taken from, without the normal direction.
+  CStructuredBlocks& structured_blocks = structured_elements->create_component<CStructuredBlocks>("structured_blocks");
+  for(Uint block = blocks_begin; block != blocks_end; ++block)
+  {
+    const BlockData::CountsT& segments = block_data.block_subdivisions[block];
+    if(dims.first == DIM_3D)
+      structured_blocks.add_block(segments[XX], segments[YY], segments[ZZ]);
+    else if(dims.second == Hexa3DLagrangeP1::XNEG)
+      structured_blocks.add_block(segments[YY], segments[ZZ]);
+    else if(dims.second == Hexa3DLagrangeP1::YNEG)
+      structured_blocks.add_block(segments[XX], segments[ZZ]);
+    else
+      structured_blocks.add_block(segments[XX], segments[YY]);
+  }
+  structured_blocks.setup(*structured_elements);
 }
 
 void partition_blocks(const BlockData& blocks_in, const Uint nb_partitions, const CoordXYZ direction, BlockData& blocks_out)
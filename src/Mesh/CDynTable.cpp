@@ -19,6 +19,8 @@ Common::ComponentBuilder < CDynTable<bool>, Component, LibMesh > CDynTable_bool_
 
 Common::ComponentBuilder < CDynTable<Uint>, Component, LibMesh > CDynTable_Uint_Builder;
 
+Common::ComponentBuilder < CDynTable<Gid>, Component, LibMesh > CDynTable_Gid_Builder;
+
 Common::ComponentBuilder < CDynTable<int>, Component, LibMesh >  CDynTable_int_Builder;
 
 Common::ComponentBuilder < CDynTable<Real>, Component, LibMesh > CDynTable_Real_Builder;
@@ -39,6 +41,12 @@ std::ostream& operator<<(std::ostream& os, CDynTable<Uint>::ConstRow row)
   return os;
 }
 
+std::ostream& operator<<(std::ostream& os, CDynTable<Gid>::ConstRow row)
+{
+  print_vector(os, row);
+  return os;
+}
+
 std::ostream& operator<<(std::ostream& os, CDynTable<int>::ConstRow row)
 {
   print_vector(os, row);
@@ -101,6 +109,27 @@ std::ostream& operator<<(std::ostream& os, const CDynTable<Uint>& table)
 	return os;
 }
 
+std::ostream& operator<<(std::ostream& os, const CDynTable<Gid>& table)
+{
+	if (table.size())
+		os << "\n";
+  Uint i=0;
+  boost_foreach(CDynTable<Gid>::ConstRow row, table.array())
+  {
+		os << "  " << i << ":  ";
+		if (row.size() == 0)
+			os << "~";
+		else
+		{
+			boost_foreach(const Gid entry, row)
+				os << entry << " ";
+		}
+		os << "\n";
+    ++i;
+	}
+	return os;
+}
+
 std::ostream& operator<<(std::ostream& os, const CDynTable<int>& table)
 {
 	if (table.size())
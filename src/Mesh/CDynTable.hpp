@@ -117,12 +117,14 @@ private: // data
 
 std::ostream& operator<<(std::ostream& os, CDynTable<bool>::ConstRow row);
 std::ostream& operator<<(std::ostream& os, CDynTable<Uint>::ConstRow row);
+std::ostream& operator<<(std::ostream& os, CDynTable<Gid>::ConstRow row);
 std::ostream& operator<<(std::ostream& os, CDynTable<int>::ConstRow row);
 std::ostream& operator<<(std::ostream& os, CDynTable<Real>::ConstRow row);
 std::ostream& operator<<(std::ostream& os, CDynTable<std::string>::ConstRow row);
 
 std::ostream& operator<<(std::ostream& os, const CDynTable<bool>& table);
 std::ostream& operator<<(std::ostream& os, const CDynTable<Uint>& table);
+std::ostream& operator<<(std::ostream& os, const CDynTable<Gid>& table);
 std::ostream& operator<<(std::ostream& os, const CDynTable<int>& table);
 std::ostream& operator<<(std::ostream& os, const CDynTable<Real>& table);
 std::ostream& operator<<(std::ostream& os, const CDynTable<std::string>& table);
@@ -55,7 +55,7 @@ CEntities::CEntities ( const std::string& name ) :
       ->pretty_name("Element type")
       ->attach_trigger(boost::bind(&CEntities::configure_element_type, this));
 
-  m_global_numbering = create_static_component_ptr<CList<Uint> >(Mesh::Tags::global_elem_indices());
+  m_global_numbering = create_static_component_ptr<CList<Gid> >(Mesh::Tags::global_elem_indices());
   m_global_numbering->add_tag(Mesh::Tags::global_elem_indices());
   m_global_numbering->properties()["brief"] = std::string("The global element indices (inter processor)");
 
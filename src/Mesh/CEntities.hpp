@@ -92,10 +92,10 @@ public: // functions
   const CNodes& nodes() const;
 
   /// Mutable access to the list of nodes
-  CList<Uint>& glb_idx() { return *m_global_numbering; }
+  CList<Gid>& glb_idx() { return *m_global_numbering; }
 
   /// Const access to the list of nodes
-  const CList<Uint>& glb_idx() const { return *m_global_numbering; }
+  const CList<Gid>& glb_idx() const { return *m_global_numbering; }
 
   CList<Uint>& rank() { return *m_rank; }
   const CList<Uint>& rank() const { return *m_rank; }
@@ -139,7 +139,7 @@ protected: // data
 
   boost::shared_ptr<Common::CLink> m_nodes;
 
-  boost::shared_ptr<CList<Uint> > m_global_numbering;
+  boost::shared_ptr<CList<Gid> > m_global_numbering;
 
   std::vector<boost::shared_ptr<CSpace> > m_spaces;
 
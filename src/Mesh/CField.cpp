@@ -25,7 +25,7 @@
 #include "Mesh/CMesh.hpp"
 #include "Mesh/CTable.hpp"
 #include "Mesh/CList.hpp"
-#include "Mesh/CFieldView.hpp"
+#include "Mesh/CSpace.hpp"
 #include "Mesh/CCells.hpp"
 
 namespace CF {
@@ -65,7 +65,8 @@ CField::CField ( const std::string& name  ) :
   m_basis(Basis::POINT_BASED),
   m_space_name("space[0]"),
   m_iter_stamp(0),
-  m_time_stamp(0.)
+  m_time_stamp(0.),
+  m_precision(REAL)
 {
   mark_basic();
 
@@ -89,6 +90,20 @@ CField::CField ( const std::string& name  ) :
   option->attach_trigger ( boost::bind ( &CField::config_field_type,   this ) );
   option->mark_basic();
 
+  option = m_options.add_option< OptionT<std::string> >("Layout", std::string("AoS"));
+  option->description("Storage of the data: the variables of a row together (AoS), "
+                      "or each variable over all the rows together (SoA) for vectorized loops");
+  option->pretty_name("Layout");
+  option->restricted_list() += std::string("SoA");
+  option->attach_trigger ( boost::bind ( &CField::config_layout,   this ) );
+
+  option = m_options.add_option< OptionT<std::string> >("Precision", std::string("Real"));
+  option->description("Precision of the stored values: Real, or Single for auxiliary fields "
+                      "such as wave speeds and update coefficients, to halve their memory traffic");
+  option->pretty_name("Precision");
+  option->restricted_list() += std::string("Single");
+  option->attach_trigger ( boost::bind ( &CField::config_precision,   this ) );
+
   option = m_options.add_option< OptionT<std::string> >("Space", m_space_name);
   option->description("The space of the field is based on");
   option->link_to(&m_space_name);
@@ -131,6 +146,66 @@ CField::CField ( const std::string& name  ) :
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void CField::config_layout()
+{
+  std::string layout;
+  option("Layout").put_value(layout);
+  m_data->set_layout( layout == "SoA" ? CTable<Real>::SOA : CTable<Real>::AOS );
+  if ( is_not_null(m_data_single) )
+    m_data_single->set_layout( layout == "SoA" ? CTable<float>::SOA : CTable<float>::AOS );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CField::config_precision()
+{
+  std::string precision;
+  option("Precision").put_value(precision);
+  const Precision new_precision = precision == "Single" ? SINGLE : REAL;
+  if (new_precision == m_precision)
+    return;
+
+  if ( is_null(m_data_single) )
+  {
+    m_data_single = create_static_component_ptr<CTable<float> >("data_single");
+    config_layout();
+  }
+
+  // data that was already allocated is converted to the new precision
+
+  if (new_precision == SINGLE)
+  {
+    m_data_single->set_row_size(m_data->row_size());
+    m_data_single->resize(m_data->size());
+    for (Uint i=0; i<m_data->size(); ++i)
+      for (Uint j=0; j<m_data->row_size(); ++j)
+        (*m_data_single)[i][j] = static_cast<float>((*m_data)[i][j]);
+    m_data->resize(0);
+  }
+  else
+  {
+    m_data->set_row_size(m_data_single->row_size());
+    m_data->resize(m_data_single->size());
+    for (Uint i=0; i<m_data_single->size(); ++i)
+      for (Uint j=0; j<m_data_single->row_size(); ++j)
+        (*m_data)[i][j] = (*m_data_single)[i][j];
+    m_data_single->resize(0);
+  }
+
+  m_precision = new_precision;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CField::throw_precision_mismatch(const Precision precision) const
+{
+  throw IllegalCall(FromHere(), "Field "+uri().string()+" is stored in "
+                    +(m_precision == SINGLE ? "single precision" : "Real")+", not in "
+                    +(precision == SINGLE ? "single precision" : "Real"));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void CField::config_var_types()
 {
   std::vector<std::string> var_types; option("VarTypes").put_value(var_types);
@@ -279,14 +354,13 @@ void CField::create_data_storage()
   boost_foreach(const VarType var_size, m_var_types)
     row_size += Uint(var_size);
 
-  m_data->set_row_size(row_size);
-
+  Uint table_size(0);
   switch (m_basis)
   {
     case Basis::POINT_BASED:
     {
       m_used_nodes = CElements::used_nodes(topology()).as_ptr<CList<Uint> >();
-      m_data->resize(m_used_nodes->size());
+      table_size = m_used_nodes->size();
       break;
     }
     case Basis::ELEMENT_BASED:
@@ -298,10 +372,9 @@ void CField::create_data_storage()
           throw ValueNotFound(FromHere(),"space \""+m_space_name+"\" does not exist in "+field_elements.uri().path());
 
         m_elements_start_idx[field_elements.as_ptr<CEntities>()] = data_size;
-        CFieldView field_view("tmp_field_view");
-        data_size = field_view.initialize(*this,field_elements.as_ptr<CEntities>());
+        data_size += field_elements.space(m_space_name).nb_states() * field_elements.size();
       }
-      m_data->resize(data_size);
+      table_size = data_size;
       break;
     }
     case Basis::CELL_BASED:
@@ -314,10 +387,9 @@ void CField::create_data_storage()
           throw ValueNotFound(FromHere(),"space \""+m_space_name+"\" does not exist in "+field_elements.uri().path());
 
         m_elements_start_idx[field_elements.as_ptr<CEntities>()] = data_size;
-        CFieldView field_view("tmp_field_view");
-        data_size = field_view.initialize(*this,field_elements.as_ptr<CEntities>());
+        data_size += field_elements.space(m_space_name).nb_states() * field_elements.size();
       }
-      m_data->resize(data_size);
+      table_size = data_size;
       break;
     }
     case Basis::FACE_BASED:
@@ -329,10 +401,9 @@ void CField::create_data_storage()
           throw ValueNotFound(FromHere(),"space \""+m_space_name+"\" does not exist in "+field_elements.uri().path());
 
         m_elements_start_idx[field_elements.as_ptr<CEntities>()] = data_size;
-        CFieldView field_view("tmp_field_view");
-        data_size = field_view.initialize(*this,field_elements.as_ptr<CEntities>());
+        data_size += field_elements.space(m_space_name).nb_states() * field_elements.size();
       }
-      m_data->resize(data_size);
+      table_size = data_size;
       break;
     }
 
@@ -340,6 +411,17 @@ void CField::create_data_storage()
       throw NotSupported(FromHere() , "Basis can only be ELEMENT_BASED or NODE_BASED");
       break;
   }
+
+  if (m_precision == SINGLE)
+  {
+    m_data_single->set_row_size(row_size);
+    m_data_single->resize(table_size);
+  }
+  else
+  {
+    m_data->set_row_size(row_size);
+    m_data->resize(table_size);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -434,7 +516,10 @@ PECommPattern& CField::parallelize_with(PECommPattern& comm_pattern)
 {
   cf_assert_desc("Only point-based fields supported now", m_basis == Basis::POINT_BASED);
   m_comm_pattern = comm_pattern.as_ptr<Common::PECommPattern>();
-  comm_pattern.insert(name(),data().array(),true);
+  if (m_precision == SINGLE)
+    comm_pattern.insert(name(),data_single().array(),true);
+  else
+    comm_pattern.insert(name(),data().array(),true);
   return comm_pattern;
 }
 
@@ -447,7 +532,7 @@ PECommPattern& CField::parallelize()
 
   // Extract gid from the nodes.glb_idx()  for only the nodes in the region the fields will use.
   const CList<Uint>& nodes = used_nodes();
-  std::vector<Uint> gid;
+  std::vector<Gid> gid;
   std::vector<Uint> rank;
   gid.reserve(nodes.size());
   rank.reserve(nodes.size());
@@ -40,6 +40,10 @@ public: // typedefs
 
   enum VarType { SCALAR=1, VECTOR_2D=2, VECTOR_3D=3, TENSOR_2D=4, TENSOR_3D=9};
 
+  /// Precision of the stored values: Real, or float for auxiliary fields
+  /// that do not need the precision of the solution
+  enum Precision { REAL=0, SINGLE=1 };
+
   class Mesh_API Basis
   {
   public:
@@ -101,16 +105,33 @@ public: // functions
   VarType var_type(const Uint i=0) const { return m_var_types[i]; }
 
   /// Return the table that holds the data for this field
-  CTable<Real>& data() { return *m_data; }
+  /// @throw Common::IllegalCall if the field is stored in single precision
+  CTable<Real>& data() { check_precision(REAL); return *m_data; }
 
   /// Return the const table that holds the data for this field
-  const CTable<Real>& data() const { return *m_data; }
+  /// @throw Common::IllegalCall if the field is stored in single precision
+  const CTable<Real>& data() const { check_precision(REAL); return *m_data; }
+
+  /// Precision of the stored values, chosen with the option "Precision"
+  Precision precision() const { return m_precision; }
+
+  /// Return the table that holds the data for this field, if stored in single precision.
+  /// The field views only give access to fields stored in Real: kernels read
+  /// this table directly and convert the values when loading them.
+  /// @throw Common::IllegalCall if the field is stored in Real
+  CTable<float>& data_single() { check_precision(SINGLE); return *m_data_single; }
+
+  /// Return the const table that holds the data for this field, if stored in single precision
+  /// @throw Common::IllegalCall if the field is stored in Real
+  const CTable<float>& data_single() const { check_precision(SINGLE); return *m_data_single; }
 
   /// Return the table that holds the data for this field
-  CTable<Real>::Ptr data_ptr() { return m_data; }
+  /// @throw Common::IllegalCall if the field is stored in single precision
+  CTable<Real>::Ptr data_ptr() { check_precision(REAL); return m_data; }
 
   /// Return the const table that holds the data for this field
-  CTable<Real>::ConstPtr data_ptr() const { return m_data; }
+  /// @throw Common::IllegalCall if the field is stored in single precision
+  CTable<Real>::ConstPtr data_ptr() const { check_precision(REAL); return m_data; }
 
   void set_topology(CRegion& topology);
 
@@ -118,7 +139,7 @@ public: // functions
 
   CRegion& topology();
 
-  Uint size() const { return m_data->size(); }
+  Uint size() const { return m_precision == SINGLE ? m_data_single->size() : m_data->size(); }
 
   const CList<Uint>& used_nodes() const;
 
@@ -126,11 +147,13 @@ public: // functions
 
   /// Operator to have modifiable access to a table-row
   /// @return A mutable row of the underlying array
-  CTable<Real>::Row operator[](const Uint idx) { return m_data->array()[idx]; }
+  /// @throw Common::IllegalCall if the field is stored in single precision
+  CTable<Real>::Row operator[](const Uint idx) { check_precision(REAL); return m_data->array()[idx]; }
 
   /// Operator to have non-modifiable access to a table-row
   /// @return A const row of the underlying array
-  CTable<Real>::ConstRow operator[](const Uint idx) const { return m_data->array()[idx]; }
+  /// @throw Common::IllegalCall if the field is stored in single precision
+  CTable<Real>::ConstRow operator[](const Uint idx) const { check_precision(REAL); return m_data->array()[idx]; }
 
   CTable<Real>::ConstRow coords(const Uint idx) const;
 
@@ -151,6 +174,13 @@ public: // functions
 
   Common::PECommPattern& parallelize_with(Common::PECommPattern& comm_pattern);
 
+  /// The communication pattern used by synchronize(), null if the field is not parallelized
+  boost::shared_ptr<Common::PECommPattern> comm_pattern_ptr() const { return m_comm_pattern; }
+
+  /// Forgets the communication pattern, which is no longer valid once
+  /// the nodes have been migrated. parallelize() must be called again.
+  void reset_comm_pattern() { m_comm_pattern.reset(); }
+
   void synchronize();
 
 private:
@@ -166,6 +196,19 @@ private:
   void config_var_types();
   void config_tree();
   void config_field_type();
+  void config_layout();
+  void config_precision();
+
+  /// throws if the field is not stored in the given precision
+  void check_precision(const Precision precision) const
+  {
+    if (m_precision != precision)
+      throw_precision_mismatch(precision);
+  }
+
+  void throw_precision_mismatch(const Precision precision) const;
+
+  Precision m_precision;
 
   std::vector<std::string> m_var_names;
   std::vector<VarType> m_var_types;
@@ -178,6 +221,8 @@ protected:
 
   boost::shared_ptr<CTable<Real> > m_data;
 
+  boost::shared_ptr<CTable<float> > m_data_single;
+
   boost::shared_ptr<CTable<Real> > m_coords;
 
   boost::shared_ptr<CList<Uint> > m_used_nodes;
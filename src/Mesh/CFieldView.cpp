@@ -6,6 +6,7 @@
 
 #include "Common/Log.hpp"
 
+#include "Common/BasicExceptions.hpp"
 #include "Common/CBuilder.hpp"
 #include "Common/FindComponents.hpp"
 #include "Common/Foreach.hpp"
@@ -108,6 +109,8 @@ bool CFieldView::set_elements(CEntities::Ptr elements)
 
 void CFieldView::set_field(CField& field)
 {
+  if (field.precision() != CField::REAL)
+    throw NotSupported(FromHere(), "Field "+field.uri().string()+" is stored in single precision, and has no view");
   m_field = field.as_ptr<CField>();
   m_field_data = field.data().as_ptr<CTable<Real> >();
   cf_assert( is_not_null(m_field_data.lock()) );
@@ -655,7 +655,7 @@ void CReader::read_boco_unstructured(CRegion& parent_region)
       std::map<std::string,CElements::Ptr> elements = create_faces_in_region(this_region,nodes,get_supported_element_types());
       std::map<std::string,CTable<Uint>::Buffer::Ptr> buffer = create_connectivity_buffermap(elements);
 
-      for (int global_element=boco_elems[0]-1;global_element<boco_elems[1];++global_element)
+      for (Gid global_element=boco_elems[0]-1;global_element<static_cast<Gid>(boco_elems[1]);++global_element)
       {
         // Check which region this global_element belongs to
         CElements::Ptr element_region = m_global_to_region[global_element].first;
@@ -705,7 +705,7 @@ void CReader::read_boco_unstructured(CRegion& parent_region)
 
       for (int i=0; i<m_boco.nBC_elem; ++i)
       {
-        Uint global_element = boco_elems[i]-1;
+        Gid global_element = boco_elems[i]-1;
 
         // Check which region this global_element belongs to
         CElements::Ptr element_region = m_global_to_region[global_element].first;
@@ -899,9 +899,9 @@ void CReader::read_boco_structured(CRegion& parent_region)
 
 //////////////////////////////////////////////////////////////////////////////
 
-Uint CReader::get_total_nbElements()
+Gid CReader::get_total_nbElements()
 {
-  Uint nbElements = 0;
+  Gid nbElements = 0;
 
   if (m_zone.type == Unstructured)
   {
@@ -61,7 +61,7 @@ private: // functions
   void create_structured_elements(CRegion& parent_region);
   void read_boco_unstructured(CRegion& parent_region);
   void read_boco_structured(CRegion& parent_region);
-  Uint get_total_nbElements();
+  Gid get_total_nbElements();
 
   Uint structured_node_idx(Uint i, Uint j, Uint k)
   {
@@ -122,7 +122,7 @@ void CWriter::write_zone(const CRegion& region)
       xCoord = new Real[m_zone.total_nbVertices];
   }
 
-  Uint idx=0;
+  Gid idx=0;
   BOOST_FOREACH(const CTable<Real>& coordinates, find_components_recursively_with_tag<CTable<Real> >(m_mesh->nodes(),Mesh::Tags::coordinates()))
   {
     m_global_start_idx[&coordinates] = idx;
@@ -26,12 +26,16 @@ Shared::Shared()
   m_supported_element_types.push_back("CF.Mesh.SF.Quad3DLagrangeP1");
   m_supported_element_types.push_back("CF.Mesh.SF.Tetra3DLagrangeP1");
   m_supported_element_types.push_back("CF.Mesh.SF.Hexa3DLagrangeP1");
+  m_supported_element_types.push_back("CF.Mesh.SF.Prism3DLagrangeP1");
+  m_supported_element_types.push_back("CF.Mesh.SF.Pyramid3DLagrangeP1");
 
   m_elemtype_CGNS_to_CF[BAR_2  ] = "CF.Mesh.SF.Line";
   m_elemtype_CGNS_to_CF[TRI_3  ] = "CF.Mesh.SF.Triag";
   m_elemtype_CGNS_to_CF[QUAD_4 ] = "CF.Mesh.SF.Quad";
   m_elemtype_CGNS_to_CF[TETRA_4] = "CF.Mesh.SF.Tetra";
   m_elemtype_CGNS_to_CF[HEXA_8 ] = "CF.Mesh.SF.Hexa";
+  m_elemtype_CGNS_to_CF[PENTA_6] = "CF.Mesh.SF.Prism";
+  m_elemtype_CGNS_to_CF[PYRA_5 ] = "CF.Mesh.SF.Pyramid";
 
   m_elemtype_CF_to_CGNS["CF.Mesh.SF.Line1DLagrangeP1" ] = BAR_2;
   m_elemtype_CF_to_CGNS["CF.Mesh.SF.Line2DLagrangeP1" ] = BAR_2;
@@ -42,6 +46,8 @@ Shared::Shared()
   m_elemtype_CF_to_CGNS["CF.Mesh.SF.Quad3DLagrangeP1" ] = QUAD_4;
   m_elemtype_CF_to_CGNS["CF.Mesh.SF.Tetra3DLagrangeP1"] = TETRA_4;
   m_elemtype_CF_to_CGNS["CF.Mesh.SF.Hexa3DLagrangeP1" ] = HEXA_8;
+  m_elemtype_CF_to_CGNS["CF.Mesh.SF.Prism3DLagrangeP1"] = PENTA_6;
+  m_elemtype_CF_to_CGNS["CF.Mesh.SF.Pyramid3DLagrangeP1"] = PYRA_5;
 }
 
 //////////////////////////////////////////////////////////////////////////////
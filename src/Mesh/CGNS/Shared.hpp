@@ -101,7 +101,7 @@ protected:
     int nbSols;
     int nbSections;
     int nbBocos;
-    Uint total_nbElements;
+    Gid total_nbElements;
     CNodes* nodes;
     Uint nodes_start_idx;
     //
@@ -46,9 +46,9 @@ CHash::CHash ( const std::string& name ) :
 
 //////////////////////////////////////////////////////////////////////////////
 
-Uint CHash::part_of_obj(const Uint obj) const
+Uint CHash::part_of_obj(const Gid obj) const
 {
-  return std::min(m_nb_parts-1, (obj - m_base) / part_size() );
+  return std::min(Gid(m_nb_parts-1), (obj - m_base) / part_size() );
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -60,21 +60,21 @@ Uint CHash::proc_of_part(const Uint part) const
 
 //////////////////////////////////////////////////////////////////////////////
 
-Uint CHash::part_size() const
+Gid CHash::part_size() const
 {
   return m_nb_obj/m_nb_parts;
 }
 
 //////////////////////////////////////////////////////////////////////////////
 
-Uint CHash::proc_of_obj(const Uint obj) const
+Uint CHash::proc_of_obj(const Gid obj) const
 {
   return proc_of_part( part_of_obj(obj) );
 }
 
 //////////////////////////////////////////////////////////////////////////////
 
-bool CHash::owns(const Uint obj) const
+bool CHash::owns(const Gid obj) const
 {
   return (proc_of_obj(obj) == mpi::PE::instance().rank());
 }
@@ -95,14 +95,14 @@ Uint CHash::nb_objects_in_proc(const Uint proc) const
 
 //////////////////////////////////////////////////////////////////////////////
 
-Uint CHash::start_idx_in_part(const Uint part) const
+Gid CHash::start_idx_in_part(const Uint part) const
 {
-  return m_nb_obj/m_nb_parts*part;
+  return Gid(m_nb_obj)/m_nb_parts*part;
 }
 
 //////////////////////////////////////////////////////////////////////////////
 
-Uint CHash::end_idx_in_part(const Uint part) const
+Gid CHash::end_idx_in_part(const Uint part) const
 {
   if (part == m_nb_parts - 1)
     return m_nb_obj;
@@ -112,7 +112,7 @@ Uint CHash::end_idx_in_part(const Uint part) const
 
 //////////////////////////////////////////////////////////////////////////////
 
-Uint CHash::start_idx_in_proc(const Uint proc) const
+Gid CHash::start_idx_in_proc(const Uint proc) const
 {
   Uint part_begin = m_nb_parts/mpi::PE::instance().size()*proc;
   return start_idx_in_part(part_begin);
@@ -120,7 +120,7 @@ Uint CHash::start_idx_in_proc(const Uint proc) const
 
 //////////////////////////////////////////////////////////////////////////////
 
-Uint CHash::end_idx_in_proc(const Uint proc) const
+Gid CHash::end_idx_in_proc(const Uint proc) const
 {
   Uint part_end = (proc == mpi::PE::instance().size()-1) ? m_nb_parts : m_nb_parts/mpi::PE::instance().size()*(proc+1);
   return end_idx_in_part(part_end);
@@ -43,27 +43,27 @@ public: // functions
   /// Get the class name
   static std::string type_name () { return "CHash"; }
 
-  Uint part_of_obj(const Uint obj) const;
+  Uint part_of_obj(const Gid obj) const;
 
   Uint proc_of_part(const Uint part) const;
 
-	Uint proc_of_obj(const Uint obj) const;
+	Uint proc_of_obj(const Gid obj) const;
 
 	Uint nb_objects_in_part(const Uint part) const;
 
 	Uint nb_objects_in_proc(const Uint proc) const;
 
-	Uint start_idx_in_part(const Uint part) const;
+	Gid start_idx_in_part(const Uint part) const;
 
-	Uint end_idx_in_part(const Uint part) const;
+	Gid end_idx_in_part(const Uint part) const;
 
-	Uint start_idx_in_proc(const Uint proc) const;
+	Gid start_idx_in_proc(const Uint proc) const;
 
-	Uint end_idx_in_proc(const Uint proc) const;
+	Gid end_idx_in_proc(const Uint proc) const;
 
-  bool owns(const Uint obj) const;
+  bool owns(const Gid obj) const;
 
-  Uint part_size() const;
+  Gid part_size() const;
 
 private:
 
@@ -45,7 +45,7 @@ CF::Common::ComponentBuilder < CLinearInterpolator, CInterpolator, LibMesh > CLi
 //////////////////////////////////////////////////////////////////////////////
 
 CLinearInterpolator::CLinearInterpolator( const std::string& name )
-  : CInterpolator(name), m_dim(0), m_bounding(2), m_N(3), m_D(3), m_point_idx(3), m_sufficient_nb_points(0)
+  : CInterpolator(name), m_dim(0), m_octtree_idx(3), m_sufficient_nb_points(0)
 {
 
 
@@ -57,7 +57,7 @@ CLinearInterpolator::CLinearInterpolator( const std::string& name )
       ->description("The number of divisions in each direction of the comb. "
                         "Takes precedence over \"ApproximateNbElementsPerCell\". ");
 
-  m_elements = create_component_ptr<CUnifiedData>("elements");
+  m_octtree = create_static_component_ptr<COcttree>("octtree");
 
 }
 
@@ -68,8 +68,14 @@ void CLinearInterpolator::construct_internal_storage(const CMesh& source)
   if (m_source_mesh != source.as_ptr<CMesh>())
   {
     m_source_mesh = source.as_ptr<CMesh>();
-    create_bounding_box();
-    create_octtree();
+    m_dim = m_source_mesh->dimension();
+
+    m_octtree->configure_option("nb_elems_per_cell", option("ApproximateNbElementsPerCell").value<Uint>());
+    m_octtree->configure_option("nb_cells", option("Divisions").value< std::vector<Uint> >());
+    m_octtree->configure_option("mesh", m_source_mesh->uri());
+    m_octtree->create_octtree();
+
+    m_sufficient_nb_points = static_cast<Uint>(std::pow(3.,(int)m_dim));
   }
 }
 
@@ -81,33 +87,26 @@ void CLinearInterpolator::interpolate_field_from_to(const CField& source, CField
   CTable<Real>& t_data = target.data();
 
   // Allocations
-  CElements::ConstPtr s_elements;
   Uint s_elm_idx;
   RealVector t_node(m_dim); t_node.setZero();
 
   if (source.basis() == CField::Basis::POINT_BASED && target.basis() == CField::Basis::POINT_BASED)
   {
+    RealMatrix t_points(t_data.size(),m_dim);
+    RealMatrix t_values(t_data.size(),t_data.row_size());
     for (Uint t_node_idx=0; t_node_idx<t_data.size(); ++t_node_idx)
     {
       to_vector(t_node,target.coords(t_node_idx));
-      boost::tie(s_elements,s_elm_idx) = find_element(t_node);
-      if (is_not_null(s_elements))
-      {
-        CConnectivity::ConstRow s_elm = s_elements->node_connectivity()[s_elm_idx];
-        std::vector<RealVector> s_nodes(s_elm.size(),RealVector(m_dim));
-        fill( s_nodes , s_elements->nodes().coordinates() , s_elm );
-
-        std::vector<Real> w(s_nodes.size());
-        pseudo_laplacian_weighted_linear_interpolation(s_nodes, t_node, w);
+      t_points.row(t_node_idx) = t_node.transpose();
+      for (Uint idata=0; idata<t_data.row_size(); ++idata)
+        t_values(t_node_idx,idata) = t_data[t_node_idx][idata];
+    }
 
-        for (Uint idata=0; idata<t_data.row_size(); ++idata)
-          t_data[t_node_idx][idata] = 0;
+    interpolate_from_points(source,t_points,t_values);
 
-        for (Uint s_node_idx=0; s_node_idx<s_nodes.size(); ++s_node_idx)
-          for (Uint idata=0; idata<t_data.row_size(); ++idata)
-            t_data[t_node_idx][idata] += w[s_node_idx]*s_data[s_elm[s_node_idx]][idata];
-      }
-    }
+    for (Uint t_node_idx=0; t_node_idx<t_data.size(); ++t_node_idx)
+      for (Uint idata=0; idata<t_data.row_size(); ++idata)
+        t_data[t_node_idx][idata] = t_values(t_node_idx,idata);
   }
   else if (source.basis() == CField::Basis::ELEMENT_BASED && target.basis() == CField::Basis::POINT_BASED)
   {
@@ -115,7 +114,7 @@ void CLinearInterpolator::interpolate_field_from_to(const CField& source, CField
     for (Uint t_node_idx=0; t_node_idx<t_data.size(); ++t_node_idx)
     {
       to_vector(t_node,target.coords(t_node_idx));
-      if (find_point_in_octtree(t_node,m_point_idx))
+      if (m_octtree->find_octtree_cell(t_node,m_octtree_idx))
       {
         find_pointcloud(m_sufficient_nb_points);
 
@@ -124,7 +123,7 @@ void CLinearInterpolator::interpolate_field_from_to(const CField& source, CField
         Uint cnt(0);
         boost_foreach(const Uint glb_elem_idx, m_element_cloud)
         {
-          boost::tie(component,s_elm_idx)=m_elements->location(glb_elem_idx);
+          boost::tie(component,s_elm_idx)=m_octtree->unified_elements().location(glb_elem_idx);
           CElements const& elements = component->as_type<CElements const>();
           RealMatrix elem_coords = elements.get_coordinates(s_elm_idx);
           elements.element_type().compute_centroid(elem_coords,s_centroids[cnt]);
@@ -153,38 +152,31 @@ void CLinearInterpolator::interpolate_field_from_to(const CField& source, CField
     CFieldView t_view("t_view");
     t_view.set_field(target);
     RealVector t_centroid(m_dim);
-    t_centroid.setZero();
-    Uint s_elm_idx;
     RealMatrix elem_coordinates;
 
     boost_foreach( CElements& t_elements, find_components_recursively<CElements>(target.topology()) )
     {
       if (t_view.set_elements(t_elements))
       {
+        RealMatrix t_points(t_elements.size(),m_dim);
+        RealMatrix t_values(t_elements.size(),t_data.row_size());
+
         t_elements.allocate_coordinates(elem_coordinates);
         for (Uint t_elm_idx=0; t_elm_idx<t_elements.size(); ++t_elm_idx)
         {
           t_elements.put_coordinates(elem_coordinates,t_elm_idx);
           t_elements.element_type().compute_centroid(elem_coordinates,t_centroid);
+          to_vector(t_node,t_centroid);
+          t_points.row(t_elm_idx) = t_node.transpose();
+          for (Uint idata=0; idata<t_data.row_size(); ++idata)
+            t_values(t_elm_idx,idata) = t_view[t_elm_idx][idata];
+        }
 
-          boost::tie(s_elements,s_elm_idx) = find_element(t_centroid);
-          if (is_not_null(s_elements))
-          {
-            CConnectivity::ConstRow s_elm = s_elements->node_connectivity()[s_elm_idx];
-            std::vector<RealVector> s_nodes(s_elm.size(),RealVector(m_dim));
-            fill( s_nodes , s_elements->nodes().coordinates() , s_elm );
-
-            std::vector<Real> w(s_nodes.size());
-            pseudo_laplacian_weighted_linear_interpolation(s_nodes, t_centroid, w);
+        interpolate_from_points(source,t_points,t_values);
 
-            for (Uint idata=0; idata<t_data.row_size(); ++idata)
-              t_view[t_elm_idx][idata] = 0;
-
-            for (Uint s_node_idx=0; s_node_idx<s_nodes.size(); ++s_node_idx)
-              for (Uint idata=0; idata<t_data.row_size(); ++idata)
-                t_view[t_elm_idx][idata] += w[s_node_idx]*s_data[s_elm[s_node_idx]][idata];
-          }
-        }
+        for (Uint t_elm_idx=0; t_elm_idx<t_elements.size(); ++t_elm_idx)
+          for (Uint idata=0; idata<t_data.row_size(); ++idata)
+            t_view[t_elm_idx][idata] = t_values(t_elm_idx,idata);
       }
     }
   }
@@ -194,7 +186,6 @@ void CLinearInterpolator::interpolate_field_from_to(const CField& source, CField
     t_view.set_field(target);
     RealVector t_centroid(m_dim);
     t_centroid.setZero();
-    Uint s_elm_idx;
     //Uint t_elm_idx;
     RealMatrix elem_coordinates;
     Component::ConstPtr component;
@@ -210,7 +201,7 @@ void CLinearInterpolator::interpolate_field_from_to(const CField& source, CField
 
 
 
-          if (find_point_in_octtree(t_centroid,m_point_idx))
+          if (m_octtree->find_octtree_cell(t_centroid,m_octtree_idx))
           {
             find_pointcloud(m_sufficient_nb_points);
             std::vector<Uint> s_data_idx(m_element_cloud.size());
@@ -218,7 +209,7 @@ void CLinearInterpolator::interpolate_field_from_to(const CField& source, CField
             Uint cnt(0);
             boost_foreach(const Uint glb_elem_idx, m_element_cloud)
             {
-              boost::tie(component,s_elm_idx)=m_elements->location(glb_elem_idx);
+              boost::tie(component,s_elm_idx)=m_octtree->unified_elements().location(glb_elem_idx);
               CElements const& elements = component->as_type<CElements>();
 
               RealMatrix elem_coords = elements.get_coordinates(s_elm_idx);
@@ -253,151 +244,39 @@ void CLinearInterpolator::interpolate_field_from_to(const CField& source, CField
 
 //////////////////////////////////////////////////////////////////////
 
-void CLinearInterpolator::create_bounding_box()
-{
-  m_dim=m_source_mesh->dimension();
-
-  // find bounding box coordinates for region 1 and region 2
-  m_bounding[MIN].setConstant(real_max());
-  m_bounding[MAX].setConstant(real_min());
-
-  boost_foreach(CTable<Real>::ConstRow coords, m_source_mesh->nodes().coordinates().array())
-  {
-    for (Uint d=0; d<m_dim; ++d)
-    {
-      m_bounding[MIN][d] = std::min(m_bounding[MIN][d],  coords[d]);
-      m_bounding[MAX][d] = std::max(m_bounding[MAX][d],  coords[d]);
-    }
-  }
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void CLinearInterpolator::create_octtree()
+void CLinearInterpolator::interpolate_from_points(const CField& source, const RealMatrix& t_points, RealMatrix& t_values)
 {
-  std::vector<Real> L(3);
-
-  Real V=1;
-  for (Uint d=0; d<m_dim; ++d)
-  {
-    L[d] = m_bounding[MAX][d] - m_bounding[MIN][d];
-    V*=L[d];
-  }
-
-  m_nb_elems = m_source_mesh->properties().value<Uint>("nb_cells");
-
-  if (option("Divisions").value<std::vector<Uint> >().size() > 0)
-  {
-    m_N = option("Divisions").value<std::vector<Uint> >();
-    for (Uint d=0; d<m_dim; ++d)
-      m_D[d] = (L[d])/static_cast<Real>(m_N[d]);
-  }
-  else
-  {
-    Real V1 = V/m_nb_elems;
-    Real D1 = std::pow(V1,1./m_dim)*option("ApproximateNbElementsPerCell").value<Uint>();
-
-    for (Uint d=0; d<m_dim; ++d)
-    {
-      m_N[d] = (Uint) std::ceil(L[d]/D1);
-      m_D[d] = (L[d])/static_cast<Real>(m_N[d]);
-    }
-  }
-
-  CFinfo << "Honeycomb:" << CFendl;
-  CFinfo << "----------" << CFendl;
-  for (Uint d=0; d<m_dim; ++d)
-  {
-    CFinfo << "range["<<d<<"] :   L = " << L[d] << "    N = " << m_N[d] << "    D = " << m_D[d] << CFendl;
-  }
-  CFinfo << "V = " << V << CFendl;
-
-  // initialize the honeycomb
-  m_honeycomb.resize(boost::extents[std::max(Uint(1),m_N[0])][std::max(Uint(1),m_N[1])][std::max(Uint(1),m_N[2])]);
-
-  boost_foreach(const CElements& elements, find_components_recursively_with_filter<CElements>(*m_source_mesh,IsElementsVolume()))
-    m_elements->add(elements);
-
-  Uint glb_elem_idx=0;
-  RealVector centroid(m_dim);
-  boost_foreach(const CElements& elements, find_components_recursively_with_filter<CElements>(*m_source_mesh,IsElementsVolume()))
-  {
-    Uint nb_nodes_per_element = elements.node_connectivity().row_size();
-    RealMatrix coordinates(nb_nodes_per_element,m_dim);
-
-    for (Uint elem_idx=0; elem_idx<elements.size(); ++elem_idx)
-    {
-      elements.put_coordinates(coordinates,elem_idx);
-      elements.element_type().compute_centroid(coordinates,centroid);
-      for (Uint d=0; d<m_dim; ++d)
-        m_point_idx[d]=std::min((Uint) std::floor( (centroid[d] - m_bounding[MIN][d])/m_D[d]), m_N[d]-1 );
-      m_honeycomb[m_point_idx[0]][m_point_idx[1]][m_point_idx[2]].push_back(glb_elem_idx);
-      ++glb_elem_idx;
-    }
-  }
-
-
-  Uint total=0;
-
-  switch (m_dim)
-  {
-    case DIM_2D:
-      for (Uint i=0; i<m_N[0]; ++i)
-        for (Uint j=0; j<m_N[1]; ++j)
-        {
-          Uint k=0;
-          // CFinfo << "("<<i<<","<<j<<") has elems ";
-          // if (m_honeycomb[i][j][k].size())
-          //   CFinfo << Mesh::to_vector(m_honeycomb[i][j][k]).transpose() << CFendl;
-          // else
-          //   CFinfo << CFendl;
-          total += m_honeycomb[i][j][k].size();
-        }
-      break;
-    case DIM_3D:
-      for (Uint i=0; i<m_N[0]; ++i)
-        for (Uint j=0; j<m_N[1]; ++j)
-          for (Uint k=0; k<m_N[2]; ++k)
-          {
-            // CFinfo << "("<<i<<","<<j<<","<<k<<") has elems ";
-            // if (m_honeycomb[i][j][k].size())
-            //   CFinfo << Mesh::to_vector(m_honeycomb[i][j][k]).transpose() << CFendl;
-            // else
-            //   CFinfo << CFendl;
-            total += m_honeycomb[i][j][k].size();
-          }
-      break;
-    default:
-      break;
-  }
-
-  CFinfo << "total = " << total << " of " << m_nb_elems << CFendl;
-
-  m_sufficient_nb_points = static_cast<Uint>(std::pow(3.,(int)m_dim));
-
-}
-
+  const CTable<Real>& s_data = source.data();
 
-//////////////////////////////////////////////////////////////////////////////
+  // locate all the target points at once
+  std::vector<Uint> s_unified_elems;
+  m_octtree->find_elements(t_points,s_unified_elems);
 
-bool CLinearInterpolator::find_point_in_octtree(const RealVector& coordinate, std::vector<Uint>& point_idx)
-{
-  //CFinfo << "point " << coordinate << CFflush;
-  cf_assert(coordinate.size() == static_cast<int>(m_dim));
-
-  for (Uint d=0; d<m_dim; ++d)
+  Component::ConstPtr component;
+  Uint s_elm_idx;
+  RealVector t_point(m_dim);
+  std::vector<RealVector> s_nodes;
+  std::vector<Real> w;
+  for (Uint t_pt_idx=0; t_pt_idx<s_unified_elems.size(); ++t_pt_idx)
   {
-    if ( (coordinate[d] - m_bounding[MIN][d])/m_D[d] > m_N[d])
-    {
-      //CFinfo << "coord["<<d<<"] = " << coordinate[d] <<" is not inside bounding box" << CFendl;
-      //CFinfo << (coordinate[d] - m_ranges[d][0])/m_D[d] << " > " << m_N[d] << CFendl;
-      return false; // no index found
-    }
-    point_idx[d] = std::min((Uint) std::floor( (coordinate[d] - m_bounding[MIN][d])/m_D[d]), m_N[d]-1 );
+    if (s_unified_elems[t_pt_idx] == uint_max())
+      continue;
+
+    boost::tie(component,s_elm_idx) = m_octtree->unified_elements().location(s_unified_elems[t_pt_idx]);
+    const CElements& s_elements = component->as_type<CElements const>();
+    CConnectivity::ConstRow s_elm = s_elements.node_connectivity()[s_elm_idx];
+    s_nodes.resize(s_elm.size(),RealVector(m_dim));
+    fill( s_nodes , s_elements.nodes().coordinates() , s_elm );
+
+    t_point = t_points.row(t_pt_idx).transpose();
+    w.resize(s_elm.size());
+    pseudo_laplacian_weighted_linear_interpolation(s_nodes, t_point, w);
+
+    t_values.row(t_pt_idx).setZero();
+    for (Uint s_node_idx=0; s_node_idx<s_elm.size(); ++s_node_idx)
+      for (Uint idata=0; idata<t_values.cols(); ++idata)
+        t_values(t_pt_idx,idata) += w[s_node_idx]*s_data[s_elm[s_node_idx]][idata];
   }
-
-  //CFinfo << " should be in box ("<<m_point_idx[0]<<","<<m_point_idx[1]<<","<<m_point_idx[2]<<")" << CFendl;
-  return true;
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -405,83 +284,11 @@ bool CLinearInterpolator::find_point_in_octtree(const RealVector& coordinate, st
 void CLinearInterpolator::find_pointcloud(Uint nb_points)
 {
   m_element_cloud.resize(0);
-  Uint r=1;
-  int i(0), j(0), k(0);
-  int imin, jmin, kmin;
-  int imax, jmax, kmax;
-
-  if (m_honeycomb[m_point_idx[0]][m_point_idx[1]][m_point_idx[2]].size() <= nb_points)
-    r=0;
-
-  while (m_element_cloud.size() < nb_points && m_element_cloud.size() < m_nb_elems)
-  {
-    ++r;
-    m_element_cloud.resize(0);
-
-    switch (m_dim)
-    {
-      case DIM_3D:
-        imin = std::max(int(m_point_idx[0])-int(r), 0);  imax = std::min(int(m_point_idx[0])+int(r),int(m_N[0])-1);
-        jmin = std::max(int(m_point_idx[1])-int(r), 0);  jmax = std::min(int(m_point_idx[1])+int(r),int(m_N[1])-1);
-        kmin = std::max(int(m_point_idx[2])-int(r), 0);  kmax = std::min(int(m_point_idx[2])+int(r),int(m_N[2])-1);
-        for (i = imin; i <= imax; ++i)
-          for (j = jmin; j <= jmax; ++j)
-            for (k = kmin; k <= kmax; ++k)
-            {
-              boost_foreach(const Uint glb_elem_idx, m_honeycomb[i][j][k])
-              m_element_cloud.push_back(glb_elem_idx);
-              //CFinfo << "   ("<<i<<","<<j<<","<<k<<")" <<  CFendl;
-            }
-        break;
-      case DIM_2D:
-        imin = std::max(int(m_point_idx[0])-int(r), 0);  imax = std::min(int(m_point_idx[0])+int(r),int(m_N[0])-1);
-        jmin = std::max(int(m_point_idx[1])-int(r), 0);  jmax = std::min(int(m_point_idx[1])+int(r),int(m_N[1])-1);
-        for (i = imin; i <= imax; ++i)
-          for (j = jmin; j <= jmax; ++j)
-          {
-            boost_foreach(const Uint glb_elem_idx, m_honeycomb[i][j][k])
-            m_element_cloud.push_back(glb_elem_idx);
-            //CFinfo << "   ("<<i<<","<<j<<","<<k<<")" <<  CFendl;
-          }
-        break;
-      case DIM_1D:
-        imin = std::max(int(m_point_idx[0])-int(r), 0);  imax = std::min(int(m_point_idx[0])+int(r),int(m_N[0])-1);
-        for (i = imin; i <= imax; ++i)
-        {
-          boost_foreach(const Uint glb_elem_idx, m_honeycomb[i][j][k])
-          m_element_cloud.push_back(glb_elem_idx);
-          //CFinfo << "   ("<<i<<","<<j<<","<<k<<")" <<  CFendl;
-        }
-        break;
-    }
-  }
 
-  //CFinfo << m_pointcloud.size() << " points in the pointcloud " << CFendl;
-
-}
-
-//////////////////////////////////////////////////////////////////////////////
-
-boost::tuple<CElements::ConstPtr,Uint> CLinearInterpolator::find_element(const RealVector& target_coord)
-{
-  if (find_point_in_octtree(target_coord,m_point_idx))
-  {
-    find_pointcloud(1);
-
-    Component::ConstPtr component;
-    Uint elem_idx;
-    boost_foreach(const Uint glb_elem_idx, m_element_cloud)
-    {
-      boost::tie(component,elem_idx)=m_elements->location(glb_elem_idx);
-      const CElements& elements = component->as_type<CElements>();
-      RealMatrix elem_coordinates = elements.get_coordinates(elem_idx);
-      if (elements.element_type().is_coord_in_element(target_coord,elem_coordinates))
-      {
-        return boost::make_tuple(elements.as_ptr<CElements>(),elem_idx);
-      }
-    }
-  }
-  return boost::make_tuple(CElements::ConstPtr(), 0u);
+  // grow the rings around the octtree cell until enough elements are gathered
+  const Uint nb_elems = m_octtree->unified_elements().size();
+  for (Uint ring=0; m_element_cloud.size() < nb_points && m_element_cloud.size() < nb_elems; ++ring)
+    m_octtree->gather_elements_around_idx(m_octtree_idx,ring,m_element_cloud);
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -14,6 +14,7 @@
 #include "Mesh/CInterpolator.hpp"
 #include "Mesh/CElements.hpp"
 #include "Mesh/CUnifiedData.hpp"
+#include "Mesh/COcttree.hpp"
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -31,12 +32,6 @@ public: // typedefs
   typedef boost::shared_ptr<CLinearInterpolator> Ptr;
   typedef boost::shared_ptr<CLinearInterpolator const> ConstPtr;
 
-private: // typedefs
-
-  typedef std::pair<const CElements*,Uint> Point;
-  typedef boost::multi_array<std::vector<Uint> ,3> Honeycomb;
-  typedef std::vector<const Point*> Pointcloud;
-
 public: // functions
   /// constructor
   CLinearInterpolator( const std::string& name );
@@ -55,26 +50,17 @@ private: // functions
 	/// @param target [out] the target field
 	virtual void interpolate_field_from_to(const CField& source, CField& target);
 
-	/// Create the octtree for fast searching in which element a coordinate can be found
-	void create_bounding_box();
-
-	void create_octtree();
-
-  /// Given a coordinate, find which box in the octtree it is located in
-  /// @param coordinate [in]  The coordinate to look for
-  /// @param point_idx  [out] box location in the octtree (i,j,k)
-  /// @return true if the coordinate is found inside the honeycomb
-  bool find_point_in_octtree(const RealVector& coordinate, std::vector<Uint>& point_idx);
-
 	/// Find the pointcloud of minimum "nb_points" points
-	/// It is assumed that first "find_comb_idx(coordinate)" is called
+	/// It is assumed that first "m_octtree->find_octtree_cell(coordinate,m_octtree_idx)" is called
 	/// @param nb_points [in] the minimum number of points in the point cloud
 	void find_pointcloud(Uint nb_points);
 
-	/// Find one single element in which the given coordinate resides.
-	/// @param target_coord [in] the given coordinate
-	/// @return the elements region, and the local coefficient in this region
-	boost::tuple<CElements::ConstPtr,Uint> find_element(const RealVector& target_coord);
+	/// Interpolate a point based source field in a batch of target points
+	/// @param source    [in]  the point based source field
+	/// @param t_points  [in]  the target points, one per row
+	/// @param t_values  [out] the interpolated values, one row per target point.
+	///                        Rows of points outside the source mesh are left untouched.
+	void interpolate_from_points(const CField& source, const RealMatrix& t_points, RealMatrix& t_values);
 
 	/// Pseudo-Laplacian weighted linear interpolation algorithm
 	/// @param source_points [in] The coordinates of the points used for interpolation
@@ -97,22 +83,14 @@ private: // data
 
   CMesh::ConstPtr m_source_mesh;
 
-  Pointcloud m_pointcloud;
-  Honeycomb m_honeycomb;
+  /// search structures of the source mesh
+  COcttree::Ptr m_octtree;
 
   Uint m_dim;
-  enum {MIN=0,MAX=1};
-  std::vector< RealVector3, Eigen::aligned_allocator<RealVector3> > m_bounding;
-  std::vector<Uint> m_N;
-  std::vector<Real> m_D;
-  std::vector<Uint> m_point_idx;
-
-  Uint m_nb_elems;
+  std::vector<Uint> m_octtree_idx;
 
   Uint m_sufficient_nb_points;
 
-  CUnifiedData::Ptr m_elements;
-
   std::vector<Uint> m_element_cloud;
 
 }; // end CLinearInterpolator
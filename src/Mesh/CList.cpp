@@ -20,6 +20,8 @@ Common::ComponentBuilder < CList<bool>, Component, LibMesh > CList_bool_Builder;
 
 Common::ComponentBuilder < CList<Uint>, Component, LibMesh > CList_Uint_Builder;
 
+Common::ComponentBuilder < CList<Gid>, Component, LibMesh > CList_Gid_Builder;
+
 Common::ComponentBuilder < CList<int>, Component, LibMesh >  CList_int_Builder;
 
 Common::ComponentBuilder < CList<Real>, Component, LibMesh > CList_Real_Builder;
@@ -50,6 +52,17 @@ std::ostream& operator<<(std::ostream& os, const CList<Uint>& list)
   return os;
 }
 
+std::ostream& operator<<(std::ostream& os, const CList<Gid>& list)
+{
+  if (list.size())
+    os << "\n";
+  for (Uint i=0; i<list.size(); ++i)
+  {
+    os << "  " << i << ":  " << list[i] << "\n";
+  }
+  return os;
+}
+
 std::ostream& operator<<(std::ostream& os, const CList<int>& list)
 {
   if (list.size())
@@ -47,7 +47,7 @@ public: // typedefs
   typedef ValueT value_type;
 
   /// @brief the type of the internal structure of the list
-  typedef boost::multi_array<ValueT,1> ListT;
+  typedef boost::multi_array<ValueT,1,Common::Allocator<ValueT> > ListT;
 
   /// @brief the type of the buffer used to interact with the table
   typedef ListBufferT<ValueT> Buffer;
@@ -129,6 +129,7 @@ private: // data
 
 std::ostream& operator<<(std::ostream& os, const CList<bool>& list);
 std::ostream& operator<<(std::ostream& os, const CList<Uint>& list);
+std::ostream& operator<<(std::ostream& os, const CList<Gid>& list);
 std::ostream& operator<<(std::ostream& os, const CList<int>& list);
 std::ostream& operator<<(std::ostream& os, const CList<Real>& list);
 std::ostream& operator<<(std::ostream& os, const CList<std::string>& list);
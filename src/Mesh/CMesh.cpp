@@ -222,6 +222,9 @@ CField& CMesh::create_scalar_field( const std::string& name , CField& based_on_f
   std::string space; based_on_field.option("Space").put_value(space);
   field.configure_option("Space",space);
 
+  std::string layout; based_on_field.option("Layout").put_value(layout);
+  field.configure_option("Layout",layout);
+
   field.create_data_storage();
 
   return field;
@@ -250,6 +253,9 @@ CField& CMesh::create_field( const std::string& name , CField& based_on_field)
   std::string space; based_on_field.option("Space").put_value(space);
   field.configure_option("Space",space);
 
+  std::string layout; based_on_field.option("Layout").put_value(layout);
+  field.configure_option("Layout",layout);
+
   field.create_data_storage();
   return field;
 
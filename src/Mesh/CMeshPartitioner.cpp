@@ -20,6 +20,8 @@
 #include "Common/XML/Protocol.hpp"
 #include "Common/XML/SignalOptions.hpp"
 
+#include "Math/Consts.hpp"
+
 #include "Mesh/CMesh.hpp"
 #include "Mesh/CList.hpp"
 #include "Mesh/CMeshPartitioner.hpp"
@@ -28,6 +30,7 @@
 #include "Mesh/CRegion.hpp"
 #include "Mesh/Manipulations.hpp"
 #include "Mesh/CMeshElements.hpp"
+#include "Mesh/CStructuredBlocks.hpp"
 
 namespace CF {
 namespace Mesh {
@@ -50,7 +53,7 @@ CMeshPartitioner::CMeshPartitioner ( const std::string& name ) :
       ->link_to(&m_nb_parts)
       ->mark_basic();
 
-  m_global_to_local = create_static_component_ptr<CMap<Uint,Uint> >("global_to_local");
+  m_global_to_local = create_static_component_ptr<CMap<Gid,Uint> >("global_to_local");
   m_lookup = create_static_component_ptr<CUnifiedData >("lookup");
 
   regist_signal( "load_balance" )
@@ -138,7 +141,7 @@ void CMeshPartitioner::initialize(CMesh& mesh)
   m_end_node_per_part.resize(mpi::PE::instance().size());
   m_end_elem_per_part.resize(mpi::PE::instance().size());
 
-  Uint start_id(0);
+  Gid start_id(0);
   for (Uint p=0; p<mpi::PE::instance().size(); ++p)
   {
     m_start_id_per_part[p]   = start_id;
@@ -173,7 +176,7 @@ void CMeshPartitioner::build_global_to_local_index(CMesh& mesh)
     m_lookup->add(elements);
 
   m_nb_owned_obj = 0;
-  CList<Uint>& node_glb_idx = nodes.glb_idx();
+  CList<Gid>& node_glb_idx = nodes.glb_idx();
   for (Uint i=0; i<nodes.size(); ++i)
   {
     if (!nodes.is_ghost(i))
@@ -192,7 +195,7 @@ void CMeshPartitioner::build_global_to_local_index(CMesh& mesh)
   m_global_to_local->reserve(tot_nb_obj);
   Uint loc_idx=0;
   //CFinfo << "adding nodes to map " << CFendl;
-  boost_foreach (Uint glb_idx, node_glb_idx.array())
+  boost_foreach (const Gid glb_idx, node_glb_idx.array())
   {
     //CFinfo << "  adding node with glb " << glb_idx << CFendl;
     if (nodes.is_ghost(loc_idx) == false)
@@ -217,7 +220,7 @@ void CMeshPartitioner::build_global_to_local_index(CMesh& mesh)
   //CFinfo << "adding elements " << CFendl;
   boost_foreach ( CElements& elements, find_components_recursively<CElements>(mesh))
   {
-    boost_foreach (Uint glb_idx, elements.glb_idx().array())
+    boost_foreach (const Gid glb_idx, elements.glb_idx().array())
     {
       cf_assert_desc(to_str(glb_idx)+"<"+to_str(m_start_elem_per_part[mpi::PE::instance().rank()]),glb_idx >= m_start_elem_per_part[mpi::PE::instance().rank()]);
       cf_assert_desc(to_str(glb_idx)+">="+to_str(m_end_elem_per_part[mpi::PE::instance().rank()]),glb_idx < m_end_elem_per_part[mpi::PE::instance().rank()]);
@@ -273,9 +276,9 @@ void CMeshPartitioner::show_changes()
 
 //////////////////////////////////////////////////////////////////////////////
 
-boost::tuple<Uint,Uint> CMeshPartitioner::location_idx(const Uint glb_obj) const
+boost::tuple<Uint,Uint> CMeshPartitioner::location_idx(const Gid glb_obj) const
 {
-  CMap<Uint,Uint>::const_iterator itr = m_global_to_local->find(glb_obj);
+  CMap<Gid,Uint>::const_iterator itr = m_global_to_local->find(glb_obj);
   if (itr != m_global_to_local->end() )
   {
     return m_lookup->location_idx(itr->second);
@@ -285,7 +288,7 @@ boost::tuple<Uint,Uint> CMeshPartitioner::location_idx(const Uint glb_obj) const
 
 //////////////////////////////////////////////////////////////////////////////
 
-boost::tuple<Component::Ptr,Uint> CMeshPartitioner::location(const Uint glb_obj) const
+boost::tuple<Component::Ptr,Uint> CMeshPartitioner::location(const Gid glb_obj) const
 {
   return m_lookup->location( (*m_global_to_local)[glb_obj] );
 }
@@ -311,7 +314,7 @@ void flex_all_gather(const std::vector<T>& send, std::vector<std::vector<T> >& r
       displs[i] = displs[i-1] + strides[i-1];
       sum_strides += strides[i];
     }
-    std::vector<Uint> recv_linear(sum_strides);
+    std::vector<T> recv_linear(sum_strides);
     MPI_CHECK_RESULT(MPI_Allgatherv, ((void*)&send[0], (int)send.size(), get_mpi_datatype<T>(), &recv_linear[0], &strides[0], &displs[0], get_mpi_datatype<T>(), mpi::PE::instance().communicator()));
     recv.resize(strides.size());
     for (Uint i=0; i<strides.size(); ++i)
@@ -353,8 +356,8 @@ void flex_all_to_all(const std::vector<std::vector<T> >& send, std::vector<std::
   for (Uint i=1; i<mpi::PE::instance().size(); ++i)
     recv_displs[i] = recv_displs[i-1] + recv_strides[i-1];
 
-  std::vector<Uint> recv_linear(recv_displs.back()+recv_strides.back());
-  MPI_CHECK_RESULT(MPI_Alltoallv, (&send_linear[0], &send_strides[0], &send_displs[0], mpi::get_mpi_datatype<Uint>(), &recv_linear[0], &recv_strides[0], &recv_displs[0], get_mpi_datatype<Uint>(), mpi::PE::instance().communicator()));
+  std::vector<T> recv_linear(recv_displs.back()+recv_strides.back());
+  MPI_CHECK_RESULT(MPI_Alltoallv, (&send_linear[0], &send_strides[0], &send_displs[0], mpi::get_mpi_datatype<T>(), &recv_linear[0], &recv_strides[0], &recv_displs[0], get_mpi_datatype<T>(), mpi::PE::instance().communicator()));
 
   recv.resize(recv_strides.size());
   for (Uint i=0; i<recv_strides.size(); ++i)
@@ -471,18 +474,26 @@ void CMeshPartitioner::migrate()
         element_manipulation.remove(e);
     }
     /// @todo mechanism not to flush element_manipulation until during real migration
+
+    // the elements are reordered, and lose their block structure
+    if (CStructuredBlocks::Ptr structured_blocks = find_component_ptr<CStructuredBlocks>(elements))
+      elements.remove_component(*structured_blocks);
   }
 
   // -----------------------------------------------------------------------------
   // SET NODE CONNECTIVITY TO GLOBAL NUMBERS BEFORE PARTITIONING
+  /// @todo the connectivity table is 32 bit, migrate the global node numbers
+  ///       in a separate table to partition meshes with more than 2^32 nodes
 
-  const CList<Uint>& global_node_indices = mesh.nodes().glb_idx();
+  const CList<Gid>& global_node_indices = mesh.nodes().glb_idx();
   boost_foreach (CEntities& elements, mesh.topology().elements_range())
   {
     boost_foreach ( CTable<Uint>::Row nodes, elements.as_type<CElements>().node_connectivity().array() )
     {
       boost_foreach ( Uint& node, nodes )
       {
+        if (global_node_indices[node] > Gid(Math::Consts::uint_max()))
+          throw NotSupported(FromHere(), "Migration of node with glb_idx "+to_str(global_node_indices[node])+", which does not fit in the connectivity table");
         node = global_node_indices[node];
       }
     }
@@ -572,11 +583,11 @@ void CMeshPartitioner::migrate()
   // -----------------------------------------------------------------------------
   // COLLECT GHOST-NODES TO LOOK FOR ON OTHER PROCESSORS
 
-  std::set<Uint> owned_nodes;
+  std::set<Gid> owned_nodes;
   for (Uint n=0; n<nodes.size(); ++n)
     owned_nodes.insert(nodes.glb_idx()[n]);
 
-  std::set<Uint> ghost_nodes;
+  std::set<Gid> ghost_nodes;
   boost_foreach(const CElements& elements, find_components_recursively<CElements>(mesh.topology()))
   {
     boost_foreach(CConnectivity::ConstRow connected_nodes, elements.node_connectivity().array())
@@ -589,19 +600,19 @@ void CMeshPartitioner::migrate()
     }
   }
 
-  std::vector<Uint> request_nodes;  request_nodes.reserve(ghost_nodes.size());
-  boost_foreach(const Uint node, ghost_nodes)
+  std::vector<Gid> request_nodes;  request_nodes.reserve(ghost_nodes.size());
+  boost_foreach(const Gid node, ghost_nodes)
     request_nodes.push_back(node);
 
 
   // -----------------------------------------------------------------------------
   // SEARCH FOR REQUESTED NODES
-  // in  : requested nodes                std::vector<Uint>
+  // in  : requested nodes                std::vector<Gid>
   // out : buffer with packed nodes       mpi::Buffer(nodes)
 
   // COMMUNICATE NODES TO LOOK FOR
 
-  std::vector<std::vector<Uint> > recv_request_nodes;
+  std::vector<std::vector<Gid> > recv_request_nodes;
   flex_all_gather(request_nodes,recv_request_nodes);
 
 
@@ -614,13 +625,13 @@ void CMeshPartitioner::migrate()
 
       for (Uint n=0; n<recv_request_nodes[proc].size(); ++n)
       {
-        Uint find_glb_idx = recv_request_nodes[proc][n];
+        Gid find_glb_idx = recv_request_nodes[proc][n];
 
         // +--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+
         /// @todo THIS ALGORITHM HAS TO BE IMPROVED (BRUTE FORCE)
         Uint loc_idx=0;
         bool found=false;
-        boost_foreach(const Uint glb_idx, nodes.glb_idx().array())
+        boost_foreach(const Gid glb_idx, nodes.glb_idx().array())
         {
 
           cf_assert(loc_idx < nodes.size());
@@ -660,8 +671,8 @@ void CMeshPartitioner::migrate()
 
   // -----------------------------------------------------------------------------
   // FIX NODE CONNECTIVITY
-  std::map<Uint,Uint> glb_to_loc;
-  std::map<Uint,Uint>::iterator it;
+  std::map<Gid,Uint> glb_to_loc;
+  std::map<Gid,Uint>::iterator it;
   bool inserted;
   for (Uint n=0; n<nodes.size(); ++n)
   {
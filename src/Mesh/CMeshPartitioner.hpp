@@ -98,6 +98,13 @@ public: // functions
   template <typename VectorT>
   void list_of_connected_procs_in_part(const Uint part, VectorT& proc_per_neighbor) const;
 
+  /// Weight of each object owned by the part, in the order of list_of_objects_owned_by_part().
+  /// The weight is the Real property "partition_weight" of the nodes or elements
+  /// component holding the object, or 1 if this property is not set.
+  /// All objects of a component thus have the same weight.
+  template <typename VectorT>
+  void list_of_object_weights_in_part(const Uint part, VectorT& weights) const;
+
 
 public: // functions
 
@@ -107,23 +114,23 @@ public: // functions
 
 protected: // functions
 
-  bool is_node(const Uint glb_obj) const
+  bool is_node(const Gid glb_obj) const
   {
     Uint p = part_of_obj(glb_obj);
     return m_start_node_per_part[p] <= glb_obj && glb_obj < m_end_node_per_part[p];
   }
 
-  bool is_elem(const Uint glb_obj) const
+  bool is_elem(const Gid glb_obj) const
   {
     Uint p = part_of_obj(glb_obj);
     return m_start_node_per_part[p] <= glb_obj && glb_obj < m_end_node_per_part[p];
   }
 
-  boost::tuple<Uint,Uint> location_idx(const Uint glb_obj) const;
+  boost::tuple<Uint,Uint> location_idx(const Gid glb_obj) const;
 
-  boost::tuple<Common::Component::Ptr,Uint> location(const Uint glb_obj) const;
+  boost::tuple<Common::Component::Ptr,Uint> location(const Gid glb_obj) const;
 
-  Uint part_of_obj(const Uint obj) const
+  Uint part_of_obj(const Gid obj) const
   {
     for (Uint p=0; p<m_end_id_per_part.size(); ++p)
     {
@@ -151,14 +158,14 @@ private: // data
   Uint m_nb_owned_obj;
 
 
-  Common::CMap<Uint,Uint>::Ptr m_global_to_local;
+  Common::CMap<Gid,Uint>::Ptr m_global_to_local;
 
-  std::vector<Uint> m_start_id_per_part;
-  std::vector<Uint> m_end_id_per_part;
-  std::vector<Uint> m_start_node_per_part;
-  std::vector<Uint> m_end_node_per_part;
-  std::vector<Uint> m_start_elem_per_part;
-  std::vector<Uint> m_end_elem_per_part;
+  std::vector<Gid> m_start_id_per_part;
+  std::vector<Gid> m_end_id_per_part;
+  std::vector<Gid> m_start_node_per_part;
+  std::vector<Gid> m_end_node_per_part;
+  std::vector<Gid> m_start_elem_per_part;
+  std::vector<Gid> m_end_elem_per_part;
 
   CUnifiedData::Ptr m_lookup;
 
@@ -177,7 +184,7 @@ template <typename VectorT>
 void CMeshPartitioner::list_of_objects_owned_by_part(const Uint part, VectorT& obj_list) const
 {
   Uint idx=0;
-  foreach_container((const Uint glb_obj),*m_global_to_local)
+  foreach_container((const Gid glb_obj),*m_global_to_local)
   {
     if (part_of_obj(glb_obj) == part)
       obj_list[idx++] = glb_obj;
@@ -194,7 +201,7 @@ Uint CMeshPartitioner::nb_connected_objects_in_part(const Uint part, VectorT& nb
   Uint loc_idx;
   Uint size = 0;
   Uint idx = 0;
-  foreach_container((const Uint glb_obj)(const Uint loc_obj),*m_global_to_local)
+  foreach_container((const Gid glb_obj)(const Uint loc_obj),*m_global_to_local)
   {
     if (part_of_obj(glb_obj) == part)
     {
@@ -202,7 +209,7 @@ Uint CMeshPartitioner::nb_connected_objects_in_part(const Uint part, VectorT& nb
 
       if (CNodes::Ptr nodes = comp->as_ptr<CNodes>())
       {
-        const CDynTable<Uint>& node_to_glb_elm = nodes->glb_elem_connectivity();
+        const CDynTable<Gid>& node_to_glb_elm = nodes->glb_elem_connectivity();
         nb_connections_per_obj[idx] = node_to_glb_elm.row_size(loc_idx);
       }
       else if (CElements::Ptr elements = comp->as_ptr<CElements>())
@@ -228,21 +235,21 @@ void CMeshPartitioner::list_of_connected_objects_in_part(const Uint part, Vector
   Uint loc_idx;
 
   Uint idx = 0;
-  foreach_container((const Uint glb_obj)(const Uint loc_obj),*m_global_to_local)
+  foreach_container((const Gid glb_obj)(const Uint loc_obj),*m_global_to_local)
   {
     if (part_of_obj(glb_obj) == part)
     {
       boost::tie(comp,loc_idx) = m_lookup->location(loc_obj);
       if (CNodes::Ptr nodes = comp->as_ptr<CNodes>())
       {
-        const CDynTable<Uint>& node_to_glb_elm = nodes->glb_elem_connectivity();
-        boost_foreach (const Uint glb_elm , node_to_glb_elm[loc_idx])
+        const CDynTable<Gid>& node_to_glb_elm = nodes->glb_elem_connectivity();
+        boost_foreach (const Gid glb_elm , node_to_glb_elm[loc_idx])
           connected_objects[idx++] = glb_elm;
       }
       else if (CElements::Ptr elements = comp->as_ptr<CElements>())
       {
         const CConnectivity& connectivity_table = elements->node_connectivity();
-        const CList<Uint>& glb_node_indices    = elements->nodes().glb_idx();
+        const CList<Gid>& glb_node_indices     = elements->nodes().glb_idx();
 
         boost_foreach (const Uint loc_node , connectivity_table[loc_idx])
           connected_objects[idx++] = glb_node_indices[ loc_node ];
@@ -264,21 +271,21 @@ void CMeshPartitioner::list_of_connected_procs_in_part(const Uint part, VectorT&
   Uint loc_idx;
 
   Uint idx = 0;
-  foreach_container((const Uint glb_obj)(const Uint loc_obj),*m_global_to_local)
+  foreach_container((const Gid glb_obj)(const Uint loc_obj),*m_global_to_local)
   {
     if (part_of_obj(glb_obj) == part)
     {
       boost::tie(comp,loc_idx) = m_lookup->location(loc_obj);
       if (CNodes::Ptr nodes = comp->as_ptr<CNodes>())
       {
-        const CDynTable<Uint>& node_to_glb_elm = nodes->glb_elem_connectivity();
-        boost_foreach (const Uint glb_elm , node_to_glb_elm[loc_idx])
+        const CDynTable<Gid>& node_to_glb_elm = nodes->glb_elem_connectivity();
+        boost_foreach (const Gid glb_elm , node_to_glb_elm[loc_idx])
           connected_procs[idx++] = part_of_obj(glb_elm); /// @todo should be proc of obj, not part!!!
       }
       else if (CElements::Ptr elements = comp->as_ptr<CElements>())
       {
         const CConnectivity& connectivity_table = elements->node_connectivity();
-        const CList<Uint>& glb_node_indices    = elements->nodes().glb_idx();
+        const CList<Gid>& glb_node_indices     = elements->nodes().glb_idx();
         boost_foreach (const Uint loc_node , connectivity_table[loc_idx])
           connected_procs[idx++] = part_of_obj( glb_node_indices[loc_node] ); /// @todo should be proc of obj, not part!!!
       }
@@ -290,6 +297,36 @@ void CMeshPartitioner::list_of_connected_procs_in_part(const Uint part, VectorT&
 
 //////////////////////////////////////////////////////////////////////////////
 
+template <typename VectorT>
+void CMeshPartitioner::list_of_object_weights_in_part(const Uint part, VectorT& weights) const
+{
+  // declaration for boost::tie
+  Common::Component::Ptr comp;
+  Uint loc_idx;
+
+  // the weight is looked up once per component
+  Common::Component* weight_comp = nullptr;
+  Real weight = 1.;
+
+  Uint idx = 0;
+  foreach_container((const Gid glb_obj)(const Uint loc_obj),*m_global_to_local)
+  {
+    if (part_of_obj(glb_obj) == part)
+    {
+      boost::tie(comp,loc_idx) = m_lookup->location(loc_obj);
+      if (comp.get() != weight_comp)
+      {
+        weight_comp = comp.get();
+        weight = comp->properties().check("partition_weight") ? comp->properties().value<Real>("partition_weight") : 1.;
+      }
+      weights[idx++] = weight;
+    }
+  }
+  cf_assert( idx == nb_objects_owned_by_part(part) );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 } // Mesh
 } // CF
 
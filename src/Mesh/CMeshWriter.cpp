@@ -10,6 +10,7 @@
 #include "Common/OptionT.hpp"
 #include "Common/CEnv.hpp"
 #include "Common/Core.hpp"
+#include "Common/Log.hpp"
 
 #include "Mesh/CMeshWriter.hpp"
 #include "Mesh/MeshMetadata.hpp"
@@ -63,9 +64,10 @@ void CMeshWriter::config_fields()
   m_fields.resize(0);
   boost_foreach ( const URI& uri, field_uris)
   {
-    m_fields.push_back(access_component_ptr_checked(uri)->as_ptr_checked<CField>());
-    if ( is_null(m_fields.back().lock()) )
+    CField::Ptr field = access_component_ptr_checked(uri)->as_ptr_checked<CField>();
+    if ( is_null(field) )
       throw ValueNotFound(FromHere(),"Invalid URI ["+uri.string()+"]");
+    add_field(field);
   }
 }
 
@@ -75,7 +77,20 @@ void CMeshWriter::set_fields(const std::vector<CField::Ptr>& fields)
 {
   m_fields.resize(0);
   boost_foreach( CField::Ptr field, fields )
-    m_fields.push_back(field);
+    add_field(field);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CMeshWriter::add_field(const CField::Ptr& field)
+{
+  // the writers access the fields through views, which exist only in Real
+  if (field->precision() != CField::REAL)
+  {
+    CFwarn << "Field " << field->uri().string() << " is stored in single precision and is not written" << CFendl;
+    return;
+  }
+  m_fields.push_back(field);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
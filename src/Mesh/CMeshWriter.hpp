@@ -70,6 +70,9 @@ private: // functions
 
   void config_fields();
 
+  /// Adds a field to write, unless it is stored in single precision
+  void add_field(const boost::shared_ptr<CField>& field);
+
 protected: // classes
 
   class IsGroup
@@ -82,9 +82,9 @@ void CMixedHash::config_nb_parts ()
 
 //////////////////////////////////////////////////////////////////////////////
 
-Uint CMixedHash::part_of_obj(const Uint obj) const
+Uint CMixedHash::part_of_obj(const Gid obj) const
 {
-  return std::min(m_nb_parts-1, (obj - m_base) / part_size() );
+  return std::min(Gid(m_nb_parts-1), (obj - m_base) / part_size() );
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -96,9 +96,9 @@ Uint CMixedHash::proc_of_part(const Uint part) const
 
 //////////////////////////////////////////////////////////////////////////////
 
-Uint CMixedHash::part_size() const
+Gid CMixedHash::part_size() const
 {
-  Uint psize = 0;
+  Gid psize = 0;
   boost_foreach (CHash::ConstPtr hash, m_subhash)
     psize += hash->part_size();
   return psize;
@@ -106,14 +106,14 @@ Uint CMixedHash::part_size() const
 
 //////////////////////////////////////////////////////////////////////////////
 
-Uint CMixedHash::proc_of_obj(const Uint obj) const
+Uint CMixedHash::proc_of_obj(const Gid obj) const
 {
   return proc_of_part( part_of_obj(obj) );
 }
 
 //////////////////////////////////////////////////////////////////////////////
 
-bool CMixedHash::owns(const Uint obj) const
+bool CMixedHash::owns(const Gid obj) const
 {
   if (proc_of_obj(obj) == mpi::PE::instance().rank())
     return true;
@@ -142,9 +142,9 @@ Uint CMixedHash::nb_objects_in_proc(const Uint proc) const
 
 //////////////////////////////////////////////////////////////////////////////
 
-Uint CMixedHash::start_idx_in_part(const Uint part) const
+Gid CMixedHash::start_idx_in_part(const Uint part) const
 {
-  Uint start_idx = 0;
+  Gid start_idx = 0;
   boost_foreach (CHash::ConstPtr hash, m_subhash)
     start_idx += hash->start_idx_in_part(part);
   return start_idx ;
@@ -152,9 +152,9 @@ Uint CMixedHash::start_idx_in_part(const Uint part) const
 
 //////////////////////////////////////////////////////////////////////////////
 
-Uint CMixedHash::end_idx_in_part(const Uint part) const
+Gid CMixedHash::end_idx_in_part(const Uint part) const
 {
-  Uint end_idx = 0;
+  Gid end_idx = 0;
   boost_foreach (CHash::ConstPtr hash, m_subhash)
     end_idx += hash->end_idx_in_part(part);
   return end_idx;
@@ -162,7 +162,7 @@ Uint CMixedHash::end_idx_in_part(const Uint part) const
 
 //////////////////////////////////////////////////////////////////////////////
 
-Uint CMixedHash::start_idx_in_proc(const Uint proc) const
+Gid CMixedHash::start_idx_in_proc(const Uint proc) const
 {
   Uint part_begin = m_nb_parts/mpi::PE::instance().size()*proc;
   return start_idx_in_part(part_begin);
@@ -170,13 +170,13 @@ Uint CMixedHash::start_idx_in_proc(const Uint proc) const
 
 //////////////////////////////////////////////////////////////////////////////
 
-Uint CMixedHash::subhash_of_obj(const Uint obj) const
+Uint CMixedHash::subhash_of_obj(const Gid obj) const
 {
   Uint part = part_of_obj(obj);
-  Uint start_idx_of_obj_part = start_idx_in_part( part );
-  Uint offset = obj - start_idx_of_obj_part;
+  Gid start_idx_of_obj_part = start_idx_in_part( part );
+  Gid offset = obj - start_idx_of_obj_part;
 
-  Uint psize = 0;
+  Gid psize = 0;
   Uint i=0;
   boost_foreach(CHash::ConstPtr hash, m_subhash)
   {
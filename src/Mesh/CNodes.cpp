@@ -25,7 +25,7 @@ CNodes::CNodes ( const std::string& name ) :
   m_coordinates = create_static_component_ptr< Field >(Mesh::Tags::coordinates());
   m_coordinates->add_tag(Mesh::Tags::coordinates());
 
-  m_glb_elem_connectivity = create_static_component_ptr< CDynTable<Uint> >("glb_elem_connectivity");
+  m_glb_elem_connectivity = create_static_component_ptr< CDynTable<Gid> >("glb_elem_connectivity");
   m_glb_elem_connectivity->add_tag("glb_elem_connectivity");
 
   add_tag(Mesh::Tags::nodes());
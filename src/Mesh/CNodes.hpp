@@ -45,8 +45,8 @@ public: // functions
   Field& coordinates() { return *m_coordinates; }
   const Field& coordinates() const { return *m_coordinates; }
 
-  CDynTable<Uint>& glb_elem_connectivity() { return *m_glb_elem_connectivity; }
-  const CDynTable<Uint>& glb_elem_connectivity() const { return *m_glb_elem_connectivity; }
+  CDynTable<Gid>& glb_elem_connectivity() { return *m_glb_elem_connectivity; }
+  const CDynTable<Gid>& glb_elem_connectivity() const { return *m_glb_elem_connectivity; }
 
   /// The dimension for the coordinates of the mesh
   Uint dim() const { return coordinates().row_size(); }
@@ -57,7 +57,7 @@ private: // data
 
   boost::shared_ptr<Field> m_coordinates;
 
-  boost::shared_ptr<CDynTable<Uint> > m_glb_elem_connectivity;
+  boost::shared_ptr<CDynTable<Gid> > m_glb_elem_connectivity;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -5,9 +5,11 @@
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
 #include <set>
+#include <algorithm>
 
 #include <boost/algorithm/string/erase.hpp>
 #include <boost/tuple/tuple.hpp>
+#include <boost/bind.hpp>
 
 #include "Common/Foreach.hpp"
 #include "Common/Log.hpp"
@@ -17,6 +19,8 @@
 #include "Common/OptionArray.hpp"
 #include "Common/OptionComponent.hpp"
 #include "Common/CLink.hpp"
+#include "Common/MPI/PE.hpp"
+#include "Common/ThreadPool.hpp"
 
 #include "Math/Consts.hpp"
 #include "Mesh/COcttree.hpp"
@@ -45,6 +49,47 @@ CF::Common::ComponentBuilder < COcttree, Component, LibMesh > COcttree_Builder;
 
 //////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+/// maximum number of elements in a leaf of the bounding volume hierarchy
+const Uint nb_elems_per_leaf = 4;
+
+/// maximum depth of the bounding volume hierarchy, the median split
+/// keeps it below log2 of the number of elements
+const Uint max_bvh_depth = 64;
+
+/// maximum number of elements kept to retry the location of a coordinate on their faces
+const Uint max_candidates = 32;
+
+/// number of points located by one task of the thread pool in find_elements()
+const Uint nb_points_per_chunk = 256;
+
+/// Orders elements by the center of their bounding box along one axis
+struct CenterLess
+{
+  CenterLess(const std::vector<Real>& centers, const Uint axis) : m_centers(centers), m_axis(axis) {}
+
+  bool operator()(const Uint a, const Uint b) const
+  {
+    return m_centers[3*a+m_axis] < m_centers[3*b+m_axis];
+  }
+
+  const std::vector<Real>& m_centers;
+  const Uint m_axis;
+};
+
+/// Range of elements of a node of the bounding volume hierarchy still to be created
+struct BVHRange
+{
+  Uint begin;
+  Uint end;
+  Uint parent;  ///< node of which this range is the second child, or uint_max()
+};
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////
+
 COcttree::COcttree( const std::string& name )
   : Component(name), m_dim(0), m_bounding(2), m_N(3), m_D(3), m_octtree_idx(3)
 {
@@ -81,7 +126,7 @@ void COcttree::create_bounding_box()
 
   // find bounding box coordinates for region 1 and region 2
   m_bounding[MIN].setConstant(real_max());
-  m_bounding[MAX].setConstant(real_min());
+  m_bounding[MAX].setConstant(-real_max());
 
   boost_foreach(CTable<Real>::ConstRow coords, m_mesh.lock()->nodes().coordinates().array())
   {
@@ -163,6 +208,8 @@ void COcttree::create_octtree()
     }
   }
 
+  create_bvh();
+
 
   // Uint total=0;
   //
@@ -321,44 +368,338 @@ void COcttree::gather_elements_around_idx(const std::vector<Uint>& octtree_idx,
 
 boost::tuple<CElements::ConstPtr,Uint> COcttree::find_element(const RealVector& target_coord)
 {
-  if (find_octtree_cell(target_coord,m_octtree_idx))
+  cf_assert(target_coord.size() == static_cast<int>(m_dim));
+
+  if (m_elem_coords.size() != m_components.size())
+    allocate_coordinates(m_elem_coords);
+
+  const Uint unif_elem_idx = find_unified_element(target_coord,m_elem_coords);
+  if (unif_elem_idx == uint_max())
+    return boost::make_tuple(CElements::ConstPtr(), 0u);
+
+  return boost::make_tuple(m_components[m_elem_comp[unif_elem_idx]]->as_ptr<CElements>(),m_elem_local[unif_elem_idx]);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void COcttree::create_bvh()
+{
+  const Uint nb_elems = m_elements->size();
+
+  m_components.resize(m_elements->components().size());
+  for (Uint comp=0; comp<m_components.size(); ++comp)
+    m_components[comp] = &m_elements->components()[comp]->as_type<CElements>();
+
+  m_elem_comp.resize(nb_elems);
+  m_elem_local.resize(nb_elems);
+  for (Uint e=0; e<nb_elems; ++e)
+    boost::tie(m_elem_comp[e],m_elem_local[e]) = m_elements->location_idx(e);
+
+  // bounding boxes of the elements, slightly enlarged so that points on
+  // the faces of an element are never missed due to round-off
+
+  std::vector<Real> elem_min(3*nb_elems,0.);
+  std::vector<Real> elem_max(3*nb_elems,0.);
+  std::vector<Real> centers(3*nb_elems,0.);
+
+  std::vector<RealMatrix> elem_coords;
+  allocate_coordinates(elem_coords);
+  for (Uint e=0; e<nb_elems; ++e)
   {
-    std::vector<Uint> unified_elements(0); unified_elements.reserve(16);
+    RealMatrix& coordinates = elem_coords[m_elem_comp[e]];
+    m_components[m_elem_comp[e]]->put_coordinates(coordinates,m_elem_local[e]);
+
+    Real size = 0.;
+    for (Uint d=0; d<m_dim; ++d)
+    {
+      elem_min[3*e+d] = coordinates.col(d).minCoeff();
+      elem_max[3*e+d] = coordinates.col(d).maxCoeff();
+      size = std::max(size, elem_max[3*e+d] - elem_min[3*e+d]);
+    }
+    for (Uint d=0; d<m_dim; ++d)
+    {
+      elem_min[3*e+d] -= 1e-8*size;
+      elem_max[3*e+d] += 1e-8*size;
+      centers[3*e+d] = 0.5*(elem_min[3*e+d] + elem_max[3*e+d]);
+    }
+  }
 
-    Component::ConstPtr component;
-    Uint elem_idx;
+  // the hierarchy is built top-down by splitting the elements at the median
+  // of their centers along the longest axis. The nodes are created depth first,
+  // from a stack of element ranges still to be split.
 
-    gather_elements_around_idx(m_octtree_idx,0,unified_elements);
+  m_bvh_elems.resize(nb_elems);
+  for (Uint e=0; e<nb_elems; ++e)
+    m_bvh_elems[e] = e;
+
+  m_bvh_nodes.clear();
+  m_bvh_nodes.reserve(2*nb_elems/nb_elems_per_leaf+1);
+
+  std::vector<BVHRange> ranges;
+  if (nb_elems)
+  {
+    BVHRange root = { 0, nb_elems, uint_max() };
+    ranges.push_back(root);
+  }
 
-    boost_foreach(const Uint unif_elem_idx, unified_elements)
+  while (!ranges.empty())
+  {
+    const BVHRange range = ranges.back();
+    ranges.pop_back();
+
+    const Uint node_idx = m_bvh_nodes.size();
+    if (range.parent != uint_max())
+      m_bvh_nodes[range.parent].first = node_idx;
+    m_bvh_nodes.push_back(BVHNode());
+    BVHNode& node = m_bvh_nodes.back();
+
+    Real center_min[3] = {0.,0.,0.};
+    Real center_max[3] = {0.,0.,0.};
+    for (Uint d=0; d<3; ++d)
+    {
+      node.min[d] = real_max();   node.max[d] = -real_max();
+      center_min[d] = real_max(); center_max[d] = -real_max();
+    }
+    for (Uint i=range.begin; i<range.end; ++i)
     {
-      boost::tie(component,elem_idx)=m_elements->location(unif_elem_idx);
-      const CElements& elements = component->as_type<CElements>();
-      const RealMatrix elem_coordinates = elements.get_coordinates(elem_idx);
-      if (elements.element_type().is_coord_in_element(target_coord,elem_coordinates))
+      const Uint e = m_bvh_elems[i];
+      for (Uint d=0; d<m_dim; ++d)
       {
-        return boost::make_tuple(elements.as_ptr<CElements>(),elem_idx);
+        node.min[d] = std::min(node.min[d], elem_min[3*e+d]);
+        node.max[d] = std::max(node.max[d], elem_max[3*e+d]);
+        center_min[d] = std::min(center_min[d], centers[3*e+d]);
+        center_max[d] = std::max(center_max[d], centers[3*e+d]);
       }
     }
 
-    // if arrived here, it means no element has been found. Enlarge the search with one more ring, for possible misses.
-    unified_elements.resize(0); unified_elements.reserve(16);
-    gather_elements_around_idx(m_octtree_idx,1,unified_elements);
+    if (range.end - range.begin <= nb_elems_per_leaf)
+    {
+      node.first = range.begin;
+      node.count = range.end - range.begin;
+      continue;
+    }
+
+    Uint axis = 0;
+    for (Uint d=1; d<m_dim; ++d)
+      if (center_max[d]-center_min[d] > center_max[axis]-center_min[axis])
+        axis = d;
+
+    const Uint mid = range.begin + (range.end - range.begin)/2;
+    std::nth_element(m_bvh_elems.begin()+range.begin, m_bvh_elems.begin()+mid, m_bvh_elems.begin()+range.end, CenterLess(centers,axis));
+
+    node.first = uint_max();
+    node.count = 0;
+
+    // the first child is popped first, so that it directly follows its parent
+    BVHRange second = { mid, range.end, node_idx };
+    BVHRange first  = { range.begin, mid, uint_max() };
+    ranges.push_back(second);
+    ranges.push_back(first);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void COcttree::allocate_coordinates(std::vector<RealMatrix>& elem_coords) const
+{
+  elem_coords.resize(m_components.size());
+  for (Uint comp=0; comp<m_components.size(); ++comp)
+    m_components[comp]->allocate_coordinates(elem_coords[comp]);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+Uint COcttree::find_unified_element(const RealVector& coord, std::vector<RealMatrix>& elem_coords) const
+{
+  if (m_bvh_nodes.empty())
+    return uint_max();
+
+  Uint stack[max_bvh_depth];
+  Uint stack_size = 0;
+  stack[stack_size++] = 0;
+
+  // elements whose bounding box contains the coordinate
+  Uint candidates[max_candidates];
+  Uint nb_candidates = 0;
+
+  while (stack_size)
+  {
+    const Uint node_idx = stack[--stack_size];
+    const BVHNode& node = m_bvh_nodes[node_idx];
+
+    bool in_box = true;
+    for (Uint d=0; d<m_dim; ++d)
+      in_box = in_box && coord[d] >= node.min[d] && coord[d] <= node.max[d];
+    if (!in_box)
+      continue;
+
+    if (node.count == 0)
+    {
+      cf_assert(stack_size+2 <= max_bvh_depth);
+      stack[stack_size++] = node.first;
+      stack[stack_size++] = node_idx+1;
+      continue;
+    }
+
+    for (Uint i=node.first; i<node.first+node.count; ++i)
+    {
+      const Uint unif_elem_idx = m_bvh_elems[i];
+      const Uint comp = m_elem_comp[unif_elem_idx];
+      const CElements& elements = *m_components[comp];
+      RealMatrix& coordinates = elem_coords[comp];
+      elements.put_coordinates(coordinates,m_elem_local[unif_elem_idx]);
+      if (elements.element_type().is_coord_in_element(coord,coordinates))
+        return unif_elem_idx;
+      if (nb_candidates < max_candidates)
+        candidates[nb_candidates++] = unif_elem_idx;
+    }
+  }
+
+  // A coordinate on a face shared by elements may be rejected by all of them
+  // due to round-off in their mapped coordinates. It is then moved slightly
+  // towards the center of every candidate element.
+
+  RealVector moved_coord(m_dim);
+  for (Uint c=0; c<nb_candidates; ++c)
+  {
+    const Uint comp = m_elem_comp[candidates[c]];
+    const CElements& elements = *m_components[comp];
+    RealMatrix& coordinates = elem_coords[comp];
+    elements.put_coordinates(coordinates,m_elem_local[candidates[c]]);
+    for (Uint d=0; d<m_dim; ++d)
+      moved_coord[d] = coord[d] + 1e-8*(coordinates.col(d).mean() - coord[d]);
+    if (elements.element_type().is_coord_in_element(moved_coord,coordinates))
+      return candidates[c];
+  }
+  return uint_max();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void COcttree::find_elements_in_range(const RealMatrix& points, const Uint begin, const Uint end, std::vector<Uint>& unified_elems) const
+{
+  std::vector<RealMatrix> elem_coords;
+  allocate_coordinates(elem_coords);
+
+  RealVector coord(m_dim);
+  for (Uint p=begin; p<end; ++p)
+  {
+    coord = points.row(p).transpose();
+    unified_elems[p] = find_unified_element(coord,elem_coords);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void COcttree::find_elements(const RealMatrix& points, std::vector<Uint>& unified_elems) const
+{
+  if (m_bvh_nodes.empty() && m_elements->size())
+    throw SetupError(FromHere(), "The octtree of "+uri().string()+" has not been created");
+  cf_assert(points.cols() == static_cast<int>(m_dim));
+
+  const Uint nb_points = points.rows();
+  unified_elems.resize(nb_points);
+
+  // every chunk of points is located with its own temporaries
+  Common::ThreadPool::instance().parallel_for(0, nb_points,
+    boost::bind(&COcttree::find_elements_in_range, this, boost::cref(points), _1, _2, boost::ref(unified_elems)),
+    nb_points_per_chunk);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void COcttree::find_elements(const RealMatrix& points, std::vector<Uint>& ranks, std::vector<Uint>& unified_elems) const
+{
+  find_elements(points,unified_elems);
+
+  const Uint nb_points = points.rows();
+  const bool parallel = mpi::PE::instance().is_active() && mpi::PE::instance().size() > 1;
+  const Uint rank = parallel ? mpi::PE::instance().rank() : 0u;
+
+  ranks.resize(nb_points);
+  for (Uint p=0; p<nb_points; ++p)
+    ranks[p] = (unified_elems[p] != uint_max()) ? rank : uint_max();
+
+  if (!parallel)
+    return;
+
+  const Uint nb_procs = mpi::PE::instance().size();
+
+  // bounding boxes of the meshes of all the processes
+
+  std::vector<Real> bounding_box(2*m_dim);
+  for (Uint d=0; d<m_dim; ++d)
+  {
+    bounding_box[d]       = m_bounding[MIN][d];
+    bounding_box[m_dim+d] = m_bounding[MAX][d];
+  }
+  std::vector<Real> bounding_boxes(nb_procs*2*m_dim);
+  mpi::PE::instance().all_gather(bounding_box,bounding_boxes);
+
+  // send the points that are not found to the processes whose bounding box contains them
+
+  std::vector< std::vector<Uint> > sent_points(nb_procs);
+  for (Uint p=0; p<nb_points; ++p)
+  {
+    if (ranks[p] != uint_max())
+      continue;
+
+    for (Uint proc=0; proc<nb_procs; ++proc)
+    {
+      if (proc == rank)
+        continue;
+      const Real* box = &bounding_boxes[proc*2*m_dim];
+      bool in_box = true;
+      for (Uint d=0; d<m_dim; ++d)
+        in_box = in_box && points(p,d) >= box[d] && points(p,d) <= box[m_dim+d];
+      if (in_box)
+        sent_points[proc].push_back(p);
+    }
+  }
+
+  std::vector<Real> send_coords;
+  std::vector<int> send_n(nb_procs);
+  for (Uint proc=0; proc<nb_procs; ++proc)
+  {
+    send_n[proc] = sent_points[proc].size();
+    boost_foreach(const Uint p, sent_points[proc])
+      for (Uint d=0; d<m_dim; ++d)
+        send_coords.push_back(points(p,d));
+  }
+
+  std::vector<Real> recv_coords;
+  std::vector<int> recv_n(nb_procs,-1);
+  mpi::PE::instance().all_to_all(send_coords,send_n,recv_coords,recv_n,m_dim);
 
-    boost_foreach(const Uint unif_elem_idx, unified_elements)
+  // locate the received points and send the results back
+
+  const Uint nb_recv = recv_coords.size()/m_dim;
+  RealMatrix recv_points(nb_recv,m_dim);
+  for (Uint p=0; p<nb_recv; ++p)
+    for (Uint d=0; d<m_dim; ++d)
+      recv_points(p,d) = recv_coords[p*m_dim+d];
+
+  std::vector<Uint> recv_elems;
+  find_elements(recv_points,recv_elems);
+
+  std::vector<Uint> found_elems;
+  mpi::PE::instance().all_to_all(recv_elems,recv_n,found_elems,send_n);
+
+  // the process with the lowest rank owns points found by several processes
+
+  Uint cnt = 0;
+  for (Uint proc=0; proc<nb_procs; ++proc)
+  {
+    boost_foreach(const Uint p, sent_points[proc])
     {
-      boost::tie(component,elem_idx)=m_elements->location(unif_elem_idx);
-      const CElements& elements = component->as_type<CElements>();
-      const RealMatrix elem_coordinates = elements.get_coordinates(elem_idx);
-      if (elements.element_type().is_coord_in_element(target_coord,elem_coordinates))
+      if (found_elems[cnt] != uint_max() && proc < ranks[p])
       {
-        return boost::make_tuple(elements.as_ptr<CElements>(),elem_idx);
+        ranks[p] = proc;
+        unified_elems[p] = found_elems[cnt];
       }
+      ++cnt;
     }
-
   }
-  // if arrived here, it means no element has been found. Give up.
-  return boost::make_tuple(CElements::ConstPtr(), 0u);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -24,7 +24,16 @@ namespace Mesh {
 
 //////////////////////////////////////////////////////////////////////////////
 
-/// This class defines Neutral mesh format reader
+/// Spatial search structures over the volume elements of a mesh.
+///
+/// A uniform grid of cells, binning the elements by centroid, is used to gather
+/// the elements around a location (see CStencilComputerOcttree).
+/// Point location uses a bounding volume hierarchy (BVH) over the bounding boxes
+/// of the elements instead, which adapts to the local mesh size and only tests
+/// the elements whose bounding box contains the point.
+/// Batches of points are located with find_elements(), shared among the
+/// threads of the Common::ThreadPool,
+/// and can be routed to the ranks owning the elements of a distributed mesh.
 /// @author Willem Deconinck
 class Mesh_API COcttree : public Common::Component
 {
@@ -46,6 +55,7 @@ public: // functions
   /// Gets the Class name
   static std::string type_name() { return "COcttree"; }
 
+  /// Create the uniform grid and the bounding volume hierarchy of the mesh
   void create_octtree();
 
   /// Find one single element in which the given coordinate resides.
@@ -53,6 +63,27 @@ public: // functions
   /// @return the elements region, and the local coefficient in this region
   boost::tuple<CElements::ConstPtr,Uint> find_element(const RealVector& target_coord);
 
+  /// Find the elements in which a batch of coordinates reside, shared among
+  /// the threads of the Common::ThreadPool
+  /// @param points        [in]  the coordinates, one point per row
+  /// @param unified_elems [out] the unified index of the element of every point,
+  ///                            or Math::Consts::uint_max() if it is not found
+  void find_elements(const RealMatrix& points, std::vector<Uint>& unified_elems) const;
+
+  /// Find the elements in which a batch of coordinates reside, in a mesh
+  /// distributed over the processes. The points that are not found in the local
+  /// part of the mesh are sent to the processes whose bounding box contains them.
+  /// @note this is a collective operation
+  /// @param points        [in]  the coordinates, one point per row
+  /// @param ranks         [out] the rank of the process owning the element of every point,
+  ///                            or Math::Consts::uint_max() if it is not found
+  /// @param unified_elems [out] the unified index of the element of every point
+  ///                            in the mesh of the process owning it
+  void find_elements(const RealMatrix& points, std::vector<Uint>& ranks, std::vector<Uint>& unified_elems) const;
+
+  /// @return the elements in the octtree, the unified indexes refer to
+  const CUnifiedData& unified_elements() const { return *m_elements; }
+
   /// Given a coordinate, find which box in the octtree it is located in
   /// @param coordinate  [in]  The coordinate to look for
   /// @param octtree_idx [out] location of the box (i,j,k) in which the coordinate sits
@@ -72,6 +103,21 @@ private: //functions
   /// Create the octtree for fast searching in which element a coordinate can be found
   void create_bounding_box();
 
+  /// Create the bounding volume hierarchy over the bounding boxes of the elements
+  void create_bvh();
+
+  /// Find the element in which a coordinate resides, traversing the bounding volume hierarchy
+  /// @param coord          [in]  the coordinate
+  /// @param elem_coords    [in,out] preallocated coordinates of an element, one matrix per component
+  /// @return the unified index of the element, or Math::Consts::uint_max() if it is not found
+  Uint find_unified_element(const RealVector& coord, std::vector<RealMatrix>& elem_coords) const;
+
+  /// Find the elements of the points [begin,end[ of a batch
+  void find_elements_in_range(const RealMatrix& points, const Uint begin, const Uint end, std::vector<Uint>& unified_elems) const;
+
+  /// Allocate the coordinates of one element for every component
+  void allocate_coordinates(std::vector<RealMatrix>& elem_coords) const;
+
   /// Utility function to convert a vector-like type to a RealVector
   template<typename RowT>
   void to_vector(RealVector& result, const RowT& row)
@@ -82,6 +128,19 @@ private: //functions
       result[i] = row[i];
   }
 
+private: // typedefs
+
+  /// Node of the bounding volume hierarchy.
+  /// The nodes are stored depth first, so the first child of an inner node
+  /// follows it. A leaf holds the elements m_bvh_elems[first,first+count[
+  struct BVHNode
+  {
+    Real min[3];
+    Real max[3];
+    Uint first;   ///< first element of a leaf, or second child of an inner node
+    Uint count;   ///< number of elements of a leaf, 0 for an inner node
+  };
+
 private: // data
 
   boost::weak_ptr<CMesh> m_mesh;
@@ -98,6 +157,20 @@ private: // data
 
   std::vector<Uint> m_octtree_idx;
 
+  /// nodes of the bounding volume hierarchy, the root first
+  std::vector<BVHNode> m_bvh_nodes;
+  /// unified element indexes, ordered by leaf
+  std::vector<Uint> m_bvh_elems;
+
+  /// the components of m_elements
+  std::vector<const CElements*> m_components;
+  /// component and local index of every element
+  std::vector<Uint> m_elem_comp;
+  std::vector<Uint> m_elem_local;
+
+  /// coordinates of one element per component, used by find_element()
+  std::vector<RealMatrix> m_elem_coords;
+
 }; // end COcttree
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,185 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+
+#include "Common/CBuilder.hpp"
+#include "Common/FindComponents.hpp"
+
+#include "Math/Defs.hpp"
+
+#include "Mesh/CElements.hpp"
+#include "Mesh/CStructuredBlocks.hpp"
+#include "Mesh/CTable.hpp"
+#include "Mesh/ElementType.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh {
+
+  using namespace Common;
+
+Common::ComponentBuilder < CStructuredBlocks, Component, LibMesh > CStructuredBlocks_Builder;
+
+////////////////////////////////////////////////////////////////////////////////
+
+CStructuredBlocks::CStructuredBlocks ( const std::string& name ) :
+  Component(name),
+  m_dimension(DIM_3D),
+  m_block_start(1,0)
+{
+  properties()["brief"] = std::string("Block structure of elements generated on a structured grid");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+CStructuredBlocks::~CStructuredBlocks()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CStructuredBlocks::add_block(const Uint nx, const Uint ny, const Uint nz)
+{
+  Block block;
+  block.first_element = m_block_start.back();
+  block.size[XX] = nx;
+  block.size[YY] = ny;
+  block.size[ZZ] = nz;
+  block.stride[XX] = 1;
+  block.stride[YY] = nx;
+  block.stride[ZZ] = nx*ny;
+  block.implicit_nodes = false;
+  block.inner_size[XX] = 0;
+  block.inner_size[YY] = 0;
+  block.inner_size[ZZ] = 0;
+  block.first_node = 0;
+
+  m_blocks.push_back(block);
+  m_block_start.push_back(block.first_element + block.nb_elements());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CStructuredBlocks::setup(const CElements& elements)
+{
+  cf_assert(nb_elements() == elements.size());
+  m_dimension = elements.element_type().dimensionality();
+
+  const CTable<Uint>& connectivity = elements.node_connectivity();
+  const Uint nb_nodes = connectivity.row_size();
+
+  for(Uint b = 0; b != m_blocks.size(); ++b)
+  {
+    Block& block = m_blocks[b];
+    block.implicit_nodes = false;
+    if(block.nb_elements() == 0)
+      continue;
+
+    // nodes of the first and last element, checked by of()
+    const CTable<Uint>::ConstRow first_row = connectivity[block.first_element];
+    const CTable<Uint>::ConstRow last_row = connectivity[m_block_start[b+1]-1];
+    block.end_nodes.assign(first_row.begin(), first_row.end());
+    block.end_nodes.insert(block.end_nodes.end(), last_row.begin(), last_row.end());
+
+    // a block one element thick has no element with all its nodes inside
+    bool has_inner_elements = true;
+    for(Uint d = 0; d != DIM_3D; ++d)
+    {
+      block.inner_size[d] = d < m_dimension ? block.size[d] - 1 : block.size[d];
+      has_inner_elements = has_inner_elements && block.inner_size[d] > 0;
+    }
+    if(!has_inner_elements)
+      continue;
+
+    // offsets of the nodes of the first element, from the lowest one
+    block.first_node = *std::min_element(first_row.begin(), first_row.end());
+    block.node_offsets.resize(nb_nodes);
+    for(Uint n = 0; n != nb_nodes; ++n)
+      block.node_offsets[n] = first_row[n] - block.first_node;
+
+    // every element with all its nodes inside must have the same offsets
+    block.implicit_nodes = true;
+    std::vector<Uint> nodes(nb_nodes);
+    for(Uint element = block.first_element; element != m_block_start[b+1] && block.implicit_nodes; ++element)
+    {
+      if(!element_nodes(b, element, nodes))
+        continue;
+      const CTable<Uint>::ConstRow row = connectivity[element];
+      block.implicit_nodes = std::equal(nodes.begin(), nodes.end(), row.begin());
+    }
+
+    if(!block.implicit_nodes)
+      block.node_offsets.clear();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+CStructuredBlocks::ConstPtr CStructuredBlocks::of(const CEntities& elements)
+{
+  ConstPtr blocks = find_component_ptr<CStructuredBlocks>(elements);
+  if(is_null(blocks) || blocks->nb_elements() != elements.size())
+    return ConstPtr();
+
+  // renumbered or rebuilt elements keep their number but not their nodes
+  const CElements* connected_elements = dynamic_cast<const CElements*>(&elements);
+  if(is_null(connected_elements))
+    return ConstPtr();
+  const CTable<Uint>& connectivity = connected_elements->node_connectivity();
+  const Uint nb_nodes = connectivity.row_size();
+  for(Uint b = 0; b != blocks->nb_blocks(); ++b)
+  {
+    const Block& block = blocks->block(b);
+    if(block.nb_elements() == 0)
+      continue;
+    if(block.end_nodes.size() != 2*nb_nodes)
+      return ConstPtr();
+    const CTable<Uint>::ConstRow first_row = connectivity[block.first_element];
+    const CTable<Uint>::ConstRow last_row = connectivity[blocks->m_block_start[b+1]-1];
+    if(!std::equal(first_row.begin(), first_row.end(), block.end_nodes.begin())
+       || !std::equal(last_row.begin(), last_row.end(), block.end_nodes.begin() + nb_nodes))
+      return ConstPtr();
+  }
+  return blocks;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Uint CStructuredBlocks::block_of(const Uint element) const
+{
+  cf_assert(element < nb_elements());
+  return std::upper_bound(m_block_start.begin(), m_block_start.end(), element) - m_block_start.begin() - 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool CStructuredBlocks::neighbor(const Uint element, const Uint direction, const bool positive, Uint& neighbor) const
+{
+  cf_assert(direction < m_dimension);
+  const Block& block = m_blocks[block_of(element)];
+  const Uint position = ((element - block.first_element) / block.stride[direction]) % block.size[direction];
+
+  if(positive)
+  {
+    if(position + 1 == block.size[direction])
+      return false;
+    neighbor = element + block.stride[direction];
+  }
+  else
+  {
+    if(position == 0)
+      return false;
+    neighbor = element - block.stride[direction];
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Mesh
+} // CF
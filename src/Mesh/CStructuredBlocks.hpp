@@ -0,0 +1,173 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Mesh_CStructuredBlocks_hpp
+#define CF_Mesh_CStructuredBlocks_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "Common/Component.hpp"
+
+#include "Math/Defs.hpp"
+
+#include "Mesh/LibMesh.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh {
+
+  class CElements;
+  class CEntities;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Block structure of the elements of a CElements component, generated block by
+/// block on a structured grid (see BlockMesh::build_mesh).
+/// The elements of a block follow each other, numbered with the first direction
+/// varying fastest, so that the neighbors of an element inside its block are at
+/// a fixed distance (the stride of the direction) and need no connectivity lookup.
+/// The interfaces between the blocks and the boundaries stay unstructured:
+/// neighbors across them are found through the face connectivity as usual.
+/// In the blocks whose nodes are also numbered structurally, the nodes of the elements
+/// that do not touch the positive sides of the block follow from the element index.
+class Mesh_API CStructuredBlocks : public Common::Component {
+
+public: // typedefs
+
+  typedef boost::shared_ptr<CStructuredBlocks> Ptr;
+  typedef boost::shared_ptr<CStructuredBlocks const> ConstPtr;
+
+  /// A block of elements
+  struct Block
+  {
+    /// Index of the first element of the block
+    Uint first_element;
+
+    /// Number of elements in each direction, 1 beyond the dimension of the elements
+    Uint size[3];
+
+    /// Distance between the indices of neighboring elements in each direction
+    Uint stride[3];
+
+    /// True if the nodes of the elements inside the block are computed
+    bool implicit_nodes;
+
+    /// Number of elements in each direction that do not touch the positive sides of the
+    /// block, one less than size in the directions of the elements
+    Uint inner_size[3];
+
+    /// Lowest node of the first element, the lowest node of an element being this plus the element position in the block
+    Uint first_node;
+
+    /// Offsets of the nodes of an element from its lowest node, in the order of the connectivity table
+    std::vector<Uint> node_offsets;
+
+    /// Nodes of the first and last element, to detect a change of the connectivity table
+    std::vector<Uint> end_nodes;
+
+    /// Number of elements in the block
+    Uint nb_elements() const { return size[0]*size[1]*size[2]; }
+  };
+
+public: // functions
+
+  /// Contructor
+  /// @param name of the component
+  CStructuredBlocks ( const std::string& name );
+
+  /// Virtual destructor
+  virtual ~CStructuredBlocks();
+
+  /// Get the class name
+  static std::string type_name () { return "CStructuredBlocks"; }
+
+  /// Appends a block, whose elements follow those of the previous block
+  void add_block(const Uint nx, const Uint ny, const Uint nz = 1);
+
+  /// Find out which blocks have their nodes numbered structurally, by checking
+  /// the connectivity table of the elements
+  void setup(const CElements& elements);
+
+  /// @return the block structure of elements, or a null pointer if they have none
+  ///         or if they changed since it was built: the number of elements and the
+  ///         nodes of the first and last element of each block are checked
+  static ConstPtr of(const CEntities& elements);
+
+  /// Number of blocks
+  Uint nb_blocks() const { return m_blocks.size(); }
+
+  /// Access to a block
+  const Block& block(const Uint b) const { return m_blocks[b]; }
+
+  /// Number of elements in all blocks
+  Uint nb_elements() const { return m_block_start.back(); }
+
+  /// @return the block containing an element
+  Uint block_of(const Uint element) const;
+
+  /// Neighbor of an element inside its block
+  /// @param direction XX, YY or ZZ
+  /// @param positive true for the neighbor in the positive direction
+  /// @return false if the neighbor is in another block or beyond the boundary
+  bool neighbor(const Uint element, const Uint direction, const bool positive, Uint& neighbor) const;
+
+  /// Compute the nodes of an element, in the order of the connectivity table
+  /// @return false if the nodes of the element are not implicit, and must be read from the connectivity table
+  template<typename NodesT>
+  bool element_nodes(const Uint b, const Uint element, NodesT& nodes) const
+  {
+    const Block& block = m_blocks[b];
+    const Uint local = element - block.first_element;
+    if(!is_inner(block, local % block.size[XX], (local / block.stride[YY]) % block.size[YY], local / block.stride[ZZ]))
+      return false;
+
+    inner_element_nodes(block, element, nodes);
+    return true;
+  }
+
+  /// True if the nodes of the element at position (i,j,k) of a block are computed.
+  /// Elements touching the positive sides have nodes in the neighbor blocks or on the boundary.
+  static bool is_inner(const Block& block, const Uint i, const Uint j, const Uint k)
+  {
+    return block.implicit_nodes && i < block.inner_size[XX] && j < block.inner_size[YY] && k < block.inner_size[ZZ];
+  }
+
+  /// Compute the nodes of an element for which is_inner() is true, in the order of the connectivity table.
+  /// Loops over a block in the order of its elements use this with is_inner() to avoid
+  /// recomputing the position of each element.
+  template<typename NodesT>
+  static void inner_element_nodes(const Block& block, const Uint element, NodesT& nodes)
+  {
+    const Uint lowest_node = block.first_node + element - block.first_element;
+    const Uint nb_nodes = block.node_offsets.size();
+    for(Uint n = 0; n != nb_nodes; ++n)
+      nodes[n] = lowest_node + block.node_offsets[n];
+  }
+
+private: // data
+
+  /// Dimension of the structured grid
+  Uint m_dimension;
+
+  /// The blocks
+  std::vector<Block> m_blocks;
+
+  /// First element of each block, followed by the total number of elements
+  std::vector<Uint> m_block_start;
+
+}; // CStructuredBlocks
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Mesh
+} // CF
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_Mesh_CStructuredBlocks_hpp
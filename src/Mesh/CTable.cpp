@@ -24,6 +24,10 @@ Common::ComponentBuilder < CTable<int>, Component, LibMesh >  CTable_int_Builder
 
 Common::ComponentBuilder < CTable<Real>, Component, LibMesh > CTable_Real_Builder;
 
+#ifndef CF_REAL_IS_FLOAT
+Common::ComponentBuilder < CTable<float>, Component, LibMesh > CTable_float_Builder;
+#endif
+
 Common::ComponentBuilder < CTable<std::string>, Component, LibMesh > CTable_string_Builder;
 
 ////////////////////////////////////////////////////////////////////////////////
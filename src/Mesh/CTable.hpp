@@ -9,6 +9,8 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <new>
+
 #include "Common/Component.hpp"
 
 #include "Mesh/ArrayBufferT.hpp"
@@ -25,6 +27,11 @@ namespace Mesh {
 ///
 /// The internal structure is that of a boost::multi_array,
 /// so storage is contingent in memory for reducing cache missing
+///
+/// The values of a row are contiguous by default (AOS layout). With the SOA
+/// layout the values of a column are contiguous instead, so that loops over
+/// the rows of a column vectorize. Rows are accessed the same way with both
+/// layouts, and column() gives bulk loops the location and stride of a column.
 //
 /// The table can be filled through a buffer. The buffer avoids
 /// the typical reallocation in a std::vector. Flushing the buffer
@@ -47,7 +54,7 @@ public: // typedefs
   typedef ValueT value_type;
 
   /// @brief the type of the internal structure of the table
-  typedef boost::multi_array<ValueT,2> ArrayT;
+  typedef boost::multi_array<ValueT,2,Common::Allocator<ValueT> > ArrayT;
 
   /// @brief the type of a row in the internal structure of the table
   typedef typename boost::subarray_gen<ArrayT,1>::type Row;
@@ -64,6 +71,41 @@ public: // typedefs
   /// @brief boost::shared_ptr shortcut of this component const version
   typedef boost::shared_ptr<CTable const> ConstPtr;
 
+  /// @brief storage order of the values
+  enum Layout {
+    AOS=0, ///< rows are contiguous (array of structures)
+    SOA=1  ///< columns are contiguous (structure of arrays)
+  };
+
+  /// @brief strided access to the values of a column
+  template<typename T>
+  struct ColumnSpan
+  {
+    /// value in the first row
+    T* values;
+    /// distance between the values of consecutive rows, 1 for the SOA layout
+    Uint stride;
+    /// number of rows
+    Uint size;
+
+    /// @return the value in a row
+    T& operator[](const Uint row) const { return values[row*stride]; }
+
+    /// Conversion to a const column
+    template<typename U>
+    operator ColumnSpan<U>() const
+    {
+      const ColumnSpan<U> column = { values, stride, size };
+      return column;
+    }
+  };
+
+  /// @brief the type of a column of the table
+  typedef ColumnSpan<ValueT> Column;
+
+  /// @brief the const type of a column of the table
+  typedef ColumnSpan<const ValueT> ConstColumn;
+
 public: // functions
 
   /// Contructor
@@ -92,6 +134,34 @@ public: // functions
     m_array.resize(boost::extents[nb_rows][row_size()]);
   }
 
+  /// @return the storage order of the values
+  Layout layout() const
+  {
+    return m_array.storage_order().ordering(0) == 1 ? AOS : SOA;
+  }
+
+  /// Changes the storage order of the values, keeping them.
+  /// The internal structure is rebuilt in place, so buffers must be flushed first.
+  /// @param[in] layout the new storage order
+  void set_layout(const Layout layout)
+  {
+    if (layout == this->layout())
+      return;
+
+    const boost::general_storage_order<2> order = layout == AOS ?
+      boost::general_storage_order<2>(boost::c_storage_order()) :
+      boost::general_storage_order<2>(boost::fortran_storage_order());
+
+    ArrayT values(m_array);
+
+    // a multi_array keeps its storage order for its whole life
+    m_array.~ArrayT();
+    new (&m_array) ArrayT(boost::extents[0][0], order);
+
+    m_array.resize(boost::extents[values.shape()[0]][values.shape()[1]]);
+    m_array = values;
+  }
+
   /// Modifiable access to the internal structure
   /// @return A reference to the array data
   ArrayT& array() { return m_array; }
@@ -127,6 +197,22 @@ public: // functions
   /// @return A const row of the underlying array
   ConstRow operator[](const Uint idx) const { return m_array[idx]; }
 
+  /// Strided access to a column, for bulk loops over the rows
+  /// @return the values of column col
+  Column column(const Uint col)
+  {
+    const Column column = { m_array.data() + col*m_array.strides()[1], Uint(m_array.strides()[0]), size() };
+    return column;
+  }
+
+  /// Strided access to a column, for bulk loops over the rows
+  /// @return the values of column col
+  ConstColumn column(const Uint col) const
+  {
+    const ConstColumn column = { m_array.data() + col*m_array.strides()[1], Uint(m_array.strides()[0]), size() };
+    return column;
+  }
+
   /// Number of rows, excluding rows that may be in the buffer
   /// @return The number of local rows in the array
   Uint size() const { return m_array.size(); }
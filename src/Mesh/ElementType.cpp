@@ -116,9 +116,20 @@ RealMatrix ElementType::jacobian(const RealVector& mapped_coord, const RealMatri
 RealVector ElementType::plane_jacobian_normal(const RealVector& mapped_coords,
                                               const RealMatrix& nodes,
                                               const CoordRef direction) const
+{
+  RealVector result(dimensionality());
+  compute_plane_jacobian_normal(mapped_coords,nodes,direction,result);
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ElementType::compute_plane_jacobian_normal(const RealVector& mapped_coords,
+                                                const RealMatrix& nodes,
+                                                const CoordRef direction,
+                                                RealVector& result) const
 {
   throw Common::NotImplemented(FromHere(),"jacobian not implemented for "+derived_type_name());
-  return RealVector(1);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
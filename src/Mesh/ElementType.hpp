@@ -157,6 +157,18 @@ public: // functions
   virtual RealVector plane_jacobian_normal(const RealVector& mapped_coords,
                                            const RealMatrix& nodes,
                                            const CoordRef orientation) const;
+
+  /// Compute the jacobian of the plane or section of the element, as plane_jacobian_normal()
+  /// but without allocating the result.
+  /// @param mapped_coord [in]  coordinates in mapped space (dimensionality x 1)
+  /// @param nodes        [in]  coordinates of the element nodes (nb_nodes x dimension)
+  /// @param orientation  [in]  direction normal to the plane
+  /// @param result       [out] vector in mapped space scaled with the jacobian of the
+  ///                           section, sized to the dimensionality beforehand
+  virtual void compute_plane_jacobian_normal(const RealVector& mapped_coords,
+                                             const RealMatrix& nodes,
+                                             const CoordRef orientation,
+                                             RealVector& result) const;
 protected: // data
 
   /// the GeoShape::Type corresponding to the shape
@@ -90,7 +90,7 @@ public: // functions
 
   CTable<Uint>::ConstRow indexes_for_element(const Uint unified_element_idx) const;
 
-  CList<Uint>& glb_idx() const { return field_group().glb_idx(); }
+  CList<Gid>& glb_idx() const { return field_group().glb_idx(); }
 
   CList<Uint>& rank() const { return field_group().rank(); }
 
@@ -111,7 +111,7 @@ FieldGroup::FieldGroup ( const std::string& name  ) :
   m_rank = create_static_component_ptr< CList<Uint> >("rank");
   m_rank->add_tag("rank");
 
-  m_glb_idx = create_static_component_ptr< CList<Uint> >(Mesh::Tags::global_indices());
+  m_glb_idx = create_static_component_ptr< CList<Gid> >(Mesh::Tags::global_indices());
   m_glb_idx->add_tag(Mesh::Tags::global_indices());
 
 
@@ -255,6 +255,9 @@ void FieldGroup::check_sanity()
     if (list.size() != m_size)
       throw InvalidStructure(FromHere(),"list ["+list.uri().string()+"] has a size "+to_str(list.size())+" != supposed "+to_str(m_size));
   }
+
+  if (m_glb_idx->size() != m_size)
+    throw InvalidStructure(FromHere(),"list ["+m_glb_idx->uri().string()+"] has a size "+to_str(m_glb_idx->size())+" != supposed "+to_str(m_size));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
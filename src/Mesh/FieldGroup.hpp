@@ -94,7 +94,7 @@ public: // functions
 
   const std::string& space() const { return m_space; }
 
-  CList<Uint>& glb_idx() const { return *m_glb_idx; }
+  CList<Gid>& glb_idx() const { return *m_glb_idx; }
 
   CList<Uint>& rank() const { return *m_rank; }
 
@@ -141,7 +141,7 @@ protected:
   Uint m_size;
 
   boost::shared_ptr<Common::CLink> m_topology;
-  boost::shared_ptr<CList<Uint> > m_glb_idx;
+  boost::shared_ptr<CList<Gid> > m_glb_idx;
   boost::shared_ptr<CList<Uint> > m_rank;
   boost::shared_ptr<CUnifiedData> m_elements_lookup;
 };
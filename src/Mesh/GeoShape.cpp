@@ -30,7 +30,7 @@ GeoShape::Convert::Convert()
     ( GeoShape::TRIAG,   "Triag"   )
     ( GeoShape::QUAD,    "Quad"    )
     ( GeoShape::TETRA,   "Tetra"   )
-    ( GeoShape::PYRAM,   "Pyram"   )
+    ( GeoShape::PYRAM,   "Pyramid" )
     ( GeoShape::PRISM,   "Prism"   )
     ( GeoShape::HEXA,    "Hexa"    );
 
@@ -41,7 +41,7 @@ GeoShape::Convert::Convert()
     ("Triag",    GeoShape::TRIAG   )
     ("Quad",     GeoShape::QUAD    )
     ("Tetra",    GeoShape::TETRA   )
-    ("Pyram",    GeoShape::PYRAM   )
+    ("Pyramid",  GeoShape::PYRAM   )
     ("Prism",    GeoShape::PRISM   )
     ("Hexa",     GeoShape::HEXA    );
 }
@@ -13,6 +13,9 @@
 #include "Common/OptionT.hpp"
 #include "Common/StreamHelpers.hpp"
 #include "Common/StringConversion.hpp"
+#include "Common/BasicExceptions.hpp"
+
+#include "Math/Consts.hpp"
 
 
 #include "Mesh/CMesh.hpp"
@@ -173,7 +176,7 @@ void CReader::get_file_positions()
   m_node_data_positions.clear();
   m_element_node_data_positions.clear();
 
-  int p;
+  std::streampos p;
   std::string line;
   while (!m_file.eof())
   {
@@ -216,7 +219,9 @@ void CReader::get_file_positions()
       m_file >> m_total_nb_elements;
       //CFinfo << "The total number of elements is " << m_total_nb_elements << CFendl;
 
-      //Create a hash
+      //Create a hash, its options only hold 32-bit counts
+      if (m_total_nb_nodes > Math::Consts::uint_max() || m_total_nb_elements > Math::Consts::uint_max())
+        throw NotSupported(FromHere(), "The mesh has more than 2^32 nodes or elements");
       m_hash = create_component_ptr<CMixedHash>("hash");
       std::vector<Uint> num_obj(2);
       num_obj[0] = m_total_nb_nodes;
@@ -224,10 +229,11 @@ void CReader::get_file_positions()
       m_hash->configure_option("nb_obj",num_obj);
 
 
-      Uint elem_idx, elem_type, nb_tags, phys_tag;
+      Gid elem_idx;
+      Uint elem_type, nb_tags, phys_tag;
 
       //Let's count how many elements of each type are present
-      for(Uint ie = 0; ie < m_total_nb_elements; ++ie)
+      for(Gid ie = 0; ie < m_total_nb_elements; ++ie)
       {
           m_file >> elem_idx;
           m_file >> elem_type;
@@ -323,10 +329,11 @@ void CReader::find_ghost_nodes()
 
 
     // read every line and store the connectivity in the correct region through the buffer
-    Uint elementNumber, elementType, nbElementNodes;
-    Uint gmsh_node_number, nb_tags, phys_tag, other_tag;
+    Gid elementNumber;
+    Uint elementType, nbElementNodes;
+    Uint nb_tags, phys_tag, other_tag;
 
-    for (Uint i=0; i<m_total_nb_elements; ++i)
+    for (Gid i=0; i<m_total_nb_elements; ++i)
     {
       if (m_total_nb_elements > 100000)
       {
@@ -348,7 +355,7 @@ void CReader::find_ghost_nodes()
             m_file >> other_tag;
 
         // check if element nodes are ghost
-        std::vector<Uint> gmsh_element_nodes(nbElementNodes);
+        std::vector<Gid> gmsh_element_nodes(nbElementNodes);
         for (Uint j=0; j<nbElementNodes; ++j)
         {
           m_file >> gmsh_element_nodes[j];
@@ -396,11 +403,11 @@ void CReader::read_coordinates()
   // declare and allocate one coordinate row
 //  std::vector<Real> rowVector(m_mesh_dimension);
 
-  std::set<Uint>::const_iterator it;
+  std::set<Gid>::const_iterator it;
 
   Uint coord_idx=nodes_start_idx;
 
-  for (Uint node_idx=0; node_idx<m_total_nb_nodes; ++node_idx)
+  for (Gid node_idx=0; node_idx<m_total_nb_nodes; ++node_idx)
   {
     if (m_total_nb_nodes > 100000)
     {
@@ -414,7 +421,7 @@ void CReader::read_coordinates()
       nodes.rank()[coord_idx] = part;
       m_node_idx_gmsh_to_cf[node_idx]=coord_idx;
       std::stringstream ss(line);
-      Uint nodeNumber;
+      Gid nodeNumber;
       ss >> nodeNumber;
       for (Uint dim=0; dim<m_mesh_dimension; ++dim)
         ss >> nodes.coordinates()[coord_idx][dim];
@@ -430,7 +437,7 @@ void CReader::read_coordinates()
         nodes.rank()[coord_idx] = m_hash->subhash(NODES).part_of_obj(node_idx);
         m_node_idx_gmsh_to_cf[node_idx]=coord_idx;
         std::stringstream ss(line);
-        Uint nodeNumber;
+        Gid nodeNumber;
         ss >> nodeNumber;
 //        CFinfo << "reading ghostnode " << nodeNumber;
         for (Uint dim=0; dim<m_mesh_dimension; ++dim)
@@ -535,10 +542,10 @@ void CReader::read_connectivity()
  }
 
    std::string etype_CF;
-   std::set<Uint>::const_iterator it;
    std::vector<Uint> cf_element;
-   Uint element_number, gmsh_element_type, nb_element_nodes;
-   Uint gmsh_node_number, nb_tags, phys_tag, other_tag;
+   Gid element_number, gmsh_node_number;
+   Uint gmsh_element_type, nb_element_nodes;
+   Uint nb_tags, phys_tag, other_tag;
    Uint cf_node_number;
    Uint cf_idx;
 
@@ -554,7 +561,7 @@ void CReader::read_connectivity()
      for(Uint etype = 0; etype < Shared::nb_gmsh_types; ++etype)
       (m_nb_gmsh_elem_in_region[ir])[etype] = 0;
 
-  for (Uint i=0; i<m_total_nb_elements; ++i)
+  for (Gid i=0; i<m_total_nb_elements; ++i)
   {
     if (m_total_nb_elements > 100000)
     {
@@ -645,7 +652,7 @@ void CReader::read_element_data()
 
   std::map<std::string,Field> fields;
 
-  boost_foreach(Uint element_data_position, m_element_data_positions)
+  boost_foreach(std::streampos element_data_position, m_element_data_positions)
   {
     m_file.seekg(element_data_position,std::ios::beg);
     read_variable_header(fields);
@@ -676,19 +683,19 @@ void CReader::read_element_data()
       CFieldView field_view("field_view");
       field_view.set_field(field);
 
-      Uint gmsh_elem_idx;
+      Gid gmsh_elem_idx;
       Uint cf_idx;
       CElements::Ptr elements;
       Uint d;
       std::vector<Real> data(gmsh_field.var_types[i]);
 
-      for (Uint e=0; e<gmsh_field.nb_entries; ++e)
+      for (Gid e=0; e<gmsh_field.nb_entries; ++e)
       {
         m_file >> gmsh_elem_idx;
         for (d=0; d<data.size(); ++d)
           m_file >> data[d];
 
-        std::map<Uint, boost::tuple<CElements::Ptr,Uint> >::iterator it = m_elem_idx_gmsh_to_cf.find(gmsh_elem_idx);
+        std::map<Gid, boost::tuple<CElements::Ptr,Uint> >::iterator it = m_elem_idx_gmsh_to_cf.find(gmsh_elem_idx);
         if (it != m_elem_idx_gmsh_to_cf.end())
         {
           boost::tie(elements,cf_idx) = it->second;
@@ -727,7 +734,7 @@ void CReader::read_node_data()
 
   std::map<std::string,Field> fields;
 
-  boost_foreach(Uint node_data_position, m_node_data_positions)
+  boost_foreach(std::streampos node_data_position, m_node_data_positions)
   {
     m_file.seekg(node_data_position,std::ios::beg);
     read_variable_header(fields);
@@ -758,18 +765,18 @@ void CReader::read_node_data()
       CFieldView field_view("field_view");
       field_view.set_field(field);
 
-      Uint gmsh_node_idx;
+      Gid gmsh_node_idx;
       Uint cf_idx;
       Uint d;
       std::vector<Real> data(gmsh_field.var_types[i]);
 
-      for (Uint e=0; e<gmsh_field.nb_entries; ++e)
+      for (Gid e=0; e<gmsh_field.nb_entries; ++e)
       {
         m_file >> gmsh_node_idx;
         for (d=0; d<data.size(); ++d)
           m_file >> data[d];
 
-        std::map<Uint, Uint>::iterator it = m_node_idx_gmsh_to_cf.find(gmsh_node_idx);
+        std::map<Gid, Uint>::iterator it = m_node_idx_gmsh_to_cf.find(gmsh_node_idx);
         if (it != m_node_idx_gmsh_to_cf.end())
         {
           cf_idx = it->second;
@@ -803,7 +810,7 @@ void CReader::read_variable_header(std::map<std::string,Field>& fields)
   Uint nb_integer_tags(0);
   Uint field_time_step(0);
   Uint var_type(0);
-  Uint nb_entries(0);
+  Gid nb_entries(0);
 
   //Re-read the line that contains the keyword '$Elements':
   getline(m_file,line);
@@ -79,8 +79,8 @@ private: // data
   boost::shared_ptr<CMixedHash> m_hash;
 
   // map< gmsh index , pair< elements, index in elements > >
-  std::map<Uint, boost::tuple<boost::shared_ptr<CElements>,Uint> > m_elem_idx_gmsh_to_cf;
-  std::map<Uint, Uint> m_node_idx_gmsh_to_cf;
+  std::map<Gid, boost::tuple<boost::shared_ptr<CElements>,Uint> > m_elem_idx_gmsh_to_cf;
+  std::map<Gid, Uint> m_node_idx_gmsh_to_cf;
 
   boost::filesystem::fstream m_file;
   boost::shared_ptr<CMesh> m_mesh;
@@ -105,24 +105,24 @@ private: // data
 
   std::vector<RegionData> m_region_list;
 
-  std::set<Uint> m_ghost_nodes;
-  //std::set<Uint> m_ghost_elems;
-  std::set<Uint> m_nodes_to_read;
+  std::set<Gid> m_ghost_nodes;
+  //std::set<Gid> m_ghost_elems;
+  std::set<Gid> m_nodes_to_read;
 
   std::vector<std::set<Uint> > m_node_to_glb_elements;
 
   //Markers for important places in the file to be read
-  Uint m_region_names_position;
-  Uint m_coordinates_position;
-  Uint m_elements_position;
-  std::vector<Uint> m_element_data_positions;
-  std::vector<Uint> m_node_data_positions;
-  std::vector<Uint> m_element_node_data_positions;
+  std::streampos m_region_names_position;
+  std::streampos m_coordinates_position;
+  std::streampos m_elements_position;
+  std::vector<std::streampos> m_element_data_positions;
+  std::vector<std::streampos> m_node_data_positions;
+  std::vector<std::streampos> m_element_node_data_positions;
 
 
   std::vector<std::vector<Uint> > m_nb_gmsh_elem_in_region;
-  Uint m_total_nb_elements;
-  Uint m_total_nb_nodes;
+  Gid m_total_nb_elements;
+  Gid m_total_nb_nodes;
 
   struct Field
   {
@@ -133,8 +133,8 @@ private: // data
     Real time;
     Uint time_step;
     std::vector<Uint> var_types;
-    Uint nb_entries;
-    std::vector<Uint> file_data_positions;
+    Gid nb_entries;
+    std::vector<std::streampos> file_data_positions;
   };
 
   void read_variable_header(std::map<std::string,Field>& fields);
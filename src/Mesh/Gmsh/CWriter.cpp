@@ -58,6 +58,8 @@ CWriter::CWriter( const std::string& name )
   m_elementTypes["CF.Mesh.SF.Quad3DLagrangeP1" ]=3;
   m_elementTypes["CF.Mesh.SF.Tetra3DLagrangeP1"]=4;
   m_elementTypes["CF.Mesh.SF.Hexa3DLagrangeP1" ]=5;
+  m_elementTypes["CF.Mesh.SF.Prism3DLagrangeP1"]=6;
+  m_elementTypes["CF.Mesh.SF.Pyramid3DLagrangeP1"]=7;
 
   m_elementTypes["CF.Mesh.SF.Line1DLagrangeP2" ]=8;
   m_elementTypes["CF.Mesh.SF.Line2DLagrangeP2" ]=8;
@@ -222,7 +224,7 @@ void CWriter::write_connectivity(std::fstream& file)
   Uint group_number;
   Uint elm_type;
   Uint number_of_tags=3; // 1 for physical entity,  1 for elementary geometrical entity,  1 for mesh partition
-  Uint elm_number=0;
+  Gid elm_number=0;
   Uint partition_number = mpi::PE::instance().rank();
 
   boost_foreach(const CEntities& elements, m_mesh->topology().elements_range())
@@ -328,7 +330,7 @@ void CWriter::write_elem_nodal_data(std::fstream& file)
           {
             CMultiStateFieldView field_view("field_view");
             field_view.initialize(elementbased_field,elements.as_ptr<CEntities>());
-            Uint elm_number = m_element_start_idx[&elements];
+            Gid elm_number = m_element_start_idx[&elements];
             Uint local_nb_elms = elements.size();
 
             const Uint nb_states = field_view.space().nb_states();
@@ -605,7 +607,7 @@ void CWriter::write_element_data(std::fstream& file)
           {
             CFieldView field_view("field_view");
             field_view.initialize(elementbased_field,field_elements.as_ptr<CEntities>());
-            Uint elm_number = m_element_start_idx[&field_elements];
+            Gid elm_number = m_element_start_idx[&field_elements];
             Uint local_nb_elms = field_elements.size();
             for (Uint local_elm_idx = 0; local_elm_idx<local_nb_elms; ++local_elm_idx)
             {
@@ -66,7 +66,7 @@ private: // data
 
   std::map<std::string,Uint> m_elementTypes;
 
-  std::map<CEntities const*,Uint> m_element_start_idx;
+  std::map<CEntities const*,Gid> m_element_start_idx;
 
   boost::shared_ptr< Common::CMap<Uint,Uint> > m_cf_2_gmsh_node;
 }; // end CWriter
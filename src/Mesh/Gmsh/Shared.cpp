@@ -69,6 +69,8 @@ Shared::Shared() :
   m_supported_types.push_back("CF.Mesh.SF.Triag3DLagrangeP1");
   m_supported_types.push_back("CF.Mesh.SF.Hexa3DLagrangeP1");
   m_supported_types.push_back("CF.Mesh.SF.Tetra3DLagrangeP1");
+  m_supported_types.push_back("CF.Mesh.SF.Prism3DLagrangeP1");
+  m_supported_types.push_back("CF.Mesh.SF.Pyramid3DLagrangeP1");
   m_supported_types.push_back("CF.Mesh.SF.Point1DLagrangeP0");
   m_supported_types.push_back("CF.Mesh.SF.Point2DLagrangeP0");
   m_supported_types.push_back("CF.Mesh.SF.Point3DLagrangeP0");
@@ -78,6 +80,8 @@ Shared::Shared() :
   m_CFelement_to_GmshElement[GeoShape::QUAD ]=P1QUAD;
   m_CFelement_to_GmshElement[GeoShape::HEXA ]=P1HEXA;
   m_CFelement_to_GmshElement[GeoShape::TETRA]=P1TETRA;
+  m_CFelement_to_GmshElement[GeoShape::PRISM]=P1PRISM;
+  m_CFelement_to_GmshElement[GeoShape::PYRAM]=P1PYRAM;
   m_CFelement_to_GmshElement[GeoShape::POINT]=P0POINT;
 
   // --------------------------------------------------- NODES
@@ -151,6 +155,38 @@ Shared::Shared() :
   m_nodes_gmsh_to_cf[P1HEXA][6]=4;
   m_nodes_gmsh_to_cf[P1HEXA][7]=5;
 
+  // P1 prism
+  m_nodes_cf_to_gmsh[P1PRISM].resize(6);
+  m_nodes_cf_to_gmsh[P1PRISM][0]=0;
+  m_nodes_cf_to_gmsh[P1PRISM][1]=1;
+  m_nodes_cf_to_gmsh[P1PRISM][2]=2;
+  m_nodes_cf_to_gmsh[P1PRISM][3]=3;
+  m_nodes_cf_to_gmsh[P1PRISM][4]=4;
+  m_nodes_cf_to_gmsh[P1PRISM][5]=5;
+
+  m_nodes_gmsh_to_cf[P1PRISM].resize(6);
+  m_nodes_gmsh_to_cf[P1PRISM][0]=0;
+  m_nodes_gmsh_to_cf[P1PRISM][1]=1;
+  m_nodes_gmsh_to_cf[P1PRISM][2]=2;
+  m_nodes_gmsh_to_cf[P1PRISM][3]=3;
+  m_nodes_gmsh_to_cf[P1PRISM][4]=4;
+  m_nodes_gmsh_to_cf[P1PRISM][5]=5;
+
+  // P1 pyramid
+  m_nodes_cf_to_gmsh[P1PYRAM].resize(5);
+  m_nodes_cf_to_gmsh[P1PYRAM][0]=0;
+  m_nodes_cf_to_gmsh[P1PYRAM][1]=1;
+  m_nodes_cf_to_gmsh[P1PYRAM][2]=2;
+  m_nodes_cf_to_gmsh[P1PYRAM][3]=3;
+  m_nodes_cf_to_gmsh[P1PYRAM][4]=4;
+
+  m_nodes_gmsh_to_cf[P1PYRAM].resize(5);
+  m_nodes_gmsh_to_cf[P1PYRAM][0]=0;
+  m_nodes_gmsh_to_cf[P1PYRAM][1]=1;
+  m_nodes_gmsh_to_cf[P1PYRAM][2]=2;
+  m_nodes_gmsh_to_cf[P1PYRAM][3]=3;
+  m_nodes_gmsh_to_cf[P1PYRAM][4]=4;
+
   // P2 line
   m_nodes_cf_to_gmsh[P2LINE].resize(3);
   m_nodes_cf_to_gmsh[P2LINE][0]=0;
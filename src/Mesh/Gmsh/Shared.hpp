@@ -56,7 +56,7 @@ protected:
   static const std::string dim_name[4];
   static const std::string order_name[10];
 
-  enum GmshElement { P1LINE=1,   P1TRIAG=2,  P1QUAD=3,  P1TETRA=4,  P1HEXA=5,
+  enum GmshElement { P1LINE=1,   P1TRIAG=2,  P1QUAD=3,  P1TETRA=4,  P1HEXA=5,  P1PRISM=6,  P1PYRAM=7,
                      P2LINE=8,   P2TRIAG=9,  P2QUAD=10, P2TETRA=11, P2HEXA=12,
                      P0POINT=15, P3TRIAG=21, P3LINE=26, P3QUAD = 36 };
   
@@ -574,6 +574,119 @@ struct GaussMappedCoordsImpl<Order, GeoShape::HEXA>
   }
 };
 
+/// Prism rules: product of the triangle and line rules of the same order
+template<Uint Order>
+struct GaussMappedCoordsImpl<Order, GeoShape::PRISM>
+{
+  typedef GaussMappedCoordsImpl<Order, GeoShape::TRIAG> TriagT;
+  typedef GaussMappedCoordsImpl<Order, GeoShape::LINE> LineT;
+
+  static const Uint nb_points = TriagT::nb_points * LineT::nb_points;
+
+  typedef Eigen::Matrix<Real, 3, nb_points> CoordsT;
+  typedef Eigen::Matrix<Real, 1, nb_points> WeightsT;
+
+  static CoordsT coords()
+  {
+    const typename TriagT::CoordsT triag_coords = TriagT::coords();
+    const typename LineT::CoordsT line_coords = LineT::coords();
+
+    CoordsT result;
+    Uint n = 0;
+    for(Uint i = 0; i != TriagT::nb_points; ++i)
+    {
+      for(Uint j = 0; j != LineT::nb_points; ++j)
+      {
+        result.col(n++) << triag_coords(KSI,i), triag_coords(ETA,i), line_coords(KSI,j);
+      }
+    }
+
+    return result;
+  }
+
+  static WeightsT weights()
+  {
+    const typename TriagT::WeightsT triag_weights = TriagT::weights();
+    const typename LineT::WeightsT line_weights = LineT::weights();
+
+    WeightsT result;
+    Uint n = 0;
+    for(Uint i = 0; i != TriagT::nb_points; ++i)
+    {
+      for(Uint j = 0; j != LineT::nb_points; ++j)
+      {
+        result[n++] = triag_weights[i] * line_weights[j];
+      }
+    }
+
+    return result;
+  }
+};
+
+template<>
+struct GaussMappedCoordsImpl<1, GeoShape::PYRAM>
+{
+  static const Uint nb_points = 1;
+
+  typedef Eigen::Matrix<Real, 3, 1> CoordsT;
+  typedef Eigen::Matrix<Real, 1, 1> WeightsT;
+
+  static CoordsT coords()
+  {
+    return CoordsT(0., 0., 0.25);
+  }
+
+  static WeightsT weights()
+  {
+    WeightsT result;
+    result << 4./3.;
+    return result;
+  }
+};
+
+/// Pyramid rules: the hexahedron rule of the same order, collapsed onto the apex.
+/// Each point is moved to xi = u*(1-zeta), eta = v*(1-zeta), zeta = (1+w)/2 and its
+/// weight is multiplied by the determinant of that transformation, (1-zeta)^2/2
+template<Uint Order>
+struct GaussMappedCoordsImpl<Order, GeoShape::PYRAM>
+{
+  typedef GaussMappedCoordsImpl<Order, GeoShape::HEXA> HexaT;
+
+  static const Uint nb_points = HexaT::nb_points;
+
+  typedef Eigen::Matrix<Real, 3, nb_points> CoordsT;
+  typedef Eigen::Matrix<Real, 1, nb_points> WeightsT;
+
+  static CoordsT coords()
+  {
+    const typename HexaT::CoordsT hexa_coords = HexaT::coords();
+
+    CoordsT result;
+    for(Uint n = 0; n != nb_points; ++n)
+    {
+      const Real zeta = 0.5 * (1. + hexa_coords(ZTA,n));
+      result.col(n) << hexa_coords(KSI,n) * (1. - zeta), hexa_coords(ETA,n) * (1. - zeta), zeta;
+    }
+
+    return result;
+  }
+
+  static WeightsT weights()
+  {
+    const typename HexaT::CoordsT hexa_coords = HexaT::coords();
+    const typename HexaT::WeightsT hexa_weights = HexaT::weights();
+
+    WeightsT result;
+    for(Uint n = 0; n != nb_points; ++n)
+    {
+      const Real zeta = 0.5 * (1. + hexa_coords(ZTA,n));
+      result[n] = 0.5 * hexa_weights[n] * (1. - zeta) * (1. - zeta);
+    }
+
+    return result;
+  }
+};
+
 /// Stores pre-computed mapped coords and weights for all gauss point locations
 template<Uint Order, GeoShape::Type Shape>
 struct GaussMappedCoords
@@ -12,6 +12,7 @@
 #include <deque>
 
 #include "Common/Foreach.hpp"
+#include "Common/Allocator.hpp"
 #include "Common/BoostArray.hpp"
 #include "Common/BasicExceptions.hpp"
 #include "Common/StringConversion.hpp"
@@ -47,7 +48,7 @@ public: // typedef
   typedef ListBufferIterator<ListBufferT const> const_iterator;
 
 
-  typedef boost::multi_array<T,1> Array_t;
+  typedef boost::multi_array<T,1,Common::Allocator<T> > Array_t;
   typedef T value_type;
 
   typedef boost::shared_ptr<ListBufferT> Ptr;
@@ -4,6 +4,8 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include "Common/FindComponents.hpp"
+#include "Common/Foreach.hpp"
 #include "Common/MPI/debug.hpp"
 
 #include "Math/Consts.hpp"
@@ -11,6 +13,7 @@
 #include "Mesh/Manipulations.hpp"
 #include "Mesh/CNodes.hpp"
 #include "Mesh/CElements.hpp"
+#include "Mesh/Tags.hpp"
 
 namespace CF {
 namespace Mesh {
@@ -21,23 +24,74 @@ using namespace Math::Consts;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+EntityDataBuffers::EntityDataBuffers(Component& entities, const Uint nb_entities)
+{
+  boost_foreach(CTable<Real>& table, find_components_with_tag<CTable<Real> >(entities,Tags::entity_data()))
+  {
+    if (table.size() != nb_entities)
+      throw BadValue(FromHere(), table.uri().string()+" has "+to_str(table.size())+" rows instead of "+to_str(nb_entities));
+    tables.push_back(table.as_ptr<CTable<Real> >());
+    buffers.push_back(table.create_buffer_ptr());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void EntityDataBuffers::rm_row(const Uint idx)
+{
+  boost_foreach(CTable<Real>::Buffer::Ptr& buffer, buffers)
+    buffer->rm_row(idx);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void EntityDataBuffers::pack(mpi::Buffer& buf, const Uint idx) const
+{
+  boost_foreach(const CTable<Real>::Ptr& table, tables)
+    buf << table->array()[idx];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void EntityDataBuffers::unpack(mpi::Buffer& buf, const Uint idx)
+{
+  std::vector<Real> row;
+  boost_foreach(CTable<Real>::Buffer::Ptr& buffer, buffers)
+  {
+    buf >> row;
+    cf_always_assert(buffer->add_row(row) == idx);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void EntityDataBuffers::flush()
+{
+  boost_foreach(CTable<Real>::Buffer::Ptr& buffer, buffers)
+    buffer->flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 RemoveNodes::RemoveNodes(CNodes& nodes) :
     glb_idx (nodes.glb_idx().create_buffer()),
     rank (nodes.rank().create_buffer()),
     coordinates (nodes.coordinates().create_buffer()),
-    connected_elements (nodes.glb_elem_connectivity().create_buffer())
+    connected_elements (nodes.glb_elem_connectivity().create_buffer()),
+    entity_data (nodes,nodes.size())
 {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void RemoveNodes::operator() (const Uint idx)
 {
-  Uint val = glb_idx.get_row(idx);
+  Gid val = glb_idx.get_row(idx);
 
   glb_idx.rm_row(idx);
   rank.rm_row(idx);
   coordinates.rm_row(idx);
   connected_elements.rm_row(idx);
+  entity_data.rm_row(idx);
 
 //  std::cout << PERank << "removed node  " << val << std::endl;
 }
@@ -50,6 +104,7 @@ void RemoveNodes::flush()
   rank.flush();
   coordinates.flush();
   connected_elements.flush();
+  entity_data.flush();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -57,18 +112,20 @@ void RemoveNodes::flush()
 RemoveElements::RemoveElements(CElements& elements) :
     glb_idx (elements.glb_idx().create_buffer()),
     rank (elements.rank().create_buffer()),
-    connected_nodes (elements.node_connectivity().create_buffer())
+    connected_nodes (elements.node_connectivity().create_buffer()),
+    entity_data (elements,elements.size())
 {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void RemoveElements::operator() (const Uint idx)
 {
-  Uint val = glb_idx.get_row(idx);
+  Gid val = glb_idx.get_row(idx);
 
   glb_idx.rm_row(idx);
   rank.rm_row(idx);
   connected_nodes.rm_row(idx);
+  entity_data.rm_row(idx);
 
 //  std::cout << PERank << "removed element  " << val << std::endl;
 }
@@ -80,6 +137,7 @@ void RemoveElements::flush()
   glb_idx.flush();
   rank.flush();
   connected_nodes.flush();
+  entity_data.flush();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -90,7 +148,8 @@ PackUnpackElements::PackUnpackElements(CElements& elements) :
     m_idx(uint_max()),
     glb_idx (elements.glb_idx().create_buffer()),
     rank (elements.rank().create_buffer()),
-    connected_nodes (elements.node_connectivity().create_buffer())
+    connected_nodes (elements.node_connectivity().create_buffer()),
+    entity_data (elements,elements.size())
 {}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -106,11 +165,12 @@ PackUnpackElements& PackUnpackElements::operator() (const Uint idx, const bool r
 
 void PackUnpackElements::remove(const Uint idx)
 {
-  Uint val = glb_idx.get_row(idx);
+  Gid val = glb_idx.get_row(idx);
 
   glb_idx.rm_row(idx);
   rank.rm_row(idx);
   connected_nodes.rm_row(idx);
+  entity_data.rm_row(idx);
 
   //std::cout << PERank << "removed element  " << val << std::endl;
 }
@@ -121,7 +181,7 @@ void PackUnpackElements::pack(mpi::Buffer& buf)
 {
   cf_assert_desc("Must call using  object(idx).pack(buf), instead of object.pack(buf)" , m_idx != uint_max());
 
-  Uint val = m_elements.glb_idx()[m_idx];
+  Gid val = m_elements.glb_idx()[m_idx];
 
   buf << m_elements.glb_idx()[m_idx]
       << m_elements.rank()[m_idx];
@@ -129,6 +189,8 @@ void PackUnpackElements::pack(mpi::Buffer& buf)
   boost_foreach(const Uint connected_node, m_elements.node_connectivity()[m_idx])
       buf << connected_node;
 
+  entity_data.pack(buf,m_idx);
+
   //std::cout << PERank << "packed element    glb_idx = " << val << std::endl;
 
   if (m_remove_after_pack)
@@ -140,7 +202,7 @@ void PackUnpackElements::pack(mpi::Buffer& buf)
 
 void PackUnpackElements::unpack(mpi::Buffer& buf)
 {
-  Uint glb_idx_data;
+  Gid glb_idx_data;
   Uint rank_data;
   std::vector<Uint> connected_nodes_data(m_elements.node_connectivity().row_size());
 
@@ -153,6 +215,7 @@ void PackUnpackElements::unpack(mpi::Buffer& buf)
   idx = glb_idx.add_row(glb_idx_data);
   cf_always_assert(rank.add_row(rank_data) == idx);
   cf_always_assert(connected_nodes.add_row(connected_nodes_data) == idx);
+  entity_data.unpack(buf,idx);
 
   // std::cout << PERank << "unpacked and added element    glb_idx = " << glb_idx_data << "\t    rank = " << rank_data << "\t    connected_nodes = " << connected_nodes_data << std::endl;
 }
@@ -164,6 +227,7 @@ void PackUnpackElements::flush()
   glb_idx.flush();
   connected_nodes.flush();
   rank.flush();
+  entity_data.flush();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -175,7 +239,8 @@ PackUnpackNodes::PackUnpackNodes(CNodes& nodes) :
   glb_idx (nodes.glb_idx().create_buffer(100)),
   rank (nodes.rank().create_buffer(100)),
   coordinates (nodes.coordinates().create_buffer(100)),
-  connected_elements (nodes.glb_elem_connectivity().create_buffer(100))
+  connected_elements (nodes.glb_elem_connectivity().create_buffer(100)),
+  entity_data (nodes,nodes.size())
 {}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -191,7 +256,7 @@ PackUnpackNodes& PackUnpackNodes::operator() (const Uint idx, const bool remove_
 
 void PackUnpackNodes::remove(const Uint idx)
 {
-  Uint val = glb_idx.get_row(idx);
+  Gid val = glb_idx.get_row(idx);
 
   cf_assert(idx < m_nodes.size());
 
@@ -199,6 +264,7 @@ void PackUnpackNodes::remove(const Uint idx)
   rank.rm_row(idx);
   coordinates.rm_row(idx);
   connected_elements.rm_row(idx);
+  entity_data.rm_row(idx);
 
   m_idx = uint_max();
 }
@@ -216,7 +282,7 @@ void PackUnpackNodes::pack(mpi::Buffer& buf)
   cf_assert(m_idx < m_nodes.glb_elem_connectivity().size());
 
 
-  Uint val = m_nodes.glb_idx()[m_idx];
+  Gid val = m_nodes.glb_idx()[m_idx];
 
   buf << m_nodes.glb_idx()[m_idx];
 
@@ -226,6 +292,8 @@ void PackUnpackNodes::pack(mpi::Buffer& buf)
 
   buf << m_nodes.glb_elem_connectivity()[m_idx];
 
+  entity_data.pack(buf,m_idx);
+
 //  std::cout << PERank << "packed node    glb_idx = " << val << std::endl;
 
   if (m_remove_after_pack)
@@ -238,10 +306,10 @@ void PackUnpackNodes::pack(mpi::Buffer& buf)
 
 void PackUnpackNodes::unpack(mpi::Buffer& buf)
 {
-  Uint glb_idx_data;
+  Gid glb_idx_data;
   Uint rank_data;
   std::vector<Real> coordinates_data;
-  std::vector<Uint> connected_elems_data;
+  std::vector<Gid> connected_elems_data;
 
   buf >> glb_idx_data >> rank_data >> coordinates_data >> connected_elems_data;
 
@@ -250,6 +318,7 @@ void PackUnpackNodes::unpack(mpi::Buffer& buf)
   cf_always_assert(rank.add_row(rank_data) == idx);
   cf_always_assert(coordinates.add_row(coordinates_data) == idx);
   cf_always_assert(connected_elements.add_row(connected_elems_data) == idx);
+  entity_data.unpack(buf,idx);
 
   //std::cout << PERank << "added node    glb_idx = " << glb_idx_data << "\t    rank = " << rank_data << "\t    coords = " << coordinates_data << "\t    connected_elem = " << connected_elems_data << std::endl;
   m_idx = uint_max();
@@ -263,6 +332,7 @@ void PackUnpackNodes::flush()
   rank.flush();
   coordinates.flush();
   connected_elements.flush();
+  entity_data.flush();
   m_idx = uint_max();
 }
 
@@ -23,6 +23,28 @@ namespace Mesh {
 
   ////////////////////////////////////////////////////////////////////////////////
 
+/// Buffers for the tables tagged with Tags::entity_data() inside a component
+/// holding entities (nodes or elements), so that their rows follow the
+/// entities when these are removed, copied or migrated.
+struct EntityDataBuffers
+{
+  EntityDataBuffers(Common::Component& entities, const Uint nb_entities);
+
+  void rm_row(const Uint idx);
+
+  void pack(Common::mpi::Buffer& buf, const Uint idx) const;
+
+  /// unpacks one row for each table, which must be added at index idx
+  void unpack(Common::mpi::Buffer& buf, const Uint idx);
+
+  void flush();
+
+  std::vector<CTable<Real>::Ptr>          tables;
+  std::vector<CTable<Real>::Buffer::Ptr>  buffers;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
 struct RemoveNodes
 {
   RemoveNodes(CNodes& nodes);
@@ -31,10 +53,11 @@ struct RemoveNodes
 
   void flush();
 
-  CList<Uint>::Buffer       glb_idx;
+  CList<Gid>::Buffer        glb_idx;
   CList<Uint>::Buffer       rank;
   CTable<Real>::Buffer      coordinates;
-  CDynTable<Uint>::Buffer   connected_elements;
+  CDynTable<Gid>::Buffer    connected_elements;
+  EntityDataBuffers         entity_data;
 };
 
 struct RemoveElements
@@ -45,9 +68,10 @@ struct RemoveElements
 
   void flush();
 
-  CList<Uint>::Buffer       glb_idx;
+  CList<Gid>::Buffer        glb_idx;
   CList<Uint>::Buffer       rank;
   CTable<Uint>::Buffer      connected_nodes;
+  EntityDataBuffers         entity_data;
 };
 
 
@@ -70,9 +94,10 @@ struct PackUnpackElements: Common::mpi::PackedObject
   CElements& m_elements;
   Uint m_idx;
   bool m_remove_after_pack;
-  CList<Uint>::Buffer       glb_idx;
+  CList<Gid>::Buffer        glb_idx;
   CList<Uint>::Buffer       rank;
   CTable<Uint>::Buffer      connected_nodes;
+  EntityDataBuffers         entity_data;
 };
 
 
@@ -95,10 +120,11 @@ struct PackUnpackNodes: Common::mpi::PackedObject
   CNodes& m_nodes;
   Uint m_idx;
   bool m_remove_after_pack;
-  CList<Uint>::Buffer       glb_idx;
+  CList<Gid>::Buffer        glb_idx;
   CList<Uint>::Buffer       rank;
   CTable<Real>::Buffer      coordinates;
-  CDynTable<Uint>::Buffer   connected_elements;
+  CDynTable<Gid>::Buffer    connected_elements;
+  EntityDataBuffers         entity_data;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -15,6 +15,9 @@
 #include "Common/StreamHelpers.hpp"
 #include "Common/Foreach.hpp"
 #include "Common/StringConversion.hpp"
+#include "Common/BasicExceptions.hpp"
+
+#include "Math/Consts.hpp"
 
 #include "Mesh/CMesh.hpp"
 #include "Mesh/CTable.hpp"
@@ -112,7 +115,9 @@ void CReader::do_read_mesh_into(const URI& file, CMesh& mesh)
 
   cf_assert(m_mesh->nodes().coordinates().row_size() == m_headerData.NDFCD);
 
-  // Create a hash
+  // Create a hash, its options only hold 32-bit counts
+  if (m_headerData.NUMNP > Math::Consts::uint_max() || m_headerData.NELEM > Math::Consts::uint_max())
+    throw NotSupported(FromHere(), "The mesh of "+fp.string()+" has more than 2^32 nodes or elements");
   m_hash = create_component_ptr<CMixedHash>("hash");
   std::vector<Uint> num_obj(2);
   num_obj[0] = m_headerData.NUMNP;
@@ -173,7 +178,7 @@ void CReader::get_file_positions()
   m_element_group_positions.resize(0);
   m_boundary_condition_positions.resize(0);
 
-  int p;
+  std::streampos p;
   std::string line;
   while (!m_file.eof())
   {
@@ -198,7 +203,8 @@ void CReader::read_headerData()
 {
   m_file.seekg(0,std::ios::beg);
 
-  Uint NUMNP, NELEM, NGRPS, NBSETS, NDFCD, NDFVL;
+  Gid NUMNP, NELEM;
+  Uint NGRPS, NBSETS, NDFCD, NDFVL;
   std::string line;
 
   // skip 2 lines
@@ -242,8 +248,9 @@ void CReader::find_ghost_nodes()
 
 
     // read every line and store the connectivity in the correct region through the buffer
-    Uint elementNumber, elementType, nbElementNodes;
-    for (Uint i=0; i<m_headerData.NELEM; ++i)
+    Gid elementNumber;
+    Uint elementType, nbElementNodes;
+    for (Gid i=0; i<m_headerData.NELEM; ++i)
     {
       if (m_headerData.NELEM > 100000)
       {
@@ -257,7 +264,7 @@ void CReader::find_ghost_nodes()
         m_file >> elementNumber >> elementType >> nbElementNodes;
 
         // check if element nodes are ghost
-        std::vector<Uint> neu_element_nodes(nbElementNodes);
+        std::vector<Gid> neu_element_nodes(nbElementNodes);
         for (Uint j=0; j<nbElementNodes; ++j)
         {
           m_file >> neu_element_nodes[j];
@@ -292,10 +299,10 @@ void CReader::read_coordinates()
   // declare and allocate one coordinate row
   std::vector<Real> rowVector(m_headerData.NDFCD);
 
-  std::set<Uint>::const_iterator not_found = m_ghost_nodes.end();
+  std::set<Gid>::const_iterator not_found = m_ghost_nodes.end();
 
   Uint coord_idx=0;
-  for (Uint node_idx=1; node_idx<=m_headerData.NUMNP; ++node_idx)
+  for (Gid node_idx=1; node_idx<=m_headerData.NUMNP; ++node_idx)
   {
     if (m_headerData.NUMNP > 100000)
     {
@@ -308,7 +315,7 @@ void CReader::read_coordinates()
       nodes.rank()[coord_idx] = m_hash->subhash(NODES).part_of_obj(node_idx-1);
       m_node_to_coord_idx[node_idx]=coord_idx;
       std::stringstream ss(line);
-      Uint nodeNumber;
+      Gid nodeNumber;
       ss >> nodeNumber;
       for (Uint dim=0; dim<m_headerData.NDFCD; ++dim)
         ss >> nodes.coordinates()[coord_idx][dim];
@@ -322,7 +329,7 @@ void CReader::read_coordinates()
         nodes.rank()[coord_idx] = m_hash->subhash(NODES).part_of_obj(node_idx-1);
         m_node_to_coord_idx[node_idx]=coord_idx;
         std::stringstream ss(line);
-        Uint nodeNumber;
+        Gid nodeNumber;
         ss >> nodeNumber;
         for (Uint dim=0; dim<m_headerData.NDFCD; ++dim)
           ss >> nodes.coordinates()[coord_idx][dim];
@@ -354,12 +361,12 @@ void CReader::read_connectivity()
   // read every line and store the connectivity in the correct region through the buffer
   std::string etype_CF;
   std::vector<Uint> cf_element;
-  Uint neu_node_number;
+  Gid neu_node_number;
   Uint cf_node_number;
   Uint cf_idx;
   Uint table_idx;
 
-  for (Uint i=0; i<m_headerData.NELEM; ++i)
+  for (Gid i=0; i<m_headerData.NELEM; ++i)
   {
     if (m_headerData.NELEM > 100000)
     {
@@ -368,7 +375,8 @@ void CReader::read_connectivity()
     }
 
     // element description
-    Uint elementNumber, elementType, nbElementNodes;
+    Gid elementNumber;
+    Uint elementType, nbElementNodes;
     m_file >> elementNumber >> elementType >> nbElementNodes;
 
     // get element nodes
@@ -414,14 +422,13 @@ void CReader::read_groups()
   std::string line;
   int dummy;
 
-  std::set<Uint>::const_iterator it;
-
   for (Uint g=0; g<m_headerData.NGRPS; ++g)
   {
     m_file.seekg(m_element_group_positions[g],std::ios::beg);
 
     std::string ELMMAT;
-    Uint NGP, NELGP, MTYP, NFLAGS, I;
+    Uint NGP, MTYP, NFLAGS;
+    Gid NELGP, I;
     getline(m_file,line);  // ELEMENT GROUP...
     m_file >> line >> NGP >> line >> NELGP >> line >> MTYP >> line >> NFLAGS >> ELMMAT;
     groups[g].NGP    = NGP;
@@ -450,9 +457,9 @@ void CReader::read_groups()
     //    these new regions.
 
     // Read first to see howmany elements to allocate
-    int p = m_file.tellg();
+    std::streampos p = m_file.tellg();
     Uint nb_elems_in_group = 0;
-    for (Uint i=0; i<NELGP; ++i)
+    for (Gid i=0; i<NELGP; ++i)
     {
       m_file >> I;
       if (m_hash->subhash(ELEMS).owns(I-1))
@@ -461,7 +468,7 @@ void CReader::read_groups()
     // now allocate and read again
     groups[g].ELEM.reserve(nb_elems_in_group);
     m_file.seekg(p,std::ios::beg);
-    for (Uint i=0; i<NELGP; ++i)
+    for (Gid i=0; i<NELGP; ++i)
     {
       m_file >> I;
       if (m_hash->subhash(ELEMS).owns(I-1))
@@ -484,7 +491,7 @@ void CReader::read_groups()
     std::map<std::string,CConnectivity::Buffer::Ptr> buffer = create_connectivity_buffermap(elements);
 
     // Copy elements from tmp_region in the correct region
-    boost_foreach(Uint global_element, group.ELEM)
+    boost_foreach(Gid global_element, group.ELEM)
     {
       CElements::Ptr tmp_elems = m_global_to_tmp[global_element].first;
       Uint local_element = m_global_to_tmp[global_element].second;
@@ -513,7 +520,8 @@ void CReader::read_boundaries()
     m_file.seekg(m_boundary_condition_positions[t],std::ios::beg);
 
     std::string NAME;
-    int ITYPE, NENTRY, NVALUES, IBCODE1, IBCODE2, IBCODE3, IBCODE4, IBCODE5;
+    int ITYPE, NVALUES, IBCODE1, IBCODE2, IBCODE3, IBCODE4, IBCODE5;
+    Gid NENTRY;
 
     // read header
     getline(m_file,line);  // BOUNDARY CONDITIONS...
@@ -535,14 +543,15 @@ void CReader::read_boundaries()
     std::map<std::string,CConnectivity::Buffer::Ptr> buffer = create_connectivity_buffermap (elements);
 
     // read boundary elements connectivity
-    for (int i=0; i<NENTRY; ++i)
+    for (Gid i=0; i<NENTRY; ++i)
     {
-      int ELEM, ETYPE, FACE;
+      Gid ELEM;
+      int ETYPE, FACE;
       m_file >> ELEM >> ETYPE >> FACE;
 
-      Uint global_element = ELEM;
+      Gid global_element = ELEM;
 
-      std::map<Uint,Region_TableIndex_pair>::iterator it = m_global_to_tmp.find(global_element);
+      std::map<Gid,Region_TableIndex_pair>::iterator it = m_global_to_tmp.find(global_element);
       if (it != m_global_to_tmp.end())
       {
         CElements::Ptr tmp_elements = it->second.first;
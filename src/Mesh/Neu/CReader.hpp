@@ -79,20 +79,20 @@ private: // data
   boost::shared_ptr<CMixedHash> m_hash;
 
   // map< global index , pair< temporary table, index in temporary table > >
-  std::map<Uint,Region_TableIndex_pair> m_global_to_tmp;
+  std::map<Gid,Region_TableIndex_pair> m_global_to_tmp;
 
   boost::filesystem::fstream m_file;
   CMesh::Ptr m_mesh;
   CRegion::Ptr m_region;
   CRegion::Ptr m_tmp;
 
-	std::set<Uint> m_ghost_nodes;
-	std::map<Uint,Uint> m_node_to_coord_idx;
+	std::set<Gid> m_ghost_nodes;
+	std::map<Gid,Uint> m_node_to_coord_idx;
 
-	Uint m_nodal_coordinates_position;
-	Uint m_elements_cells_position;
-	std::vector<Uint> m_element_group_positions;
-	std::vector<Uint> m_boundary_condition_positions;
+	std::streampos m_nodal_coordinates_position;
+	std::streampos m_elements_cells_position;
+	std::vector<std::streampos> m_element_group_positions;
+	std::vector<std::streampos> m_boundary_condition_positions;
 
   struct HeaderData
   {
@@ -102,7 +102,8 @@ private: // data
     // NBSETS   Number of boundary condition sets
     // NDFCD    Number of coordinate directions (2 or 3)
     // NDFVL    Number of velocity components (2 or 3)
-    Uint NUMNP, NELEM, NGRPS, NBSETS, NDFCD, NDFVL;
+    Gid NUMNP, NELEM;
+    Uint NGRPS, NBSETS, NDFCD, NDFVL;
     std::string mesh_name;
   } m_headerData;
 
@@ -114,9 +115,10 @@ private: // data
     // NFLAGS   Number of solver-dependent flags
     // ELMMAT   Identifying name of element group (or entity or zone)
     // ELEM     Vector of element indices
-    Uint NGP, NELGP, MTYP, NFLAGS;
+    Uint NGP, MTYP, NFLAGS;
+    Gid NELGP;
     std::string ELMMAT;
-    std::vector<Uint> ELEM;
+    std::vector<Gid> ELEM;
   };
 
   struct BCData
@@ -127,7 +129,8 @@ private: // data
     // NVALUES  Number of values for each data record
     // IBCODE1  (Optional) Boundary condition code 1
     std::string NAME;
-    Uint ITYPE, NENTRY, NVALUES, IBCODE1;
+    Uint ITYPE, NVALUES, IBCODE1;
+    Gid NENTRY;
   };
 
 }; // end CReader
@@ -96,7 +96,7 @@ void CWriter::write_headerData(std::fstream& file)
   boost::gregorian::date date = boost::gregorian::from_simple_string(m_mesh->metadata().properties().value_str("date"));
 
   Uint group_counter(0);
-  Uint element_counter(0);
+  Gid element_counter(0);
   Uint bc_counter(0);
 
   const Uint node_counter = m_mesh->nodes().size();
@@ -176,10 +176,10 @@ void CWriter::write_connectivity(std::fstream& file)
   file << "      ELEMENTS/CELLS 2.3.16" << std::endl;
 
   // global element number
-  Uint elm_number=0;
+  Gid elm_number=0;
 
   // loop over all element regions
-  Uint node_idx=0;
+  Gid node_idx=0;
   boost_foreach(const CElements& elementregion, find_components_recursively<CElements>(m_mesh->topology()))
   {
     bool isBC = false;
@@ -202,7 +202,7 @@ void CWriter::write_connectivity(std::fstream& file)
       boost_foreach(const CConnectivity::ConstRow& cf_element , elementregion.node_connectivity().array())
       {
         file << std::setw(8) << ++elm_number << std::setw(3) << elm_type << std::setw(3) << nb_nodes << " ";
-        std::vector<Uint> neu_element(nb_nodes);
+        std::vector<Gid> neu_element(nb_nodes);
 
         // fill the neu_element (connectivity)
         for (Uint j=0; j<nb_nodes; ++j)
@@ -214,7 +214,7 @@ void CWriter::write_connectivity(std::fstream& file)
         }
 
         Uint eol_counter=0;
-        boost_foreach(Uint neu_node, neu_element)
+        boost_foreach(Gid neu_node, neu_element)
         {
           if (eol_counter == 7)
           {
@@ -261,10 +261,10 @@ void CWriter::write_groups(std::fstream& file)
       Uint line_counter=0;
       boost_foreach(const CElements& elementregion, find_components_recursively <CElements>(group))
       {
-        Uint elm_global_start_idx = m_global_start_idx[elementregion.as_ptr<CElements>()]+1;
-        Uint elm_global_end_idx = elementregion.node_connectivity().size() + elm_global_start_idx;
+        Gid elm_global_start_idx = m_global_start_idx[elementregion.as_ptr<CElements>()]+1;
+        Gid elm_global_end_idx = elementregion.node_connectivity().size() + elm_global_start_idx;
 
-        for (Uint elm=elm_global_start_idx; elm<elm_global_end_idx; elm++, line_counter++)
+        for (Gid elm=elm_global_start_idx; elm<elm_global_end_idx; elm++, line_counter++)
         {
           if (line_counter == 10)
           {
@@ -330,10 +330,10 @@ void CWriter::write_boundaries(std::fstream& file)
               CFaceConnectivity::ElementReferenceT connected = face_connectivity.adjacent_element(elem, face);
 
               CElements::ConstPtr connected_region = connected.first->as_ptr<CElements>();
-              Uint connected_region_start_idx = m_global_start_idx[connected_region];
+              Gid connected_region_start_idx = m_global_start_idx[connected_region];
 
               Uint elm_local_idx = connected.second;
-              Uint elm_global_idx = connected_region_start_idx + elm_local_idx;
+              Gid elm_global_idx = connected_region_start_idx + elm_local_idx;
               Uint neu_elm_type = m_CFelement_to_NeuElement[connected_region->element_type().shape()];
               Uint neu_elm_face_idx = m_faces_cf_to_neu[neu_elm_type][face_connectivity.adjacent_face(elem, face)];
 
@@ -70,7 +70,7 @@ private: // functions
 private: // data
 
   /// implementation detail, raw pointers are safe as keys
-  std::map<CElements::ConstPtr,Uint> m_global_start_idx;
+  std::map<CElements::ConstPtr,Gid> m_global_start_idx;
 
   std::string m_fileBasename;
 
@@ -0,0 +1,58 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Mesh_Prism3D_hpp
+#define CF_Mesh_Prism3D_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/assign/list_of.hpp>
+#include "Mesh/ElementType.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh {
+
+////////////////////////////////////////////////////////////////////////////////
+  
+/// This class defines a 3D prism (wedge) mesh element, with two triangular and three quadrilateral faces
+struct Mesh_API Prism3D : public ElementType
+{
+
+  /// constructor
+  Prism3D(const std::string& name);
+  
+  /// Gets the Class name
+  static std::string type_name() { return "Prism3D"; }
+
+  /// @return m_geoShape
+  static const GeoShape::Type shape = GeoShape::PRISM;
+  
+  /// @return number of faces
+  static const Uint nb_faces = 5;
+  
+  /// @return number of edges
+  static const Uint nb_edges = 9;
+  
+  /// @return m_dimensionality
+  static const Uint dimensionality = DIM_3D;
+  
+  /// @return m_dimension
+  static const Uint dimension = DIM_3D;
+  
+  virtual Real compute_area(const NodesT& coord) const { return 0.; }
+
+}; // end Prism3D
+  
+////////////////////////////////////////////////////////////////////////////////
+
+} // Mesh
+} // CF
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_Mesh_Prism3D_hpp
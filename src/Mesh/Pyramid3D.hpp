@@ -0,0 +1,58 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Mesh_Pyramid3D_hpp
+#define CF_Mesh_Pyramid3D_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/assign/list_of.hpp>
+#include "Mesh/ElementType.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh {
+
+////////////////////////////////////////////////////////////////////////////////
+  
+/// This class defines a 3D pyramid mesh element, with a quadrilateral base and four triangular faces
+struct Mesh_API Pyramid3D : public ElementType
+{
+
+  /// constructor
+  Pyramid3D(const std::string& name);
+  
+  /// Gets the Class name
+  static std::string type_name() { return "Pyramid3D"; }
+
+  /// @return m_geoShape
+  static const GeoShape::Type shape = GeoShape::PYRAM;
+  
+  /// @return number of faces
+  static const Uint nb_faces = 5;
+  
+  /// @return number of edges
+  static const Uint nb_edges = 8;
+  
+  /// @return m_dimensionality
+  static const Uint dimensionality = DIM_3D;
+  
+  /// @return m_dimension
+  static const Uint dimension = DIM_3D;
+  
+  virtual Real compute_area(const NodesT& coord) const { return 0.; }
+
+}; // end Pyramid3D
+  
+////////////////////////////////////////////////////////////////////////////////
+
+} // Mesh
+} // CF
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_Mesh_Pyramid3D_hpp
@@ -135,13 +135,13 @@ void Line1DLagrangeP1::jacobian_adjoint(const MappedCoordsT& mappedCoord, const
 
 ////////////////////////////////////////////////////////////////////////////////
 
-RealVector Line1DLagrangeP1::plane_jacobian_normal(const RealVector& mapped_coords,
-                                                   const RealMatrix& nodes,
-                                                   const CoordRef orientation) const
+void Line1DLagrangeP1::compute_plane_jacobian_normal(const RealVector& mapped_coords,
+                                                     const RealMatrix& nodes,
+                                                     const CoordRef orientation,
+                                                     RealVector& result) const
 {
-  RealVector result(1);
+  cf_assert(result.size() == dimensionality);
   result[XX] = 1.;
-  return result;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
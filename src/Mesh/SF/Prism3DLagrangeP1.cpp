@@ -0,0 +1,250 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <cmath>
+
+#include <boost/assign/list_of.hpp>
+
+#include "Common/BasicExceptions.hpp"
+#include "Common/CBuilder.hpp"
+
+#include "LibSF.hpp"
+#include "Prism3DLagrangeP1.hpp"
+#include "Quad3DLagrangeP1.hpp"
+#include "Triag3DLagrangeP1.hpp"
+
+namespace CF {
+namespace Mesh {
+namespace SF {
+
+////////////////////////////////////////////////////////////////////////////////
+
+Common::ComponentBuilder < Prism3DLagrangeP1,
+                           ElementType,
+                           LibSF >
+aPrism3DLagrangeP1_Builder;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Prism3DLagrangeP1::Prism3DLagrangeP1(const std::string& name) : Prism3D(name)
+{
+  m_nb_nodes = nb_nodes;
+  m_order = order;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Real Prism3DLagrangeP1::compute_volume(const NodesT& coord) const
+{
+  return volume(coord);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Prism3DLagrangeP1::compute_centroid(const NodesT& coord , RealVector& centroid) const
+{
+  const Real f = 1./6.;
+  centroid[XX] = f*(coord(0,XX)+coord(1,XX)+coord(2,XX)+coord(3,XX)+coord(4,XX)+coord(5,XX));
+  centroid[YY] = f*(coord(0,YY)+coord(1,YY)+coord(2,YY)+coord(3,YY)+coord(4,YY)+coord(5,YY));
+  centroid[ZZ] = f*(coord(0,ZZ)+coord(1,ZZ)+coord(2,ZZ)+coord(3,ZZ)+coord(4,ZZ)+coord(5,ZZ));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Prism3DLagrangeP1::is_coord_in_element(const RealVector& coord, const NodesT& nodes) const
+{
+  return in_element(coord,nodes);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const ElementType::FaceConnectivity& Prism3DLagrangeP1::faces()
+{
+  static FaceConnectivity connectivity;
+  if(connectivity.face_first_nodes.empty())
+  {
+    connectivity.face_first_nodes = boost::assign::list_of(0)(3)(6)(10)(14);
+    connectivity.face_node_counts = boost::assign::list_of(3)(3)(4)(4)(4);
+    connectivity.face_nodes = boost::assign::list_of(0)(2)(1)
+                                                    (3)(4)(5)
+                                                    (0)(1)(4)(3)
+                                                    (1)(2)(5)(4)
+                                                    (2)(0)(3)(5);
+  }
+  return connectivity;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const CF::Mesh::ElementType::FaceConnectivity& Prism3DLagrangeP1::face_connectivity() const
+{
+  return faces();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const CF::Mesh::ElementType& Prism3DLagrangeP1::face_type(const CF::Uint face) const
+{
+  static const Triag3DLagrangeP1 triag_facetype;
+  static const Quad3DLagrangeP1 quad_facetype;
+  if (faces().face_node_counts[face] == 3)
+    return triag_facetype;
+  return quad_facetype;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Prism3DLagrangeP1::in_element( const CoordsT& coord, const NodeMatrixT& nodes)
+{
+  for (Uint iFace=0; iFace<nb_faces; ++iFace)
+  {
+    if (!(is_orientation_inside(coord, nodes, iFace)))
+      return false;
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Prism3DLagrangeP1::is_orientation_inside(const CoordsT& coord, const NodeMatrixT& nodes, const Uint face)
+{
+  const ElementType::FaceConnectivity::RangeT face_nodes = faces().face_node_range(face);
+
+  // triangular faces are planar, their nodes are ordered with the normal pointing outwards
+  if (faces().face_node_counts[face] == 3)
+  {
+    const CoordsT v1 = nodes.row(face_nodes[1]) - nodes.row(face_nodes[0]);
+    const CoordsT v2 = nodes.row(face_nodes[2]) - nodes.row(face_nodes[0]);
+    const CoordsT pp = coord.transpose() - nodes.row(face_nodes[0]);
+    return v1.cross(v2).dot(pp) <= 0;
+  }
+
+  // bilinear quadrilateral faces: same test as for the hexahedron
+  const Uint a = face_nodes[3];
+  const Uint b = face_nodes[2];
+  const Uint c = face_nodes[1];
+  const Uint d = face_nodes[0];
+
+  RealMatrix3 M;
+  M.col(0) = nodes.row(b) - nodes.row(a);
+  M.col(1) = nodes.row(d) - nodes.row(a);
+  M.col(2) = nodes.row(c) - nodes.row(a);
+  const CoordsT pp = coord.transpose()  - nodes.row(a);
+
+  const CoordsT bp_x_dp = M.col(0).cross(M.col(1));
+  const Real h = bp_x_dp.dot(M.col(2));
+  if (h != 0)
+  {
+    RealMatrix3 T;
+    T << 1,  0,  1,
+         0,  1,  1,
+         0,  0,  h;
+
+    // Do transformation
+    RealVector ppp = T*M.inverse()*pp;
+
+    if (ppp[ZZ] < h*ppp[XX]*ppp[YY])
+      return false;
+  }
+  else
+  {
+    if (bp_x_dp.dot(pp) < 0)
+      return false;
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Prism3DLagrangeP1::shape_function_value(const MappedCoordsT& mapped_coord, ShapeFunctionsT& shape_func)
+{
+  SFPrismLagrangeP1::compute_value(mapped_coord,shape_func);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Prism3DLagrangeP1::mapped_coordinates(const CoordsT& coord, const NodeMatrixT& nodes, MappedCoordsT& mapped_coord)
+{
+  // The mapping is linear in xi and eta, but the side faces may be warped,
+  // so iterate starting from the centroid
+  mapped_coord << 1./3., 1./3., 0.;
+
+  ShapeFunctionsT sf;
+  JacobianT jac;
+  const Real threshold = 1e-24; // 1e-12 squared, because we compare the squared update
+  for (Uint nb_iters = 0; nb_iters != 100; ++nb_iters)
+  {
+    shape_function_value(mapped_coord, sf);
+    const CoordsT diff = coord - (sf*nodes).transpose();
+    jacobian(mapped_coord, nodes, jac);
+    const MappedCoordsT update = jac.transpose().inverse() * diff;
+    mapped_coord += update;
+    if (update.dot(update) < threshold)
+      return;
+  }
+
+  throw Common::FailedToConverge(FromHere(), "Failed to find Prism3DLagrangeP1 mapped coordinates");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Prism3DLagrangeP1::shape_function_gradient(const MappedCoordsT& mapped_coord, MappedGradientT& result)
+{
+  SFPrismLagrangeP1::compute_gradient(mapped_coord,result);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Real Prism3DLagrangeP1::jacobian_determinant(const MappedCoordsT& mapped_coord, const NodeMatrixT& nodes)
+{
+  JacobianT J;
+  jacobian(mapped_coord, nodes, J);
+  return J.determinant();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Prism3DLagrangeP1::jacobian(const MappedCoordsT& mapped_coord, const NodeMatrixT& nodes, JacobianT& result)
+{
+  MappedGradientT gradient;
+  shape_function_gradient(mapped_coord, gradient);
+  result.noalias() = gradient * nodes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Prism3DLagrangeP1::jacobian_adjoint(const MappedCoordsT& mapped_coord, const NodeMatrixT& nodes, JacobianT& result)
+{
+  JacobianT J;
+  jacobian(mapped_coord, nodes, J);
+  result(0, 0) =  (J(1, 1)*J(2, 2) - J(1, 2)*J(2, 1));
+  result(0, 1) = -(J(0, 1)*J(2, 2) - J(0, 2)*J(2, 1));
+  result(0, 2) =  (J(0, 1)*J(1, 2) - J(1, 1)*J(0, 2));
+  result(1, 0) = -(J(1, 0)*J(2, 2) - J(1, 2)*J(2, 0));
+  result(1, 1) =  (J(0, 0)*J(2, 2) - J(0, 2)*J(2, 0));
+  result(1, 2) = -(J(0, 0)*J(1, 2) - J(0, 2)*J(1, 0));
+  result(2, 0) =  (J(1, 0)*J(2, 1) - J(1, 1)*J(2, 0));
+  result(2, 1) = -(J(0, 0)*J(2, 1) - J(0, 1)*J(2, 0));
+  result(2, 2) =  (J(0, 0)*J(1, 1) - J(0, 1)*J(1, 0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Real Prism3DLagrangeP1::volume(const NodeMatrixT& nodes)
+{
+  // The jacobian determinant is linear in xi and eta and quadratic in zeta, so the
+  // centroid of the triangle times 2 Gauss points along zeta integrate it exactly
+  const Real mu = 1./3.;
+  const Real zeta = 1./std::sqrt(3.);
+  return 0.5 * ( jacobian_determinant(MappedCoordsT(mu, mu, -zeta), nodes)
+               + jacobian_determinant(MappedCoordsT(mu, mu,  zeta), nodes) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // SF
+} // Mesh
+} // CF
@@ -0,0 +1,252 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <cmath>
+
+#include <boost/assign/list_of.hpp>
+
+#include "Common/BasicExceptions.hpp"
+#include "Common/CBuilder.hpp"
+
+#include "LibSF.hpp"
+#include "Pyramid3DLagrangeP1.hpp"
+#include "Quad3DLagrangeP1.hpp"
+#include "Triag3DLagrangeP1.hpp"
+
+namespace CF {
+namespace Mesh {
+namespace SF {
+
+////////////////////////////////////////////////////////////////////////////////
+
+Common::ComponentBuilder < Pyramid3DLagrangeP1,
+                           ElementType,
+                           LibSF >
+aPyramid3DLagrangeP1_Builder;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Pyramid3DLagrangeP1::Pyramid3DLagrangeP1(const std::string& name) : Pyramid3D(name)
+{
+  m_nb_nodes = nb_nodes;
+  m_order = order;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Real Pyramid3DLagrangeP1::compute_volume(const NodesT& coord) const
+{
+  return volume(coord);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Pyramid3DLagrangeP1::compute_centroid(const NodesT& coord , RealVector& centroid) const
+{
+  // a quarter of the way from the center of the base to the apex
+  const Real f = 0.1875;
+  centroid[XX] = f*(coord(0,XX)+coord(1,XX)+coord(2,XX)+coord(3,XX)) + 0.25*coord(4,XX);
+  centroid[YY] = f*(coord(0,YY)+coord(1,YY)+coord(2,YY)+coord(3,YY)) + 0.25*coord(4,YY);
+  centroid[ZZ] = f*(coord(0,ZZ)+coord(1,ZZ)+coord(2,ZZ)+coord(3,ZZ)) + 0.25*coord(4,ZZ);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Pyramid3DLagrangeP1::is_coord_in_element(const RealVector& coord, const NodesT& nodes) const
+{
+  return in_element(coord,nodes);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const ElementType::FaceConnectivity& Pyramid3DLagrangeP1::faces()
+{
+  static FaceConnectivity connectivity;
+  if(connectivity.face_first_nodes.empty())
+  {
+    connectivity.face_first_nodes = boost::assign::list_of(0)(4)(7)(10)(13);
+    connectivity.face_node_counts = boost::assign::list_of(4)(3)(3)(3)(3);
+    connectivity.face_nodes = boost::assign::list_of(0)(3)(2)(1)
+                                                    (0)(1)(4)
+                                                    (1)(2)(4)
+                                                    (2)(3)(4)
+                                                    (3)(0)(4);
+  }
+  return connectivity;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const CF::Mesh::ElementType::FaceConnectivity& Pyramid3DLagrangeP1::face_connectivity() const
+{
+  return faces();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const CF::Mesh::ElementType& Pyramid3DLagrangeP1::face_type(const CF::Uint face) const
+{
+  static const Triag3DLagrangeP1 triag_facetype;
+  static const Quad3DLagrangeP1 quad_facetype;
+  if (faces().face_node_counts[face] == 3)
+    return triag_facetype;
+  return quad_facetype;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Pyramid3DLagrangeP1::in_element( const CoordsT& coord, const NodeMatrixT& nodes)
+{
+  for (Uint iFace=0; iFace<nb_faces; ++iFace)
+  {
+    if (!(is_orientation_inside(coord, nodes, iFace)))
+      return false;
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Pyramid3DLagrangeP1::is_orientation_inside(const CoordsT& coord, const NodeMatrixT& nodes, const Uint face)
+{
+  const ElementType::FaceConnectivity::RangeT face_nodes = faces().face_node_range(face);
+
+  // triangular faces are planar, their nodes are ordered with the normal pointing outwards
+  if (faces().face_node_counts[face] == 3)
+  {
+    const CoordsT v1 = nodes.row(face_nodes[1]) - nodes.row(face_nodes[0]);
+    const CoordsT v2 = nodes.row(face_nodes[2]) - nodes.row(face_nodes[0]);
+    const CoordsT pp = coord.transpose() - nodes.row(face_nodes[0]);
+    return v1.cross(v2).dot(pp) <= 0;
+  }
+
+  // the base may be a bilinear quadrilateral: same test as for the hexahedron
+  const Uint a = face_nodes[3];
+  const Uint b = face_nodes[2];
+  const Uint c = face_nodes[1];
+  const Uint d = face_nodes[0];
+
+  RealMatrix3 M;
+  M.col(0) = nodes.row(b) - nodes.row(a);
+  M.col(1) = nodes.row(d) - nodes.row(a);
+  M.col(2) = nodes.row(c) - nodes.row(a);
+  const CoordsT pp = coord.transpose()  - nodes.row(a);
+
+  const CoordsT bp_x_dp = M.col(0).cross(M.col(1));
+  const Real h = bp_x_dp.dot(M.col(2));
+  if (h != 0)
+  {
+    RealMatrix3 T;
+    T << 1,  0,  1,
+         0,  1,  1,
+         0,  0,  h;
+
+    // Do transformation
+    RealVector ppp = T*M.inverse()*pp;
+
+    if (ppp[ZZ] < h*ppp[XX]*ppp[YY])
+      return false;
+  }
+  else
+  {
+    if (bp_x_dp.dot(pp) < 0)
+      return false;
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Pyramid3DLagrangeP1::shape_function_value(const MappedCoordsT& mapped_coord, ShapeFunctionsT& shape_func)
+{
+  SFPyramidLagrangeP1::compute_value(mapped_coord,shape_func);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Pyramid3DLagrangeP1::mapped_coordinates(const CoordsT& coord, const NodeMatrixT& nodes, MappedCoordsT& mapped_coord)
+{
+  // The mapping is rational, so iterate starting from the centroid
+  mapped_coord << 0., 0., 0.25;
+
+  ShapeFunctionsT sf;
+  JacobianT jac;
+  const Real threshold = 1e-24; // 1e-12 squared, because we compare the squared update
+  for (Uint nb_iters = 0; nb_iters != 100; ++nb_iters)
+  {
+    shape_function_value(mapped_coord, sf);
+    const CoordsT diff = coord - (sf*nodes).transpose();
+    jacobian(mapped_coord, nodes, jac);
+    const MappedCoordsT update = jac.transpose().inverse() * diff;
+    mapped_coord += update;
+    if (update.dot(update) < threshold)
+      return;
+  }
+
+  throw Common::FailedToConverge(FromHere(), "Failed to find Pyramid3DLagrangeP1 mapped coordinates");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Pyramid3DLagrangeP1::shape_function_gradient(const MappedCoordsT& mapped_coord, MappedGradientT& result)
+{
+  SFPyramidLagrangeP1::compute_gradient(mapped_coord,result);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Real Pyramid3DLagrangeP1::jacobian_determinant(const MappedCoordsT& mapped_coord, const NodeMatrixT& nodes)
+{
+  JacobianT J;
+  jacobian(mapped_coord, nodes, J);
+  return J.determinant();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Pyramid3DLagrangeP1::jacobian(const MappedCoordsT& mapped_coord, const NodeMatrixT& nodes, JacobianT& result)
+{
+  MappedGradientT gradient;
+  shape_function_gradient(mapped_coord, gradient);
+  result.noalias() = gradient * nodes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Pyramid3DLagrangeP1::jacobian_adjoint(const MappedCoordsT& mapped_coord, const NodeMatrixT& nodes, JacobianT& result)
+{
+  JacobianT J;
+  jacobian(mapped_coord, nodes, J);
+  result(0, 0) =  (J(1, 1)*J(2, 2) - J(1, 2)*J(2, 1));
+  result(0, 1) = -(J(0, 1)*J(2, 2) - J(0, 2)*J(2, 1));
+  result(0, 2) =  (J(0, 1)*J(1, 2) - J(1, 1)*J(0, 2));
+  result(1, 0) = -(J(1, 0)*J(2, 2) - J(1, 2)*J(2, 0));
+  result(1, 1) =  (J(0, 0)*J(2, 2) - J(0, 2)*J(2, 0));
+  result(1, 2) = -(J(0, 0)*J(1, 2) - J(0, 2)*J(1, 0));
+  result(2, 0) =  (J(1, 0)*J(2, 1) - J(1, 1)*J(2, 0));
+  result(2, 1) = -(J(0, 0)*J(2, 1) - J(0, 1)*J(2, 0));
+  result(2, 2) =  (J(0, 0)*J(1, 1) - J(0, 1)*J(1, 0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Real Pyramid3DLagrangeP1::volume(const NodeMatrixT& nodes)
+{
+  // The jacobian determinant is constant along the rays from the apex, and at most
+  // quadratic in xi and eta on the base, so 2x2 Gauss points on the base integrate
+  // it exactly, the rays contributing a factor 1/3
+  const Real mu = 1./std::sqrt(3.);
+  return ( jacobian_determinant(MappedCoordsT(-mu, -mu, 0.), nodes)
+         + jacobian_determinant(MappedCoordsT( mu, -mu, 0.), nodes)
+         + jacobian_determinant(MappedCoordsT( mu,  mu, 0.), nodes)
+         + jacobian_determinant(MappedCoordsT(-mu,  mu, 0.), nodes) ) / 3.;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // SF
+} // Mesh
+} // CF
@@ -225,9 +225,10 @@ void Quad2DLagrangeP1::jacobian_adjoint(const MappedCoordsT& mapped_coord, const
 }
 
 
-RealVector Quad2DLagrangeP1::plane_jacobian_normal(const RealVector& mapped_coords,
-                                                   const RealMatrix& nodes,
-                                                   const CoordRef orientation) const
+void Quad2DLagrangeP1::compute_plane_jacobian_normal(const RealVector& mapped_coords,
+                                                     const RealMatrix& nodes,
+                                                     const CoordRef orientation,
+                                                     RealVector& result) const
 {
   const Real x0 = nodes(0,XX);
   const Real y0 = nodes(0,YY);
@@ -244,7 +245,7 @@ RealVector Quad2DLagrangeP1::plane_jacobian_normal(const RealVector& mapped_coor
   const Real xi =  mapped_coords[KSI];
   const Real eta = mapped_coords[ETA];
 
-  RealVector result(dimensionality);
+  cf_assert(result.size() == dimensionality);
 
   switch (orientation)
   {
@@ -256,7 +257,7 @@ RealVector Quad2DLagrangeP1::plane_jacobian_normal(const RealVector& mapped_coor
       const Real dN3deta =  (1. - xi);
       result[XX] = +0.25 * (y0*dN0deta + y1*dN1deta + y2*dN2deta + y3*dN3deta);
       result[YY] = -0.25 * (x0*dN0deta + x1*dN1deta + x2*dN2deta + x3*dN3deta);
-      return result;
+      return;
     }
     case ETA:
     {
@@ -266,13 +267,12 @@ RealVector Quad2DLagrangeP1::plane_jacobian_normal(const RealVector& mapped_coor
       const Real dN3dxi = -(1. + eta);
       result[XX] = -0.25 * (y0*dN0dxi  + y1*dN1dxi  + y2*dN2dxi  + y3*dN3dxi);
       result[YY] = +0.25 * (x0*dN0dxi  + x1*dN1dxi  + x2*dN2dxi  + x3*dN3dxi);
-      return result;
+      return;
     }
     case ZTA:
       throw Common::ShouldNotBeHere(FromHere(),"");
   }
   throw Common::ShouldNotBeHere(FromHere(),"orientation not defined");
-  return result;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -95,9 +95,10 @@ struct MESH_SF_API Quad2DLagrangeP1  : public Quad2D {
   virtual const CF::Mesh::ElementType& face_type(const CF::Uint face) const;
   virtual Real jacobian_determinant(const RealVector& mapped_coord, const RealMatrix& nodes) const;
   virtual RealMatrix jacobian(const RealVector& mapped_coord, const RealMatrix& nodes) const;
-  virtual RealVector plane_jacobian_normal(const RealVector& mapped_coords,
-                                           const RealMatrix& nodes,
-                                           const CoordRef orientation) const;
+  virtual void compute_plane_jacobian_normal(const RealVector& mapped_coords,
+                                             const RealMatrix& nodes,
+                                             const CoordRef orientation,
+                                             RealVector& result) const;
 
   /// Shape function reference
   virtual const ShapeFunction& shape_function() const
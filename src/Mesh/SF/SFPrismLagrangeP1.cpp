@@ -0,0 +1,104 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "Common/CBuilder.hpp"
+
+#include "LibSF.hpp"
+#include "SFPrismLagrangeP1.hpp"
+
+namespace CF {
+namespace Mesh {
+namespace SF {
+
+////////////////////////////////////////////////////////////////////////////////
+
+Common::ComponentBuilder < SFPrismLagrangeP1, ShapeFunction, LibSF > SFPrismLagrangeP1_Builder;
+
+////////////////////////////////////////////////////////////////////////////////
+
+SFPrismLagrangeP1::SFPrismLagrangeP1(const std::string& name) : ShapeFunction(name)
+{
+  m_dimensionality = dimensionality;
+  m_nb_nodes = nb_nodes;
+  m_order = order;
+  m_shape = shape;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SFPrismLagrangeP1::compute_value(const MappedCoordsT& mapped_coord, ValueT& result)
+{
+  const Real xi   = mapped_coord[KSI];
+  const Real eta  = mapped_coord[ETA];
+  const Real zeta = mapped_coord[ZTA];
+
+  const Real a = 1. - xi - eta;
+
+  const Real c1 = 0.5*(1 - zeta);
+  const Real c2 = 0.5*(1 + zeta);
+
+  result[0] = a*c1;
+  result[1] = xi*c1;
+  result[2] = eta*c1;
+  result[3] = a*c2;
+  result[4] = xi*c2;
+  result[5] = eta*c2;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SFPrismLagrangeP1::compute_gradient(const MappedCoordsT& mapped_coord, GradientT& result)
+{
+  const Real xi   = mapped_coord[KSI];
+  const Real eta  = mapped_coord[ETA];
+  const Real zeta = mapped_coord[ZTA];
+
+  const Real a = 1. - xi - eta;
+
+  const Real c1 = 0.5*(1 - zeta);
+  const Real c2 = 0.5*(1 + zeta);
+
+  result(KSI, 0) = -c1;
+  result(ETA, 0) = -c1;
+  result(ZTA, 0) = -0.5*a;
+
+  result(KSI, 1) =  c1;
+  result(ETA, 1) =  0.;
+  result(ZTA, 1) = -0.5*xi;
+
+  result(KSI, 2) =  0.;
+  result(ETA, 2) =  c1;
+  result(ZTA, 2) = -0.5*eta;
+
+  result(KSI, 3) = -c2;
+  result(ETA, 3) = -c2;
+  result(ZTA, 3) =  0.5*a;
+
+  result(KSI, 4) =  c2;
+  result(ETA, 4) =  0.;
+  result(ZTA, 4) =  0.5*xi;
+
+  result(KSI, 5) =  0.;
+  result(ETA, 5) =  c2;
+  result(ZTA, 5) =  0.5*eta;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+RealMatrix SFPrismLagrangeP1::s_mapped_sf_nodes =  ( RealMatrix(6,3) <<
+      0.,  0., -1.,
+      1.,  0., -1.,
+      0.,  1., -1.,
+      0.,  0.,  1.,
+      1.,  0.,  1.,
+      0.,  1.,  1.
+).finished();
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // SF
+} // Mesh
+} // CF
@@ -0,0 +1,106 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "Common/CBuilder.hpp"
+
+#include "LibSF.hpp"
+#include "SFPyramidLagrangeP1.hpp"
+
+namespace CF {
+namespace Mesh {
+namespace SF {
+
+////////////////////////////////////////////////////////////////////////////////
+
+Common::ComponentBuilder < SFPyramidLagrangeP1, ShapeFunction, LibSF > SFPyramidLagrangeP1_Builder;
+
+////////////////////////////////////////////////////////////////////////////////
+
+SFPyramidLagrangeP1::SFPyramidLagrangeP1(const std::string& name) : ShapeFunction(name)
+{
+  m_dimensionality = dimensionality;
+  m_nb_nodes = nb_nodes;
+  m_order = order;
+  m_shape = shape;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SFPyramidLagrangeP1::compute_value(const MappedCoordsT& mapped_coord, ValueT& result)
+{
+  const Real xi   = mapped_coord[KSI];
+  const Real eta  = mapped_coord[ETA];
+  const Real zeta = mapped_coord[ZTA];
+
+  const Real c = 1. - zeta;
+
+  // rational term, zero along the axis and at the apex
+  const Real r = c > 1e-12 ? xi*eta/c : 0.;
+
+  result[0] = 0.25*(c - xi - eta + r);
+  result[1] = 0.25*(c + xi - eta - r);
+  result[2] = 0.25*(c + xi + eta + r);
+  result[3] = 0.25*(c - xi + eta - r);
+  result[4] = zeta;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SFPyramidLagrangeP1::compute_gradient(const MappedCoordsT& mapped_coord, GradientT& result)
+{
+  const Real xi   = mapped_coord[KSI];
+  const Real eta  = mapped_coord[ETA];
+  const Real zeta = mapped_coord[ZTA];
+
+  const Real c = 1. - zeta;
+
+  // derivatives of the rational term xi*eta/c
+  Real dr_dxi = 0.;
+  Real dr_deta = 0.;
+  Real dr_dzeta = 0.;
+  if(c > 1e-12)
+  {
+    dr_dxi = eta/c;
+    dr_deta = xi/c;
+    dr_dzeta = xi*eta/(c*c);
+  }
+
+  result(KSI, 0) = 0.25*(-1. + dr_dxi);
+  result(ETA, 0) = 0.25*(-1. + dr_deta);
+  result(ZTA, 0) = 0.25*(-1. + dr_dzeta);
+
+  result(KSI, 1) = 0.25*( 1. - dr_dxi);
+  result(ETA, 1) = 0.25*(-1. - dr_deta);
+  result(ZTA, 1) = 0.25*(-1. - dr_dzeta);
+
+  result(KSI, 2) = 0.25*( 1. + dr_dxi);
+  result(ETA, 2) = 0.25*( 1. + dr_deta);
+  result(ZTA, 2) = 0.25*(-1. + dr_dzeta);
+
+  result(KSI, 3) = 0.25*(-1. - dr_dxi);
+  result(ETA, 3) = 0.25*( 1. - dr_deta);
+  result(ZTA, 3) = 0.25*(-1. - dr_dzeta);
+
+  result(KSI, 4) = 0.;
+  result(ETA, 4) = 0.;
+  result(ZTA, 4) = 1.;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+RealMatrix SFPyramidLagrangeP1::s_mapped_sf_nodes =  ( RealMatrix(5,3) <<
+     -1., -1.,  0.,
+      1., -1.,  0.,
+      1.,  1.,  0.,
+     -1.,  1.,  0.,
+      0.,  0.,  1.
+).finished();
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // SF
+} // Mesh
+} // CF
@@ -27,6 +27,8 @@
 #include "Quad3DLagrangeP1.hpp"
 #include "Tetra3DLagrangeP1.hpp"
 #include "Hexa3DLagrangeP1.hpp"
+#include "Prism3DLagrangeP1.hpp"
+#include "Pyramid3DLagrangeP1.hpp"
 
 namespace CF {
 namespace Mesh {
@@ -48,7 +50,9 @@ typedef boost::mpl::vector< Line1DLagrangeP1,
                             Quad2DLagrangeP2,
                             Quad3DLagrangeP1,
                             Hexa3DLagrangeP1,
-                            Tetra3DLagrangeP1
+                            Tetra3DLagrangeP1,
+                            Prism3DLagrangeP1,
+                            Pyramid3DLagrangeP1
 > Types;
 
 ///////////////////////////////////////////////////////////////////////////////
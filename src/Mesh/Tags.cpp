@@ -37,6 +37,8 @@ const char * Tags::connectivity_table () { return "connectivity_table"; }
 
 const char * Tags::geometry_elements () { return "geometry_elements"; }
 
+const char * Tags::entity_data () { return "entity_data"; }
+
 ////////////////////////////////////////////////////////////////////////////////
 
 } // Mesh
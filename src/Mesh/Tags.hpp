@@ -48,6 +48,9 @@ public:
 
   static const char * geometry_elements ();
 
+  /// tables with one row per entity, moved along with the entities when the mesh is migrated
+  static const char * entity_data ();
+
 }; // Tags
 
 ////////////////////////////////////////////////////////////////////////////////////////////
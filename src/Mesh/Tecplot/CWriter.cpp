@@ -6,6 +6,8 @@
 
 #include <iostream>
 
+#include <boost/assign/list_of.hpp>
+
 #include "Common/BoostFilesystem.hpp"
 #include "Common/Foreach.hpp"
 #include "Common/Log.hpp"
@@ -259,12 +261,28 @@ void CWriter::write_file(std::fstream& file)
     }
 
     file << "\n### connectivity\n\n";
+    // prisms and pyramids are written as bricks with coalesced nodes
+    std::vector<Uint> brick_nodes;
+    if ( etype.shape() == GeoShape::PRISM )
+      brick_nodes = boost::assign::list_of(0)(1)(2)(2)(3)(4)(5)(5);
+    else if ( etype.shape() == GeoShape::PYRAM )
+      brick_nodes = boost::assign::list_of(0)(1)(2)(3)(4)(4)(4)(4);
     // write connectivity
     boost_foreach( CConnectivity::ConstRow e_nodes, elements.node_connectivity().array() )
     {
-      boost_foreach ( Uint n, e_nodes)
+      if ( brick_nodes.empty() )
+      {
+        boost_foreach ( Uint n, e_nodes)
+        {
+          file << zone_node_idx[n] << " ";
+        }
+      }
+      else
       {
-        file << zone_node_idx[n] << " ";
+        boost_foreach ( Uint i, brick_nodes)
+        {
+          file << zone_node_idx[e_nodes[i]] << " ";
+        }
       }
       file << "\n";
     }
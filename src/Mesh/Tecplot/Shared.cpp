@@ -69,6 +69,8 @@ Shared::Shared() :
   m_supported_types.push_back("CF.Mesh.SF.Triag3DLagrangeP1");
   m_supported_types.push_back("CF.Mesh.SF.Hexa3DLagrangeP1");
   m_supported_types.push_back("CF.Mesh.SF.Tetra3DLagrangeP1");
+  m_supported_types.push_back("CF.Mesh.SF.Prism3DLagrangeP1");
+  m_supported_types.push_back("CF.Mesh.SF.Pyramid3DLagrangeP1");
   m_supported_types.push_back("CF.Mesh.SF.Point1DLagrangeP1");
   m_supported_types.push_back("CF.Mesh.SF.Point2DLagrangeP1");
   m_supported_types.push_back("CF.Mesh.SF.Point3DLagrangeP1");
@@ -101,7 +101,12 @@ void CWriter::write_from_to(const CMesh& mesh, const URI& file_path)
     (GeoShape::TRIAG,5)
     (GeoShape::QUAD, 9)
     (GeoShape::TETRA, 10)
-    (GeoShape::HEXA, 12);
+    (GeoShape::HEXA, 12)
+    (GeoShape::PRISM, 13)
+    (GeoShape::PYRAM, 14);
+
+  // VTK wedges start with the triangle whose normal points away from the other one
+  const std::vector<Uint> wedge_nodes = boost::assign::list_of(0)(2)(1)(3)(5)(4);
 
   // Count number of elements, and the total number of connectivity nodes
   Uint nb_elems = 0;
@@ -124,12 +129,13 @@ void CWriter::write_from_to(const CMesh& mesh, const URI& file_path)
       const Uint n_elems = elements.size();
       const CTable<Uint>& conn_table = elements.node_connectivity();
       const Uint n_el_nodes = elements.element_type().nb_nodes();
+      const bool is_wedge = elements.element_type().shape() == GeoShape::PRISM;
       for(Uint i = 0; i != n_elems; ++i)
       {
         file << " " << n_el_nodes;
         const CTable<Uint>::ConstRow row = conn_table[i];
         for(Uint j = 0; j != n_el_nodes; ++j)
-          file << " " << row[j];
+          file << " " << row[is_wedge ? wedge_nodes[j] : j];
         file << "\n";
       }
     }
@@ -44,6 +44,11 @@ CPartitioner::CPartitioner ( const std::string& name ) :
       ->pretty_name("Graph Package")
       ->mark_basic();
 
+  m_options.add_option<OptionT <std::string> >("approach", "PARTITION")
+      ->description("Zoltan load balancing approach: PARTITION from scratch, "
+                    "REPARTITION or REFINE to keep the migration low when the mesh is already distributed")
+      ->pretty_name("Approach");
+
   m_options.add_option<OptionT <Uint> >("debug_level", 0)
       ->description("Internal Zoltan debug level (0 to 10)")
       ->pretty_name("Debug Level");
@@ -155,7 +160,7 @@ void CPartitioner::set_partitioning_params()
   // HIER (for hybrid hierarchical partitioning)
   // NONE (for no load balancing).
 
-  zoltan_handle().Set_Param( "LB_APPROACH", "PARTITION");
+  zoltan_handle().Set_Param( "LB_APPROACH", m_options["approach"].value<std::string>() );
   // The desired load balancing approach. Only LB_METHOD = HYPERGRAPH or GRAPH
   // uses the LB_APPROACH parameter. Valid values are
   //   PARTITION (Partition "from scratch," not taking into account the current data distribution;
@@ -178,6 +183,11 @@ void CPartitioner::set_partitioning_params()
   // "PARTS" (or "PART ASSIGNMENT" or any string with "PART" in it) to return the new process and part assignment of every local object, including those not being exported.
   // "NONE", to return neither import nor export information
 
+  zoltan_handle().Set_Param( "OBJ_WEIGHT_DIM", "1");
+  // The number of weights (to be supplied by the user in a query function) associated with an object.
+  // If this parameter is zero, all objects have equal weight.
+  // The weights are given by the "partition_weight" property of the nodes and elements components.
+
 
   zoltan_handle().Set_Param( "NUM_GLOBAL_PARTS", to_str( m_options["nb_parts"].value<Uint>() ));
   // The total number of parts to be generated by a call to Zoltan_LB_Partition.
@@ -245,6 +255,11 @@ void CPartitioner::query_list_of_objects(void *data, int sizeGID, int sizeLID,
 
   p.list_of_objects_owned_by_part(mpi::PE::instance().rank(),globalID);
 
+  if (wgt_dim > 0)
+  {
+    cf_assert(wgt_dim == 1);
+    p.list_of_object_weights_in_part(mpi::PE::instance().rank(),obj_wgts);
+  }
 
   // for debugging
 #if 0
@@ -40,6 +40,9 @@ public: // functions
   /// execute the action
   virtual void execute ();
 
+  /// the area of an element is only written by its own index
+  virtual ThreadSafety thread_safety() const { return INDEPENDENT; }
+
 private: // helper functions
 
   void config_field();
@@ -28,64 +28,89 @@ namespace Actions {
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
-void compute_L2( CTable<Real>::ArrayT& array, Real& norm )
+template <typename ColumnT>
+void compute_L2( const ColumnT& values, Real& norm )
 {
   const int size = 1; // sum 1 value in each processor
 
   Real loc_norm = 0.; // norm on local processor
   Real glb_norm = 0.; // norm summed over all processors
 
-  boost_foreach(CTable<Real>::ConstRow row, array )
-      loc_norm += row[0]*row[0];
+  for (Uint i=0; i<values.size; ++i)
+    loc_norm += Real(values[i])*values[i];
 
   mpi::PE::instance().all_reduce( mpi::plus(), &loc_norm, size, &glb_norm );
 
   norm = std::sqrt(glb_norm);
 }
 
-void compute_L1( CTable<Real>::ArrayT& array, Real& norm )
+template <typename ColumnT>
+void compute_L1( const ColumnT& values, Real& norm )
 {
   const int size = 1; // sum 1 value in each processor
 
   Real loc_norm = 0.; // norm on local processor
   Real glb_norm = 0.; // norm summed over all processors
 
-  boost_foreach(CTable<Real>::ConstRow row, array )
-      loc_norm += std::abs( row[0] );
+  for (Uint i=0; i<values.size; ++i)
+    loc_norm += std::abs( values[i] );
 
   mpi::PE::instance().all_reduce( mpi::plus(), &loc_norm, size, &glb_norm );
+
+  norm = glb_norm;
 }
 
-void compute_Linf( CTable<Real>::ArrayT& array, Real& norm )
+template <typename ColumnT>
+void compute_Linf( const ColumnT& values, Real& norm )
 {
   const int size = 1; // sum 1 value in each processor
 
   Real loc_norm = 0.; // norm on local processor
   Real glb_norm = 0.; // norm summed over all processors
 
-  boost_foreach(CTable<Real>::ConstRow row, array )
-      loc_norm = std::max( std::abs(row[0]), loc_norm );
+  for (Uint i=0; i<values.size; ++i)
+    loc_norm = std::max( Real(std::abs(values[i])), loc_norm );
 
   mpi::PE::instance().all_reduce( mpi::max(), &loc_norm, size, &glb_norm );
 
   norm = glb_norm;
 }
 
-void compute_Lp( CTable<Real>::ArrayT& array, Real& norm, Uint order )
+template <typename ColumnT>
+void compute_Lp( const ColumnT& values, Real& norm, Uint order )
 {
   const int size = 1; // sum 1 value in each processor
 
   Real loc_norm = 0.; // norm on local processor
   Real glb_norm = 0.; // norm summed over all processors
 
-  boost_foreach(CTable<Real>::ConstRow row, array )
-    loc_norm += std::pow( std::abs(row[0]), (int)order ) ;
+  for (Uint i=0; i<values.size; ++i)
+    loc_norm += std::pow( Real(std::abs(values[i])), (int)order ) ;
 
   mpi::PE::instance().all_reduce( mpi::plus(), &loc_norm, size, &glb_norm );
 
   norm = std::pow(glb_norm, 1./order );
 }
 
+/// norm of the first variable, contiguous with the SoA layout
+template <typename T>
+void compute_norm( const CTable<T>& table, const Uint order, Real& norm )
+{
+  const typename CTable<T>::ConstColumn values = table.column(0);
+
+  switch(order) {
+
+  case 2:  compute_L2( values, norm );    break;
+
+  case 1:  compute_L1( values, norm );    break;
+
+  case 0:  compute_Linf( values, norm );  break; // consider order 0 as Linf
+
+  default: compute_Lp( values, norm, order );    break;
+
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 
 Common::ComponentBuilder < CComputeLNorm, CAction, LibActions > CComputeLNorm_Builder;
@@ -117,10 +142,9 @@ void CComputeLNorm::execute()
 {
   if ( m_field.expired() ) 	throw SetupError(FromHere(), "Field was not set");
 
-  CTable<Real>& table = m_field.lock()->data();
-  CTable<Real>::ArrayT& array =  table.array();
+  const CField& field = *m_field.lock();
 
-  const Uint nbrows = table.size();
+  const Uint nbrows = field.size();
 
   if ( !nbrows ) throw SetupError(FromHere(), "Field has empty table");
 
@@ -130,18 +154,10 @@ void CComputeLNorm::execute()
 
   // sum of all processors
 
-  switch(order) {
-
-  case 2:  compute_L2( array, norm );    break;
-
-  case 1:  compute_L1( array, norm );    break;
-
-  case 0:  compute_Linf( array, norm );  break; // consider order 0 as Linf
-
-  default: compute_Lp( array, norm, order );    break;
-
-  }
-
+  if ( field.precision() == CField::SINGLE )
+    compute_norm( field.data_single(), order, norm );
+  else
+    compute_norm( field.data(), order, norm );
 
   if( m_options.option("Scale").value<bool>() && order )
     norm /= nbrows;
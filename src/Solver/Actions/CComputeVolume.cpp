@@ -11,6 +11,10 @@
 #include "Mesh/CSpace.hpp"
 #include "Mesh/ElementType.hpp"
 #include "Mesh/CEntities.hpp"
+#include "Mesh/CElements.hpp"
+#include "Mesh/CNodes.hpp"
+#include "Mesh/CStructuredBlocks.hpp"
+#include "Mesh/ElementData.hpp"
 
 #include "Solver/Actions/CComputeVolume.hpp"
 
@@ -62,7 +66,10 @@ void CComputeVolume::trigger_elements()
 {
   m_can_start_loop = m_volume->set_elements(elements());
   if (m_can_start_loop)
+  {
     elements().allocate_coordinates(m_coordinates);
+    m_nodes.resize(m_coordinates.rows());
+  }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////
@@ -95,6 +102,39 @@ void CComputeVolume::execute()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void CComputeVolume::execute_block(const CStructuredBlocks& blocks, const Uint block_idx)
+{
+  const CStructuredBlocks::Block& block = blocks.block(block_idx);
+  const CElements& elems = elements().as_type<CElements>();
+  const CTable<Uint>& connectivity = elems.node_connectivity();
+  const CTable<Real>& coordinates = elems.nodes().coordinates();
+  const ElementType& etype = elems.element_type();
+  CScalarFieldView& volume = *m_volume;
+
+  // the position of the element follows from the loop, not from its index
+  Uint elem = block.first_element;
+  for (Uint k = 0; k != block.size[ZZ]; ++k)
+  {
+    for (Uint j = 0; j != block.size[YY]; ++j)
+    {
+      for (Uint i = 0; i != block.size[XX]; ++i, ++elem)
+      {
+        if (CStructuredBlocks::is_inner(block,i,j,k))
+          CStructuredBlocks::inner_element_nodes(block,elem,m_nodes);
+        else
+        {
+          const CTable<Uint>::ConstRow row = connectivity[elem];
+          std::copy(row.begin(), row.end(), m_nodes.begin());
+        }
+        fill(m_coordinates,coordinates,m_nodes);
+        volume[elem] = etype.compute_volume(m_coordinates);
+      }
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 } // Actions
 } // Solver
 } // CF
@@ -7,6 +7,8 @@
 #ifndef CF_Solver_Actions_CComputeVolume_hpp
 #define CF_Solver_Actions_CComputeVolume_hpp
 
+#include "Math/MatrixTypes.hpp"
+
 #include "Solver/Actions/CLoopOperation.hpp"
 
 /////////////////////////////////////////////////////////////////////////////////////
@@ -45,6 +47,13 @@ public: // functions
   /// execute the action
   virtual void execute ();
 
+  /// computes the volumes of a block, with the nodes of the inner elements
+  /// computed from their position instead of read from the connectivity table
+  virtual void execute_block(const Mesh::CStructuredBlocks& blocks, const Uint block);
+
+  /// the volume of an element is only written by its own index
+  virtual ThreadSafety thread_safety() const { return INDEPENDENT; }
+
 private: // helper functions
 
   void config_field();
@@ -57,6 +66,9 @@ private: // data
 
   RealMatrix m_coordinates;
 
+  /// nodes of the current element in execute_block()
+  std::vector<Uint> m_nodes;
+
 };
 
 /////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,161 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "Common/CBuilder.hpp"
+#include "Common/Foreach.hpp"
+#include "Common/FindComponents.hpp"
+#include "Common/Log.hpp"
+#include "Common/OptionComponent.hpp"
+#include "Common/OptionT.hpp"
+
+#include "Common/MPI/PE.hpp"
+
+#include "Mesh/CElements.hpp"
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CMeshTransformer.hpp"
+#include "Mesh/CNodes.hpp"
+#include "Mesh/CRegion.hpp"
+
+#include "CDynamicLoadBalance.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+using namespace CF::Common;
+using namespace CF::Mesh;
+
+namespace CF {
+namespace Solver {
+namespace Actions {
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+Common::ComponentBuilder < CDynamicLoadBalance, CAction, LibActions > CDynamicLoadBalance_Builder;
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+CDynamicLoadBalance::CDynamicLoadBalance ( const std::string& name ) : Solver::Action(name)
+{
+  mark_basic();
+
+  options().add_option( OptionComponent<Component>::create( "iterator", &m_iterator) )
+      ->pretty_name("Iterator Component")
+      ->description("The component that stores the \'iteration\'");
+
+  options().add_option< OptionT<Uint> >( "interval", 0u )
+      ->pretty_name("Interval")
+      ->description("Interval of iterations between measurements of the imbalance (0 disables the load balancing)");
+
+  options().add_option< OptionT<Real> >( "imbalance_threshold", 1.1 )
+      ->pretty_name("Imbalance Threshold")
+      ->description("The mesh is load balanced when the largest loop time of a process "
+                    "exceeds the mean loop time by this factor");
+
+  options().add_option< OptionT<Real> >( "node_weight", 0. )
+      ->pretty_name("Node Weight")
+      ->description("Partition weight of a node, relative to the mean cost of an element");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Real CDynamicLoadBalance::imbalance()
+{
+  Real loop_time = 0.;
+  boost_foreach(const CElements& elements, find_components_recursively<CElements>(mesh().topology()))
+  {
+    if (elements.properties().check("loop_time"))
+      loop_time += elements.properties().value<Real>("loop_time");
+  }
+
+  if ( !mpi::PE::instance().is_active() )
+    return 1.;
+
+  Real max_loop_time = 0.;
+  Real sum_loop_time = 0.;
+  mpi::PE::instance().all_reduce( mpi::max(),  &loop_time, 1, &max_loop_time );
+  mpi::PE::instance().all_reduce( mpi::plus(), &loop_time, 1, &sum_loop_time );
+
+  if (sum_loop_time <= 0.)
+    return 1.;
+
+  return max_loop_time * mpi::PE::instance().size() / sum_loop_time;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CDynamicLoadBalance::set_partition_weights()
+{
+  Real local[2] = {0.,0.}; // loop time and number of elements that were measured
+  boost_foreach(const CElements& elements, find_components_recursively<CElements>(mesh().topology()))
+  {
+    if (elements.properties().check("loop_time"))
+    {
+      local[0] += elements.properties().value<Real>("loop_time");
+      local[1] += elements.size();
+    }
+  }
+
+  Real global[2];
+  mpi::PE::instance().all_reduce( mpi::plus(), local, 2, global );
+  const Real mean_elem_cost = global[1] > 0. ? global[0] / global[1] : 0.;
+
+  boost_foreach(CElements& elements, find_components_recursively<CElements>(mesh().topology()))
+  {
+    Real weight = 1.;
+    if (mean_elem_cost > 0. && elements.size() > 0 && elements.properties().check("loop_time"))
+      weight = elements.properties().value<Real>("loop_time") / elements.size() / mean_elem_cost;
+    elements.properties()["partition_weight"] = weight;
+  }
+
+  mesh().nodes().properties()["partition_weight"] = option("node_weight").value<Real>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CDynamicLoadBalance::reset_loop_times()
+{
+  boost_foreach(CElements& elements, find_components_recursively<CElements>(mesh().topology()))
+  {
+    if (elements.properties().check("loop_time"))
+      elements.properties()["loop_time"] = Real(0.);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CDynamicLoadBalance::execute()
+{
+  if( m_iterator.expired() )
+    throw SetupError( FromHere(), "The option 'iterator' was not set in the component " + uri().string() );
+
+  const Uint iteration = boost::any_cast<Uint> ( m_iterator.lock()->property("iteration") );
+
+  const Uint interval = option("interval").value<Uint>();
+
+  if (interval == 0 || iteration % interval != 0)
+    return;
+
+  const Real measured_imbalance = imbalance();
+
+  CFinfo << "load imbalance at iteration " << iteration << ": " << measured_imbalance << CFendl;
+
+  if ( measured_imbalance > option("imbalance_threshold").value<Real>() )
+  {
+    set_partition_weights();
+
+    CMeshTransformer::Ptr load_balancer =
+        build_component_abstract_type<CMeshTransformer>("CF.Mesh.Actions.LoadBalance","load_balancer");
+    load_balancer->configure_option("repartition", true);
+    load_balancer->transform(mesh());
+  }
+
+  reset_loop_times();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Actions
+} // Solver
+} // CF
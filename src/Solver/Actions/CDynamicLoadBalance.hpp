@@ -0,0 +1,80 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Solver_Actions_CDynamicLoadBalance_hpp
+#define CF_Solver_Actions_CDynamicLoadBalance_hpp
+
+#include "Solver/Actions/LibActions.hpp"
+#include "Solver/Action.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Solver {
+namespace Actions {
+
+/// Periodically measures the load imbalance between the processes, and
+/// load balances the mesh again if it is too large. @n
+/// The cost of the elements is measured by the element loops (CForAllElements
+/// and CForAllElementsT), which accumulate their time in the "loop_time"
+/// property of each elements component. The imbalance is the largest loop time
+/// of a process divided by the mean over all processes. When it exceeds the
+/// threshold, each elements component gets as "partition_weight" its measured
+/// cost per element, relative to the mean cost per element over all processes,
+/// and the mesh is repartitioned with the Mesh::Actions::LoadBalance transformer,
+/// which also migrates the fields. @n
+/// The cost is only known per elements component: all elements of a component
+/// get the same, averaged, weight. This balances meshes where the cost differs
+/// between element types or regions, but not a cost that varies between the
+/// elements of one component, e.g. through local refinement of the order or
+/// a shock capturing that is active in part of a region.
+class Solver_Actions_API CDynamicLoadBalance : public Solver::Action {
+
+public: // typedefs
+
+  /// pointers
+  typedef boost::shared_ptr<CDynamicLoadBalance> Ptr;
+  typedef boost::shared_ptr<CDynamicLoadBalance const> ConstPtr;
+
+public: // functions
+  /// Contructor
+  /// @param name of the component
+  CDynamicLoadBalance ( const std::string& name );
+
+  /// Virtual destructor
+  virtual ~CDynamicLoadBalance() {}
+
+  /// Get the class name
+  static std::string type_name () { return "CDynamicLoadBalance"; }
+
+  /// execute the action
+  virtual void execute ();
+
+  /// Collective: the largest loop time of a process divided by the mean over all processes
+  Real imbalance ();
+
+private: // helper functions
+
+  /// Sets the partition weights from the measured loop times, as one averaged
+  /// cost per element for each elements component
+  void set_partition_weights ();
+
+  /// restarts the measurement of the loop times
+  void reset_loop_times ();
+
+private: // data
+
+  boost::weak_ptr<Component> m_iterator;  ///< component that holds the iteration
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Actions
+} // Solver
+} // CF
+
+#endif // CF_Solver_Actions_CDynamicLoadBalance_hpp
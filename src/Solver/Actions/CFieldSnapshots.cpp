@@ -0,0 +1,94 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "Common/CBuilder.hpp"
+#include "Common/CGroup.hpp"
+#include "Common/Foreach.hpp"
+#include "Common/Signal.hpp"
+#include "Common/StringConversion.hpp"
+
+#include "Common/XML/SignalFrame.hpp"
+
+#include "Mesh/CTable.hpp"
+
+#include "CFieldSnapshots.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+using namespace CF::Common;
+using namespace CF::Common::XML;
+using namespace CF::Mesh;
+
+namespace CF {
+namespace Solver {
+namespace Actions {
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+Common::ComponentBuilder < CFieldSnapshots, Component, LibActions > CFieldSnapshots_Builder;
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+CFieldSnapshots::CFieldSnapshots ( const std::string& name ) : Component(name)
+{
+  mark_basic();
+
+  regist_signal( "field_snapshot" )
+      ->hidden(true)
+      ->description("Called when a worker sends field values")
+      ->connect( boost::bind( &CFieldSnapshots::signal_field_snapshot, this, _1 ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CFieldSnapshots::signal_field_snapshot ( SignalArgs& args )
+{
+  const Uint iteration = args.get_option<Uint>( "iteration" );
+  const Uint rank = args.get_option<Uint>( "rank" );
+  const std::vector<std::string> fields = args.get_array<std::string>( "fields" );
+
+  const std::string group_name = "rank_" + to_str(rank);
+  Component::Ptr group = get_child_ptr( group_name );
+  if( is_null(group) )
+    group = create_component_ptr<CGroup>( group_name );
+
+  FieldSnapshot snapshot;
+  std::vector<Real> values;
+
+  boost_foreach( const std::string& field_path, fields )
+  {
+    if( !args.has_map( field_path ) )
+      throw ValueNotFound( FromHere(), "Field snapshot of iteration " + to_str(iteration) + " has no data for " + field_path );
+
+    snapshot.read( args.map( field_path ) );
+    m_decoders[ std::make_pair(rank, field_path) ].decode( snapshot, values );
+
+    const std::string table_name = URI( field_path ).name();
+    Component::Ptr table_comp = group->get_child_ptr( table_name );
+    if( is_null(table_comp) )
+    {
+      table_comp = group->create_component_ptr< CTable<Real> >( table_name );
+      table_comp->properties().add_property( "field", field_path );
+      table_comp->properties().add_property( "iteration", iteration );
+    }
+
+    CTable<Real>& table = table_comp->as_type< CTable<Real> >();
+    table.set_row_size( snapshot.row_size );
+    table.resize( snapshot.nb_rows );
+
+    for( Uint row = 0 ; row < snapshot.nb_rows ; ++row )
+      for( Uint col = 0 ; col < snapshot.row_size ; ++col )
+        table[row][col] = values[ row * snapshot.row_size + col ];
+
+    table.configure_property( "iteration", iteration );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Actions
+} // Solver
+} // CF
@@ -0,0 +1,69 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Solver_Actions_CFieldSnapshots_hpp
+#define CF_Solver_Actions_CFieldSnapshots_hpp
+
+#include <map>
+
+#include "Common/Component.hpp"
+
+#include "Solver/Actions/LibActions.hpp"
+#include "Solver/Actions/FieldStreamCodec.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Solver {
+namespace Actions {
+
+/// Receives the snapshots sent by the CStreamFields actions of the workers,
+/// in the parent process (the UI server). @n
+/// The values of each streamed field are rebuilt in a table, stored as
+/// rank_<rank>/<field name>. The table has the property "field" with the path
+/// of the field on the worker, and "iteration" with the iteration of the last
+/// snapshot.
+class Solver_Actions_API CFieldSnapshots : public Common::Component {
+
+public: // typedefs
+
+  /// pointers
+  typedef boost::shared_ptr<CFieldSnapshots> Ptr;
+  typedef boost::shared_ptr<CFieldSnapshots const> ConstPtr;
+
+public: // functions
+  /// Contructor
+  /// @param name of the component
+  CFieldSnapshots ( const std::string& name );
+
+  /// Virtual destructor
+  virtual ~CFieldSnapshots() {}
+
+  /// Get the class name
+  static std::string type_name () { return "CFieldSnapshots"; }
+
+  /// @name SIGNALS
+  //@{
+
+  /// decodes the snapshots of a worker into the tables
+  void signal_field_snapshot ( Common::SignalArgs& args );
+
+  //@} END SIGNALS
+
+private: // data
+
+  /// decoders, with the rank and the field path as key
+  std::map< std::pair<Uint,std::string>, FieldStreamDecoder > m_decoders;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Actions
+} // Solver
+} // CF
+
+#endif // CF_Solver_Actions_CFieldSnapshots_hpp
@@ -10,6 +10,7 @@
 
 #include "Mesh/CRegion.hpp"
 #include "Mesh/CCells.hpp"
+#include "Mesh/CStructuredBlocks.hpp"
 
 #include "Solver/Actions/CForAllCells.hpp"
 
@@ -41,8 +42,16 @@ void CForAllCells::execute()
     boost_foreach(CLoopOperation& op, find_components<CLoopOperation>(*this))
     {
       op.set_elements(elements);
-      if (op.can_start_loop())
+      if (op.can_start_loop() && !execute_in_threads(op,elements))
       {
+        // block-structured cells are executed block by block
+        if (CStructuredBlocks::ConstPtr blocks = CStructuredBlocks::of(elements))
+        {
+          for ( Uint block = 0; block != blocks->nb_blocks(); ++block )
+            op.execute_block(*blocks,block);
+          continue;
+        }
+
         const Uint nb_elem = elements.size();
         for ( Uint elem = 0; elem != nb_elem; ++elem )
         {
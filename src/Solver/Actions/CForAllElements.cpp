@@ -7,9 +7,11 @@
 #include "Common/Log.hpp"
 #include "Common/CBuilder.hpp"
 #include "Common/Foreach.hpp"
+#include "Common/Timer.hpp"
 
 #include "Mesh/CRegion.hpp"
 #include "Mesh/CElements.hpp"
+#include "Mesh/CStructuredBlocks.hpp"
 
 #include "Solver/Actions/CForAllElements.hpp"
 
@@ -37,12 +39,22 @@ void CForAllElements::execute()
   boost_foreach(CRegion::Ptr& region, m_loop_regions)
     boost_foreach(CElements& elements, find_components_recursively<CElements>(*region))
   {
+    Timer timer;
+
     // Setup all child operations
     boost_foreach(CLoopOperation& op, find_components<CLoopOperation>(*this))
     {
       op.set_elements(elements);
-      if (op.can_start_loop())
+      if (op.can_start_loop() && !execute_in_threads(op,elements))
       {
+        // block-structured elements are executed block by block
+        if (CStructuredBlocks::ConstPtr blocks = CStructuredBlocks::of(elements))
+        {
+          for ( Uint block = 0; block != blocks->nb_blocks(); ++block )
+            op.execute_block(*blocks,block);
+          continue;
+        }
+
         const Uint nb_elem = elements.size();
         for ( Uint elem = 0; elem != nb_elem; ++elem )
         {
@@ -51,6 +63,8 @@ void CForAllElements::execute()
         }
       }
     }
+
+    add_loop_time(elements,timer.elapsed());
   }
 }
 
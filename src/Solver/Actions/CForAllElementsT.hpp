@@ -11,6 +11,7 @@
 
 #include "Common/Foreach.hpp"
 #include "Common/FindComponents.hpp"
+#include "Common/Timer.hpp"
 
 #include "Mesh/SF/Types.hpp"
 #include "Mesh/CRegion.hpp"
@@ -45,6 +46,9 @@ class Solver_Actions_API CForAllElementsT : public CLoop
   {
     private: // data
 
+      /// Loop sharing the elements among threads
+      CForAllElementsT& loop;
+
       /// Region to loop on
       Mesh::CRegion& region;
 
@@ -54,8 +58,8 @@ class Solver_Actions_API CForAllElementsT : public CLoop
     public: // functions
 
       /// Constructor
-      ElementLooper(ActionT& operation, Mesh::CRegion& region_in )
-        : region(region_in) , op(operation)
+      ElementLooper(CForAllElementsT& loop_in, ActionT& operation, Mesh::CRegion& region_in )
+        : loop(loop_in), region(region_in) , op(operation)
       {}
 
       /// Operator
@@ -64,8 +68,9 @@ class Solver_Actions_API CForAllElementsT : public CLoop
       {
         boost_foreach(Mesh::CElements& elements, Common::find_components_recursively_with_filter<Mesh::CElements>(region,IsShapeFunction<SFType>()))
         {
+          Common::Timer timer;
           op.set_elements(elements);
-          if (op.can_start_loop())
+          if (op.can_start_loop() && !loop.execute_in_threads(op,elements))
           {
             const Uint nb_elem = elements.size();
             for ( Uint elem = 0; elem != nb_elem; ++elem )
@@ -74,6 +79,7 @@ class Solver_Actions_API CForAllElementsT : public CLoop
               op.execute();
             }
           }
+          add_loop_time(elements,timer.elapsed());
         }
       }
 
@@ -121,7 +127,7 @@ public: // functions
     {
       CFinfo << region->uri().string() << CFendl;
       
-      ElementLooper loop_elements(*m_action,*region);
+      ElementLooper loop_elements(*this,*m_action,*region);
       boost::mpl::for_each< Mesh::SF::Types >(loop_elements);
     }
   }
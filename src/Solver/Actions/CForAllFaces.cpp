@@ -40,7 +40,7 @@ void CForAllFaces::execute()
       boost_foreach(CLoopOperation& op, find_components<CLoopOperation>(*this))
       {
         op.set_elements(elements);
-        if (op.can_start_loop())
+        if (op.can_start_loop() && !execute_in_threads(op,elements))
         {
           const Uint nb_elem = elements.size();
           for ( Uint elem = 0; elem != nb_elem; ++elem )
@@ -35,9 +35,13 @@ void CForAllNodes2::execute()
 {
   boost_foreach(CRegion::Ptr& region, m_loop_regions)
   {
+    const CList<Uint>::ListT& nodes = CElements::used_nodes(*region).array();
     boost_foreach(CLoopOperation& op, find_components<CLoopOperation>(*this))
     {
-     boost_foreach(const Uint node, CElements::used_nodes(*region).array())
+      if (execute_in_threads(op,nodes.data(),nodes.size()))
+        continue;
+
+      boost_foreach(const Uint node, nodes)
       {
         op.select_loop_idx(node);
         op.execute();
@@ -4,14 +4,20 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include <boost/bind.hpp>
+
 #include "Common/URI.hpp"
  
 
+#include "Common/Foreach.hpp"
 #include "Common/OptionArray.hpp"
+#include "Common/ThreadPool.hpp"
 
 #include "Solver/Actions/CLoop.hpp"
+#include "Solver/Actions/EntityColoring.hpp"
 
 #include "Mesh/CRegion.hpp"
+#include "Mesh/CElements.hpp"
 
 /////////////////////////////////////////////////////////////////////////////////////
 
@@ -24,6 +30,28 @@ namespace Actions {
 
 /////////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+/// Loops smaller than this are not worth sharing among threads
+const Uint min_nb_indexes = 64;
+
+/// Executes the operation of a thread on the indexes [begin,end[ of a list,
+/// or on [begin,end[ itself if there is no list
+void execute_range(const std::vector<CLoopOperation*>& ops, const Uint* indexes,
+                   const Uint begin, const Uint end, const Uint thread)
+{
+  CLoopOperation& op = *ops[thread];
+  for (Uint i=begin; i!=end; ++i)
+  {
+    op.select_loop_idx(indexes ? indexes[i] : i);
+    op.execute();
+  }
+}
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////
+
 CLoop::CLoop ( const std::string& name ) :
   Solver::Action(name)
 {
@@ -59,6 +87,71 @@ CLoopOperation& CLoop::action(const std::string& name)
 
 /////////////////////////////////////////////////////////////////////////////////////
 
+void CLoop::add_loop_time(CElements& elements, const Real time)
+{
+  if (elements.properties().check("loop_time"))
+    elements.properties()["loop_time"] = elements.properties().value<Real>("loop_time") + time;
+  else
+    elements.properties()["loop_time"] = time;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+bool CLoop::execute_in_threads(CLoopOperation& op, CEntities& entities)
+{
+  ThreadPool& pool = ThreadPool::instance();
+  const CLoopOperation::ThreadSafety safety = op.thread_safety();
+  if (safety == CLoopOperation::SERIAL || pool.nb_threads() == 1 || entities.size() < min_nb_indexes)
+    return false;
+
+  const std::vector<CLoopOperation*>& ops = op.thread_operations();
+  if (ops.empty())
+    return false;
+
+  for (Uint thread=1; thread<ops.size(); ++thread)
+  {
+    ops[thread]->set_elements(entities);
+    if (!ops[thread]->can_start_loop())
+      return false;
+  }
+
+  if (safety == CLoopOperation::INDEPENDENT)
+  {
+    pool.parallel_for(0, entities.size(), boost::bind(&execute_range, boost::cref(ops), (const Uint*)0, _1, _2, _3));
+    return true;
+  }
+
+  // the entities of a color are executed concurrently, the colors one after the other
+
+  const EntityColoring& colors = EntityColoring::of(entities);
+  const Uint* by_color = colors.entities().empty() ? 0 : &colors.entities()[0];
+  for (Uint c=0; c<colors.nb_colors(); ++c)
+    pool.parallel_for(colors.color_start(c), colors.color_start(c+1), boost::bind(&execute_range, boost::cref(ops), by_color, _1, _2, _3));
+
+  if (!colors.uncolored().empty())
+    execute_range(ops, &colors.uncolored()[0], 0, colors.uncolored().size(), 0);
+
+  return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+bool CLoop::execute_in_threads(CLoopOperation& op, const Uint* indexes, const Uint nb_indexes)
+{
+  ThreadPool& pool = ThreadPool::instance();
+  if (op.thread_safety() != CLoopOperation::INDEPENDENT || pool.nb_threads() == 1 || nb_indexes < min_nb_indexes)
+    return false;
+
+  const std::vector<CLoopOperation*>& ops = op.thread_operations();
+  if (ops.empty())
+    return false;
+
+  pool.parallel_for(0, nb_indexes, boost::bind(&execute_range, boost::cref(ops), indexes, _1, _2, _3));
+  return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
 } // Actions
 } // Solver
 } // CF
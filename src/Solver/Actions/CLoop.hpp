@@ -18,6 +18,8 @@ namespace CF {
   namespace Mesh
   {
     class CRegion;
+    class CElements;
+    class CEntities;
   }
 
 namespace Solver {
@@ -60,6 +62,22 @@ public: // functions
 
 protected:
 
+  /// Adds the time spent looping over the elements to their Real property "loop_time",
+  /// from which CDynamicLoadBalance estimates the cost of the elements
+  static void add_loop_time(Mesh::CElements& elements, const Real time);
+
+  /// Executes an operation on all the entities of a component with the threads of the
+  /// Common::ThreadPool, as allowed by CLoopOperation::thread_safety().
+  /// The operation must be set up for the entities with set_elements() first.
+  /// @return false if the caller has to loop serially, as the operation or the
+  ///         entities do not allow threads, or the pool has a single thread
+  bool execute_in_threads(CLoopOperation& op, Mesh::CEntities& entities);
+
+  /// Executes an operation on a list of indexes with the threads of the
+  /// Common::ThreadPool, if the operation is CLoopOperation::INDEPENDENT
+  /// @return false if the caller has to loop serially
+  bool execute_in_threads(CLoopOperation& op, const Uint* indexes, const Uint nb_indexes);
+
   /// Regions to loop over
   std::vector<boost::shared_ptr<Mesh::CRegion> > m_loop_regions;
 
@@ -5,12 +5,19 @@
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
 #include "Common/CBuilder.hpp"
+#include "Common/CFactory.hpp"
+#include "Common/Core.hpp"
+#include "Common/CFactories.hpp"
+#include "Common/FindComponents.hpp"
+#include "Common/Foreach.hpp"
 #include "Common/OptionT.hpp"
 #include "Common/OptionURI.hpp"
 #include "Common/OptionComponent.hpp"
+#include "Common/ThreadPool.hpp"
 
 #include "Mesh/CList.hpp"
 #include "Mesh/CElements.hpp"
+#include "Mesh/CStructuredBlocks.hpp"
 
 #include "Solver/Actions/CLoopOperation.hpp"
 
@@ -30,7 +37,9 @@ CLoopOperation::CLoopOperation ( const std::string& name ) :
   Common::CAction(name),
   m_can_start_loop(true),
   m_call_config_elements(true),
-  m_idx(0)
+  m_idx(0),
+  m_thread_triggers_attached(false),
+  m_serial_only(false)
 {
   // Following option is ignored if the loop is not about elements
   //m_options.add_option(OptionComponent<Mesh::CEntities>::create("Elements","Elements that are being looped",&m_elements));
@@ -77,6 +86,105 @@ void CLoopOperation::set_elements(CEntities& elements)
   m_call_config_elements = true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+CLoopOperation::Ptr CLoopOperation::clone_for_thread() const
+{
+  const std::string concrete_type = derived_type_name();
+
+  // the builders are named after the full type name, including the library namespace
+  const CFactory& factory = *Core::instance().factories().get_factory<CLoopOperation>();
+  Component::ConstPtr builder = factory.get_child_ptr(concrete_type);
+  if ( is_null(builder) )
+    throw ValueNotFound(FromHere(), "No builder of "+concrete_type+" to clone "+uri().string()+" for a thread");
+
+  CLoopOperation::Ptr clone = builder->as_ptr_checked<CBuilder>()->build(name())->as_ptr_checked<CLoopOperation>();
+  copy_options_to(*clone);
+  return clone;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CLoopOperation::copy_options_to(CLoopOperation& other) const
+{
+  boost_foreach(const OptionList::OptionStorage_t::value_type& option, m_options.store)
+  {
+    if (option.first == "Elements" || option.first == "LoopIndex")
+      continue;
+    if (other.option(option.first).value_str() != option.second->value_str())
+      other.configure_option(option.first, option.second->value());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const std::vector<CLoopOperation*>& CLoopOperation::thread_operations()
+{
+  const Uint nb_threads = ThreadPool::instance().nb_threads();
+  if (m_serial_only || m_thread_operations.size() == nb_threads)
+    return m_thread_operations;
+
+  for (Uint thread=1; thread<m_thread_operations.size(); ++thread)
+    remove_component(*m_thread_operations[thread]);
+  m_thread_operations.clear();
+
+  std::vector<CLoopOperation::Ptr> copies;
+  try
+  {
+    for (Uint thread=1; thread<nb_threads; ++thread)
+      copies.push_back(clone_for_thread());
+  }
+  catch (ValueNotFound&)
+  {
+    // the operation is executed serially
+    m_serial_only = true;
+    return m_thread_operations;
+  }
+
+  m_thread_operations.push_back(this);
+  for (Uint thread=1; thread<nb_threads; ++thread)
+  {
+    CLoopOperation::Ptr copy = copies[thread-1];
+    copy->rename("thread_"+to_str(thread));
+    add_component(copy);
+    m_thread_operations.push_back(copy.get());
+  }
+
+  // the copies follow the options from now on
+  if (!m_thread_triggers_attached)
+  {
+    boost_foreach(const OptionList::OptionStorage_t::value_type& option, m_options.store)
+    {
+      if (option.first != "Elements" && option.first != "LoopIndex")
+        option.second->attach_trigger( boost::bind( &CLoopOperation::config_thread_operations, this ) );
+    }
+    m_thread_triggers_attached = true;
+  }
+
+  return m_thread_operations;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CLoopOperation::config_thread_operations()
+{
+  for (Uint thread=1; thread<m_thread_operations.size(); ++thread)
+    copy_options_to(*m_thread_operations[thread]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CLoopOperation::execute_block(const CStructuredBlocks& blocks, const Uint block)
+{
+  const CStructuredBlocks::Block& elements = blocks.block(block);
+  const Uint end = elements.first_element + elements.nb_elements();
+  for (Uint elem = elements.first_element; elem != end; ++elem)
+  {
+    select_loop_idx(elem);
+    execute();
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////
 
 } // Actions
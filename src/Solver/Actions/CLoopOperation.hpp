@@ -17,6 +17,7 @@ namespace CF {
 namespace Mesh {
   class CElements;
   class CEntities;
+  class CStructuredBlocks;
   template <typename T> class CList;
 }
 namespace Solver {
@@ -32,6 +33,20 @@ public: // typedefs
   typedef boost::shared_ptr<CLoopOperation> Ptr;
   typedef boost::shared_ptr<CLoopOperation const> ConstPtr;
 
+  /// How the loops may share the execution of the operation among threads
+  enum ThreadSafety
+  {
+    /// the operation is executed by one thread
+    SERIAL,
+    /// execute() only writes data of the looped index,
+    /// so all the indexes are executed concurrently
+    INDEPENDENT,
+    /// execute() also writes data of the nodes of the looped element,
+    /// or of the cells adjacent to the looped face. The loops color the
+    /// elements so that elements executed concurrently share none of them.
+    COLORED
+  };
+
 public: // functions
   /// Contructor
   /// @param name of the component
@@ -53,7 +68,37 @@ public: // functions
   void set_elements(Mesh::CEntities& elements);
   
   bool can_start_loop() { return m_can_start_loop; }
-  
+
+  /// @return how the loops may share the execution of this operation among threads.
+  /// Operations that override it must not modify shared data in execute()
+  /// other than allowed by the returned value.
+  virtual ThreadSafety thread_safety() const { return SERIAL; }
+
+  /// Create a copy of this operation, executed by another thread of a parallel loop.
+  /// The default builds a new operation of the same type and copies the option values.
+  /// Operations with state that is not set through options must override it.
+  virtual CLoopOperation::Ptr clone_for_thread() const;
+
+  /// Copy the option values that differ from those of another operation of the
+  /// same type to it, except the elements and the loop index
+  void copy_options_to(CLoopOperation& other) const;
+
+  /// @return the operations executed by the threads of the Common::ThreadPool in a
+  ///         parallel loop: this operation for the first thread and copies of it for
+  ///         the others, or an empty vector if it cannot be copied.
+  /// The copies are children of this operation, named "thread_1", "thread_2", ...
+  /// They are created when the number of threads changes, and configured when
+  /// the options of this operation change.
+  const std::vector<CLoopOperation*>& thread_operations();
+
+  /// Execute the operation on the elements of a block of block-structured elements
+  /// (see Mesh::CStructuredBlocks), called by the element loops instead of execute()
+  /// when it is executed serially. Operations with a structured kernel override it:
+  /// the elements of the block are contiguous, and their neighbors inside the block
+  /// are at the strides of the block, without connectivity lookup.
+  /// The default executes the elements of the block one by one.
+  virtual void execute_block(const Mesh::CStructuredBlocks& blocks, const Uint block);
+
 protected: // functions
 
   Uint idx() const { return m_idx; }  
@@ -68,12 +113,24 @@ private: // functions
   bool m_call_config_elements;
   void config_elements();
 
+  /// copies the options to the operations of the other threads
+  void config_thread_operations();
+
 private: // data
   
   Uint m_idx;
 
   boost::weak_ptr<Mesh::CEntities>  m_elements;
 
+  /// this operation and its copies, one per thread of the last parallel loop
+  std::vector<CLoopOperation*> m_thread_operations;
+
+  /// true if the options are followed by the copies
+  bool m_thread_triggers_attached;
+
+  /// true if the operation cannot be copied with clone_for_thread()
+  bool m_serial_only;
+
 };
 
 /////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,251 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+
+#include "Common/CBuilder.hpp"
+#include "Common/Core.hpp"
+#include "Common/CRoot.hpp"
+#include "Common/Foreach.hpp"
+#include "Common/Log.hpp"
+#include "Common/OptionArray.hpp"
+#include "Common/OptionComponent.hpp"
+#include "Common/OptionT.hpp"
+#include "Common/OptionURI.hpp"
+#include "Common/StringConversion.hpp"
+
+#include "Common/MPI/CPEManager.hpp"
+#include "Common/MPI/PE.hpp"
+
+#include "Common/XML/SignalFrame.hpp"
+
+#include "Mesh/CElements.hpp"
+#include "Mesh/CField.hpp"
+#include "Mesh/CList.hpp"
+#include "Mesh/CRegion.hpp"
+
+#include "CStreamFields.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+using namespace CF::Common;
+using namespace CF::Common::XML;
+using namespace CF::Mesh;
+
+namespace CF {
+namespace Solver {
+namespace Actions {
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+Common::ComponentBuilder < CStreamFields, CAction, LibActions > CStreamFields_Builder;
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// copies the given rows of a field table after each other, in Real
+/// @return the row size of the table
+template <typename T>
+Uint copy_rows( const CTable<T>& table, const std::vector<Uint>& rows, std::vector<Real>& values )
+{
+  const Uint row_size = table.row_size();
+
+  values.resize( rows.size() * row_size );
+
+  for( Uint i = 0 ; i < rows.size() ; ++i )
+  {
+    typename CTable<T>::ConstRow row = table[ rows[i] ];
+    std::copy( row.begin(), row.end(), values.begin() + i * row_size );
+  }
+
+  return row_size;
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+CStreamFields::CStreamFields ( const std::string& name ) : Solver::Action(name),
+  m_dropped(0)
+{
+  mark_basic();
+
+  options().add_option( OptionComponent<Component>::create( "iterator", &m_iterator) )
+      ->pretty_name("Iterator Component")
+      ->description("The component that stores the \'iteration\'");
+
+  options().add_option< OptionT<Uint> >( "stride", 0 )
+      ->pretty_name("Stride")
+      ->description("Interval of iterations between snapshots (0 disables the streaming)");
+
+  std::vector< URI > dummy;
+  options().add_option< OptionArrayT < URI > > ("fields", dummy)
+      ->pretty_name("Fields")
+      ->description("Fields to stream")
+      ->attach_trigger ( boost::bind ( &CStreamFields::config_streams, this ) );
+
+  options().add_option< OptionURI >( "surface", URI() )
+      ->pretty_name("Surface")
+      ->description("If set, only the nodes of this region are sent (point-based fields only)")
+      ->attach_trigger ( boost::bind ( &CStreamFields::config_streams, this ) );
+
+  options().add_option< OptionT<Uint> >( "subsample", 1u )
+      ->pretty_name("Subsample")
+      ->description("Only one row out of this number is sent")
+      ->attach_trigger ( boost::bind ( &CStreamFields::config_streams, this ) );
+
+  options().add_option< OptionT<Uint> >( "bits", 16u )
+      ->pretty_name("Bits")
+      ->description("Number of bits used to quantize each value (between 2 and 24)")
+      ->attach_trigger ( boost::bind ( &CStreamFields::config_bits, this ) );
+
+  options().add_option< OptionT<Uint> >( "keyframe_interval", 20u )
+      ->pretty_name("Key Frame Interval")
+      ->description("Maximum number of snapshots between two snapshots that do not depend on the previous ones")
+      ->attach_trigger ( boost::bind ( &CStreamFields::config_streams, this ) );
+
+  options().add_option< OptionURI >( "receiver", URI("//Root/Tools/FieldSnapshots") )
+      ->pretty_name("Receiver")
+      ->description("Component of the parent process that receives the snapshots (see CFieldSnapshots)");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CStreamFields::config_bits()
+{
+  const Uint bits = option("bits").value<Uint>();
+
+  if( bits < FieldSnapshot::min_bits || bits > FieldSnapshot::max_bits )
+    throw BadValue( FromHere(), "Option 'bits' of " + uri().string() + " must be between "
+                    + to_str(FieldSnapshot::min_bits) + " and " + to_str(FieldSnapshot::max_bits) );
+
+  config_streams();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CStreamFields::config_streams()
+{
+  m_streams.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CStreamFields::setup_stream( const CField& field, Stream& stream ) const
+{
+  const Uint subsample = std::max( option("subsample").value<Uint>(), 1u );
+  const URI surface_path = option("surface").value<URI>();
+
+  std::vector<Uint> surface_nodes;
+  const bool on_surface = !surface_path.empty() && field.basis() == CField::Basis::POINT_BASED;
+
+  if( on_surface )
+  {
+    Component::Ptr surface = Core::instance().root().access_component_ptr( surface_path );
+
+    if( is_null(surface) )
+      throw ValueNotFound( FromHere(), "Could not find surface with path [" + surface_path.path() + "]" );
+
+    // sorted, as it is built from a set
+    const CList<Uint>& nodes = CElements::used_nodes( *surface );
+    surface_nodes.assign( nodes.array().begin(), nodes.array().end() );
+  }
+
+  stream.rows.clear();
+
+  Uint nb_selected = 0;
+
+  for( Uint row = 0 ; row < field.size() ; ++row )
+  {
+    if( on_surface && !std::binary_search( surface_nodes.begin(), surface_nodes.end(), field.used_nodes()[row] ) )
+      continue;
+
+    if( nb_selected++ % subsample == 0 )
+      stream.rows.push_back( row );
+  }
+
+  stream.encoder = FieldStreamEncoder( option("bits").value<Uint>(), option("keyframe_interval").value<Uint>() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CStreamFields::execute()
+{
+  if( m_iterator.expired() )
+    throw SetupError( FromHere(), "The option 'iterator' was not set in the component " + uri().string() );
+
+  const Uint iteration = boost::any_cast<Uint> ( m_iterator.lock()->property("iteration") );
+
+  const Uint stride = option("stride").value<Uint>();
+
+  if ( stride == 0 || iteration % stride != 0 )
+    return;
+
+  // only workers have a parent to stream to
+  if( !mpi::PE::instance().is_active() || mpi::PE::instance().get_parent() == MPI_COMM_NULL )
+    return;
+
+  Component::Ptr mgr_comp = Core::instance().root().access_component_ptr( URI("//Root/Tools/PEManager") );
+
+  if( is_null(mgr_comp) )
+    return;
+
+  mpi::CPEManager& mgr = mgr_comp->as_type<mpi::CPEManager>();
+
+  SignalFrame frame( "field_snapshot", uri(), option("receiver").value<URI>() );
+
+  std::vector<URI> field_paths; option("fields").put_value(field_paths);
+  std::vector<std::string> streamed;
+
+  FieldSnapshot snapshot;
+  std::vector<Real> values;
+
+  boost_foreach( const URI& field_path, field_paths )
+  {
+    const CField& field = access_component( field_path ).as_type<CField>();
+
+    std::map<std::string, Stream>::iterator it = m_streams.find( field.uri().path() );
+
+    if( it == m_streams.end() )
+    {
+      it = m_streams.insert( std::make_pair( field.uri().path(), Stream() ) ).first;
+      setup_stream( field, it->second );
+    }
+
+    Stream& stream = it->second;
+
+    const Uint row_size = field.precision() == CField::SINGLE ?
+        copy_rows( field.data_single(), stream.rows, values ) :
+        copy_rows( field.data(), stream.rows, values );
+
+    stream.encoder.encode( values, row_size, snapshot );
+
+    snapshot.write( frame.map( field.uri().path() ) );
+    streamed.push_back( field.uri().path() );
+  }
+
+  frame.set_option<Uint>( "iteration", iteration );
+  frame.set_option<Uint>( "rank", mpi::PE::instance().rank() );
+  frame.set_array<std::string>( "fields", streamed, " ; " );
+
+  if( mgr.try_send_to_parent( frame ) )
+  {
+    for( std::map<std::string, Stream>::iterator it = m_streams.begin() ; it != m_streams.end() ; ++it )
+      it->second.encoder.commit();
+  }
+  else
+  {
+    ++m_dropped;
+    CFdebug << "Field snapshot of iteration " << iteration << " dropped (" << m_dropped << " so far)" << CFendl;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Actions
+} // Solver
+} // CF
@@ -0,0 +1,93 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Solver_Actions_CStreamFields_hpp
+#define CF_Solver_Actions_CStreamFields_hpp
+
+#include <map>
+
+#include "Solver/Actions/LibActions.hpp"
+#include "Solver/Actions/FieldStreamCodec.hpp"
+#include "Solver/Action.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh   { class CField; }
+namespace Solver {
+namespace Actions {
+
+/// Periodically sends the values of some fields to the parent process (the UI
+/// server), as a "field_snapshot" signal on its CFieldSnapshots component. @n
+/// Rows can be restricted to the nodes of a region (e.g. a boundary, for
+/// point-based fields) and subsampled. Values are quantized and delta-encoded
+/// against the previous snapshot (see FieldStreamEncoder). @n
+/// Sending never blocks: if the previous snapshot has not been delivered yet,
+/// the current one is dropped and the next one is encoded against the last
+/// snapshot that was sent. A snapshot must fit in the receive buffer of the
+/// parent (see ListeningInfo::buffer_size()): sending a bigger one throws, and
+/// the streamed rows or bits have to be reduced.
+class Solver_Actions_API CStreamFields : public Solver::Action {
+
+public: // typedefs
+
+  /// pointers
+  typedef boost::shared_ptr<CStreamFields> Ptr;
+  typedef boost::shared_ptr<CStreamFields const> ConstPtr;
+
+public: // functions
+  /// Contructor
+  /// @param name of the component
+  CStreamFields ( const std::string& name );
+
+  /// Virtual destructor
+  virtual ~CStreamFields() {}
+
+  /// Get the class name
+  static std::string type_name () { return "CStreamFields"; }
+
+  /// execute the action
+  virtual void execute ();
+
+private: // helper functions
+
+  /// State kept for each streamed field
+  struct Stream
+  {
+    /// rows of the field data that are sent
+    std::vector<Uint> rows;
+
+    FieldStreamEncoder encoder;
+  };
+
+  /// selects the rows to send and creates the encoder of a field
+  void setup_stream ( const Mesh::CField& field, Stream& stream ) const;
+
+  /// forgets the streams, so that they are set up again on next execution
+  void config_streams ();
+
+  /// checks the number of bits before forgetting the streams
+  void config_bits ();
+
+private: // data
+
+  boost::weak_ptr<Component> m_iterator;  ///< component that holds the iteration
+
+  /// streams, with the field path as key
+  std::map<std::string, Stream> m_streams;
+
+  /// number of snapshots dropped because the previous one was not sent yet
+  Uint m_dropped;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // Actions
+} // Solver
+} // CF
+
+#endif // CF_Solver_Actions_CStreamFields_hpp
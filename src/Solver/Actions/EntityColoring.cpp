@@ -0,0 +1,142 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <map>
+
+#include <boost/cstdint.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "Common/BasicExceptions.hpp"
+#include "Common/Foreach.hpp"
+
+#include "Mesh/CElements.hpp"
+#include "Mesh/CCellFaces.hpp"
+#include "Mesh/CConnectivity.hpp"
+#include "Mesh/CFaceCellConnectivity.hpp"
+
+#include "Solver/Actions/EntityColoring.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+using namespace CF::Common;
+using namespace CF::Mesh;
+
+namespace CF {
+namespace Solver {
+namespace Actions {
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Number of colors of a coloring, one bit each in a mask
+const Uint max_nb_colors = 64;
+
+/// Colorings of the components, by address
+std::map< const CEntities*, EntityColoring >& colorings()
+{
+  static std::map< const CEntities*, EntityColoring > colorings;
+  return colorings;
+}
+
+boost::mutex& colorings_mutex()
+{
+  static boost::mutex mutex;
+  return mutex;
+}
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+const EntityColoring& EntityColoring::of(CEntities& entities)
+{
+  boost::lock_guard<boost::mutex> lock(colorings_mutex());
+
+  EntityColoring& coloring = colorings()[&entities];
+  if (coloring.m_entities.lock() != entities.as_ptr<CEntities>() || coloring.m_size != entities.size())
+    coloring.build(entities);
+  return coloring;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+void EntityColoring::build(CEntities& entities)
+{
+  m_entities = entities.as_ptr<CEntities>();
+  m_size = entities.size();
+  m_color_start.clear();
+  m_entities_by_color.clear();
+  m_uncolored.clear();
+
+  // elements conflict through their nodes, faces through their cells
+
+  const CTable<Uint>* conflicts = 0;
+  if (CElements::Ptr elements = entities.as_ptr<CElements>())
+    conflicts = &elements->node_connectivity();
+  else if (CCellFaces::Ptr faces = entities.as_ptr<CCellFaces>())
+    conflicts = &faces->cell_connectivity().connectivity();
+  else
+    throw NotSupported(FromHere(), "No coloring of "+entities.uri().string()+", which are neither elements nor faces");
+
+  const CTable<Uint>::ArrayT& table = conflicts->array();
+  Uint nb_shared = 0;
+  for (Uint idx=0; idx<m_size; ++idx)
+    boost_foreach(const Uint shared, table[idx])
+      nb_shared = std::max(nb_shared, shared+1);
+
+  // greedy coloring: every entity takes the first color none of its nodes (cells) has
+
+  std::vector<boost::uint64_t> shared_colors(nb_shared,0);
+  std::vector<Uint> color(m_size,max_nb_colors);
+  std::vector<Uint> nb_per_color(max_nb_colors,0);
+  for (Uint idx=0; idx<m_size; ++idx)
+  {
+    boost::uint64_t taken = 0;
+    boost_foreach(const Uint shared, table[idx])
+      taken |= shared_colors[shared];
+
+    Uint c=0;
+    while (c<max_nb_colors && (taken & (boost::uint64_t(1) << c)))
+      ++c;
+
+    if (c == max_nb_colors)
+    {
+      m_uncolored.push_back(idx);
+      continue;
+    }
+
+    color[idx] = c;
+    ++nb_per_color[c];
+    boost_foreach(const Uint shared, table[idx])
+      shared_colors[shared] |= boost::uint64_t(1) << c;
+  }
+
+  // entities sorted by color
+
+  Uint nb_colors = 0;
+  while (nb_colors<max_nb_colors && nb_per_color[nb_colors])
+    ++nb_colors;
+
+  m_color_start.resize(nb_colors+1,0);
+  for (Uint c=0; c<nb_colors; ++c)
+    m_color_start[c+1] = m_color_start[c] + nb_per_color[c];
+
+  std::vector<Uint> next(m_color_start.begin(),m_color_start.end()-1);
+  m_entities_by_color.resize(m_color_start.back());
+  for (Uint idx=0; idx<m_size; ++idx)
+    if (color[idx] != max_nb_colors)
+      m_entities_by_color[next[color[idx]]++] = idx;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+} // Actions
+} // Solver
+} // CF
+
+/////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,82 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Solver_Actions_EntityColoring_hpp
+#define CF_Solver_Actions_EntityColoring_hpp
+
+#include <vector>
+
+#include <boost/weak_ptr.hpp>
+
+#include "Solver/Actions/LibActions.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Mesh { class CEntities; }
+namespace Solver {
+namespace Actions {
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/// Elements or faces grouped by color, so that the entities of one color share no
+/// node (elements) or cell (faces), and may be executed concurrently by the loops
+/// that write to the nodes or cells of an entity.
+/// The greedy coloring only depends on the connectivity, so that a loop executing
+/// the colors one after the other always executes the entities in the same order.
+class Solver_Actions_API EntityColoring
+{
+public: // functions
+
+  /// Constructor, without colors
+  EntityColoring() : m_size(0), m_color_start(1,0) {}
+
+  /// @return the coloring of a component of elements or faces, computed at the first call
+  ///         and kept as long as the component exists with the same size
+  static const EntityColoring& of(Mesh::CEntities& entities);
+
+  /// @return the number of colors
+  Uint nb_colors() const { return m_color_start.size() - 1; }
+
+  /// @return the position in entities() of the first entity of a color,
+  ///         color_start(nb_colors()) being the number of colored entities
+  Uint color_start(const Uint color) const { return m_color_start[color]; }
+
+  /// @return the colored entities, sorted by color
+  const std::vector<Uint>& entities() const { return m_entities_by_color; }
+
+  /// @return the entities left when all the colors are taken, to execute serially
+  const std::vector<Uint>& uncolored() const { return m_uncolored; }
+
+private: // functions
+
+  /// Colors the entities of a component
+  void build(Mesh::CEntities& entities);
+
+private: // data
+
+  boost::weak_ptr<Mesh::CEntities> m_entities;
+
+  /// number of entities when the coloring was computed
+  Uint m_size;
+
+  /// colored entities in CSR format
+  std::vector<Uint> m_color_start;
+  std::vector<Uint> m_entities_by_color;
+
+  std::vector<Uint> m_uncolored;
+
+}; // EntityColoring
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+} // Actions
+} // Solver
+} // CF
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_Solver_Actions_EntityColoring_hpp
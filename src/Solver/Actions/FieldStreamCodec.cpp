@@ -0,0 +1,314 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+#include <cmath>
+
+#include <boost/archive/iterators/base64_from_binary.hpp>
+#include <boost/archive/iterators/binary_from_base64.hpp>
+#include <boost/archive/iterators/transform_width.hpp>
+
+#include "Common/Assertions.hpp"
+#include "Common/BasicExceptions.hpp"
+#include "Common/StringConversion.hpp"
+
+#include "Common/XML/SignalFrame.hpp"
+
+#include "Solver/Actions/FieldStreamCodec.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+using namespace CF::Common;
+using namespace CF::Common::XML;
+
+namespace CF {
+namespace Solver {
+namespace Actions {
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+typedef boost::archive::iterators::base64_from_binary<
+    boost::archive::iterators::transform_width< std::string::const_iterator, 6, 8 > > Base64Writer;
+
+typedef boost::archive::iterators::transform_width<
+    boost::archive::iterators::binary_from_base64< std::string::const_iterator >, 8, 6 > Base64Reader;
+
+/// fraction of the value span added on each side of the quantization range,
+/// so that slowly drifting values do not trigger a key frame at each snapshot
+const Real range_margin = 0.1;
+
+void to_base64 ( const std::string& binary, std::string& text )
+{
+  text.assign( Base64Writer(binary.begin()), Base64Writer(binary.end()) );
+  text.append( (3 - binary.size() % 3) % 3, '=' );
+}
+
+void from_base64 ( const std::string& text, std::string& binary )
+{
+  std::string::size_type padding = 0;
+
+  while( padding < text.size() && text[text.size() - padding - 1] == '=' )
+    ++padding;
+
+  if( text.size() % 4 != 0 || padding > 2 )
+    throw ParsingFailed( FromHere(), "Field snapshot data is not valid base64" );
+
+  const std::string stripped = text.substr( 0, text.size() - padding );
+
+  try
+  {
+    binary.assign( Base64Reader(stripped.begin()), Base64Reader(stripped.end()) );
+  }
+  catch( std::exception& e )
+  {
+    throw ParsingFailed( FromHere(), std::string("Field snapshot data is not valid base64: ") + e.what() );
+  }
+
+  binary.resize( text.size() / 4 * 3 - padding );
+}
+
+/// appends a signed difference as a zigzag-encoded variable length integer
+void write_delta ( const long long delta, std::string& out )
+{
+  unsigned long long value = ( static_cast<unsigned long long>(delta) << 1 ) ^ static_cast<unsigned long long>( delta >> 63 );
+
+  while( value >= 0x80 )
+  {
+    out.push_back( static_cast<char>( (value & 0x7F) | 0x80 ) );
+    value >>= 7;
+  }
+  out.push_back( static_cast<char>(value) );
+}
+
+long long read_delta ( std::string::const_iterator& pos, const std::string::const_iterator& end )
+{
+  unsigned long long value = 0;
+  Uint shift = 0;
+
+  while( true )
+  {
+    if( pos == end || shift > 63 )
+      throw ParsingFailed( FromHere(), "Field snapshot data is truncated" );
+
+    const unsigned char byte = static_cast<unsigned char>(*pos++);
+    value |= static_cast<unsigned long long>(byte & 0x7F) << shift;
+
+    if( (byte & 0x80) == 0 )
+      break;
+
+    shift += 7;
+  }
+
+  return static_cast<long long>( value >> 1 ) ^ -static_cast<long long>( value & 1 );
+}
+
+/// @return true if values can be quantized on this number of bits
+bool valid_bits ( const Uint bits )
+{
+  return bits >= FieldSnapshot::min_bits && bits <= FieldSnapshot::max_bits;
+}
+
+} // anonymous namespace
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+const Uint FieldSnapshot::min_bits;
+const Uint FieldSnapshot::max_bits;
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+void FieldSnapshot::write ( SignalFrame& frame ) const
+{
+  frame.set_option<bool>( "key_frame", key_frame );
+  frame.set_option<Uint>( "bits", bits );
+  frame.set_option<Uint>( "row_size", row_size );
+  frame.set_option<Uint>( "nb_rows", nb_rows );
+  frame.set_array<Real>( "min", min, " ; " );
+  frame.set_array<Real>( "max", max, " ; " );
+  frame.set_option<std::string>( "data", data );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+void FieldSnapshot::read ( const SignalFrame& frame )
+{
+  key_frame = frame.get_option<bool>( "key_frame" );
+  bits = frame.get_option<Uint>( "bits" );
+  row_size = frame.get_option<Uint>( "row_size" );
+  nb_rows = frame.get_option<Uint>( "nb_rows" );
+  min = frame.get_array<Real>( "min" );
+  max = frame.get_array<Real>( "max" );
+  data = frame.get_option<std::string>( "data" );
+
+  if( !valid_bits(bits) )
+    throw ParsingFailed( FromHere(), "Field snapshot quantized on " + to_str(bits) + " bits" );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+FieldStreamEncoder::FieldStreamEncoder ( const Uint bits, const Uint keyframe_interval ) :
+  m_bits(bits),
+  m_keyframe_interval(keyframe_interval),
+  m_since_key_frame(0),
+  m_encoded_key_frame(false)
+{
+  if( !valid_bits(bits) )
+    throw BadValue( FromHere(), "Field values can not be quantized on " + to_str(bits) + " bits"
+                    " (between " + to_str(FieldSnapshot::min_bits) + " and " + to_str(FieldSnapshot::max_bits) + ")" );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+void FieldStreamEncoder::encode ( const std::vector<Real>& values, const Uint row_size, FieldSnapshot& snapshot )
+{
+  cf_assert( row_size != 0 );
+  cf_assert( values.size() % row_size == 0 );
+
+  const Uint nb_rows = values.size() / row_size;
+  const Real levels = static_cast<Real>( (1u << m_bits) - 1 );
+
+  bool key_frame = m_reference.size() != values.size() || m_min.size() != row_size ||
+      ( m_keyframe_interval != 0 && m_since_key_frame >= m_keyframe_interval );
+
+  // values out of the current range need a new key frame
+  for( Uint i = 0 ; i < values.size() && !key_frame ; ++i )
+  {
+    const Uint col = i % row_size;
+    key_frame = values[i] < m_min[col] || values[i] > m_max[col];
+  }
+
+  m_encoded_min = m_min;
+  m_encoded_max = m_max;
+
+  if( key_frame )
+  {
+    m_encoded_min.assign( row_size, 0. );
+    m_encoded_max.assign( row_size, 0. );
+
+    for( Uint col = 0 ; col < row_size ; ++col )
+    {
+      Real lo = nb_rows ? values[col] : 0.;
+      Real hi = lo;
+
+      for( Uint row = 1 ; row < nb_rows ; ++row )
+      {
+        lo = std::min( lo, values[row*row_size + col] );
+        hi = std::max( hi, values[row*row_size + col] );
+      }
+
+      Real margin = range_margin * ( hi - lo );
+      if( margin == 0. )
+        margin = std::max( range_margin * std::abs(hi), 1e-12 );
+
+      m_encoded_min[col] = lo - margin;
+      m_encoded_max[col] = hi + margin;
+    }
+  }
+
+  m_encoded.resize( values.size() );
+
+  std::string binary;
+  binary.reserve( values.size() * 2 );
+
+  for( Uint i = 0 ; i < values.size() ; ++i )
+  {
+    const Uint col = i % row_size;
+    const Real scaled = ( values[i] - m_encoded_min[col] ) / ( m_encoded_max[col] - m_encoded_min[col] );
+
+    m_encoded[i] = static_cast<Uint>( std::min( std::max( scaled, 0. ), 1. ) * levels + 0.5 );
+
+    const long long previous = key_frame ? 0 : m_reference[i];
+    write_delta( static_cast<long long>(m_encoded[i]) - previous, binary );
+  }
+
+  m_encoded_key_frame = key_frame;
+
+  snapshot.key_frame = key_frame;
+  snapshot.bits = m_bits;
+  snapshot.row_size = row_size;
+  snapshot.nb_rows = nb_rows;
+  snapshot.min = m_encoded_min;
+  snapshot.max = m_encoded_max;
+
+  to_base64( binary, snapshot.data );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+void FieldStreamEncoder::commit ()
+{
+  m_reference.swap( m_encoded );
+  m_encoded.clear();
+
+  m_min = m_encoded_min;
+  m_max = m_encoded_max;
+
+  m_since_key_frame = m_encoded_key_frame ? 1 : m_since_key_frame + 1;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+void FieldStreamEncoder::reset ()
+{
+  m_reference.clear();
+  m_min.clear();
+  m_max.clear();
+  m_since_key_frame = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+void FieldStreamDecoder::decode ( const FieldSnapshot& snapshot, std::vector<Real>& values )
+{
+  const Uint size = snapshot.nb_rows * snapshot.row_size;
+
+  if( !valid_bits(snapshot.bits) )
+    throw ParsingFailed( FromHere(), "Field snapshot quantized on " + to_str(snapshot.bits) + " bits" );
+
+  if( snapshot.min.size() != snapshot.row_size || snapshot.max.size() != snapshot.row_size )
+    throw ParsingFailed( FromHere(), "Field snapshot range does not match its row size" );
+
+  if( !snapshot.key_frame && m_reference.size() != size )
+    throw ParsingFailed( FromHere(), "Field snapshot does not match the previous one" );
+
+  std::string binary;
+  from_base64( snapshot.data, binary );
+
+  const Real levels = static_cast<Real>( (1u << snapshot.bits) - 1 );
+
+  std::vector<Uint> quantized( size );
+  values.resize( size );
+
+  std::string::const_iterator pos = binary.begin();
+  const std::string::const_iterator end = binary.end();
+
+  for( Uint i = 0 ; i < size ; ++i )
+  {
+    const long long previous = snapshot.key_frame ? 0 : m_reference[i];
+    const long long value = previous + read_delta( pos, end );
+
+    if( value < 0 || value > static_cast<long long>(levels) )
+      throw ParsingFailed( FromHere(), "Field snapshot value out of range" );
+
+    const Uint col = i % snapshot.row_size;
+
+    quantized[i] = static_cast<Uint>(value);
+    values[i] = snapshot.min[col] + ( snapshot.max[col] - snapshot.min[col] ) * ( quantized[i] / levels );
+  }
+
+  if( pos != end )
+    throw ParsingFailed( FromHere(), "Field snapshot has trailing data" );
+
+  m_reference.swap( quantized );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+} // Actions
+} // Solver
+} // CF
@@ -0,0 +1,158 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Solver_Actions_FieldStreamCodec_hpp
+#define CF_Solver_Actions_FieldStreamCodec_hpp
+
+#include <string>
+#include <vector>
+
+#include "Common/CF.hpp"
+
+#include "Solver/Actions/LibActions.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+namespace CF {
+namespace Common { namespace XML { class SignalFrame; } }
+namespace Solver {
+namespace Actions {
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/// One encoded snapshot of a table of values, as produced by FieldStreamEncoder
+struct Solver_Actions_API FieldSnapshot
+{
+  /// true if the snapshot does not depend on the previous one
+  bool key_frame;
+
+  /// number of bits used to quantize each value
+  Uint bits;
+
+  /// number of values per row
+  Uint row_size;
+
+  /// number of rows
+  Uint nb_rows;
+
+  /// lower bound of the quantization range, per column
+  std::vector<Real> min;
+
+  /// upper bound of the quantization range, per column
+  std::vector<Real> max;
+
+  /// quantized values, delta-encoded against the previous snapshot (or against
+  /// zero for key frames), stored as base64 text so that it fits in XML frames
+  std::string data;
+
+  /// smallest number of bits per quantized value
+  static const Uint min_bits = 2;
+
+  /// largest number of bits per quantized value, so that the levels fit in a Uint
+  static const Uint max_bits = 24;
+
+  /// Writes the snapshot as options of a signal frame
+  void write ( Common::XML::SignalFrame& frame ) const;
+
+  /// Reads a snapshot written by write()
+  /// @throw ParsingFailed if the number of bits is out of range
+  void read ( const Common::XML::SignalFrame& frame );
+};
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/// Encodes successive snapshots of a table of values. @n
+/// Each column is quantized on @c bits bits over a range that is fixed at each
+/// key frame, then the difference with the last committed snapshot is stored
+/// as a variable length integer. For fields that change slowly between two
+/// snapshots, most differences fit in a single byte. @n
+/// A key frame is produced for the first snapshot, when the table size
+/// changes, when a value falls out of the current range, or every
+/// @c keyframe_interval snapshots.
+class Solver_Actions_API FieldStreamEncoder
+{
+public:
+
+  /// Constructor
+  /// @param bits number of bits per quantized value (between 2 and 24)
+  /// @param keyframe_interval maximum number of snapshots between two key
+  /// frames (0 means only when needed)
+  /// @throw BadValue if the number of bits is out of range
+  FieldStreamEncoder ( const Uint bits = 16, const Uint keyframe_interval = 20 );
+
+  /// Encodes a snapshot
+  /// @param values the table, row after row
+  /// @param row_size number of values per row
+  /// @param snapshot the encoded snapshot
+  /// @note the encoder state is only updated by commit(), so that a snapshot
+  /// that could not be sent is not used as reference for the next one
+  void encode ( const std::vector<Real>& values, const Uint row_size, FieldSnapshot& snapshot );
+
+  /// Makes the last encoded snapshot the reference for the next one
+  void commit ();
+
+  /// Forces the next snapshot to be a key frame
+  void reset ();
+
+private:
+
+  Uint m_bits;
+
+  Uint m_keyframe_interval;
+
+  /// number of snapshots committed since the last key frame
+  Uint m_since_key_frame;
+
+  /// quantized values of the reference snapshot
+  std::vector<Uint> m_reference;
+
+  /// quantized values of the last encoded snapshot
+  std::vector<Uint> m_encoded;
+
+  std::vector<Real> m_min;
+
+  std::vector<Real> m_max;
+
+  std::vector<Real> m_encoded_min;
+
+  std::vector<Real> m_encoded_max;
+
+  bool m_encoded_key_frame;
+
+};
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/// Rebuilds the values from snapshots encoded by FieldStreamEncoder.
+/// Snapshots have to be decoded in the order they were committed.
+class Solver_Actions_API FieldStreamDecoder
+{
+public:
+
+  /// Decodes a snapshot
+  /// @param snapshot the encoded snapshot
+  /// @param values the rebuilt table, row after row
+  /// @throw ParsingFailed if the data is corrupted, if the number of bits is
+  /// out of range, or if the snapshot is not a key frame and does not match
+  /// the previous one
+  void decode ( const FieldSnapshot& snapshot, std::vector<Real>& values );
+
+private:
+
+  /// quantized values of the previous snapshot
+  std::vector<Uint> m_reference;
+
+};
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+} // Actions
+} // Solver
+} // CF
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+#endif // CF_Solver_Actions_FieldStreamCodec_hpp
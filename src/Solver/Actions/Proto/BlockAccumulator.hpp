@@ -91,7 +91,7 @@ struct BlockAssignmentOp<SystemMatrixTag, OpTagT>
     // TODO: We take some shortcuts here that assume the same shape function for every variable. Storage order for the system is i.e. uvp, uvp, ...
     static const Uint mat_size = DataT::EMatrixSizeT::value;
     static const Uint nb_dofs = mat_size / DataT::SupportT::SF::nb_nodes;
-    const Mesh::CTable<Uint>::ConstRow connectivity = data.support().element_connectivity();
+    const typename DataT::SupportT::ConnectivityT& connectivity = data.support().element_connectivity();
     for(Uint row = 0; row != mat_size; ++row)
     {
       const Uint i_gid = connectivity[row % DataT::SupportT::SF::nb_nodes]*nb_dofs + row / DataT::SupportT::SF::nb_nodes;
@@ -112,7 +112,7 @@ struct BlockAssignmentOp<SystemRHSTag, OpTagT>
     // TODO: We take some shortcuts here that assume the same shape function for every variable. Storage order for the system is i.e. uvp, uvp, ...
     static const Uint mat_size = DataT::EMatrixSizeT::value;
     static const Uint nb_dofs = mat_size / DataT::SupportT::SF::nb_nodes;
-    const Mesh::CTable<Uint>::ConstRow connectivity = data.support().element_connectivity();
+    const typename DataT::SupportT::ConnectivityT& connectivity = data.support().element_connectivity();
     for(Uint i = 0; i != mat_size; ++i)
     {
       do_assign_op(OpTagT(), lss.rhs()[connectivity[i % DataT::SupportT::SF::nb_nodes]*nb_dofs + i / DataT::SupportT::SF::nb_nodes], rhs[i]);
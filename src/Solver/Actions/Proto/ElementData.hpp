@@ -7,6 +7,8 @@
 #ifndef CF_Solver_Actions_Proto_ElementData_hpp
 #define CF_Solver_Actions_Proto_ElementData_hpp
 
+#include <boost/array.hpp>
+
 #include <boost/fusion/algorithm/iteration/for_each.hpp>
 #include <boost/fusion/adapted/mpl.hpp>
 #include <boost/fusion/mpl.hpp>
@@ -26,6 +28,7 @@
 #include "Mesh/CField.hpp"
 #include "Mesh/CMesh.hpp"
 #include "Mesh/CRegion.hpp"
+#include "Mesh/CStructuredBlocks.hpp"
 #include "Mesh/CNodes.hpp"
 #include "Mesh/ElementData.hpp"
 
@@ -76,20 +79,34 @@ public:
   /// Return type of the value() method
   typedef const ValueT& ValueResultT;
   
+  /// Node indices of an element
+  typedef boost::array<Uint, SF::nb_nodes> ConnectivityT;
+  
   /// We store nodes as a fixed-size Eigen matrix, so we need to make sure alignment is respected
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
   GeometricSupport(const Mesh::CElements& elements) :
     m_coordinates(elements.nodes().coordinates()),
-    m_connectivity(elements.node_connectivity())
+    m_connectivity(elements.node_connectivity()),
+    m_blocks(Mesh::CStructuredBlocks::of(elements)),
+    m_block(0),
+    m_block_begin(0),
+    m_block_end(0),
+    m_structured_idx(0)
   {
+    m_position[XX] = m_position[YY] = m_position[ZZ] = 0;
   }
 
   /// Update nodes for the current element
   void set_element(const Uint element_idx)
   {
     m_element_idx = element_idx;
-    Mesh::fill(m_nodes, m_coordinates, m_connectivity[element_idx]);
+    if(!m_blocks || !structured_element_nodes(element_idx))
+    {
+      const Mesh::CTable<Uint>::ConstRow row = m_connectivity[element_idx];
+      std::copy(row.begin(), row.end(), m_element_connectivity.begin());
+    }
+    Mesh::fill(m_nodes, m_coordinates, m_element_connectivity);
   }
   
   /// Reference to the current nodes
@@ -99,9 +116,9 @@ public:
   }
   
   /// Connectivity data for the current element
-  Mesh::CTable<Uint>::ConstRow element_connectivity() const
+  const ConnectivityT& element_connectivity() const
   {
-    return m_connectivity[m_element_idx];
+    return m_element_connectivity;
   }
   
   Real volume() const
@@ -189,6 +206,46 @@ public:
   }
   
 private:
+  /// Compute the nodes of an element of block-structured elements, instead of reading the connectivity table
+  bool structured_element_nodes(const Uint element_idx)
+  {
+    const bool next = element_idx == m_structured_idx + 1 && element_idx < m_block_end;
+    m_structured_idx = element_idx;
+    if(element_idx < m_block_begin || element_idx >= m_block_end)
+    {
+      m_block = m_blocks->block_of(element_idx);
+      m_block_begin = m_blocks->block(m_block).first_element;
+      m_block_end = m_block_begin + m_blocks->block(m_block).nb_elements();
+    }
+    const Mesh::CStructuredBlocks::Block& block = m_blocks->block(m_block);
+    
+    // loops visit the elements in order, so the position is mostly advanced instead of divided out
+    if(next)
+    {
+      if(++m_position[XX] == block.size[XX])
+      {
+        m_position[XX] = 0;
+        if(++m_position[YY] == block.size[YY])
+        {
+          m_position[YY] = 0;
+          ++m_position[ZZ];
+        }
+      }
+    }
+    else
+    {
+      const Uint local = element_idx - m_block_begin;
+      m_position[XX] = local % block.size[XX];
+      m_position[YY] = (local / block.stride[YY]) % block.size[YY];
+      m_position[ZZ] = local / block.stride[ZZ];
+    }
+    
+    if(!Mesh::CStructuredBlocks::is_inner(block, m_position[XX], m_position[YY], m_position[ZZ]))
+      return false;
+    Mesh::CStructuredBlocks::inner_element_nodes(block, element_idx, m_element_connectivity);
+    return true;
+  }
+  
   void compute_normal_dispatch(boost::mpl::false_, const typename SF::MappedCoordsT&) const
   {
   }
@@ -219,6 +276,21 @@ private:
   /// Connectivity table
   const Mesh::CTable<Uint>& m_connectivity;
   
+  /// Block structure of the elements, if any
+  Mesh::CStructuredBlocks::ConstPtr m_blocks;
+  
+  /// Block of the current element, and its range of elements
+  Uint m_block;
+  Uint m_block_begin;
+  Uint m_block_end;
+  
+  /// Last element passed to structured_element_nodes(), and its position in its block
+  Uint m_structured_idx;
+  Uint m_position[3];
+  
+  /// Nodes of the current element
+  ConnectivityT m_element_connectivity;
+  
   /// Index for the current element
   Uint m_element_idx;
   
@@ -316,7 +388,7 @@ public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
   template<typename VariableT>
-  SFVariableData(const VariableT& placeholder, const Mesh::CElements& elements, const SupportT& support) : m_data(0), m_connectivity(0), m_support(support)
+  SFVariableData(const VariableT& placeholder, const Mesh::CElements& elements, const SupportT& support) : m_data(0), m_support(support)
   {
     const Mesh::CMesh& mesh = Common::find_parent_component<Mesh::CMesh>(elements);
     Common::Component::ConstPtr field_comp = mesh.get_child_ptr(placeholder.field_name);
@@ -325,8 +397,6 @@ public:
     
     m_data = &field->data();
     
-    m_connectivity = &elements.node_connectivity();    
-    
     var_begin = field->var_index(placeholder.variable_name);
   }
 
@@ -336,12 +406,12 @@ public:
     if(!m_data)
       return;
     m_element_idx = element_idx;
-    Mesh::fill(m_element_values, *m_data, (*m_connectivity)[element_idx], var_begin);
+    Mesh::fill(m_element_values, *m_data, m_support.element_connectivity(), var_begin);
   }
   
-  const Mesh::CTable<Uint>::ConstRow element_connectivity() const
+  const typename SupportT::ConnectivityT& element_connectivity() const
   {
-    return (*m_connectivity)[m_element_idx];
+    return m_support.element_connectivity();
   }
 
   /// Reference to the geometric support
@@ -425,9 +495,6 @@ private:
   /// Coordinates table
   Mesh::CTable<Real> const* m_data;
   
-  /// Connectivity table
-  Mesh::CTable<Uint> const* m_connectivity;
-  
   /// Gemetric support
   const SupportT& m_support;
   
@@ -649,7 +716,19 @@ public:
   {
     return m_element_rhs;
   };
-  
+
+  /// The elements that are looped over
+  const Mesh::CElements& elements() const
+  {
+    return m_elements;
+  }
+
+  /// Index of the current element
+  Uint element_idx() const
+  {
+    return m_element_idx;
+  }
+
 private:
   /// Variables used in the expression
   VariablesT& m_variables;
@@ -14,6 +14,7 @@
 #include "Mesh/Integrators/Gauss.hpp"
 
 #include "ElementMatrix.hpp"
+#include "ElementMatrixCache.hpp"
 #include "ElementTransforms.hpp"
 #include "IndexLooping.hpp"
 
@@ -210,6 +211,74 @@ struct ElementQuadrature :
 /// Use group(expr1, expr2, ..., exprN) to evaluate a group of expressions
 static boost::proto::terminal<ElementQuadratureTag>::type element_quadrature = {};
 
+/// Evaluates cached_element_quadrature(cache) << (expr1, expr2, ..., exprN). The first time an element is visited,
+/// the quadrature is evaluated as with element_quadrature and the resulting element matrices are stored in the cache.
+/// On later visits, the stored matrices are copied into the element matrices, skipping the quadrature.
+template<typename GrammarT>
+struct CachedElementQuadrature :
+  boost::proto::transform< CachedElementQuadrature<GrammarT> >
+{
+  template<typename ExprT, typename StateT, typename DataT>
+  struct impl : boost::proto::transform_impl<ExprT, StateT, DataT>
+  {
+    typedef void result_type;
+
+    typedef typename boost::remove_reference<DataT>::type::ElementMatrixT ElementMatrixT;
+
+    /// Fusion functor to copy the element matrix targeted by each expression to or from the stored values.
+    /// The position in the stored values is kept by the caller, because the functor is copied for each segment of the flattened expression
+    struct copy_matrix
+    {
+      copy_matrix(typename impl::data_param data, Real*& values, const bool store) :
+        m_data(data),
+        m_values(values),
+        m_store(store)
+      {
+      }
+
+      template<typename ChildExprT>
+      void operator()(ChildExprT& expr) const
+      {
+        ElementMatrixT& matrix = m_data.element_matrix(CachedMatrixIndex()(expr));
+        Eigen::Map<ElementMatrixT> stored(m_values);
+        if(m_store)
+          stored = matrix;
+        else
+          matrix = stored;
+        m_values += ElementMatrixT::SizeAtCompileTime;
+      }
+
+    private:
+      typename impl::data_param m_data;
+      Real*& m_values;
+      const bool m_store;
+    };
+
+    void operator ()(
+                typename impl::expr_param expr
+              , typename impl::state_param state
+              , typename impl::data_param data
+    ) const
+    {
+      ElementMatrixCache& cache = boost::proto::value(boost::proto::child_c<1>(boost::proto::left(expr)));
+      ElementMatrixCache::Storage& storage = cache.storage(data.elements());
+      const Uint element_idx = data.element_idx();
+      Real* values = &storage.values[element_idx * storage.nb_values];
+
+      if(storage.stored[element_idx])
+      {
+        boost::fusion::for_each(boost::proto::flatten(boost::proto::right(expr)), copy_matrix(data, values, false));
+        return;
+      }
+
+      // Only the right hand side of the << is used by the quadrature, so it can evaluate our expression directly
+      typename ElementQuadrature<GrammarT>::template impl<ExprT, StateT, DataT>()(expr, state, data);
+      boost::fusion::for_each(boost::proto::flatten(boost::proto::right(expr)), copy_matrix(data, values, true));
+      storage.stored[element_idx] = 1;
+    }
+  };
+};
+
 
 /// Grammar that allows looping over I and J indices
 template<typename I, typename J>
@@ -243,6 +312,11 @@ struct ElementIntegration :
     <
       boost::proto::shift_left< boost::proto::terminal<ElementQuadratureTag>, boost::proto::comma<boost::proto::_, boost::proto::_> >,
       ElementQuadrature< boost::proto::call< IndexLooper<ElementMathImplicitIndexed> > >
+    >,
+    boost::proto::when // cached_element_quadrature(cache) << syntax, to reuse the element matrices of a previous loop
+    <
+      CachedQuadrature,
+      CachedElementQuadrature< boost::proto::call< IndexLooper<ElementMathImplicitIndexed> > >
     >
   >
 {
@@ -18,9 +18,12 @@
 #include "ElementData.hpp"
 #include "ElementExpressionWrapper.hpp"
 #include "ElementGrammar.hpp"
+#include "ThreadedLoop.hpp"
 
 #include "Mesh/CMesh.hpp"
 
+#include "Solver/Actions/EntityColoring.hpp"
+
 namespace CF {
 namespace Solver {
 namespace Actions {
@@ -105,21 +108,100 @@ struct ExpressionRunner
 /// Helper struct to launch execution once all shape functions have been determined
 template<typename DataT>
 struct ElementLooperImpl
-{  
-  template<typename ExprT>
-  void operator()(const ExprT& expr, DataT& data, const Uint nb_elems) const
+{
+  template<typename ExprT, typename VariablesT>
+  void operator()(const ExprT& expr, VariablesT& variables, Mesh::CElements& elements) const
   {
-    const typename DataT::SupportShapeFunction::MappedCoordsT mapped_coords; // needed to deduce proper return type when wrapping
-    run(WrapExpression()(expr, mapped_coords, data), data, nb_elems);
+    const Uint nb_elems = elements.size();
+
+    // The storage of the cached element matrices is allocated here, so the threads can share it
+    const Uint matrix_size = DataT::ElementMatrixT::SizeAtCompileTime;
+    PrepareElementMatrixCaches()(expr, matrix_size, elements);
+
+    const LoopThreading threading = ElementLoopThreading<ExprT>::value;
+    Common::ThreadPool& pool = Common::ThreadPool::instance();
+
+    if(threading == SERIAL_LOOP || pool.nb_threads() == 1 || nb_elems < min_nb_threaded_entities)
+    {
+      DataT data(variables, elements);
+      const typename DataT::SupportShapeFunction::MappedCoordsT mapped_coords; // needed to deduce proper return type when wrapping
+      run(WrapExpression()(expr, mapped_coords, data), data, 0, 0, nb_elems);
+      return;
+    }
+
+    // Each thread uses its own data, created by the calling thread
+    std::vector< boost::shared_ptr<DataT> > thread_data(pool.nb_threads());
+    for(Uint i = 0; i != thread_data.size(); ++i)
+      thread_data[i].reset(new DataT(variables, elements));
+
+    if(threading == INDEPENDENT_LOOP)
+    {
+      run_chunks(ChunkRunner<ExprT>(expr, thread_data, 0), nb_elems);
+      return;
+    }
+
+    // The elements of a color share no node, and the remaining elements are executed by a single chunk
+    const EntityColoring& coloring = EntityColoring::of(elements);
+    for(Uint c = 0; c != coloring.nb_colors(); ++c)
+    {
+      run_chunks(ChunkRunner<ExprT>(expr, thread_data, &coloring.entities()[coloring.color_start(c)]),
+                 coloring.color_start(c+1) - coloring.color_start(c));
+    }
+
+    const std::vector<Uint>& uncolored = coloring.uncolored();
+    if(!uncolored.empty())
+    {
+      LocalCopies copies;
+      CollectPrivateValues()(expr, copies);
+      ChunkRunner<ExprT>(expr, thread_data, &uncolored[0])(copies, 0, uncolored.size(), 0);
+      copies.add_to_targets();
+    }
   }
-  
+
 private:
+  /// Executes a chunk of the elements, for run_chunks
+  template<typename ExprT>
+  struct ChunkRunner
+  {
+    /// @param elements the elements to loop over, or 0 to loop over all of them
+    ChunkRunner(const ExprT& expr, const std::vector< boost::shared_ptr<DataT> >& thread_data, const Uint* elements) :
+      m_expr(expr),
+      m_thread_data(thread_data),
+      m_elements(elements)
+    {
+    }
+
+    const ExprT& expression() const
+    {
+      return m_expr;
+    }
+
+    void operator()(LocalCopies& copies, const Uint begin, const Uint end, const Uint thread) const
+    {
+      run_local(LocalizeTerminals()(m_expr, 0, copies), *m_thread_data[thread], begin, end);
+    }
+
+  private:
+    template<typename LocalExprT>
+    void run_local(const LocalExprT& expr, DataT& data, const Uint begin, const Uint end) const
+    {
+      const typename DataT::SupportShapeFunction::MappedCoordsT mapped_coords;
+      run(WrapExpression()(expr, mapped_coords, data), data, m_elements, begin, end);
+    }
+
+    const ExprT& m_expr;
+    const std::vector< boost::shared_ptr<DataT> >& m_thread_data;
+    const Uint* m_elements;
+  };
+
+  /// Executes the expression on the elements [begin,end[, or on elements[begin] to elements[end-1] if elements is not 0
   template<typename FilteredExprT>
-  void run(const FilteredExprT& expr, DataT& data, const Uint nb_elems) const
+  static void run(const FilteredExprT& expr, DataT& data, const Uint* elements, const Uint begin, const Uint end)
   {
     ElementGrammar grammar;
-    for(Uint elem = 0; elem != nb_elems; ++elem)
+    for(Uint i = begin; i != end; ++i)
     {
+      const Uint elem = elements ? elements[i] : i;
       // Update the data for the element
       data.set_element(elem);
       // Run the expression using a proto transform, passing as arguments in the standard proto sense: the expression, a state and the data
@@ -144,9 +226,7 @@ struct ExpressionRunner<ShapeFunctionsT, ExprT, SupportSF, VariablesT, Variables
       INVALID_ELEMENT_EXPRESSION,
       (ElementGrammar));
     
-    DataT data(variables, elements);
-    
-    ElementLooperImpl<DataT>()(expression, data, elements.size());
+    ElementLooperImpl<DataT>()(expression, variables, elements);
   }
   
 private:
@@ -189,9 +269,7 @@ struct ElementLooper
     
     // TODO: add static assert?
     
-    DataT data(m_variables, m_elements);
-    
-    ElementLooperImpl<DataT>()(m_expr, data, m_elements.size());
+    ElementLooperImpl<DataT>()(m_expr, m_variables, m_elements);
   }
   
   /// Static dispatch in case different SF are possible
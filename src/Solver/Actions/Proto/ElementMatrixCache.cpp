@@ -0,0 +1,46 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+
+#include "Mesh/CElements.hpp"
+
+#include "ElementMatrixCache.hpp"
+
+namespace CF {
+namespace Solver {
+namespace Actions {
+namespace Proto {
+
+void ElementMatrixCache::invalidate()
+{
+  m_storage.clear();
+}
+
+void ElementMatrixCache::prepare(const Mesh::CElements& elements, const Uint nb_values)
+{
+  Storage& storage = m_storage[&elements];
+  const Uint nb_elements = elements.size();
+  if(storage.nb_values == nb_values && storage.stored.size() == nb_elements)
+    return;
+
+  storage.nb_values = nb_values;
+  storage.values.assign(nb_values * nb_elements, 0.);
+  storage.stored.assign(nb_elements, 0);
+}
+
+Uint ElementMatrixCache::nb_stored() const
+{
+  Uint result = 0;
+  for(StorageMapT::const_iterator it = m_storage.begin(); it != m_storage.end(); ++it)
+    result += std::count(it->second.stored.begin(), it->second.stored.end(), 1);
+  return result;
+}
+
+} // namespace Proto
+} // namespace Actions
+} // namespace Solver
+} // namespace CF
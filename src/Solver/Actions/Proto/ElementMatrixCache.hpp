@@ -0,0 +1,191 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Solver_Actions_Proto_ElementMatrixCache_hpp
+#define CF_Solver_Actions_Proto_ElementMatrixCache_hpp
+
+#include <map>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include <boost/fusion/include/size.hpp>
+
+#include <boost/proto/core.hpp>
+#include <boost/proto/fusion.hpp>
+#include <boost/proto/transform/fold.hpp>
+
+#include "Common/Assertions.hpp"
+
+#include "Math/MatrixTypes.hpp"
+
+#include "ElementMatrix.hpp"
+
+/// @file
+/// Storage for element matrices that don't change between loops, such as the mass matrix or the
+/// laplacian of a linear problem. Use cached_element_quadrature(cache) << (_A(u) += ..., _T(u) += ...)
+/// instead of element_quadrature to compute the element matrices only in the first loop over the
+/// elements, and to reuse them in the next loops.
+
+namespace CF {
+
+  namespace Mesh { class CElements; }
+
+namespace Solver {
+namespace Actions {
+namespace Proto {
+
+/// Per-element storage for the element matrices computed by a cached_element_quadrature.
+/// The cache doesn't know what the matrices depend on: call invalidate() when a coefficient
+/// of the cached terms (time step, material property, ...) or the mesh changes.
+class ElementMatrixCache : boost::noncopyable
+{
+public:
+  /// Matrices stored for the elements of one CElements
+  struct Storage
+  {
+    Storage() : nb_values(0) {}
+
+    /// Number of values stored for each element
+    Uint nb_values;
+    /// Values for all elements, element after element
+    std::vector<Real> values;
+    /// Not zero for the elements that have their values stored
+    std::vector<char> stored;
+  };
+
+  /// Drop the stored matrices, so the next loop computes them again
+  void invalidate();
+
+  /// Allocate the storage for the given elements, with nb_values per element.
+  /// Existing values are kept if the sizes didn't change.
+  /// Called before looping over the elements, so the storage can be accessed concurrently in the loop
+  void prepare(const Mesh::CElements& elements, const Uint nb_values);
+
+  /// Storage for the given elements, allocated by prepare()
+  Storage& storage(const Mesh::CElements& elements)
+  {
+    const StorageMapT::iterator it = m_storage.find(&elements);
+    cf_assert(it != m_storage.end());
+    return it->second;
+  }
+
+  /// Number of elements that have their matrices stored
+  Uint nb_stored() const;
+
+private:
+  typedef std::map<const Mesh::CElements*, Storage> StorageMapT;
+  StorageMapT m_storage;
+};
+
+/// Tags a cached element quadrature
+struct CachedElementQuadratureTag
+{
+};
+
+/// Use cached_element_quadrature(cache) << (expr1, expr2, ..., exprN) to evaluate the element matrices
+/// the same way as element_quadrature, storing them in cache. Each of the expressions must add to an
+/// element matrix, and may not depend on values that change between loops.
+inline boost::proto::result_of::make_expr< boost::proto::tag::function, CachedElementQuadratureTag, ElementMatrixCache& >::type const
+cached_element_quadrature(ElementMatrixCache& cache)
+{
+  return boost::proto::make_expr<boost::proto::tag::function>( CachedElementQuadratureTag(), boost::ref(cache) );
+}
+
+/// Matches the element matrices that can be the target of a cached quadrature
+struct CachedMatrixTarget :
+  boost::proto::or_
+  <
+    ElementMatrixTerm,
+    boost::proto::function< ElementMatrixTerm, boost::proto::vararg<boost::proto::_> >
+  >
+{
+};
+
+/// Matches the expressions of a cached quadrature
+struct CachedQuadratureTerms :
+  boost::proto::or_
+  <
+    boost::proto::comma<CachedQuadratureTerms, CachedQuadratureTerms>,
+    boost::proto::plus_assign<CachedMatrixTarget, boost::proto::_>
+  >
+{
+};
+
+/// Matches cached_element_quadrature(cache) << (expr1, expr2, ..., exprN)
+struct CachedQuadrature :
+  boost::proto::shift_left
+  <
+    boost::proto::function< boost::proto::terminal<CachedElementQuadratureTag>, boost::proto::terminal<ElementMatrixCache> >,
+    boost::proto::and_< boost::proto::comma<boost::proto::_, boost::proto::_>, CachedQuadratureTerms >
+  >
+{
+};
+
+/// Returns the element matrix targeted by one of the expressions of a cached quadrature
+struct CachedMatrixIndex :
+  boost::proto::or_
+  <
+    boost::proto::when< boost::proto::plus_assign<boost::proto::_, boost::proto::_>, CachedMatrixIndex(boost::proto::_left) >,
+    boost::proto::when< ElementMatrixTerm, boost::proto::_value >,
+    boost::proto::when< boost::proto::function< ElementMatrixTerm, boost::proto::vararg<boost::proto::_> >, boost::proto::_value(boost::proto::_child0) >
+  >
+{
+};
+
+/// Allocates the storage of a cache for the elements passed as data, with the element matrix size passed as state
+struct PrepareCache :
+  boost::proto::transform< PrepareCache >
+{
+  template<typename ExprT, typename StateT, typename DataT>
+  struct impl : boost::proto::transform_impl<ExprT, StateT, DataT>
+  {
+    typedef Uint result_type;
+
+    /// Number of matrices stored for each element, one for each expression
+    typedef typename boost::fusion::result_of::size
+    <
+      typename boost::proto::result_of::flatten<typename boost::proto::result_of::right<ExprT>::type>::type
+    >::type NbMatricesT;
+
+    result_type operator ()(typename impl::expr_param expr, typename impl::state_param matrix_size, typename impl::data_param elements) const
+    {
+      ElementMatrixCache& cache = boost::proto::value(boost::proto::child_c<1>(boost::proto::left(expr)));
+      cache.prepare(elements, NbMatricesT::value * matrix_size);
+      return matrix_size;
+    }
+  };
+};
+
+/// Prepares the caches used in an element expression, before looping over the elements passed as data parameter.
+/// The state is the number of values in an element matrix.
+struct PrepareElementMatrixCaches :
+  boost::proto::or_
+  <
+    boost::proto::when<CachedQuadrature, PrepareCache>,
+    boost::proto::when
+    <
+      boost::proto::terminal<boost::proto::_>,
+      boost::proto::_state
+    >,
+    boost::proto::when
+    <
+      boost::proto::nary_expr<boost::proto::_, boost::proto::vararg<boost::proto::_> >
+    , boost::proto::fold
+      <
+        boost::proto::_, boost::proto::_state, PrepareElementMatrixCaches
+      >
+    >
+  >
+{
+};
+
+} // namespace Proto
+} // namespace Actions
+} // namespace Solver
+} // namespace CF
+
+#endif // CF_Solver_Actions_Proto_ElementMatrixCache_hpp
@@ -202,7 +202,7 @@ public:
 };
 
 /// Default element types supported by elements expressions
-typedef boost::mpl::vector4<Mesh::SF::Line1DLagrangeP1, Mesh::SF::Triag2DLagrangeP1, Mesh::SF::Quad2DLagrangeP1, Mesh::SF::Hexa3DLagrangeP1> DefaultElementTypes;
+typedef boost::mpl::vector6<Mesh::SF::Line1DLagrangeP1, Mesh::SF::Triag2DLagrangeP1, Mesh::SF::Quad2DLagrangeP1, Mesh::SF::Hexa3DLagrangeP1, Mesh::SF::Prism3DLagrangeP1, Mesh::SF::Pyramid3DLagrangeP1> DefaultElementTypes;
 
 /// Convenience method to construct an Expression to loop over elements
 /// @returns a shared pointer to the constructed expression
@@ -7,6 +7,8 @@
 #ifndef CF_Solver_Actions_Proto_IndexLooping_hpp
 #define CF_Solver_Actions_Proto_IndexLooping_hpp
 
+#include <boost/mpl/for_each.hpp>
+
 #include <boost/proto/core.hpp>
 
 /// @file 
@@ -12,6 +12,7 @@
 
 #include "NodeData.hpp"
 #include "NodeGrammar.hpp"
+#include "ThreadedLoop.hpp"
 
 /// @file
 /// Loop over the nodes for a region
@@ -120,24 +121,64 @@ struct NodeLooperDim
   
   void operator()() const
   {
-    // Create data used for the evaluation
-    DataT node_data(m_variables, m_region, m_region.nodes().coordinates(), m_expr);
+    const Mesh::CTable<Real>& coordinates = m_region.nodes().coordinates();
     
-    // Wrap things up so that we can store the intermediate product results
-    do_run(WrapExpression()(m_expr, 0, node_data), node_data);
+    std::vector<Uint> nodes;
+    make_node_list(m_region, coordinates, nodes);
+    
+    Common::ThreadPool& pool = Common::ThreadPool::instance();
+    if(NodeLoopThreading<ExprT>::value == SERIAL_LOOP || pool.nb_threads() == 1 || nodes.size() < min_nb_threaded_entities)
+    {
+      // Create data used for the evaluation
+      DataT node_data(m_variables, m_region, coordinates, m_expr);
+      
+      // Wrap things up so that we can store the intermediate product results
+      do_run(WrapExpression()(m_expr, 0, node_data), node_data, nodes, 0, nodes.size());
+      return;
+    }
+    
+    // Each thread uses its own data, created by the calling thread
+    std::vector< boost::shared_ptr<DataT> > thread_data(pool.nb_threads());
+    for(Uint i = 0; i != thread_data.size(); ++i)
+      thread_data[i].reset(new DataT(m_variables, m_region, coordinates, m_expr));
+    
+    run_chunks(ChunkRunner(*this, thread_data, nodes), nodes.size());
   }
   
 private:
+  /// Executes a chunk of the nodes, for run_chunks
+  struct ChunkRunner
+  {
+    ChunkRunner(const NodeLooperDim& looper, const std::vector< boost::shared_ptr<DataT> >& thread_data, const std::vector<Uint>& nodes) :
+      m_looper(looper),
+      m_thread_data(thread_data),
+      m_nodes(nodes)
+    {
+    }
+    
+    const ExprT& expression() const
+    {
+      return m_looper.m_expr;
+    }
+    
+    void operator()(LocalCopies& copies, const Uint begin, const Uint end, const Uint thread) const
+    {
+      DataT& data = *m_thread_data[thread];
+      m_looper.do_run(WrapExpression()(LocalizeTerminals()(m_looper.m_expr, 0, copies), 0, data), data, m_nodes, begin, end);
+    }
+    
+  private:
+    const NodeLooperDim& m_looper;
+    const std::vector< boost::shared_ptr<DataT> >& m_thread_data;
+    const std::vector<Uint>& m_nodes;
+  };
+  
   template<typename FilteredExprT>
-  void do_run(const FilteredExprT& expr, DataT& data) const
+  void do_run(const FilteredExprT& expr, DataT& data, const std::vector<Uint>& nodes, const Uint begin, const Uint end) const
   {
     NodeGrammar grammar;
     
-    std::vector<Uint> nodes;
-    make_node_list(m_region, m_region.nodes().coordinates(), nodes);
-    
-    const Uint nb_nodes = nodes.size();
-    for(Uint i = 0; i != nb_nodes; ++i)
+    for(Uint i = begin; i != end; ++i)
     {
       data.set_node(nodes[i]);
       grammar(expr, 0, data); // The "0" is the proto state, which is unused at the top-level expression
@@ -0,0 +1,491 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef CF_Solver_Actions_Proto_ThreadedLoop_hpp
+#define CF_Solver_Actions_Proto_ThreadedLoop_hpp
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/or.hpp>
+#include <boost/type_traits/is_const.hpp>
+#include <boost/type_traits/is_reference.hpp>
+#include <boost/type_traits/remove_reference.hpp>
+
+#include <boost/proto/core.hpp>
+#include <boost/proto/transform/fold.hpp>
+
+#include "Common/ThreadPool.hpp"
+
+#include "ElementOperations.hpp"
+#include "LSSProxy.hpp"
+#include "SolutionVector.hpp"
+#include "Terminals.hpp"
+#include "Transforms.hpp"
+
+/// @file
+/// Execution of the element and node loops by the threads of the Common::ThreadPool.
+///
+/// Each thread uses its own element or node data, and each chunk of the loop evaluates
+/// a copy of the expression in which the writable terminals are replaced:
+///   - The targets of += and -= (reductions) start at zero for every chunk, and the sums
+///     of the chunks are added to the targets in chunk order after the loop. The chunks
+///     only depend on the number of threads, so results are reproducible for a fixed
+///     number of threads.
+///   - Values of a type for which IsThreadPrivate holds are copied for every chunk,
+///     together with the terminals that refer to one of their members.
+/// Element expressions writing to the linear system or to a field are executed one
+/// color of elements at a time (see EntityColoring), so that the elements executed
+/// concurrently share no node. Expressions with other writes to shared values (stream
+/// output, assignments, custom ops taking a shared value) remain serial.
+
+namespace CF {
+namespace Solver {
+namespace Actions {
+namespace Proto {
+
+/// Specialize to inherit from boost::mpl::true_ for the types of the values used as scratch space
+/// for each element, such as the coefficients computed by a custom op. The threaded loops give
+/// every chunk of the loop a copy of them.
+template<typename T>
+struct IsThreadPrivate : boost::mpl::false_
+{
+};
+
+/// True if T refers to a value that is shared among the threads and may be written
+template<typename T>
+struct IsSharedValue :
+  boost::mpl::bool_
+  <
+    boost::is_reference<T>::value
+    && !boost::is_const<typename boost::remove_reference<T>::type>::value
+    && !IsThreadPrivate<typename boost::remove_reference<T>::type>::value
+  >
+{
+};
+
+/// True if T refers to a thread private value
+template<typename T>
+struct IsPrivateValue :
+  boost::mpl::bool_
+  <
+    boost::is_reference<T>::value
+    && !boost::is_const<typename boost::remove_reference<T>::type>::value
+    && IsThreadPrivate<typename boost::remove_reference<T>::type>::value
+  >
+{
+};
+
+/// Matches terminals referring to a shared value
+struct SharedValue :
+  boost::proto::and_
+  <
+    boost::proto::terminal<boost::proto::_>,
+    boost::proto::if_< IsSharedValue<boost::proto::_value>() >
+  >
+{
+};
+
+/// Matches terminals referring to a thread private value
+struct PrivateValue :
+  boost::proto::and_
+  <
+    boost::proto::terminal<boost::proto::_>,
+    boost::proto::if_< IsPrivateValue<boost::proto::_value>() >
+  >
+{
+};
+
+/// Shared values that are summed over the loop
+struct ReductionTarget :
+  boost::proto::and_
+  <
+    SharedValue,
+    boost::proto::or_<Scalar, MatVec>
+  >
+{
+};
+
+/// Sums over the loop
+struct Reduction :
+  boost::proto::or_
+  <
+    boost::proto::plus_assign<ReductionTarget, boost::proto::_>,
+    boost::proto::minus_assign<ReductionTarget, boost::proto::_>
+  >
+{
+};
+
+struct SerialWrites;
+
+/// Argument of a custom op, that may be modified by the op
+struct CustomOpArgument :
+  boost::proto::or_
+  <
+    boost::proto::when<SharedValue, boost::mpl::true_()>,
+    boost::proto::otherwise< boost::proto::call<SerialWrites> >
+  >
+{
+};
+
+/// Evaluates to boost::mpl::true_ if the expression writes to shared values other than reductions,
+/// so that it must be executed serially
+struct SerialWrites :
+  boost::proto::or_
+  <
+    boost::proto::when< boost::proto::terminal<std::ostream>, boost::mpl::true_() >,
+    boost::proto::when< boost::proto::terminal<boost::proto::_>, boost::mpl::false_() >,
+    boost::proto::when< Reduction, SerialWrites(boost::proto::_right) >,
+    boost::proto::when
+    <
+      boost::proto::or_
+      <
+        boost::proto::assign<SharedValue, boost::proto::_>,
+        boost::proto::plus_assign<SharedValue, boost::proto::_>,
+        boost::proto::minus_assign<SharedValue, boost::proto::_>,
+        boost::proto::multiplies_assign<SharedValue, boost::proto::_>,
+        boost::proto::divides_assign<SharedValue, boost::proto::_>
+      >,
+      boost::mpl::true_()
+    >,
+    boost::proto::when
+    <
+      boost::proto::function< boost::proto::terminal< SFOp< CustomSFOp<boost::proto::_> > >, boost::proto::vararg<boost::proto::_> >,
+      boost::proto::fold< boost::proto::_, boost::mpl::false_(), boost::mpl::or_< boost::proto::_state, boost::proto::call<CustomOpArgument> >() >
+    >,
+    boost::proto::otherwise
+    <
+      boost::proto::fold< boost::proto::_, boost::mpl::false_(), boost::mpl::or_< boost::proto::_state, boost::proto::call<SerialWrites> >() >
+    >
+  >
+{
+};
+
+/// Evaluates to boost::mpl::true_ if an element expression writes to the nodes of the element,
+/// so that elements sharing a node may not be executed concurrently
+struct SharedElementWrites :
+  boost::proto::or_
+  <
+    boost::proto::when< boost::proto::terminal< LSSComponent<SolutionVectorTag> >, boost::mpl::false_() >,
+    boost::proto::when< boost::proto::terminal< LSSComponent<boost::proto::_> >, boost::mpl::true_() >,
+    boost::proto::when
+    <
+      boost::proto::or_
+      <
+        boost::proto::assign<FieldTypes, boost::proto::_>,
+        boost::proto::plus_assign<FieldTypes, boost::proto::_>,
+        boost::proto::minus_assign<FieldTypes, boost::proto::_>
+      >,
+      boost::mpl::true_()
+    >,
+    boost::proto::when< boost::proto::terminal<boost::proto::_>, boost::mpl::false_() >,
+    boost::proto::otherwise
+    <
+      boost::proto::fold< boost::proto::_, boost::mpl::false_(), boost::mpl::or_< boost::proto::_state, boost::proto::call<SharedElementWrites> >() >
+    >
+  >
+{
+};
+
+/// Ways to execute a loop
+enum LoopThreading
+{
+  SERIAL_LOOP,       ///< by the calling thread only
+  INDEPENDENT_LOOP,  ///< all entities concurrently
+  COLORED_LOOP       ///< the entities of one color concurrently, one color after the other
+};
+
+/// Threading of an element loop over ExprT
+template<typename ExprT>
+struct ElementLoopThreading
+{
+  static const LoopThreading value =
+    boost::result_of<SerialWrites(ExprT)>::type::value ? SERIAL_LOOP :
+    (boost::result_of<SharedElementWrites(ExprT)>::type::value ? COLORED_LOOP : INDEPENDENT_LOOP);
+};
+
+/// Threading of a node loop over ExprT. Every node is visited once, so writes to the node are independent.
+template<typename ExprT>
+struct NodeLoopThreading
+{
+  static const LoopThreading value = boost::result_of<SerialWrites(ExprT)>::type::value ? SERIAL_LOOP : INDEPENDENT_LOOP;
+};
+
+/// Loops over fewer entities are executed serially
+const Uint min_nb_threaded_entities = 64;
+
+/// Copies of the writable values of an expression, used by one chunk of a loop
+class LocalCopies : boost::noncopyable
+{
+public:
+  ~LocalCopies()
+  {
+    for(Uint i = 0; i != m_entries.size(); ++i)
+      m_entries[i].destroy(m_entries[i].copy);
+  }
+
+  /// @return the sum of a reduction target over the chunk, starting at zero
+  template<typename T>
+  T& reduction(T& target)
+  {
+    for(Uint i = 0; i != m_entries.size(); ++i)
+    {
+      if(m_entries[i].add && m_entries[i].original == &target)
+        return *static_cast<T*>(m_entries[i].copy);
+    }
+
+    T* copy = new T(target);
+    set_zero(*copy);
+    const Entry entry = { &target, copy, sizeof(T), &add_to<T>, &destroy<T> };
+    m_entries.push_back(entry);
+    return *copy;
+  }
+
+  /// Copies a thread private value for the chunk
+  template<typename T>
+  void make_private(T& original)
+  {
+    for(Uint i = 0; i != m_entries.size(); ++i)
+    {
+      if(!m_entries[i].add && m_entries[i].original == &original)
+        return;
+    }
+
+    const Entry entry = { &original, new T(original), sizeof(T), 0, &destroy<T> };
+    m_entries.push_back(entry);
+  }
+
+  /// @return the value itself, or its location in the copy of the thread private value containing it
+  template<typename T>
+  T& local(T& value) const
+  {
+    const char* address = reinterpret_cast<const char*>(&value);
+    for(Uint i = 0; i != m_entries.size(); ++i)
+    {
+      const Entry& entry = m_entries[i];
+      const char* original = static_cast<const char*>(entry.original);
+      if(!entry.add && address >= original && address + sizeof(T) <= original + entry.size)
+        return *reinterpret_cast<T*>(static_cast<char*>(entry.copy) + (address - original));
+    }
+    return value;
+  }
+
+  /// Adds the sums over the chunk to the reduction targets, in the order they were first used
+  void add_to_targets() const
+  {
+    for(Uint i = 0; i != m_entries.size(); ++i)
+    {
+      if(m_entries[i].add)
+        m_entries[i].add(m_entries[i].original, m_entries[i].copy);
+    }
+  }
+
+private:
+  struct Entry
+  {
+    void* original;
+    void* copy;
+    Uint size;
+    void (*add)(void*, const void*);
+    void (*destroy)(void*);
+  };
+
+  template<typename T>
+  static void add_to(void* target, const void* sum)
+  {
+    *static_cast<T*>(target) += *static_cast<const T*>(sum);
+  }
+
+  template<typename T>
+  static void destroy(void* copy)
+  {
+    delete static_cast<T*>(copy);
+  }
+
+  static void set_zero(Real& value) { value = 0.; }
+  static void set_zero(int& value) { value = 0; }
+  static void set_zero(Uint& value) { value = 0; }
+
+  template<typename MatrixT>
+  static void set_zero(Eigen::MatrixBase<MatrixT>& value) { value.setZero(); }
+
+  std::vector<Entry> m_entries;
+};
+
+/// Copies the thread private value of a terminal
+struct MakePrivate :
+  boost::proto::transform< MakePrivate >
+{
+  template<typename ExprT, typename State, typename DataT>
+  struct impl : boost::proto::transform_impl<ExprT, State, DataT>
+  {
+    typedef typename impl::state& result_type;
+
+    result_type operator ()(
+                typename impl::expr_param expr
+              , typename impl::state_param state // the LocalCopies of the chunk
+              , typename impl::data_param
+    ) const
+    {
+      state.make_private(boost::proto::value(expr));
+      return state;
+    }
+  };
+};
+
+/// Copies the thread private values appearing in the expression into the LocalCopies passed as state parameter
+struct CollectPrivateValues :
+  boost::proto::or_
+  <
+    boost::proto::when<PrivateValue, MakePrivate>,
+    boost::proto::when
+    <
+      boost::proto::terminal<boost::proto::_>,
+      boost::proto::_state
+    >,
+    boost::proto::when
+    <
+      boost::proto::nary_expr<boost::proto::_, boost::proto::vararg<boost::proto::_> >
+    , boost::proto::fold
+      <
+        boost::proto::_, boost::proto::_state, CollectPrivateValues
+      >
+    >
+  >
+{
+};
+
+/// Base for the transforms replacing a terminal with a terminal referring to a local copy
+template<typename Derived>
+struct LocalTerminal :
+  boost::proto::transform< Derived >
+{
+  template<typename ExprT, typename State, typename DataT>
+  struct impl : boost::proto::transform_impl<ExprT, State, DataT>
+  {
+    typedef typename boost::remove_reference
+    <
+      typename boost::result_of<boost::proto::_value(typename impl::expr_param)>::type
+    >::type ValueT;
+
+    typedef typename boost::proto::terminal<ValueT&>::type result_type;
+
+    result_type operator ()(
+                typename impl::expr_param expr
+              , typename impl::state_param
+              , typename impl::data_param copies // the LocalCopies of the chunk
+    ) const
+    {
+      result_type result = { Derived::apply(boost::proto::value(expr), copies) };
+      return result;
+    }
+  };
+};
+
+/// Refers to the sum over the chunk
+struct LocalReduction : LocalTerminal<LocalReduction>
+{
+  template<typename T>
+  static T& apply(T& target, LocalCopies& copies)
+  {
+    return copies.reduction(target);
+  }
+};
+
+/// Refers to the copy of a thread private value, or to the value itself
+struct LocalValue : LocalTerminal<LocalValue>
+{
+  template<typename T>
+  static T& apply(T& value, const LocalCopies& copies)
+  {
+    return copies.local(value);
+  }
+};
+
+/// Replaces the writable terminals of an expression with their copies in the LocalCopies passed as data parameter
+struct LocalizeTerminals :
+  boost::proto::or_
+  <
+    boost::proto::when
+    <
+      boost::proto::plus_assign<ReductionTarget, boost::proto::_>,
+      boost::proto::functional::make_expr<boost::proto::tag::plus_assign>
+      (
+        LocalReduction(boost::proto::_left), LocalizeTerminals(boost::proto::_right)
+      )
+    >,
+    boost::proto::when
+    <
+      boost::proto::minus_assign<ReductionTarget, boost::proto::_>,
+      boost::proto::functional::make_expr<boost::proto::tag::minus_assign>
+      (
+        LocalReduction(boost::proto::_left), LocalizeTerminals(boost::proto::_right)
+      )
+    >,
+    boost::proto::when< boost::proto::or_<SharedValue, PrivateValue>, LocalValue >,
+    boost::proto::when< boost::proto::terminal<boost::proto::_>, boost::proto::_expr >,
+    boost::proto::nary_expr< boost::proto::_, boost::proto::vararg<LocalizeTerminals> >
+  >
+{
+};
+
+/// Adapts a chunk runner to a task of the ThreadPool
+template<typename RunnerT>
+struct ChunkTask
+{
+  ChunkTask(const RunnerT& runner, const std::vector< boost::shared_ptr<LocalCopies> >& copies, const Uint chunk_size) :
+    m_runner(runner),
+    m_copies(copies),
+    m_chunk_size(chunk_size)
+  {
+  }
+
+  void operator()(const Uint begin, const Uint end, const Uint thread) const
+  {
+    LocalCopies& copies = *m_copies[begin / m_chunk_size];
+    CollectPrivateValues()(m_runner.expression(), copies);
+    m_runner(copies, begin, end, thread);
+  }
+
+private:
+  const RunnerT& m_runner;
+  const std::vector< boost::shared_ptr<LocalCopies> >& m_copies;
+  const Uint m_chunk_size;
+};
+
+/// Executes the loop [0,nb_entities[ in chunks shared among the threads of the pool.
+/// The chunks only depend on the number of entities and threads, and their reductions are added to the
+/// targets in chunk order.
+/// @param runner Executes a chunk as runner(copies, begin, end, thread), and returns the expression with runner.expression()
+template<typename RunnerT>
+void run_chunks(const RunnerT& runner, const Uint nb_entities)
+{
+  if(nb_entities == 0)
+    return;
+
+  Common::ThreadPool& pool = Common::ThreadPool::instance();
+  const Uint chunk_size = std::max(1u, nb_entities / (4*pool.nb_threads()));
+  const Uint nb_chunks = (nb_entities + chunk_size - 1) / chunk_size;
+
+  std::vector< boost::shared_ptr<LocalCopies> > copies(nb_chunks);
+  for(Uint i = 0; i != nb_chunks; ++i)
+    copies[i].reset(new LocalCopies());
+
+  pool.parallel_for(0, nb_entities, ChunkTask<RunnerT>(runner, copies, chunk_size), chunk_size);
+
+  for(Uint i = 0; i != nb_chunks; ++i)
+    copies[i]->add_to_targets();
+}
+
+} // namespace Proto
+} // namespace Actions
+} // namespace Solver
+} // namespace CF
+
+#endif // CF_Solver_Actions_Proto_ThreadedLoop_hpp
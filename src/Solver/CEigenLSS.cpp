@@ -306,6 +306,38 @@ void CEigenLSS::print_matrix()
 }
 
 
+namespace {
+
+/// increments the values of the variables of one field, stored in a table of Real or of float
+template <typename T>
+void increment_field(const RealVector& solution, const std::string& field_name, const std::vector<std::string>& field_names, const std::vector<std::string>& var_names, const std::vector<Uint>& var_sizes, const std::vector<Uint>& var_offsets, const CField& field, CTable<T>& field_table)
+{
+  const Uint nb_vars = var_names.size();
+  const Uint field_size = field_table.size();
+  for(Uint row_idx = 0; row_idx != field_size; ++row_idx)
+  {
+    typename CTable<T>::Row row = field_table[row_idx];
+    for(Uint i = 0; i != nb_vars; ++i)
+    {
+      if(field_names[i] != field_name)
+        continue;
+
+      const Uint solution_begin = var_offsets.back() * row_idx + var_offsets[i];
+      const Uint solution_end = solution_begin + var_sizes[i];
+      Uint field_idx = field.var_index(var_names[i]);
+
+      cf_assert( (Uint) field.var_type(var_names[i]) == (Uint) var_sizes[i]);
+
+      for(Uint sol_idx = solution_begin; sol_idx != solution_end; ++sol_idx)
+      {
+        row[field_idx++] += solution[sol_idx];
+      }
+    }
+  }
+}
+
+} // namespace
+
 void increment_solution(const RealVector& solution, const std::vector<std::string>& field_names, const std::vector<std::string>& var_names, const std::vector<Uint>& var_sizes, CMesh& solution_mesh)
 {
   const Uint nb_vars = var_names.size();
@@ -324,28 +356,10 @@ void increment_solution(const RealVector& solution, const std::vector<std::strin
     if(unique_field_names.insert(field_name).second)
     {
       CField& field = *solution_mesh.get_child_ptr(field_name)->as_ptr<CField>();
-      CTable<Real>& field_table = field.data();
-      const Uint field_size = field_table.size();
-      for(Uint row_idx = 0; row_idx != field_size; ++row_idx)
-      {
-        CTable<Real>::Row row = field_table[row_idx];
-        for(Uint i = 0; i != nb_vars; ++i)
-        {
-          if(field_names[i] != field_name)
-            continue;
-
-          const Uint solution_begin = var_offsets.back() * row_idx + var_offsets[i];
-          const Uint solution_end = solution_begin + var_sizes[i];
-          Uint field_idx = field.var_index(var_names[i]);
-
-          cf_assert( (Uint) field.var_type(var_names[i]) == (Uint) var_sizes[i]);
-
-          for(Uint sol_idx = solution_begin; sol_idx != solution_end; ++sol_idx)
-          {
-            row[field_idx++] += solution[sol_idx];
-          }
-        }
-      }
+      if(field.precision() == CField::SINGLE)
+        increment_field(solution, field_name, field_names, var_names, var_sizes, var_offsets, field, field.data_single());
+      else
+        increment_field(solution, field_name, field_names, var_names, var_sizes, var_offsets, field, field.data());
     }
   }
 }
@@ -24,7 +24,8 @@ CTime::CTime ( const std::string& name  ) :
   m_current_time(0.),
   m_dt(0.),
   m_invdt(0.),
-  m_iter(0)
+  m_iter(0),
+  m_inner_iter(0)
 {
   mark_basic();
 
@@ -66,6 +66,13 @@ public: // functions
   /// @return iteration
   const Uint& iter() const { return m_iter; }
 
+  /// @return modifiable pseudo-time iteration inside the current time step,
+  ///         used by dual time stepping
+  Uint& inner_iter() { return m_inner_iter; }
+
+  /// @return pseudo-time iteration inside the current time step
+  const Uint& inner_iter() const { return m_inner_iter; }
+
   /// @return end_time
   Real end_time() const { return m_end_time; }
 
@@ -75,6 +82,7 @@ private: // data
   Real m_dt;
   Real m_invdt;
   Uint m_iter;
+  Uint m_inner_iter;
   Real m_end_time;
 
   void trigger_timestep();
@@ -63,6 +63,7 @@ public: // functions
     static const char * update_coeff()   { return "update_coeff"; }
     static const char * cfl()            { return "cfl"; }
     static const char * time_accurate()  { return "time_accurate"; }
+    static const char * dual_time_stepping() { return "dual_time_stepping"; }
   }; // Tags
 
   /// Contructor
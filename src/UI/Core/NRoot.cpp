@@ -119,6 +119,13 @@ void NRoot::connectedToServer()
 
   // build and send signal
   SignalFrame frame("client_registration", CLIENT_ROOT_PATH, SERVER_CORE_PATH);
+  SignalOptions options( frame );
+
+  // binary frames are smaller and faster to parse, but cannot be
+  // printed in debug mode
+  options.add_option< OptionT<bool> >("binary_frames", !NTree::globalTree()->isDebugModeEnabled());
+
+  options.flush();
 
   ThreadManager::instance().network().send(frame);
 }
@@ -8,8 +8,12 @@
 
 #include "rapidxml/rapidxml.hpp"
 
+#include "Common/Foreach.hpp"
+#include "Common/OptionT.hpp"
 #include "Common/Signal.hpp"
 
+#include "Common/XML/SignalOptions.hpp"
+
 #include "UI/Core/TreeThread.hpp"
 #include "UI/Core/NetworkThread.hpp"
 #include "UI/Core/NLog.hpp"
@@ -35,7 +39,8 @@ namespace Core {
 NTree::NTree(NRoot::Ptr rootNode)
   : CNode(CLIENT_TREE, "NTree", CNode::DEBUG_NODE),
     m_advancedMode(false),
-    m_debugModeEnabled(false)
+    m_debugModeEnabled(false),
+    m_treeVersion(0)
 {
 
 
@@ -53,6 +58,12 @@ NTree::NTree(NRoot::Ptr rootNode)
   regist_signal( "list_tree" )
     ->description("New tree")
     ->pretty_name("")->connect(boost::bind(&NTree::list_tree_reply, this, _1));
+
+  unregist_signal("list_tree_delta"); // unregister base class signal
+
+  regist_signal( "list_tree_delta" )
+    ->description("Tree changes")
+    ->pretty_name("")->connect(boost::bind(&NTree::list_tree_delta_reply, this, _1));
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -647,6 +658,8 @@ void NTree::list_tree_reply(SignalArgs & args)
     if(!currentIndexPath.path().empty())
       m_currentIndex = this->indexFromPath(currentIndexPath);
 
+    if(args.main_map.check_entry("version"))
+      m_treeVersion = args.main_map.get_value<Uint>("version");
 
     NLog::globalLog()->addMessage("Tree updated.");
   }
@@ -665,12 +678,89 @@ void NTree::list_tree_reply(SignalArgs & args)
 
 ////////////////////////////////////////////////////////////////////////////
 
+void NTree::list_tree_delta_reply(SignalArgs & args)
+{
+  if( args.main_map.get_value<bool>("full") )
+  {
+    list_tree_reply(args);
+    return;
+  }
+
+  emit beginResetModel();
+
+  try
+  {
+    URI currentIndexPath;
+
+    if(m_currentIndex.isValid())
+      currentIndexPath = indexToTreeNode(m_currentIndex)->node()->uri();
+
+    //
+    // remove old nodes
+    //
+    std::vector<std::string> removed = args.main_map.get_array<std::string>("removed");
+
+    boost_foreach( const std::string & path, removed )
+    {
+      URI uri(path, URI::Scheme::CPATH);
+      QModelIndex parentIndex = indexFromPath(uri.base_path());
+
+      if( !parentIndex.isValid() )
+        continue;
+
+      CNode::Ptr parent = indexToNode( parentIndex );
+
+      // the node may already be gone if the client tree was modified locally
+      if( parent->realComponent()->get_child_ptr(uri.name()).get() != nullptr )
+        parent->removeNode( uri.name().c_str() );
+    }
+
+    //
+    // add the new nodes, each one is placed under its parent
+    //
+    XmlNode added = args.map("added").main_map.content;
+
+    for( rapidxml::xml_node<>* node = added.content->first_node("node") ;
+         node != nullptr ; node = node->next_sibling("node") )
+    {
+      rapidxml::xml_attribute<>* parentAttr = node->first_attribute("parent");
+
+      cf_assert( parentAttr != nullptr );
+
+      QModelIndex parentIndex = indexFromPath( URI(parentAttr->value(), URI::Scheme::CPATH) );
+      CNode::Ptr newNode = CNode::createFromXml( XmlNode(node) );
+
+      if( parentIndex.isValid() && newNode.get() != nullptr )
+        indexToNode( parentIndex )->addNode( newNode );
+    }
+
+    // retrieve the previous index, if it still exists
+    if(!currentIndexPath.path().empty())
+      m_currentIndex = this->indexFromPath(currentIndexPath);
+
+    m_treeVersion = args.main_map.get_value<Uint>("version");
+  }
+  catch(XmlError & xe)
+  {
+    NLog::globalLog()->addException(xe.what());
+    m_treeVersion = 0; // get the whole tree next time
+  }
+
+  emit endResetModel();
+
+  emit currentIndexChanged(m_currentIndex, QModelIndex());
+}
+
+////////////////////////////////////////////////////////////////////////////
+
 void NTree::clearTree()
 {
 
 
   //QMutexLocker locker(m_mutex);
 
+  m_treeVersion = 0;
+
   NRoot::Ptr treeRoot = m_rootNode->node()->castTo<NRoot>();
   ComponentIterator<CNode> itRem = treeRoot->root()->begin<CNode>();
   QMap<int, std::string> listToRemove;
@@ -732,7 +822,14 @@ void NTree::updateTree()
 {
 
 
-  SignalFrame frame("list_tree", CLIENT_TREE_PATH, SERVER_ROOT_PATH);
+  SignalFrame frame("list_tree_delta", CLIENT_TREE_PATH, SERVER_ROOT_PATH);
+  SignalOptions options( frame );
+
+  // the server only sends what changed since our version
+  options.add_option< OptionT<Uint> >("version", m_treeVersion);
+
+  options.flush();
+
   ThreadManager::instance().network().send(frame);
 }
 
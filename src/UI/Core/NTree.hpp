@@ -300,6 +300,15 @@ namespace Core {
     /// @param node New tree
     void list_tree_reply(CF::Common::SignalArgs & node);
 
+    /// @brief Signal called when the server sends the changes since the
+    /// last known tree version
+
+    /// The removed nodes are deleted and the added ones are built in place.
+    /// If the server could not compute the changes, the reply contains the
+    /// whole tree and is processed by @c #list_tree_reply().
+    /// @param node Tree changes
+    void list_tree_delta_reply(CF::Common::SignalArgs & node);
+
     /// @} END Signals
 
     void contentListed(Component::Ptr node);
@@ -357,6 +366,12 @@ namespace Core {
     /// @brief Mutex to control concurrent access.
     QMutex * m_mutex;
 
+    /// @brief Version of the server tree the client tree is synchronized with.
+
+    /// If 0, the client tree is not synchronized and the next update
+    /// retrieves the whole tree.
+    Uint m_treeVersion;
+
     /// @brief Converts an index to a tree node
 
     /// @param index Node index to convert
@@ -8,6 +8,7 @@
 #include <QTcpSocket>
 
 #include "Common/Log.hpp"
+#include "Common/XML/BinaryFormat.hpp"
 #include "Common/XML/FileOperations.hpp"
 
 #include "UI/UICommon/ComponentNames.hpp"
@@ -151,7 +152,9 @@ void NetworkThread::newData()
   {
     in.readBytes(frame, m_blockSize);
 
-    if(NTree::globalTree()->isDebugModeEnabled())
+    bool binary = m_blockSize > 0 && XML::is_binary_frame(frame, m_blockSize);
+
+    if(NTree::globalTree()->isDebugModeEnabled() && !binary)
       CFinfo << frame << CFendl;
 
     // parse the frame and call the boost signal
@@ -159,7 +162,13 @@ void NetworkThread::newData()
     {
       if( m_blockSize > 0 )
       {
-        XmlDoc::Ptr doc = XML::parse_cstring(frame, m_blockSize - 1);
+        XmlDoc::Ptr doc;
+
+        if( binary )
+          doc = XML::parse_binary(frame, m_blockSize);
+        else
+          doc = XML::parse_cstring(frame, m_blockSize - 1);
+
         newSignal(doc);
       }
     }
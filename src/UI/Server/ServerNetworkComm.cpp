@@ -15,6 +15,7 @@
 #include "Common/OptionT.hpp"
 #include "Common/Log.hpp"
 
+#include "Common/XML/BinaryFormat.hpp"
 #include "Common/XML/FileOperations.hpp"
 #include "Common/XML/Protocol.hpp"
 #include "Common/XML/SignalOptions.hpp"
@@ -96,25 +97,24 @@ bool ServerNetworkComm::openPort(quint16 port)
 
 int ServerNetworkComm::send(QTcpSocket * client, const XmlDoc & signal)
 {
-  QByteArray block;
-  QDataStream out(&block, QIODevice::WriteOnly);
   int count = 0; // total bytes sent
 
-  std::string signal_str;
-
-  XML::to_string(signal, signal_str);
-
-  out.setVersion(QDataStream::Qt_4_6);
-
-  out.writeBytes(signal_str.c_str(), signal_str.length() + 1);
-
   if(client == nullptr)
   {
+    // each format is built at most once, whatever the number of clients
+    QByteArray textBlock;
+    QByteArray binaryBlock;
     QHash<QTcpSocket *, std::string>::iterator it = m_clients.begin();
 
     while(it != m_clients.end())
     {
       client = it.key();
+
+      QByteArray & block = m_binaryClients.contains(client) ? binaryBlock : textBlock;
+
+      if(block.isEmpty())
+        block = this->buildBlock(signal, m_binaryClients.contains(client));
+
       count += client->write(block);
       m_bytesSent += count;
       client->flush();
@@ -123,7 +123,7 @@ int ServerNetworkComm::send(QTcpSocket * client, const XmlDoc & signal)
   }
   else
   {
-    count = client->write(block);
+    count = client->write( this->buildBlock(signal, m_binaryClients.contains(client)) );
     m_bytesSent += count;
 
     client->flush();
@@ -135,6 +135,31 @@ int ServerNetworkComm::send(QTcpSocket * client, const XmlDoc & signal)
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
+QByteArray ServerNetworkComm::buildBlock(const XmlDoc & signal, bool binary) const
+{
+  QByteArray block;
+  QDataStream out(&block, QIODevice::WriteOnly);
+  std::string signal_str;
+
+  out.setVersion(QDataStream::Qt_4_6);
+
+  if(binary)
+  {
+    XML::to_binary(signal, signal_str);
+    out.writeBytes(signal_str.c_str(), signal_str.length());
+  }
+  else
+  {
+    XML::to_string(signal, signal_str);
+    out.writeBytes(signal_str.c_str(), signal_str.length() + 1);
+  }
+
+  return block;
+}
+
+//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
 void ServerNetworkComm::sendSignalToClient(const XmlDoc & signal, const string & uuid)
 {
   QTcpSocket * socket = this->getSocket(uuid);
@@ -345,6 +370,12 @@ void ServerNetworkComm::newData()
           {
             m_clients[socket] = clientId;
 
+            // the client may ask for binary frames
+            SignalOptions options( *sig_frame );
+
+            if( options.check("binary_frames") && options.value<bool>("binary_frames") )
+              m_binaryClients.insert(socket);
+
             // Build the reply
             SignalFrame reply = sig_frame->create_reply();
             SignalOptions roptions( reply );
@@ -403,6 +434,7 @@ void ServerNetworkComm::clientDisconnected()
   if(socket != nullptr)
   {
     m_clients.remove(socket);
+    m_binaryClients.remove(socket);
 
     std::cout << "A client has gone (" << m_clients.size() << " left)\n";
   }
@@ -13,6 +13,7 @@
 #include <QAbstractSocket>
 #include <QList>
 #include <QMutex>
+#include <QSet>
 
 #include "UI/UICommon/LogMessage.hpp"
 
@@ -137,6 +138,12 @@ namespace Server {
     /// The key is pointer to the m_socket. The value is the client UUID.
     QHash<QTcpSocket *, std::string> m_clients;
 
+    /// @brief Clients that asked for binary frames.
+
+    /// The key is pointer to the m_socket. Clients that are not in the
+    /// set receive XML frames.
+    QSet<QTcpSocket *> m_binaryClients;
+
     /// @brief Number of bytes recieved.
     int m_bytesRecieved;
 
@@ -164,6 +171,14 @@ namespace Server {
     /// @return Returns the number of bytes sent.
     int send(QTcpSocket * client, const Common::XML::XmlDoc & signal);
 
+    /// @brief Builds the block to write on a socket.
+
+    /// @param signal Signal frame to convert.
+    /// @param binary If @c true, the frame is converted to the binary format,
+    /// otherwise it is converted to XML text.
+    /// @return Returns the block.
+    QByteArray buildBlock(const Common::XML::XmlDoc & signal, bool binary) const;
+
 		bool sendFrameRejected(QTcpSocket * client,
 													 const std::string & frameid,
 													 const CF::Common::URI & sender,
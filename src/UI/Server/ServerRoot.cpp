@@ -20,6 +20,8 @@
 
 #include "Solver/CPlotter.hpp"
 
+#include "Solver/Actions/CFieldSnapshots.hpp"
+
 #include "UI/UICommon/ComponentNames.hpp"
 
 #include "UI/Server/Notifier.hpp"
@@ -92,6 +94,9 @@ CRoot::Ptr ServerRoot::root()
     tools->create_component_ptr<CJournal>("Journal")->mark_basic();
     tools->create_component_ptr<mpi::CPEManager>("PEManager")->mark_basic();
 
+    // receives the fields streamed by the workers
+    tools->create_component_ptr<Actions::CFieldSnapshots>("FieldSnapshots");
+
     CPlotter::Ptr plotter = tools->create_component_ptr<CPlotter>("Plotter");
 
     plotter->mark_basic();
@@ -0,0 +1,131 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for CF::Common::Allocator"
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+
+#include "Common/Allocator.hpp"
+#include "Common/BoostArray.hpp"
+#include "Common/ThreadPool.hpp"
+
+using namespace CF;
+using namespace CF::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+bool is_aligned(const void* block, const std::size_t alignment)
+{
+  return reinterpret_cast<boost::uintptr_t>(block) % alignment == 0;
+}
+
+/// Fills an array allocated with the current settings, and checks its values
+void check_table(const Uint nb_rows, const Uint nb_cols)
+{
+  typedef boost::multi_array<Real,2,Allocator<Real> > TableT;
+  TableT table(boost::extents[nb_rows][nb_cols]);
+  BOOST_CHECK(is_aligned(table.data(), MemoryManager::alignment));
+
+  for (Uint i=0; i<nb_rows; ++i)
+    for (Uint j=0; j<nb_cols; ++j)
+      table[i][j] = i*nb_cols+j;
+
+  table.resize(boost::extents[2*nb_rows][nb_cols]);
+  BOOST_CHECK(is_aligned(table.data(), MemoryManager::alignment));
+  for (Uint i=0; i<nb_rows; ++i)
+    for (Uint j=0; j<nb_cols; ++j)
+      BOOST_CHECK_EQUAL(table[i][j], Real(i*nb_cols+j));
+}
+
+/// Allocates a large block for every index of a range, counting the misaligned blocks per thread
+void allocate_in_task(std::vector<Uint>& nb_misaligned, const Uint begin, const Uint end, const Uint thread)
+{
+  MemoryManager& memory = MemoryManager::instance();
+  for (Uint i=begin; i<end; ++i)
+  {
+    void* block = memory.allocate(1000000);
+    if (!is_aligned(block, MemoryManager::alignment))
+      ++nb_misaligned[thread];
+    memory.deallocate(block);
+  }
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( AllocatorSuite )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( alignment )
+{
+  MemoryManager& memory = MemoryManager::instance();
+  BOOST_CHECK(!memory.HugePages);
+  BOOST_CHECK(!memory.ParallelFirstTouch);
+
+  for (std::size_t bytes=0; bytes<1000; bytes+=7)
+  {
+    void* block = memory.allocate(bytes);
+    BOOST_CHECK(is_aligned(block, MemoryManager::alignment));
+    memory.deallocate(block);
+  }
+
+  std::vector< Uint, Allocator<Uint> > values(1000,3);
+  BOOST_CHECK(is_aligned(&values[0], MemoryManager::alignment));
+  values.resize(100000,3);
+  BOOST_CHECK_EQUAL(values.back(), 3u);
+
+  check_table(1000,3);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( first_touch )
+{
+  MemoryManager& memory = MemoryManager::instance();
+  ThreadPool::instance().set_nb_threads(4);
+  memory.ParallelFirstTouch = true;
+  memory.HugePages = true;
+
+  // small tables are left to the calling thread, large ones touched by the pool
+  check_table(10,3);
+  check_table(300000,4);
+
+  memory.ParallelFirstTouch = false;
+  memory.HugePages = false;
+  ThreadPool::instance().set_nb_threads(1);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( first_touch_within_task )
+{
+  MemoryManager& memory = MemoryManager::instance();
+  ThreadPool& pool = ThreadPool::instance();
+  pool.set_nb_threads(4);
+  memory.ParallelFirstTouch = true;
+
+  // large blocks allocated by the threads of the pool are not shared among them again
+  std::vector<Uint> nb_misaligned(4,0);
+  pool.parallel_for(0, 32, boost::bind(&allocate_in_task, boost::ref(nb_misaligned), _1, _2, _3), 1);
+  BOOST_CHECK_EQUAL(nb_misaligned[0]+nb_misaligned[1]+nb_misaligned[2]+nb_misaligned[3], 0u);
+
+  memory.ParallelFirstTouch = false;
+  pool.set_nb_threads(1);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
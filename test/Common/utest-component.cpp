@@ -18,9 +18,13 @@
 #include "Common/CRoot.hpp"
 #include "Common/CGroup.hpp"
 #include "Common/CLink.hpp"
+#include "Common/OptionT.hpp"
+
+#include "rapidxml/rapidxml.hpp"
 
 #include "Common/XML/Protocol.hpp"
 #include "Common/XML/SignalFrame.hpp"
+#include "Common/XML/SignalOptions.hpp"
 
 using namespace std;
 using namespace boost;
@@ -300,6 +304,110 @@ BOOST_AUTO_TEST_CASE( rename )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_CASE( tree_changes_since )
+{
+  CRoot::Ptr root = CRoot::create ( "root" );
+
+  Component::Ptr dir1 = root->create_component_ptr<CGroup>("dir1");
+  Component::Ptr dir2 = dir1->create_component_ptr<CGroup>("dir2");
+  root->create_component_ptr<CGroup>("old");
+
+  const Uint version = root->tree_version();
+
+  std::vector<std::string> removed;
+  std::vector<std::string> added;
+
+  BOOST_CHECK( root->tree_changes_since(version, removed, added) );
+  BOOST_CHECK( removed.empty() );
+  BOOST_CHECK( added.empty() );
+
+  // a client from the future must reload the whole tree
+  BOOST_CHECK( !root->tree_changes_since(version + 1, removed, added) );
+
+  // created then deleted: nothing to send
+  root->create_component_ptr<CGroup>("tmp");
+  root->remove_component("tmp");
+
+  // created under a new node: only the new node is sent
+  Component::Ptr dir3 = dir2->create_component_ptr<CGroup>("dir3");
+  dir3->create_component_ptr<CGroup>("dir4");
+
+  // renamed: old path removed, new path added
+  dir1->rename("dir1_renamed");
+
+  // deleted
+  root->remove_component("old");
+
+  BOOST_CHECK( root->tree_changes_since(version, removed, added) );
+
+  BOOST_CHECK_EQUAL( removed.size(), 2u );
+  BOOST_CHECK_EQUAL( removed[0], "//root/dir1" );
+  BOOST_CHECK_EQUAL( removed[1], "//root/old" );
+
+  BOOST_CHECK_EQUAL( added.size(), 1u );
+  BOOST_CHECK_EQUAL( added[0], "//root/dir1_renamed" );
+
+  // when the log is too short, the whole tree is needed
+  root->set_tree_log_size(2);
+  BOOST_CHECK( !root->tree_changes_since(version, removed, added) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( list_tree_delta_signal )
+{
+  CRoot::Ptr root = CRoot::create ( "root" );
+
+  root->create_component_ptr<CGroup>("dir1");
+  CLink::Ptr lnk = root->create_component_ptr<CLink>("lnk");
+
+  // first call, with no version: the whole tree is sent
+  SignalFrame frame_full("list_tree_delta", root->uri(), root->uri());
+  root->call_signal( "list_tree_delta", frame_full );
+
+  SignalFrame reply_full = frame_full.get_reply();
+  BOOST_CHECK( reply_full.main_map.get_value<bool>("full") );
+
+  const Uint version = reply_full.main_map.get_value<Uint>("version");
+  BOOST_CHECK_EQUAL( version, root->tree_version() );
+
+  // modify the tree
+  Component::Ptr dir2 = root->create_component_ptr<CGroup>("dir2");
+  lnk->link_to(dir2);
+  root->remove_component("dir1");
+
+  SignalFrame frame("list_tree_delta", root->uri(), root->uri());
+  SignalOptions options( frame );
+
+  options.add_option< OptionT<Uint> >("version", version);
+  options.flush();
+
+  root->call_signal( "list_tree_delta", frame );
+
+  SignalFrame reply = frame.get_reply();
+  BOOST_CHECK( !reply.main_map.get_value<bool>("full") );
+  BOOST_CHECK_EQUAL( reply.main_map.get_value<Uint>("version"), root->tree_version() );
+
+  std::vector<std::string> removed = reply.main_map.get_array<std::string>("removed");
+  BOOST_CHECK_EQUAL( removed.size(), 2u );
+  BOOST_CHECK_EQUAL( removed[0], "//root/lnk" );
+  BOOST_CHECK_EQUAL( removed[1], "//root/dir1" );
+
+  // dir2 and the retargeted link are sent with their parent path
+  XmlNode added = reply.map("added").main_map.content;
+  Uint nb_added = 0;
+
+  for( rapidxml::xml_node<>* node = added.content->first_node("node") ;
+       node != nullptr ; node = node->next_sibling("node"), ++nb_added )
+  {
+    BOOST_CHECK_EQUAL( std::string(node->first_attribute("parent")->value()), "//root" );
+  }
+
+  BOOST_CHECK_EQUAL( nb_added, 2u );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_SUITE_END()
 
 ////////////////////////////////////////////////////////////////////////////////
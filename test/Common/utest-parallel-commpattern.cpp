@@ -50,7 +50,7 @@ struct PECommPatternFixture
   }
 
   /// function for setting up a gid & rank combo (with size of 6*nproc on each process)
-  void setupGidAndRank(std::vector<Uint>& gid, std::vector<Uint>& rank)
+  void setupGidAndRank(std::vector<Gid>& gid, std::vector<Uint>& rank)
   {
     // global indices and ranks, ordering: 0 1 2 ... 0 0 1 1 2 2 ... 0 0 0 1 1 1 2 2 2 ...
     int nproc=mpi::PE::instance().size();
@@ -477,12 +477,13 @@ BOOST_AUTO_TEST_CASE( commpattern_mainstream )
   PECommPattern pecp("CommPattern");
 
   // setup gid & rank
-  std::vector<Uint> gid;
+  std::vector<Gid> gid;
   std::vector<Uint> rank;
   setupGidAndRank(gid,rank);
   const int stride=1;
   const bool to_synchronize=false;
   pecp.insert("gid",gid,stride,to_synchronize);
+  BOOST_CHECK_EQUAL( pecp.get_child("gid").as_type<PEObjectWrapper>().is_data_type_Gid() , true );
 
   // additional arrays for testing
   std::vector<int> v1;
@@ -532,8 +533,8 @@ BOOST_AUTO_TEST_CASE( commpattern_external_synchronization )
   PECommPattern pecp("CommPattern");
 
   // setup gid & rank
-  std::vector<Uint> pre_gid; // it is used to feed through series of adds
-  std::vector<Uint> gid(0);
+  std::vector<Gid> pre_gid; // it is used to feed through series of adds
+  std::vector<Gid> gid(0);
   std::vector<Uint> rank;
   setupGidAndRank(pre_gid,rank);
   pecp.insert("gid",gid,1,false);
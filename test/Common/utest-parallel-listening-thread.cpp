@@ -0,0 +1,187 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for CF::Common::mpi::ListeningThread"
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/bind.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Common/BasicExceptions.hpp"
+#include "Common/Log.hpp"
+
+#include "Common/MPI/PE.hpp"
+#include "Common/MPI/ListeningThread.hpp"
+
+#include "Common/XML/FileOperations.hpp"
+#include "Common/XML/SignalFrame.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace CF;
+using namespace CF::Common;
+using namespace CF::Common::XML;
+using namespace CF::Common::mpi;
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct ListeningThreadFixture
+{
+  ListeningThreadFixture() : nb_frames(0), nb_expected(0)
+  {
+    m_argc = boost::unit_test::framework::master_test_suite().argc;
+    m_argv = boost::unit_test::framework::master_test_suite().argv;
+  }
+
+  /// slot called by the thread for each frame, stops the listening
+  /// when all expected frames arrived
+  void new_frame( const Communicator &, XmlDoc::Ptr )
+  {
+    ++nb_frames;
+
+    if( nb_frames == nb_expected )
+      listener.stop_listening();
+  }
+
+  /// sends frames from rank 1 to rank 0
+  void send_frames( Communicator comm, Uint count )
+  {
+    SignalFrame frame("ping", "cpath://Root", "cpath://Root");
+    std::string str;
+
+    to_string( *frame.xml_doc, str );
+
+    for( Uint i = 0 ; i < count ; ++i )
+      MPI_Send( const_cast<char*>(str.c_str()), str.length() + 1, MPI_CHAR, 0, 0, comm );
+  }
+
+  ListeningThread listener;
+
+  Uint nb_frames;
+
+  Uint nb_expected;
+
+  int m_argc;
+
+  char** m_argv;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( ListeningThreadSuite, ListeningThreadFixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( init )
+{
+  PE::instance().init(m_argc,m_argv);
+  BOOST_CHECK_EQUAL( PE::instance().is_active() , true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( receive_frames )
+{
+  // rank 1 sends to rank 0
+  if( PE::instance().size() < 2 || !PE::instance().is_thread_multiple() )
+    return;
+
+  Communicator comm;
+  MPI_Comm_dup( MPI_COMM_WORLD, &comm );
+
+  const Uint count = 50;
+
+  if( PE::instance().rank() == 0 )
+  {
+    nb_expected = count;
+
+    listener.new_signal.connect( boost::bind(&ListeningThreadFixture::new_frame, this, _1, _2) );
+    listener.add_communicator( comm );
+    listener.start_listening();
+
+    // the thread stops itself when all frames arrived
+    listener.thread().join();
+
+    BOOST_CHECK_EQUAL( nb_frames, count );
+
+    listener.remove_comunicator( comm );
+  }
+  else if( PE::instance().rank() == 1 )
+    send_frames( comm, count );
+
+  MPI_Barrier( comm );
+  MPI_Comm_free( &comm );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( thread_support )
+{
+  if( PE::instance().is_thread_multiple() )
+    return;
+
+  // the listening thread refuses to start without MPI_THREAD_MULTIPLE
+  Communicator comm;
+  MPI_Comm_dup( MPI_COMM_WORLD, &comm );
+
+  listener.add_communicator( comm );
+  BOOST_CHECK_THROW( listener.start_listening(), SetupError );
+  BOOST_CHECK( !listener.thread().joinable() );
+
+  listener.remove_comunicator( comm );
+  MPI_Comm_free( &comm );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( stop_without_data )
+{
+  if( !PE::instance().is_thread_multiple() )
+    return;
+
+  Communicator comm;
+  MPI_Comm_dup( MPI_COMM_WORLD, &comm );
+
+  listener.add_communicator( comm );
+  listener.start_listening();
+
+  // the thread is blocked on the receive, it must be woken up to exit
+  listener.stop_listening();
+
+  BOOST_CHECK( !listener.thread().joinable() );
+
+  // can be restarted and a communicator can be added on the run
+  Communicator other;
+  MPI_Comm_dup( MPI_COMM_WORLD, &other );
+
+  listener.start_listening();
+  listener.add_communicator( other );
+  listener.remove_comunicator( comm );
+  listener.stop_listening();
+
+  BOOST_CHECK( !listener.thread().joinable() );
+
+  listener.remove_comunicator( other );
+
+  MPI_Comm_free( &other );
+  MPI_Comm_free( &comm );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( finalize )
+{
+  PE::instance().finalize();
+  BOOST_CHECK_EQUAL( PE::instance().is_active() , false );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
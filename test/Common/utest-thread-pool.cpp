@@ -0,0 +1,151 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for CF::Common::ThreadPool"
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "Common/BasicExceptions.hpp"
+#include "Common/ThreadPool.hpp"
+
+using namespace CF;
+using namespace CF::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Marks the indices of a range with the thread executing them
+void mark(std::vector<Uint>& threads, const Uint begin, const Uint end, const Uint thread)
+{
+  for (Uint i=begin; i<end; ++i)
+    threads[i] = thread;
+}
+
+/// Sums a range per thread, with a nested parallel_for
+void sum(std::vector<Uint>& sums, const Uint begin, const Uint end, const Uint thread)
+{
+  std::vector<Uint> inner(end-begin);
+  ThreadPool::instance().parallel_for(0, inner.size(), boost::bind(&mark, boost::ref(inner), _1, _2, _3));
+  for (Uint i=0; i<inner.size(); ++i)
+    BOOST_CHECK_EQUAL(inner[i], thread);
+
+  for (Uint i=begin; i<end; ++i)
+    sums[thread] += i;
+}
+
+/// Sums a range per thread
+void accumulate(std::vector<Uint>& sums, const Uint begin, const Uint end, const Uint thread)
+{
+  for (Uint i=begin; i<end; ++i)
+    sums[thread] += i;
+}
+
+/// Sums the range [0,n[ repeatedly with parallel_for(), counting the wrong sums
+void sum_repeatedly(const Uint n, Uint& nb_wrong)
+{
+  for (Uint repeat=0; repeat<100; ++repeat)
+  {
+    std::vector<Uint> sums(4,0);
+    ThreadPool::instance().parallel_for(0, n, boost::bind(&accumulate, boost::ref(sums), _1, _2, _3), 10);
+    if (sums[0]+sums[1]+sums[2]+sums[3] != (n-1)*n/2)
+      ++nb_wrong;
+  }
+}
+
+/// Fails on the index 42
+void fail(const Uint begin, const Uint end, const Uint thread)
+{
+  if (begin <= 42 && 42 < end)
+    throw ValueNotFound(FromHere(), "42");
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( ThreadPoolSuite )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( serial )
+{
+  ThreadPool& pool = ThreadPool::instance();
+  BOOST_CHECK_EQUAL(pool.nb_threads(), 1u);
+
+  std::vector<Uint> threads(100,10);
+  pool.parallel_for(0, 100, boost::bind(&mark, boost::ref(threads), _1, _2, _3));
+  for (Uint i=0; i<threads.size(); ++i)
+    BOOST_CHECK_EQUAL(threads[i], 0u);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( parallel_for )
+{
+  ThreadPool& pool = ThreadPool::instance();
+  pool.set_nb_threads(4);
+  BOOST_CHECK_EQUAL(pool.nb_threads(), 4u);
+
+  std::vector<Uint> threads(10000,10);
+  pool.parallel_for(0, 10000, boost::bind(&mark, boost::ref(threads), _1, _2, _3));
+  for (Uint i=0; i<threads.size(); ++i)
+    BOOST_CHECK(threads[i] < 4u);
+
+  // every index once, nested loops executing serially in their task
+
+  std::vector<Uint> sums(4,0);
+  pool.parallel_for(0, 1000, boost::bind(&sum, boost::ref(sums), _1, _2, _3), 10);
+  BOOST_CHECK_EQUAL(sums[0]+sums[1]+sums[2]+sums[3], 999u*1000u/2u);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( exceptions )
+{
+  ThreadPool& pool = ThreadPool::instance();
+  BOOST_CHECK_THROW(pool.parallel_for(0, 100, boost::bind(&fail, _1, _2, _3), 1), ParallelError);
+
+  // the pool is still usable after a failure
+  std::vector<Uint> threads(100,10);
+  pool.parallel_for(0, 100, boost::bind(&mark, boost::ref(threads), _1, _2, _3));
+  for (Uint i=0; i<threads.size(); ++i)
+    BOOST_CHECK(threads[i] < 4u);
+
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( concurrent_callers )
+{
+  ThreadPool& pool = ThreadPool::instance();
+  BOOST_CHECK_EQUAL(pool.nb_threads(), 4u);
+
+  // threads outside the pool execute their loop serially while the pool is busy
+  std::vector<Uint> nb_wrong(3,0);
+  boost::thread first( boost::bind(&sum_repeatedly, 1000u, boost::ref(nb_wrong[0])) );
+  boost::thread second( boost::bind(&sum_repeatedly, 1000u, boost::ref(nb_wrong[1])) );
+  sum_repeatedly(1000u, nb_wrong[2]);
+  first.join();
+  second.join();
+
+  BOOST_CHECK_EQUAL(nb_wrong[0], 0u);
+  BOOST_CHECK_EQUAL(nb_wrong[1], 0u);
+  BOOST_CHECK_EQUAL(nb_wrong[2], 0u);
+
+  pool.set_nb_threads(1);
+  BOOST_CHECK_EQUAL(pool.nb_threads(), 1u);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
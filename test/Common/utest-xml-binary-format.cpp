@@ -0,0 +1,136 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for XML binary frames"
+
+#include "rapidxml/rapidxml.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include "Common/BasicExceptions.hpp"
+#include "Common/CGroup.hpp"
+#include "Common/CRoot.hpp"
+#include "Common/URI.hpp"
+
+#include "Common/XML/BinaryFormat.hpp"
+#include "Common/XML/FileOperations.hpp"
+#include "Common/XML/Protocol.hpp"
+#include "Common/XML/SignalFrame.hpp"
+
+using namespace CF;
+using namespace CF::Common;
+using namespace CF::Common::XML;
+
+/////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( XmlBinaryFormat_TestSuite )
+
+/////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE ( round_trip )
+{
+  SignalFrame frame ( "theTarget", "cpath://Root/sender", "cpath://Root/receiver" );
+
+  frame.set_option<std::string>( "name", "MyMesh" );
+  frame.set_option<Uint>( "version", 42u );
+  frame.set_option<bool>( "full", false );
+
+  std::vector<std::string> paths;
+  paths.push_back("//Root/a");
+  paths.push_back("//Root/b");
+  frame.set_array( "removed", paths, " ; " );
+
+  std::string text;
+  std::string binary;
+
+  to_string( *frame.xml_doc, text );
+  to_binary( *frame.xml_doc, binary );
+
+  BOOST_CHECK( is_binary_frame( binary.c_str(), binary.size() ) );
+  BOOST_CHECK( !is_binary_frame( text.c_str(), text.size() ) );
+
+  // the binary frame gives back the same frame
+  XmlDoc::Ptr doc = parse_binary( binary.c_str(), binary.size() );
+  SignalFrame frame_back( Protocol::goto_doc_node(*doc).content->first_node( "frame" ) );
+
+  std::string frame_text;
+  std::string frame_text_back;
+
+  to_string( frame.node, frame_text );
+  to_string( frame_back.node, frame_text_back );
+
+  BOOST_CHECK_EQUAL( frame_text_back, frame_text );
+
+  BOOST_CHECK_EQUAL( frame_back.get_option<std::string>("name"), std::string("MyMesh") );
+  BOOST_CHECK_EQUAL( frame_back.get_option<Uint>("version"), 42u );
+  BOOST_CHECK_EQUAL( frame_back.get_option<bool>("full"), false );
+  BOOST_CHECK_EQUAL( frame_back.get_array<std::string>("removed").size(), 2u );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE ( component_tree_is_compact )
+{
+  CRoot::Ptr root = CRoot::create ( "Root" );
+
+  for( Uint i = 0 ; i < 50 ; ++i )
+  {
+    Component::Ptr group = root->create_component_ptr<CGroup>( "group" );
+    for( Uint j = 0 ; j < 10 ; ++j )
+      group->create_component_ptr<CGroup>( "item" );
+  }
+
+  SignalFrame frame ( "list_tree", root->uri(), root->uri() );
+  root->call_signal( "list_tree", frame );
+
+  std::string text;
+  std::string binary;
+
+  to_string( *frame.xml_doc, text );
+  to_binary( *frame.xml_doc, binary );
+
+  // type names and modes are only stored once
+  BOOST_CHECK_LT( binary.size() * 3, text.size() );
+
+  XmlDoc::Ptr doc = parse_binary( binary.c_str(), binary.size() );
+
+  std::string reply_text;
+  std::string reply_text_back;
+
+  to_string( frame.get_reply().node, reply_text );
+  SignalFrame reply_back( Protocol::goto_doc_node(*doc).content->first_node("frame") );
+
+  to_string( reply_back.get_reply().node, reply_text_back );
+
+  BOOST_CHECK_EQUAL( reply_text_back, reply_text );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE ( corrupted_frames )
+{
+  SignalFrame frame ( "theTarget", "cpath://Root/sender", "cpath://Root/receiver" );
+  frame.set_option<std::string>( "name", "MyMesh" );
+
+  std::string binary;
+  to_binary( *frame.xml_doc, binary );
+
+  // not a binary frame
+  BOOST_CHECK_THROW( parse_binary( "<frame/>", 8 ), XmlError );
+
+  // truncated frame
+  BOOST_CHECK_THROW( parse_binary( binary.c_str(), binary.size() - 1 ), XmlError );
+
+  // trailing data
+  std::string longer = binary + "x";
+  BOOST_CHECK_THROW( parse_binary( longer.c_str(), longer.size() ), XmlError );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////
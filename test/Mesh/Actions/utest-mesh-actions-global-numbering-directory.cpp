@@ -0,0 +1,247 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Tests Mesh::Actions::GlobalNumberingDirectory"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/BasicExceptions.hpp"
+#include "Common/Core.hpp"
+#include "Common/MPI/PE.hpp"
+
+#include "Math/Consts.hpp"
+
+#include "Mesh/Actions/GlobalNumberingDirectory.hpp"
+
+using namespace CF;
+using namespace CF::Common;
+using namespace CF::Common::mpi;
+using namespace CF::Math::Consts;
+using namespace CF::Mesh::Actions;
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct GlobalNumberingDirectory_Fixture
+{
+  /// common setup for each test case
+  GlobalNumberingDirectory_Fixture()
+  {
+    m_argc = boost::unit_test::framework::master_test_suite().argc;
+    m_argv = boost::unit_test::framework::master_test_suite().argv;
+  }
+
+  int m_argc;
+  char** m_argv;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( GlobalNumberingDirectory_TestSuite, GlobalNumberingDirectory_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( Init )
+{
+  Core::instance().initiate(m_argc,m_argv);
+  PE::instance().init(m_argc,m_argv);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Every process owns 100 points on a line, the points of the neighbour
+/// processes are its ghosts. Ghosts are added in reverse order, with
+/// x=0 given as -0. to check that both are matched.
+BOOST_AUTO_TEST_CASE( resolve_ghosts )
+{
+  const Uint rank = PE::instance().rank();
+  const Uint size = PE::instance().size();
+  const Uint nb_owned = 100;
+
+  GlobalNumberingDirectory<Real> directory(2);
+
+  Real key[2];
+  key[1] = 0.5;
+
+  for (Uint i=0; i<nb_owned; ++i)
+  {
+    key[0] = rank*nb_owned + i;
+    directory.add(key, 1000 + rank*nb_owned + i);
+  }
+
+  // ghost on the right
+  if (rank+1 < size)
+  {
+    key[0] = (rank+1)*nb_owned;
+    directory.add(key, gid_max());
+  }
+
+  // ghost on the left
+  if (rank > 0)
+  {
+    key[0] = rank*nb_owned - 1;
+    directory.add(key, gid_max());
+  }
+
+  // ghost of the first point, sent as -0.
+  if (rank > 0)
+  {
+    key[0] = -0.;
+    directory.add(key, gid_max());
+  }
+
+  std::vector<Gid> glb_idx;
+  std::vector<Uint> owner;
+  directory.resolve(glb_idx, owner, true);
+
+  BOOST_CHECK_EQUAL(glb_idx.size(), directory.size());
+  BOOST_CHECK_EQUAL(owner.size(), directory.size());
+
+  for (Uint i=0; i<nb_owned; ++i)
+  {
+    BOOST_CHECK_EQUAL(glb_idx[i], 1000 + rank*nb_owned + i);
+    BOOST_CHECK_EQUAL(owner[i], rank);
+  }
+
+  Uint g = nb_owned;
+  if (rank+1 < size)
+  {
+    BOOST_CHECK_EQUAL(glb_idx[g], 1000 + (rank+1)*nb_owned);
+    BOOST_CHECK_EQUAL(owner[g], rank+1);
+    ++g;
+  }
+  if (rank > 0)
+  {
+    BOOST_CHECK_EQUAL(glb_idx[g], 1000 + rank*nb_owned - 1);
+    BOOST_CHECK_EQUAL(owner[g], rank-1);
+    ++g;
+
+    BOOST_CHECK_EQUAL(glb_idx[g], 1000u);
+    BOOST_CHECK_EQUAL(owner[g], 0u);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( large_global_index )
+{
+  // global indices beyond 2^32, the ghost of rank r is owned by rank r-1
+  const Uint rank = PE::instance().rank();
+  const Gid offset = Gid(uint_max()) + 1;
+
+  GlobalNumberingDirectory<Real> directory(1);
+
+  Real key = rank;
+  directory.add(&key, offset + rank);
+  if (rank > 0)
+  {
+    key = rank - 1;
+    directory.add(&key, gid_max());
+  }
+
+  std::vector<Gid> glb_idx;
+  std::vector<Uint> owner;
+  directory.resolve(glb_idx, owner, true);
+
+  BOOST_CHECK_EQUAL(glb_idx[0], offset + rank);
+  if (rank > 0)
+  {
+    BOOST_CHECK_EQUAL(glb_idx[1], offset + rank - 1);
+    BOOST_CHECK_EQUAL(owner[1], rank-1);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( large_integer_keys )
+{
+  // keys beyond 2^53 that a Real can not tell apart
+  const Uint rank = PE::instance().rank();
+  const Gid base = Gid(1) << 53;
+
+  GlobalNumberingDirectory<Gid> directory(2);
+
+  Gid key[2] = { base, base + 2*rank + 1 };
+  directory.add(key, 2*rank);
+  key[1] = base + 2*rank + 2;
+  directory.add(key, 2*rank + 1);
+  key[1] = base + 2*rank + 1;
+  directory.add(key, gid_max());
+
+  std::vector<Gid> glb_idx;
+  std::vector<Uint> owner;
+  BOOST_CHECK_NO_THROW(directory.resolve(glb_idx, owner, true));
+
+  BOOST_CHECK_EQUAL(glb_idx[2], 2*rank);
+  BOOST_CHECK_EQUAL(owner[2], rank);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( missing_owner )
+{
+  GlobalNumberingDirectory<Real> directory(1);
+
+  const Real key = -1. - PE::instance().rank();
+  directory.add(&key, gid_max());
+
+  std::vector<Gid> glb_idx;
+  std::vector<Uint> owner;
+
+  directory.resolve(glb_idx, owner, false);
+  BOOST_CHECK_EQUAL(glb_idx[0], gid_max());
+  BOOST_CHECK_EQUAL(owner[0], uint_max());
+
+  BOOST_CHECK_THROW(directory.resolve(glb_idx, owner, true), ValueNotFound);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( duplicated_key )
+{
+  // all processes own the same key
+  GlobalNumberingDirectory<Real> directory(1);
+
+  const Real key = 42.;
+  directory.add(&key, PE::instance().rank());
+
+  std::vector<Gid> glb_idx;
+  std::vector<Uint> owner;
+
+  // only the home process of the key sees the duplicates
+  bool thrown = false;
+  try
+  {
+    directory.resolve(glb_idx, owner, true);
+  }
+  catch (ValueExists&)
+  {
+    thrown = true;
+  }
+
+  std::vector<int> thrown_per_proc(PE::instance().size());
+  PE::instance().all_gather(static_cast<int>(thrown), thrown_per_proc);
+
+  int nb_thrown = 0;
+  for (Uint p=0; p<thrown_per_proc.size(); ++p)
+    nb_thrown += thrown_per_proc[p];
+
+  BOOST_CHECK_EQUAL(nb_thrown, PE::instance().size() > 1 ? 1 : 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( Terminate )
+{
+  PE::instance().finalize();
+  Core::instance().terminate();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
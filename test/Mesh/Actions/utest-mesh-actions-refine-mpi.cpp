@@ -0,0 +1,195 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Tests Mesh::Actions::Refine in parallel"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/Core.hpp"
+#include "Common/CRoot.hpp"
+#include "Common/FindComponents.hpp"
+#include "Common/Foreach.hpp"
+
+#include "Common/MPI/PE.hpp"
+
+#include "Mesh/Actions/Refine.hpp"
+#include "Mesh/CElements.hpp"
+#include "Mesh/CField.hpp"
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CMeshReader.hpp"
+#include "Mesh/CNodes.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/ElementType.hpp"
+
+using namespace CF;
+using namespace CF::Common;
+using namespace CF::Common::mpi;
+using namespace CF::Mesh;
+using namespace CF::Mesh::Actions;
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct RefineMPI_Fixture
+{
+  RefineMPI_Fixture()
+  {
+    m_argc = boost::unit_test::framework::master_test_suite().argc;
+    m_argv = boost::unit_test::framework::master_test_suite().argv;
+  }
+
+  /// reads the mesh, with an indicator marking the cells left of x = 1.5
+  static CMesh& read_mesh(const std::string& name)
+  {
+    CMeshReader::Ptr meshreader = build_component_abstract_type<CMeshReader>("CF.Mesh.Neu.CReader","meshreader");
+    CMesh& mesh = Core::instance().root().create_component<CMesh>(name);
+    meshreader->read_mesh_into("quadtriag.neu",mesh);
+
+    // in parallel, each process gets the elements around the nodes it owns
+    if (PE::instance().is_active())
+    {
+      build_component_abstract_type<CMeshTransformer>("CF.Mesh.Actions.CGlobalNumbering","glb_numbering")->transform(mesh);
+      build_component_abstract_type<CMeshTransformer>("CF.Mesh.Actions.CGlobalConnectivity","glb_connectivity")->transform(mesh);
+      build_component_abstract_type<CMeshTransformer>("CF.Mesh.Actions.GrowOverlap","grow_overlap")->transform(mesh);
+    }
+
+    build_component_abstract_type<CMeshTransformer>("CF.Mesh.Actions.CreateSpaceP0","create_space_P0")->transform(mesh);
+    CField& indicator = mesh.create_field("indicator",CField::Basis::CELL_BASED,"P0");
+    boost_foreach(const CElements& elements, find_components_recursively<CElements>(mesh.topology()))
+    {
+      if (indicator.exists_for_entities(elements) == false)
+        continue;
+      const Uint start = indicator.elements_start_idx(elements);
+      for (Uint e=0; e<elements.size(); ++e)
+        indicator[start+e][0] = elements.get_coordinates(e).col(XX).mean() < 1.5 ? 1. : 0.;
+    }
+    return mesh;
+  }
+
+  /// number and total area of the cells owned by this process
+  static void owned_cells(const CMesh& mesh, Uint& nb_cells, Real& area)
+  {
+    nb_cells = 0;
+    area = 0.;
+    boost_foreach(const CElements& elements, find_components_recursively<CElements>(mesh.topology()))
+    {
+      if (elements.element_type().dimensionality() != mesh.dimension())
+        continue;
+      for (Uint e=0; e<elements.size(); ++e)
+      {
+        if (elements.is_ghost(e))
+          continue;
+        ++nb_cells;
+        area += elements.element_type().compute_volume(elements.get_coordinates(e));
+      }
+    }
+  }
+
+  int m_argc;
+  char** m_argv;
+
+  /// result of the refinement in serial
+  static Uint serial_nb_cells;
+  static Real serial_area;
+  static Uint serial_nb_nodes;
+};
+
+Uint RefineMPI_Fixture::serial_nb_cells = 0;
+Real RefineMPI_Fixture::serial_area = 0.;
+Uint RefineMPI_Fixture::serial_nb_nodes = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( RefineMPISuite, RefineMPI_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Must be run before the parallel environment is initialized
+BOOST_AUTO_TEST_CASE( SerialReference )
+{
+  CMesh& mesh = read_mesh("serial");
+
+  Refine::Ptr refine = allocate_component<Refine>("refine");
+  refine->configure_option("indicator",mesh.get_child("indicator").uri());
+  refine->transform(mesh);
+
+  owned_cells(mesh,serial_nb_cells,serial_area);
+  serial_nb_nodes = mesh.nodes().size();
+  BOOST_CHECK_GT(serial_nb_cells, 16u);
+  BOOST_CHECK_LT(serial_nb_cells, 64u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( Init )
+{
+  PE::instance().init(m_argc,m_argv);
+  BOOST_CHECK_EQUAL(PE::instance().size(), 2u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( LocalRefinement )
+{
+  CMesh& mesh = read_mesh("parallel");
+
+  Refine::Ptr refine = allocate_component<Refine>("refine");
+  refine->configure_option("indicator",mesh.get_child("indicator").uri());
+  refine->transform(mesh);
+
+  // the processes split the edges they share alike, and own the same cells as in serial
+  Uint nb_cells;
+  Real area;
+  owned_cells(mesh,nb_cells,area);
+  Uint total_nb_cells;
+  Real total_area;
+  PE::instance().all_reduce(plus(),&nb_cells,1,&total_nb_cells);
+  PE::instance().all_reduce(plus(),&area,1,&total_area);
+  BOOST_CHECK_EQUAL(total_nb_cells, serial_nb_cells);
+  BOOST_CHECK_CLOSE(total_area, serial_area, 1e-10);
+
+  // and create each new node once, on the process owning it
+  Uint nb_nodes = 0;
+  for (Uint n=0; n<mesh.nodes().size(); ++n)
+    if (!mesh.nodes().is_ghost(n))
+      ++nb_nodes;
+  Uint total_nb_nodes;
+  PE::instance().all_reduce(plus(),&nb_nodes,1,&total_nb_nodes);
+  BOOST_CHECK_EQUAL(total_nb_nodes, serial_nb_nodes);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( UniformRefinement )
+{
+  CMesh& mesh = Core::instance().root().get_child("parallel").as_type<CMesh>();
+
+  Uint nb_cells_before;
+  Real area_before;
+  owned_cells(mesh,nb_cells_before,area_before);
+
+  Refine::Ptr refine = allocate_component<Refine>("refine");
+  refine->transform(mesh);
+
+  Uint nb_cells;
+  Real area;
+  owned_cells(mesh,nb_cells,area);
+  BOOST_CHECK_EQUAL(nb_cells, 4*nb_cells_before);
+  BOOST_CHECK_CLOSE(area, area_before, 1e-10);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( Terminate )
+{
+  PE::instance().finalize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
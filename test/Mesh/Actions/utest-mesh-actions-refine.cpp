@@ -0,0 +1,262 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Tests Mesh::Actions::Refine"
+
+#include <map>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/Core.hpp"
+#include "Common/CRoot.hpp"
+#include "Common/FindComponents.hpp"
+#include "Common/Foreach.hpp"
+
+#include "Mesh/Actions/Refine.hpp"
+#include "Mesh/CElements.hpp"
+#include "Mesh/CField.hpp"
+#include "Mesh/CList.hpp"
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CMeshReader.hpp"
+#include "Mesh/CNodes.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/CSimpleMeshGenerator.hpp"
+#include "Mesh/CSpace.hpp"
+#include "Mesh/ElementType.hpp"
+
+using namespace CF;
+using namespace CF::Common;
+using namespace CF::Mesh;
+using namespace CF::Mesh::Actions;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Total volume of the cells, and the smallest one
+void cell_volumes(const CMesh& mesh, Real& total, Real& smallest)
+{
+  total = 0.;
+  smallest = 1e30;
+  boost_foreach(const CElements& elements, find_components_recursively<CElements>(mesh.topology()))
+  {
+    if (elements.element_type().dimensionality() != mesh.dimension())
+      continue;
+    for (Uint e=0; e<elements.size(); ++e)
+    {
+      const Real volume = elements.element_type().compute_volume(elements.get_coordinates(e));
+      total += volume;
+      smallest = std::min(smallest, volume);
+    }
+  }
+}
+
+/// Checks that a 2D mesh is conforming: each edge of a cell is shared with another
+/// cell, or is a boundary line
+void check_conforming_2d(const CMesh& mesh)
+{
+  typedef std::pair<Uint,Uint> Edge;
+  std::map<Edge,Uint> cell_edges;
+  std::map<Edge,Uint> boundary_edges;
+  boost_foreach(const CElements& elements, find_components_recursively<CElements>(mesh.topology()))
+  {
+    const bool is_cell = elements.element_type().dimensionality() == 2;
+    for (Uint e=0; e<elements.size(); ++e)
+    {
+      const CTable<Uint>::ConstRow nodes = elements.get_nodes(e);
+      const Uint nb_edges = is_cell ? nodes.size() : 1;
+      for (Uint i=0; i<nb_edges; ++i)
+      {
+        const Uint a = nodes[i];
+        const Uint b = nodes[(i+1)%nodes.size()];
+        ++(is_cell ? cell_edges : boundary_edges)[Edge(std::min(a,b),std::max(a,b))];
+      }
+    }
+  }
+
+  Uint nb_open_edges = 0;
+  for (std::map<Edge,Uint>::const_iterator it = cell_edges.begin(); it != cell_edges.end(); ++it)
+  {
+    BOOST_CHECK_LE(it->second, 2u);
+    if (it->second == 1)
+    {
+      ++nb_open_edges;
+      BOOST_CHECK_EQUAL(boundary_edges.count(it->first), 1u);
+    }
+  }
+  BOOST_CHECK_EQUAL(nb_open_edges, boundary_edges.size());
+}
+
+Uint nb_cells(const CMesh& mesh)
+{
+  Uint result = 0;
+  boost_foreach(const CElements& elements, find_components_recursively<CElements>(mesh.topology()))
+  {
+    if (elements.element_type().dimensionality() == mesh.dimension())
+      result += elements.size();
+  }
+  return result;
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( RefineSuite )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( UniformRefinement2D )
+{
+  CMeshReader::Ptr meshreader = build_component_abstract_type<CMeshReader>("CF.Mesh.Neu.CReader","meshreader");
+  CMesh& mesh = Core::instance().root().create_component<CMesh>("quadtriag_uniform");
+  meshreader->read_mesh_into("quadtriag.neu",mesh);
+
+  // a linear field is interpolated exactly
+  CField& linear = mesh.create_field("linear",CField::Basis::POINT_BASED);
+  const CList<Uint>& used_nodes = linear.used_nodes();
+  for (Uint i=0; i<used_nodes.size(); ++i)
+    linear[i][0] = mesh.nodes().coordinates()[used_nodes[i]][XX] + 2.*mesh.nodes().coordinates()[used_nodes[i]][YY];
+
+  Real volume_before, smallest_before;
+  cell_volumes(mesh,volume_before,smallest_before);
+  BOOST_REQUIRE_GT(smallest_before, 0.);
+  const Uint nb_cells_before = nb_cells(mesh);
+
+  Refine::Ptr refine = allocate_component<Refine>("refine");
+  refine->configure_option("levels",2u);
+  refine->transform(mesh);
+
+  Real volume_after, smallest_after;
+  cell_volumes(mesh,volume_after,smallest_after);
+  BOOST_CHECK_CLOSE(volume_after, volume_before, 1e-10);
+  BOOST_CHECK_GT(smallest_after, 0.);
+  BOOST_CHECK_EQUAL(nb_cells(mesh), 16*nb_cells_before);
+  check_conforming_2d(mesh);
+
+  BOOST_CHECK_EQUAL(linear.size(), linear.used_nodes().size());
+  for (Uint i=0; i<linear.size(); ++i)
+  {
+    const Uint node = linear.used_nodes()[i];
+    BOOST_CHECK_CLOSE(linear[i][0], mesh.nodes().coordinates()[node][XX] + 2.*mesh.nodes().coordinates()[node][YY], 1e-10);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( LocalRefinement2D )
+{
+  CMeshReader::Ptr meshreader = build_component_abstract_type<CMeshReader>("CF.Mesh.Neu.CReader","meshreader");
+  CMesh& mesh = Core::instance().root().create_component<CMesh>("quadtriag_local");
+  meshreader->read_mesh_into("quadtriag.neu",mesh);
+
+  build_component_abstract_type<CMeshTransformer>("CF.Mesh.Actions.CreateSpaceP0","create_space_P0")->transform(mesh);
+  CField& indicator = mesh.create_field("indicator",CField::Basis::CELL_BASED,"P0");
+
+  // mark the first triangle only
+  Uint nb_triangles = 0;
+  boost_foreach(const CElements& elements, find_components_recursively<CElements>(mesh.topology()))
+  {
+    if (elements.element_type().shape() == GeoShape::TRIAG && indicator.exists_for_entities(elements))
+    {
+      indicator[indicator.elements_start_idx(elements)][0] = 1.;
+      nb_triangles += elements.size();
+      break;
+    }
+  }
+  BOOST_REQUIRE_GT(nb_triangles, 0u);
+
+  Real volume_before, smallest_before;
+  cell_volumes(mesh,volume_before,smallest_before);
+  const Uint nb_cells_before = nb_cells(mesh);
+
+  Refine::Ptr refine = allocate_component<Refine>("refine");
+  refine->configure_option("indicator",indicator.uri());
+  refine->transform(mesh);
+
+  Real volume_after, smallest_after;
+  cell_volumes(mesh,volume_after,smallest_after);
+  BOOST_CHECK_CLOSE(volume_after, volume_before, 1e-10);
+  BOOST_CHECK_GT(smallest_after, 0.);
+  BOOST_CHECK_GT(nb_cells(mesh), nb_cells_before);
+  BOOST_CHECK_LT(nb_cells(mesh), 4*nb_cells_before);
+  check_conforming_2d(mesh);
+
+  // the marked triangle is split in 4, and its children keep its value
+  Real marked = 0.;
+  for (Uint i=0; i<indicator.size(); ++i)
+    marked += indicator[i][0];
+  BOOST_CHECK_EQUAL(marked, 4.);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( LocalRefinementQuads )
+{
+  CMesh& mesh = Core::instance().root().create_component<CMesh>("rectangle_local");
+  CSimpleMeshGenerator::create_rectangle(mesh, 4., 4., 4, 4);
+
+  build_component_abstract_type<CMeshTransformer>("CF.Mesh.Actions.CreateSpaceP0","create_space_P0")->transform(mesh);
+  CField& indicator = mesh.create_field("indicator",CField::Basis::CELL_BASED,"P0");
+  indicator.data() = 0.;
+
+  // mark the cell in the corner
+  boost_foreach(const CElements& elements, find_components_recursively<CElements>(mesh.topology()))
+  {
+    if (elements.element_type().shape() == GeoShape::QUAD && indicator.exists_for_entities(elements))
+    {
+      indicator[indicator.elements_start_idx(elements)][0] = 1.;
+      break;
+    }
+  }
+
+  Refine::Ptr refine = allocate_component<Refine>("refine");
+  refine->configure_option("indicator",indicator.uri());
+  refine->transform(mesh);
+
+  // quadrilaterals have no conforming split of one edge: the refinement spreads
+  // to all the quadrilaterals connected to the marked one
+  BOOST_CHECK_EQUAL(nb_cells(mesh), 64u);
+  check_conforming_2d(mesh);
+
+  Real marked = 0.;
+  for (Uint i=0; i<indicator.size(); ++i)
+    marked += indicator[i][0];
+  BOOST_CHECK_EQUAL(marked, 4.);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( UniformRefinement3D )
+{
+  CMeshReader::Ptr meshreader = build_component_abstract_type<CMeshReader>("CF.Mesh.Neu.CReader","meshreader");
+  CMesh& mesh = Core::instance().root().create_component<CMesh>("hextet_uniform");
+  meshreader->read_mesh_into("hextet.neu",mesh);
+
+  Real volume_before, smallest_before;
+  cell_volumes(mesh,volume_before,smallest_before);
+  BOOST_REQUIRE_GT(smallest_before, 0.);
+  const Uint nb_cells_before = nb_cells(mesh);
+  const Uint nb_nodes_before = mesh.nodes().size();
+
+  Refine::Ptr refine = allocate_component<Refine>("refine");
+  refine->transform(mesh);
+
+  Real volume_after, smallest_after;
+  cell_volumes(mesh,volume_after,smallest_after);
+  BOOST_CHECK_CLOSE(volume_after, volume_before, 1e-10);
+  BOOST_CHECK_GT(smallest_after, 0.);
+  BOOST_CHECK_EQUAL(nb_cells(mesh), 8*nb_cells_before);
+  BOOST_CHECK_GT(mesh.nodes().size(), nb_nodes_before);
+  BOOST_CHECK_EQUAL(mesh.nodes().glb_idx().size(), mesh.nodes().size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
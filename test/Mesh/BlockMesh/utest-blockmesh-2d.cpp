@@ -16,7 +16,11 @@
 
 #include "Mesh/BlockMesh/BlockData.hpp"
 #include "Mesh/CDomain.hpp"
+#include "Mesh/CElements.hpp"
 #include "Mesh/CMesh.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/CStructuredBlocks.hpp"
+#include "Mesh/CTable.hpp"
 #include "Mesh/CMeshWriter.hpp"
 
 using namespace CF;
@@ -79,6 +83,52 @@ BOOST_AUTO_TEST_CASE( Grid2D )
   writer->write_from_to(mesh, URI("grid-2d.vtk"));
 }
 
+BOOST_AUTO_TEST_CASE( StructuredBlocks2D )
+{
+  CMesh& mesh = Core::instance().root().get_child("domain").get_child("mesh").as_type<CMesh>();
+  CElements& elements = find_component<CElements>(mesh.topology().get_child("root_region").get_child("volume"));
+  CTable<Uint>& connectivity = elements.node_connectivity();
+
+  CStructuredBlocks::ConstPtr blocks = CStructuredBlocks::of(elements);
+  BOOST_REQUIRE(blocks);
+  BOOST_CHECK_EQUAL(blocks->nb_blocks(), 1u);
+
+  const CStructuredBlocks::Block& block = blocks->block(0);
+  BOOST_CHECK_EQUAL(block.size[XX], 10u);
+  BOOST_CHECK_EQUAL(block.size[YY], 10u);
+  BOOST_CHECK_EQUAL(block.size[ZZ], 1u);
+  BOOST_CHECK(block.implicit_nodes);
+
+  // neighbors inside the block, none across the boundary
+  Uint neighbor = 0;
+  BOOST_CHECK(blocks->neighbor(0, XX, true, neighbor));
+  BOOST_CHECK_EQUAL(neighbor, 1u);
+  BOOST_CHECK(blocks->neighbor(0, YY, true, neighbor));
+  BOOST_CHECK_EQUAL(neighbor, 10u);
+  BOOST_CHECK(!blocks->neighbor(0, XX, false, neighbor));
+  BOOST_CHECK(!blocks->neighbor(9, XX, true, neighbor));
+  BOOST_CHECK(!blocks->neighbor(95, YY, true, neighbor));
+
+  // computed nodes match the connectivity, for all elements not touching the positive sides
+  Uint nb_computed = 0;
+  std::vector<Uint> nodes(4);
+  for(Uint elem = 0; elem != elements.size(); ++elem)
+  {
+    if(!blocks->element_nodes(0, elem, nodes))
+      continue;
+    ++nb_computed;
+    for(Uint n = 0; n != 4; ++n)
+      BOOST_CHECK_EQUAL(nodes[n], connectivity[elem][n]);
+  }
+  BOOST_CHECK_EQUAL(nb_computed, 81u);
+
+  // a change in the nodes of the last element invalidates the block structure
+  std::swap(connectivity[99][0], connectivity[99][2]);
+  BOOST_CHECK(!CStructuredBlocks::of(elements));
+  std::swap(connectivity[99][0], connectivity[99][2]);
+  BOOST_CHECK(CStructuredBlocks::of(elements));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -133,6 +133,20 @@ BOOST_AUTO_TEST_CASE( JacobianAdjoint )
   BOOST_CHECK_LT(boost::accumulators::max(accumulator.ulps), 1);
 }
 
+BOOST_AUTO_TEST_CASE( PlaneJacobianNormal )
+{
+  // the plane of a line is a point, with unit jacobian
+  const Line1DLagrangeP1 etype;
+  const RealVector mapped = mapped_coords;
+  const RealMatrix dyn_nodes = nodes;
+
+  RealVector result(1);
+  etype.compute_plane_jacobian_normal(mapped, dyn_nodes, KSI, result);
+  BOOST_CHECK_EQUAL(result[XX], 1.);
+
+  BOOST_CHECK_EQUAL(etype.plane_jacobian_normal(mapped, dyn_nodes, KSI)[XX], 1.);
+}
+
 BOOST_AUTO_TEST_CASE( integrateConst )
 {
   ConstFunctor ftor(nodes);
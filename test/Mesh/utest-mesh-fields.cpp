@@ -21,7 +21,9 @@
 #include "Mesh/CRegion.hpp"
 #include "Mesh/CElements.hpp"
 #include "Mesh/CField.hpp"
+#include "Mesh/CFieldView.hpp"
 #include "Mesh/CMeshReader.hpp"
+#include "Mesh/CMeshTransformer.hpp"
 #include "Mesh/CNodes.hpp"
 
 using namespace boost;
@@ -186,6 +188,153 @@ BOOST_AUTO_TEST_CASE( FieldOperators )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_CASE( FieldLayout )
+{
+  CMesh& mesh = *FieldTests_Fixture::m_mesh;
+
+  CField& solution = *mesh.get_child_ptr("solution")->as_ptr<CField>();
+  CTable<Real>& data = solution.data();
+  BOOST_CHECK_EQUAL ( data.layout() , CTable<Real>::AOS );
+
+  const Uint nb_rows = data.size();
+  const Uint nb_vars = data.row_size();
+  for (Uint i=0; i<nb_rows; ++i)
+    for (Uint j=0; j<nb_vars; ++j)
+      data[i][j] = i*nb_vars + j;
+
+  BOOST_CHECK_EQUAL ( data.column(1).stride , nb_vars );
+
+  // the values are kept, and the rows accessed the same way
+  solution.configure_option("Layout",std::string("SoA"));
+  BOOST_CHECK_EQUAL ( data.layout() , CTable<Real>::SOA );
+  for (Uint i=0; i<nb_rows; ++i)
+    for (Uint j=0; j<nb_vars; ++j)
+      BOOST_CHECK_EQUAL ( data[i][j] , Real(i*nb_vars + j) );
+
+  // contiguous columns
+  for (Uint j=0; j<nb_vars; ++j)
+  {
+    const CTable<Real>::ConstColumn column = data.column(j);
+    BOOST_CHECK_EQUAL ( column.stride , 1u );
+    BOOST_CHECK_EQUAL ( column.size , nb_rows );
+    for (Uint i=0; i<nb_rows; ++i)
+      BOOST_CHECK_EQUAL ( column.values[i] , Real(i*nb_vars + j) );
+  }
+
+  // fields created from it use the same layout
+  CField& copy = mesh.create_field("solution_layout",solution);
+  BOOST_CHECK_EQUAL ( copy.data().layout() , CTable<Real>::SOA );
+  copy.data() = data;
+  BOOST_CHECK_EQUAL ( copy.data()[nb_rows-1][nb_vars-1] , data[nb_rows-1][nb_vars-1] );
+
+  // adding rows keeps the layout
+  data.resize(nb_rows+1);
+  BOOST_CHECK_EQUAL ( data.column(0).stride , 1u );
+  BOOST_CHECK_EQUAL ( data[nb_rows-1][nb_vars-1] , Real(nb_rows*nb_vars - 1) );
+
+  solution.configure_option("Layout",std::string("AoS"));
+  BOOST_CHECK_EQUAL ( data.layout() , CTable<Real>::AOS );
+  BOOST_CHECK_EQUAL ( data[nb_rows-1][nb_vars-1] , Real(nb_rows*nb_vars - 1) );
+  data.resize(nb_rows);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( FieldPrecision )
+{
+  CMesh& mesh = *FieldTests_Fixture::m_mesh;
+
+  CField& solution = *mesh.get_child_ptr("solution")->as_ptr<CField>();
+  CField& coeff = mesh.create_scalar_field("coeff",solution);
+  BOOST_CHECK_EQUAL ( coeff.precision() , CField::REAL );
+
+  const Uint nb_rows = coeff.size();
+  for (Uint i=0; i<nb_rows; ++i)
+    coeff.data()[i][0] = 0.5*i;
+
+  // the values are converted, and the Real storage released
+  coeff.configure_option("Precision",std::string("Single"));
+  BOOST_CHECK_EQUAL ( coeff.precision() , CField::SINGLE );
+  BOOST_CHECK_EQUAL ( coeff.size() , nb_rows );
+  const CTable<float>& data = coeff.data_single();
+  BOOST_CHECK_EQUAL ( data.size() , nb_rows );
+  BOOST_CHECK_EQUAL ( data.row_size() , 1u );
+  for (Uint i=0; i<nb_rows; ++i)
+    BOOST_CHECK_EQUAL ( data[i][0] , 0.5f*i );
+
+  // new storage is allocated in single precision
+  coeff.create_data_storage();
+  BOOST_CHECK_EQUAL ( coeff.data_single().size() , nb_rows );
+
+  // fields in single precision have no view
+  CFieldView view("view");
+  BOOST_CHECK_THROW ( view.set_field(coeff) , NotSupported );
+
+  // nor access to Real data
+  BOOST_CHECK_THROW ( coeff.data() , IllegalCall );
+  BOOST_CHECK_THROW ( coeff[0] , IllegalCall );
+  const CField& const_coeff = coeff;
+  BOOST_CHECK_THROW ( const_coeff[0] , IllegalCall );
+
+  coeff.data_single()[0][0] = 2.f;
+  coeff.configure_option("Precision",std::string("Real"));
+  BOOST_CHECK_EQUAL ( coeff.data().size() , nb_rows );
+  BOOST_CHECK_EQUAL ( coeff.data()[0][0] , 2. );
+  BOOST_CHECK_THROW ( coeff.data_single() , IllegalCall );
+
+  mesh.remove_component("coeff");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( InitSinglePrecisionField )
+{
+  CMesh& mesh = *FieldTests_Fixture::m_mesh;
+  build_component_abstract_type<CMeshTransformer>("CF.Mesh.Actions.CreateSpaceP0","create_spaceP0")->transform(mesh);
+
+  const std::vector<std::string> functions(1,"x+2*y");
+
+  CMeshTransformer::Ptr init_constant = build_component_abstract_type<CMeshTransformer>("CF.Mesh.Actions.CInitFieldConstant","init_constant");
+  init_constant->configure_option("constant",3.);
+  CMeshTransformer::Ptr init_function = build_component_abstract_type<CMeshTransformer>("CF.Mesh.Actions.CInitFieldFunction","init_function");
+  init_function->configure_option("functions",functions);
+
+  // point based
+  CField& solution = *mesh.get_child_ptr("solution")->as_ptr<CField>();
+  CField& point_coeff = mesh.create_scalar_field("point_coeff",solution);
+  point_coeff.configure_option("Precision",std::string("Single"));
+
+  init_constant->configure_option("field",point_coeff.uri());
+  init_constant->transform(mesh);
+  for (Uint i=0; i<point_coeff.size(); ++i)
+    BOOST_CHECK_EQUAL ( point_coeff.data_single()[i][0] , 3.f );
+
+  init_function->configure_option("field",point_coeff.uri());
+  init_function->transform(mesh);
+  for (Uint i=0; i<point_coeff.size(); ++i)
+    BOOST_CHECK_CLOSE ( point_coeff.data_single()[i][0] , point_coeff.coords(i)[XX] + 2.*point_coeff.coords(i)[YY] , 1e-4 );
+
+  // cell based, single precision values match the Real ones
+  CField& real_coeff = mesh.create_field("real_coeff",CField::Basis::CELL_BASED,"P0","coeff[1]");
+  CField& cell_coeff = mesh.create_field("cell_coeff",CField::Basis::CELL_BASED,"P0","coeff[1]");
+  cell_coeff.configure_option("Precision",std::string("Single"));
+
+  init_function->configure_option("field",real_coeff.uri());
+  init_function->transform(mesh);
+  init_function->configure_option("field",cell_coeff.uri());
+  init_function->transform(mesh);
+
+  BOOST_CHECK_EQUAL ( cell_coeff.size() , real_coeff.size() );
+  for (Uint i=0; i<cell_coeff.size(); ++i)
+    BOOST_CHECK_CLOSE ( cell_coeff.data_single()[i][0] , real_coeff.data()[i][0] , 1e-4 );
+
+  mesh.remove_component("point_coeff");
+  mesh.remove_component("real_coeff");
+  mesh.remove_component("cell_coeff");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_SUITE_END()
 
 ////////////////////////////////////////////////////////////////////////////////
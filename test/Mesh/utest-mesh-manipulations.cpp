@@ -0,0 +1,183 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for CF::Mesh manipulations"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/BasicExceptions.hpp"
+#include "Common/Core.hpp"
+#include "Common/CRoot.hpp"
+#include "Common/FindComponents.hpp"
+
+#include "Common/MPI/PE.hpp"
+#include "Common/MPI/Buffer.hpp"
+
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/CElements.hpp"
+#include "Mesh/CNodes.hpp"
+#include "Mesh/CMeshTransformer.hpp"
+#include "Mesh/CSimpleMeshGenerator.hpp"
+#include "Mesh/Manipulations.hpp"
+#include "Mesh/Tags.hpp"
+
+using namespace CF;
+using namespace CF::Mesh;
+using namespace CF::Common;
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Manipulations_Fixture
+{
+  /// common setup for each test case
+  Manipulations_Fixture()
+  {
+    m_argc = boost::unit_test::framework::master_test_suite().argc;
+    m_argv = boost::unit_test::framework::master_test_suite().argv;
+  }
+
+  int m_argc;
+  char** m_argv;
+
+  /// common mesh accessed by all tests
+  static CMesh::Ptr m_mesh;
+};
+
+CMesh::Ptr Manipulations_Fixture::m_mesh;
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( Manipulations_TestSuite, Manipulations_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( Init )
+{
+  Core::instance().initiate(m_argc,m_argv);
+  mpi::PE::instance().init(m_argc,m_argv);
+
+  m_mesh = Core::instance().root().create_component_ptr<CMesh>("mesh");
+  CSimpleMeshGenerator::create_rectangle(*m_mesh,3.,2.,3u,2u,1u,false);
+
+  build_component_abstract_type<CMeshTransformer>("CF.Mesh.Actions.CGlobalNumbering","glb_numbering")->transform(*m_mesh);
+  build_component_abstract_type<CMeshTransformer>("CF.Mesh.Actions.CGlobalConnectivity","glb_connectivity")->transform(*m_mesh);
+
+  // tables that must follow the nodes and elements
+  CNodes& nodes = m_mesh->nodes();
+  CTable<Real>& node_data = nodes.create_component<CTable<Real> >("node_data");
+  node_data.add_tag(Tags::entity_data());
+  node_data.set_row_size(2);
+  node_data.resize(nodes.size());
+  for (Uint n=0; n<nodes.size(); ++n)
+  {
+    node_data[n][0] = n;
+    node_data[n][1] = 10.*n;
+  }
+
+  CElements& elements = find_component_recursively<CElements>(m_mesh->topology());
+  CTable<Real>& elem_data = elements.create_component<CTable<Real> >("elem_data");
+  elem_data.add_tag(Tags::entity_data());
+  elem_data.set_row_size(1);
+  elem_data.resize(elements.size());
+  for (Uint e=0; e<elements.size(); ++e)
+    elem_data[e][0] = 100.+e;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( pack_unpack_nodes )
+{
+  CNodes& nodes = m_mesh->nodes();
+  const CTable<Real>& node_data = nodes.get_child("node_data").as_type<CTable<Real> >();
+  const Uint nb_nodes = nodes.size();
+
+  // copy node 1 to the end
+  mpi::Buffer buf;
+  PackUnpackNodes copy_node(nodes);
+  buf << copy_node(1,PackUnpackNodes::COPY);
+  buf >> copy_node;
+  copy_node.flush();
+
+  BOOST_CHECK_EQUAL(nodes.size(), nb_nodes+1);
+  BOOST_CHECK_EQUAL(node_data.size(), nodes.size());
+  BOOST_CHECK_EQUAL(node_data[nb_nodes][0], 1.);
+  BOOST_CHECK_EQUAL(node_data[nb_nodes][1], 10.);
+
+  // migrate node 0: its row is removed, and added again at the end
+  PackUnpackNodes migrate_node(nodes);
+  buf.reset();
+  buf << migrate_node(0,PackUnpackNodes::MIGRATE);
+  migrate_node.flush();
+
+  BOOST_CHECK_EQUAL(nodes.size(), nb_nodes);
+  BOOST_CHECK_EQUAL(node_data.size(), nodes.size());
+
+  buf >> migrate_node;
+  migrate_node.flush();
+
+  BOOST_CHECK_EQUAL(node_data.size(), nodes.size());
+  BOOST_CHECK_EQUAL(node_data[nodes.size()-1][0], 0.);
+
+  // remove the node copied at the end
+  RemoveNodes remove(nodes);
+  remove(nb_nodes);
+  remove.flush();
+  BOOST_CHECK_EQUAL(node_data.size(), nodes.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( pack_unpack_elements )
+{
+  CElements& elements = find_component_recursively<CElements>(m_mesh->topology());
+  const CTable<Real>& elem_data = elements.get_child("elem_data").as_type<CTable<Real> >();
+  const Uint nb_elems = elements.size();
+
+  mpi::Buffer buf;
+  PackUnpackElements copy(elements);
+  buf << copy(2,PackUnpackElements::COPY);
+  buf >> copy;
+  copy.flush();
+
+  BOOST_CHECK_EQUAL(elements.size(), nb_elems+1);
+  BOOST_CHECK_EQUAL(elem_data.size(), elements.size());
+  BOOST_CHECK_EQUAL(elem_data[nb_elems][0], 102.);
+
+  RemoveElements remove(elements);
+  remove(0);
+  remove.flush();
+
+  BOOST_CHECK_EQUAL(elem_data.size(), elements.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( wrong_size )
+{
+  CNodes& nodes = m_mesh->nodes();
+  CTable<Real>& node_data = nodes.get_child("node_data").as_type<CTable<Real> >();
+  node_data.resize(nodes.size()+1);
+
+  BOOST_CHECK_THROW(PackUnpackNodes copy_node(nodes), BadValue);
+
+  nodes.remove_component("node_data");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( Terminate )
+{
+  mpi::PE::instance().finalize();
+  Core::instance().terminate();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
@@ -18,6 +18,7 @@
 #include "Common/FindComponents.hpp"
 #include "Common/CLink.hpp"
 #include "Common/CRoot.hpp"
+#include "Common/ThreadPool.hpp"
 
 #include "Mesh/CMesh.hpp"
 #include "Mesh/CRegion.hpp"
@@ -28,6 +29,8 @@
 #include "Mesh/COcttree.hpp"
 #include "Mesh/CStencilComputerOcttree.hpp"
 
+#include "Math/Consts.hpp"
+
 using namespace boost;
 using namespace boost::assign;
 using namespace CF;
@@ -133,6 +136,66 @@ BOOST_AUTO_TEST_CASE( Octtree_creation )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_CASE( Octtree_batched_search )
+{
+  CMeshGenerator::Ptr mesh_generator = build_component_abstract_type<CMeshGenerator>("CF.Mesh.CSimpleMeshGenerator","batch_mesh_generator");
+  Core::instance().root().add_component(mesh_generator);
+  mesh_generator->configure_option("parent",Core::instance().root().uri());
+  mesh_generator->configure_option("name",std::string("batch_mesh"));
+  mesh_generator->configure_option("lengths",std::vector<Real>(2,10.));
+  mesh_generator->configure_option("nb_cells",std::vector<Uint>(2,40));
+  mesh_generator->execute();
+
+  COcttree::Ptr octtree = allocate_component<COcttree>("batch_octtree");
+  octtree->configure_option("mesh", Core::instance().root().get_child("batch_mesh").uri() );
+  octtree->create_octtree();
+
+  // points in every cell of the mesh and one outside the mesh
+  const Uint nb_points = 100*100+1;
+  RealMatrix points(nb_points,2);
+  for (Uint i=0; i<100; ++i)
+    for (Uint j=0; j<100; ++j)
+      points.row(100*i+j) << 0.03+0.1*i , 0.03+0.1*j ;
+  points.row(nb_points-1) << 11. , 5. ;
+
+  std::vector<Uint> unified_elems;
+  ThreadPool::instance().set_nb_threads(4);
+  octtree->find_elements(points,unified_elems);
+  ThreadPool::instance().set_nb_threads(1);
+  BOOST_CHECK_EQUAL(unified_elems.size(), nb_points);
+  BOOST_CHECK_EQUAL(unified_elems.back(), Math::Consts::uint_max());
+
+  // the batched search agrees with the search of single points
+  CElements::ConstPtr elements;
+  Uint idx(0);
+  RealVector coord(2);
+  for (Uint p=0; p<nb_points-1; ++p)
+  {
+    coord = points.row(p).transpose();
+    boost::tie(elements,idx) = octtree->find_element(coord);
+    BOOST_CHECK(is_not_null(elements));
+    BOOST_CHECK_EQUAL(octtree->unified_elements().unified_idx(*elements,idx), unified_elems[p]);
+    // 40 cells of length 0.25 in each direction, numbered along x first
+    BOOST_CHECK_EQUAL(idx, 40*static_cast<Uint>(points(p,YY)/0.25) + static_cast<Uint>(points(p,XX)/0.25));
+  }
+
+  // points on the faces between cells are found as well
+  coord << 0.25 , 0.65 ;
+  boost::tie(elements,idx) = octtree->find_element(coord);
+  BOOST_CHECK(is_not_null(elements));
+  coord << 2.25 , 2.25 ;
+  boost::tie(elements,idx) = octtree->find_element(coord);
+  BOOST_CHECK(is_not_null(elements));
+
+  // without parallel environment every point is owned by this process
+  std::vector<Uint> ranks;
+  octtree->find_elements(points,ranks,unified_elems);
+  BOOST_CHECK_EQUAL(ranks.front(), 0u);
+  BOOST_CHECK_EQUAL(ranks.back(), Math::Consts::uint_max());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_SUITE_END()
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -602,8 +602,8 @@ BOOST_AUTO_TEST_CASE( parallelize_and_synchronize )
         if ( glb_node_2_loc_node.find(find_glb_node_idx) != glb_node_not_found)
         {
           Uint loc_idx = glb_node_2_loc_node[find_glb_node_idx];
-          CDynTable<Uint>::ConstRow connected_elements = nodes.glb_elem_connectivity()[loc_idx];
-          boost_foreach ( const Uint glb_elem_idx, nodes.glb_elem_connectivity()[loc_idx] )
+          CDynTable<Gid>::ConstRow connected_elements = nodes.glb_elem_connectivity()[loc_idx];
+          boost_foreach ( const Gid glb_elem_idx, nodes.glb_elem_connectivity()[loc_idx] )
           {
 
             if ( glb_elem_2_loc_elem.find(glb_elem_idx) != glb_elem_not_found)
@@ -659,7 +659,7 @@ BOOST_AUTO_TEST_CASE( parallelize_and_synchronize )
                                     << elements.rank()[elem_idx];
 
           boost_foreach(const Uint connected_node, elements.node_connectivity()[elem_idx])
-              elements_to_send[to_proc] << nodes.glb_idx()[connected_node];
+              elements_to_send[to_proc] << static_cast<Uint>(nodes.glb_idx()[connected_node]);
 
         }
       }
@@ -0,0 +1,212 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for the Prism3DLagrangeP1 shape function"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/Log.hpp"
+#include "Common/CRoot.hpp"
+
+#include "Mesh/CTable.hpp"
+#include "Mesh/Integrators/Gauss.hpp"
+#include "Mesh/SF/Prism3DLagrangeP1.hpp"
+
+using namespace CF;
+using namespace CF::Mesh;
+using namespace CF::Mesh::Integrators;
+using namespace CF::Mesh::SF;
+
+//////////////////////////////////////////////////////////////////////////////
+
+typedef Prism3DLagrangeP1 SFT;
+
+struct Prism3DLagrangeP1Fixture
+{
+  typedef SFT::NodeMatrixT NodesT;
+  /// common setup for each test case
+  Prism3DLagrangeP1Fixture() :
+    mapped_coords(0.2, 0.3, 0.4),
+    // a boundary layer prism: thin, sheared, and with a warped top
+    nodes
+    (
+      (NodesT() <<
+        1.0, 2.0, 3.0,
+        1.5, 2.1, 3.0,
+        1.1, 2.6, 3.05,
+        1.02, 2.01, 3.1,
+        1.53, 2.12, 3.09,
+        1.12, 2.61, 3.17).finished()
+    ),
+    // the same prism, without the warping: a linear map of the reference prism
+    affine_nodes
+    (
+      (NodesT() <<
+        1.0, 2.0, 3.0,
+        1.5, 2.1, 3.0,
+        1.1, 2.6, 3.05,
+        1.02, 2.01, 3.1,
+        1.52, 2.11, 3.1,
+        1.12, 2.61, 3.15).finished()
+    )
+  {
+  }
+
+  /// common values accessed by all tests goes here
+
+  const SFT::MappedCoordsT mapped_coords;
+  const NodesT nodes;
+  const NodesT affine_nodes;
+
+  /// Integral of the jacobian determinant, with the given quadrature
+  template<Uint Order>
+  Real integrate_volume(const NodesT& element_nodes) const
+  {
+    typedef GaussMappedCoords<Order, GeoShape::PRISM> GaussT;
+    Real result = 0.;
+    for(Uint i = 0; i != GaussT::nb_points; ++i)
+      result += GaussT::instance().weights[i] * SFT::jacobian_determinant(GaussT::instance().coords.col(i), element_nodes);
+    return result;
+  }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( Prism3DLagrangeP1Suite, Prism3DLagrangeP1Fixture )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( ShapeFunction )
+{
+  // Kronecker delta property at the nodes
+  const RealMatrix& sf_nodes = SFPrismLagrangeP1::mapped_sf_nodes();
+  for(Uint i = 0; i != SFT::nb_nodes; ++i)
+  {
+    SFT::ShapeFunctionsT result;
+    SFT::shape_function_value(sf_nodes.row(i).transpose(), result);
+    for(Uint j = 0; j != SFT::nb_nodes; ++j)
+      BOOST_CHECK_SMALL(result[j] - (i == j ? 1. : 0.), 1e-14);
+  }
+
+  // partition of unity
+  SFT::ShapeFunctionsT result;
+  SFT::shape_function_value(mapped_coords, result);
+  BOOST_CHECK_CLOSE(result.sum(), 1., 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE( MappedGradient )
+{
+  // compare with central differences, exact for the polynomial shape functions
+  const Real eps = 1e-4;
+  SFT::MappedGradientT result;
+  SFT::shape_function_gradient(mapped_coords, result);
+  for(Uint d = 0; d != SFT::dimensionality; ++d)
+  {
+    SFT::MappedCoordsT plus = mapped_coords;
+    SFT::MappedCoordsT minus = mapped_coords;
+    plus[d] += eps;
+    minus[d] -= eps;
+    SFT::ShapeFunctionsT sf_plus, sf_minus;
+    SFT::shape_function_value(plus, sf_plus);
+    SFT::shape_function_value(minus, sf_minus);
+    for(Uint j = 0; j != SFT::nb_nodes; ++j)
+      BOOST_CHECK_SMALL(result(d,j) - (sf_plus[j] - sf_minus[j]) / (2.*eps), 1e-10);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( MappedCoordinates )
+{
+  SFT::ShapeFunctionsT sf;
+  SFT::shape_function_value(mapped_coords, sf);
+  const SFT::CoordsT coords = (sf*nodes).transpose();
+
+  SFT::MappedCoordsT result;
+  SFT::mapped_coordinates(coords, nodes, result);
+  for(Uint d = 0; d != SFT::dimensionality; ++d)
+    BOOST_CHECK_SMALL(result[d] - mapped_coords[d], 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE( IntegrateConst )
+{
+  // weights add up to the volume of the reference prism
+  typedef GaussMappedCoords<1, GeoShape::PRISM> Gauss1T;
+  typedef GaussMappedCoords<2, GeoShape::PRISM> Gauss2T;
+  typedef GaussMappedCoords<4, GeoShape::PRISM> Gauss4T;
+  BOOST_CHECK_CLOSE(Gauss1T::instance().weights.sum(), 1., 1e-12);
+  BOOST_CHECK_CLOSE(Gauss2T::instance().weights.sum(), 1., 1e-12);
+  BOOST_CHECK_CLOSE(Gauss4T::instance().weights.sum(), 1., 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE( Volume )
+{
+  // linear map of the reference prism, of volume 1
+  SFT::JacobianT jacobian;
+  SFT::jacobian(mapped_coords, affine_nodes, jacobian);
+  BOOST_CHECK_CLOSE(SFT::volume(affine_nodes), jacobian.determinant(), 1e-10);
+  BOOST_CHECK_CLOSE(integrate_volume<1>(affine_nodes), jacobian.determinant(), 1e-10);
+
+  // warped prism, compared with a high order quadrature
+  BOOST_CHECK_CLOSE(SFT::volume(nodes), integrate_volume<4>(nodes), 1e-10);
+  BOOST_CHECK_CLOSE(SFT::volume(nodes), integrate_volume<2>(nodes), 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE( JacobianAdjoint )
+{
+  SFT::JacobianT jacobian, adjoint;
+  SFT::jacobian(mapped_coords, nodes, jacobian);
+  SFT::jacobian_adjoint(mapped_coords, nodes, adjoint);
+  const SFT::JacobianT product = jacobian * adjoint;
+  const Real det = SFT::jacobian_determinant(mapped_coords, nodes);
+  for(Uint i = 0; i != SFT::dimensionality; ++i)
+    for(Uint j = 0; j != SFT::dimensionality; ++j)
+      BOOST_CHECK_SMALL(product(i,j) - (i == j ? det : 0.), 1e-14);
+}
+
+BOOST_AUTO_TEST_CASE( Faces )
+{
+  // faces are oriented outwards
+  const ElementType::FaceConnectivity& faces = SFT::faces();
+  const SFT::CoordsT centroid = nodes.colwise().sum() / SFT::nb_nodes;
+  for(Uint face = 0; face != SFT::nb_faces; ++face)
+  {
+    const ElementType::FaceConnectivity::RangeT face_nodes = faces.face_node_range(face);
+    const SFT::CoordsT v1 = nodes.row(face_nodes[1]) - nodes.row(face_nodes[0]);
+    const SFT::CoordsT v2 = nodes.row(face_nodes[2]) - nodes.row(face_nodes[0]);
+    const SFT::CoordsT outward = nodes.row(face_nodes[0]).transpose() - centroid;
+    BOOST_CHECK_GT(v1.cross(v2).dot(outward), 0.);
+  }
+
+  BOOST_CHECK_EQUAL(faces.face_node_counts[0], 3u);
+  BOOST_CHECK_EQUAL(faces.face_node_counts[2], 4u);
+  SFT prism;
+  BOOST_CHECK_EQUAL(prism.face_type(0).shape(), GeoShape::TRIAG);
+  BOOST_CHECK_EQUAL(prism.face_type(1).shape(), GeoShape::TRIAG);
+  BOOST_CHECK_EQUAL(prism.face_type(2).shape(), GeoShape::QUAD);
+}
+
+BOOST_AUTO_TEST_CASE( Is_coord_in_element )
+{
+  const SFT::CoordsT centroid = nodes.colwise().sum() / SFT::nb_nodes;
+
+  BOOST_CHECK_EQUAL(SFT::in_element(centroid,nodes),true);
+
+  // points just inside each corner
+  for(Uint i = 0; i != SFT::nb_nodes; ++i)
+  {
+    const SFT::CoordsT corner = nodes.row(i);
+    BOOST_CHECK_EQUAL(SFT::in_element(corner + 0.01*(centroid - corner),nodes),true);
+  }
+
+  BOOST_CHECK_EQUAL(SFT::in_element(2.0 * centroid,nodes),false);
+  BOOST_CHECK_EQUAL(SFT::in_element(centroid + SFT::CoordsT(0., 0., 0.2),nodes),false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
@@ -10,6 +10,7 @@
 #include <boost/assign/list_of.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include "Common/BasicExceptions.hpp"
 #include "Common/Log.hpp"
 #include "Common/CRoot.hpp"
 
@@ -255,6 +256,32 @@ BOOST_AUTO_TEST_CASE( computeJacobianAdjoint )
   BOOST_CHECK_LT(boost::accumulators::max(accumulator.ulps), 15);
 }
 
+BOOST_AUTO_TEST_CASE( computePlaneJacobianNormal )
+{
+  // the normals of the planes of constant ksi and eta are the columns of the jacobian adjoint
+  SFT::JacobianT adjoint;
+  Quad2DLagrangeP1::jacobian_adjoint(mapped_coords, nodes, adjoint);
+
+  const Quad2DLagrangeP1 etype;
+  const RealVector mapped = mapped_coords;
+  const RealMatrix dyn_nodes = nodes;
+
+  RealVector result(2);
+  Accumulator accumulator;
+
+  etype.compute_plane_jacobian_normal(mapped, dyn_nodes, KSI, result);
+  vector_test(result, RealVector(adjoint.col(KSI)), accumulator);
+  vector_test(etype.plane_jacobian_normal(mapped, dyn_nodes, KSI), result, accumulator);
+
+  etype.compute_plane_jacobian_normal(mapped, dyn_nodes, ETA, result);
+  vector_test(result, RealVector(adjoint.col(ETA)), accumulator);
+  vector_test(etype.plane_jacobian_normal(mapped, dyn_nodes, ETA), result, accumulator);
+
+  BOOST_CHECK_LT(boost::accumulators::max(accumulator.ulps), 15);
+
+  BOOST_CHECK_THROW(etype.compute_plane_jacobian_normal(mapped, dyn_nodes, ZTA, result), ShouldNotBeHere);
+}
+
 BOOST_AUTO_TEST_CASE( integrateConst )
 {
   // Shapefunction determinant should be double the volume for triangles
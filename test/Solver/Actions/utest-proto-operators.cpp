@@ -24,6 +24,7 @@
 #include "Common/Core.hpp"
 #include "Common/CRoot.hpp"
 #include "Common/Log.hpp"
+#include "Common/ThreadPool.hpp"
 
 #include "Math/MatrixTypes.hpp"
 
@@ -326,6 +327,44 @@ BOOST_AUTO_TEST_CASE( VoidOp )
   BOOST_CHECK_EQUAL(count, 10);
 }
 
+/// Test the loops executed by several threads
+BOOST_AUTO_TEST_CASE( ThreadedLoops )
+{
+  CMesh::Ptr mesh = Core::instance().root().create_component_ptr<CMesh>("threaded_rect");
+  Tools::MeshGeneration::create_rectangle(*mesh, 2., 3., 40, 40);
+  
+  Real serial_vol = 0.;
+  for_each_element<VolumeTypes>(mesh->topology(), boost::proto::lit(serial_vol) += volume);
+  
+  ThreadPool::instance().set_nb_threads(4);
+  
+  // Reductions are summed per chunk, the same way for every run with the same number of threads
+  Real vol = 0.;
+  for_each_element<VolumeTypes>(mesh->topology(), boost::proto::lit(vol) += volume);
+  BOOST_CHECK_CLOSE(vol, serial_vol, 1e-10);
+  BOOST_CHECK_CLOSE(vol, 6., 1e-10);
+  
+  Real vol_again = 0.;
+  for_each_element<VolumeTypes>(mesh->topology(), boost::proto::lit(vol_again) += volume);
+  BOOST_CHECK_EQUAL(vol, vol_again);
+  
+  // A custom op modifying a shared argument is executed serially
+  int count = 0;
+  for_each_element<VolumeTypes>(mesh->topology(), counter(count));
+  BOOST_CHECK_EQUAL(count, 1600);
+  
+  // Node loops write each node once
+  CField& field = mesh->create_scalar_field("ThreadedX", "x", CF::Mesh::CField::Basis::POINT_BASED);
+  MeshTerm<0, ScalarField > x("ThreadedX", "x");
+  for_each_node(mesh->topology(), x = coordinates[0]);
+  
+  const CTable<Real>& coords = mesh->nodes().coordinates();
+  for(Uint i = 0; i != coords.size(); ++i)
+    BOOST_CHECK_EQUAL(field.data()[i][0], coords[i][XX]);
+  
+  ThreadPool::instance().set_nb_threads(1);
+}
+
 BOOST_AUTO_TEST_CASE( ElementGaussQuadrature )
 {
   CMesh::Ptr mesh = Core::instance().root().create_component_ptr<CMesh>("GaussQuadratureLine");
@@ -372,6 +411,68 @@ BOOST_AUTO_TEST_CASE( ElementGaussQuadrature )
 }
 
 
+/// Sum of the mass matrices over the elements, computed with a cached quadrature
+Real cached_mass_sum(CMesh& mesh, ElementMatrixCache& cache, Real& stiffness_sum)
+{
+  MeshTerm<0, ScalarField > temperature("CachedTemperature", "T");
+  RealMatrix4 mass; mass.setZero();
+  RealMatrix4 stiffness; stiffness.setZero();
+
+  for_each_element< boost::mpl::vector1<SF::Quad2DLagrangeP1> >
+  (
+    mesh.topology(),
+    group <<
+    (
+      _A = _0, _T = _0,
+      cached_element_quadrature(cache) <<
+      (
+        _A(temperature) += transpose(N(temperature))*N(temperature),
+        _T(temperature) += transpose(nabla(temperature))*nabla(temperature)
+      ),
+      boost::proto::lit(mass) += _A,
+      boost::proto::lit(stiffness) += _T
+    )
+  );
+
+  stiffness_sum = stiffness.sum();
+  return mass.sum();
+}
+
+BOOST_AUTO_TEST_CASE( CachedElementQuadrature )
+{
+  CMesh::Ptr mesh = Core::instance().root().create_component_ptr<CMesh>("CachedQuadratureRect");
+  Tools::MeshGeneration::create_rectangle(*mesh, 2., 3., 10, 10);
+  mesh->create_scalar_field("CachedTemperature", "T", CField::Basis::POINT_BASED);
+
+  ElementMatrixCache cache;
+  Real stiffness_sum = 1.;
+
+  // The mass matrices add up to the area, and the rows of the laplacian to zero
+  BOOST_CHECK_CLOSE(cached_mass_sum(*mesh, cache, stiffness_sum), 6., 1e-10);
+  BOOST_CHECK_SMALL(stiffness_sum, 1e-10);
+  BOOST_CHECK_EQUAL(cache.nb_stored(), 100u);
+
+  // Stretch the mesh: the stored matrices are reused until the cache is invalidated
+  CTable<Real>& coords = mesh->nodes().coordinates();
+  for(Uint i = 0; i != coords.size(); ++i)
+  {
+    coords[i][XX] *= 2.;
+    coords[i][YY] *= 2.;
+  }
+  BOOST_CHECK_CLOSE(cached_mass_sum(*mesh, cache, stiffness_sum), 6., 1e-10);
+  cache.invalidate();
+  BOOST_CHECK_EQUAL(cache.nb_stored(), 0u);
+  BOOST_CHECK_CLOSE(cached_mass_sum(*mesh, cache, stiffness_sum), 24., 1e-10);
+
+  // Threads store the matrices of their own elements
+  ThreadPool::instance().set_nb_threads(4);
+  cache.invalidate();
+  BOOST_CHECK_CLOSE(cached_mass_sum(*mesh, cache, stiffness_sum), 24., 1e-10);
+  BOOST_CHECK_EQUAL(cache.nb_stored(), 100u);
+  BOOST_CHECK_CLOSE(cached_mass_sum(*mesh, cache, stiffness_sum), 24., 1e-10);
+  ThreadPool::instance().set_nb_threads(1);
+}
+
 BOOST_AUTO_TEST_CASE(GroupArity)
 {
   CMesh::Ptr mesh = Core::instance().root().create_component_ptr<CMesh>("GaussQuadratureLine");
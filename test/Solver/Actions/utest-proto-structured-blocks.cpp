@@ -0,0 +1,134 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for benchmarking the loops over block-structured elements"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Solver/Actions/Proto/ElementLooper.hpp"
+#include "Solver/Actions/Proto/Functions.hpp"
+#include "Solver/Actions/Proto/Terminals.hpp"
+
+#include "Common/Core.hpp"
+#include "Common/CRoot.hpp"
+#include "Common/FindComponents.hpp"
+#include "Common/ThreadPool.hpp"
+
+#include "Mesh/CMesh.hpp"
+#include "Mesh/CRegion.hpp"
+#include "Mesh/CElements.hpp"
+#include "Mesh/CField.hpp"
+#include "Mesh/CStructuredBlocks.hpp"
+#include "Mesh/BlockMesh/BlockData.hpp"
+#include "Mesh/SF/Types.hpp"
+
+#include "Solver/Actions/CComputeVolume.hpp"
+#include "Solver/Actions/CForAllElements.hpp"
+
+#include "Tools/MeshGeneration/MeshGeneration.hpp"
+#include "Tools/Testing/TimedTestFixture.hpp"
+
+using namespace CF;
+using namespace CF::Solver;
+using namespace CF::Solver::Actions;
+using namespace CF::Solver::Actions::Proto;
+using namespace CF::Mesh;
+using namespace CF::Common;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Each volume computation is timed with the block structure, then without it
+struct StructuredBlocksFixture : public Tools::Testing::TimedTestFixture
+{
+  /// Total volume computed by a serial CForAllElements loop with CComputeVolume, stored in a new field
+  static Real compute_volume_field(const std::string& field_name)
+  {
+    CField& field = channel_3d->create_field(field_name, CField::Basis::CELL_BASED, "space[0]", "volume[1]");
+    CForAllElements& loop = Core::instance().root().create_component<CForAllElements>("loop_" + field_name);
+    loop.configure_option("regions", std::vector<URI>(1, channel_3d->topology().uri()));
+    loop.create_loop_operation("CF.Solver.Actions.CComputeVolume").configure_option("Volume", field.uri());
+    loop.execute();
+
+    Real vol = 0.;
+    for(Uint i = 0; i != field.size(); ++i)
+      vol += field.data()[i][0];
+    return vol;
+  }
+
+  /// Total volume computed by a proto loop
+  static Real proto_volume()
+  {
+    Real vol = 0.;
+    for_each_element< boost::mpl::vector1<SF::Hexa3DLagrangeP1> >(channel_3d->topology(), vol += volume);
+    return vol;
+  }
+
+  static CElements& hexas()
+  {
+    return find_component_recursively_with_name<CElements>(*channel_3d, "elements_CF.Mesh.SF.Hexa3DLagrangeP1");
+  }
+
+  static CMesh::Ptr channel_3d;
+};
+
+CMesh::Ptr StructuredBlocksFixture::channel_3d;
+
+BOOST_AUTO_TEST_SUITE( StructuredBlocksSuite )
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Must be run before the next tests
+BOOST_FIXTURE_TEST_CASE( CreateMesh3D, StructuredBlocksFixture )
+{
+  channel_3d = Core::instance().root().create_component_ptr<CMesh>("channel_3d");
+  BlockMesh::BlockData block_data;
+  Tools::MeshGeneration::create_channel_3d(block_data, 10., 0.5, 5., 80, 40, 60, 0.1);
+  BlockMesh::build_mesh(block_data, *channel_3d);
+
+  // the loops over block-structured elements are serial
+  ThreadPool::instance().set_nb_threads(1);
+  BOOST_CHECK(CStructuredBlocks::of(hexas()));
+}
+
+BOOST_FIXTURE_TEST_CASE( ComputeVolumeBlocks, StructuredBlocksFixture )
+{
+  BOOST_CHECK_CLOSE(compute_volume_field("volume_blocks"), 50., 1e-6);
+}
+
+BOOST_FIXTURE_TEST_CASE( ProtoVolumeBlocks, StructuredBlocksFixture )
+{
+  BOOST_CHECK_CLOSE(proto_volume(), 50., 1e-6);
+}
+
+BOOST_FIXTURE_TEST_CASE( RemoveBlocks, StructuredBlocksFixture )
+{
+  hexas().remove_component("structured_blocks");
+  BOOST_CHECK(!CStructuredBlocks::of(hexas()));
+}
+
+BOOST_FIXTURE_TEST_CASE( ComputeVolumeNoBlocks, StructuredBlocksFixture )
+{
+  BOOST_CHECK_CLOSE(compute_volume_field("volume_no_blocks"), 50., 1e-6);
+
+  // the structured kernel computes the same volumes as the element by element loop
+  const CTable<Real>& with_blocks = channel_3d->get_child("volume_blocks").as_type<CField>().data();
+  const CTable<Real>& without_blocks = channel_3d->get_child("volume_no_blocks").as_type<CField>().data();
+  BOOST_REQUIRE_EQUAL(with_blocks.size(), without_blocks.size());
+  for(Uint i = 0; i != with_blocks.size(); ++i)
+    BOOST_CHECK_EQUAL(with_blocks[i][0], without_blocks[i][0]);
+}
+
+BOOST_FIXTURE_TEST_CASE( ProtoVolumeNoBlocks, StructuredBlocksFixture )
+{
+  BOOST_CHECK_CLOSE(proto_volume(), 50., 1e-6);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
@@ -20,6 +20,7 @@
 #include "Common/CRoot.hpp"
 #include "Common/CLibraries.hpp"
 #include "Common/CEnv.hpp"
+#include "Common/ThreadPool.hpp"
 
 #include "Mesh/CMesh.hpp"
 #include "Mesh/CMeshWriter.hpp"
@@ -223,6 +224,64 @@ BOOST_AUTO_TEST_CASE ( test_CSetFieldValue )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_CASE ( test_CForAllElementsT_threads )
+{
+  CRoot& root = Core::instance().root();
+  CMesh::Ptr mesh = root.get_child_ptr("mesh2")->as_ptr<CMesh>();
+
+  std::vector<URI> topology = list_of(mesh->topology().uri());
+
+  // serial loop
+  CField& serial_field = mesh->create_field("serial_volumes",CField::Basis::CELL_BASED,"space[0]","var[1]");
+  CForAllElementsT<CComputeVolume>::Ptr serial_loop =
+    root.create_component_ptr< CForAllElementsT<CComputeVolume> > ("serial_cell_volumes");
+  serial_loop->configure_option("regions",topology);
+  serial_loop->action().configure_option("Volume",serial_field.uri());
+  serial_loop->execute();
+  BOOST_CHECK(is_null(serial_loop->action().get_child_ptr("thread_1")));
+
+  // the same loop, with the elements shared among 4 threads
+  CField& threaded_field = mesh->create_field("threaded_volumes",CField::Basis::CELL_BASED,"space[0]","var[1]");
+  threaded_field.data() = 0.;
+  CForAllElementsT<CComputeVolume>::Ptr threaded_loop =
+    root.create_component_ptr< CForAllElementsT<CComputeVolume> > ("threaded_cell_volumes");
+  threaded_loop->configure_option("regions",topology);
+  threaded_loop->action().configure_option("Volume",threaded_field.uri());
+
+  ThreadPool::instance().set_nb_threads(4);
+  threaded_loop->execute();
+
+  BOOST_CHECK_EQUAL(threaded_field.data().size(), serial_field.data().size());
+  for (Uint i=0; i<serial_field.data().size(); ++i)
+    BOOST_CHECK_EQUAL(threaded_field.data()[i][0], serial_field.data()[i][0]);
+
+  // the copies of the operation are created once, in the component tree
+  CLoopOperation& op = threaded_loop->action();
+  BOOST_CHECK_EQUAL(op.thread_operations().size(), 4u);
+  BOOST_CHECK(op.thread_operations()[0] == &op);
+  Component::Ptr copy = op.get_child_ptr("thread_3");
+  BOOST_CHECK(is_not_null(copy));
+  BOOST_CHECK(op.thread_operations()[3] == copy.get());
+
+  // and follow the options of the operation
+  CField& reconfigured_field = mesh->create_field("reconfigured_volumes",CField::Basis::CELL_BASED,"space[0]","var[1]");
+  reconfigured_field.data() = 0.;
+  op.configure_option("Volume",reconfigured_field.uri());
+  BOOST_CHECK_EQUAL(copy->option("Volume").value_str(), reconfigured_field.uri().string());
+
+  threaded_loop->execute();
+  BOOST_CHECK(op.get_child_ptr("thread_3") == copy);
+  for (Uint i=0; i<serial_field.data().size(); ++i)
+    BOOST_CHECK_EQUAL(reconfigured_field.data()[i][0], serial_field.data()[i][0]);
+
+  ThreadPool::instance().set_nb_threads(1);
+
+  root.remove_component( *serial_loop );
+  root.remove_component( *threaded_loop );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_CASE ( test_CForAllElementsT )
 {
   CRoot& root = Core::instance().root();
@@ -0,0 +1,254 @@
+// Copyright (C) 2010 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for the field streaming codec"
+
+#include <cmath>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/BasicExceptions.hpp"
+#include "Common/Core.hpp"
+#include "Common/CRoot.hpp"
+
+#include "Common/XML/SignalFrame.hpp"
+
+#include "Mesh/CTable.hpp"
+
+#include "Solver/Actions/CFieldSnapshots.hpp"
+#include "Solver/Actions/FieldStreamCodec.hpp"
+
+using namespace CF;
+using namespace CF::Common;
+using namespace CF::Common::XML;
+using namespace CF::Mesh;
+using namespace CF::Solver::Actions;
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct FieldStreamFixture
+{
+  FieldStreamFixture() : nb_rows(1000) {}
+
+  /// fills a table of 2 columns with a smooth field depending on time t
+  void fill( const Real t, std::vector<Real>& values )
+  {
+    values.resize( 2 * nb_rows );
+
+    for( Uint row = 0 ; row < nb_rows ; ++row )
+    {
+      const Real x = row / Real(nb_rows);
+      values[2*row]   = std::sin( 6.28 * x + t );
+      values[2*row+1] = 1e5 + 100. * x * t;
+    }
+  }
+
+  /// largest error relative to the quantization range
+  Real error( const std::vector<Real>& a, const std::vector<Real>& b, const FieldSnapshot& snapshot )
+  {
+    Real max_error = 0.;
+
+    for( Uint i = 0 ; i < a.size() ; ++i )
+    {
+      const Uint col = i % snapshot.row_size;
+      max_error = std::max( max_error, std::abs( a[i] - b[i] ) / ( snapshot.max[col] - snapshot.min[col] ) );
+    }
+
+    return max_error;
+  }
+
+  const Uint nb_rows;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( FieldStreamSuite, FieldStreamFixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( round_trip )
+{
+  FieldStreamEncoder encoder( 16, 0 );
+  FieldStreamDecoder decoder;
+
+  FieldSnapshot snapshot;
+  std::vector<Real> values;
+  std::vector<Real> decoded;
+
+  std::string::size_type key_frame_size = 0;
+
+  for( Uint i = 0 ; i < 10 ; ++i )
+  {
+    fill( 0.001 * i, values );
+
+    encoder.encode( values, 2, snapshot );
+    encoder.commit();
+
+    BOOST_CHECK_EQUAL( snapshot.key_frame, i == 0 );
+    BOOST_CHECK_EQUAL( snapshot.nb_rows, nb_rows );
+
+    decoder.decode( snapshot, decoded );
+
+    BOOST_CHECK_EQUAL( decoded.size(), values.size() );
+    BOOST_CHECK_LE( error( values, decoded, snapshot ), 1. / ( (1 << 16) - 1 ) );
+
+    if( i == 0 )
+      key_frame_size = snapshot.data.size();
+    else // small changes give small differences
+      BOOST_CHECK_LT( snapshot.data.size() * 2, key_frame_size );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( key_frames )
+{
+  FieldStreamEncoder encoder( 8, 3 );
+  FieldSnapshot snapshot;
+  std::vector<Real> values;
+
+  fill( 0., values );
+
+  encoder.encode( values, 2, snapshot ); encoder.commit();
+  BOOST_CHECK( snapshot.key_frame );
+
+  encoder.encode( values, 2, snapshot ); encoder.commit();
+  BOOST_CHECK( !snapshot.key_frame );
+
+  encoder.encode( values, 2, snapshot ); encoder.commit();
+  BOOST_CHECK( !snapshot.key_frame );
+
+  // interval reached
+  encoder.encode( values, 2, snapshot ); encoder.commit();
+  BOOST_CHECK( snapshot.key_frame );
+
+  // a value out of the range
+  values[0] = 10.;
+  encoder.encode( values, 2, snapshot ); encoder.commit();
+  BOOST_CHECK( snapshot.key_frame );
+
+  // a different size
+  values.resize( 10 );
+  encoder.encode( values, 2, snapshot ); encoder.commit();
+  BOOST_CHECK( snapshot.key_frame );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( dropped_snapshots )
+{
+  FieldStreamEncoder encoder( 16, 0 );
+  FieldStreamDecoder decoder;
+
+  FieldSnapshot snapshot;
+  std::vector<Real> values;
+  std::vector<Real> decoded;
+
+  fill( 0., values );
+  encoder.encode( values, 2, snapshot );
+  encoder.commit();
+  decoder.decode( snapshot, decoded );
+
+  // this one is not sent, hence not committed
+  fill( 0.01, values );
+  encoder.encode( values, 2, snapshot );
+
+  // the next one is encoded against the first one
+  fill( 0.02, values );
+  encoder.encode( values, 2, snapshot );
+  encoder.commit();
+
+  BOOST_CHECK( !snapshot.key_frame );
+
+  decoder.decode( snapshot, decoded );
+  BOOST_CHECK_LE( error( values, decoded, snapshot ), 1. / ( (1 << 16) - 1 ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( corrupted_snapshots )
+{
+  FieldStreamEncoder encoder;
+  FieldSnapshot snapshot;
+  std::vector<Real> values;
+  std::vector<Real> decoded;
+
+  fill( 0., values );
+  encoder.encode( values, 2, snapshot );
+  encoder.commit();
+
+  encoder.encode( values, 2, snapshot );
+
+  // a delta without its key frame
+  FieldStreamDecoder decoder;
+  BOOST_CHECK_THROW( decoder.decode( snapshot, decoded ), ParsingFailed );
+
+  // truncated data
+  encoder.reset();
+  encoder.encode( values, 2, snapshot );
+  snapshot.data.resize( snapshot.data.size() - 4 );
+  BOOST_CHECK_THROW( decoder.decode( snapshot, decoded ), ParsingFailed );
+
+  // a number of bits that can not be quantized
+  encoder.encode( values, 2, snapshot );
+  snapshot.bits = 40;
+  BOOST_CHECK_THROW( decoder.decode( snapshot, decoded ), ParsingFailed );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( bits_range )
+{
+  BOOST_CHECK_THROW( FieldStreamEncoder( 1 ), BadValue );
+  BOOST_CHECK_THROW( FieldStreamEncoder( 25 ), BadValue );
+  BOOST_CHECK_NO_THROW( FieldStreamEncoder( 2 ) );
+  BOOST_CHECK_NO_THROW( FieldStreamEncoder( 24 ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( receive_snapshots )
+{
+  CFieldSnapshots& receiver = Core::instance().root().create_component<CFieldSnapshots>("FieldSnapshots");
+
+  FieldStreamEncoder encoder( 16, 0 );
+  FieldSnapshot snapshot;
+  std::vector<Real> values;
+
+  const std::string field_path = "//Root/Domain/mesh/solution";
+
+  for( Uint i = 0 ; i < 2 ; ++i )
+  {
+    fill( 0.01 * i, values );
+    encoder.encode( values, 2, snapshot );
+    encoder.commit();
+
+    // built as CStreamFields does on the workers
+    SignalFrame frame( "field_snapshot", URI("//Root/Worker"), receiver.uri() );
+    snapshot.write( frame.map( field_path ) );
+    frame.set_option<Uint>( "iteration", 10 * i );
+    frame.set_option<Uint>( "rank", 3u );
+    frame.set_array<std::string>( "fields", std::vector<std::string>(1, field_path), " ; " );
+
+    receiver.call_signal( "field_snapshot", frame );
+
+    const CTable<Real>& table = receiver.get_child( "rank_3" ).get_child( "solution" ).as_type< CTable<Real> >();
+
+    BOOST_CHECK_EQUAL( table.size(), nb_rows );
+    BOOST_CHECK_EQUAL( table.row_size(), 2u );
+    BOOST_CHECK_EQUAL( boost::any_cast<Uint>( table.property("iteration") ), 10 * i );
+
+    std::vector<Real> received( table.array().data(), table.array().data() + table.array().num_elements() );
+    BOOST_CHECK_LE( error( values, received, snapshot ), 1. / ( (1 << 16) - 1 ) );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////